@@ -0,0 +1,2 @@
+COPY person FROM "dataset/shortest-path-direction-tests/vPerson.csv";
+COPY knows FROM "dataset/shortest-path-direction-tests/eKnows.csv";
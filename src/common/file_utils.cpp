@@ -7,6 +7,8 @@
 #ifdef _WIN32
 #include <fileapi.h>
 #include <windows.h>
+#else
+#include <sys/uio.h>
 #endif
 
 namespace kuzu {
@@ -46,7 +48,8 @@ int64_t FileInfo::getFileSize() {
 std::unique_ptr<FileInfo> FileUtils::openFile(const std::string& path, int flags) {
 #if defined(_WIN32)
     auto dwDesiredAccess = 0ul;
-    auto dwCreationDisposition = (flags & O_CREAT) ? OPEN_ALWAYS : OPEN_EXISTING;
+    auto dwCreationDisposition = (flags & O_CREAT) ? ((flags & O_EXCL) ? CREATE_NEW : OPEN_ALWAYS) :
+                                                     OPEN_EXISTING;
     auto dwShareMode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
     if (flags & (O_CREAT | O_WRONLY | O_RDWR)) {
         dwDesiredAccess |= GENERIC_WRITE;
@@ -170,6 +173,72 @@ void FileUtils::readFromFile(
 #endif
 }
 
+void FileUtils::readFromFile(
+    FileInfo* fileInfo, const std::vector<FileBuffer>& buffers, uint64_t position) {
+#if defined(_WIN32)
+    for (auto& buffer : buffers) {
+        readFromFile(fileInfo, buffer.buffer, buffer.numBytes, position);
+        position += buffer.numBytes;
+    }
+#else
+    std::vector<iovec> iovecs(buffers.size());
+    uint64_t numBytes = 0;
+    for (auto i = 0u; i < buffers.size(); i++) {
+        iovecs[i].iov_base = buffers[i].buffer;
+        iovecs[i].iov_len = buffers[i].numBytes;
+        numBytes += buffers[i].numBytes;
+    }
+    auto numBytesRead = preadv(fileInfo->fd, iovecs.data(), (int)iovecs.size(), position);
+    if (numBytesRead != numBytes && fileInfo->getFileSize() != position + numBytesRead) {
+        throw Exception(
+            StringUtils::string_format("Cannot read from file: {} fileDescriptor: {} "
+                                       "numBytesRead: {} numBytesToRead: {} position: {}",
+                fileInfo->path, fileInfo->fd, numBytesRead, numBytes, position));
+    }
+#endif
+}
+
+void FileUtils::writeToFile(
+    FileInfo* fileInfo, const std::vector<FileBuffer>& buffers, uint64_t offset) {
+#if defined(_WIN32)
+    for (auto& buffer : buffers) {
+        writeToFile(fileInfo, buffer.buffer, buffer.numBytes, offset);
+        offset += buffer.numBytes;
+    }
+#else
+    std::vector<iovec> iovecs(buffers.size());
+    uint64_t numBytesToWrite = 0;
+    for (auto i = 0u; i < buffers.size(); i++) {
+        iovecs[i].iov_base = buffers[i].buffer;
+        iovecs[i].iov_len = buffers[i].numBytes;
+        numBytesToWrite += buffers[i].numBytes;
+    }
+    uint64_t numBytesWritten = pwritev(fileInfo->fd, iovecs.data(), (int)iovecs.size(), offset);
+    if (numBytesWritten != numBytesToWrite) {
+        throw Exception(StringUtils::string_format(
+            "Cannot write to file. path: {} fileDescriptor: {} offsetToWrite: {} "
+            "numBytesToWrite: {} numBytesWritten: {}.",
+            fileInfo->path, fileInfo->fd, offset, numBytesToWrite, numBytesWritten));
+    }
+#endif
+}
+
+void FileUtils::syncFile(FileInfo* fileInfo) {
+#if defined(_WIN32)
+    if (!FlushFileBuffers((HANDLE)fileInfo->handle)) {
+        auto error = GetLastError();
+        throw Exception(StringUtils::string_format("Cannot sync file: {} handle: {}. Error {}: {}",
+            fileInfo->path, (intptr_t)fileInfo->handle, error,
+            std::system_category().message(error)));
+    }
+#else
+    if (fsync(fileInfo->fd) != 0) {
+        throw Exception(StringUtils::string_format("Cannot sync file: {} fileDescriptor: {}.",
+            fileInfo->path, fileInfo->fd));
+    }
+#endif
+}
+
 void FileUtils::createDir(const std::string& dir) {
     try {
         if (std::filesystem::exists(dir)) {
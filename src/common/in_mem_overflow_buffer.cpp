@@ -20,5 +20,33 @@ void InMemOverflowBuffer::allocateNewBlock() {
     blocks.push_back(std::move(newBlock));
 }
 
+void InMemOverflowBuffer::unpinBlocks() {
+    for (auto& block : blocks) {
+        block->block->unpin();
+    }
+}
+
+void InMemOverflowBuffer::unpinFullBlocks() {
+    // Blocks are unpinned as soon as a new current block is allocated, so the blocks before an
+    // unpinned block are unpinned already.
+    for (auto i = (int64_t)blocks.size() - 1; i >= 0; i--) {
+        if (blocks[i].get() == currentBlock) {
+            continue;
+        }
+        if (!blocks[i]->block->isPinned()) {
+            break;
+        }
+        blocks[i]->block->unpin();
+    }
+}
+
+uint64_t InMemOverflowBuffer::pinBlocks() {
+    uint64_t numBytesRead = 0;
+    for (auto& block : blocks) {
+        numBytesRead += block->block->pin();
+    }
+    return numBytesRead;
+}
+
 } // namespace common
 } // namespace kuzu
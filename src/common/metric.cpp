@@ -1,5 +1,10 @@
 #include "common/metric.h"
 
+#include <bit>
+#include <cmath>
+
+#include "common/string_utils.h"
+
 namespace kuzu {
 namespace common {
 
@@ -51,5 +56,42 @@ void NumericMetric::incrementByOne() {
     accumulatedValue++;
 }
 
+void LatencyHistogram::record(uint64_t latencyInMicros) {
+    // std::bit_width(x) is the index of the bucket holding x: 0 for 0 and i for [2^(i-1), 2^i).
+    auto bucketIdx = std::min((uint32_t)std::bit_width(latencyInMicros), NUM_BUCKETS - 1);
+    buckets[bucketIdx].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getNumRecorded() const {
+    uint64_t numRecorded = 0;
+    for (auto& bucket : buckets) {
+        numRecorded += bucket.load(std::memory_order_relaxed);
+    }
+    return numRecorded;
+}
+
+uint64_t LatencyHistogram::getPercentileUpperBoundInMicros(double percentile) const {
+    auto numRecorded = getNumRecorded();
+    if (numRecorded == 0) {
+        return 0;
+    }
+    auto rank = std::max((uint64_t)1, (uint64_t)std::ceil(percentile / 100 * numRecorded));
+    uint64_t numSeen = 0;
+    for (auto i = 0u; i < NUM_BUCKETS; i++) {
+        numSeen += buckets[i].load(std::memory_order_relaxed);
+        if (numSeen >= rank) {
+            return getBucketUpperBoundInMicros(i);
+        }
+    }
+    // Latencies recorded concurrently may change the counts between the two passes.
+    return getBucketUpperBoundInMicros(NUM_BUCKETS - 1);
+}
+
+std::string LatencyHistogram::toString() const {
+    return StringUtils::string_format("count: {}, p50 < {}us, p99 < {}us, max < {}us",
+        getNumRecorded(), getPercentileUpperBoundInMicros(50), getPercentileUpperBoundInMicros(99),
+        getPercentileUpperBoundInMicros(100));
+}
+
 } // namespace common
 } // namespace kuzu
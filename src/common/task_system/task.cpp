@@ -22,6 +22,15 @@ void Task::deRegisterThreadAndFinalizeTaskIfNecessary() {
             finalizeIfNecessary();
         } catch (std::exception& e) { setExceptionNoLock(std::current_exception()); }
     }
+    if (isCompletedNoLock()) {
+        completionCV.notify_all();
+    }
+}
+
+bool Task::waitUntilCompletedFor(uint64_t timeoutInMicros) {
+    lock_t lck{mtx};
+    return completionCV.wait_for(
+        lck, std::chrono::microseconds(timeoutInMicros), [&] { return isCompletedNoLock(); });
 }
 
 } // namespace common
@@ -1,6 +1,14 @@
 #include "common/task_system/task_scheduler.h"
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+
+#include <fstream>
+#endif
+
 #include "common/constants.h"
+#include "common/string_utils.h"
 #include "spdlog/spdlog.h"
 
 using namespace kuzu::common;
@@ -8,53 +16,215 @@ using namespace kuzu::common;
 namespace kuzu {
 namespace common {
 
-TaskScheduler::TaskScheduler(uint64_t numThreads) : nextScheduledTaskID{0} {
+#if defined(__linux__)
+// Parses a sysfs cpu list, e.g., "0-15,32-47".
+static std::vector<uint64_t> parseCPUList(const std::string& cpuList) {
+    std::vector<uint64_t> cpus;
+    for (auto& range : StringUtils::split(cpuList, ",")) {
+        if (range.empty()) {
+            continue;
+        }
+        auto bounds = StringUtils::split(range, "-");
+        auto begin = std::stoull(bounds[0]);
+        auto end = bounds.size() > 1 ? std::stoull(bounds[1]) : begin;
+        for (auto cpu = begin; cpu <= end; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+static std::vector<std::vector<uint64_t>> getCPUsPerNUMANode() {
+    std::vector<std::vector<uint64_t>> cpusPerNode;
+    for (auto nodeID = 0u;; ++nodeID) {
+        std::ifstream cpuListFile(
+            "/sys/devices/system/node/node" + std::to_string(nodeID) + "/cpulist");
+        if (!cpuListFile.is_open()) {
+            break;
+        }
+        std::string cpuList;
+        std::getline(cpuListFile, cpuList);
+        auto cpus = parseCPUList(StringUtils::rtrim(cpuList));
+        if (!cpus.empty()) {
+            cpusPerNode.push_back(std::move(cpus));
+        }
+    }
+    return cpusPerNode;
+}
+
+static void pinThreadToCPUs(std::thread& thread, const std::vector<uint64_t>& cpus) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : cpus) {
+        CPU_SET(cpu, &cpuSet);
+    }
+    if (pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) != 0) {
+        spdlog::warn("Failed to pin worker thread to its NUMA node.");
+    }
+}
+#endif
+
+TaskScheduler::TaskScheduler(uint64_t numThreads, bool pinThreadsToNUMANodes)
+    : nextScheduledTaskID{0} {
+    // We keep at least one queue so tasks can be scheduled even if there is no worker thread.
+    for (auto n = 0u; n < std::max<uint64_t>(numThreads, 1); ++n) {
+        workerQueues.push_back(std::make_unique<WorkerQueue>());
+    }
     for (auto n = 0u; n < numThreads; ++n) {
-        threads.emplace_back([&] { runWorkerThread(); });
+        threads.emplace_back([&, n] { runWorkerThread(n); });
+    }
+#if defined(__linux__)
+    if (pinThreadsToNUMANodes) {
+        auto cpusPerNode = getCPUsPerNUMANode();
+        if (!cpusPerNode.empty()) {
+            for (auto n = 0u; n < threads.size(); ++n) {
+                pinThreadToCPUs(threads[n], cpusPerNode[n % cpusPerNode.size()]);
+            }
+        }
     }
+#endif
 }
 
 TaskScheduler::~TaskScheduler() {
-    stopThreads.store(true);
+    {
+        lock_t lck{idleMtx};
+        stopThreads.store(true);
+    }
+    idleCV.notify_all();
     for (auto& thread : threads) {
         thread.join();
     }
 }
 
 std::shared_ptr<ScheduledTask> TaskScheduler::scheduleTask(const std::shared_ptr<Task>& task) {
-    lock_t lck{mtx};
     auto scheduledTask = std::make_shared<ScheduledTask>(task, nextScheduledTaskID++);
-    taskQueue.push_back(scheduledTask);
+    auto& workerQueue = *workerQueues[scheduledTask->ID % workerQueues.size()];
+    {
+        lock_t lck{workerQueue.mtx};
+        workerQueue.taskQueue.push_back(scheduledTask);
+    }
+    {
+        lock_t lck{idleMtx};
+        taskGeneration++;
+    }
+    idleCV.notify_all();
     return scheduledTask;
 }
 
 void TaskScheduler::scheduleTaskAndWaitOrError(
     const std::shared_ptr<Task>& task, processor::ExecutionContext* context) {
-    for (auto& dependency : task->children) {
-        scheduleTaskAndWaitOrError(dependency, context);
-    }
-    auto scheduledTask = scheduleTask(task);
-    while (!task->isCompleted()) {
+    std::vector<std::shared_ptr<ScheduledTask>> scheduledTasks;
+    std::unordered_map<Task*, uint64_t> numCompletedChildren;
+    std::exception_ptr exceptionPtr = nullptr;
+    scheduleTaskTree(task, scheduledTasks);
+    while (!scheduledTasks.empty()) {
+        waitForCompletionOfAnyTask(scheduledTasks, THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS);
         if (context != nullptr && context->clientContext->isTimeOutEnabled()) {
             interruptTaskIfTimeOutNoLock(context);
-        } else if (task->hasException()) {
-            // Interrupt tasks that errored, so other threads can stop working on them early.
-            context->clientContext->interrupt();
         }
-        std::this_thread::sleep_for(
-            std::chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS));
+        std::vector<std::shared_ptr<ScheduledTask>> completedTasks;
+        for (auto it = scheduledTasks.begin(); it != scheduledTasks.end();) {
+            auto& scheduledTask = *it;
+            if (scheduledTask->task->hasException() && exceptionPtr == nullptr) {
+                // Keep the first exception. Later ones may just be caused by the interrupt. Other
+                // running tasks are interrupted, so their threads can stop working on them early.
+                exceptionPtr = scheduledTask->task->getExceptionPtr();
+                if (context != nullptr) {
+                    context->clientContext->interrupt();
+                }
+            }
+            if (scheduledTask->task->isCompleted()) {
+                // Completed tasks are removed lazily by workers. Since idle workers no longer scan
+                // the queues periodically, we remove the task eagerly.
+                removeScheduledTask(scheduledTask->ID);
+                completedTasks.push_back(std::move(scheduledTask));
+                it = scheduledTasks.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (exceptionPtr != nullptr) {
+            continue;
+        }
+        for (auto& completedTask : completedTasks) {
+            scheduleTasksAfterCompletion(
+                completedTask->task.get(), task, numCompletedChildren, scheduledTasks);
+        }
     }
-    if (task->hasException()) {
-        removeErroringTask(scheduledTask->ID);
-        std::rethrow_exception(task->getExceptionPtr());
+    if (exceptionPtr != nullptr) {
+        std::rethrow_exception(exceptionPtr);
+    }
+}
+
+void TaskScheduler::scheduleTaskTree(const std::shared_ptr<Task>& task,
+    std::vector<std::shared_ptr<ScheduledTask>>& scheduledTasks) {
+    if (task->children.empty()) {
+        scheduledTasks.push_back(scheduleTask(task));
+    } else if (task->hasIndependentChildTasks()) {
+        for (auto& child : task->children) {
+            scheduleTaskTree(child, scheduledTasks);
+        }
+    } else {
+        scheduleTaskTree(task->children[0], scheduledTasks);
     }
 }
 
-std::shared_ptr<ScheduledTask> TaskScheduler::getTaskAndRegister() {
-    lock_t lck{mtx};
-    if (taskQueue.empty()) {
-        return nullptr;
+void TaskScheduler::scheduleTasksAfterCompletion(Task* completedTask,
+    const std::shared_ptr<Task>& root, std::unordered_map<Task*, uint64_t>& numCompletedChildren,
+    std::vector<std::shared_ptr<ScheduledTask>>& scheduledTasks) {
+    auto parent = completedTask->parent;
+    if (completedTask == root.get() || parent == nullptr) {
+        return;
     }
+    auto numCompleted = ++numCompletedChildren[parent];
+    if (numCompleted < parent->children.size()) {
+        if (!parent->hasIndependentChildTasks()) {
+            // Children complete in order, so the next child to run is the numCompleted-th one.
+            scheduleTaskTree(parent->children[numCompleted], scheduledTasks);
+        }
+        return;
+    }
+    if (parent == root.get()) {
+        scheduledTasks.push_back(scheduleTask(root));
+        return;
+    }
+    for (auto& sibling : parent->parent->children) {
+        if (sibling.get() == parent) {
+            scheduledTasks.push_back(scheduleTask(sibling));
+            return;
+        }
+    }
+}
+
+void TaskScheduler::waitForCompletionOfAnyTask(
+    const std::vector<std::shared_ptr<ScheduledTask>>& scheduledTasks, uint64_t timeoutInMicros) {
+    lock_t lck{completionMtx};
+    completionCV.wait_for(lck, std::chrono::microseconds(timeoutInMicros), [&] {
+        for (auto& scheduledTask : scheduledTasks) {
+            if (scheduledTask->task->isCompleted()) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+std::shared_ptr<ScheduledTask> TaskScheduler::getTaskAndRegister(uint64_t workerID) {
+    // Try the worker's own queue first, then steal from the other queues.
+    for (auto i = 0u; i < workerQueues.size(); ++i) {
+        auto& workerQueue = *workerQueues[(workerID + i) % workerQueues.size()];
+        auto scheduledTask = getTaskAndRegisterFromQueue(workerQueue);
+        if (scheduledTask) {
+            return scheduledTask;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<ScheduledTask> TaskScheduler::getTaskAndRegisterFromQueue(
+    WorkerQueue& workerQueue) {
+    lock_t lck{workerQueue.mtx};
+    auto& taskQueue = workerQueue.taskQueue;
     auto it = taskQueue.begin();
     while (it != taskQueue.end()) {
         auto task = (*it)->task;
@@ -77,8 +247,10 @@ std::shared_ptr<ScheduledTask> TaskScheduler::getTaskAndRegister() {
     return nullptr;
 }
 
-void TaskScheduler::removeErroringTask(uint64_t scheduledTaskID) {
-    lock_t lck{mtx};
+void TaskScheduler::removeScheduledTask(uint64_t scheduledTaskID) {
+    auto& workerQueue = *workerQueues[scheduledTaskID % workerQueues.size()];
+    lock_t lck{workerQueue.mtx};
+    auto& taskQueue = workerQueue.taskQueue;
     for (auto it = taskQueue.begin(); it != taskQueue.end(); ++it) {
         if (scheduledTaskID == (*it)->ID) {
             taskQueue.erase(it);
@@ -87,24 +259,34 @@ void TaskScheduler::removeErroringTask(uint64_t scheduledTaskID) {
     }
 }
 
-void TaskScheduler::runWorkerThread() {
+void TaskScheduler::waitForNewTask(uint64_t seenGeneration) {
+    lock_t lck{idleMtx};
+    idleCV.wait(lck, [&] { return stopThreads.load() || taskGeneration.load() != seenGeneration; });
+}
+
+void TaskScheduler::runWorkerThread(uint64_t workerID) {
     while (true) {
         if (stopThreads.load()) {
             break;
         }
-        auto scheduledTask = getTaskAndRegister();
+        // Read the generation before scanning the queues, so a task scheduled during the scan
+        // wakes us up instead of being missed.
+        auto seenGeneration = taskGeneration.load();
+        auto scheduledTask = getTaskAndRegister(workerID);
         if (!scheduledTask) {
-            std::this_thread::sleep_for(
-                std::chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS));
+            waitForNewTask(seenGeneration);
             continue;
         }
         try {
             scheduledTask->task->run();
-            scheduledTask->task->deRegisterThreadAndFinalizeTaskIfNecessary();
         } catch (std::exception& e) {
             scheduledTask->task->setException(std::current_exception());
-            scheduledTask->task->deRegisterThreadAndFinalizeTaskIfNecessary();
-            continue;
+        }
+        scheduledTask->task->deRegisterThreadAndFinalizeTaskIfNecessary();
+        if (scheduledTask->task->isCompleted()) {
+            // Taking the lock orders the completion before the waiter's next check.
+            { lock_t lck{completionMtx}; }
+            completionCV.notify_all();
         }
     }
 }
@@ -120,7 +120,10 @@ void ValueVector::copyFromVectorData(
 void ValueVector::resetAuxiliaryBuffer() {
     switch (dataType.getPhysicalType()) {
     case PhysicalTypeID::STRING: {
-        reinterpret_cast<StringAuxiliaryBuffer*>(auxiliaryBuffer.get())->resetOverflowBuffer();
+        auto stringAuxiliaryBuffer =
+            reinterpret_cast<StringAuxiliaryBuffer*>(auxiliaryBuffer.get());
+        stringAuxiliaryBuffer->resetOverflowBuffer();
+        stringAuxiliaryBuffer->setDictionary(nullptr);
         return;
     }
     case PhysicalTypeID::VAR_LIST: {
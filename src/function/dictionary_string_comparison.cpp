@@ -0,0 +1,88 @@
+#include "function/comparison/dictionary_string_comparison.h"
+
+#include "storage/storage_structure/string_dictionary.h"
+
+using namespace kuzu::common;
+using namespace kuzu::storage;
+
+namespace kuzu {
+namespace function {
+
+static inline const ValueVector& getDictionaryVector(
+    const ValueVector& left, const ValueVector& right) {
+    return left.state->isFlat() ? right : left;
+}
+
+static inline const ValueVector& getFlatVector(const ValueVector& left, const ValueVector& right) {
+    return left.state->isFlat() ? left : right;
+}
+
+static inline bool isEqual(const ValueVector& dictionaryVector, const uint32_t* codes,
+    uint32_t pos, uint32_t flatCode, const ku_string_t& flatValue) {
+    if (codes[pos] != StringDictionary::INVALID_CODE) {
+        return codes[pos] == flatCode;
+    }
+    return dictionaryVector.getValue<ku_string_t>(pos) == flatValue;
+}
+
+bool DictionaryStringComparison::canCompareOnCodes(
+    const ValueVector& left, const ValueVector& right) {
+    if (left.state->isFlat() == right.state->isFlat()) {
+        return false;
+    }
+    return StringVector::getDictionary(&getDictionaryVector(left, right)) != nullptr;
+}
+
+void DictionaryStringComparison::execute(const ValueVector& left, const ValueVector& right,
+    ValueVector& result, bool isNotEquals) {
+    auto& dictionaryVector = getDictionaryVector(left, right);
+    auto& flatVector = getFlatVector(left, right);
+    auto flatPos = flatVector.state->selVector->selectedPositions[0];
+    if (flatVector.isNull(flatPos)) {
+        result.setAllNull();
+        return;
+    }
+    auto& flatValue = flatVector.getValue<ku_string_t>(flatPos);
+    auto flatCode = StringVector::getDictionary(&dictionaryVector)->getCode(flatValue);
+    auto codes = StringVector::getDictionaryCodes(&dictionaryVector);
+    auto resultValues = (uint8_t*)result.getData();
+    auto& selVector = dictionaryVector.state->selVector;
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        auto pos = selVector->selectedPositions[i];
+        result.setNull(pos, dictionaryVector.isNull(pos));
+        if (!result.isNull(pos)) {
+            resultValues[pos] =
+                isEqual(dictionaryVector, codes, pos, flatCode, flatValue) != isNotEquals;
+        }
+    }
+}
+
+bool DictionaryStringComparison::select(const ValueVector& left, const ValueVector& right,
+    SelectionVector& selVector, bool isNotEquals) {
+    auto& dictionaryVector = getDictionaryVector(left, right);
+    auto& flatVector = getFlatVector(left, right);
+    auto flatPos = flatVector.state->selVector->selectedPositions[0];
+    if (flatVector.isNull(flatPos)) {
+        return false;
+    }
+    auto& flatValue = flatVector.getValue<ku_string_t>(flatPos);
+    auto flatCode = StringVector::getDictionary(&dictionaryVector)->getCode(flatValue);
+    auto codes = StringVector::getDictionaryCodes(&dictionaryVector);
+    auto& dictionarySelVector = dictionaryVector.state->selVector;
+    auto selectedPositionsBuffer = selVector.getSelectedPositionsBuffer();
+    uint64_t numSelectedValues = 0;
+    for (auto i = 0u; i < dictionarySelVector->selectedSize; i++) {
+        auto pos = dictionarySelVector->selectedPositions[i];
+        if (dictionaryVector.isNull(pos)) {
+            continue;
+        }
+        selectedPositionsBuffer[numSelectedValues] = pos;
+        numSelectedValues +=
+            isEqual(dictionaryVector, codes, pos, flatCode, flatValue) != isNotEquals;
+    }
+    selVector.selectedSize = numSelectedValues;
+    return numSelectedValues > 0;
+}
+
+} // namespace function
+} // namespace kuzu
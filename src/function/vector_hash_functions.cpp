@@ -1,12 +1,38 @@
 #include "function/hash/vector_hash_functions.h"
 
 #include "function/binary_function_executor.h"
+#include "storage/storage_structure/string_dictionary.h"
 
 using namespace kuzu::common;
 
 namespace kuzu {
 namespace function {
 
+// The hashes of the dictionary entries are precomputed, so only values that are not in the
+// dictionary are hashed.
+static void computeDictionaryStringHash(ValueVector* operand, ValueVector* result) {
+    auto dictionary = StringVector::getDictionary(operand);
+    auto codes = StringVector::getDictionaryCodes(operand);
+    auto resultValues = (hash_t*)result->getData();
+    auto computeHashAtPos = [&](uint32_t pos) {
+        if (operand->isNull(pos)) {
+            resultValues[pos] = NULL_HASH;
+        } else if (codes[pos] != storage::StringDictionary::INVALID_CODE) {
+            resultValues[pos] = dictionary->getHash(codes[pos]);
+        } else {
+            Hash::operation(operand->getValue<ku_string_t>(pos), resultValues[pos]);
+        }
+    };
+    auto& selVector = operand->state->selVector;
+    if (operand->state->isFlat()) {
+        computeHashAtPos(selVector->selectedPositions[0]);
+    } else {
+        for (auto i = 0u; i < selVector->selectedSize; i++) {
+            computeHashAtPos(selVector->selectedPositions[i]);
+        }
+    }
+}
+
 void VectorHashFunction::computeHash(ValueVector* operand, ValueVector* result) {
     result->state = operand->state;
     assert(result->dataType.getLogicalTypeID() == LogicalTypeID::INT64);
@@ -33,7 +59,11 @@ void VectorHashFunction::computeHash(ValueVector* operand, ValueVector* result)
         UnaryHashFunctionExecutor::execute<float_t, hash_t>(*operand, *result);
     } break;
     case PhysicalTypeID::STRING: {
-        UnaryHashFunctionExecutor::execute<ku_string_t, hash_t>(*operand, *result);
+        if (StringVector::getDictionary(operand)) {
+            computeDictionaryStringHash(operand, result);
+        } else {
+            UnaryHashFunctionExecutor::execute<ku_string_t, hash_t>(*operand, *result);
+        }
     } break;
     case PhysicalTypeID::INTERVAL: {
         UnaryHashFunctionExecutor::execute<interval_t, hash_t>(*operand, *result);
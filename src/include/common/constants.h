@@ -39,6 +39,23 @@ enum PageSizeClass : uint8_t {
     PAGE_256KB = 1,
 };
 
+// Replacement policies of the buffer manager. See the `Eviction policies` section above
+// `BufferManager` for more details.
+enum class EvictionPolicy : uint8_t {
+    SECOND_CHANCE = 0,
+    SCAN_RESISTANT = 1,
+};
+
+// Durability of committed write transactions. With SYNC, commit returns after the WAL and the files
+// written by the checkpoint are synced to disk. With RELAXED, commit returns before and the files
+// are synced in the background within the sync interval of the `CommitSyncer`, so a crash of the
+// OS or the machine can lose the transactions committed in that window. RELAXED requires background
+// checkpointing, whose checkpoints wait for the sync of their files instead of the commit.
+enum class DurabilityMode : uint8_t {
+    SYNC = 0,
+    RELAXED = 1,
+};
+
 // Currently the system supports files with 2 different pages size, which we refer to as
 // PAGE_4KB_SIZE and PAGE_256KB_SIZE. PAGE_4KB_SIZE is the default size of the page which is the
 // unit of read/write to the database files, such as to store columns or lists. For now, this value
@@ -61,8 +78,27 @@ struct BufferPoolConstants {
     // `removeNonEvictableCandidates` to remove candidates that are not evictable. See
     // `EvictionQueue::removeNonEvictableCandidates()` for more details.
     static constexpr uint64_t EVICTION_QUEUE_PURGING_INTERVAL = 1024;
+    // Under the SCAN_RESISTANT eviction policy, the probationary eviction queue holds candidates
+    // for at most 1/PROBATIONARY_EVICTION_QUEUE_SIZE_DIVISOR of the 4KB frames of the buffer pool.
+    static constexpr uint64_t PROBATIONARY_EVICTION_QUEUE_SIZE_DIVISOR = 4;
     // The default max size for a VMRegion.
     static constexpr uint64_t DEFAULT_VM_REGION_MAX_SIZE = (uint64_t)1 << 43; // (8TB)
+    // The number of background threads that read the pages requested by `BufferManager::prefetch`.
+    static constexpr uint64_t NUM_ASYNC_PAGE_READER_THREADS = 4;
+    // Sequential scans of columns and large lists prefetch the pages holding the next
+    // NUM_VECTORS_TO_READ_AHEAD vectors of values.
+    static constexpr uint64_t NUM_VECTORS_TO_READ_AHEAD = 4;
+    // The max number of consecutive pages that are read or written with a single vectored call.
+    static constexpr uint64_t MAX_NUM_PAGES_PER_EXTENT = 64;
+    // A hash join keeps the partitions of its hash table in memory as long as they fit in this
+    // ratio of the buffer pool, and spills the other partitions. See `JoinHashTable`.
+    static constexpr double HASH_JOIN_MEMORY_RATIO = 0.5;
+    // A hash aggregate combines the hash tables of its threads in partitions, one at a time, if
+    // the tables do not fit in this ratio of the buffer pool. See `HashAggregateSharedState`.
+    static constexpr double HASH_AGGREGATE_MEMORY_RATIO = 0.5;
+    // An ORDER BY sorts in memory as long as its tuples fit in this ratio of the buffer pool (and
+    // in the order_by_memory_budget setting), and sorts externally otherwise. See `OrderBy`.
+    static constexpr double ORDER_BY_MEMORY_RATIO = 0.5;
 
     static constexpr uint64_t DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING = 1ull << 26; // (64MB)
 };
@@ -81,11 +117,31 @@ struct StorageConstants {
     static constexpr char RELS_METADATA_FILE_NAME_FOR_WAL[] = "rels.statistics.wal";
     static constexpr char CATALOG_FILE_NAME[] = "catalog.bin";
     static constexpr char CATALOG_FILE_NAME_FOR_WAL[] = "catalog.bin.wal";
+    static constexpr char SPILL_FILE_PREFIX[] = "intermediate.";
+    static constexpr char SPILL_FILE_SUFFIX[] = ".spill";
 
     // The number of pages that we add at one time when we need to grow a file.
     static constexpr uint64_t PAGE_GROUP_SIZE_LOG2 = 10;
     static constexpr uint64_t PAGE_GROUP_SIZE = (uint64_t)1 << PAGE_GROUP_SIZE_LOG2;
     static constexpr uint64_t PAGE_IDX_IN_GROUP_MASK = ((uint64_t)1 << PAGE_GROUP_SIZE_LOG2) - 1;
+
+    // Compressed columns store their values in segments of NUM_PAGES_PER_COLUMN_SEGMENT pages. See
+    // `ColumnCompression` for more details.
+    static constexpr uint64_t NUM_PAGES_PER_COLUMN_SEGMENT = 8;
+
+    // String columns are dictionary-encoded by COPY if they have at most this many distinct values
+    // of at most MAX_STRING_DICTIONARY_SIZE bytes in total. See `StringDictionary`.
+    static constexpr uint64_t MAX_NUM_STRING_DICTIONARY_ENTRIES = 1 << 16;
+    static constexpr uint64_t MAX_STRING_DICTIONARY_SIZE = 1 << 24;
+};
+
+struct TransactionConstants {
+    // The max time that the files of a committed write transaction stay unsynced under the RELAXED
+    // durability mode.
+    static constexpr uint64_t RELAXED_DURABILITY_SYNC_INTERVAL_IN_MS = 100;
+    // The max time that the background checkpointer waits for read transactions to leave on their
+    // own before it stops new transactions from starting.
+    static constexpr uint64_t MAX_BACKGROUND_CHECKPOINT_DELAY_IN_MS = 1000;
 };
 
 struct ListsMetadataConstants {
@@ -102,7 +158,8 @@ struct ListsMetadataConstants {
 
 // Hash Index Configurations
 struct HashIndexConstants {
-    static constexpr uint8_t SLOT_CAPACITY = 3;
+    // Slots span 4 cache lines. The number of entries of a slot depends on the size of its keys.
+    static constexpr uint64_t SLOT_SIZE = 256;
 };
 
 struct CopyConstants {
@@ -155,6 +212,13 @@ struct PlannerKnobs {
 struct ClientContextConstants {
     // We disable query timeout by default.
     static constexpr uint64_t TIMEOUT_IN_MS = 0;
+    // Max size (in bytes) of the parsed rels that COPY REL keeps in memory for copying rel lists.
+    // The rels are also limited by the free buffer pool memory, and the rels over the limits are
+    // spilled.
+    static constexpr uint64_t COPY_REL_BUFFER_SIZE = 1ull << 32;
+    // Max size (in bytes) of the tuples that ORDER BY sorts in memory. Larger inputs are written
+    // into sorted runs, which are merged from the spill file.
+    static constexpr uint64_t ORDER_BY_MEMORY_BUDGET = 1ull << 32;
 };
 
 } // namespace common
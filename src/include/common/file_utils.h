@@ -34,6 +34,12 @@ struct FileInfo {
 #endif
 };
 
+// A buffer of a vectored read or write. See `FileUtils::readFromFile`.
+struct FileBuffer {
+    uint8_t* buffer;
+    uint64_t numBytes;
+};
+
 class FileUtils {
 public:
     static std::unique_ptr<FileInfo> openFile(const std::string& path, int flags);
@@ -41,8 +47,18 @@ public:
     static void createFileWithSize(const std::string& path, uint64_t size);
     static void readFromFile(
         FileInfo* fileInfo, void* buffer, uint64_t numBytes, uint64_t position);
+    // Reads consecutive bytes of the file from the given position into the buffers in order. On
+    // POSIX systems, all buffers are filled by a single preadv call.
+    static void readFromFile(
+        FileInfo* fileInfo, const std::vector<FileBuffer>& buffers, uint64_t position);
     static void writeToFile(
         FileInfo* fileInfo, uint8_t* buffer, uint64_t numBytes, uint64_t offset);
+    // Writes the buffers in order to consecutive bytes of the file from the given offset. On POSIX
+    // systems, all buffers are written by a single pwritev call.
+    static void writeToFile(
+        FileInfo* fileInfo, const std::vector<FileBuffer>& buffers, uint64_t offset);
+    // Flushes the writes to the file from the OS page cache to the disk (fsync).
+    static void syncFile(FileInfo* fileInfo);
     // This function is a no-op if either file, from or to, does not exist.
     static void overwriteFile(const std::string& from, const std::string& to);
     static void copyFile(const std::string& from, const std::string& to,
@@ -39,6 +39,14 @@ public:
         currentBlock = other.currentBlock;
     }
 
+    // Unpins all blocks so that they can be spilled under memory pressure. The buffer must not be
+    // accessed until pinBlocks is called. Returns the number of bytes read back from disk.
+    void unpinBlocks();
+    uint64_t pinBlocks();
+    // Unpins all blocks except the current one, which space is allocated from.
+    void unpinFullBlocks();
+    inline uint64_t getNumBlocks() const { return blocks.size(); }
+
     // Releases all memory accumulated for string overflows so far and re-initializes its state to
     // an empty buffer. If there is a large string that used point to any of these overflow buffers
     // they will error.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <mutex>
 
 #include "common/timer.h"
@@ -50,5 +52,32 @@ public:
     uint64_t accumulatedValue;
 };
 
+/**
+ * LatencyHistogram counts latencies in buckets of powers of two microseconds: bucket 0 counts the
+ * latencies below 1us and bucket i > 0 the latencies in [2^(i-1), 2^i) us. Unlike the metrics
+ * above, it is thread safe.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t NUM_BUCKETS = 40;
+
+    void record(uint64_t latencyInMicros);
+
+    uint64_t getNumRecorded() const;
+    inline uint64_t getBucketCount(uint32_t bucketIdx) const { return buckets[bucketIdx].load(); }
+    static inline uint64_t getBucketUpperBoundInMicros(uint32_t bucketIdx) {
+        return (uint64_t)1 << bucketIdx;
+    }
+    // Returns the upper bound of the bucket holding the given percentile, in [0, 100], of the
+    // latencies, or 0 if no latency is recorded.
+    uint64_t getPercentileUpperBoundInMicros(double percentile) const;
+
+    // E.g., "count: 10, p50 < 64us, p99 < 1024us, max < 2048us".
+    std::string toString() const;
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+};
+
 } // namespace common
 } // namespace kuzu
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+#include "common/task_system/task.h"
+
+namespace kuzu {
+namespace common {
+
+// Processes the items [0, numItems) on the threads of the task. Each thread takes the next item
+// that no thread has taken yet, until all items are taken.
+class ParallelForTask : public Task {
+public:
+    ParallelForTask(uint64_t numItems, uint64_t numThreads,
+        std::function<void(uint64_t itemIdx)> processItem)
+        : Task{numThreads}, numItems{numItems}, nextItemIdx{0},
+          processItem{std::move(processItem)} {}
+
+    void run() final {
+        auto itemIdx = nextItemIdx.fetch_add(1);
+        while (itemIdx < numItems) {
+            processItem(itemIdx);
+            itemIdx = nextItemIdx.fetch_add(1);
+        }
+    }
+
+private:
+    uint64_t numItems;
+    std::atomic<uint64_t> nextItemIdx;
+    std::function<void(uint64_t itemIdx)> processItem;
+};
+
+} // namespace common
+} // namespace kuzu
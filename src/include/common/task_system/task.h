@@ -1,5 +1,6 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -60,6 +61,11 @@ public:
 
     inline void setSingleThreadedTask() { maxNumThreads = 1; }
 
+    // Marks the children of this task as independent of each other, so the TaskScheduler can
+    // execute them concurrently instead of one after another.
+    inline void setIndependentChildTasks() { independentChildTasks = true; }
+    inline bool hasIndependentChildTasks() const { return independentChildTasks; }
+
     bool registerThread();
 
     void deRegisterThreadAndFinalizeTaskIfNecessary();
@@ -69,6 +75,10 @@ public:
         setExceptionNoLock(exceptionPtr);
     }
 
+    // Blocks the calling thread until the task is completed or the given timeout passes. Returns
+    // true if the task is completed.
+    bool waitUntilCompletedFor(uint64_t timeoutInMicros);
+
     inline bool hasException() {
         lock_t lck{mtx};
         return exceptionsPtr != nullptr;
@@ -99,8 +109,11 @@ public:
 
 protected:
     std::mutex mtx;
+    // Notified when the task completes, so waiting threads do not need to sleep-poll.
+    std::condition_variable completionCV;
     uint64_t maxNumThreads, numThreadsFinished{0}, numThreadsRegistered{0};
     std::exception_ptr exceptionsPtr = nullptr;
+    bool independentChildTasks = false;
     uint64_t ID;
 };
 
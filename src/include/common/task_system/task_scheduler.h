@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <thread>
+#include <unordered_map>
 
 #include "common/task_system/task.h"
 #include "common/utils.h"
@@ -17,59 +19,110 @@ struct ScheduledTask {
     uint64_t ID;
 };
 
+// Each worker thread owns one WorkerQueue. Scheduled tasks are distributed over the worker queues
+// so that workers do not contend on a single lock when grabbing tasks.
+struct WorkerQueue {
+    std::mutex mtx;
+    std::deque<std::shared_ptr<ScheduledTask>> taskQueue;
+};
+
 /**
  * TaskScheduler is a library that manages a set of worker threads that can execute tasks that are
- * put into a task queue. Each task accepts a maximum number of threads. Users of TaskScheduler
+ * put into task queues. Each task accepts a maximum number of threads. Users of TaskScheduler
  * schedule tasks to be executed by calling schedule functions, e.g., scheduleTask or
- * scheduleTaskAndWaitOrError. New tasks are put at the end of the queue. Workers grab the first
- * task from the beginning of the queue that they can register themselves to work on. Any task that
- * is completed is removed automatically from the queue. If there is a task that raises an
- * exception, the worker threads catch it and store it with the tasks. The user thread that is
- * waiting on the completion of the task (or tasks) will throw the exception (the user thread could
- * be waiting on a tasks through a function that waits, e.g., scheduleTaskAndWaitOrError.
+ * scheduleTaskAndWaitOrError. If there is a task that raises an exception, the worker threads
+ * catch it and store it with the tasks. The user thread that is waiting on the completion of the
+ * task (or tasks) will throw the exception (the user thread could be waiting on a tasks through a
+ * function that waits, e.g., scheduleTaskAndWaitOrError.
  *
  * Currently there is one way the TaskScheduler can be used:
  * Schedule one task T and wait for T to finish or error if there was an exception raised by
  * one of the threads working on T that errored. This is simply done by the call:
  *      scheduleTaskAndWaitOrError(T);
  *
- * TaskScheduler guarantees that workers will register themselves to tasks in FIFO order. However
- * this does not guarantee that the tasks will be completed in FIFO order: a long running task
- * that is not accepting more registration can stay in the queue for an unlimited time until
- * completion.
+ * Scheduling is work-stealing: every worker thread owns a queue and new tasks are distributed over
+ * the queues in round-robin order. A worker first tries to register itself to a task in its own
+ * queue and, if there is none it can register to, steals work by registering itself to a task in
+ * another worker's queue. Because a task can be worked on by multiple threads, stealing does not
+ * remove the task from its queue. Any task that is completed is removed automatically from the
+ * queues. Idle workers block on a condition variable and are woken up when a new task is
+ * scheduled, instead of sleep-polling the queues.
+ *
+ * TaskScheduler guarantees that workers will register themselves to the tasks of each queue in
+ * FIFO order. However this does not guarantee that the tasks will be completed in FIFO order: a
+ * long running task that is not accepting more registration can stay in the queue for an
+ * unlimited time until completion.
+ *
+ * If pinThreadsToNUMANodes is set, worker threads are distributed over the NUMA nodes of the
+ * machine in round-robin order and each worker is pinned to the CPUs of its node. This is a no-op
+ * on platforms that do not expose NUMA topology.
  */
 class TaskScheduler {
 public:
-    explicit TaskScheduler(uint64_t numThreads);
+    explicit TaskScheduler(uint64_t numThreads, bool pinThreadsToNUMANodes = false);
     ~TaskScheduler();
 
     // Functions for the users of the task scheduler, e.g., processor to use.
 
-    // Schedules the dependencies of the given task and finally the task one after another (so
-    // not concurrently), and throws an exception if any of the tasks errors. Regardless of
-    // whether or not the given task or one of its dependencies errors, when this function
-    // returns, no task related to the given task will be in the task queue. Further no worker
-    // thread will be working on the given task.
+    // Schedules the dependencies of the given task and finally the task, and throws an exception
+    // if any of the tasks errors. Dependencies are scheduled one after another (so not
+    // concurrently), unless the task marks its children as independent, in which case the
+    // dependency trees are scheduled concurrently and the task is scheduled once all of them have
+    // completed. The calling thread only schedules the tasks of the tree as their dependencies
+    // complete; all tasks are executed by the worker threads, each with its own maxNumThreads.
+    // Once a task errors, no further task of the tree is scheduled. Regardless of whether or not
+    // the given task or one of its dependencies errors, when this function returns, no task
+    // related to the given task will be in the task queue. Further no worker thread will be
+    // working on the given task.
     void scheduleTaskAndWaitOrError(
         const std::shared_ptr<Task>& task, processor::ExecutionContext* context);
 
     std::shared_ptr<ScheduledTask> scheduleTask(const std::shared_ptr<Task>& task);
 
+    inline uint64_t getNumWorkerThreads() const { return threads.size(); }
+
 private:
-    void removeErroringTask(uint64_t scheduledTaskID);
+    // Schedules the tasks of the given task tree that can start: the task itself if it has no
+    // children, otherwise the trees of all its children if they are independent, or else the tree
+    // of its first child.
+    void scheduleTaskTree(const std::shared_ptr<Task>& task,
+        std::vector<std::shared_ptr<ScheduledTask>>& scheduledTasks);
+    // Schedules the tasks that can start once the given task of the tree rooted at root has
+    // completed successfully: the next child of its parent, or the parent once all of its children
+    // have completed.
+    void scheduleTasksAfterCompletion(Task* completedTask, const std::shared_ptr<Task>& root,
+        std::unordered_map<Task*, uint64_t>& numCompletedChildren,
+        std::vector<std::shared_ptr<ScheduledTask>>& scheduledTasks);
+    // Blocks until one of the given tasks completes or the given timeout passes. Exceptions of
+    // tasks that have not completed yet are noticed after the timeout.
+    void waitForCompletionOfAnyTask(
+        const std::vector<std::shared_ptr<ScheduledTask>>& scheduledTasks,
+        uint64_t timeoutInMicros);
+
+    void removeScheduledTask(uint64_t scheduledTaskID);
 
     // Functions to launch worker threads and for the worker threads to use to grab task from queue.
-    void runWorkerThread();
-    std::shared_ptr<ScheduledTask> getTaskAndRegister();
+    void runWorkerThread(uint64_t workerID);
+    std::shared_ptr<ScheduledTask> getTaskAndRegister(uint64_t workerID);
+    static std::shared_ptr<ScheduledTask> getTaskAndRegisterFromQueue(WorkerQueue& workerQueue);
+    // Blocks the worker until a task is scheduled after seenGeneration or the scheduler stops.
+    void waitForNewTask(uint64_t seenGeneration);
 
     void interruptTaskIfTimeOutNoLock(processor::ExecutionContext* context);
 
 private:
-    std::mutex mtx;
-    std::deque<std::shared_ptr<ScheduledTask>> taskQueue;
+    std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+    // idleMtx protects waiting on idleCV. taskGeneration is incremented every time a task is
+    // scheduled, so a worker that found no task can tell whether it missed a new one.
+    std::mutex idleMtx;
+    std::condition_variable idleCV;
+    std::atomic<uint64_t> taskGeneration{0};
     std::atomic<bool> stopThreads{false};
+    // Notified by workers when a task completes, so the threads driving task trees wake up.
+    std::mutex completionMtx;
+    std::condition_variable completionCV;
     std::vector<std::thread> threads;
-    uint64_t nextScheduledTaskID;
+    std::atomic<uint64_t> nextScheduledTaskID;
 };
 
 } // namespace common
@@ -49,6 +49,46 @@ public:
     }
 };
 
+// Values packed with a fixed bit width, one after the other, starting from the least significant
+// bit of each byte.
+class BitPackingUtils {
+
+public:
+    // Writes the bitWidth least significant bits of value at bitOffset. The bits around the value
+    // are kept.
+    static inline void packValue(
+        uint8_t* buffer, uint64_t bitOffset, uint64_t bitWidth, uint64_t value) {
+        while (bitWidth > 0) {
+            auto bytePos = bitOffset >> 3;
+            auto shift = bitOffset & 7;
+            auto numBits = std::min<uint64_t>(8 - shift, bitWidth);
+            auto mask = (uint8_t)(BitmaskUtils::all1sMaskForLeastSignificantBits(numBits) << shift);
+            buffer[bytePos] = (buffer[bytePos] & ~mask) | ((uint8_t)(value << shift) & mask);
+            value >>= numBits;
+            bitOffset += numBits;
+            bitWidth -= numBits;
+        }
+    }
+
+    // Reads the value of bitWidth bits at bitOffset of a buffer of bufferSize bytes. The value is
+    // read with a single unaligned 64-bit load (two if it spans 9 bytes), so the loops unpacking
+    // consecutive values are free of data-dependent branches.
+    static inline uint64_t unpackValue(
+        const uint8_t* buffer, uint64_t bufferSize, uint64_t bitOffset, uint64_t bitWidth) {
+        auto bytePos = bitOffset >> 3;
+        auto shift = bitOffset & 7;
+        uint64_t word = 0;
+        // Bytes beyond the end of the buffer are never part of a value.
+        memcpy(&word, buffer + bytePos, std::min<uint64_t>(sizeof(uint64_t), bufferSize - bytePos));
+        auto mask = BitmaskUtils::all1sMaskForLeastSignificantBits(bitWidth);
+        auto value = (word >> shift) & mask;
+        if (shift + bitWidth > 64) {
+            value |= ((uint64_t)buffer[bytePos + sizeof(uint64_t)] << (64 - shift)) & mask;
+        }
+        return value;
+    }
+};
+
 static uint64_t nextPowerOfTwo(uint64_t v) {
     v--;
     v |= v >> 1;
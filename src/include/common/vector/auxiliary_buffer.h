@@ -7,6 +7,10 @@ class Array;
 }
 
 namespace kuzu {
+namespace storage {
+class StringDictionary;
+}
+
 namespace common {
 
 class ValueVector;
@@ -29,8 +33,23 @@ public:
     }
     inline void resetOverflowBuffer() const { inMemOverflowBuffer->resetBuffer(); }
 
+    inline const storage::StringDictionary* getDictionary() const { return dictionary; }
+    inline void setDictionary(const storage::StringDictionary* dictionary_) {
+        dictionary = dictionary_;
+    }
+    inline uint32_t* getDictionaryCodes() {
+        if (!dictionaryCodes) {
+            dictionaryCodes = std::make_unique<uint32_t[]>(DEFAULT_VECTOR_CAPACITY);
+        }
+        return dictionaryCodes.get();
+    }
+
 private:
     std::unique_ptr<InMemOverflowBuffer> inMemOverflowBuffer;
+    // Set by scans of dictionary-encoded columns, which also set the code of each value. Codes are
+    // only valid at the non-null positions of the scan. See `StringDictionary`.
+    const storage::StringDictionary* dictionary = nullptr;
+    std::unique_ptr<uint32_t[]> dictionaryCodes;
 };
 
 class StructAuxiliaryBuffer : public AuxiliaryBuffer {
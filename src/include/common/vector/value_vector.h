@@ -104,6 +104,25 @@ public:
             ->getOverflowBuffer();
     }
 
+    // The dictionary of the values of vectors that are scanned from dictionary-encoded columns, and
+    // nullptr otherwise.
+    static inline const storage::StringDictionary* getDictionary(const ValueVector* vector) {
+        assert(vector->dataType.getPhysicalType() == PhysicalTypeID::STRING);
+        return reinterpret_cast<StringAuxiliaryBuffer*>(vector->auxiliaryBuffer.get())
+            ->getDictionary();
+    }
+    static inline void setDictionary(
+        ValueVector* vector, const storage::StringDictionary* dictionary) {
+        assert(vector->dataType.getPhysicalType() == PhysicalTypeID::STRING);
+        reinterpret_cast<StringAuxiliaryBuffer*>(vector->auxiliaryBuffer.get())
+            ->setDictionary(dictionary);
+    }
+    static inline uint32_t* getDictionaryCodes(const ValueVector* vector) {
+        assert(vector->dataType.getPhysicalType() == PhysicalTypeID::STRING);
+        return reinterpret_cast<StringAuxiliaryBuffer*>(vector->auxiliaryBuffer.get())
+            ->getDictionaryCodes();
+    }
+
     static void addString(ValueVector* vector, uint32_t vectorPos, ku_string_t& srcStr);
     static void addString(
         ValueVector* vector, uint32_t vectorPos, const char* srcStr, uint64_t length);
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "common/vector/value_vector.h"
+
+namespace kuzu {
+namespace function {
+
+// Evaluates EQUALS and NOT_EQUALS between the strings of a vector scanned from a
+// dictionary-encoded column and a flat string, e.g., a literal, on dictionary codes. The code of
+// the flat string is looked up once, and values that are not in the dictionary are compared as
+// strings. See `StringDictionary`.
+struct DictionaryStringComparison {
+    static bool canCompareOnCodes(
+        const common::ValueVector& left, const common::ValueVector& right);
+
+    static void execute(const common::ValueVector& left, const common::ValueVector& right,
+        common::ValueVector& result, bool isNotEquals);
+
+    static bool select(const common::ValueVector& left, const common::ValueVector& right,
+        common::SelectionVector& selVector, bool isNotEquals);
+};
+
+} // namespace function
+} // namespace kuzu
@@ -2,6 +2,7 @@
 
 #include "binder/expression/expression.h"
 #include "comparison_functions.h"
+#include "dictionary_string_comparison.h"
 #include "function/vector_functions.h"
 
 namespace kuzu {
@@ -48,6 +49,44 @@ private:
             *params[0], *params[1], selVector);
     }
 
+    // EQUALS and NOT_EQUALS of dictionary-encoded strings are evaluated on dictionary codes.
+    template<typename FUNC>
+    static constexpr bool isEqualityComparison() {
+        return std::is_same_v<FUNC, Equals> || std::is_same_v<FUNC, NotEquals>;
+    }
+
+    template<typename FUNC>
+    static void StringComparisonExecFunction(
+        const std::vector<std::shared_ptr<common::ValueVector>>& params,
+        common::ValueVector& result) {
+        assert(params.size() == 2);
+        if constexpr (isEqualityComparison<FUNC>()) {
+            if (DictionaryStringComparison::canCompareOnCodes(*params[0], *params[1])) {
+                result.resetAuxiliaryBuffer();
+                DictionaryStringComparison::execute(*params[0], *params[1], result,
+                    std::is_same_v<FUNC, NotEquals> /* isNotEquals */);
+                return;
+            }
+        }
+        BinaryComparisonExecFunction<common::ku_string_t, common::ku_string_t, uint8_t, FUNC>(
+            params, result);
+    }
+
+    template<typename FUNC>
+    static bool StringComparisonSelectFunction(
+        const std::vector<std::shared_ptr<common::ValueVector>>& params,
+        common::SelectionVector& selVector) {
+        assert(params.size() == 2);
+        if constexpr (isEqualityComparison<FUNC>()) {
+            if (DictionaryStringComparison::canCompareOnCodes(*params[0], *params[1])) {
+                return DictionaryStringComparison::select(*params[0], *params[1], selVector,
+                    std::is_same_v<FUNC, NotEquals> /* isNotEquals */);
+            }
+        }
+        return BinaryComparisonSelectFunction<common::ku_string_t, common::ku_string_t, FUNC>(
+            params, selVector);
+    }
+
     template<typename FUNC>
     static inline std::unique_ptr<VectorFunctionDefinition> getDefinition(
         const std::string& name, common::LogicalType leftType, common::LogicalType rightType) {
@@ -86,8 +125,7 @@ private:
             func = BinaryComparisonExecFunction<uint8_t, uint8_t, uint8_t, FUNC>;
         } break;
         case common::PhysicalTypeID::STRING: {
-            func = BinaryComparisonExecFunction<common::ku_string_t, common::ku_string_t, uint8_t,
-                FUNC>;
+            func = StringComparisonExecFunction<FUNC>;
         } break;
         case common::PhysicalTypeID::INTERNAL_ID: {
             func = BinaryComparisonExecFunction<common::nodeID_t, common::nodeID_t, uint8_t, FUNC>;
@@ -136,7 +174,7 @@ private:
             func = BinaryComparisonSelectFunction<uint8_t, uint8_t, FUNC>;
         } break;
         case common::PhysicalTypeID::STRING: {
-            func = BinaryComparisonSelectFunction<common::ku_string_t, common::ku_string_t, FUNC>;
+            func = StringComparisonSelectFunction<FUNC>;
         } break;
         case common::PhysicalTypeID::INTERNAL_ID: {
             func = BinaryComparisonSelectFunction<common::nodeID_t, common::nodeID_t, FUNC>;
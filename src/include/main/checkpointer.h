@@ -0,0 +1,82 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "kuzu_fwd.h"
+
+namespace kuzu {
+namespace main {
+
+/**
+ * Checkpointer checkpoints committed write transactions in a background thread. A write transaction
+ * is committed once its commit record is durable in the WAL, and it stays the active write
+ * transaction until its checkpoint applies the WAL to the database files and clears the WAL.
+ *
+ * Until then, read transactions keep reading the last checkpointed version through the versioned
+ * file handles, so the checkpointer first waits up to maxCheckpointDelayInMs for them to leave on
+ * their own. Only then, or as soon as a new transaction waits for the checkpoint, it stops new
+ * transactions from starting and waits for the remaining read transactions to leave. If they don't
+ * leave within the timeout of the TransactionManager, new transactions are allowed to start again
+ * and the checkpoint is retried.
+ *
+ * Note: Our concurrency model has only 2 versions, so the WAL holds at most one committed write
+ * transaction and new write transactions wait for the checkpoint of the previous one.
+ */
+class Checkpointer {
+public:
+    // checkpointFunc applies the WAL of the committed write transaction and clears the WAL.
+    Checkpointer(transaction::TransactionManager& transactionManager,
+        uint64_t maxCheckpointDelayInMs, std::function<void()> checkpointFunc);
+    // Checkpoints the scheduled write transaction, if any, before returning.
+    ~Checkpointer();
+
+    // Returns the sequence number of the checkpoint, which is passed to `waitForCheckpoint`.
+    uint64_t scheduleCheckpoint(std::unique_ptr<transaction::Transaction> writeTransaction);
+    // Waits until the checkpoints up to the given one complete. Throws if they don't complete
+    // within the timeout of the TransactionManager, or if one of them failed, in which case the WAL
+    // is replayed when the database is opened again.
+    void waitForCheckpoint(uint64_t checkpointSeq);
+    inline void waitForScheduledCheckpoint() { waitForCheckpoint(getNumScheduledCheckpoints()); }
+
+    inline uint64_t getNumScheduledCheckpoints() {
+        std::unique_lock lck{mtx};
+        return numScheduledCheckpoints;
+    }
+    inline uint64_t getNumCompletedCheckpoints() {
+        std::unique_lock lck{mtx};
+        return numCompletedCheckpoints;
+    }
+
+private:
+    void runCheckpointLoop();
+    // Waits for read transactions to leave without blocking new transactions, until none is left,
+    // the checkpoint delay passes or a transaction waits for the checkpoint.
+    void waitForReadTransactionsToLeave(std::unique_lock<std::mutex>& lck);
+    // Returns false if read transactions didn't leave within the timeout.
+    bool tryCheckpoint();
+
+private:
+    std::shared_ptr<spdlog::logger> logger;
+    transaction::TransactionManager& transactionManager;
+    uint64_t maxCheckpointDelayInMs;
+    std::function<void()> checkpointFunc;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::unique_ptr<transaction::Transaction> writeTransactionToCheckpoint;
+    uint64_t numScheduledCheckpoints;
+    uint64_t numCompletedCheckpoints;
+    uint64_t numWaitingTransactions;
+    // The first failed checkpoint and its error. Later transactions can't be checkpointed either.
+    uint64_t failedCheckpointSeq;
+    std::string error;
+    bool stopped;
+    std::thread checkpointThread;
+};
+
+} // namespace main
+} // namespace kuzu
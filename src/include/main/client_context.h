@@ -29,6 +29,8 @@ class ClientContext {
     friend class testing::TinySnbCopyCSVTransactionTest;
     friend class ThreadsSetting;
     friend class TimeoutSetting;
+    friend class CopyRelBufferSizeSetting;
+    friend class OrderByMemoryBudgetSetting;
 
 public:
     explicit ClientContext();
@@ -49,12 +51,18 @@ public:
 
     std::string getCurrentSetting(std::string optionName);
 
+    inline uint64_t getCopyRelBufferSize() const { return copyRelBufferSize; }
+
+    inline uint64_t getOrderByMemoryBudget() const { return orderByMemoryBudget; }
+
 private:
     inline void resetActiveQuery() { activeQuery.reset(); }
 
     uint64_t numThreadsForExecution;
     ActiveQuery activeQuery;
     uint64_t timeoutInMS;
+    uint64_t copyRelBufferSize;
+    uint64_t orderByMemoryBudget;
 };
 
 } // namespace main
@@ -240,6 +240,9 @@ protected:
     std::unique_ptr<ClientContext> clientContext;
     std::unique_ptr<transaction::Transaction> activeTransaction;
     ConnectionTransactionMode transactionMode;
+    // The checkpoint of the last write transaction committed by the connection. See
+    // `Database::waitForCheckpointIfNecessary`.
+    uint64_t lastCommittedCheckpointSeq = 0;
     std::mutex mtx;
 };
 
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include "common/api.h"
 #include "common/constants.h"
@@ -10,6 +11,8 @@
 namespace kuzu {
 namespace main {
 
+class Checkpointer;
+
 /**
  * @brief Stores buffer pool size and max number of threads configurations.
  */
@@ -26,6 +29,22 @@ KUZU_API struct SystemConfig {
 
     uint64_t bufferPoolSize;
     uint64_t maxNumThreads;
+    // Pins the query worker threads to the CPUs of the NUMA nodes (round-robin). Linux only.
+    bool pinThreadsToNUMANodes = false;
+    // Replacement policy of the buffer pool. SCAN_RESISTANT keeps pages read by sequential scans
+    // from evicting pages that are repeatedly accessed, e.g., by point lookups.
+    common::EvictionPolicy evictionPolicy = common::EvictionPolicy::SECOND_CHANCE;
+    // Whether commits of write transactions wait for their files to be synced to disk. See
+    // `common::DurabilityMode`. The RELAXED mode requires enableBackgroundCheckpointing.
+    common::DurabilityMode durabilityMode = common::DurabilityMode::SYNC;
+    // The max time that committed files stay unsynced under the RELAXED durability mode.
+    uint64_t relaxedDurabilitySyncIntervalInMs =
+        common::TransactionConstants::RELAXED_DURABILITY_SYNC_INTERVAL_IN_MS;
+    // Checkpoints committed write transactions in a background thread, so commits return once
+    // their WAL is durable instead of waiting for read transactions to leave. See `Checkpointer`.
+    bool enableBackgroundCheckpointing = false;
+    uint64_t maxBackgroundCheckpointDelayInMs =
+        common::TransactionConstants::MAX_BACKGROUND_CHECKPOINT_DELAY_IN_MS;
 };
 
 /**
@@ -72,7 +91,16 @@ private:
     // skipCheckpointForTestingRecovery is used to simulate a failure before checkpointing in tests.
     void commit(transaction::Transaction* transaction, bool skipCheckpointForTestingRecovery);
     void rollback(transaction::Transaction* transaction, bool skipCheckpointForTestingRecovery);
+    // With background checkpointing, write transactions wait for the scheduled checkpoint before
+    // they start, and read transactions wait for the given checkpoint, i.e., the checkpoint of the
+    // last write transaction of their connection, so they read the writes of their connection.
+    void waitForCheckpointIfNecessary(transaction::TransactionType type, uint64_t checkpointSeq);
+    uint64_t getNumScheduledCheckpoints() const;
+    void checkpointCommittedTransaction();
     void checkpointAndClearWAL(storage::WALReplayMode walReplayMode);
+    // Syncs the files to disk, or requests a background sync under the RELAXED durability mode
+    // unless waitForSync is set.
+    void syncCommittedFiles(const std::vector<std::string>& filePaths, bool waitForSync = false);
     void rollbackAndClearWAL();
     void recoverIfNecessary();
 
@@ -86,6 +114,14 @@ private:
     std::unique_ptr<storage::StorageManager> storageManager;
     std::unique_ptr<transaction::TransactionManager> transactionManager;
     std::unique_ptr<storage::WAL> wal;
+    std::unique_ptr<storage::CommitSyncer> commitSyncer;
+    // Latencies of the commits of write transactions, of the file syncs they wait for and of their
+    // checkpoints.
+    std::unique_ptr<common::LatencyHistogram> commitLatencyHistogram;
+    std::unique_ptr<common::LatencyHistogram> commitSyncLatencyHistogram;
+    std::unique_ptr<common::LatencyHistogram> checkpointLatencyHistogram;
+    // Reset first by the destructor, while the storage that it checkpoints is alive.
+    std::unique_ptr<Checkpointer> checkpointer;
     std::shared_ptr<spdlog::logger> logger;
 };
 
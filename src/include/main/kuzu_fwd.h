@@ -27,12 +27,14 @@ class Catalog;
 
 namespace common {
 enum class StatementType : uint8_t;
+class LatencyHistogram;
 class Value;
 } // namespace common
 
 namespace storage {
 class MemoryManager;
 class BufferManager;
+class CommitSyncer;
 class StorageManager;
 class WAL;
 enum class WALReplayMode : uint8_t;
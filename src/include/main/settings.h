@@ -31,5 +31,29 @@ struct TimeoutSetting {
     }
 };
 
+struct CopyRelBufferSizeSetting {
+    static constexpr const char* name = "copy_rel_buffer_size";
+    static constexpr const common::LogicalTypeID inputType = common::LogicalTypeID::INT64;
+    static void setContext(ClientContext* context, const common::Value& parameter) {
+        assert(parameter.getDataType()->getLogicalTypeID() == common::LogicalTypeID::INT64);
+        context->copyRelBufferSize = parameter.getValue<int64_t>();
+    }
+    static std::string getSetting(ClientContext* context) {
+        return std::to_string(context->copyRelBufferSize);
+    }
+};
+
+struct OrderByMemoryBudgetSetting {
+    static constexpr const char* name = "order_by_memory_budget";
+    static constexpr const common::LogicalTypeID inputType = common::LogicalTypeID::INT64;
+    static void setContext(ClientContext* context, const common::Value& parameter) {
+        assert(parameter.getDataType()->getLogicalTypeID() == common::LogicalTypeID::INT64);
+        context->orderByMemoryBudget = parameter.getValue<int64_t>();
+    }
+    static std::string getSetting(ClientContext* context) {
+        return std::to_string(context->orderByMemoryBudget);
+    }
+};
+
 } // namespace main
 } // namespace kuzu
@@ -2,6 +2,7 @@
 
 #include "binder/expression/node_expression.h"
 #include "logical_operator_visitor.h"
+#include "planner/logical_plan/logical_operator/logical_scan_node.h"
 #include "planner/logical_plan/logical_plan.h"
 
 namespace kuzu {
@@ -40,6 +41,10 @@ private:
         std::shared_ptr<binder::NodeExpression> node, std::shared_ptr<binder::Expression> predicate,
         std::shared_ptr<planner::LogicalOperator> child);
 
+    // Add the predicates that can skip morsels with zone maps to SCAN_NODE_ID. The predicates are
+    // still pushed down as filters.
+    void addZoneMapPredicates(planner::LogicalScanNode* scanNode);
+
     // Finish the current push down optimization by apply remaining predicates as a single filter.
     // And heuristically reorder equality predicates first in the filter.
     std::shared_ptr<planner::LogicalOperator> finishPushDown(
@@ -30,13 +30,31 @@ public:
         return children[0]->getSchema()->getExpressionsInScope();
     }
 
+    // If ORDER BY is followed by LIMIT, only the first (skip + limit) tuples need to be sorted.
+    inline void setLimitNumber(uint64_t number) {
+        hasLimit = true;
+        limitNumber = number;
+    }
+    inline bool hasLimitNumber() const { return hasLimit; }
+    inline uint64_t getLimitNumber() const {
+        assert(hasLimit);
+        return limitNumber;
+    }
+
     inline std::unique_ptr<LogicalOperator> copy() override {
-        return make_unique<LogicalOrderBy>(expressionsToOrderBy, isAscOrders, children[0]->copy());
+        auto orderBy =
+            make_unique<LogicalOrderBy>(expressionsToOrderBy, isAscOrders, children[0]->copy());
+        if (hasLimit) {
+            orderBy->setLimitNumber(limitNumber);
+        }
+        return orderBy;
     }
 
 private:
     binder::expression_vector expressionsToOrderBy;
     std::vector<bool> isAscOrders;
+    bool hasLimit = false;
+    uint64_t limitNumber = UINT64_MAX;
 };
 
 } // namespace planner
@@ -18,6 +18,8 @@ public:
           joinType{joinType}, recursiveChild{std::move(recursiveChild)} {}
 
     f_group_pos_set getGroupsPosToFlatten() override;
+    // Shortest path lengths from multiple bound nodes are computed by a single BFS.
+    bool isMultiSourceBFS() const;
 
     void computeFactorizedSchema() override;
     void computeFlatSchema() override;
@@ -25,15 +27,27 @@ public:
     inline void setJoinType(RecursiveJoinType joinType_) { joinType = joinType_; }
     inline RecursiveJoinType getJoinType() const { return joinType; }
     inline std::shared_ptr<LogicalOperator> getRecursiveChild() const { return recursiveChild; }
+    inline void setReverseRecursiveChild(std::shared_ptr<LogicalOperator> child) {
+        reverseRecursiveChild = std::move(child);
+    }
+    inline std::shared_ptr<LogicalOperator> getReverseRecursiveChild() const {
+        return reverseRecursiveChild;
+    }
 
     inline std::unique_ptr<LogicalOperator> copy() override {
-        return std::make_unique<LogicalRecursiveExtend>(boundNode, nbrNode, rel, direction,
+        auto result = std::make_unique<LogicalRecursiveExtend>(boundNode, nbrNode, rel, direction,
             joinType, children[0]->copy(), recursiveChild->copy());
+        if (reverseRecursiveChild != nullptr) {
+            result->setReverseRecursiveChild(reverseRecursiveChild->copy());
+        }
+        return result;
     }
 
 private:
     RecursiveJoinType joinType;
     std::shared_ptr<LogicalOperator> recursiveChild;
+    // Extends from the nodeCopy of the recursive info to its node. Only set for shortest paths.
+    std::shared_ptr<LogicalOperator> reverseRecursiveChild;
 };
 
 class LogicalPathPropertyProbe : public LogicalOperator {
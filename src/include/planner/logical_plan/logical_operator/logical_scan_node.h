@@ -8,22 +8,32 @@ namespace planner {
 
 class LogicalScanNode : public LogicalOperator {
 public:
-    explicit LogicalScanNode(std::shared_ptr<binder::NodeExpression> node)
-        : LogicalOperator{LogicalOperatorType::SCAN_NODE}, node{std::move(node)} {}
+    explicit LogicalScanNode(std::shared_ptr<binder::NodeExpression> node,
+        binder::expression_vector zoneMapPredicates = binder::expression_vector{})
+        : LogicalOperator{LogicalOperatorType::SCAN_NODE}, node{std::move(node)},
+          zoneMapPredicates{std::move(zoneMapPredicates)} {}
 
     void computeFactorizedSchema() override;
     void computeFlatSchema() override;
 
-    inline std::string getExpressionsForPrinting() const override { return node->toString(); }
+    std::string getExpressionsForPrinting() const override;
 
     inline std::shared_ptr<binder::NodeExpression> getNode() const { return node; }
 
+    // Zone map predicates are predicates on the properties of the node that are also evaluated by
+    // filters above the scan. The scan skips the morsels whose zone maps can't satisfy them.
+    inline void addZoneMapPredicate(std::shared_ptr<binder::Expression> predicate) {
+        zoneMapPredicates.push_back(std::move(predicate));
+    }
+    inline binder::expression_vector getZoneMapPredicates() const { return zoneMapPredicates; }
+
     inline std::unique_ptr<LogicalOperator> copy() override {
-        return make_unique<LogicalScanNode>(node);
+        return make_unique<LogicalScanNode>(node, zoneMapPredicates);
     }
 
 private:
     std::shared_ptr<binder::NodeExpression> node;
+    binder::expression_vector zoneMapPredicates;
 };
 
 class LogicalIndexScanNode : public LogicalOperator {
@@ -7,6 +7,10 @@
 #include "transaction/transaction.h"
 
 namespace kuzu {
+namespace common {
+class TaskScheduler;
+} // namespace common
+
 namespace processor {
 
 struct ExecutionContext {
@@ -15,7 +19,8 @@ struct ExecutionContext {
         storage::MemoryManager* memoryManager, storage::BufferManager* bufferManager,
         main::ClientContext* clientContext)
         : numThreads{numThreads}, profiler{profiler}, memoryManager{memoryManager},
-          bufferManager{bufferManager}, transaction{nullptr}, clientContext{clientContext} {}
+          bufferManager{bufferManager}, transaction{nullptr}, clientContext{clientContext},
+          taskScheduler{nullptr} {}
 
     uint64_t numThreads;
     common::Profiler* profiler;
@@ -24,6 +29,9 @@ struct ExecutionContext {
 
     transaction::Transaction* transaction;
     main::ClientContext* clientContext;
+    // The scheduler that executes the plan. Operators can schedule their own tasks on it before the
+    // pipelines are executed, e.g. when their global states are initialized.
+    common::TaskScheduler* taskScheduler;
 };
 
 } // namespace processor
@@ -60,6 +60,25 @@ public:
 
     inline uint64_t getNumEntries() const { return factorizedTable->getNumTuples(); }
 
+    inline const std::vector<common::LogicalType>& getKeyDataTypes() const {
+        return keyDataTypes;
+    }
+    inline const std::vector<common::LogicalType>& getDependentKeyDataTypes() const {
+        return dependentKeyDataTypes;
+    }
+
+    //! the number of bytes of the hash slots and tuples.
+    inline uint64_t getNumBytes() const {
+        return (hashSlotsBlocks.size() + factorizedTable->getNumBlocks()) *
+               common::BufferPoolConstants::PAGE_256KB_SIZE;
+    }
+
+    //! Distinct hash tables are deduplicated across threads by the aggregate shared state instead
+    //! of through merge(), so the caller takes over their ownership.
+    inline std::vector<std::unique_ptr<AggregateHashTable>> moveDistinctHashTables() {
+        return std::move(distinctHashTables);
+    }
+
     inline void append(const std::vector<common::ValueVector*>& groupByFlatKeyVectors,
         const std::vector<common::ValueVector*>& groupByUnFlatKeyVectors,
         const std::vector<std::unique_ptr<AggregateInput>>& aggregateInputs,
@@ -81,11 +100,32 @@ public:
 
     //! merge aggregate hash table by combining aggregate states under the same key
     void merge(AggregateHashTable& other);
+    //! merge the given tuples of other.
+    void merge(AggregateHashTable& other, const std::vector<ft_tuple_idx_t>& otherTupleIdxes);
+
+    //! partition tuples by the most significant bits of their hash values
+    std::vector<std::vector<ft_tuple_idx_t>> partitionTuplesByHash(uint64_t numPartitionsLog2);
+    // ! The following function will only be used by distinct hash tables.
+    //! append tuples of other that do not exist in this table and return their indexes in other.
+    //! Var-sized values are copied into this table, so other can be freed afterwards.
+    std::vector<ft_tuple_idx_t> appendDistinctTuples(
+        AggregateHashTable& other, const std::vector<ft_tuple_idx_t>& otherTupleIdxes);
+
+    //! update the state of a distinct aggregate function with the given tuples of a distinct hash
+    //! table. The group by keys of these tuples must already exist in this table.
+    void combineDistinctAggState(uint32_t aggregateFunctionIdx, AggregateHashTable& distinctHT,
+        const std::vector<ft_tuple_idx_t>& tupleIdxes);
 
     void finalizeAggregateStates();
 
     void resize(uint64_t newSize);
 
+    //! unpin the hash slots and tuples so that they can be spilled under memory pressure. The
+    //! table must not be accessed until it is pinned again.
+    void unpinBlocks();
+    //! pin the hash slots and tuples, and return the number of bytes read back from disk.
+    uint64_t pinBlocks();
+
 private:
     void initializeFT(
         const std::vector<std::unique_ptr<function::AggregateFunction>>& aggregateFunctions);
@@ -94,10 +134,14 @@ private:
 
     void initializeTmpVectors();
 
+    void mergeTuples(AggregateHashTable& other,
+        const std::function<ft_tuple_idx_t(uint64_t)>& getOtherTupleIdx, uint64_t numTuples);
+
     // ! This function will only be used by distinct aggregate, which assumes that all groupByKeys
     // are flat.
     uint8_t* findEntryInDistinctHT(
         const std::vector<common::ValueVector*>& groupByKeyVectors, common::hash_t hash);
+    uint8_t* findEntryInDistinctHT(const uint8_t* otherEntry, common::hash_t hash);
 
     void initializeFTEntryWithFlatVec(
         common::ValueVector* groupByFlatVector, uint64_t numEntriesToInitialize, uint32_t colIdx);
@@ -149,6 +193,8 @@ private:
     // are flat.
     bool matchFlatGroupByKeys(const std::vector<common::ValueVector*>& keyVectors, uint8_t* entry);
 
+    bool matchDistinctEntries(const uint8_t* entry, const uint8_t* otherEntry);
+
     uint64_t matchUnflatVecWithFTColumn(common::ValueVector* vector, uint64_t numMayMatches,
         uint64_t& numNoMatches, uint32_t colIdx);
 
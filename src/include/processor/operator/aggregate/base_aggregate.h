@@ -1,5 +1,6 @@
 #pragma once
 
+#include "aggregate_hash_table.h"
 #include "aggregate_input.h"
 #include "function/aggregate/aggregate_function.h"
 #include "processor/operator/sink.h"
@@ -7,19 +8,40 @@
 namespace kuzu {
 namespace processor {
 
+struct DistinctHashTablePartition {
+    std::mutex mtx;
+    std::unique_ptr<AggregateHashTable> hashTable;
+};
+
 class BaseAggregateSharedState {
+public:
+    // Each thread builds its own distinct hash tables. Once a thread is done, its distinct tuples
+    // are radix partitioned by hash and deduplicated against the shared partitions. Partitions are
+    // locked separately, so threads finishing at the same time merge different partitions in
+    // parallel. Returns, for each local table, the indexes of its tuples that no thread has seen
+    // before, in the order they were appended to the table. The thread updates its aggregate
+    // states with these tuples and can then free its local tables, since the partitions copy the
+    // values they keep.
+    std::vector<std::vector<ft_tuple_idx_t>> combineDistinctHashTables(
+        const std::vector<std::unique_ptr<AggregateHashTable>>& localDistinctHashTables,
+        storage::MemoryManager& memoryManager);
+
 protected:
     explicit BaseAggregateSharedState(
         const std::vector<std::unique_ptr<function::AggregateFunction>>& aggregateFunctions);
 
-    virtual std::pair<uint64_t, uint64_t> getNextRangeToRead() = 0;
-
     virtual ~BaseAggregateSharedState() {}
 
 protected:
+    static constexpr uint64_t DISTINCT_NUM_PARTITIONS_LOG2 = 4;
+
     std::mutex mtx;
     uint64_t currentOffset;
     std::vector<std::unique_ptr<function::AggregateFunction>> aggregateFunctions;
+    // Partitions of the distinct hash table of each distinct aggregate function. Empty for
+    // non-distinct aggregate functions.
+    std::vector<std::vector<std::unique_ptr<DistinctHashTablePartition>>> distinctPartitions;
+    uint64_t numCombinedDistinctHashTables;
 };
 
 class BaseAggregate : public Sink {
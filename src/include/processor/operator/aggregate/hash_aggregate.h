@@ -6,28 +6,45 @@
 namespace kuzu {
 namespace processor {
 
+// The local hash tables of all threads are combined into a global hash table if they fit in the
+// HASH_AGGREGATE_MEMORY_RATIO of the buffer pool. Otherwise, each local hash table is split into
+// radix partitions by the hash of its group by keys, which are unpinned so that they can be
+// spilled, and the global hash table is combined one partition at a time, so that only one
+// partition of the global table and one partition of a local table need to be in memory. The
+// partitions of the global table are then read one at a time. Each local hash table still needs
+// to fit in memory.
 class HashAggregateSharedState : public BaseAggregateSharedState {
 
 public:
     explicit HashAggregateSharedState(
         const std::vector<std::unique_ptr<function::AggregateFunction>>& aggregateFunctions)
-        : BaseAggregateSharedState{aggregateFunctions} {}
+        : BaseAggregateSharedState{aggregateFunctions}, currentPartitionIdx{0},
+          numThreadsReadingRanges{0} {}
 
     void appendAggregateHashTable(std::unique_ptr<AggregateHashTable> aggregateHashTable);
 
-    void combineAggregateHashTable(storage::MemoryManager& memoryManager);
+    // Combines the local hash tables and finalizes the aggregate states. Returns the number of
+    // bytes read back from the spill file.
+    uint64_t combineAggregateHashTable(storage::MemoryManager& memoryManager);
 
-    void finalizeAggregateHashTable();
+    // Returns the table of the next range of entries to read, or nullptr once all entries are
+    // read. The table stays in memory until the range is released.
+    std::tuple<AggregateHashTable*, uint64_t, uint64_t> getNextRangeToRead();
+    void releaseRangeToRead();
 
-    std::pair<uint64_t, uint64_t> getNextRangeToRead() override;
-
-    inline uint8_t* getRow(uint64_t idx) { return globalAggregateHashTable->getEntry(idx); }
-
-    FactorizedTable* getFactorizedTable() { return globalAggregateHashTable->getFactorizedTable(); }
+private:
+    uint64_t combineAggregateHashTablePartitions(storage::MemoryManager& memoryManager);
 
 private:
+    static constexpr uint64_t NUM_PARTITIONS_LOG2 = 4;
+
     std::vector<std::unique_ptr<AggregateHashTable>> localAggregateHashTables;
-    std::unique_ptr<AggregateHashTable> globalAggregateHashTable;
+    // The global hash table, or its non-empty partitions if they are combined one at a time. Only
+    // the partition being read is pinned.
+    std::vector<std::unique_ptr<AggregateHashTable>> globalAggregateHashTables;
+    uint64_t currentPartitionIdx;
+    uint64_t numThreadsReadingRanges;
+    std::condition_variable rangeReleased;
 };
 
 class HashAggregate : public BaseAggregate {
@@ -17,7 +17,7 @@ public:
 
     void finalizeAggregateStates();
 
-    std::pair<uint64_t, uint64_t> getNextRangeToRead() override;
+    std::pair<uint64_t, uint64_t> getNextRangeToRead();
 
     inline function::AggregateState* getAggregateState(uint64_t idx) {
         return globalAggregateStates[idx].get();
@@ -52,9 +52,11 @@ public:
     }
 
 private:
-    void computeDistinctAggregate(AggregateHashTable* distinctHT,
-        function::AggregateFunction* function, AggregateInput* input,
-        function::AggregateState* state, storage::MemoryManager* memoryManager);
+    void computeDistinctAggregate(AggregateHashTable* distinctHT, AggregateInput* input);
+    // Updates the local state of a distinct aggregate function with the given tuples of its
+    // distinct hash table.
+    void updateDistinctAggregateState(uint32_t aggregateFunctionIdx,
+        const std::vector<ft_tuple_idx_t>& tupleIdxes, storage::MemoryManager* memoryManager);
     void computeAggregate(function::AggregateFunction* function, AggregateInput* input,
         function::AggregateState* state, storage::MemoryManager* memoryManager);
 
@@ -16,8 +16,7 @@ public:
 
     inline std::shared_ptr<arrow::RecordBatch> readTuples(
         std::unique_ptr<storage::ReadFileMorsel> morsel) override {
-        auto csvMorsel = reinterpret_cast<storage::ReadCSVMorsel*>(morsel.get());
-        return csvMorsel->recordBatch;
+        return reinterpret_cast<storage::ReadCSVMorsel*>(morsel.get())->readRecordBatch();
     }
 
     inline std::unique_ptr<PhysicalOperator> clone() override {
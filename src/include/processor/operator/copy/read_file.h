@@ -19,7 +19,7 @@ public:
     void initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) override;
 
     inline void initGlobalStateInternal(kuzu::processor::ExecutionContext* context) override {
-        sharedState->countNumRows();
+        sharedState->countNumRows(context);
     }
 
     inline bool isSource() const override { return true; }
@@ -27,6 +27,8 @@ private:
                dataChunkToFlatten->state->currIdx == (prevSelVector->selectedSize - 1);
     }
     void resetToCurrentSelVector(std::shared_ptr<common::SelectionVector>& selVector) override;
+    // The selection vector of the flattened chunk is restored by the next getNextTuple().
+    inline void resetInputStateInternal() final { dataChunkToFlatten->state->currIdx = -1; }
 
 private:
     uint32_t dataChunkToFlattenPos;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/task_system/task.h"
 #include "function/hash/hash_functions.h"
 #include "join_hash_table.h"
 #include "processor/operator/physical_operator.h"
@@ -18,10 +19,14 @@ class HashJoinBuild;
 // HashJoinBuild thread when they finished materializing thread-local tuples. Also, the state holds
 // a global htDirectory, which will be updated by the last thread in the hash join build side
 // task/pipeline, and probed by the HashJoinProbe operators.
+// Spilled partitions of the hash table are loaded for the HashJoinProbe threads that probe them,
+// one partition at a time. A thread holds the loaded partition until it releases it, and other
+// threads wait to load another partition until no thread holds the loaded one.
 class HashJoinSharedState {
 public:
     explicit HashJoinSharedState(std::unique_ptr<JoinHashTable> hashTable)
-        : hashTable{std::move(hashTable)} {};
+        : hashTable{std::move(hashTable)}, loadedPartitionIdx{UINT64_MAX},
+          numThreadsHoldingLoadedPartition{0} {};
 
     virtual ~HashJoinSharedState() = default;
 
@@ -29,9 +34,50 @@ public:
 
     inline JoinHashTable* getHashTable() { return hashTable.get(); }
 
+    // Returns the number of bytes read back from the spill file to load the partition.
+    uint64_t acquireSpilledPartition(uint64_t partitionIdx);
+    void releaseSpilledPartition();
+
 protected:
     std::mutex mtx;
     std::unique_ptr<JoinHashTable> hashTable;
+    std::condition_variable spilledPartitionReleased;
+    uint64_t loadedPartitionIdx;
+    uint64_t numThreadsHoldingLoadedPartition;
+};
+
+// Scatters the tuples of the hash table of a HashJoinBuild into radix partitions, once all build
+// threads have merged their tuples into it. Each thread that registers to the task scatters
+// different tuple blocks.
+class HashJoinPartitionTuplesTask : public common::Task {
+public:
+    HashJoinPartitionTuplesTask(JoinHashTable* hashTable, uint64_t maxNumThreads)
+        : Task{maxNumThreads}, hashTable{hashTable} {}
+
+    inline void run() override {
+        std::vector<std::vector<uint8_t*>> partitionedTuples;
+        while (hashTable->partitionTuplesOfNextBlock(partitionedTuples)) {}
+        hashTable->appendPartitionedTuples(std::move(partitionedTuples));
+    }
+
+private:
+    JoinHashTable* hashTable;
+};
+
+// Builds the hash slots of the hash table of a HashJoinBuild from its partitioned tuples. Each
+// thread that registers to the task builds different partitions of the hash slots.
+class HashJoinBuildSlotsTask : public common::Task {
+public:
+    HashJoinBuildSlotsTask(JoinHashTable* hashTable, uint64_t maxNumThreads)
+        : Task{maxNumThreads}, hashTable{hashTable} {}
+
+    inline void run() override {
+        while (hashTable->buildHashSlotsOfNextPartition()) {}
+    }
+    inline void finalizeIfNecessary() override { hashTable->finishBuildingHashSlots(); }
+
+private:
+    JoinHashTable* hashTable;
 };
 
 class HashJoinBuildInfo {
@@ -89,8 +135,8 @@ public:
 
 protected:
     virtual void initLocalHashTable(storage::MemoryManager& memoryManager) {
-        hashTable = std::make_unique<JoinHashTable>(
-            memoryManager, info->getNumKeys(), info->tableSchema->copy());
+        hashTable = std::make_unique<JoinHashTable>(memoryManager, info->getNumKeys(),
+            info->tableSchema->copy(), sharedState->getHashTable()->canSpillPartitions());
     }
 
 protected:
@@ -36,6 +36,10 @@ public:
     ProbeDataInfo(const ProbeDataInfo& other)
         : ProbeDataInfo{other.keysDataPos, other.payloadsOutPos} {
         markDataPos = other.markDataPos;
+        probeSideDataPos = other.probeSideDataPos;
+        if (other.probeSideTableSchema != nullptr) {
+            probeSideTableSchema = other.probeSideTableSchema->copy();
+        }
     }
 
     inline uint32_t getNumPayloads() const { return payloadsOutPos.size(); }
@@ -44,9 +48,16 @@ public:
     std::vector<DataPos> keysDataPos;
     std::vector<DataPos> payloadsOutPos;
     DataPos markDataPos;
+    // The probe-side vectors, and the layout of the tables that keep the probe-side tuples whose
+    // keys are in spilled partitions of the hash table.
+    std::vector<DataPos> probeSideDataPos;
+    std::unique_ptr<FactorizedTableSchema> probeSideTableSchema;
 };
 
 // Probe side on left, i.e. children[0] and build side on right, i.e. children[1]
+// Probe-side tuples whose keys are in spilled partitions of the hash table are not probed while
+// the probe side is read. They are kept in one factorized table per partition instead, and are
+// probed once the probe side is exhausted, one partition at a time with the partition loaded.
 class HashJoinProbe : public PhysicalOperator, public SelVectorOverWriter {
 public:
     HashJoinProbe(std::shared_ptr<HashJoinSharedState> sharedState, common::JoinType joinType,
@@ -56,7 +67,8 @@ public:
         : PhysicalOperator{PhysicalOperatorType::HASH_JOIN_PROBE, std::move(probeChild),
               std::move(buildChild), id, paramsString},
           sharedState{std::move(sharedState)}, joinType{joinType}, flatProbe{flatProbe},
-          probeDataInfo{probeDataInfo} {}
+          probeDataInfo{probeDataInfo}, isProbingSpilledPartitions{false}, spilledPartitionIdx{0},
+          nextSpilledTupleIdx{0}, holdsSpilledPartition{false} {}
 
     // This constructor is used for cloning only.
     HashJoinProbe(std::shared_ptr<HashJoinSharedState> sharedState, common::JoinType joinType,
@@ -65,7 +77,10 @@ public:
         : PhysicalOperator{PhysicalOperatorType::HASH_JOIN_PROBE, std::move(probeChild), id,
               paramsString},
           sharedState{std::move(sharedState)}, joinType{joinType}, flatProbe{flatProbe},
-          probeDataInfo{probeDataInfo} {}
+          probeDataInfo{probeDataInfo}, isProbingSpilledPartitions{false}, spilledPartitionIdx{0},
+          nextSpilledTupleIdx{0}, holdsSpilledPartition{false} {}
+
+    ~HashJoinProbe() override;
 
     void initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) override;
 
@@ -84,6 +99,16 @@ private:
     bool getMatchedTuplesForFlatKey(ExecutionContext* context);
     // We can probe a batch of input tuples if we know they have at most one match.
     bool getMatchedTuplesForUnFlatKey(ExecutionContext* context);
+    // Reads the next probe-side tuples, from the child and then from the tables of the spilled
+    // partitions, and probes their keys. Returns false once all tuples are probed.
+    bool probeNextTuples(ExecutionContext* context);
+    // Keeps the tuples whose keys are in spilled partitions, and removes them from the probed
+    // keys. Returns false if all probed keys are removed.
+    bool keepTuplesOfSpilledPartitions();
+    void appendToSpilledTuples(uint64_t partitionIdx);
+    bool scanNextSpilledTuples(ExecutionContext* context);
+    uint64_t getMultiplicityOfSpilledTuple(FactorizedTable& table, ft_tuple_idx_t tupleIdx) const;
+    void releaseSpilledPartition();
 
     inline uint64_t getInnerJoinResult() {
         return flatProbe ? getInnerJoinResultForFlatKey() : getInnerJoinResultForUnFlatKey();
@@ -108,6 +133,20 @@ private:
 
     std::unique_ptr<common::ValueVector> hashVector;
     std::unique_ptr<common::ValueVector> tmpHashVector;
+
+    storage::MemoryManager* memoryManager;
+    std::vector<common::ValueVector*> probeSideVectors;
+    std::vector<ft_col_idx_t> probeSideColumnIdxs;
+    std::unique_ptr<common::ValueVector> multiplicityVector;
+    // The probe-side vectors and the multiplicity vector.
+    std::vector<common::ValueVector*> vectorsToSpill;
+    std::vector<std::unique_ptr<FactorizedTable>> spilledTuples;
+    std::shared_ptr<common::SelectionVector> spilledKeysSelVector;
+    std::unique_ptr<uint64_t[]> spillPartitionIdxes;
+    bool isProbingSpilledPartitions;
+    uint64_t spilledPartitionIdx;
+    ft_tuple_idx_t nextSpilledTupleIdx;
+    bool holdsSpilledPartition;
 };
 
 } // namespace processor
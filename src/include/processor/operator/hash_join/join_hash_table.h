@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "common/utils.h"
 #include "function/hash/hash_functions.h"
 #include "processor/operator/base_hash_table.h"
@@ -8,52 +11,156 @@
 namespace kuzu {
 namespace processor {
 
+// A hash table that can spill partitions appends the tuples of a thread-local table, once the table
+// holds more than one block of tuples, to NUM_SPILL_PARTITIONS tables by the most significant bits
+// of the hash of their keys. The tuples appended before stay in memory. When the partitions do not
+// all fit in memory, pinPartitions spills the partitions that do not fit. Their hash slots are not
+// built until the partition is loaded by loadSpilledPartition, and probing skips their keys, so
+// that the hash join probes the keys of the spilled partitions once all other keys are probed, one
+// loaded partition at a time. See `HashJoinProbe`.
 class JoinHashTable : public BaseHashTable {
 public:
     JoinHashTable(storage::MemoryManager& memoryManager, uint64_t numKeyColumns,
-        std::unique_ptr<FactorizedTableSchema> tableSchema);
+        std::unique_ptr<FactorizedTableSchema> tableSchema, bool canSpillPartitions = false);
 
     virtual ~JoinHashTable() = default;
 
     virtual void append(const std::vector<common::ValueVector*>& vectorsToAppend);
+    //! pin the tuples of the partitions that fit in memoryLimit bytes along with their hash slots,
+    //! and spill the other partitions. Returns the number of bytes read back from the spill file.
+    uint64_t pinPartitions(uint64_t memoryLimit);
     void allocateHashSlots(uint64_t numTuples);
-    void buildHashSlots();
+    //! scatter the tuples of the next tuple block that no thread has scattered yet into radix
+    //! partitions by their hash bits. Returns false once all blocks have been taken.
+    bool partitionTuplesOfNextBlock(std::vector<std::vector<uint8_t*>>& partitionedTuples);
+    //! publish the tuples scattered by one thread, so they are inserted into the hash slots.
+    void appendPartitionedTuples(std::vector<std::vector<uint8_t*>> partitionedTuples);
+    //! build the hash slots of the next partition that no thread has started building yet.
+    //! Partitions cover disjoint ranges of hash slots, so threads build them without
+    //! synchronization. Returns false once all partitions have been taken.
+    bool buildHashSlotsOfNextPartition();
+    //! release the scattered tuples once the hash slots of all partitions are built.
+    inline void finishBuildingHashSlots() { partitionedTuplesOfThreads.clear(); }
+    static inline uint64_t getNumRadixPartitions() {
+        return (uint64_t)1 << NUM_RADIX_PARTITIONS_LOG2;
+    }
 
-    void probe(const std::vector<common::ValueVector*>& keyVectors, common::ValueVector* hashVector,
-        common::ValueVector* tmpHashVector, uint8_t** probedTuples);
+    //! find the tuples of the hash slots of the keys. Keys of spilled partitions are not probed
+    //! unless probeSpilledPartition is set, in which case all keys must be in the loaded
+    //! partition. Returns false if no key is probed because all keys are null or the table is
+    //! empty.
+    bool probe(const std::vector<common::ValueVector*>& keyVectors, common::ValueVector* hashVector,
+        common::ValueVector* tmpHashVector, uint8_t** probedTuples,
+        bool probeSpilledPartition = false);
+    //! pin the tuples of a spilled partition and build its hash slots, so that its keys can be
+    //! probed. Returns the number of bytes read back from the spill file.
+    uint64_t loadSpilledPartition(uint64_t partitionIdx);
+    //! free the hash slots of a loaded spilled partition and unpin its tuples.
+    void unloadSpilledPartition(uint64_t partitionIdx);
+    inline bool hasSpilledPartitions() const {
+        return std::find(isPartitionSpilled.begin(), isPartitionSpilled.end(), true) !=
+               isPartitionSpilled.end();
+    }
+    inline bool isPartitionOfHashSpilled(common::hash_t hash) const {
+        return !isPartitionSpilled.empty() && isPartitionSpilled[getSpillPartitionIdx(hash)];
+    }
+    static inline uint64_t getSpillPartitionIdx(common::hash_t hash) {
+        return getPartitionIdx(hash, NUM_SPILL_PARTITIONS_LOG2);
+    }
+    inline bool canSpillPartitions() const { return canSpill; }
+    static inline uint64_t getNumSpillPartitions() {
+        return (uint64_t)1 << NUM_SPILL_PARTITIONS_LOG2;
+    }
 
     inline void lookup(std::vector<common::ValueVector*>& vectors,
         std::vector<uint32_t>& colIdxesToScan, uint8_t** tuplesToRead, uint64_t startPos,
         uint64_t numTuplesToRead) {
         factorizedTable->lookup(vectors, colIdxesToScan, tuplesToRead, startPos, numTuplesToRead);
     }
-    inline void merge(JoinHashTable& other) { factorizedTable->merge(*other.factorizedTable); }
-    inline uint64_t getNumTuples() { return factorizedTable->getNumTuples(); }
+    //! merge the tuples of a thread-local table. Merged tuples are unpinned, so that they can be
+    //! spilled while other threads are still building their local tables, until pinPartitions.
+    void merge(JoinHashTable& other);
+    uint64_t getNumTuples() const;
     inline uint8_t** getPrevTuple(const uint8_t* tuple) const {
         return (uint8_t**)(tuple + colOffsetOfPrevPtrInTuple);
     }
     inline uint8_t* getTupleForHash(common::hash_t hash) {
-        auto slotIdx = getSlotIdxForHash(hash);
+        auto slotIdx = getPartitionedSlotIdxForHash(hash);
         return ((uint8_t**)(hashSlotsBlocks[slotIdx >> numSlotsPerBlockLog2]
                                 ->getData()))[slotIdx & slotIdxInBlockMask];
     }
     inline FactorizedTable* getFactorizedTable() { return factorizedTable.get(); }
+    inline uint64_t getNumPartitions() const { return (uint64_t)1 << numPartitionsLog2; }
     inline const FactorizedTableSchema* getTableSchema() {
         return factorizedTable->getTableSchema();
     }
 
 protected:
+    // The most significant bits of a hash select the partition, and the least significant bits
+    // select the slot within the partition. Slots of a partition are contiguous.
+    inline uint64_t getPartitionedSlotIdxForHash(common::hash_t hash) const {
+        return numPartitionsLog2 == 0 ?
+                   hash & bitmask :
+                   (getPartitionIdx(hash, numPartitionsLog2) << numSlotsPerPartitionLog2) |
+                       (hash & slotIdxInPartitionMask);
+    }
+    static inline uint64_t getPartitionIdx(common::hash_t hash, uint64_t numPartitionsLog2) {
+        return hash >> (sizeof(common::hash_t) * 8 - numPartitionsLog2);
+    }
+    common::hash_t getHash(const common::nodeID_t* nodeIDs) const;
     uint8_t** findHashSlot(common::nodeID_t* nodeIDs) const;
     // This function returns the pointer that previously stored in the same slot.
     uint8_t* insertEntry(uint8_t* tuple) const;
+    inline void insertTuple(uint8_t* tuple) const {
+        auto lastSlotEntryInHT = insertEntry(tuple);
+        memcpy(getPrevTuple(tuple), &lastSlotEntryInHT, sizeof(uint8_t*));
+    }
 
     // This function returns a boolean flag indicating if there is non-null keys after discarding.
     static bool discardNullFromKeys(
         const std::vector<common::ValueVector*>& vectors, uint32_t numKeyVectors);
 
 private:
+    void appendToTable(FactorizedTable& table, const std::vector<common::ValueVector*>& vectors);
+    void appendToPartitions(const std::vector<common::ValueVector*>& vectorsToAppend);
+    void buildHashSlotsForPartition(uint64_t partitionIdx);
+    // Spilled partitions cover whole blocks of hash slots, because there are at least as many
+    // blocks as spill partitions once a partition is spilled.
+    inline std::pair<uint64_t, uint64_t> getHashSlotsBlocksOfSpillPartition(
+        uint64_t partitionIdx) const {
+        auto numBlocksPerPartition = hashSlotsBlocks.size() >> NUM_SPILL_PARTITIONS_LOG2;
+        return std::make_pair(
+            partitionIdx * numBlocksPerPartition, (partitionIdx + 1) * numBlocksPerPartition);
+    }
+
+private:
+    // Tuples are scattered by this many hash bits. A partition of hash slots covers one or more
+    // of these radix partitions.
+    static constexpr uint64_t NUM_RADIX_PARTITIONS_LOG2 = 8;
+    static constexpr uint64_t NUM_SPILL_PARTITIONS_LOG2 = 4;
+
     uint64_t numKeyColumns;
     uint64_t colOffsetOfPrevPtrInTuple;
+    uint64_t numPartitionsLog2;
+    uint64_t numSlotsPerPartitionLog2;
+    uint64_t slotIdxInPartitionMask;
+    std::atomic<uint64_t> nextBlockIdxToPartition;
+    std::atomic<uint64_t> nextPartitionIdxToBuild;
+    std::mutex mtx;
+    // Tuples scattered by radix partition, by each thread that partitioned tuple blocks. Tuples
+    // are scattered only once all thread-local tables are merged, because merging may move the
+    // tuples of the last block of the table.
+    std::vector<std::vector<std::vector<uint8_t*>>> partitionedTuplesOfThreads;
+    // The tuple blocks whose tuples are inserted into the hash slots when the slots are built,
+    // i.e., the blocks of factorizedTable and of the partitions that are not spilled.
+    std::vector<DataBlock*> tupleBlocksToPartition;
+    bool canSpill;
+    // Tuples appended after factorizedTable holds one block of tuples, by spill partition. Empty
+    // until then.
+    std::vector<std::unique_ptr<FactorizedTable>> partitionTables;
+    std::vector<bool> isPartitionSpilled;
+    // Positions of the keys of each spill partition, when appending unflat keys.
+    std::vector<std::shared_ptr<common::SelectionVector>> partitionSelVectors;
 };
 
 } // namespace processor
@@ -34,6 +34,8 @@ private:
 
     std::shared_ptr<common::ValueVector> indexVector;
     std::shared_ptr<common::ValueVector> outVector;
+    // Node offsets of the keys looked up in a batch, indexed by the positions in indexVector.
+    std::unique_ptr<common::offset_t[]> nodeOffsets;
 };
 
 } // namespace processor
@@ -26,6 +26,9 @@ struct StrKeyColInfo {
     bool isAscOrder;
 };
 
+// MergedKeyBlocks is a sorted run of encoded keys. Its key blocks are unpinned unless they are
+// pinned through pinBlocks, so that a run waiting to be merged or scanned can be spilled by the
+// buffer manager. Tuples can only be read or written while their key blocks are pinned.
 class MergedKeyBlocks {
 public:
     MergedKeyBlocks(
@@ -34,6 +37,13 @@ public:
     // This constructor is used to convert a dataBlock to a MergedKeyBlocks.
     MergedKeyBlocks(uint32_t numBytesPerTuple, std::shared_ptr<DataBlock> keyBlock);
 
+    // Pins and unpins the key blocks holding tuples in the range [startTupleIdx, endTupleIdx).
+    // Blocks are reference counted, so ranges of concurrent morsels may share blocks. These
+    // functions are not thread-safe, callers need to synchronize them. pinBlocks returns the
+    // number of bytes read back from disk.
+    uint64_t pinBlocks(uint64_t startTupleIdx, uint64_t endTupleIdx);
+    void unpinBlocks(uint64_t startTupleIdx, uint64_t endTupleIdx);
+
     inline uint8_t* getTuple(uint64_t tupleIdx) const {
         assert(tupleIdx < numTuples);
         return keyBlocks[tupleIdx / numTuplesPerBlock]->getData() +
@@ -59,9 +69,105 @@ private:
     uint32_t numTuplesPerBlock;
     uint64_t numTuples;
     std::vector<std::shared_ptr<DataBlock>> keyBlocks;
+    std::vector<uint32_t> numPinsPerBlock;
     uint32_t endTupleOffset;
 };
 
+// A sorted run of the external sort, see `OrderBy`. The payload of the ith key is the ith tuple of
+// the run, so payloads are read by their position in the run rather than by the tuple info encoded
+// in the keys. Payload tuples are kept in small tables, in the order of the run. Runs are written
+// and read sequentially, and only the key block and the payload table of the current tuple are
+// pinned. All other blocks of a run are unpinned, so the buffer manager can write them to the
+// spill file.
+struct SortedRun {
+    explicit SortedRun(std::shared_ptr<MergedKeyBlocks> keyBlocks)
+        : keyBlocks{std::move(keyBlocks)} {}
+
+    inline uint64_t getNumTuples() const { return keyBlocks->getNumTuples(); }
+
+    // A payload table is full once it holds a block of tuples, or once its tuples and their
+    // overflow data take this number of blocks.
+    static constexpr uint64_t MAX_NUM_BLOCKS_PER_PAYLOAD_TABLE = 4;
+    // The memory that a reader or a writer of a run keeps pinned: a key block and a payload table.
+    static constexpr uint64_t NUM_BYTES_TO_READ_OR_WRITE =
+        (MAX_NUM_BLOCKS_PER_PAYLOAD_TABLE + 1) * common::BufferPoolConstants::PAGE_256KB_SIZE;
+
+    std::shared_ptr<MergedKeyBlocks> keyBlocks;
+    std::vector<std::unique_ptr<FactorizedTable>> payloadTables;
+};
+
+// Writes the tuples of a sorted run in order. Payload tuples are copied through value vectors,
+// which copy their overflow data into the payload tables of the run.
+class SortedRunWriter {
+public:
+    SortedRunWriter(storage::MemoryManager* memoryManager,
+        const FactorizedTableSchema& payloadTableSchema,
+        const std::vector<common::LogicalType>& payloadTypes, uint32_t numBytesPerTuple,
+        uint64_t numTuples);
+
+    // Copies the key and buffers the payload tuple, which must stay pinned until the payloads are
+    // flushed.
+    void append(const uint8_t* keyTuplePtr, uint8_t* payloadTuple);
+
+    // Copies the buffered payload tuples into the payload tables.
+    void flushPayloads();
+
+    // Flushes the payloads and unpins the last blocks of the run.
+    std::shared_ptr<SortedRun> finish();
+
+    inline uint64_t getNumBytesSpilled() const { return numBytesSpilled; }
+
+private:
+    FactorizedTable& getPayloadTableToAppend();
+
+private:
+    storage::MemoryManager* memoryManager;
+    const FactorizedTableSchema& payloadTableSchema;
+    std::shared_ptr<SortedRun> sortedRun;
+    uint32_t numBytesPerTuple;
+    uint64_t numTuplesAppended;
+    // Payload tables with unflat columns are copied one tuple at a time.
+    bool copySingleTuple;
+    std::vector<std::unique_ptr<common::ValueVector>> payloadVectors;
+    std::vector<common::ValueVector*> payloadVectorsToCopy;
+    std::vector<ft_col_idx_t> payloadColIdxes;
+    std::vector<uint8_t*> payloadTuplesToCopy;
+    // Number of bytes of spilled key blocks read back from disk.
+    uint64_t numBytesSpilled;
+};
+
+// Reads the tuples of a sorted run in order.
+class SortedRunReader {
+public:
+    explicit SortedRunReader(std::shared_ptr<SortedRun> sortedRun);
+
+    inline bool hasMoreTuples() const { return nextTupleIdx < sortedRun->getNumTuples(); }
+
+    inline uint8_t* getKeyTuplePtr() const { return sortedRun->keyBlocks->getTuple(nextTupleIdx); }
+
+    inline uint8_t* getPayloadTuple() const {
+        return sortedRun->payloadTables[payloadTableIdx]->getTuple(nextTupleIdxInPayloadTable);
+    }
+
+    // Returns true if moving to the next tuple unpins the payload table of the current tuple.
+    inline bool isLastTupleInPayloadTable() const {
+        return nextTupleIdxInPayloadTable + 1 ==
+               sortedRun->payloadTables[payloadTableIdx]->getNumTuples();
+    }
+
+    void moveToNextTuple();
+
+    inline uint64_t getNumBytesSpilled() const { return numBytesSpilled; }
+
+private:
+    std::shared_ptr<SortedRun> sortedRun;
+    uint64_t nextTupleIdx;
+    uint64_t payloadTableIdx;
+    uint64_t nextTupleIdxInPayloadTable;
+    // Number of bytes of the run read back from disk.
+    uint64_t numBytesSpilled;
+};
+
 struct BlockPtrInfo {
     inline BlockPtrInfo(
         uint64_t startTupleIdx, uint64_t endTupleIdx, std::shared_ptr<MergedKeyBlocks>& keyBlocks)
@@ -109,14 +215,34 @@ public:
 
     void mergeKeyBlocks(KeyBlockMergeMorsel& keyBlockMergeMorsel) const;
 
+    // Merges the sorted runs into the writer with a k-way merge, reading each run sequentially.
+    // Returns the number of bytes of the runs read back from disk.
+    uint64_t mergeSortedRuns(
+        const std::vector<std::shared_ptr<SortedRun>>& sortedRuns, SortedRunWriter& writer) const;
+
     inline bool compareTuplePtr(uint8_t* leftTuplePtr, uint8_t* rightTuplePtr) const {
         return hasStringCol ? compareTuplePtrWithStringCol(leftTuplePtr, rightTuplePtr) :
                               memcmp(leftTuplePtr, rightTuplePtr, numBytesToCompare) > 0;
     }
 
+    // Compares tuples of sorted runs, whose payload tuples are given by the caller.
+    inline bool compareTuplePtr(uint8_t* leftTuplePtr, uint8_t* rightTuplePtr,
+        uint8_t* leftPayloadTuple, uint8_t* rightPayloadTuple) const {
+        return hasStringCol ? compareTuplePtrWithStringCol(leftTuplePtr, rightTuplePtr,
+                                  leftPayloadTuple, rightPayloadTuple) :
+                              memcmp(leftTuplePtr, rightTuplePtr, numBytesToCompare) > 0;
+    }
+
     bool compareTuplePtrWithStringCol(uint8_t* leftTuplePtr, uint8_t* rightTuplePtr) const;
 
 private:
+    // Payload tuples that are not given (nullptr) are looked up in the factorizedTables by the
+    // tuple info encoded in the keys.
+    bool compareTuplePtrWithStringCol(uint8_t* leftTuplePtr, uint8_t* rightTuplePtr,
+        uint8_t* leftPayloadTuple, uint8_t* rightPayloadTuple) const;
+
+    uint8_t* getPayloadTuple(uint8_t* tuplePtr) const;
+
     void copyRemainingBlockDataToResult(BlockPtrInfo& blockToCopy, BlockPtrInfo& resultBlock) const;
 
 private:
@@ -139,7 +265,8 @@ public:
         std::shared_ptr<MergedKeyBlocks> resultKeyBlock, KeyBlockMerger& keyBlockMerger)
         : leftKeyBlock{std::move(leftKeyBlock)}, rightKeyBlock{std::move(rightKeyBlock)},
           resultKeyBlock{std::move(resultKeyBlock)}, leftKeyBlockNextIdx{0},
-          rightKeyBlockNextIdx{0}, activeMorsels{0}, keyBlockMerger{keyBlockMerger} {}
+          rightKeyBlockNextIdx{0}, activeMorsels{0}, numBytesSpilled{0},
+          keyBlockMerger{keyBlockMerger} {}
 
     std::unique_ptr<KeyBlockMergeMorsel> getMorsel();
 
@@ -151,6 +278,7 @@ public:
 
 private:
     uint64_t findRightKeyBlockIdx(uint8_t* leftEndTuplePtr);
+    bool isLeftEndTupleLarger(uint8_t* leftEndTuplePtr, uint64_t rightTupleIdx);
 
 public:
     static const uint32_t batch_size = 10000;
@@ -164,6 +292,8 @@ public:
     // If the counter is 0 and there is no morsel left in the current task, we can
     // put the resultKeyBlock back to the keyBlock list.
     uint64_t activeMorsels;
+    // Number of bytes of spilled key blocks read back from disk to compute morsels.
+    uint64_t numBytesSpilled;
     // KeyBlockMerger is used to compare the values of two tuples during the binary search.
     KeyBlockMerger& keyBlockMerger;
 };
@@ -181,8 +311,8 @@ struct KeyBlockMergeMorsel {
     uint64_t rightKeyBlockEndIdx;
 };
 
-// A dispatcher class used to assign KeyBlockMergeMorsel to threads.
-// All functions are guaranteed to be thread-safe, so callers don't need to
+// A dispatcher class used to assign KeyBlockMergeMorsel to threads, or sorted runs to merge if the
+// sort is external. All functions are guaranteed to be thread-safe, so callers don't need to
 // acquire a lock before calling these functions.
 class KeyBlockMergeTaskDispatcher {
 public:
@@ -190,19 +320,42 @@ public:
         std::lock_guard<std::mutex> keyBlockMergeDispatcherLock{mtx};
         // Returns true if there are no more merge task to do or the sortedKeyBlocks is empty
         // (meaning that the resultSet is empty).
-        return sortedKeyBlocks->size() <= 1 && activeKeyBlockMergeTasks.empty();
+        return sortedKeyBlocks->size() <= 1 && activeKeyBlockMergeTasks.empty() &&
+               sortedRuns->size() <= 1 && numSortedRunsBeingMerged == 0;
     }
 
     std::unique_ptr<KeyBlockMergeMorsel> getMorsel();
 
     void doneMorsel(std::unique_ptr<KeyBlockMergeMorsel> morsel);
 
+    // Sorted runs are merged by a single thread each, k runs at a time, until a single run is
+    // left. Threads merge disjoint runs in parallel, and the number of runs being merged at the
+    // same time is bounded by the memory budget of the sort. Returns no runs if there are less
+    // than two runs that can be merged at this time.
+    std::vector<std::shared_ptr<SortedRun>> getSortedRunsToMerge();
+
+    void doneSortedRunsMerge(std::shared_ptr<SortedRun> mergedRun, uint64_t numRunsMerged,
+        uint64_t numBytesSpilledOfMerge);
+
+    inline uint64_t getNumBytesSpilled() {
+        std::lock_guard<std::mutex> keyBlockMergeDispatcherLock{mtx};
+        return numBytesSpilled;
+    }
+
     // This function is used to initialize the columns of keyBlockMergeTaskDispatcher based on
     // sharedFactorizedTablesAndSortedKeyBlocks.
     void init(storage::MemoryManager* memoryManager,
         std::shared_ptr<std::queue<std::shared_ptr<MergedKeyBlocks>>> sortedKeyBlocks,
+        std::shared_ptr<std::queue<std::shared_ptr<SortedRun>>> sortedRuns,
         std::vector<std::shared_ptr<FactorizedTable>>& factorizedTables,
-        std::vector<StrKeyColInfo>& strKeyColsInfo, uint64_t numBytesPerTuple);
+        std::vector<StrKeyColInfo>& strKeyColsInfo, uint64_t numBytesPerTuple,
+        uint64_t memoryBudget);
+
+private:
+    // A morsel pins the key blocks it reads from and writes to until it is done, so that only the
+    // key blocks of active morsels need to be in memory.
+    void pinKeyBlocks(KeyBlockMergeMorsel& morsel);
+    void unpinKeyBlocks(KeyBlockMergeMorsel& morsel);
 
 private:
     std::mutex mtx;
@@ -211,6 +364,13 @@ private:
     std::shared_ptr<std::queue<std::shared_ptr<MergedKeyBlocks>>> sortedKeyBlocks;
     std::vector<std::shared_ptr<KeyBlockMergeTask>> activeKeyBlockMergeTasks;
     std::unique_ptr<KeyBlockMerger> keyBlockMerger;
+    std::shared_ptr<std::queue<std::shared_ptr<SortedRun>>> sortedRuns;
+    // Each run being merged has a reader and each merge has a writer, which keep
+    // SortedRun::NUM_BYTES_TO_READ_OR_WRITE bytes pinned. The number of runs being merged is
+    // bounded so that the readers and a writer fit in the memory budget.
+    uint64_t maxNumSortedRunsToMerge = 2;
+    uint64_t numSortedRunsBeingMerged = 0;
+    uint64_t numBytesSpilled = 0;
 };
 
 } // namespace processor
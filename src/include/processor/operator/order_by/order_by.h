@@ -13,14 +13,15 @@ namespace kuzu {
 namespace processor {
 
 // This class contains factorizedTables, nextFactorizedTableIdx, strKeyColsInfo,
-// sortedKeyBlocks and the size of each tuple in keyBlocks. The class is shared between the
-// order_by, orderByMerge, orderByScan operators. All functions are guaranteed to be thread-safe, so
-// caller doesn't need to acquire a lock before calling these functions.
+// sortedKeyBlocks, sortedRuns and the size of each tuple in keyBlocks. The class is shared between
+// the order_by, orderByMerge, orderByScan operators. All functions are guaranteed to be
+// thread-safe, so caller doesn't need to acquire a lock before calling these functions.
 class SharedFactorizedTablesAndSortedKeyBlocks {
 public:
     explicit SharedFactorizedTablesAndSortedKeyBlocks()
         : nextFactorizedTableIdx{0},
-          sortedKeyBlocks{std::make_shared<std::queue<std::shared_ptr<MergedKeyBlocks>>>()} {}
+          sortedKeyBlocks{std::make_shared<std::queue<std::shared_ptr<MergedKeyBlocks>>>()},
+          sortedRuns{std::make_shared<std::queue<std::shared_ptr<SortedRun>>>()} {}
 
     uint8_t getNextFactorizedTableIdx() {
         std::unique_lock lck{mtx};
@@ -43,11 +44,34 @@ public:
         sortedKeyBlocks->emplace(mergedDataBlocks);
     }
 
+    void appendSortedRun(std::shared_ptr<SortedRun> sortedRun) {
+        std::unique_lock lck{mtx};
+        sortedRuns->emplace(std::move(sortedRun));
+    }
+
+    inline bool isExternalSort() {
+        std::unique_lock lck{mtx};
+        return !sortedRuns->empty();
+    }
+
     void setNumBytesPerTuple(uint32_t _numBytesPerTuple) {
         assert(numBytesPerTuple == UINT32_MAX);
         numBytesPerTuple = _numBytesPerTuple;
     }
 
+    // Factorized tables are unpinned once their tuples are appended, so that they can be spilled
+    // while key blocks are merged. Returns the number of bytes read back from disk. This is only
+    // done if the sort is in memory, i.e., if all factorizedTables fit in the memory budget.
+    // Otherwise, the payloads are copied into the sorted runs, which are read sequentially.
+    uint64_t pinFactorizedTables() {
+        std::unique_lock lck{mtx};
+        uint64_t numBytesRead = 0;
+        for (auto& factorizedTable : factorizedTables) {
+            numBytesRead += factorizedTable->pinBlocks();
+        }
+        return numBytesRead;
+    }
+
     void combineFTHasNoNullGuarantee() {
         for (auto i = 1u; i < factorizedTables.size(); i++) {
             factorizedTables[0]->mergeMayContainNulls(*factorizedTables[i]);
@@ -66,9 +90,14 @@ public:
     std::vector<std::shared_ptr<FactorizedTable>> factorizedTables;
     uint8_t nextFactorizedTableIdx;
     std::shared_ptr<std::queue<std::shared_ptr<MergedKeyBlocks>>> sortedKeyBlocks;
+    std::shared_ptr<std::queue<std::shared_ptr<SortedRun>>> sortedRuns;
 
     uint32_t numBytesPerTuple = UINT32_MAX; // encoding size
     std::vector<StrKeyColInfo> strKeyColsInfo;
+    // The schema and column types of the payload tables of sorted runs. All columns of the schema
+    // may contain nulls, since a run holds tuples of all factorizedTables.
+    std::unique_ptr<FactorizedTableSchema> payloadTableSchema;
+    std::vector<common::LogicalType> payloadTypes;
 };
 
 struct OrderByDataInfo {
@@ -94,39 +123,65 @@ public:
     bool mayContainUnflatKey;
 };
 
+// ORDER BY sorts in memory if the tuples fit in its memory budget (see getMemoryBudget()). Each
+// thread radix sorts its key blocks, which are merged by OrderByMerge, and OrderByScan reads the
+// payloads from the factorizedTables by the tuple info encoded in the keys.
+// Otherwise, the sort is external: once the tuples of a thread exceed its share of the budget, the
+// thread radix sorts its key blocks and writes each of them into a sorted run together with its
+// payloads (see SortedRunWriter), and then clears its factorizedTable. Runs are unpinned, so they
+// are written to the spill file, and are merged k-way by OrderByMerge into a single run, which is
+// scanned sequentially by OrderByScan.
 class OrderBy : public Sink {
 public:
     OrderBy(std::unique_ptr<ResultSetDescriptor> resultSetDescriptor,
         const OrderByDataInfo& orderByDataInfo,
         std::shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState,
         std::unique_ptr<PhysicalOperator> child, uint32_t id, const std::string& paramsString)
-        : Sink{std::move(resultSetDescriptor), PhysicalOperatorType::ORDER_BY, std::move(child), id,
-              paramsString},
-          orderByDataInfo{orderByDataInfo}, sharedState{std::move(sharedState)} {}
+        : OrderBy{std::move(resultSetDescriptor), PhysicalOperatorType::ORDER_BY, orderByDataInfo,
+              std::move(sharedState), std::move(child), id, paramsString} {}
 
     void initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) override;
 
     void executeInternal(ExecutionContext* context) override;
 
-    void finalize(ExecutionContext* context) override {
-        // TODO(Ziyi): we always call lookup function on the first factorizedTable in sharedState
-        // and that lookup function may read tuples in other factorizedTable, So we need to combine
-        // hasNoNullGuarantee with other factorizedTables. This is not a good way to solve this
-        // problem, and should be changed later.
-        sharedState->combineFTHasNoNullGuarantee();
-    }
+    void finalize(ExecutionContext* context) override;
 
     std::unique_ptr<PhysicalOperator> clone() override {
         return std::make_unique<OrderBy>(resultSetDescriptor->copy(), orderByDataInfo, sharedState,
             children[0]->clone(), id, paramsString);
     }
 
+    // The memory budget of the sort is the order_by_memory_budget setting, capped by
+    // ORDER_BY_MEMORY_RATIO of the buffer pool.
+    static uint64_t getMemoryBudget(ExecutionContext* context);
+
+protected:
+    OrderBy(std::unique_ptr<ResultSetDescriptor> resultSetDescriptor,
+        PhysicalOperatorType operatorType, const OrderByDataInfo& orderByDataInfo,
+        std::shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState,
+        std::unique_ptr<PhysicalOperator> child, uint32_t id, const std::string& paramsString)
+        : Sink{std::move(resultSetDescriptor), operatorType, std::move(child), id, paramsString},
+          orderByDataInfo{orderByDataInfo}, sharedState{std::move(sharedState)} {}
+
+    // Registers the thread-local factorizedTable in the sharedState and creates the key encoder
+    // writing into it.
+    void initLocalFactorizedTableAndEncoder(ResultSet* resultSet, ExecutionContext* context);
+
 private:
     std::unique_ptr<FactorizedTableSchema> populateTableSchema();
 
     void initGlobalStateInternal(ExecutionContext* context) override;
 
-private:
+    // Radix sorts the key blocks of the thread and writes them into sorted runs, then clears the
+    // key blocks and the factorizedTable of the thread.
+    void writeSortedRuns(ExecutionContext* context);
+
+    // Writes the sorted keys and the payloads they point to in factorizedTable into a sorted run.
+    // Returns the number of bytes spilled by the writer.
+    uint64_t writeSortedRun(const uint8_t* keys, uint64_t numTuples,
+        FactorizedTable& factorizedTable, storage::MemoryManager* memoryManager);
+
+protected:
     uint8_t factorizedTableIdx;
     OrderByDataInfo orderByDataInfo;
     std::unique_ptr<OrderByKeyEncoder> orderByKeyEncoder;
@@ -135,6 +190,8 @@ private:
     std::vector<common::ValueVector*> vectorsToAppend;
     std::shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState;
     std::shared_ptr<FactorizedTable> localFactorizedTable;
+    // The share of the memory budget of this thread.
+    uint64_t memoryBudget;
 };
 
 } // namespace processor
@@ -88,6 +88,10 @@ public:
 
     void encodeKeys();
 
+    // Drops all encoded keys and restarts encoding from the first tuple of the factorizedTable,
+    // so that the encoder can be reused to encode keys that are not appended to any table.
+    void clear();
+
 private:
     template<typename type>
     static inline void encodeTemplate(const uint8_t* data, uint8_t* resultPtr, bool swapBytes) {
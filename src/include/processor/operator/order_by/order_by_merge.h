@@ -34,6 +34,8 @@ public:
 
     void executeInternal(ExecutionContext* context) override;
 
+    void finalize(ExecutionContext* context) override;
+
     std::unique_ptr<PhysicalOperator> clone() override {
         return make_unique<OrderByMerge>(sharedState, sharedDispatcher, id, paramsString);
     }
@@ -41,6 +43,9 @@ public:
 private:
     void initGlobalStateInternal(ExecutionContext* context) override;
 
+    void mergeSortedRuns(
+        std::vector<std::shared_ptr<SortedRun>> sortedRuns, storage::MemoryManager* memoryManager);
+
 private:
     std::shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState;
     std::unique_ptr<KeyBlockMerger> localMerger;
@@ -16,6 +16,14 @@ struct MergedKeyBlockScanState {
     std::unique_ptr<BlockPtrInfo> blockPtrInfo;
 };
 
+// The payloads of a sorted run are in the order of the run, so they are scanned sequentially, one
+// payload table at a time.
+struct SortedRunScanState {
+    std::shared_ptr<SortedRun> sortedRun;
+    uint64_t nextPayloadTableIdx;
+    uint64_t nextTupleIdxInPayloadTable;
+};
+
 // To preserve the ordering of tuples, the orderByScan operator will only
 // be executed in single-thread mode.
 class OrderByScan : public PhysicalOperator {
@@ -46,11 +54,15 @@ public:
 private:
     void initMergedKeyBlockScanState();
 
+    bool getNextTuplesFromSortedRun();
+
 private:
     std::vector<DataPos> outVectorPos;
     std::shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState;
     std::vector<common::ValueVector*> vectorsToRead;
     std::unique_ptr<MergedKeyBlockScanState> mergedKeyBlockScanState;
+    std::unique_ptr<SortedRunScanState> sortedRunScanState;
+    common::NumericMetric* numBytesSpilled = nullptr;
 };
 
 } // namespace processor
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "processor/operator/order_by/key_block_merger.h"
+#include "processor/operator/order_by/order_by.h"
+
+namespace kuzu {
+namespace processor {
+
+// TopK replaces OrderBy if ORDER BY is followed by LIMIT and every tuple of the factorizedTable is
+// a single output tuple. Each thread keeps a max-heap of its best limitNumber encoded keys. Keys of
+// the input tuples are first encoded into a scratch key block and compared with the worst tuple in
+// the heap, so only tuples that may enter the heap are appended to the factorizedTable. Each thread
+// produces a sorted run of at most limitNumber tuples, and finalize merges these runs into the
+// single run scanned by OrderByScan. Neither radix sort nor the merge of key blocks is needed.
+class TopK : public OrderBy {
+public:
+    TopK(std::unique_ptr<ResultSetDescriptor> resultSetDescriptor,
+        const OrderByDataInfo& orderByDataInfo,
+        std::shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState,
+        uint64_t limitNumber, std::unique_ptr<PhysicalOperator> child, uint32_t id,
+        const std::string& paramsString)
+        : OrderBy{std::move(resultSetDescriptor), PhysicalOperatorType::TOP_K, orderByDataInfo,
+              std::move(sharedState), std::move(child), id, paramsString},
+          limitNumber{limitNumber} {}
+
+    void initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) override;
+
+    void executeInternal(ExecutionContext* context) override;
+
+    void finalize(ExecutionContext* context) override;
+
+    std::unique_ptr<PhysicalOperator> clone() override {
+        return std::make_unique<TopK>(resultSetDescriptor->copy(), orderByDataInfo, sharedState,
+            limitNumber, children[0]->clone(), id, paramsString);
+    }
+
+private:
+    // Removes the tuples of the current resultSet that can't enter the heap from the selection
+    // vector of the key data chunk. Returns false if no tuple can enter the heap.
+    bool selectCandidates();
+
+    // Returns true if the candidate key is guaranteed not to be smaller than the worst key in the
+    // heap. Ties of long string prefixes can only be resolved by reading the full strings, which
+    // are not appended to the factorizedTable yet, so such candidates are kept.
+    bool isDominatedByHeapTop(const uint8_t* candidateKey) const;
+
+    void pushToHeap(uint8_t* tuple);
+
+    // Copies the given encoded tuples into a new sorted run.
+    std::shared_ptr<MergedKeyBlocks> createSortedRun(
+        const std::vector<uint8_t*>& tuples, storage::MemoryManager* memoryManager) const;
+
+private:
+    uint64_t limitNumber;
+    std::unique_ptr<OrderByKeyEncoder> candidateKeyEncoder;
+    // The merger only reads the thread-local factorizedTable to resolve ties of string keys.
+    // Therefore, it uses its own list of factorizedTables instead of the shared one, which may be
+    // resized by other threads.
+    std::vector<std::shared_ptr<FactorizedTable>> localFactorizedTables;
+    std::unique_ptr<KeyBlockMerger> localMerger;
+    std::vector<uint8_t*> heap;
+};
+
+} // namespace processor
+} // namespace kuzu
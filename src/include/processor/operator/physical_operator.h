@@ -62,6 +62,7 @@ enum class PhysicalOperatorType : uint8_t {
     ORDER_BY,
     ORDER_BY_MERGE,
     ORDER_BY_SCAN,
+    TOP_K,
     UNION_ALL_SCAN,
     UNWIND,
     VAR_LENGTH_ADJ_LIST_EXTEND,
@@ -84,6 +85,29 @@ public:
     common::NumericMetric& numOutputTuple;
 };
 
+// Page prefetch counters of operators that read ahead the pages they scan.
+struct PrefetchMetrics {
+
+public:
+    PrefetchMetrics(common::NumericMetric& numPageHits, common::NumericMetric& numPageMisses,
+        common::NumericMetric& numPagesPrefetched)
+        : numPageHits{numPageHits}, numPageMisses{numPageMisses}, numPagesPrefetched{
+                                                                      numPagesPrefetched} {}
+
+    // Adds the given stats to the metrics and resets the stats.
+    inline void collect(storage::PrefetchStats& stats) {
+        numPageHits.increase(stats.numPageHits);
+        numPageMisses.increase(stats.numPageMisses);
+        numPagesPrefetched.increase(stats.numPagesPrefetched);
+        stats = storage::PrefetchStats{};
+    }
+
+public:
+    common::NumericMetric& numPageHits;
+    common::NumericMetric& numPageMisses;
+    common::NumericMetric& numPagesPrefetched;
+};
+
 class PhysicalOperator {
 public:
     // Leaf operator
@@ -123,6 +147,9 @@ public:
     void initGlobalState(ExecutionContext* context);
     // Local state is initialized for each thread.
     void initLocalState(ResultSet* resultSet, ExecutionContext* context);
+    // Drops the tuples that are left to output from the current input of the source, so the next
+    // getNextTuple() starts from new input. Used to stop pulling from a plan before its end.
+    void resetInputState();
 
     inline bool getNextTuple(ExecutionContext* context) {
         if (context->clientContext->isInterrupted()) {
@@ -143,20 +170,37 @@ public:
 protected:
     virtual void initGlobalStateInternal(ExecutionContext* context) {}
     virtual void initLocalStateInternal(ResultSet* resultSet_, ExecutionContext* context) {}
+    virtual void resetInputStateInternal() {}
     // Return false if no more tuples to pull, otherwise return true
     virtual bool getNextTuplesInternal(ExecutionContext* context) = 0;
 
     inline std::string getTimeMetricKey() const { return "time-" + std::to_string(id); }
     inline std::string getNumTupleMetricKey() const { return "numTuple-" + std::to_string(id); }
+    inline std::string getNumBytesSpilledMetricKey() const {
+        return "numBytesSpilled-" + std::to_string(id);
+    }
+    inline std::string getNumPageHitsMetricKey() const {
+        return "numPageHits-" + std::to_string(id);
+    }
+    inline std::string getNumPageMissesMetricKey() const {
+        return "numPageMisses-" + std::to_string(id);
+    }
+    inline std::string getNumPagesPrefetchedMetricKey() const {
+        return "numPagesPrefetched-" + std::to_string(id);
+    }
 
     void registerProfilingMetrics(common::Profiler* profiler);
+    // Called by operators that prefetch pages in their initLocalStateInternal.
+    void registerPrefetchMetrics(common::Profiler* profiler);
 
     double getExecutionTime(common::Profiler& profiler) const;
     uint64_t getNumOutputTuples(common::Profiler& profiler) const;
+    uint64_t getNumBytesSpilled(common::Profiler& profiler) const;
 
 protected:
     uint32_t id;
     std::unique_ptr<OperatorMetrics> metrics;
+    std::unique_ptr<PrefetchMetrics> prefetchMetrics;
     PhysicalOperatorType operatorType;
 
     std::vector<std::unique_ptr<PhysicalOperator>> children;
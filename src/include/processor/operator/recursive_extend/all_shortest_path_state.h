@@ -8,8 +8,10 @@ namespace processor {
 template<bool TRACK_PATH>
 class AllShortestPathState : public BaseBFSState {
 public:
-    AllShortestPathState(uint8_t upperBound, TargetDstNodes* targetDstNodes)
-        : BaseBFSState{upperBound, targetDstNodes}, minDistance{0}, numVisitedDstNodes{0} {}
+    AllShortestPathState(uint8_t upperBound, TargetDstNodes* targetDstNodes,
+        const std::vector<uint64_t>* numNodesPerTable)
+        : BaseBFSState{upperBound, targetDstNodes, numNodesPerTable}, minDistance{0},
+          numVisitedDstNodes{0} {}
 
     inline bool isComplete() final {
         return isCurrentFrontierEmpty() || isUpperBoundReached() ||
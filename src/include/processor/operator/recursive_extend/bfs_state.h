@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/exception.h"
 #include "frontier.h"
 #include "processor/operator/mask.h"
 
@@ -38,9 +39,10 @@ private:
 
 class BaseBFSState {
 public:
-    explicit BaseBFSState(uint8_t upperBound, TargetDstNodes* targetDstNodes)
-        : upperBound{upperBound}, currentLevel{0}, nextNodeIdxToExtend{0}, targetDstNodes{
-                                                                               targetDstNodes} {}
+    BaseBFSState(uint8_t upperBound, TargetDstNodes* targetDstNodes,
+        const std::vector<uint64_t>* numNodesPerTable)
+        : upperBound{upperBound}, currentLevel{0}, nextNodeIdxToExtend{0}, numFrontiers{0},
+          numNodesPerTable{numNodesPerTable}, targetDstNodes{targetDstNodes} {}
     virtual ~BaseBFSState() = default;
 
     // Get next node offset to extend from current level.
@@ -54,7 +56,7 @@ public:
     virtual void resetState() {
         currentLevel = 0;
         nextNodeIdxToExtend = 0;
-        frontiers.clear();
+        numFrontiers = 0;
         initStartFrontier();
         addNextFrontier();
     }
@@ -67,23 +69,41 @@ public:
         return currentFrontier->getMultiplicity(nodeID);
     }
 
-    inline void finalizeCurrentLevel() { moveNextLevelAsCurrentLevel(); }
-    inline size_t getNumFrontiers() const { return frontiers.size(); }
+    virtual void finalizeCurrentLevel() { moveNextLevelAsCurrentLevel(); }
+
+    // Bottom-up extension marks unvisited nodes whose nbrs are in the current frontier as visited.
+    // shouldExtendBottomUp() is checked before extending each node of the current frontier, and
+    // returns true if the whole level should be extended bottom-up instead.
+    virtual bool shouldExtendBottomUp() { return false; }
+    virtual bool isVisited(common::nodeID_t nodeID) const {
+        throw common::NotImplementedException("BaseBFSState::isVisited");
+    }
+    virtual bool isOnCurrentFrontier(common::nodeID_t nodeID) const {
+        throw common::NotImplementedException("BaseBFSState::isOnCurrentFrontier");
+    }
+    inline size_t getNumFrontiers() const { return numFrontiers; }
     inline Frontier* getFrontier(common::vector_idx_t idx) const { return frontiers[idx].get(); }
 
 protected:
     inline bool isCurrentFrontierEmpty() const { return currentFrontier->nodeIDs.empty(); }
     inline bool isUpperBoundReached() const { return currentLevel == upperBound; }
     inline void initStartFrontier() {
-        assert(frontiers.empty());
-        frontiers.push_back(std::make_unique<Frontier>());
-        currentFrontier = frontiers[frontiers.size() - 1].get();
+        assert(numFrontiers == 0);
+        currentFrontier = getNewFrontier();
     }
-    inline void addNextFrontier() {
-        frontiers.push_back(std::make_unique<Frontier>());
-        nextFrontier = frontiers[frontiers.size() - 1].get();
+    inline void addNextFrontier() { nextFrontier = getNewFrontier(); }
+    // Frontiers are pooled across resetState() calls, so the BFS of the next src node reuses the
+    // memory of the previous one.
+    inline Frontier* getNewFrontier() {
+        if (numFrontiers == frontiers.size()) {
+            frontiers.push_back(std::make_unique<Frontier>(numNodesPerTable));
+        } else {
+            frontiers[numFrontiers]->resetState();
+        }
+        return frontiers[numFrontiers++].get();
     }
     void moveNextLevelAsCurrentLevel() {
+        nextFrontier->finalize();
         currentFrontier = nextFrontier;
         currentLevel++;
         nextNodeIdxToExtend = 0;
@@ -101,7 +121,10 @@ protected:
     uint64_t nextNodeIdxToExtend; // next node to extend from current frontier.
     Frontier* currentFrontier;
     Frontier* nextFrontier;
+    // Only the first numFrontiers frontiers are used by the current BFS.
     std::vector<std::unique_ptr<Frontier>> frontiers;
+    size_t numFrontiers;
+    const std::vector<uint64_t>* numNodesPerTable;
     // Target information.
     TargetDstNodes* targetDstNodes;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <unordered_map>
 
 #include "common/types/types_include.h"
@@ -10,6 +11,7 @@ namespace processor {
 
 namespace frontier {
 using node_rel_id_t = std::pair<common::nodeID_t, common::relID_t>;
+using bwd_edges_t = std::span<const node_rel_id_t>;
 
 using node_id_set_t = std::unordered_set<common::nodeID_t, function::InternalIDHasher>;
 template<typename T>
@@ -25,14 +27,32 @@ using node_id_map_t = std::unordered_map<common::nodeID_t, T, function::Internal
  * Shortest path NOT track path  |  nodeIDs
  * Var length track path         |  nodeIDs & bwdEdges
  * Var length NOT track path     |  nodeIDs & nodeIDToMultiplicity
+ *
+ * Bwd edges and multiplicities are first kept in hash maps keyed by nodeID. Once the frontier
+ * contains more than 1/DENSE_THRESHOLD_DIVISOR of the nodes that can be visited, it switches to a
+ * dense representation where they are kept in arrays indexed by table ID and node offset. Arrays
+ * are sized by the number of nodes of each table and are kept when the frontier is reset, so a
+ * frontier reused by the next BFS doesn't allocate them again.
+ *
+ * Dense bwd edges are stored in CSR format: the bwd edges of the node at dense index i are
+ * denseBwdEdges[denseBwdEdgeOffsets[i], denseBwdEdgeOffsets[i] + denseNumBwdEdges[i]). Edges are
+ * added in any node order, so they are first appended to an edge list while denseNumBwdEdges
+ * counts the edges of each node, and finalize() assigns offsets to the nodes of the frontier and
+ * scatters the edge list. Offsets of nodes that are not in the frontier are stale, which keeps
+ * resetting a reused frontier proportional to its size.
  */
 class Frontier {
 public:
-    inline void resetState() {
-        nodeIDs.clear();
-        bwdEdges.clear();
-        nodeIDToMultiplicity.clear();
-    }
+    static constexpr uint64_t DENSE_THRESHOLD_DIVISOR = 8;
+
+    Frontier() : Frontier{nullptr /* numNodesPerTable */} {}
+    // numNodesPerTable is indexed by table ID. If it's null, the frontier is never dense.
+    explicit Frontier(const std::vector<uint64_t>* numNodesPerTable);
+
+    void resetState();
+    // Must be called once all nodes and edges of the frontier are added, and before its bwd edges
+    // are read.
+    void finalize();
 
     inline void addNode(common::nodeID_t nodeID) { nodeIDs.push_back(nodeID); }
 
@@ -41,13 +61,90 @@ public:
     void addNodeWithMultiplicity(common::nodeID_t nodeID, uint64_t multiplicity);
 
     inline uint64_t getMultiplicity(common::nodeID_t nodeID) const {
+        if (isDense) {
+            return denseMultiplicities.empty() ? 1 :
+                                                 denseMultiplicities[nodeID.tableID][nodeID.offset];
+        }
         return nodeIDToMultiplicity.empty() ? 1 : nodeIDToMultiplicity.at(nodeID);
     }
 
+    inline frontier::bwd_edges_t getBwdEdges(common::nodeID_t nodeID) const {
+        assert(!isDense || isFinalized);
+        if (isDense && hasDenseIdx(nodeID)) {
+            auto denseIdx = getDenseIdx(nodeID);
+            if (denseNumBwdEdges.empty() || denseNumBwdEdges[denseIdx] == 0) {
+                return frontier::bwd_edges_t{};
+            }
+            return frontier::bwd_edges_t{denseBwdEdges.data() + denseBwdEdgeOffsets[denseIdx],
+                denseNumBwdEdges[denseIdx]};
+        }
+        return bwdEdges.at(nodeID);
+    }
+
 public:
     std::vector<common::nodeID_t> nodeIDs;
+
+private:
+    inline bool shouldSwitchToDense() const {
+        return !isDense && numNodesPerTable != nullptr && nodeIDs.size() > denseThreshold;
+    }
+    void switchToDense();
+    void addDenseEdge(common::nodeID_t boundNodeID, common::nodeID_t nbrNodeID,
+        common::nodeID_t relID);
+
+    // Nodes of the tables in numNodesPerTable are given consecutive dense indices.
+    inline bool hasDenseIdx(common::nodeID_t nodeID) const {
+        return nodeID.tableID < numNodesPerTable->size() &&
+               nodeID.offset < (*numNodesPerTable)[nodeID.tableID];
+    }
+    inline uint64_t getDenseIdx(common::nodeID_t nodeID) const {
+        return tableStartDenseIdx[nodeID.tableID] + nodeID.offset;
+    }
+    inline void initDenseBwdEdgeArrays() {
+        auto numDenseNodes =
+            tableStartDenseIdx.empty() ? 0 : tableStartDenseIdx.back() + numNodesPerTable->back();
+        denseBwdEdgeOffsets.resize(numDenseNodes);
+        denseNumBwdEdges.resize(numDenseNodes);
+    }
+
+    // Nodes of tables that are not in numNodesPerTable are still accepted, so the arrays grow on
+    // demand.
+    template<typename T>
+    static inline T& getDenseEntry(std::vector<std::vector<T>>& arrays, common::nodeID_t nodeID) {
+        if (nodeID.tableID >= arrays.size()) {
+            arrays.resize(nodeID.tableID + 1);
+        }
+        auto& array = arrays[nodeID.tableID];
+        if (nodeID.offset >= array.size()) {
+            array.resize(std::max(nodeID.offset + 1, 2 * array.size()));
+        }
+        return array[nodeID.offset];
+    }
+    template<typename T>
+    inline void initDenseArrays(std::vector<std::vector<T>>& arrays) const {
+        arrays.resize(numNodesPerTable->size());
+        for (auto tableID = 0u; tableID < numNodesPerTable->size(); ++tableID) {
+            arrays[tableID].resize((*numNodesPerTable)[tableID]);
+        }
+    }
+
+private:
+    const std::vector<uint64_t>* numNodesPerTable;
+    std::vector<uint64_t> tableStartDenseIdx;
+    uint64_t denseThreshold;
+    bool isDense;
+    bool isFinalized;
+    // Sparse representation. Bwd edges of nodes without a dense index stay here after the
+    // frontier switches to dense.
     frontier::node_id_map_t<std::vector<frontier::node_rel_id_t>> bwdEdges;
     frontier::node_id_map_t<uint64_t> nodeIDToMultiplicity;
+    // Dense representation. An empty range of bwd edges or a zero multiplicity indicates that the
+    // node is not in the frontier.
+    std::vector<std::pair<uint64_t, frontier::node_rel_id_t>> denseBwdEdgeList;
+    std::vector<uint64_t> denseBwdEdgeOffsets;
+    std::vector<uint64_t> denseNumBwdEdges;
+    std::vector<frontier::node_rel_id_t> denseBwdEdges;
+    std::vector<std::vector<uint64_t>> denseMultiplicities;
 };
 
 } // namespace processor
@@ -68,8 +68,6 @@ private:
  * operator.
  */
 class PathScanner : public BaseFrontierScanner {
-    using nbrs_t = std::vector<frontier::node_rel_id_t>*;
-
 public:
     PathScanner(TargetDstNodes* targetDstNodes, size_t k) : BaseFrontierScanner{targetDstNodes, k} {
         nodeIDs.resize(k + 1);
@@ -95,7 +93,7 @@ private:
     // DFS states
     std::vector<common::nodeID_t> nodeIDs;
     std::vector<common::relID_t> relIDs;
-    std::stack<nbrs_t> nbrsStack;
+    std::stack<frontier::bwd_edges_t> nbrsStack;
     std::stack<int64_t> cursorStack;
 };
 
@@ -106,12 +104,18 @@ private:
 class DstNodeWithMultiplicityScanner : public BaseFrontierScanner {
 public:
     DstNodeWithMultiplicityScanner(TargetDstNodes* targetDstNodes, size_t k)
-        : BaseFrontierScanner{targetDstNodes, k} {}
+        : BaseFrontierScanner{targetDstNodes, k}, multiplicity{0} {}
 
 private:
-    inline void initScanFromDstOffset() final {}
+    inline void initScanFromDstOffset() final {
+        multiplicity = frontiers[k]->getMultiplicity(currentDstNodeID);
+    }
     void scanFromDstOffset(RecursiveJoinVectors* vectors, common::sel_t& vectorPos,
         common::sel_t& nodeIDDataVectorPos, common::sel_t& relIDDataVectorPos) final;
+
+private:
+    // Number of times the current dst node remains to be written.
+    uint64_t multiplicity;
 };
 
 /*
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+
+#include "bfs_state.h"
+
+namespace kuzu {
+namespace processor {
+
+/*
+ * MultiSourceShortestPathState computes shortest path lengths (without tracking paths) from up to
+ * 64 src nodes with a single BFS. Each node has a 64-bit mask whose ith bit indicates whether the
+ * node has been visited from the ith src node, so extending a node once serves all src nodes that
+ * have it in their frontiers. Masks are stored in arrays indexed by node offset, which requires all
+ * nodes of the recursive join to be in the same table. The arrays grow with the largest visited
+ * offset and are reused across resetState() calls.
+ *
+ * Once the BFS is complete, initScanFromSrc(i) materializes the frontiers of the ith src node, so
+ * they can be scanned as if they were computed by ShortestPathState from that src node.
+ */
+class MultiSourceShortestPathState : public BaseBFSState {
+public:
+    static constexpr uint32_t MAX_NUM_SRC_NODES = 64;
+
+    MultiSourceShortestPathState(
+        uint8_t upperBound, TargetDstNodes* targetDstNodes, common::table_id_t tableID)
+        : BaseBFSState{upperBound, targetDstNodes, nullptr /* numNodesPerTable */},
+          tableID{tableID}, isScanStarted{false}, numSrcNodes{0}, numSrcNodesWithAllDstReached{0} {}
+    ~MultiSourceShortestPathState() override = default;
+
+    inline bool isComplete() final {
+        // Nodes of the next frontier are only reported once their level is finalized, so we can
+        // only terminate early at the beginning of a level.
+        return isCurrentFrontierEmpty() || isUpperBoundReached() ||
+               (nextNodeIdxToExtend == 0 && isAllDstReached());
+    }
+
+    void resetState() final;
+
+    void markSrc(common::nodeID_t nodeID) final;
+
+    void markVisited(common::nodeID_t boundNodeID, common::nodeID_t nbrNodeID,
+        common::relID_t relID, uint64_t multiplicity) final;
+
+    void finalizeCurrentLevel() final;
+
+    void initScanFromSrc(uint32_t srcIdx);
+
+private:
+    inline bool isAllDstReached() const {
+        return numSrcNodesWithAllDstReached == numSrcNodes;
+    }
+
+    void ensureCapacity(common::offset_t offset);
+
+    void markDstVisited(common::nodeID_t nodeID, uint64_t srcMask);
+
+private:
+    // Table ID of all nodes reachable from the src nodes.
+    common::table_id_t tableID;
+    bool isScanStarted;
+    uint32_t numSrcNodes;
+    uint32_t numSrcNodesWithAllDstReached;
+    std::array<uint64_t, MAX_NUM_SRC_NODES> numVisitedDstNodes;
+    // Bit i of visitedMasks[offset] is set if the node has been visited from the ith src node.
+    // frontierMasks and nextFrontierMasks only keep the bits set at the current and next level.
+    std::vector<uint64_t> visitedMasks;
+    std::vector<uint64_t> frontierMasks;
+    std::vector<uint64_t> nextFrontierMasks;
+    // levelMasks[i][j] is the mask of src nodes whose ith frontier contains the jth node of the ith
+    // shared frontier. Once the scan starts, shared frontiers are swapped into levelFrontiers and
+    // frontiers holds the frontiers of the src node being scanned. Both are swapped back when the
+    // state is reset, so frontiers of both kinds are reused by the next batch.
+    std::vector<std::vector<uint64_t>> levelMasks;
+    std::vector<std::unique_ptr<Frontier>> levelFrontiers;
+};
+
+} // namespace processor
+} // namespace kuzu
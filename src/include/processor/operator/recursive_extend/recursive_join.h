@@ -3,7 +3,9 @@
 #include "bfs_state.h"
 #include "common/query_rel_type.h"
 #include "frontier_scanner.h"
+#include "multi_source_shortest_path_state.h"
 #include "planner/logical_plan/logical_operator/recursive_join_type.h"
+#include "processor/operator/filtering_operator.h"
 #include "processor/operator/physical_operator.h"
 #include "processor/operator/result_collector.h"
 
@@ -14,9 +16,12 @@ class ScanFrontier;
 
 struct RecursiveJoinSharedState {
     std::vector<std::unique_ptr<NodeOffsetSemiMask>> semiMasks;
+    // Tables of nodes that can be visited by the recursive join.
+    std::vector<storage::NodeTable*> recursiveNodeTables;
 
-    RecursiveJoinSharedState(std::vector<std::unique_ptr<NodeOffsetSemiMask>> semiMasks)
-        : semiMasks{std::move(semiMasks)} {}
+    RecursiveJoinSharedState(std::vector<std::unique_ptr<NodeOffsetSemiMask>> semiMasks,
+        std::vector<storage::NodeTable*> recursiveNodeTables)
+        : semiMasks{std::move(semiMasks)}, recursiveNodeTables{std::move(recursiveNodeTables)} {}
 };
 
 struct RecursiveJoinDataInfo {
@@ -33,6 +38,12 @@ struct RecursiveJoinDataInfo {
     DataPos recursiveEdgeIDPos;
     // Path info
     DataPos pathPos;
+    // Reverse recursive join info. Only set if frontiers can be extended bottom-up.
+    std::unique_ptr<ResultSetDescriptor> reverseLocalResultSetDescriptor;
+    DataPos reverseRecursiveNbrNodeIDPos;
+    DataPos reverseRecursiveEdgeIDPos;
+    // Decided by the planner, see LogicalRecursiveExtend::isMultiSourceBFS.
+    bool isMultiSourceBFS = false;
 
     RecursiveJoinDataInfo(const DataPos& srcNodePos, const DataPos& dstNodePos,
         std::unordered_set<common::table_id_t> dstNodeTableIDs, const DataPos& pathLengthPos,
@@ -47,10 +58,23 @@ struct RecursiveJoinDataInfo {
                                                             recursiveDstNodeTableIDs)},
           recursiveEdgeIDPos{recursiveEdgeIDPos}, pathPos{pathPos} {}
 
+    inline void setReverseRecursiveInfo(std::unique_ptr<ResultSetDescriptor> resultSetDescriptor,
+        const DataPos& nbrNodeIDPos, const DataPos& edgeIDPos) {
+        reverseLocalResultSetDescriptor = std::move(resultSetDescriptor);
+        reverseRecursiveNbrNodeIDPos = nbrNodeIDPos;
+        reverseRecursiveEdgeIDPos = edgeIDPos;
+    }
+
     inline std::unique_ptr<RecursiveJoinDataInfo> copy() {
-        return std::make_unique<RecursiveJoinDataInfo>(srcNodePos, dstNodePos, dstNodeTableIDs,
-            pathLengthPos, localResultSetDescriptor->copy(), recursiveDstNodeIDPos,
+        auto result = std::make_unique<RecursiveJoinDataInfo>(srcNodePos, dstNodePos,
+            dstNodeTableIDs, pathLengthPos, localResultSetDescriptor->copy(), recursiveDstNodeIDPos,
             recursiveDstNodeTableIDs, recursiveEdgeIDPos, pathPos);
+        result->isMultiSourceBFS = isMultiSourceBFS;
+        if (reverseLocalResultSetDescriptor != nullptr) {
+            result->setReverseRecursiveInfo(reverseLocalResultSetDescriptor->copy(),
+                reverseRecursiveNbrNodeIDPos, reverseRecursiveEdgeIDPos);
+        }
+        return result;
     }
 };
 
@@ -68,20 +92,24 @@ struct RecursiveJoinVectors {
 
     common::ValueVector* recursiveEdgeIDVector = nullptr;
     common::ValueVector* recursiveDstNodeIDVector = nullptr;
+    common::ValueVector* reverseRecursiveEdgeIDVector = nullptr;
+    common::ValueVector* reverseRecursiveNbrNodeIDVector = nullptr;
 };
 
-class RecursiveJoin : public PhysicalOperator {
+class RecursiveJoin : public PhysicalOperator, SelVectorOverWriter {
 public:
     RecursiveJoin(uint8_t lowerBound, uint8_t upperBound, common::QueryRelType queryRelType,
         planner::RecursiveJoinType joinType, std::shared_ptr<RecursiveJoinSharedState> sharedState,
         std::unique_ptr<RecursiveJoinDataInfo> dataInfo, std::unique_ptr<PhysicalOperator> child,
         uint32_t id, const std::string& paramsString,
-        std::unique_ptr<PhysicalOperator> recursiveRoot)
+        std::unique_ptr<PhysicalOperator> recursiveRoot,
+        std::unique_ptr<PhysicalOperator> reverseRecursiveRoot)
         : PhysicalOperator{PhysicalOperatorType::RECURSIVE_JOIN, std::move(child), id,
               paramsString},
           lowerBound{lowerBound}, upperBound{upperBound}, queryRelType{queryRelType},
           joinType{joinType}, sharedState{std::move(sharedState)}, dataInfo{std::move(dataInfo)},
-          recursiveRoot{std::move(recursiveRoot)} {}
+          recursiveRoot{std::move(recursiveRoot)}, reverseRecursiveRoot{
+                                                       std::move(reverseRecursiveRoot)} {}
 
     inline RecursiveJoinSharedState* getSharedState() const { return sharedState.get(); }
 
@@ -92,18 +120,35 @@ public:
     inline std::unique_ptr<PhysicalOperator> clone() final {
         return std::make_unique<RecursiveJoin>(lowerBound, upperBound, queryRelType, joinType,
             sharedState, dataInfo->copy(), children[0]->clone(), id, paramsString,
-            recursiveRoot->clone());
+            recursiveRoot->clone(),
+            reverseRecursiveRoot != nullptr ? reverseRecursiveRoot->clone() : nullptr);
     }
 
 private:
     void initLocalRecursivePlan(ExecutionContext* context);
 
     void populateTargetDstNodes();
+    // Frontiers switch to their dense representation based on the number of nodes of each table.
+    void populateNumNodesPerTable();
 
     bool scanOutput();
 
     // Compute BFS for a given src node.
     void computeBFS(ExecutionContext* context);
+    // Extend frontiers from the marked src nodes until BFS is complete.
+    void extendFrontiers(ExecutionContext* context);
+    // Extend the current frontier from all unvisited nodes through the reverse recursive plan.
+    void extendCurrentFrontierBottomUp(ExecutionContext* context);
+    // Mark an unvisited node as visited from its first nbr found in the current frontier.
+    void extendBottomUp(common::nodeID_t nodeID, ExecutionContext* context);
+
+    // Move to the next src node and prepare its frontiers for output. Src nodes are read from the
+    // input in batches and each batch is traversed by a single multi-source BFS. If the src data
+    // chunk is unflat, the recursive join flattens it in the same way as the Flatten operator.
+    bool scanNextSrcNode(ExecutionContext* context);
+    void computeMultiSourceBFS(ExecutionContext* context);
+
+    void resetToCurrentSelVector(std::shared_ptr<common::SelectionVector>& selVector) override;
 
     void updateVisitedNodes(common::nodeID_t boundNodeID);
 
@@ -120,9 +165,23 @@ private:
     std::unique_ptr<ResultSet> localResultSet;
     std::unique_ptr<PhysicalOperator> recursiveRoot;
     ScanFrontier* scanFrontier;
+    // Local reverse recursive plan. Null if frontiers are always extended top-down.
+    std::unique_ptr<ResultSet> reverseLocalResultSet;
+    std::unique_ptr<PhysicalOperator> reverseRecursiveRoot;
+    ScanFrontier* reverseScanFrontier = nullptr;
 
     std::unique_ptr<RecursiveJoinVectors> vectors;
+    // Indexed by table ID.
+    std::vector<uint64_t> numNodesPerTable;
     std::unique_ptr<BaseBFSState> bfsState;
+    // Set if bfsState computes shortest paths from multiple src nodes at once.
+    MultiSourceShortestPathState* multiSourceBFSState = nullptr;
+    bool isSrcNodeChunkFlat = true;
+    uint64_t numSrcNodesInChunk = 0;
+    // The current batch contains src nodes in [batchStartIdx, batchEndIdx) of the src data chunk.
+    uint64_t batchStartIdx = 0;
+    uint64_t batchEndIdx = 0;
+    uint64_t nextSrcNodeIdx = 0;
     std::unique_ptr<FrontiersScanner> frontiersScanner;
     std::unique_ptr<TargetDstNodes> targetDstNodes;
 };
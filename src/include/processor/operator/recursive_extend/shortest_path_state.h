@@ -8,8 +8,22 @@ namespace processor {
 template<bool TRACK_PATH>
 class ShortestPathState : public BaseBFSState {
 public:
-    ShortestPathState(uint8_t upperBound, TargetDstNodes* targetDstNodes)
-        : BaseBFSState{upperBound, targetDstNodes}, numVisitedDstNodes{0} {}
+    // Direction-optimizing BFS switches to bottom-up extension once the current frontier contains
+    // more than 1/TOP_DOWN_TO_BOTTOM_UP of the unvisited nodes, and switches back to top-down
+    // extension once it contains less than 1/BOTTOM_UP_TO_TOP_DOWN of all nodes.
+    static constexpr uint64_t TOP_DOWN_TO_BOTTOM_UP = 14;
+    static constexpr uint64_t BOTTOM_UP_TO_TOP_DOWN = 24;
+
+    ShortestPathState(uint8_t upperBound, TargetDstNodes* targetDstNodes,
+        const std::vector<uint64_t>* numNodesPerTable)
+        : BaseBFSState{upperBound, targetDstNodes, numNodesPerTable}, numVisitedDstNodes{0},
+          numNodes{0}, isExtendingBottomUp{false} {
+        if (numNodesPerTable != nullptr) {
+            for (auto numNodesInTable : *numNodesPerTable) {
+                numNodes += numNodesInTable;
+            }
+        }
+    }
     ~ShortestPathState() override = default;
 
     inline bool isComplete() final {
@@ -18,11 +32,12 @@ public:
     inline void resetState() final {
         BaseBFSState::resetState();
         numVisitedDstNodes = 0;
-        visited.clear();
+        isExtendingBottomUp = false;
+        visitedNodeToLevel.clear();
     }
 
     inline void markSrc(common::nodeID_t nodeID) final {
-        visited.insert(nodeID);
+        visitedNodeToLevel.insert({nodeID, 0});
         if (targetDstNodes->contains(nodeID)) {
             numVisitedDstNodes++;
         }
@@ -31,10 +46,10 @@ public:
 
     inline void markVisited(common::nodeID_t boundNodeID, common::nodeID_t nbrNodeID,
         common::nodeID_t relID, uint64_t multiplicity) final {
-        if (visited.contains(nbrNodeID)) {
+        if (visitedNodeToLevel.contains(nbrNodeID)) {
             return;
         }
-        visited.insert(nbrNodeID);
+        visitedNodeToLevel.insert({nbrNodeID, currentLevel + 1});
         if (targetDstNodes->contains(nbrNodeID)) {
             numVisitedDstNodes++;
         }
@@ -45,6 +60,28 @@ public:
         }
     }
 
+    bool shouldExtendBottomUp() final {
+        if (nextNodeIdxToExtend != 0) {
+            return false;
+        }
+        auto numFrontierNodes = currentFrontier->nodeIDs.size();
+        if (isExtendingBottomUp) {
+            isExtendingBottomUp = numFrontierNodes * BOTTOM_UP_TO_TOP_DOWN >= numNodes;
+        } else {
+            auto numVisitedNodes = visitedNodeToLevel.size();
+            auto numUnvisitedNodes = numNodes > numVisitedNodes ? numNodes - numVisitedNodes : 0;
+            isExtendingBottomUp = numFrontierNodes * TOP_DOWN_TO_BOTTOM_UP > numUnvisitedNodes;
+        }
+        return isExtendingBottomUp;
+    }
+    inline bool isVisited(common::nodeID_t nodeID) const final {
+        return visitedNodeToLevel.contains(nodeID);
+    }
+    inline bool isOnCurrentFrontier(common::nodeID_t nodeID) const final {
+        auto iter = visitedNodeToLevel.find(nodeID);
+        return iter != visitedNodeToLevel.end() && iter->second == currentLevel;
+    }
+
 private:
     inline bool isAllDstReached() const {
         return numVisitedDstNodes == targetDstNodes->getNumNodes();
@@ -52,7 +89,10 @@ private:
 
 private:
     uint64_t numVisitedDstNodes;
-    frontier::node_id_set_t visited;
+    // Number of nodes that can be visited.
+    uint64_t numNodes;
+    bool isExtendingBottomUp;
+    frontier::node_id_map_t<uint8_t> visitedNodeToLevel;
 };
 
 } // namespace processor
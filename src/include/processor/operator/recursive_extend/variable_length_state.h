@@ -7,8 +7,9 @@ namespace processor {
 
 template<bool TRACK_PATH>
 struct VariableLengthState : public BaseBFSState {
-    VariableLengthState(uint8_t upperBound, TargetDstNodes* targetDstNodes)
-        : BaseBFSState{upperBound, targetDstNodes} {}
+    VariableLengthState(uint8_t upperBound, TargetDstNodes* targetDstNodes,
+        const std::vector<uint64_t>* numNodesPerTable)
+        : BaseBFSState{upperBound, targetDstNodes, numNodesPerTable} {}
     ~VariableLengthState() override = default;
 
     inline void resetState() final { BaseBFSState::resetState(); }
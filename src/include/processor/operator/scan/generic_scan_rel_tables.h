@@ -18,6 +18,8 @@ public:
     }
 
     void init();
+    // Drops the rest of the lists that are being scanned.
+    void resetListSyncStates();
     bool scan(common::ValueVector* inVector, const std::vector<common::ValueVector*>& outputVectors,
         transaction::Transaction* transaction);
 
@@ -49,6 +51,7 @@ public:
     std::unique_ptr<PhysicalOperator> clone() final;
 
 private:
+    void resetInputStateInternal() final;
     void resetState();
     void initCurrentScanner(const common::nodeID_t& nodeID);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "processor/operator/physical_operator.h"
+#include "storage/store/node_table.h"
 
 namespace kuzu {
 namespace processor {
@@ -16,6 +17,16 @@ protected:
 
     void initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) override;
 
+    // Returns true if the input node IDs are an unflat morsel of consecutive node offsets, e.g.,
+    // produced by ScanNodeID. The pages of the following morsels are then likely to be scanned
+    // next, so they are read ahead.
+    inline bool shouldReadAhead() const {
+        return !inputNodeIDVector->state->isFlat() && inputNodeIDVector->isSequential();
+    }
+    // Reads ahead the pages of the given columns holding the nodes of the next
+    // NUM_VECTORS_TO_READ_AHEAD vectors, starting from the current morsel.
+    void readAhead(storage::NodeTable* table, const std::vector<uint32_t>& columnIds);
+
 protected:
     DataPos inputNodeIDVectorPos;
     common::ValueVector* inputNodeIDVector;
@@ -24,6 +24,9 @@ public:
             scanInfo->copy(), posInfo->copy(), children[0]->clone(), id, paramsString);
     }
 
+private:
+    inline void resetInputStateInternal() final { scanState->syncState->resetState(); }
+
 private:
     std::unique_ptr<RelTableScanInfo> scanInfo;
     std::unique_ptr<storage::RelTableScanState> scanState;
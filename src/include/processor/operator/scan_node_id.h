@@ -23,22 +23,34 @@ public:
     inline bool isSemiMaskEnabled() { return semiMask->isEnabled(); }
     inline NodeOffsetAndMorselSemiMask* getSemiMask() { return semiMask.get(); }
 
+    inline void addZoneMapPredicate(
+        storage::ZoneMap* zoneMap, const storage::ZoneMapPredicate& predicate) {
+        zoneMapPredicates.emplace_back(zoneMap, predicate);
+    }
+
     std::pair<common::offset_t, common::offset_t> getNextRangeToRead();
 
+private:
+    // Returns false if the morsel has no node in the semi mask, or if the zone map of a predicate
+    // shows that no node of the morsel satisfies the predicate.
+    bool isMorselSelected(uint64_t morselIdx);
+
 private:
     storage::NodeTable* table;
     common::offset_t maxNodeOffset;
     common::offset_t maxMorselIdx;
     common::offset_t currentNodeOffset;
     std::unique_ptr<NodeOffsetAndMorselSemiMask> semiMask;
+    std::vector<std::pair<storage::ZoneMap*, storage::ZoneMapPredicate>> zoneMapPredicates;
 };
 
 class ScanNodeIDSharedState {
 public:
     ScanNodeIDSharedState() : currentStateIdx{0} {};
 
-    inline void addTableState(storage::NodeTable* table) {
+    inline NodeTableScanState* addTableState(storage::NodeTable* table) {
         tableStates.push_back(std::make_unique<NodeTableScanState>(table));
+        return tableStates.back().get();
     }
     inline uint32_t getNumTableStates() const { return tableStates.size(); }
     inline NodeTableScanState* getTableState(uint32_t idx) const { return tableStates[idx].get(); }
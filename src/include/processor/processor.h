@@ -13,14 +13,21 @@ namespace processor {
 class QueryProcessor {
 
 public:
-    explicit QueryProcessor(uint64_t numThreads);
+    explicit QueryProcessor(uint64_t numThreads, bool pinThreadsToNUMANodes = false);
 
     std::shared_ptr<FactorizedTable> execute(PhysicalPlan* physicalPlan, ExecutionContext* context);
 
+    inline common::TaskScheduler* getTaskScheduler() { return taskScheduler.get(); }
+
 private:
     void decomposePlanIntoTasks(PhysicalOperator* op, PhysicalOperator* parent,
         common::Task* parentTask, ExecutionContext* context);
 
+    // Returns true if the pipelines of the plan do not depend on each other besides the
+    // dependencies captured by the task tree, so that child tasks can be executed concurrently.
+    static bool canExecuteChildTasksConcurrently(PhysicalOperator* op);
+    static void setIndependentChildTasks(common::Task* task);
+
 private:
     std::unique_ptr<common::TaskScheduler> taskScheduler;
 };
@@ -49,6 +49,9 @@ public:
     inline void resetToZero() {
         memset(block->buffer, 0, common::BufferPoolConstants::PAGE_256KB_SIZE);
     }
+    inline void unpin() { block->unpin(); }
+    inline uint64_t pin() { return block->pin(); }
+    inline bool isPinned() const { return block->isPinned(); }
 
     static void copyTuples(DataBlock* blockToCopyFrom, ft_tuple_idx_t tupleIdxToCopyFrom,
         DataBlock* blockToCopyInto, ft_tuple_idx_t tupleIdxToCopyTo, uint32_t numTuplesToCopy,
@@ -86,6 +89,10 @@ public:
     inline uint64_t getNumBlocks() const { return blocks.size(); }
 
     void merge(DataBlockCollection& other);
+    void unpinBlocks(bool keepLastBlockPinned = false);
+    // Unpins all blocks except the last one, which tuples are appended to.
+    void unpinFullBlocks();
+    uint64_t pinBlocks();
 
 private:
     uint32_t numBytesPerTuple;
@@ -211,6 +218,18 @@ public:
     // other factorizedTable.
     void mergeMayContainNulls(FactorizedTable& other);
     void merge(FactorizedTable& other);
+    // Unpins all blocks of the table so that they can be spilled under memory pressure. The table
+    // must not be accessed until pinBlocks is called. Returns the number of bytes read back from
+    // disk.
+    void unpinBlocks();
+    uint64_t pinBlocks();
+    // Unpins all blocks except the last flat tuple block, which merging another table into this
+    // table copies tuples into.
+    void unpinBlocksExceptLastFlatTupleBlock();
+    // Unpins the blocks that appending to the table no longer writes to, i.e., all blocks except
+    // the last flat and unflat tuple blocks and the current overflow block.
+    void unpinFullBlocks();
+    uint64_t getNumBlocks() const;
 
     inline common::InMemOverflowBuffer* getInMemOverflowBuffer() const {
         return inMemOverflowBuffer.get();
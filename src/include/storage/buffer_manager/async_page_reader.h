@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/file_utils.h"
+
+namespace kuzu {
+namespace storage {
+
+// Reads consecutive pages of a file from fileOffset into the frames given by the buffers.
+struct PageReadRequest {
+    common::FileInfo* fileInfo;
+    uint64_t fileOffset;
+    std::vector<common::FileBuffer> buffers;
+    // Called by the reader thread once the read is done. The argument is false if the read failed.
+    std::function<void(bool)> onCompletion;
+};
+
+// AsyncPageReader reads pages into frames on a pool of background threads, so a thread that needs a
+// range of pages can issue all reads at once instead of waiting for each read in turn. Each request
+// is served by a single vectored read, and the threads serve requests concurrently, which keeps
+// multiple reads in flight to the device. Queued requests are drained before the threads are
+// stopped.
+class AsyncPageReader {
+public:
+    explicit AsyncPageReader(uint64_t numThreads);
+    ~AsyncPageReader();
+
+    void submit(std::vector<PageReadRequest> requestsToSubmit);
+
+private:
+    void runReaderThread();
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<PageReadRequest> requests;
+    bool stopThreads;
+    std::vector<std::thread> threads;
+};
+
+} // namespace storage
+} // namespace kuzu
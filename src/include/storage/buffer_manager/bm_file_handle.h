@@ -1,5 +1,7 @@
 #pragma once
 
+#include <thread>
+
 #include "storage/buffer_manager/vm_region.h"
 #include "storage/file_handle.h"
 
@@ -144,6 +146,16 @@ public:
         assert(pageIdx < numPages);
         pageStates[pageIdx]->setDirty();
     }
+    inline bool isPageEvicted(common::page_idx_t pageIdx) {
+        return getPageState(pageIdx)->getState() == PageState::EVICTED;
+    }
+    // Pages being prefetched stay LOCKED until their reads complete. Functions that release frames
+    // or page states of the file without locking each page first wait for these reads.
+    inline void waitForPendingPageReads() const {
+        while (numPendingPageReads.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
 
     common::page_group_idx_t addWALPageIdxGroupIfNecessary(common::page_idx_t originalPageIdx);
     // This function is intended to be used after a fileInfo is created and we want the file
@@ -199,6 +211,8 @@ private:
     // `WALPageIdxGroup` records the WAL page idx for each page in the page group.
     // Accesses to this map is synchronized by `fhSharedMutex`.
     std::unordered_map<common::page_group_idx_t, std::unique_ptr<WALPageIdxGroup>> walPageIdxGroups;
+    // Number of pages of the file whose asynchronous reads are not complete yet.
+    std::atomic<uint64_t> numPendingPageReads;
 };
 } // namespace storage
 } // namespace kuzu
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "concurrentqueue.h"
+#include "storage/buffer_manager/async_page_reader.h"
 #include "storage/buffer_manager/bm_file_handle.h"
 
 namespace spdlog {
@@ -56,8 +57,12 @@ public:
         std::shared_lock sLck{mtx};
         return queue->try_dequeue(candidate);
     }
+    // The count is approximate if other threads enqueue or dequeue concurrently.
+    inline bool isFull() const { return queue->size_approx() >= capacity; }
 
-    void removeNonEvictableCandidates();
+    // Candidates that are second chance evictable are moved to secondChanceQueue, which is either
+    // this queue or, for the probationary queue, the main eviction queue.
+    void removeNonEvictableCandidates(EvictionQueue& secondChanceQueue);
 
     void removeCandidatesForFile(BMFileHandle& fileHandle);
 
@@ -67,6 +72,17 @@ private:
     std::unique_ptr<moodycamel::ConcurrentQueue<EvictionCandidate>> queue;
 };
 
+// Counts the pages requested through `BufferManager::prefetch`.
+struct PrefetchStats {
+    // Pages that were already cached, or being read by another thread, when they were requested.
+    uint64_t numPageHits = 0;
+    // Pages that were evicted when they were requested.
+    uint64_t numPageMisses = 0;
+    // Missed pages whose reads were issued asynchronously. The other missed pages are read
+    // synchronously when they are pinned.
+    uint64_t numPagesPrefetched = 0;
+};
+
 /**
  * The Buffer Manager (BM) is a centralized manager of database memory resources.
  * It provides two main functionalities:
@@ -155,6 +171,35 @@ private:
  * 7. During eviction, if the page is in the MARKED state, it will be LOCKED first (7.1), then
  * removed from its frame, and set to EVICTED (7.2).
  *
+ * Prefetch:
+ * Sequential scans can call `prefetch` to read ahead a range of pages. Each evicted page of the
+ * range is LOCKED and its frame is claimed by the calling thread. Runs of consecutive evicted pages
+ * are grouped into extents of up to MAX_NUM_PAGES_PER_EXTENT pages, and each extent is read with a
+ * single vectored read by a background thread of the AsyncPageReader, which unpins the pages once
+ * the read completes. Frames of pages in the same page group are contiguous, so an extent is mostly
+ * read into a single buffer. A scan that pins or optimistically reads the page in the meantime
+ * spins on the LOCKED state as if the page was pinned by another thread, so it never sees a
+ * partially read frame. Likewise, `flushAllDirtyPagesInFrames` writes runs of consecutive dirty
+ * pages as extents.
+ *
+ * Eviction policies:
+ * With the default SECOND_CHANCE policy, all unpinned pages are enqueued into a single FIFO
+ * eviction queue, and pages that are read again before they reach the front of the queue get a
+ * second chance (see transition 6). A single large scan then cycles all of its pages through the
+ * queue and evicts the pages that are repeatedly accessed by other queries, e.g., the pages of the
+ * hash index or of the adjacency lists used by point lookups.
+ * The SCAN_RESISTANT policy adds a probationary eviction queue in the spirit of 2Q. Callers pass
+ * AccessHint::SCAN to `optimisticRead` or `unpin` when they read pages sequentially, and the pages
+ * read by `prefetch` are hinted likewise. Pages loaded by a scan are enqueued into the probationary
+ * queue, and `claimAFrame` evicts from the probationary queue before the main queue, so a scan
+ * mostly recycles its own frames. The probationary queue is also bounded to a fraction of the
+ * frames: once it is full, each page loaded by a scan evicts the oldest probationary page, so a
+ * scan can't fill a buffer pool that still has free frames either. A probationary page that is
+ * read again without the hint is second chance evictable, and it is promoted to the main queue
+ * instead of being evicted when it reaches the front of the probationary queue. Scan
+ * reads of MARKED pages don't clear the mark, so a scan neither promotes pages nor protects them
+ * from eviction. Under the SECOND_CHANCE policy, the hint is ignored.
+ *
  * The design is inspired by vmcache in the paper "Virtual-Memory Assisted Buffer Management"
  * (https://www.cs.cit.tum.de/fileadmin/w00cfj/dis/_my_direct_uploads/vmcache.pdf).
  * We would also like to thank Fadhil Abubaker for doing the initial research and prototyping of
@@ -165,16 +210,24 @@ private:
 class BufferManager {
 public:
     enum class PageReadPolicy : uint8_t { READ_PAGE = 0, DONT_READ_PAGE = 1 };
+    enum class AccessHint : uint8_t { NORMAL = 0, SCAN = 1 };
 
-    explicit BufferManager(uint64_t bufferPoolSize);
+    explicit BufferManager(uint64_t bufferPoolSize,
+        common::EvictionPolicy evictionPolicy = common::EvictionPolicy::SECOND_CHANCE);
     ~BufferManager() = default;
 
     uint8_t* pin(BMFileHandle& fileHandle, common::page_idx_t pageIdx,
         PageReadPolicy pageReadPolicy = PageReadPolicy::READ_PAGE);
     void optimisticRead(BMFileHandle& fileHandle, common::page_idx_t pageIdx,
-        const std::function<void(uint8_t*)>& func);
-    // The function assumes that the requested page is already pinned.
-    void unpin(BMFileHandle& fileHandle, common::page_idx_t pageIdx);
+        const std::function<void(uint8_t*)>& func, AccessHint accessHint = AccessHint::NORMAL);
+    // The function assumes that the requested page is already pinned. The access hint of a pinned
+    // page is given when it is unpinned, because that is when the page is enqueued for eviction.
+    void unpin(BMFileHandle& fileHandle, common::page_idx_t pageIdx,
+        AccessHint accessHint = AccessHint::NORMAL);
+    // Reads the evicted pages among the numPages pages from startPageIdx into their frames
+    // asynchronously. Pages beyond the end of the file are ignored. See `Prefetch` above.
+    void prefetch(BMFileHandle& fileHandle, common::page_idx_t startPageIdx, uint64_t numPages,
+        PrefetchStats& stats);
 
     // Currently, these functions are specifically used only for WAL files.
     void removeFilePagesFromFrames(BMFileHandle& fileHandle);
@@ -193,7 +246,17 @@ public:
     inline common::frame_group_idx_t addNewFrameGroup(common::PageSizeClass pageSizeClass) {
         return vmRegions[pageSizeClass]->addNewFrameGroup();
     }
-    inline void clearEvictionQueue() { evictionQueue = std::make_unique<EvictionQueue>(0); }
+    inline void clearEvictionQueue() {
+        evictionQueue = std::make_unique<EvictionQueue>(0);
+        probationaryEvictionQueue = std::make_unique<EvictionQueue>(0);
+    }
+
+    // Reserves memory that is used outside the frames, e.g., by data that COPY keeps on the heap,
+    // by evicting pages if necessary. Returns false without reserving if not enough pages can be
+    // evicted. Reserved memory must be given back by `releaseMemory`.
+    bool reserveMemory(uint64_t size);
+    inline void releaseMemory(uint64_t size) { freeUsedMemory(size); }
+    inline uint64_t getBufferPoolSize() const { return bufferPoolSize; }
 
 private:
     bool claimAFrame(
@@ -201,14 +264,29 @@ private:
     // Return number of bytes freed.
     uint64_t tryEvictPage(EvictionCandidate& candidate);
 
+    // Returns a request that reads the pages from startPageIdx, whose states are given, into their
+    // frames and unpins them. The pages must be LOCKED and their frames claimed.
+    PageReadRequest createExtentReadRequest(BMFileHandle& fileHandle,
+        common::page_idx_t startPageIdx, std::vector<PageState*> pageStates);
+    // Returns the frames of the given consecutive pages as buffers of a vectored read or write.
+    std::vector<common::FileBuffer> getExtentBuffers(
+        BMFileHandle& fileHandle, common::page_idx_t startPageIdx, uint64_t numPages);
     void cachePageIntoFrame(
         BMFileHandle& fileHandle, common::page_idx_t pageIdx, PageReadPolicy pageReadPolicy);
     void flushIfDirtyWithoutLock(BMFileHandle& fileHandle, common::page_idx_t pageIdx);
     void removePageFromFrame(
         BMFileHandle& fileHandle, common::page_idx_t pageIdx, bool shouldFlush);
 
-    void addToEvictionQueue(
-        BMFileHandle* fileHandle, common::page_idx_t pageIdx, PageState* pageState);
+    void addToEvictionQueue(BMFileHandle* fileHandle, common::page_idx_t pageIdx,
+        PageState* pageState, AccessHint accessHint);
+    // Evicts the oldest candidate of the full probationary queue, or promotes it to the main queue
+    // if it is second chance evictable.
+    void evictOrPromoteProbationaryCandidate();
+
+    inline bool isScanResistantAccess(AccessHint accessHint) const {
+        return evictionPolicy == common::EvictionPolicy::SCAN_RESISTANT &&
+               accessHint == AccessHint::SCAN;
+    }
 
     inline uint64_t reserveUsedMemory(uint64_t size) { return usedMemory.fetch_add(size); }
     inline uint64_t freeUsedMemory(uint64_t size) { return usedMemory.fetch_sub(size); }
@@ -225,10 +303,15 @@ private:
     std::atomic<uint64_t> usedMemory;
     std::atomic<uint64_t> bufferPoolSize;
     std::atomic<uint64_t> numEvictionQueueInsertions;
+    common::EvictionPolicy evictionPolicy;
     // Each VMRegion corresponds to a virtual memory region of a specific page size. Currently, we
     // hold two sizes of PAGE_4KB and PAGE_256KB.
     std::vector<std::unique_ptr<VMRegion>> vmRegions;
     std::unique_ptr<EvictionQueue> evictionQueue;
+    // Only used by the SCAN_RESISTANT policy. See `Eviction policies` above.
+    std::unique_ptr<EvictionQueue> probationaryEvictionQueue;
+    // Declared last, so its threads are joined before the frames they read into are released.
+    std::unique_ptr<AsyncPageReader> asyncPageReader;
 };
 
 } // namespace storage
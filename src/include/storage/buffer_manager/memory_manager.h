@@ -4,6 +4,7 @@
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <string>
 
 #include "common/constants.h"
 #include "common/types/types.h"
@@ -20,26 +21,46 @@ public:
     MemoryBuffer(MemoryAllocator* allocator, common::page_idx_t blockIdx, uint8_t* buffer);
     ~MemoryBuffer();
 
+    // Marks the buffer as evictable, so that the buffer manager can spill it to the spill file of
+    // the allocator under memory pressure. The address of the buffer stays valid: pinning it again
+    // restores the content at the same address. If the allocator is not backed by a spill file,
+    // the buffer stays in memory.
+    void unpin();
+    // Returns the number of bytes read back from the spill file to pin the buffer again.
+    uint64_t pin();
+    inline bool isPinned() const { return pinned; }
+
 public:
     uint8_t* buffer;
     common::page_idx_t pageIdx;
     MemoryAllocator* allocator;
+
+private:
+    bool pinned;
 };
 
 class MemoryAllocator {
     friend class MemoryBuffer;
 
 public:
-    explicit MemoryAllocator(BufferManager* bm);
+    MemoryAllocator(BufferManager* bm, const std::string& spillDirectory);
     ~MemoryAllocator();
 
     std::unique_ptr<MemoryBuffer> allocateBuffer(bool initializeToZero = false);
     inline common::page_offset_t getPageSize() const { return pageSize; }
+    inline bool canSpill() const { return !spillFilePath.empty(); }
+    inline const std::string& getSpillFilePath() const { return spillFilePath; }
 
 private:
-    void freeBlock(common::page_idx_t pageIdx);
+    // Creates a new spill file in the directory. Several databases may share the directory, so the
+    // file name is unique, and the file is created exclusively.
+    static std::string createSpillFile(const std::string& directory);
+    void freeBlock(common::page_idx_t pageIdx, bool pinned);
+    void unpinBlock(common::page_idx_t pageIdx);
+    uint64_t pinBlock(common::page_idx_t pageIdx);
 
 private:
+    std::string spillFilePath;
     std::unique_ptr<BMFileHandle> fh;
     BufferManager* bm;
     common::page_offset_t pageSize;
@@ -61,17 +82,25 @@ private:
  *
  * MM will return a MemoryBuffer to the caller, which is a wrapper of the allocated memory block,
  * and it will automatically call its allocator to reclaim the memory block when it is destroyed.
+ *
+ * If a spill directory is given, the BMFileHandle is backed by a new spill file in that directory
+ * instead, and operators can unpin memory buffers they do not need for a while (e.g. the local
+ * hash tables of an aggregation waiting to be merged). Unpinned buffers are written to the spill
+ * file when the buffer manager evicts them, which lets intermediate results exceed the buffer pool
+ * size. The spill file is removed when the MM is destroyed.
  */
 class MemoryManager {
 public:
-    explicit MemoryManager(BufferManager* bm) : bm{bm} {
-        allocator = std::make_unique<MemoryAllocator>(bm);
+    explicit MemoryManager(BufferManager* bm, const std::string& spillDirectory = "") : bm{bm} {
+        allocator = std::make_unique<MemoryAllocator>(bm, spillDirectory);
     }
 
     inline std::unique_ptr<MemoryBuffer> allocateBuffer(bool initializeToZero = false) {
         return allocator->allocateBuffer(initializeToZero);
     }
     inline BufferManager* getBufferManager() const { return bm; }
+    inline bool canSpill() const { return allocator->canSpill(); }
+    inline const std::string& getSpillFilePath() const { return allocator->getSpillFilePath(); }
 
 private:
     BufferManager* bm;
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "catalog/table_schema.h"
+#include "common/copier_config/copier_config.h"
+#include "common/file_utils.h"
+#include "common/task_system/task_scheduler.h"
+#include <arrow/api.h>
+
+namespace kuzu {
+namespace storage {
+
+// A range of bytes of a CSV file that starts and ends at row boundaries.
+struct CSVBlock {
+    CSVBlock(uint64_t startOffset, uint64_t endOffset, common::row_idx_t numRows)
+        : startOffset{startOffset}, endOffset{endOffset}, numRows{numRows} {}
+
+    uint64_t startOffset;
+    uint64_t endOffset;
+    common::row_idx_t numRows;
+};
+
+/**
+ * CSVReader parses the CSV files of COPY into arrow arrays of the types that COPY expects for the
+ * columns of the table, so the copiers consume them as the arrays read from other file types.
+ *
+ * The file is first split into blocks of rows. The split reads fixed-size chunks of the file in
+ * parallel, with a task of the task scheduler. A row terminator is a newline outside quotes, and
+ * whether a chunk starts inside quotes depends on all bytes before it, so each chunk is scanned
+ * twice: assuming that it starts outside and inside quotes. A sequential pass then follows the
+ * quote state from the start of the file through the chunks, picks the scan of each chunk that
+ * matches its actual start state, and ends the blocks after the last row terminator of each chunk.
+ * In rare cases a chunk starts right after an escape character, or with a quote at the start of a
+ * field, and is scanned again from that state.
+ *
+ * Blocks are parsed independently, so copy threads parse different blocks in parallel. Fields are
+ * parsed directly into the buffers of the arrays, without intermediate string values.
+ *
+ * The scans skip over bytes that aren't delimiters, quotes, escapes or newlines 8 bytes at a time.
+ *
+ * A quote character starts a quoted part of a field only at the start of the field, or right after
+ * the closing quote of a quoted part, so that two quotes in a row inside quotes are a literal
+ * quote. Other quotes outside quotes are literal, e.g. 5'10". The escape character makes the next
+ * character literal, also outside quotes. An empty field that isn't quoted is NULL. Rows end with
+ * "\n" or "\r\n".
+ */
+class CSVReader {
+public:
+    CSVReader(const std::string& filePath, const common::CSVReaderConfig& csvReaderConfig,
+        catalog::TableSchema* tableSchema);
+
+    // Splits the file into blocks of rows, which end at the last row boundary before a multiple of
+    // blockSize bytes. The chunks are scanned by up to numThreads threads of the task scheduler.
+    void splitIntoBlocks(common::TaskScheduler& taskScheduler, uint64_t numThreads,
+        uint64_t blockSize = common::CopyConstants::CSV_READING_BLOCK_SIZE);
+
+    inline uint64_t getNumBlocks() const { return blocks.size(); }
+    inline common::row_idx_t getNumRowsInBlock(common::block_idx_t blockIdx) const {
+        return blocks[blockIdx].numRows;
+    }
+    inline common::row_idx_t getNumRows() const { return numRows; }
+
+    // Blocks can be read concurrently.
+    std::shared_ptr<arrow::RecordBatch> readBlock(common::block_idx_t blockIdx) const;
+
+private:
+    struct ScanState {
+        bool inQuote = false;
+        bool escaped = false;
+        // Whether a quote at the current position starts a quoted part of a field.
+        bool canOpenQuote = true;
+    };
+
+    struct ChunkScanResult {
+        common::row_idx_t numRows = 0;
+        // The offset after the last row terminator of the chunk, if the chunk has any.
+        uint64_t endOffsetOfLastRow = UINT64_MAX;
+        ScanState endState;
+        bool startsWithQuote = false;
+    };
+
+    uint64_t getStartOffsetOfRows(uint64_t fileSize);
+    ChunkScanResult scanChunk(
+        uint64_t startOffset, uint64_t numBytes, ScanState startState, char* buffer) const;
+    ChunkScanResult scanRowTerminators(
+        const char* data, uint64_t numBytes, uint64_t startOffset, ScanState state) const;
+
+private:
+    std::string filePath;
+    common::CSVReaderConfig csvReaderConfig;
+    std::shared_ptr<arrow::Schema> schema;
+    std::unique_ptr<common::FileInfo> fileInfo;
+    std::vector<CSVBlock> blocks;
+    common::row_idx_t numRows;
+};
+
+} // namespace storage
+} // namespace kuzu
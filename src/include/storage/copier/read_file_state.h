@@ -1,5 +1,6 @@
 #pragma once
 
+#include "storage/copier/csv_reader.h"
 #include "storage/copier/table_copy_utils.h"
 
 namespace kuzu {
@@ -23,16 +24,21 @@ public:
     common::row_idx_t rowIdxInFile;
 };
 
-// For CSV file, we need to read in streaming mode, so we need to read one batch at a time.
+// A block of rows of a CSV file. The block is parsed by the thread that copies it.
 class ReadCSVMorsel : public ReadFileMorsel {
 public:
-    ReadCSVMorsel(common::offset_t startRowIdx, std::string filePath,
-        common::row_idx_t rowIdxInFile, std::shared_ptr<arrow::RecordBatch> recordBatch)
-        : ReadFileMorsel{startRowIdx, common::INVALID_BLOCK_IDX, common::INVALID_ROW_IDX,
-              std::move(filePath), rowIdxInFile},
-          recordBatch{std::move(recordBatch)} {}
+    ReadCSVMorsel(common::row_idx_t rowIdx, common::block_idx_t blockIdx,
+        common::row_idx_t numRows, std::string filePath, common::row_idx_t rowIdxInFile,
+        std::shared_ptr<CSVReader> reader)
+        : ReadFileMorsel{rowIdx, blockIdx, numRows, std::move(filePath), rowIdxInFile},
+          reader{std::move(reader)} {}
 
-    std::shared_ptr<arrow::RecordBatch> recordBatch;
+    inline std::shared_ptr<arrow::RecordBatch> readRecordBatch() const {
+        return reader->readBlock(blockIdx);
+    }
+
+private:
+    std::shared_ptr<CSVReader> reader;
 };
 
 class ReadFileSharedState {
@@ -44,7 +50,8 @@ public:
           currRowIdxInCurrFile{1} {};
     virtual ~ReadFileSharedState() = default;
 
-    virtual void countNumRows() = 0;
+    // Called before the morsels are read, by the thread that schedules the tasks that read them.
+    virtual void countNumRows(processor::ExecutionContext* context) = 0;
     virtual std::unique_ptr<ReadFileMorsel> getMorsel() = 0;
 
 public:
@@ -60,19 +67,21 @@ public:
     common::row_idx_t currRowIdxInCurrFile;
 };
 
-// For CSV file, we need to read in streaming mode, so we need to keep the reader in the shared
-// state.
+// CSV files are split into blocks of rows when they are counted. The split of each file runs on the
+// task scheduler with up to the number of threads of the query.
 class ReadCSVSharedState : public ReadFileSharedState {
 public:
     ReadCSVSharedState(std::vector<std::string> filePaths, common::CSVReaderConfig csvReaderConfig,
         catalog::TableSchema* tableSchema)
-        : ReadFileSharedState{std::move(filePaths), csvReaderConfig, tableSchema} {};
+        : ReadFileSharedState{std::move(filePaths), csvReaderConfig, tableSchema} {
+        readers.resize(this->filePaths.size());
+    };
 
-    void countNumRows() final;
+    void countNumRows(processor::ExecutionContext* context) final;
     std::unique_ptr<ReadFileMorsel> getMorsel() final;
 
 private:
-    std::shared_ptr<arrow::csv::StreamingReader> reader;
+    std::vector<std::shared_ptr<CSVReader>> readers;
 };
 
 class ReadParquetSharedState : public ReadFileSharedState {
@@ -82,7 +91,7 @@ public:
         : ReadFileSharedState{std::move(filePaths), csvReaderConfig, tableSchema} {}
 
 private:
-    void countNumRows() override;
+    void countNumRows(processor::ExecutionContext* context) override;
 
     std::unique_ptr<storage::ReadFileMorsel> getMorsel() override;
 };
@@ -96,7 +105,7 @@ public:
     std::unique_ptr<storage::ReadFileMorsel> getMorsel() final;
 
 private:
-    void countNumRows() final;
+    void countNumRows(processor::ExecutionContext* context) final;
 };
 
 } // namespace storage
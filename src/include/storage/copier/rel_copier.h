@@ -1,5 +1,6 @@
 #pragma once
 
+#include "storage/buffer_manager/memory_manager.h"
 #include "storage/copier/read_file_state.h"
 #include "storage/in_mem_storage_structure/in_mem_column.h"
 #include "storage/in_mem_storage_structure/in_mem_lists.h"
@@ -12,6 +13,76 @@ namespace storage {
 
 class DirectedInMemRelData;
 
+// The rels parsed from a morsel of the input files, with the offsets of their src and dst nodes.
+// A spilled morsel keeps its rels serialized in buffers of the memory manager instead, which are
+// unpinned so that the buffer manager can write them to the spill file.
+class BufferedRelsMorsel : public ReadFileMorsel {
+public:
+    BufferedRelsMorsel(common::row_idx_t rowIdx, std::string filePath,
+        common::row_idx_t rowIdxInFile, std::shared_ptr<arrow::RecordBatch> recordBatch,
+        std::vector<common::offset_t> srcNodeOffsets, std::vector<common::offset_t> dstNodeOffsets)
+        : ReadFileMorsel{rowIdx, common::INVALID_BLOCK_IDX,
+              (common::row_idx_t)recordBatch->num_rows(), std::move(filePath), rowIdxInFile},
+          recordBatch{std::move(recordBatch)}, srcNodeOffsets{std::move(srcNodeOffsets)},
+          dstNodeOffsets{std::move(dstNodeOffsets)}, isSpilled{false}, numSpilledBytes{0} {}
+
+    // The bytes that the rels take in memory.
+    uint64_t getNumBytes() const;
+    void spill(MemoryManager& memoryManager);
+    // Reads the rels back from the spill buffers and frees the buffers.
+    void unspillIfNecessary();
+
+private:
+    void appendToSpillBuffers(MemoryManager& memoryManager, const uint8_t* data, uint64_t size);
+    void readFromSpillBuffers(uint8_t* data, uint64_t offset, uint64_t size);
+
+public:
+    std::shared_ptr<arrow::RecordBatch> recordBatch;
+    std::vector<common::offset_t> srcNodeOffsets;
+    std::vector<common::offset_t> dstNodeOffsets;
+
+private:
+    bool isSpilled;
+    // The src and dst node offsets followed by the record batch in the Arrow IPC stream format.
+    std::vector<std::unique_ptr<MemoryBuffer>> spillBuffers;
+    uint64_t numSpilledBytes;
+};
+
+// Rel lists are copied in two passes. The first pass counts the sizes of the lists, and the second
+// pass copies the rels into the lists. The first pass keeps the morsels it parses in this shared
+// state, so the second pass reads them back instead of parsing the files and looking up the
+// primary key indexes again. The morsels are kept in memory until they take maxNumBytes or the
+// buffer pool can't free enough memory for them, and the bytes of the morsels in memory are
+// reserved from the buffer manager. The morsels after those are spilled.
+class BufferedRelsSharedState : public ReadFileSharedState {
+public:
+    BufferedRelsSharedState(const common::CopyDescription& copyDescription,
+        catalog::TableSchema* tableSchema, uint64_t maxNumBytes, MemoryManager* memoryManager)
+        : ReadFileSharedState{copyDescription.filePaths, *copyDescription.csvReaderConfig,
+              tableSchema},
+          maxNumBytes{maxNumBytes}, memoryManager{memoryManager}, numBytes{0},
+          isMemoryFull{false}, nextMorselIdx{0} {}
+    ~BufferedRelsSharedState() override {
+        memoryManager->getBufferManager()->releaseMemory(numBytes);
+    }
+
+    void append(std::unique_ptr<BufferedRelsMorsel> morsel);
+
+    void countNumRows(processor::ExecutionContext* context) final {}
+    std::unique_ptr<ReadFileMorsel> getMorsel() final;
+
+private:
+    uint64_t maxNumBytes;
+    MemoryManager* memoryManager;
+    // The bytes reserved from the buffer manager.
+    uint64_t numBytes;
+    // Set once a morsel doesn't fit in memory, so the later morsels don't make the buffer manager
+    // evict pages for reservations that are likely to fail as well.
+    bool isMemoryFull;
+    std::vector<std::unique_ptr<BufferedRelsMorsel>> morsels;
+    uint64_t nextMorselIdx;
+};
+
 class RelCopier {
 public:
     RelCopier(std::shared_ptr<ReadFileSharedState> sharedState,
@@ -84,17 +155,28 @@ protected:
     RelListsCounterAndColumnCopier(std::shared_ptr<ReadFileSharedState> sharedState,
         const common::CopyDescription& copyDesc, catalog::RelTableSchema* schema,
         DirectedInMemRelData* fwdRelData, DirectedInMemRelData* bwdRelData,
-        std::vector<PrimaryKeyIndex*> pkIndexes)
+        std::vector<PrimaryKeyIndex*> pkIndexes,
+        std::shared_ptr<BufferedRelsSharedState> bufferedRels)
         : RelCopier{std::move(sharedState), copyDesc, schema, fwdRelData, bwdRelData,
-              std::move(pkIndexes)} {}
+              std::move(pkIndexes)},
+          bufferedRels{std::move(bufferedRels)} {}
 
     void finalize() override;
 
+    // Keeps the morsel for the second pass, which copies rel lists, if there is one.
+    void bufferRelsIfNecessary(ReadFileMorsel* morsel,
+        std::shared_ptr<arrow::RecordBatch> recordBatch,
+        std::vector<common::offset_t> srcNodeOffsets,
+        std::vector<common::offset_t> dstNodeOffsets);
+
     static void buildRelListsHeaders(
         ListHeadersBuilder* relListHeadersBuilder, const atomic_uint64_vec_t& relListsSizes);
     static void buildRelListsMetadata(DirectedInMemRelData* directedInMemRelData);
     static void buildRelListsMetadata(InMemLists* relLists, ListHeadersBuilder* relListHeaders);
     static void flushRelColumns(DirectedInMemRelData* directedInMemRelData);
+
+protected:
+    std::shared_ptr<BufferedRelsSharedState> bufferedRels;
 };
 
 class ParquetRelListsCounterAndColumnsCopier : public RelListsCounterAndColumnCopier {
@@ -102,13 +184,14 @@ public:
     ParquetRelListsCounterAndColumnsCopier(std::shared_ptr<ReadFileSharedState> sharedState,
         const common::CopyDescription& copyDesc, catalog::RelTableSchema* schema,
         DirectedInMemRelData* fwdRelData, DirectedInMemRelData* bwdRelData,
-        std::vector<PrimaryKeyIndex*> pkIndexes)
+        std::vector<PrimaryKeyIndex*> pkIndexes,
+        std::shared_ptr<BufferedRelsSharedState> bufferedRels)
         : RelListsCounterAndColumnCopier{std::move(sharedState), copyDesc, schema, fwdRelData,
-              bwdRelData, std::move(pkIndexes)} {}
+              bwdRelData, std::move(pkIndexes), std::move(bufferedRels)} {}
 
     std::unique_ptr<RelCopier> clone() const final {
         return std::make_unique<ParquetRelListsCounterAndColumnsCopier>(
-            sharedState, copyDesc, schema, fwdRelData, bwdRelData, pkIndexes);
+            sharedState, copyDesc, schema, fwdRelData, bwdRelData, pkIndexes, bufferedRels);
     }
 
 private:
@@ -124,13 +207,14 @@ public:
     CSVRelListsCounterAndColumnsCopier(std::shared_ptr<ReadFileSharedState> sharedState,
         const common::CopyDescription& copyDesc, catalog::RelTableSchema* schema,
         DirectedInMemRelData* fwdRelData, DirectedInMemRelData* bwdRelData,
-        std::vector<PrimaryKeyIndex*> pkIndexes)
+        std::vector<PrimaryKeyIndex*> pkIndexes,
+        std::shared_ptr<BufferedRelsSharedState> bufferedRels)
         : RelListsCounterAndColumnCopier{std::move(sharedState), copyDesc, schema, fwdRelData,
-              bwdRelData, std::move(pkIndexes)} {}
+              bwdRelData, std::move(pkIndexes), std::move(bufferedRels)} {}
 
     std::unique_ptr<RelCopier> clone() const final {
         return std::make_unique<CSVRelListsCounterAndColumnsCopier>(
-            sharedState, copyDesc, schema, fwdRelData, bwdRelData, pkIndexes);
+            sharedState, copyDesc, schema, fwdRelData, bwdRelData, pkIndexes, bufferedRels);
     }
 
 private:
@@ -150,40 +234,19 @@ private:
     void finalize() final;
 };
 
-class ParquetRelListsCopier : public RelListsCopier {
-public:
-    ParquetRelListsCopier(std::shared_ptr<ReadFileSharedState> sharedState,
-        const common::CopyDescription& copyDesc, catalog::RelTableSchema* schema,
-        DirectedInMemRelData* fwdRelData, DirectedInMemRelData* bwdRelData,
-        std::vector<PrimaryKeyIndex*> pkIndexes)
-        : RelListsCopier{std::move(sharedState), copyDesc, schema, fwdRelData, bwdRelData,
-              std::move(pkIndexes)} {}
-
-    std::unique_ptr<RelCopier> clone() const final {
-        return std::make_unique<ParquetRelListsCopier>(
-            sharedState, copyDesc, schema, fwdRelData, bwdRelData, pkIndexes);
-    }
-
-private:
-    void executeInternal(std::unique_ptr<ReadFileMorsel> morsel) final;
-
-private:
-    std::unique_ptr<parquet::arrow::FileReader> reader;
-    std::string filePath;
-};
-
-class CSVRelListsCopier : public RelListsCopier {
+// Copies rel lists from the morsels buffered or spilled by the first pass.
+class BufferedRelListsCopier : public RelListsCopier {
 public:
-    CSVRelListsCopier(std::shared_ptr<ReadFileSharedState> sharedState,
+    BufferedRelListsCopier(std::shared_ptr<BufferedRelsSharedState> bufferedRels,
         const common::CopyDescription& copyDesc, catalog::RelTableSchema* schema,
-        DirectedInMemRelData* fwdRelData, DirectedInMemRelData* bwdRelData,
-        std::vector<PrimaryKeyIndex*> pkIndexes)
-        : RelListsCopier{std::move(sharedState), copyDesc, schema, fwdRelData, bwdRelData,
-              std::move(pkIndexes)} {}
+        DirectedInMemRelData* fwdRelData, DirectedInMemRelData* bwdRelData)
+        : RelListsCopier{std::move(bufferedRels), copyDesc, schema, fwdRelData, bwdRelData,
+              std::vector<PrimaryKeyIndex*>{}} {}
 
     std::unique_ptr<RelCopier> clone() const final {
-        return std::make_unique<CSVRelListsCopier>(
-            sharedState, copyDesc, schema, fwdRelData, bwdRelData, pkIndexes);
+        return std::make_unique<BufferedRelListsCopier>(
+            std::static_pointer_cast<BufferedRelsSharedState>(sharedState), copyDesc, schema,
+            fwdRelData, bwdRelData);
     }
 
 private:
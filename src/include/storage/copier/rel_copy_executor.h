@@ -48,15 +48,14 @@ public:
     common::offset_t copy(processor::ExecutionContext* executionContext);
 
 private:
-    enum class RelCopierType : uint8_t { REL_COLUMN_COPIER_AND_LIST_COUNTER, REL_LIST_COPIER };
-
     std::unique_ptr<DirectedInMemRelData> initializeDirectedInMemRelData(
         common::RelDataDirection direction);
     common::row_idx_t countRelListsSizeAndPopulateColumns(
         processor::ExecutionContext* executionContext);
     common::row_idx_t populateRelLists(processor::ExecutionContext* executionContext);
 
-    std::unique_ptr<RelCopier> createRelCopier(RelCopierType relCopierType);
+    // Creates the copier of the first pass, which reads the files.
+    std::unique_ptr<RelCopier> createRelCopier(processor::ExecutionContext* executionContext);
 
 private:
     common::CopyDescription& copyDescription;
@@ -70,6 +69,9 @@ private:
     std::unique_ptr<DirectedInMemRelData> fwdRelData;
     std::unique_ptr<DirectedInMemRelData> bwdRelData;
     std::vector<PrimaryKeyIndex*> pkIndexes;
+    // The morsels parsed by the first pass, which are copied into rel lists by the second pass from
+    // memory or the spill file.
+    std::shared_ptr<BufferedRelsSharedState> bufferedRels;
 };
 
 } // namespace storage
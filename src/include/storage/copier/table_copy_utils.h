@@ -36,8 +36,8 @@ public:
     static std::unique_ptr<uint8_t[]> getArrowFixedList(const std::string& l, int64_t from,
         int64_t to, const common::LogicalType& dataType,
         const common::CopyDescription& copyDescription);
-    static std::shared_ptr<arrow::csv::StreamingReader> createCSVReader(const std::string& filePath,
-        common::CSVReaderConfig* csvReaderConfig, catalog::TableSchema* tableSchema);
+    // The columns of the CSV files of the table, with the types that they are parsed into.
+    static std::shared_ptr<arrow::Schema> getCSVSchema(catalog::TableSchema* tableSchema);
     static std::unique_ptr<parquet::arrow::FileReader> createParquetReader(
         const std::string& filePath, catalog::TableSchema* tableSchema);
 
@@ -51,9 +51,6 @@ public:
     static std::shared_ptr<arrow::DataType> toArrowDataType(const common::LogicalType& dataType);
 
 private:
-    static common::row_idx_t countNumLinesCSV(common::CopyDescription& copyDescription,
-        catalog::TableSchema* tableSchema,
-        std::unordered_map<std::string, FileBlockInfo>& fileBlockInfos);
     static common::row_idx_t countNumLinesParquet(common::CopyDescription& copyDescription,
         catalog::TableSchema* tableSchema,
         std::unordered_map<std::string, FileBlockInfo>& fileBlockInfos);
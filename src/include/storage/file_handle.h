@@ -27,6 +27,7 @@ public:
     constexpr static uint8_t O_PERSISTENT_FILE_NO_CREATE{0b0000'0000};
     constexpr static uint8_t O_PERSISTENT_FILE_CREATE_NOT_EXISTS{0b0000'0100};
     constexpr static uint8_t O_IN_MEM_TEMP_FILE{0b0000'0011};
+    constexpr static uint8_t O_PERSISTENT_LARGE_PAGED_FILE_CREATE_NOT_EXISTS{0b0000'0101};
 
     FileHandle(const std::string& path, uint8_t flags);
 
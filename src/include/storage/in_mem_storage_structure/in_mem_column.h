@@ -1,17 +1,42 @@
 #pragma once
 
+#include <mutex>
+#include <unordered_map>
+
 #include "storage/in_mem_storage_structure/in_mem_column_chunk.h"
+#include "storage/storage_structure/column_compression.h"
+#include "storage/storage_structure/string_dictionary.h"
+#include "storage/storage_structure/zone_map.h"
 
 namespace kuzu {
 namespace storage {
 
+// A segment of a compressed column whose values are copied by more than one chunk. The segment is
+// compressed once all of its values are copied.
+struct InMemColumnSegment {
+    InMemColumnSegment(uint64_t numValues, uint64_t numBytesPerValue);
+
+    std::unique_ptr<uint8_t[]> values;
+    // Positions that are not copied are null, so they are ignored by the compression.
+    std::unique_ptr<bool[]> isNull;
+    uint64_t numValuesCopied;
+};
+
 class InMemColumn {
 public:
     InMemColumn(std::string filePath, common::LogicalType dataType, bool requireNullBits = true);
 
-    // Encode and flush null bits.
+    // Encode and flush null bits, and the segments of compressed columns that span the last chunk.
+    // The dictionary of dictionary-encoded columns is saved if the column has few distinct values,
+    // and the zone map is saved if it is enabled.
     void saveToFile();
 
+    // Encodes the values of a STRING column with a dictionary, in addition to the column file. See
+    // `StringDictionary`.
+    void enableDictionaryEncoding();
+    // Builds the zone map of the column, which is saved with the column. See `ZoneMap`.
+    void enableZoneMap();
+
     void flushChunk(InMemColumnChunk* chunk);
 
     std::unique_ptr<InMemColumnChunk> createInMemColumnChunk(common::offset_t startNodeOffset,
@@ -45,6 +70,18 @@ public:
     inline common::LogicalType getDataType() { return dataType; }
     inline InMemOverflowFile* getInMemOverflowFile() { return inMemOverflowFile.get(); }
 
+private:
+    // Compresses the segments that are entirely within the chunk, and copies the values of the
+    // other segments into partialSegments. See `ColumnCompression` for the layout of the file.
+    void flushCompressedChunk(InMemColumnChunk* chunk);
+    void copyToPartialSegment(uint64_t segmentIdx, uint64_t posInSegment, const uint8_t* values,
+        const bool* isNull, uint64_t numValues, uint8_t* segmentBuffer);
+    void flushSegment(uint64_t segmentIdx, const uint8_t* values, const bool* isNull,
+        uint8_t* segmentBuffer);
+    // Writes the dictionary codes of the values of the chunk into the codes file.
+    void encodeChunk(InMemColumnChunk* chunk);
+    void saveDictionary();
+
 protected:
     std::string filePath;
     std::unique_ptr<FileHandle> fileHandle;
@@ -52,6 +89,13 @@ protected:
     std::unique_ptr<InMemColumn> nullColumn;
     std::unique_ptr<InMemOverflowFile> inMemOverflowFile;
     std::vector<std::unique_ptr<InMemColumn>> childColumns;
+    std::unique_ptr<ColumnCompression> compression;
+    std::mutex mtx;
+    std::unordered_map<uint64_t, std::unique_ptr<InMemColumnSegment>> partialSegments;
+    uint64_t numSegments;
+    std::unique_ptr<StringDictionaryBuilder> dictionaryBuilder;
+    std::unique_ptr<FileHandle> codesFileHandle;
+    std::unique_ptr<ZoneMap> zoneMap;
 };
 
 } // namespace storage
@@ -49,6 +49,7 @@ public:
         return nullChunk->getValue<bool>(pos);
     }
     inline uint8_t* getData() const { return buffer.get(); }
+    inline common::offset_t getStartNodeOffset() const { return startNodeOffset; }
     inline uint64_t getNumBytesPerValue() const { return numBytesPerValue; }
     inline uint64_t getNumBytes() const { return numBytes; }
     inline InMemColumnChunk* getNullChunk() { return nullChunk.get(); }
@@ -45,7 +45,7 @@ public:
     virtual ~InMemLists() = default;
 
     virtual void saveToFile();
-    void setValue(common::offset_t nodeOffset, uint64_t pos, uint8_t* val);
+    virtual void setValue(common::offset_t nodeOffset, uint64_t pos, uint8_t* val);
     template<typename T>
     void setValueFromString(
         common::offset_t nodeOffset, uint64_t pos, const char* val, uint64_t length);
@@ -56,7 +56,9 @@ public:
         return inMemFile->getPage(pageIdx)->data + (posInPage * numBytesForElement);
     }
     inline common::LogicalType getDataType() { return dataType; }
-    inline uint64_t getNumElementsInAPage() const { return numElementsInAPage; }
+    virtual inline uint64_t getNumElementsInAPage(uint64_t chunkIdx) const {
+        return numElementsInAPage;
+    }
 
     virtual void copyArrowArray(arrow::Array* boundNodeOffsets, arrow::Array* posInRelLists,
         arrow::Array* array, PropertyCopyState* copyState);
@@ -144,15 +146,34 @@ protected:
     std::unique_ptr<uint8_t[]> blobBuffer;
 };
 
+// The neighbour offsets of each chunk are packed with the bit width of the largest neighbour offset
+// of the chunk, which is known once the list sizes are counted and before any offset is set.
+// Chunks without a bit width, e.g., of the adjacency lists of an empty table, are uncompressed.
 class InMemAdjLists : public InMemLists {
 public:
     InMemAdjLists(std::string fName, uint64_t numNodes)
         : InMemLists{std::move(fName), common::LogicalType(common::LogicalTypeID::INTERNAL_ID),
-              sizeof(common::offset_t), numNodes, nullptr, false} {
+              sizeof(common::offset_t), numNodes, nullptr, false},
+          maxNbrOffsetPerChunk(StorageUtils::getNumChunks(numNodes)) {
         listHeadersBuilder = make_shared<ListHeadersBuilder>(this->fName, numNodes);
     };
 
     void saveToFile() override;
+    void setValue(common::offset_t nodeOffset, uint64_t pos, uint8_t* val) override;
+
+    inline uint64_t getNumElementsInAPage(uint64_t chunkIdx) const override {
+        return ListsMetadata::getNumNbrOffsetsPerPage(getNbrOffsetBitWidth(chunkIdx));
+    }
+    inline void updateMaxNbrOffset(common::offset_t nodeOffset, common::offset_t nbrOffset) {
+        auto& maxNbrOffset = maxNbrOffsetPerChunk[StorageUtils::getListChunkIdx(nodeOffset)];
+        auto curMaxNbrOffset = maxNbrOffset.load(std::memory_order_relaxed);
+        while (nbrOffset > curMaxNbrOffset &&
+               !maxNbrOffset.compare_exchange_weak(
+                   curMaxNbrOffset, nbrOffset, std::memory_order_relaxed)) {}
+    }
+    // Computes the bit width of each chunk from the neighbour offsets passed to
+    // updateMaxNbrOffset. Must be called before the pages of the lists are allocated.
+    void initNbrOffsetBitWidths();
 
     inline std::shared_ptr<ListHeadersBuilder> getListHeadersBuilder() const {
         return listHeadersBuilder;
@@ -160,6 +181,16 @@ public:
     inline uint32_t getListSize(common::offset_t nodeOffset) const {
         return listHeadersBuilder->getListSize(nodeOffset);
     }
+
+private:
+    inline uint32_t getNbrOffsetBitWidth(uint64_t chunkIdx) const {
+        return nbrOffsetBitWidths.empty() ? ListsMetadata::UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH :
+                                            nbrOffsetBitWidths[chunkIdx];
+    }
+
+private:
+    atomic_uint64_vec_t maxNbrOffsetPerChunk;
+    std::vector<uint32_t> nbrOffsetBitWidths;
 };
 
 class InMemStringLists : public InMemListsWithOverflow {
@@ -87,6 +87,10 @@ public:
 public:
     bool lookupInternal(
         transaction::Transaction* transaction, const uint8_t* key, common::offset_t& result);
+    // Looks up a batch of keys and returns the number of keys found. results[i] is set to the
+    // value of keys[i], or to INVALID_OFFSET if keys[i] is not found.
+    uint64_t lookupInternal(transaction::Transaction* transaction,
+        const std::vector<const uint8_t*>& keys, common::offset_t* results);
     void deleteInternal(const uint8_t* key) const;
     bool insertInternal(const uint8_t* key, common::offset_t value);
 
@@ -99,24 +103,29 @@ public:
 private:
     template<ChainedSlotsAction action>
     bool performActionInChainedSlots(transaction::TransactionType trxType, HashIndexHeader& header,
-        SlotInfo& slotInfo, const uint8_t* key, common::offset_t& result);
+        SlotInfo& slotInfo, fingerprint_t fingerprint, const uint8_t* key,
+        common::offset_t& result);
     bool lookupInPersistentIndex(
         transaction::TransactionType trxType, const uint8_t* key, common::offset_t& result);
+    // Looks up the keys at keyIdxs, in the order of their primary slots.
+    uint64_t lookupInPersistentIndex(transaction::TransactionType trxType,
+        const std::vector<const uint8_t*>& keys, std::vector<uint64_t>& keyIdxs,
+        common::offset_t* results);
     // The following two functions are only used in prepareCommit, and are not thread-safe.
     void insertIntoPersistentIndex(const uint8_t* key, common::offset_t value);
     void deleteFromPersistentIndex(const uint8_t* key);
 
     void copyAndUpdateSlotHeader(bool isCopyEntry, Slot<T>& slot, entry_pos_t entryPos,
-        const uint8_t* key, common::offset_t value);
+        fingerprint_t fingerprint, const uint8_t* key, common::offset_t value);
     void copyKVOrEntryToSlot(bool isCopyEntry, const SlotInfo& slotInfo, Slot<T>& slot,
-        const uint8_t* key, common::offset_t value);
+        fingerprint_t fingerprint, const uint8_t* key, common::offset_t value);
     void splitSlot(HashIndexHeader& header);
     void rehashSlots(HashIndexHeader& header);
     std::vector<std::pair<SlotInfo, Slot<T>>> getChainedSlots(slot_id_t pSlotId);
-    void copyEntryToSlot(slot_id_t slotId, uint8_t* entry);
+    void copyEntryToSlot(slot_id_t slotId, fingerprint_t fingerprint, uint8_t* entry);
 
-    entry_pos_t findMatchedEntryInSlot(
-        transaction::TransactionType trxType, const Slot<T>& slot, const uint8_t* key) const;
+    entry_pos_t findMatchedEntryInSlot(transaction::TransactionType trxType, const Slot<T>& slot,
+        fingerprint_t fingerprint, const uint8_t* key) const;
 
     void loopChainedSlotsToFindOneWithFreeSpace(SlotInfo& slotInfo, Slot<T>& slot);
 
@@ -160,11 +169,22 @@ public:
 
     bool lookup(transaction::Transaction* trx, common::ValueVector* keyVector, uint64_t vectorPos,
         common::offset_t& result);
+    // Looks up the keys at the selected positions of keyVector, which must not be null, and returns
+    // the number of keys found. results[pos] is INVALID_OFFSET if the key at pos is not found.
+    uint64_t lookup(
+        transaction::Transaction* trx, common::ValueVector* keyVector, common::offset_t* results);
 
     void deleteKey(common::ValueVector* keyVector, uint64_t vectorPos);
 
     bool insert(common::ValueVector* keyVector, uint64_t vectorPos, common::offset_t value);
 
+    // Looks up a batch of int64 or null-terminated string keys. Used by RelCopier.
+    inline uint64_t lookup(transaction::Transaction* transaction,
+        const std::vector<const uint8_t*>& keys, common::offset_t* results) {
+        return keyDataTypeID == common::LogicalTypeID::INT64 ?
+                   hashIndexForInt64->lookupInternal(transaction, keys, results) :
+                   hashIndexForString->lookupInternal(transaction, keys, results);
+    }
     // These two lookups are used by InMemRelCSVCopier.
     inline bool lookup(
         transaction::Transaction* transaction, int64_t key, common::offset_t& result) {
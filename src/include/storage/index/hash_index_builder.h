@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+
 #include "hash_index_header.h"
 #include "hash_index_slot.h"
 #include "storage/index/hash_index_utils.h"
@@ -27,13 +29,17 @@ static constexpr uint64_t INDEX_HEADER_IDX_IN_ARRAY = 0;
  * before any insertions or deletions to that pSlot or its chained oSlots.
  *
  * The slot data structure:
- * Each slot (p/oSlot) consists of a slot header and several entries. The max number of entries in
- * slot is given by HashIndexConstants::SLOT_CAPACITY. The size of the slot is given by
- * (sizeof(SlotHeader) + (SLOT_CAPACITY * sizeof(Entry)).
+ * Each slot (p/oSlot) consists of a slot header, the fingerprints of its entries and several
+ * entries. A slot takes HashIndexConstants::SLOT_SIZE bytes, and the max number of entries in a
+ * slot is given by Slot<T>::CAPACITY, which depends on the size of the key.
  *
  * SlotHeader: [numEntries, validityMask, nextOvfSlotId]
+ * Fingerprints: [the most significant byte of the hash of the key of each entry]
  * Entry: [key (fixed sized part), node_offset]
  *
+ * Keys are compared only for entries with the same fingerprint as the key, so a lookup usually
+ * compares a single key and doesn't read the overflow file for the other string keys of a slot.
+ *
  * 3. oSlots are used to store entries that comes to the designated primary slot that has already
  * been filled to the capacity. Several overflow slots can be chained after the single primary slot
  * as a singly linked link-list. Each slot's SlotHeader has information about the next overflow slot
@@ -57,7 +63,16 @@ public:
     virtual ~BaseHashIndex() = default;
 
 protected:
-    slot_id_t getPrimarySlotIdForKey(const HashIndexHeader& indexHeader, const uint8_t* key);
+    static slot_id_t getPrimarySlotIdForHash(
+        const HashIndexHeader& indexHeader, common::hash_t hash);
+    inline slot_id_t getPrimarySlotIdForKey(
+        const HashIndexHeader& indexHeader, const uint8_t* key) {
+        return getPrimarySlotIdForHash(indexHeader, keyHashFunc(key));
+    }
+    static inline fingerprint_t getFingerprintForHash(common::hash_t hash) {
+        // The slotId takes the least significant bits of the hash.
+        return hash >> (64 - 8 * sizeof(fingerprint_t));
+    }
 
     static inline uint64_t getNumRequiredEntries(
         uint64_t numExistingEntries, uint64_t numNewEntries) {
@@ -70,8 +85,24 @@ protected:
     hash_function_t keyHashFunc;
 };
 
+/**
+ * HashIndexBuilder builds the index of a COPY, and keys can be appended by multiple threads.
+ *
+ * The primary slots are split into partitions of consecutive slots. A partition holds the overflow
+ * slots and the overflow strings of the keys in its primary slots, so appends to different
+ * partitions don't share any state and only appends to the same partition wait for each other. A
+ * batch of keys is grouped by partition, so each partition is locked once per batch. The overflow
+ * slots and strings of all partitions are merged into the files of the index when it is flushed.
+ */
 template<typename T>
 class HashIndexBuilder : public BaseHashIndex {
+    struct Partition {
+        std::mutex mtx;
+        // The overflow slot with the local slotId i is oSlots[i - 1]. As in the oSlots disk array,
+        // slotId 0 is treated as NULL.
+        std::deque<Slot<T>> oSlots;
+        std::unique_ptr<InMemOverflowFile> overflowFile;
+    };
 
 public:
     HashIndexBuilder(const std::string& fName, const common::LogicalType& keyDataType);
@@ -88,32 +119,51 @@ public:
     inline bool append(const char* key, common::offset_t value) {
         return appendInternal(reinterpret_cast<const uint8_t*>(key), value);
     }
+    // Appends keys[i] with the value startValue + i. Returns the position of a key that already
+    // exists, or the number of keys if all keys are appended.
+    uint64_t append(const std::vector<const uint8_t*>& keys, common::offset_t startValue);
+    // Note: lookup is only valid before flush.
     inline bool lookup(int64_t key, common::offset_t& result) {
-        return lookupInternalWithoutLock(reinterpret_cast<const uint8_t*>(&key), result);
+        return lookupInternal(reinterpret_cast<const uint8_t*>(&key), result);
     }
 
     // Non-thread safe. This should only be called in the copyCSV and never be called in parallel.
     void flush();
 
 private:
+    void initPartitions();
+    inline uint64_t getPartitionIdx(slot_id_t pSlotId) const {
+        return pSlotId * partitions.size() / numPSlotsOfPartitions;
+    }
     bool appendInternal(const uint8_t* key, common::offset_t value);
-    bool lookupInternalWithoutLock(const uint8_t* key, common::offset_t& result);
+    bool appendNoLock(Partition& partition, common::hash_t hash, const uint8_t* key,
+        common::offset_t value);
+    bool lookupInternal(const uint8_t* key, common::offset_t& result);
 
     template<bool IS_LOOKUP>
-    bool lookupOrExistsInSlotWithoutLock(
-        Slot<T>* slot, const uint8_t* key, common::offset_t* result = nullptr);
-    void insertToSlotWithoutLock(Slot<T>* slot, const uint8_t* key, common::offset_t value);
-    Slot<T>* getSlot(const SlotInfo& slotInfo);
+    bool lookupOrExistsInSlotWithoutLock(Partition& partition, Slot<T>* slot,
+        fingerprint_t fingerprint, const uint8_t* key, common::offset_t* result = nullptr);
+    void insertToSlotWithoutLock(Partition& partition, Slot<T>* slot, fingerprint_t fingerprint,
+        const uint8_t* key, common::offset_t value);
+    Slot<T>* getSlot(Partition& partition, const SlotInfo& slotInfo);
     uint32_t allocatePSlots(uint32_t numSlotsToAllocate);
-    uint32_t allocateAOSlot();
+    // Moves the overflow slots and strings of the partitions to the files of the index.
+    void mergePartitions();
+    void relocateSlot(
+        Slot<T>& slot, slot_id_t oSlotIdOffset, common::page_idx_t overflowPageIdxOffset);
 
 private:
+    // The number of partitions grows with the number of primary slots up to MAX_NUM_PARTITIONS,
+    // because each partition of string keys allocates its own overflow pages.
+    static constexpr uint64_t MAX_NUM_PARTITIONS = 256;
+    static constexpr uint64_t MIN_NUM_P_SLOTS_PER_PARTITION = 1024;
+
     std::unique_ptr<FileHandle> fileHandle;
     std::unique_ptr<InMemDiskArrayBuilder<HashIndexHeader>> headerArray;
-    std::shared_mutex oSlotsSharedMutex;
     std::unique_ptr<InMemDiskArrayBuilder<Slot<T>>> pSlots;
     std::unique_ptr<InMemDiskArrayBuilder<Slot<T>>> oSlots;
-    std::vector<std::unique_ptr<std::mutex>> pSlotsMutexes;
+    std::vector<std::unique_ptr<Partition>> partitions;
+    uint64_t numPSlotsOfPartitions;
     in_mem_insert_function_t keyInsertFunc;
     in_mem_equals_function_t keyEqualsFunc;
     std::unique_ptr<InMemOverflowFile> inMemOverflowFile;
@@ -140,10 +190,6 @@ public:
         }
     }
 
-    inline void lock() { mtx.lock(); }
-
-    inline void unlock() { mtx.unlock(); }
-
     inline void bulkReserve(uint32_t numEntries) {
         keyDataTypeID == common::LogicalTypeID::INT64 ?
             hashIndexBuilderForInt64->bulkReserve(numEntries) :
@@ -161,6 +207,14 @@ public:
                    hashIndexBuilderForInt64->append(key, value) :
                    hashIndexBuilderForString->append(key, value);
     }
+    // Appends keys[i] with the value startValue + i, where a key is an int64_t or a C string.
+    // Returns the position of a key that already exists, or the number of keys if all keys are
+    // appended. Appends of different threads can run in parallel.
+    inline uint64_t append(const std::vector<const uint8_t*>& keys, common::offset_t startValue) {
+        return keyDataTypeID == common::LogicalTypeID::INT64 ?
+                   hashIndexBuilderForInt64->append(keys, startValue) :
+                   hashIndexBuilderForString->append(keys, startValue);
+    }
     inline bool lookup(int64_t key, common::offset_t& result) {
         return keyDataTypeID == common::LogicalTypeID::INT64 ?
                    hashIndexBuilderForInt64->lookup(key, result) :
@@ -174,7 +228,6 @@ public:
     }
 
 private:
-    std::mutex mtx;
     common::LogicalTypeID keyDataTypeID;
     std::unique_ptr<HashIndexBuilder<int64_t>> hashIndexBuilderForInt64;
     std::unique_ptr<HashIndexBuilder<common::ku_string_t>> hashIndexBuilderForString;
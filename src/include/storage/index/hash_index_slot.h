@@ -11,6 +11,7 @@ namespace storage {
 
 using entry_pos_t = uint8_t;
 using slot_id_t = uint64_t;
+using fingerprint_t = uint8_t;
 
 class SlotHeader {
 public:
@@ -43,11 +44,48 @@ struct SlotEntry {
     uint8_t data[sizeof(T) + sizeof(common::offset_t)];
 };
 
+// Returns the max number of entries of a slot, whose header, fingerprints and entries fit in
+// HashIndexConstants::SLOT_SIZE bytes. The fingerprints are padded to 8 bytes to keep the entries
+// aligned.
+constexpr entry_pos_t getSlotCapacity(uint64_t numBytesPerEntry) {
+    entry_pos_t capacity = 0;
+    while (sizeof(SlotHeader) + (capacity + 8) / 8 * 8 + (capacity + 1) * numBytesPerEntry <=
+           common::HashIndexConstants::SLOT_SIZE) {
+        capacity++;
+    }
+    return capacity;
+}
+
 template<typename T>
 struct Slot {
+    static constexpr entry_pos_t CAPACITY = getSlotCapacity(sizeof(SlotEntry<T>));
+    // The fingerprints take the bytes left by the header and the entries, which pads the slot to
+    // HashIndexConstants::SLOT_SIZE bytes, so slots in a page never straddle cache lines.
+    static constexpr uint64_t NUM_FINGERPRINT_BYTES = common::HashIndexConstants::SLOT_SIZE -
+                                                      sizeof(SlotHeader) -
+                                                      CAPACITY * sizeof(SlotEntry<T>);
+
+    // Returns the valid entries whose fingerprint equals the given one as a bit mask. Only the
+    // keys of these entries need to be compared, and the fingerprints are in the first cache line
+    // of the slot together with the header. The loop has a constant trip count over bytes, so it
+    // is vectorized into a few SIMD compares.
+    inline uint32_t getEntriesWithFingerprint(fingerprint_t fingerprint) const {
+        uint32_t mask = 0;
+        for (auto entryPos = 0u; entryPos < CAPACITY; entryPos++) {
+            mask |= (uint32_t)(fingerprints[entryPos] == fingerprint) << entryPos;
+        }
+        return mask & header.validityMask;
+    }
+
     SlotHeader header;
-    SlotEntry<T> entries[common::HashIndexConstants::SLOT_CAPACITY];
+    // The fingerprint of the key of each entry, i.e., the most significant byte of its hash. Only
+    // the first CAPACITY fingerprints are used.
+    alignas(8) fingerprint_t fingerprints[NUM_FINGERPRINT_BYTES];
+    alignas(8) SlotEntry<T> entries[CAPACITY];
 };
 
+static_assert(sizeof(Slot<int64_t>) == common::HashIndexConstants::SLOT_SIZE);
+static_assert(sizeof(Slot<common::ku_string_t>) == common::HashIndexConstants::SLOT_SIZE);
+
 } // namespace storage
 } // namespace kuzu
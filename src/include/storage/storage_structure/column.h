@@ -2,8 +2,11 @@
 
 #include "catalog/catalog.h"
 #include "common/types/value.h"
+#include "storage/storage_structure/column_compression.h"
 #include "storage/storage_structure/disk_overflow_file.h"
 #include "storage/storage_structure/storage_structure.h"
+#include "storage/storage_structure/string_dictionary.h"
+#include "storage/storage_structure/zone_map.h"
 
 namespace kuzu {
 namespace storage {
@@ -38,10 +41,18 @@ public:
 
     void write(common::ValueVector* nodeIDVector, common::ValueVector* vectorToWriteFrom);
 
+    // Reads ahead the pages of numValues values from startOffset, including their null bits.
+    virtual void prefetch(common::offset_t startOffset, uint64_t numValues, PrefetchStats& stats);
+
     bool isNull(common::offset_t nodeOffset, transaction::Transaction* transaction);
     virtual void setNull(common::offset_t nodeOffset);
 
     inline NullColumn* getNullColumn() { return nullColumn.get(); }
+    // Returns nullptr if the column has no zone map, e.g., if it is added after COPY.
+    inline ZoneMap* getZoneMap() { return zoneMap.get(); }
+
+    // Saves the zone map if it is updated by the transaction.
+    void prepareCommit();
 
     // Currently, used only in CopyCSV tests.
     // TODO(Guodong): Remove this function. Use `read` instead.
@@ -59,9 +70,14 @@ protected:
         uint32_t posInVectorToWriteFrom);
 
     void readFromPage(transaction::Transaction* transaction, common::page_idx_t pageIdx,
-        const std::function<void(uint8_t*)>& func);
+        const std::function<void(uint8_t*)>& func,
+        BufferManager::AccessHint accessHint = BufferManager::AccessHint::NORMAL);
 
 private:
+    // Writes the value and adds it to the zone map.
+    void writeValue(common::offset_t nodeOffset, common::ValueVector* vectorToWriteFrom,
+        uint32_t posInVectorToWriteFrom);
+
     static void readValuesFromPage(transaction::Transaction* transaction, uint8_t* frame,
         PageElementCursor& pageCursor, common::ValueVector* resultVector, uint32_t posInVector,
         uint32_t numValuesToRead, DiskOverflowFile* diskOverflowFile);
@@ -78,6 +94,7 @@ protected:
     write_data_func_t writeDataFunc;
     std::unique_ptr<DiskOverflowFile> diskOverflowFile;
     std::unique_ptr<NullColumn> nullColumn;
+    std::unique_ptr<ZoneMap> zoneMap;
 };
 
 class NullColumn : public Column {
@@ -114,37 +131,57 @@ public:
     inline BMFileHandle* getDiskOverflowFileHandle() { return diskOverflowFile->getFileHandle(); }
 };
 
+// Column of the dictionary codes of a string column. See `StringDictionary`.
+class DictionaryCodeColumn : public Column {
+public:
+    DictionaryCodeColumn(const StorageStructureIDAndFName& structureIDAndFName,
+        BufferManager* bufferManager, WAL* wal)
+        : Column{structureIDAndFName, common::LogicalType(common::LogicalTypeID::INT32),
+              sizeof(uint32_t), bufferManager, wal, false /* requireNullBits */} {}
+
+    void readCodes(transaction::Transaction* transaction, common::offset_t startOffset,
+        uint64_t numValues, uint32_t* codes);
+    uint32_t readCode(transaction::Transaction* transaction, common::offset_t nodeOffset);
+    void writeCode(common::offset_t nodeOffset, uint32_t code);
+};
+
 class StringPropertyColumn : public PropertyColumnWithOverflow {
 public:
     StringPropertyColumn(const StorageStructureIDAndFName& structureIDAndFNameOfMainColumn,
-        const common::LogicalType& dataType, BufferManager* bufferManager, WAL* wal)
-        : PropertyColumnWithOverflow{
-              structureIDAndFNameOfMainColumn, dataType, bufferManager, wal} {
-        writeDataFunc = StringPropertyColumn::writeStringToPage;
-    };
+        const common::LogicalType& dataType, BufferManager* bufferManager, WAL* wal);
+
+    void prefetch(common::offset_t startOffset, uint64_t numValues, PrefetchStats& stats) final;
+
+    void setNull(common::offset_t nodeOffset) final;
+
+    inline StringDictionary* getDictionary() { return dictionary.get(); }
+    inline BMFileHandle* getDictionaryCodesFileHandle() {
+        assert(codesColumn);
+        return codesColumn->getFileHandle();
+    }
 
     // Currently, used only in CopyCSV tests.
     common::Value readValueForTestingOnly(common::offset_t offset) final;
 
 private:
-    inline void lookup(transaction::Transaction* transaction, common::offset_t nodeOffset,
-        common::ValueVector* resultVector, uint32_t vectorPos) final {
-        resultVector->resetAuxiliaryBuffer();
-        Column::lookup(transaction, nodeOffset, resultVector, vectorPos);
-        if (!resultVector->isNull(vectorPos)) {
-            diskOverflowFile->scanSingleStringOverflow(
-                transaction->getType(), *resultVector, vectorPos);
-        }
-    }
-    inline void scan(transaction::Transaction* transaction, common::ValueVector* nodeIDVector,
-        common::ValueVector* resultVector) final {
-        resultVector->resetAuxiliaryBuffer();
-        Column::scan(transaction, nodeIDVector, resultVector);
-        diskOverflowFile->scanStrings(transaction->getType(), *resultVector);
-    }
+    void lookup(transaction::Transaction* transaction, common::offset_t nodeOffset,
+        common::ValueVector* resultVector, uint32_t vectorPos) final;
+    void scan(transaction::Transaction* transaction, common::ValueVector* nodeIDVector,
+        common::ValueVector* resultVector) final;
+    void write(common::offset_t nodeOffset, common::ValueVector* vectorToWriteFrom,
+        uint32_t posInVectorToWriteFrom) final;
+
+    // Reads the value from the column file and its overflow.
+    void lookupString(transaction::Transaction* transaction, common::offset_t nodeOffset,
+        common::ValueVector* resultVector, uint32_t vectorPos);
 
     static void writeStringToPage(uint8_t* frame, uint16_t posInFrame, common::ValueVector* vector,
         uint32_t posInVector, DiskOverflowFile* diskOverflowFile);
+
+private:
+    // Set if the column is dictionary-encoded by COPY.
+    std::unique_ptr<StringDictionary> dictionary;
+    std::unique_ptr<DictionaryCodeColumn> codesColumn;
 };
 
 class ListPropertyColumn : public PropertyColumnWithOverflow {
@@ -202,12 +239,60 @@ private:
         common::ValueVector* vector, uint32_t posInVector, DiskOverflowFile* diskOverflowFile);
 };
 
+// Column of fixed-width integer values, which are compressed in segments. See `ColumnCompression`
+// for the layout of the column file.
+class CompressedColumn : public Column {
+public:
+    CompressedColumn(const StorageStructureIDAndFName& structureIDAndFName,
+        const common::LogicalType& dataType, BufferManager* bufferManager, WAL* wal)
+        : Column{structureIDAndFName, dataType, bufferManager, wal}, compression{elementSize} {}
+
+    void batchLookup(const common::offset_t* nodeOffsets, size_t size, uint8_t* result) final;
+
+    void prefetch(common::offset_t startOffset, uint64_t numValues, PrefetchStats& stats) final;
+
+    void setNull(common::offset_t nodeOffset) final;
+
+    common::Value readValueForTestingOnly(common::offset_t offset) final;
+
+private:
+    void lookup(transaction::Transaction* transaction, common::offset_t nodeOffset,
+        common::ValueVector* resultVector, uint32_t vectorPos) final;
+    void scan(transaction::Transaction* transaction, common::ValueVector* nodeIDVector,
+        common::ValueVector* resultVector) final;
+    void write(common::offset_t nodeOffset, common::ValueVector* vectorToWriteFrom,
+        uint32_t posInVectorToWriteFrom) final;
+
+    // Decompresses numValues values from startOffset into result. The values can span segments.
+    void readValues(transaction::Transaction* transaction, common::offset_t startOffset,
+        uint64_t numValues, uint8_t* result,
+        BufferManager::AccessHint accessHint = BufferManager::AccessHint::NORMAL);
+    SegmentHeader readSegmentHeader(transaction::Transaction* transaction, uint64_t segmentIdx,
+        BufferManager::AccessHint accessHint);
+    // Appends an UNCOMPRESSED segment if the segment is beyond the end of the file.
+    void addSegmentIfNecessary(uint64_t segmentIdx);
+    // Writes a value that does not fit into the compression of its segment by decompressing the
+    // segment and compressing it again with the value.
+    void recompressSegment(uint64_t segmentIdx, uint64_t posInSegment, const uint8_t* value);
+
+    inline common::page_idx_t getFirstPageIdxOfSegment(uint64_t segmentIdx) const {
+        return segmentIdx * common::StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT;
+    }
+
+private:
+    ColumnCompression compression;
+};
+
 class SerialColumn : public Column {
 public:
     SerialColumn() : Column{common::LogicalType{common::LogicalTypeID::SERIAL}} {}
 
     void read(transaction::Transaction* transaction, common::ValueVector* nodeIDVector,
         common::ValueVector* resultVector) final;
+
+    // Serial values are computed from node offsets, so there is no page to read ahead.
+    inline void prefetch(
+        common::offset_t startOffset, uint64_t numValues, PrefetchStats& stats) final {}
 };
 
 class ColumnFactory {
@@ -218,11 +303,13 @@ public:
         case common::LogicalTypeID::INT64:
         case common::LogicalTypeID::INT32:
         case common::LogicalTypeID::INT16:
+        case common::LogicalTypeID::DATE:
+        case common::LogicalTypeID::TIMESTAMP:
+            return std::make_unique<CompressedColumn>(
+                structureIDAndFName, logicalType, bufferManager, wal);
         case common::LogicalTypeID::DOUBLE:
         case common::LogicalTypeID::FLOAT:
         case common::LogicalTypeID::BOOL:
-        case common::LogicalTypeID::DATE:
-        case common::LogicalTypeID::TIMESTAMP:
         case common::LogicalTypeID::INTERVAL:
         case common::LogicalTypeID::FIXED_LIST:
             return std::make_unique<Column>(structureIDAndFName, logicalType, bufferManager, wal);
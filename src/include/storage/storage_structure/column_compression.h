@@ -0,0 +1,97 @@
+#pragma once
+
+#include "common/constants.h"
+#include "common/types/types.h"
+
+namespace kuzu {
+namespace storage {
+
+enum class CompressionType : uint8_t {
+    UNCOMPRESSED = 0,
+    CONSTANT = 1,
+    BIT_PACKING = 2,
+};
+
+// Stored at the beginning of the first page of each segment.
+struct SegmentHeader {
+    CompressionType compressionType;
+    // The number of bits of each value. Values of CONSTANT segments take no bits.
+    uint8_t bitWidth;
+    // For CONSTANT segments, the value of all values of the segment. For BIT_PACKING segments, the
+    // frame of reference (the min value), which is subtracted from each value before packing it.
+    int64_t reference;
+};
+
+// The position of a value in a segment.
+struct SegmentCursor {
+    common::page_idx_t pageIdxInSegment;
+    uint64_t bitOffsetInPage;
+    // The number of values from the cursor to the end of the page.
+    uint64_t numValuesLeftInPage;
+};
+
+/**
+ * ColumnCompression compresses the values of fixed-width integer columns (INT16, INT32, INT64,
+ * DATE and TIMESTAMP), whose values are often small, sorted or low-cardinality.
+ *
+ * Values are stored in segments of NUM_PAGES_PER_COLUMN_SEGMENT pages. The ith segment holds the
+ * values from offset i * numValuesPerSegment, where numValuesPerSegment is the number of
+ * uncompressed values that fit into a segment after its header. So the segment of a value is
+ * computed from its offset, as the page of a value is in uncompressed columns, and each segment is
+ * compressed independently with one of:
+ *  - UNCOMPRESSED: values are stored as they are.
+ *  - CONSTANT: all values are equal to the reference, so only the header is stored.
+ *  - BIT_PACKING: values are stored as their differences with the min value of the segment
+ *    (frame of reference), packed with the bit width of the largest difference. Sorted values,
+ *    e.g., IDs, and values within a small range, e.g., timestamps of a short period, are packed
+ *    into a few bits.
+ * Packed values don't straddle page boundaries, so a compressed segment only takes the first few
+ * pages of the segment. The remaining pages are neither written nor read, and they are holes in
+ * the file. Values at null positions are ignored when choosing the compression of a segment.
+ *
+ * Updates are written in place if the new value fits into the compression of its segment.
+ * Otherwise, the segment is decompressed and compressed again with the new value, e.g., with a
+ * wider bit width. Segments that are appended after COPY are UNCOMPRESSED.
+ */
+class ColumnCompression {
+public:
+    explicit ColumnCompression(uint64_t numBytesPerValue);
+
+    static bool isCompressible(const common::LogicalType& dataType);
+
+    inline uint64_t getNumValuesPerSegment() const { return numValuesPerSegment; }
+    inline SegmentHeader getUncompressedHeader() const {
+        return SegmentHeader{
+            CompressionType::UNCOMPRESSED, (uint8_t)(numBytesPerValue * 8), 0 /* reference */};
+    }
+
+    SegmentCursor getCursor(const SegmentHeader& header, uint64_t posInSegment) const;
+
+    // Compresses numValues (at most numValuesPerSegment) values into segmentBuffer, which must hold
+    // NUM_PAGES_PER_COLUMN_SEGMENT pages. isNull can be nullptr if there is no null value. Returns
+    // the number of pages taken by the segment.
+    uint64_t compressSegment(const uint8_t* values, const bool* isNull, uint64_t numValues,
+        uint8_t* segmentBuffer) const;
+
+    // Decompresses numValues values from the cursor, which must all be in the page of the cursor.
+    // The frame is not read for CONSTANT segments, so it can be nullptr.
+    void decompressValues(const uint8_t* frame, const SegmentHeader& header,
+        const SegmentCursor& cursor, uint64_t numValues, uint8_t* result) const;
+
+    bool canUpdateInPlace(const SegmentHeader& header, const uint8_t* value) const;
+    void updateInPlace(uint8_t* frame, const SegmentHeader& header, const SegmentCursor& cursor,
+        const uint8_t* value) const;
+
+private:
+    SegmentHeader chooseCompression(
+        const uint8_t* values, const bool* isNull, uint64_t numValues) const;
+
+    int64_t readValue(const uint8_t* value) const;
+
+private:
+    uint64_t numBytesPerValue;
+    uint64_t numValuesPerSegment;
+};
+
+} // namespace storage
+} // namespace kuzu
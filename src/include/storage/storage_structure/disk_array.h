@@ -108,6 +108,10 @@ public:
         transaction::TransactionType trxType = transaction::TransactionType::READ_ONLY);
 
     U get(uint64_t idx, transaction::TransactionType trxType);
+    // Reads the elements at the given idxs, which are sorted, into values. Elements in the same
+    // array page are read together, so each array page is read only once.
+    void get(
+        const uint64_t* idxs, uint64_t numIdxs, transaction::TransactionType trxType, U* values);
 
     // Note: This function is to be used only by the WRITE trx.
     void update(uint64_t idx, U val);
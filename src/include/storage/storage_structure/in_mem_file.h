@@ -34,6 +34,10 @@ public:
 
     uint64_t getNumPages() { return pages.size(); }
 
+    // Moves the pages of the other file to the end of this file, and returns the pageIdx of the
+    // first moved page in this file.
+    common::page_idx_t movePagesFrom(InMemFile& other);
+
 protected:
     std::string filePath;
     uint16_t numBytesForElement;
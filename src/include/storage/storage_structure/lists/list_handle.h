@@ -36,6 +36,10 @@ public:
 
     void resetState();
 
+    // Pages prefetched by all Lists that are read through this ListSyncState. Unlike the other
+    // fields, the stats are not reset between lists.
+    inline PrefetchStats& getPrefetchStats() { return prefetchStats; }
+
 private:
     inline bool hasValidRangeToRead() const { return UINT32_MAX != startElemOffset; }
     inline csr_offset_t getNumValuesInList() {
@@ -57,6 +61,7 @@ private:
     uint32_t startElemOffset;
     uint32_t numValuesToRead;
     ListSourceStore sourceStore;
+    PrefetchStats prefetchStats;
 };
 
 struct ListHandle {
@@ -97,6 +102,7 @@ struct ListHandle {
     inline bool hasMoreAndSwitchSourceIfNecessary() {
         return listSyncState.hasMoreAndSwitchSourceIfNecessary();
     }
+    inline PrefetchStats& getPrefetchStats() { return listSyncState.getPrefetchStats(); }
 
 private:
     ListSyncState& listSyncState;
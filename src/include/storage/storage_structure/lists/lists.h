@@ -41,6 +41,7 @@ struct InMemList {
  * */
 class Lists : public BaseColumnOrList {
     friend class ListsUpdateIterator;
+    friend class AdjListsUpdateIterator;
     friend class ListsUpdateIteratorFactory;
 
 public:
@@ -93,13 +94,21 @@ public:
         const std::vector<uint64_t>& insertedRelTupleIdxesInFT,
         const std::unordered_set<uint64_t>& deletedRelOffsetsForList,
         UpdatedPersistentListOffsets* updatedPersistentListOffsets);
-    void fillInMemListsFromPersistentStore(common::offset_t nodeOffset,
+    virtual void fillInMemListsFromPersistentStore(common::offset_t nodeOffset,
         uint64_t numElementsInPersistentStore, InMemList& inMemList,
         const std::unordered_set<list_offset_t>& deletedRelOffsetsInList,
         UpdatedPersistentListOffsets* updatedPersistentListOffsets = nullptr);
 
 protected:
     virtual inline DiskOverflowFile* getDiskOverflowFileIfExists() { return nullptr; }
+    // Returns the number of elements in each page of the chunk of nodeOffset.
+    virtual inline uint64_t getNumElementsPerPageForNode(common::offset_t nodeOffset) {
+        return numElementsPerPage;
+    }
+    // Reads ahead the pages of the next NUM_VECTORS_TO_READ_AHEAD vectors of values of the list
+    // from startElemOffset. Lists that fit in a single vector are read at once, so they are not
+    // prefetched.
+    void prefetchLargeList(ListHandle& listHandle, uint32_t startElemOffset);
     Lists(const StorageStructureIDAndFName& storageStructureIDAndFName,
         const common::LogicalType& dataType, const size_t& elementSize,
         std::shared_ptr<ListHeaders> headers, BufferManager* bufferManager, bool hasNULLBytes,
@@ -195,6 +204,13 @@ public:
     std::unique_ptr<std::vector<common::nodeID_t>> readAdjacencyListOfNode(
         common::offset_t nodeOffset);
 
+    // Adjacency lists have neither nulls nor property updates, so updatedPersistentListOffsets
+    // must be nullptr.
+    void fillInMemListsFromPersistentStore(common::offset_t nodeOffset,
+        uint64_t numElementsInPersistentStore, InMemList& inMemList,
+        const std::unordered_set<list_offset_t>& deletedRelOffsetsInList,
+        UpdatedPersistentListOffsets* updatedPersistentListOffsets = nullptr) final;
+
     inline void checkpointInMemoryIfNecessary() final {
         headers->checkpointInMemoryIfNecessary();
         Lists::checkpointInMemoryIfNecessary();
@@ -206,10 +222,26 @@ public:
     }
 
 private:
+    inline uint32_t getNbrOffsetBitWidth(common::offset_t nodeOffset) {
+        return metadata.getNbrOffsetBitWidth(
+            StorageUtils::getListChunkIdx(nodeOffset), transaction::TransactionType::READ_ONLY);
+    }
+    inline uint64_t getNumElementsPerPageForNode(common::offset_t nodeOffset) final {
+        return ListsMetadata::getNumNbrOffsetsPerPage(getNbrOffsetBitWidth(nodeOffset));
+    }
+
     void readFromList(common::ValueVector* valueVector, ListHandle& listHandle) final;
     void readFromListsUpdatesStore(ListHandle& listHandle, common::ValueVector* valueVector);
     void readFromPersistentStore(ListHandle& listHandle, common::ValueVector* valueVector);
 
+    // Unpacks numValues neighbour offsets of the persistent list of nodeOffset from
+    // startElemOffset, and calls func(posInRange, nbrOffset) for each of them. Since pages are read
+    // optimistically, func may be called more than once for the same position.
+    template<typename FUNC>
+    void readNbrOffsets(common::offset_t nodeOffset,
+        const std::function<uint32_t(uint32_t)>& pageMapper, uint64_t startElemOffset,
+        uint64_t numValues, FUNC&& func);
+
 private:
     common::table_id_t nbrTableID;
 };
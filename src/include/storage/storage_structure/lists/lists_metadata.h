@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bit>
+
 #include "storage/storage_structure/disk_array.h"
 #include "storage/storage_structure/storage_structure.h"
 
@@ -15,6 +17,10 @@ class BaseListsMetadata {
 public:
     static constexpr uint64_t CHUNK_PAGE_LIST_HEAD_IDX_MAP_HEADER_PAGE_IDX = 0;
     static constexpr uint64_t CHUNK_PAGE_LIST_HEADER_PAGE_IDX = 1;
+    static constexpr uint64_t CHUNK_NBR_OFFSET_BIT_WIDTH_MAP_HEADER_PAGE_IDX = 2;
+    // Neighbour offsets of adjacency lists are stored at full width in chunks that have no bit
+    // width, e.g., the lists of other types or chunks that were created after COPY.
+    static constexpr uint32_t UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH = 64;
 
     explicit BaseListsMetadata() {
         logger = common::LoggerUtils::getLogger(common::LoggerConstants::LoggerEnum::STORAGE);
@@ -28,6 +34,15 @@ public:
     static uint64_t getPageIdxFromAPageList(BaseInMemDiskArray<common::page_idx_t>* pageLists,
         uint32_t pageListHead, uint32_t idxInPageList);
 
+    static inline uint32_t computeNbrOffsetBitWidth(common::offset_t maxNbrOffset) {
+        return std::max<uint32_t>(1, std::bit_width(maxNbrOffset));
+    }
+    // Packed neighbour offsets don't straddle page boundaries, so a page of a chunk with a bit
+    // width of 64 holds the same number of offsets as a page of uncompressed adjacency lists.
+    static inline uint64_t getNumNbrOffsetsPerPage(uint32_t bitWidth) {
+        return common::BufferPoolConstants::PAGE_4KB_SIZE * 8 / bitWidth;
+    }
+
 protected:
     std::shared_ptr<spdlog::logger> logger;
 };
@@ -46,14 +61,29 @@ public:
             pageLists.get(), (*chunkToPageListHeadIdxMap)[chunkIdx]);
     }
 
+    // Returns the number of bits of each neighbour offset in the adjacency lists of a chunk.
+    inline uint32_t getNbrOffsetBitWidth(uint64_t chunkIdx, transaction::TransactionType trxType) {
+        if (chunkIdx >= chunkToNbrOffsetBitWidthMap->getNumElements(trxType)) {
+            return UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH;
+        }
+        // Readers get the committed bit width from memory without going through the buffer manager.
+        return trxType == transaction::TransactionType::READ_ONLY ?
+                   (*chunkToNbrOffsetBitWidthMap)[chunkIdx] :
+                   chunkToNbrOffsetBitWidthMap->get(chunkIdx, trxType);
+    }
+    // Note: This function is to be used only by the WRITE trx.
+    void setNbrOffsetBitWidth(uint64_t chunkIdx, uint32_t bitWidth);
+
     inline void checkpointInMemoryIfNecessary() {
         chunkToPageListHeadIdxMap->checkpointInMemoryIfNecessary();
         pageLists->checkpointInMemoryIfNecessary();
+        chunkToNbrOffsetBitWidthMap->checkpointInMemoryIfNecessary();
     }
 
     inline void rollbackInMemoryIfNecessary() {
         chunkToPageListHeadIdxMap->rollbackInMemoryIfNecessary();
         pageLists->rollbackInMemoryIfNecessary();
+        chunkToNbrOffsetBitWidthMap->rollbackInMemoryIfNecessary();
     }
 
 private:
@@ -69,6 +99,9 @@ private:
     // list. pageLists is used both to store the list of pages for large lists as well as small
     // lists of each chunk.
     std::unique_ptr<InMemDiskArray<common::page_idx_t>> pageLists;
+    // chunkToNbrOffsetBitWidthMap holds the bit width of the neighbour offsets of each chunk of
+    // adjacency lists. It is empty for other lists.
+    std::unique_ptr<InMemDiskArray<uint32_t>> chunkToNbrOffsetBitWidthMap;
 };
 
 /**
@@ -98,6 +131,8 @@ public:
     // chunkId - 1 has already been populated.
     void populateChunkPageList(uint32_t chunkId, uint32_t numPages, uint32_t startPageId);
 
+    void setNbrOffsetBitWidths(const std::vector<uint32_t>& bitWidths);
+
     void saveToDisk();
 
 private:
@@ -109,6 +144,7 @@ private:
     std::unique_ptr<FileHandle> metadataFileHandleForBuilding;
     std::unique_ptr<InMemDiskArrayBuilder<uint32_t>> chunkToPageListHeadIdxMapBuilder;
     std::unique_ptr<InMemDiskArrayBuilder<common::page_idx_t>> pageListsBuilder;
+    std::unique_ptr<InMemDiskArrayBuilder<uint32_t>> chunkToNbrOffsetBitWidthMapBuilder;
 };
 
 } // namespace storage
@@ -51,6 +51,16 @@ protected:
     virtual inline void updateListHeaderIfNecessary(
         csr_offset_t oldCSROffset, csr_offset_t newCSROffset) = 0;
 
+    // Called when the iterator moves to a chunk, before any list of the chunk is written.
+    virtual inline void prepareChunk() {}
+    // Returns true if the lists of the current chunk have to be written even if their csr offsets
+    // don't change, i.e., if the layout of the chunk changes.
+    virtual inline bool mustRewriteListsInChunk() const { return false; }
+    virtual inline uint64_t getNumElementsPerPage() const { return lists->numElementsPerPage; }
+    // Writes numElements elements of the inMemList from posInList to a list page.
+    virtual void writeElementsToFrame(uint8_t* frame, InMemList& inMemList, uint64_t posInList,
+        uint64_t elementOffsetInListPage, uint64_t numElements);
+
     void seekToBeginningOfChunkIdx(uint64_t chunkIdx);
 
     void slideListsIfNecessary(uint64_t endNodeOffsetInclusive);
@@ -84,9 +94,16 @@ protected:
     bool finishCalled;
 };
 
+// Neighbour offsets are packed with the bit width of their chunk. If the offsets inserted into a
+// chunk don't fit into its bit width, the bit width grows and all lists of the chunk are written
+// again with the new bit width. Property lists don't depend on the bit width, so only their lists
+// whose csr offsets change are written.
 class AdjListsUpdateIterator : public ListsUpdateIterator {
 public:
-    explicit AdjListsUpdateIterator(Lists* lists) : ListsUpdateIterator{lists} {}
+    explicit AdjListsUpdateIterator(Lists* lists)
+        : ListsUpdateIterator{lists},
+          nbrOffsetBitWidth{ListsMetadata::UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH},
+          rewriteListsInChunk{false} {}
 
 private:
     inline void updateListHeaderIfNecessary(
@@ -95,6 +112,18 @@ private:
             lists->getHeaders()->update(curUnprocessedNodeOffset, newCSROffset);
         }
     }
+
+    void prepareChunk() override;
+    inline bool mustRewriteListsInChunk() const override { return rewriteListsInChunk; }
+    inline uint64_t getNumElementsPerPage() const override {
+        return ListsMetadata::getNumNbrOffsetsPerPage(nbrOffsetBitWidth);
+    }
+    void writeElementsToFrame(uint8_t* frame, InMemList& inMemList, uint64_t posInList,
+        uint64_t elementOffsetInListPage, uint64_t numElements) override;
+
+private:
+    uint32_t nbrOffsetBitWidth;
+    bool rewriteListsInChunk;
 };
 
 class RelPropertyListsUpdateIterator : public ListsUpdateIterator {
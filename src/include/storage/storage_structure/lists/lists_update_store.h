@@ -114,6 +114,11 @@ public:
     uint64_t getNumInsertedRelsForNodeOffset(
         ListFileID& listFileID, common::offset_t nodeOffset) const;
 
+    // Returns the largest neighbour offset of the rels inserted into the adjacency lists of a
+    // chunk, or 0 if there is none.
+    common::offset_t getMaxInsertedNbrOffsetInChunk(
+        ListFileID& listFileID, chunk_idx_t chunkIdx) const;
+
     void readValues(
         ListFileID& listFileID, ListHandle& listSyncState, common::ValueVector* valueVector) const;
 
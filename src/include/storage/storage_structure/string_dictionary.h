@@ -0,0 +1,96 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types/ku_string.h"
+#include "common/types/types.h"
+
+namespace kuzu {
+namespace storage {
+
+/**
+ * StringDictionary holds the distinct values of a dictionary-encoded string column. The column
+ * stores the code of each value, i.e., the index of the value in the dictionary, in a separate
+ * codes file next to the column file, and the dictionary is stored in the dictionary file.
+ *
+ * Dictionaries are built by COPY and are immutable afterwards. Values written after COPY are
+ * stored with their code if they are in the dictionary, and with INVALID_CODE otherwise, in which
+ * case the value is read from the column file, which keeps all values of the column.
+ *
+ * Scans set the dictionary and the codes of the values in the result vector, so equality filters
+ * and hashes of the values are computed on codes. Entries are stored as ku_string_t whose overflow
+ * points to the dictionary, so values are copied into the result vector without their overflow.
+ */
+class StringDictionary {
+public:
+    static constexpr uint32_t INVALID_CODE = UINT32_MAX;
+
+    // values are the entries of the dictionary in the order of their codes.
+    explicit StringDictionary(std::vector<std::string> values);
+
+    static std::unique_ptr<StringDictionary> loadFromFile(const std::string& fName);
+    void saveToFile(const std::string& fName) const;
+
+    inline uint32_t getNumEntries() const { return entries.size(); }
+    inline const common::ku_string_t& getEntry(uint32_t code) const {
+        assert(code < entries.size());
+        return entries[code];
+    }
+    // Equal to the hash of the entry computed by `Hash::operation`.
+    inline common::hash_t getHash(uint32_t code) const {
+        assert(code < hashes.size());
+        return hashes[code];
+    }
+
+    // Returns INVALID_CODE if the value is not in the dictionary.
+    inline uint32_t getCode(const common::ku_string_t& value) const {
+        return getCode(std::string_view{(const char*)value.getData(), value.len});
+    }
+    inline uint32_t getCode(std::string_view value) const {
+        auto it = codes.find(value);
+        return it == codes.end() ? INVALID_CODE : it->second;
+    }
+
+private:
+    std::vector<std::string> values;
+    std::vector<common::ku_string_t> entries;
+    std::vector<common::hash_t> hashes;
+    std::unordered_map<std::string_view, uint32_t> codes;
+};
+
+// Assigns codes to the distinct values of a string column while the column is copied by multiple
+// threads. Each thread encodes the distinct values of its chunk at once, so the lock is taken once
+// per chunk. The dictionary is abandoned if the column has more than
+// MAX_NUM_STRING_DICTIONARY_ENTRIES distinct values or MAX_STRING_DICTIONARY_SIZE bytes of them.
+class StringDictionaryBuilder {
+public:
+    StringDictionaryBuilder() : numBytes{0}, abandoned{false} {}
+
+    // Sets the code of each value, in the order of their first appearance across calls. Returns
+    // false if the dictionary is abandoned, in which case codes are not set.
+    bool encode(const std::vector<std::string_view>& distinctValues, std::vector<uint32_t>& codes);
+
+    inline bool isAbandoned() {
+        std::unique_lock lck{mtx};
+        return abandoned;
+    }
+
+    // Returns nullptr if the dictionary is abandoned.
+    std::unique_ptr<StringDictionary> finalize();
+
+private:
+    std::mutex mtx;
+    // Values are kept in a deque, which doesn't move its elements, as their views are the keys of
+    // codes.
+    std::deque<std::string> values;
+    std::unordered_map<std::string_view, uint32_t> codes;
+    uint64_t numBytes;
+    bool abandoned;
+};
+
+} // namespace storage
+} // namespace kuzu
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "common/expression_type.h"
+#include "common/types/value.h"
+
+namespace kuzu {
+namespace storage {
+
+union ZoneMapValue {
+    int64_t int64Val;
+    double doubleVal;
+};
+
+// The statistics of a zone, i.e., NUM_VALUES_PER_ZONE consecutive values of a column.
+struct ZoneMapEntry {
+    ZoneMapValue min;
+    ZoneMapValue max;
+    // Updates don't know if they overwrite a null, so the number of nulls is an upper bound.
+    uint64_t numNulls;
+    // False if all values of the zone are null.
+    bool hasValues;
+};
+
+// A comparison `column <comparisonType> value`, or `column IS [NOT] NULL`, whose value has the
+// type of the column.
+struct ZoneMapPredicate {
+    ZoneMapPredicate(common::ExpressionType comparisonType, ZoneMapValue value)
+        : comparisonType{comparisonType}, value{value} {}
+
+    common::ExpressionType comparisonType;
+    ZoneMapValue value;
+};
+
+/**
+ * ZoneMap keeps the min, the max and the number of nulls of each zone of a numeric node property
+ * column. Zones are aligned with the morsels of node scans, so scans skip the morsels whose zones
+ * can't satisfy a predicate on the column.
+ *
+ * Zone maps are built by COPY and only widened by updates afterwards, so they include the values
+ * of uncommitted and rolled back transactions. They are saved when a transaction commits, before
+ * its commit record is logged, and are loaded with the column.
+ */
+class ZoneMap {
+public:
+    static constexpr uint64_t NUM_VALUES_PER_ZONE = common::DEFAULT_VECTOR_CAPACITY;
+
+    explicit ZoneMap(const common::LogicalType& dataType)
+        : physicalType{dataType.getPhysicalType()}, dirty{false} {
+        assert(isSupported(dataType));
+    }
+
+    static bool isSupported(const common::LogicalType& dataType);
+    // Returns the zone map value of a non-null value of a supported type.
+    static ZoneMapValue getZoneMapValue(const common::Value& value);
+
+    static std::unique_ptr<ZoneMap> loadFromFile(
+        const common::LogicalType& dataType, const std::string& fName);
+    void saveToFile(const std::string& fName);
+
+    // Adds numValues values from startOffset, which can span zones. isNull can be nullptr.
+    void addValues(common::offset_t startOffset, const uint8_t* values, const bool* isNull,
+        uint64_t numValues);
+    void addValue(common::offset_t nodeOffset, const uint8_t* value);
+    void addNull(common::offset_t nodeOffset);
+
+    // Returns false only if no value of the zone satisfies the predicate. Zones beyond the zone
+    // map, e.g., of nodes added by another transaction, may always satisfy it.
+    bool mayMatch(uint64_t zoneIdx, const ZoneMapPredicate& predicate);
+
+    inline bool isDirty() {
+        std::shared_lock lck{mtx};
+        return dirty;
+    }
+    inline uint64_t getNumZones() {
+        std::shared_lock lck{mtx};
+        return entries.size();
+    }
+
+private:
+    // Extends the zone map with empty entries up to the zone.
+    ZoneMapEntry& getEntryToUpdate(uint64_t zoneIdx);
+    void addValueNoLock(ZoneMapEntry& entry, const uint8_t* value) const;
+
+    template<typename T>
+    static bool mayMatch(T min, T max, common::ExpressionType comparisonType, T value);
+
+private:
+    common::PhysicalTypeID physicalType;
+    std::shared_mutex mtx;
+    std::vector<ZoneMapEntry> entries;
+    bool dirty;
+};
+
+} // namespace storage
+} // namespace kuzu
@@ -77,6 +77,9 @@ public:
     static std::string appendStructFieldName(
         std::string filePath, common::struct_field_idx_t structFieldIdx);
     static std::string getPropertyNullFName(const std::string& filePath);
+    static std::string getPropertyDictionaryFName(const std::string& filePath);
+    static std::string getPropertyDictionaryCodesFName(const std::string& filePath);
+    static std::string getPropertyZoneMapFName(const std::string& filePath);
 
     static inline StorageStructureIDAndFName getNodePropertyColumnStructureIDAndFName(
         const std::string& directory, const catalog::Property& property) {
@@ -95,6 +98,15 @@ public:
         return nullColumnStructureIDAndFName;
     }
 
+    static inline StorageStructureIDAndFName getDictionaryCodesColumnStructureIDAndFName(
+        StorageStructureIDAndFName propertyColumnIDAndFName) {
+        auto codesColumnStructureIDAndFName = propertyColumnIDAndFName;
+        codesColumnStructureIDAndFName.fName =
+            StorageUtils::getPropertyDictionaryCodesFName(propertyColumnIDAndFName.fName);
+        codesColumnStructureIDAndFName.storageStructureID.isDictionaryCodes = true;
+        return codesColumnStructureIDAndFName;
+    }
+
     static inline StorageStructureIDAndFName getNodeIndexIDAndFName(
         const std::string& directory, common::table_id_t tableID) {
         auto fName = getNodeIndexFName(directory, tableID, common::DBFileType::ORIGINAL);
@@ -231,6 +243,12 @@ public:
                            common::StorageConstants::CATALOG_FILE_NAME_FOR_WAL);
     }
 
+    static inline std::string getSpillFilePath(const std::string& directory, uint64_t spillFileID) {
+        return common::FileUtils::joinPath(directory,
+            common::StorageConstants::SPILL_FILE_PREFIX + std::to_string(spillFileID) +
+                common::StorageConstants::SPILL_FILE_SUFFIX);
+    }
+
     // Note: This is a relatively slow function because of division and mod and making std::pair.
     // It is not meant to be used in performance critical code path.
     static inline std::pair<uint64_t, uint64_t> getQuotientRemainder(uint64_t i, uint64_t divisor) {
@@ -258,6 +276,9 @@ public:
 
     static std::unique_ptr<common::FileInfo> getFileInfoForReadWrite(
         const std::string& directory, StorageStructureID storageStructureID);
+    // Returns the name of the original file of the storage structure.
+    static std::string getStorageStructureFName(
+        const std::string& directory, StorageStructureID storageStructureID);
 
     static std::string getColumnFName(
         const std::string& directory, StorageStructureID storageStructureID);
@@ -30,6 +30,9 @@ public:
 
     void scan(transaction::Transaction* transaction, common::ValueVector* inputIDVector,
         const std::vector<uint32_t>& columnIdxes, std::vector<common::ValueVector*> outputVectors);
+    // Reads ahead the pages of the given columns holding numNodes nodes from startOffset.
+    void prefetch(common::offset_t startOffset, uint64_t numNodes,
+        const std::vector<uint32_t>& columnIds, PrefetchStats& stats);
 
     inline Column* getPropertyColumn(common::property_id_t propertyIdx) {
         assert(propertyColumns.contains(propertyIdx));
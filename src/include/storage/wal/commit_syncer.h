@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "common/constants.h"
+
+namespace spdlog {
+class logger;
+}
+
+namespace kuzu {
+namespace storage {
+
+/**
+ * CommitSyncer syncs the files written by committing transactions to disk with a single background
+ * thread. Files are synced in rounds: a round syncs all files requested since the previous round
+ * started, once each, so requests that arrive while a round is in progress are grouped behind the
+ * next round instead of each paying for their own syncs.
+ *
+ * Under the SYNC durability mode, `sync` returns after the round holding its files completes, and
+ * rounds start as soon as files are requested. Under the RELAXED mode, `sync` returns immediately
+ * and a round starts at most syncIntervalInMs after its first request, which bounds the time that
+ * committed files stay only in the OS page cache.
+ */
+class CommitSyncer {
+public:
+    CommitSyncer(common::DurabilityMode durabilityMode, uint64_t syncIntervalInMs);
+    // Syncs the files requested so far before returning.
+    ~CommitSyncer();
+
+    // Throws if syncing a file fails. Under the RELAXED mode, the failures of background rounds
+    // are thrown by the next call. Files that don't exist when their round starts, e.g., removed
+    // by a later checkpoint, are skipped.
+    void sync(const std::vector<std::string>& filePaths);
+    // Syncs the files before returning under both durability modes. The RELAXED mode starts the
+    // round without waiting for the sync interval, and the round also syncs the files requested
+    // by earlier `sync` calls.
+    void syncAndWait(const std::vector<std::string>& filePaths);
+
+    inline common::DurabilityMode getDurabilityMode() const { return durabilityMode; }
+    inline uint64_t getNumCompletedRounds() {
+        std::unique_lock lck{mtx};
+        return numCompletedRounds;
+    }
+
+private:
+    void syncInternal(const std::vector<std::string>& filePaths, bool waitForRound);
+    void runSyncLoop();
+    // Returns the error message, or an empty string if all files are synced.
+    std::string syncFiles(const std::unordered_set<std::string>& filePaths);
+
+private:
+    std::shared_ptr<spdlog::logger> logger;
+    common::DurabilityMode durabilityMode;
+    uint64_t syncIntervalInMs;
+    std::mutex mtx;
+    std::condition_variable filesRequestedCV;
+    std::condition_variable roundCompletedCV;
+    std::unordered_set<std::string> filesToSync;
+    uint64_t numStartedRounds;
+    uint64_t numCompletedRounds;
+    // The last round that a request waits for, which starts without waiting for the sync interval.
+    uint64_t lastWaitedRound;
+    // The last round whose sync failed and its error. Failures are reported to all requests whose
+    // round had not completed when the failure was recorded.
+    uint64_t lastFailedRound;
+    std::string lastError;
+    bool hasUnreportedError;
+    bool stopped;
+    std::thread syncThread;
+};
+
+} // namespace storage
+} // namespace kuzu
@@ -136,6 +136,7 @@ public:
     }
 
     inline std::string getDirectory() const { return directory; }
+    inline std::string getFilePath() const { return fileHandle->getFileInfo()->path; }
 
     inline void addToUpdatedNodeTables(common::table_id_t nodeTableID) {
         updatedNodeTables.insert(nodeTableID);
@@ -204,6 +204,8 @@ struct StorageStructureID {
     StorageStructureType storageStructureType;
     bool isOverflow;
     bool isNullBits;
+    // The codes column of a dictionary-encoded string column. See `StringDictionary`.
+    bool isDictionaryCodes;
     union {
         ColumnFileID columnFileID;
         ListFileID listFileID;
@@ -211,7 +213,8 @@ struct StorageStructureID {
     };
 
     inline bool operator==(const StorageStructureID& rhs) const {
-        if (storageStructureType != rhs.storageStructureType || isOverflow != rhs.isOverflow) {
+        if (storageStructureType != rhs.storageStructureType || isOverflow != rhs.isOverflow ||
+            isDictionaryCodes != rhs.isDictionaryCodes) {
             return false;
         }
         switch (storageStructureType) {
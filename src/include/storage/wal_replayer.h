@@ -1,6 +1,9 @@
 #pragma once
 
+#include <map>
+
 #include "catalog/catalog.h"
+#include "common/task_system/task_scheduler.h"
 #include "storage/buffer_manager/buffer_manager.h"
 #include "storage/wal/wal.h"
 #include "storage/wal/wal_record.h"
@@ -18,16 +21,38 @@ enum class WALReplayMode : uint8_t { COMMIT_CHECKPOINT, ROLLBACK, RECOVERY_CHECK
 
 // Note: This class is not thread-safe.
 class WALReplayer {
+    // The page records of one file. Only the last record of each page is kept, and the pages are
+    // ordered by their pageIdx in the file so that consecutive pages are written together.
+    struct PageRecordsOfFile {
+        StorageStructureID storageStructureID;
+        std::string filePath;
+        std::map<common::page_idx_t, common::page_idx_t> walPageIdxOfOriginalPageIdx;
+        // Set if the in-memory checkpointing of the pages is needed.
+        BMFileHandle* fileHandle = nullptr;
+    };
+
 public:
     WALReplayer(WAL* wal, StorageManager* storageManager, MemoryManager* memoryManager,
-        BufferManager* bufferManager, catalog::Catalog* catalog, WALReplayMode replayMode);
+        BufferManager* bufferManager, catalog::Catalog* catalog, WALReplayMode replayMode,
+        common::TaskScheduler& taskScheduler);
 
     void replay();
 
+    // The files that a checkpoint wrote to, which need to be synced before the WAL is cleared.
+    inline std::vector<std::string> getCheckpointedFilePaths() const {
+        return std::vector<std::string>{checkpointedFilePaths.begin(), checkpointedFilePaths.end()};
+    }
+    inline uint64_t getNumReplayedPages() const { return numReplayedPages; }
+
 private:
     void init();
     void replayWALRecord(WALRecord& walRecord);
-    void replayPageUpdateOrInsertRecord(const WALRecord& walRecord);
+    // Page records of a checkpoint are buffered until the next record of another type, or the end
+    // of the WAL, and then the pages of different files are replayed in parallel.
+    void bufferPageUpdateOrInsertRecord(const WALRecord& walRecord);
+    void replayBufferedPageUpdateOrInsertRecords();
+    void replayPagesOfFile(const PageRecordsOfFile& pageRecordsOfFile);
+    void rollbackPageUpdateOrInsertRecord(const WALRecord& walRecord);
     void replayTableStatisticsRecord(const WALRecord& walRecord);
     void replayCatalogRecord();
     void replayNodeTableRecord(const WALRecord& walRecord);
@@ -39,8 +64,6 @@ private:
     void replayDropPropertyRecord(const WALRecord& walRecord);
     void replayAddPropertyRecord(const WALRecord& walRecord);
 
-    void checkpointOrRollbackVersionedFileHandleAndBufferManager(
-        const WALRecord& walRecord, const StorageStructureID& storageStructureID);
     void truncateFileIfInsertion(
         BMFileHandle* fileHandle, const PageUpdateOrInsertRecord& pageInsertOrUpdateRecord);
     BMFileHandle* getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(
@@ -48,6 +71,10 @@ private:
     std::unique_ptr<catalog::Catalog> getCatalogForRecovery(common::DBFileType dbFileType);
 
 private:
+    // The maximum number of consecutive pages written to a file by one vectored write.
+    static constexpr uint64_t MAX_NUM_PAGES_PER_WRITE = 64;
+
+    std::shared_ptr<spdlog::logger> logger;
     bool isRecovering;
     bool isCheckpoint; // if true does redo operations; if false does undo operations
     // Warning: Some fields of the storageManager may not yet be initialized if the WALReplayer
@@ -56,9 +83,14 @@ private:
     BufferManager* bufferManager;
     MemoryManager* memoryManager;
     std::shared_ptr<BMFileHandle> walFileHandle;
-    std::unique_ptr<uint8_t[]> pageBuffer;
     WAL* wal;
     catalog::Catalog* catalog;
+    common::TaskScheduler& taskScheduler;
+    std::unordered_map<std::string, uint64_t> pageRecordsOfFileIdxes;
+    std::vector<PageRecordsOfFile> bufferedPageRecordsOfFiles;
+    std::unordered_set<std::string> checkpointedFilePaths;
+    uint64_t numReplayedPageRecords;
+    uint64_t numReplayedPages;
 };
 
 } // namespace storage
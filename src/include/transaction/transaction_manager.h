@@ -31,6 +31,10 @@ public:
     // stopNewTransactionsAndWaitUntilAllReadTransactionsLeave().
     void stopNewTransactionsAndWaitUntilAllReadTransactionsLeave();
     void allowReceivingNewTransactions();
+    inline bool hasActiveReadOnlyTransactions() {
+        lock_t lck{mtxForSerializingPublicFunctionCalls};
+        return !activeReadOnlyTransactionIDs.empty();
+    }
 
     // Warning: Below public functions are for tests only
     inline std::unordered_set<uint64_t>& getActiveReadOnlyTransactionIDs() {
@@ -0,0 +1,128 @@
+#include "main/checkpointer.h"
+
+#include "common/exception.h"
+#include "spdlog/spdlog.h"
+#include "transaction/transaction_manager.h"
+
+using namespace kuzu::common;
+using namespace kuzu::transaction;
+
+namespace kuzu {
+namespace main {
+
+Checkpointer::Checkpointer(TransactionManager& transactionManager, uint64_t maxCheckpointDelayInMs,
+    std::function<void()> checkpointFunc)
+    : logger{LoggerUtils::getLogger(LoggerConstants::LoggerEnum::DATABASE)},
+      transactionManager{transactionManager}, maxCheckpointDelayInMs{maxCheckpointDelayInMs},
+      checkpointFunc{std::move(checkpointFunc)}, numScheduledCheckpoints{0},
+      numCompletedCheckpoints{0}, numWaitingTransactions{0}, failedCheckpointSeq{UINT64_MAX},
+      stopped{false} {
+    checkpointThread = std::thread(&Checkpointer::runCheckpointLoop, this);
+}
+
+Checkpointer::~Checkpointer() {
+    {
+        std::unique_lock lck{mtx};
+        stopped = true;
+    }
+    cv.notify_all();
+    checkpointThread.join();
+}
+
+uint64_t Checkpointer::scheduleCheckpoint(std::unique_ptr<Transaction> writeTransaction) {
+    std::unique_lock lck{mtx};
+    assert(writeTransactionToCheckpoint == nullptr);
+    writeTransactionToCheckpoint = std::move(writeTransaction);
+    cv.notify_all();
+    return ++numScheduledCheckpoints;
+}
+
+void Checkpointer::waitForCheckpoint(uint64_t checkpointSeq) {
+    std::unique_lock lck{mtx};
+    if (numCompletedCheckpoints < checkpointSeq) {
+        numWaitingTransactions++;
+        // Wakes the checkpointer up if it is waiting for read transactions to leave on their own.
+        cv.notify_all();
+        auto isCompleted = cv.wait_for(lck,
+            std::chrono::microseconds(
+                DEFAULT_CHECKPOINT_WAIT_TIMEOUT_FOR_TRANSACTIONS_TO_LEAVE_IN_MICROS),
+            [&] { return numCompletedCheckpoints >= checkpointSeq; });
+        numWaitingTransactions--;
+        if (!isCompleted) {
+            throw TransactionManagerException(
+                "Timeout waiting for the checkpoint of a committed write transaction. If you have "
+                "an open read transaction close and try again.");
+        }
+    }
+    if (failedCheckpointSeq <= checkpointSeq) {
+        throw TransactionManagerException(
+            "Checkpointing a committed write transaction failed: " + error +
+            ". The transaction is checkpointed when the database is opened again.");
+    }
+}
+
+void Checkpointer::runCheckpointLoop() {
+    std::unique_lock lck{mtx};
+    while (true) {
+        cv.wait(lck, [&] { return stopped || writeTransactionToCheckpoint != nullptr; });
+        if (writeTransactionToCheckpoint == nullptr) {
+            return;
+        }
+        waitForReadTransactionsToLeave(lck);
+        lck.unlock();
+        std::string checkpointError;
+        try {
+            while (!tryCheckpoint()) {
+                logger->warn("Timeout waiting for read transactions to leave before checkpointing. "
+                             "Retrying.");
+                std::unique_lock stoppedLck{mtx};
+                if (stopped) {
+                    // The WAL of the committed transaction is replayed by the recovery.
+                    checkpointError = "read transactions are active while closing the database";
+                    break;
+                }
+            }
+        } catch (std::exception& e) { checkpointError = e.what(); }
+        lck.lock();
+        if (!checkpointError.empty()) {
+            // The failed transaction stays the active write transaction, so no write transaction
+            // can start before the database is opened again and recovers.
+            logger->error("Cannot checkpoint a committed write transaction: {}", checkpointError);
+            error = std::move(checkpointError);
+            failedCheckpointSeq = std::min(failedCheckpointSeq, numScheduledCheckpoints);
+        }
+        writeTransactionToCheckpoint.reset();
+        numCompletedCheckpoints = numScheduledCheckpoints;
+        cv.notify_all();
+    }
+}
+
+void Checkpointer::waitForReadTransactionsToLeave(std::unique_lock<std::mutex>& lck) {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(maxCheckpointDelayInMs);
+    while (transactionManager.hasActiveReadOnlyTransactions() &&
+           std::chrono::steady_clock::now() < deadline) {
+        if (cv.wait_for(lck, std::chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS),
+                [&] { return stopped || numWaitingTransactions > 0; })) {
+            return;
+        }
+    }
+}
+
+bool Checkpointer::tryCheckpoint() {
+    try {
+        transactionManager.stopNewTransactionsAndWaitUntilAllReadTransactionsLeave();
+    } catch (TransactionManagerException& e) { return false; }
+    try {
+        checkpointFunc();
+    } catch (std::exception& e) {
+        transactionManager.allowReceivingNewTransactions();
+        throw;
+    }
+    transactionManager.manuallyClearActiveWriteTransaction(writeTransactionToCheckpoint.get());
+    transactionManager.allowReceivingNewTransactions();
+    return true;
+}
+
+} // namespace main
+} // namespace kuzu
@@ -17,7 +17,9 @@ void ActiveQuery::reset() {
 
 ClientContext::ClientContext()
     : numThreadsForExecution{std::thread::hardware_concurrency()},
-      timeoutInMS{common::ClientContextConstants::TIMEOUT_IN_MS} {}
+      timeoutInMS{common::ClientContextConstants::TIMEOUT_IN_MS},
+      copyRelBufferSize{common::ClientContextConstants::COPY_REL_BUFFER_SIZE},
+      orderByMemoryBudget{common::ClientContextConstants::ORDER_BY_MEMORY_BUDGET} {}
 
 void ClientContext::startTimingIfEnabled() {
     if (isTimeOutEnabled()) {
@@ -158,6 +158,9 @@ std::unique_ptr<PreparedStatement> Connection::prepareNoLock(
     std::unique_ptr<ExecutionContext> executionContext;
     std::unique_ptr<LogicalPlan> logicalPlan;
     try {
+        // Binding reads the catalog, which includes the DDL of the connection after its checkpoint.
+        database->waitForCheckpointIfNecessary(
+            TransactionType::READ_ONLY, lastCommittedCheckpointSeq);
         // parsing
         auto statement = Parser::parseQuery(query);
         // binding
@@ -379,6 +382,7 @@ void Connection::beginTransactionNoLock(TransactionType type) {
             "transactions, please open other connections. Current active transaction is "
             "not affected by this exception and can still be used.");
     }
+    database->waitForCheckpointIfNecessary(type, lastCommittedCheckpointSeq);
     activeTransaction = type == transaction::TransactionType::READ_ONLY ?
                             database->transactionManager->beginReadOnlyTransaction() :
                             database->transactionManager->beginWriteTransaction();
@@ -389,6 +393,9 @@ void Connection::commitOrRollbackNoLock(
     if (activeTransaction) {
         if (action == TransactionAction::COMMIT) {
             database->commit(activeTransaction.get(), skipCheckpointForTesting);
+            if (activeTransaction->isWriteTransaction()) {
+                lastCommittedCheckpointSeq = database->getNumScheduledCheckpoints();
+            }
         } else {
             assert(action == TransactionAction::ROLLBACK);
             database->rollback(activeTransaction.get(), skipCheckpointForTesting);
@@ -7,9 +7,12 @@
 #endif
 
 #include "common/logging_level_utils.h"
+#include "common/metric.h"
+#include "main/checkpointer.h"
 #include "processor/processor.h"
 #include "spdlog/spdlog.h"
 #include "storage/storage_manager.h"
+#include "storage/wal/commit_syncer.h"
 #include "storage/wal_replayer.h"
 #include "transaction/transaction_manager.h"
 
@@ -45,20 +48,46 @@ Database::Database(std::string databasePath) : Database{std::move(databasePath),
 
 Database::Database(std::string databasePath, SystemConfig systemConfig)
     : databasePath{std::move(databasePath)}, systemConfig{systemConfig} {
+    if (this->systemConfig.durabilityMode == DurabilityMode::RELAXED &&
+        !this->systemConfig.enableBackgroundCheckpointing) {
+        // Inline checkpoints sync their files before clearing the WAL, so commits would still wait
+        // for the syncs.
+        throw RuntimeException(
+            "The RELAXED durability mode requires background checkpointing to be enabled.");
+    }
     initLoggers();
     logger = LoggerUtils::getLogger(LoggerConstants::LoggerEnum::DATABASE);
     initDBDirAndCoreFilesIfNecessary();
-    bufferManager = std::make_unique<BufferManager>(this->systemConfig.bufferPoolSize);
-    memoryManager = std::make_unique<MemoryManager>(bufferManager.get());
-    queryProcessor = std::make_unique<processor::QueryProcessor>(this->systemConfig.maxNumThreads);
+    bufferManager = std::make_unique<BufferManager>(
+        this->systemConfig.bufferPoolSize, this->systemConfig.evictionPolicy);
+    memoryManager = std::make_unique<MemoryManager>(bufferManager.get(), this->databasePath);
+    queryProcessor = std::make_unique<processor::QueryProcessor>(
+        this->systemConfig.maxNumThreads, this->systemConfig.pinThreadsToNUMANodes);
     wal = std::make_unique<WAL>(this->databasePath, *bufferManager);
+    commitSyncer = std::make_unique<CommitSyncer>(
+        this->systemConfig.durabilityMode, this->systemConfig.relaxedDurabilitySyncIntervalInMs);
+    commitLatencyHistogram = std::make_unique<LatencyHistogram>();
+    commitSyncLatencyHistogram = std::make_unique<LatencyHistogram>();
+    checkpointLatencyHistogram = std::make_unique<LatencyHistogram>();
     recoverIfNecessary();
     catalog = std::make_unique<catalog::Catalog>(wal.get());
     storageManager = std::make_unique<storage::StorageManager>(*catalog, *memoryManager, wal.get());
     transactionManager = std::make_unique<transaction::TransactionManager>(*wal);
+    if (this->systemConfig.enableBackgroundCheckpointing) {
+        checkpointer = std::make_unique<Checkpointer>(*transactionManager,
+            this->systemConfig.maxBackgroundCheckpointDelayInMs,
+            [this]() { checkpointCommittedTransaction(); });
+    }
 }
 
 Database::~Database() {
+    // Checkpoints the last committed write transaction before the storage is destructed.
+    checkpointer.reset();
+    if (commitLatencyHistogram->getNumRecorded() > 0) {
+        logger->info("Commit latencies: {}. Commit sync latencies: {}. Checkpoint latencies: {}.",
+            commitLatencyHistogram->toString(), commitSyncLatencyHistogram->toString(),
+            checkpointLatencyHistogram->toString());
+    }
     dropLoggers();
     bufferManager->clearEvictionQueue();
 }
@@ -118,8 +147,22 @@ void Database::commit(Transaction* transaction, bool skipCheckpointForTestingRec
         return;
     }
     assert(transaction->isWriteTransaction());
+    Timer commitTimer;
+    commitTimer.start();
     catalog->prepareCommitOrRollback(TransactionAction::COMMIT);
     storageManager->prepareCommit();
+    if (checkpointer != nullptr && !skipCheckpointForTestingRecovery) {
+        // Read transactions keep reading the last checkpointed version until the checkpointer
+        // applies the WAL, so the commit doesn't wait for them to leave.
+        transactionManager->commitButKeepActiveWriteTransaction(transaction);
+        wal->flushAllPages();
+        syncCommittedFiles({wal->getFilePath()});
+        checkpointer->scheduleCheckpoint(
+            std::make_unique<Transaction>(TransactionType::WRITE, transaction->getID()));
+        commitTimer.stop();
+        commitLatencyHistogram->record((uint64_t)commitTimer.getDuration());
+        return;
+    }
     // Note: It is enough to stop and wait transactions to leave the system instead of
     // for example checking on the query processor's task scheduler. This is because the
     // first and last steps that a connection performs when executing a query is to
@@ -132,13 +175,18 @@ void Database::commit(Transaction* transaction, bool skipCheckpointForTestingRec
     // order allows us to throw exceptions if we have to wait a lot to stop.
     transactionManager->commitButKeepActiveWriteTransaction(transaction);
     wal->flushAllPages();
+    // The transaction is durable once its commit record is on disk, so recovery can redo its
+    // checkpoint if the checkpoint below is interrupted.
+    syncCommittedFiles({wal->getFilePath()});
     if (skipCheckpointForTestingRecovery) {
         transactionManager->allowReceivingNewTransactions();
         return;
     }
-    checkpointAndClearWAL(WALReplayMode::COMMIT_CHECKPOINT);
+    checkpointCommittedTransaction();
     transactionManager->manuallyClearActiveWriteTransaction(transaction);
     transactionManager->allowReceivingNewTransactions();
+    commitTimer.stop();
+    commitLatencyHistogram->record((uint64_t)commitTimer.getDuration());
 }
 
 void Database::rollback(
@@ -158,18 +206,59 @@ void Database::rollback(
     transactionManager->manuallyClearActiveWriteTransaction(transaction);
 }
 
+void Database::waitForCheckpointIfNecessary(TransactionType type, uint64_t checkpointSeq) {
+    if (checkpointer == nullptr) {
+        return;
+    }
+    if (type == TransactionType::WRITE) {
+        checkpointer->waitForScheduledCheckpoint();
+    } else {
+        checkpointer->waitForCheckpoint(checkpointSeq);
+    }
+}
+
+uint64_t Database::getNumScheduledCheckpoints() const {
+    return checkpointer == nullptr ? 0 : checkpointer->getNumScheduledCheckpoints();
+}
+
+void Database::checkpointCommittedTransaction() {
+    Timer checkpointTimer;
+    checkpointTimer.start();
+    checkpointAndClearWAL(WALReplayMode::COMMIT_CHECKPOINT);
+    checkpointTimer.stop();
+    checkpointLatencyHistogram->record((uint64_t)checkpointTimer.getDuration());
+}
+
 void Database::checkpointAndClearWAL(WALReplayMode replayMode) {
     assert(replayMode == WALReplayMode::COMMIT_CHECKPOINT ||
            replayMode == WALReplayMode::RECOVERY_CHECKPOINT);
     auto walReplayer = std::make_unique<WALReplayer>(wal.get(), storageManager.get(),
-        memoryManager.get(), bufferManager.get(), catalog.get(), replayMode);
+        memoryManager.get(), bufferManager.get(), catalog.get(), replayMode,
+        *queryProcessor->getTaskScheduler());
     walReplayer->replay();
+    // The checkpointed files are synced before the WAL that can redo them is cleared, also under
+    // the RELAXED durability mode, as the cleared WAL could not redo the unsynced files. Under that
+    // mode, only the background checkpointer waits for the sync, not the commit.
+    syncCommittedFiles(walReplayer->getCheckpointedFilePaths(), true /* waitForSync */);
     wal->clearWAL();
 }
 
+void Database::syncCommittedFiles(const std::vector<std::string>& filePaths, bool waitForSync) {
+    Timer syncTimer;
+    syncTimer.start();
+    if (waitForSync) {
+        commitSyncer->syncAndWait(filePaths);
+    } else {
+        commitSyncer->sync(filePaths);
+    }
+    syncTimer.stop();
+    commitSyncLatencyHistogram->record((uint64_t)syncTimer.getDuration());
+}
+
 void Database::rollbackAndClearWAL() {
     auto walReplayer = std::make_unique<WALReplayer>(wal.get(), storageManager.get(),
-        memoryManager.get(), bufferManager.get(), catalog.get(), WALReplayMode::ROLLBACK);
+        memoryManager.get(), bufferManager.get(), catalog.get(), WALReplayMode::ROLLBACK,
+        *queryProcessor->getTaskScheduler());
     walReplayer->replay();
     wal->clearWAL();
 }
@@ -1,11 +1,13 @@
 #include "optimizer/filter_push_down_optimizer.h"
 
 #include "binder/expression/expression_visitor.h"
+#include "binder/expression/literal_expression.h"
 #include "binder/expression/property_expression.h"
 #include "planner/logical_plan/logical_operator/logical_expressions_scan.h"
 #include "planner/logical_plan/logical_operator/logical_filter.h"
 #include "planner/logical_plan/logical_operator/logical_scan_node.h"
 #include "planner/logical_plan/logical_operator/logical_scan_node_property.h"
+#include "storage/storage_structure/zone_map.h"
 
 using namespace kuzu::binder;
 using namespace kuzu::planner;
@@ -128,6 +130,9 @@ std::shared_ptr<planner::LogicalOperator> FilterPushDownOptimizer::visitScanNode
     }
     // Perform filter push down.
     auto currentRoot = scanNodeProperty->getChild(0);
+    if (currentRoot->getOperatorType() == LogicalOperatorType::SCAN_NODE) {
+        addZoneMapPredicates((LogicalScanNode*)currentRoot.get());
+    }
     for (auto& predicate : predicateSet->equalityPredicates) {
         currentRoot = pushDownToScanNode(node, predicate, currentRoot);
     }
@@ -145,6 +150,54 @@ std::shared_ptr<planner::LogicalOperator> FilterPushDownOptimizer::visitScanNode
     return appendScanNodeProperty(node, properties, currentRoot);
 }
 
+static bool isNodeProperty(const Expression& expression, const NodeExpression& node) {
+    return expression.expressionType == common::ExpressionType::PROPERTY &&
+           ((PropertyExpression&)expression).getVariableName() == node.getUniqueName();
+}
+
+// A zone map predicate compares a numeric property of the node with a non-null literal of the same
+// type, or checks if the property is null.
+static bool isZoneMapPredicate(const Expression& predicate, const NodeExpression& node) {
+    switch (predicate.expressionType) {
+    case common::ExpressionType::IS_NULL:
+    case common::ExpressionType::IS_NOT_NULL: {
+        auto property = predicate.getChild(0);
+        return isNodeProperty(*property, node) && storage::ZoneMap::isSupported(property->dataType);
+    }
+    case common::ExpressionType::EQUALS:
+    case common::ExpressionType::GREATER_THAN:
+    case common::ExpressionType::GREATER_THAN_EQUALS:
+    case common::ExpressionType::LESS_THAN:
+    case common::ExpressionType::LESS_THAN_EQUALS: {
+        auto property = predicate.getChild(0);
+        auto literal = predicate.getChild(1);
+        if (property->expressionType == common::ExpressionType::LITERAL) {
+            std::swap(property, literal);
+        }
+        return isNodeProperty(*property, node) &&
+               storage::ZoneMap::isSupported(property->dataType) &&
+               literal->expressionType == common::ExpressionType::LITERAL &&
+               !((LiteralExpression&)*literal).isNull() && literal->dataType == property->dataType;
+    }
+    default:
+        return false;
+    }
+}
+
+void FilterPushDownOptimizer::addZoneMapPredicates(LogicalScanNode* scanNode) {
+    auto node = scanNode->getNode();
+    for (auto& predicate : predicateSet->equalityPredicates) {
+        if (isZoneMapPredicate(*predicate, *node)) {
+            scanNode->addZoneMapPredicate(predicate);
+        }
+    }
+    for (auto& predicate : predicateSet->nonEqualityPredicates) {
+        if (isZoneMapPredicate(*predicate, *node)) {
+            scanNode->addZoneMapPredicate(predicate);
+        }
+    }
+}
+
 std::shared_ptr<planner::LogicalOperator> FilterPushDownOptimizer::pushDownToScanNode(
     std::shared_ptr<binder::NodeExpression> node, std::shared_ptr<binder::Expression> predicate,
     std::shared_ptr<planner::LogicalOperator> child) {
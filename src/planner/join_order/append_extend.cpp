@@ -117,6 +117,15 @@ void JoinOrderEnumerator::appendRecursiveExtend(std::shared_ptr<NodeExpression>
     }
     auto extend = std::make_shared<LogicalRecursiveExtend>(boundNode, nbrNode, rel, direction,
         RecursiveJoinType::TRACK_PATH, plan.getLastOperator(), recursivePlan->getLastOperator());
+    if (rel->getRelType() == common::QueryRelType::SHORTEST) {
+        // Shortest path frontiers can also be extended bottom-up, i.e. from unvisited nodes to
+        // their nbrs in the frontier, which requires a recursive plan in the reverse direction.
+        auto reverseRecursivePlan = std::make_unique<LogicalPlan>();
+        createRecursivePlan(recursiveInfo->nodeCopy, recursiveInfo->node, recursiveInfo->rel,
+            ExtendDirectionUtils::getReverseExtendDirection(direction), recursiveInfo->predicates,
+            *reverseRecursivePlan);
+        extend->setReverseRecursiveChild(reverseRecursivePlan->getLastOperator());
+    }
     queryPlanner->appendFlattens(extend->getGroupsPosToFlatten(), plan);
     extend->setChild(0, plan.getLastOperator());
     extend->computeFactorizedSchema();
@@ -11,12 +11,22 @@ f_group_pos_set LogicalRecursiveExtend::getGroupsPosToFlatten() {
     f_group_pos_set result;
     auto inSchema = children[0]->getSchema();
     auto boundNodeGroupPos = inSchema->getGroupPos(*boundNode->getInternalIDProperty());
-    if (!inSchema->getGroup(boundNodeGroupPos)->isFlat()) {
+    // A multi-source BFS reads a batch of bound nodes from an unflat group and flattens the group
+    // by itself, see RecursiveJoin::scanNextSrcNode.
+    if (!inSchema->getGroup(boundNodeGroupPos)->isFlat() && !isMultiSourceBFS()) {
         result.insert(boundNodeGroupPos);
     }
     return result;
 }
 
+bool LogicalRecursiveExtend::isMultiSourceBFS() const {
+    // Masks of the multi-source BFS are indexed by node offset, so all nodes of the recursive join
+    // must be in the same table.
+    return rel->getRelType() == common::QueryRelType::SHORTEST &&
+           joinType == RecursiveJoinType::TRACK_NONE &&
+           rel->getRecursiveInfo()->node->getNumTableIDs() == 1;
+}
+
 void LogicalRecursiveExtend::computeFlatSchema() {
     copyChildSchema(0);
     schema->insertToGroupAndScope(nbrNode->getInternalIDProperty(), 0);
@@ -34,6 +44,9 @@ void LogicalRecursiveExtend::computeFlatSchema() {
 
 void LogicalRecursiveExtend::computeFactorizedSchema() {
     copyChildSchema(0);
+    if (isMultiSourceBFS()) {
+        schema->flattenGroup(schema->getGroupPos(*boundNode->getInternalIDProperty()));
+    }
     auto nbrGroupPos = schema->createGroup();
     schema->insertToGroupAndScope(nbrNode->getInternalIDProperty(), nbrGroupPos);
     schema->insertToGroupAndScope(rel->getLengthExpression(), nbrGroupPos);
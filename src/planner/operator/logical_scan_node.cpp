@@ -15,6 +15,20 @@ void LogicalScanNode::computeFlatSchema() {
     schema->insertToGroupAndScope(node->getInternalIDProperty(), 0);
 }
 
+std::string LogicalScanNode::getExpressionsForPrinting() const {
+    if (zoneMapPredicates.empty()) {
+        return node->toString();
+    }
+    std::string result = node->toString() + ", ZoneMap: ";
+    for (auto i = 0u; i < zoneMapPredicates.size(); ++i) {
+        if (i > 0) {
+            result += " AND ";
+        }
+        result += zoneMapPredicates[i]->toString();
+    }
+    return result;
+}
+
 void LogicalIndexScanNode::computeFactorizedSchema() {
     copyChildSchema(0);
     auto groupPos = schema->getGroupPos(*indexExpression);
@@ -52,6 +52,13 @@ void ProjectionPlanner::planProjectionBody(
     if (projectionBody.hasOrderByExpressions()) {
         planOrderBy(expressionsToProject, projectionBody.getOrderByExpressions(),
             projectionBody.getSortingOrders(), plan);
+        // Projection and multiplicity reducer don't change the number of tuples, so ORDER BY only
+        // needs to produce the first (skip + limit) tuples unless DISTINCT is in between.
+        if (projectionBody.hasLimit() && !projectionBody.getIsDistinct()) {
+            auto orderBy = (LogicalOrderBy*)plan.getLastOperator().get();
+            auto skipNumber = projectionBody.hasSkip() ? projectionBody.getSkipNumber() : 0;
+            orderBy->setLimitNumber(skipNumber + projectionBody.getLimitNumber());
+        }
     }
     appendProjection(expressionsToProject, plan);
     if (projectionBody.getIsDistinct()) {
@@ -70,8 +70,8 @@ std::unique_ptr<PhysicalOperator> PlanMapper::mapHashJoin(LogicalOperator* logic
         hashJoin->getExpressionsToMaterialize(), hashJoin->getJoinNodeIDs());
     // Create build
     auto buildInfo = createHashBuildInfo(*buildSchema, hashJoin->getJoinNodeIDs(), payloads);
-    auto globalHashTable = std::make_unique<JoinHashTable>(
-        *memoryManager, buildInfo->getNumKeys(), buildInfo->getTableSchema()->copy());
+    auto globalHashTable = std::make_unique<JoinHashTable>(*memoryManager, buildInfo->getNumKeys(),
+        buildInfo->getTableSchema()->copy(), true /* canSpillPartitions */);
     auto sharedState = std::make_shared<HashJoinSharedState>(std::move(globalHashTable));
     auto hashJoinBuild =
         make_unique<HashJoinBuild>(std::make_unique<ResultSetDescriptor>(buildSchema), sharedState,
@@ -86,6 +86,32 @@ std::unique_ptr<PhysicalOperator> PlanMapper::mapHashJoin(LogicalOperator* logic
         probePayloadsOutPos.emplace_back(outSchema->getExpressionPos(*payload));
     }
     ProbeDataInfo probeDataInfo(probeKeysDataPos, probePayloadsOutPos);
+    // Probe-side tuples whose keys are in spilled partitions of the hash table are kept in
+    // factorized tables until the partitions are loaded. They are stored like the build side
+    // tuples, i.e., columns of the key chunks and of flat chunks are flat.
+    auto probeSchema = hashJoin->getChild(0)->getSchema();
+    planner::f_group_pos_set keyGroupPosSet;
+    for (auto& pos : probeKeysDataPos) {
+        keyGroupPosSet.insert(pos.dataChunkPos);
+    }
+    probeDataInfo.probeSideTableSchema = std::make_unique<FactorizedTableSchema>();
+    for (auto& expression : probeSchema->getExpressionsInScope()) {
+        auto pos = DataPos(outSchema->getExpressionPos(*expression));
+        std::unique_ptr<ColumnSchema> columnSchema;
+        if (keyGroupPosSet.contains(pos.dataChunkPos) ||
+            probeSchema->getGroup(probeSchema->getGroupPos(*expression))->isFlat()) {
+            columnSchema = std::make_unique<ColumnSchema>(false /* isUnFlat */, pos.dataChunkPos,
+                LogicalTypeUtils::getRowLayoutSize(expression->dataType));
+        } else {
+            columnSchema = std::make_unique<ColumnSchema>(
+                true /* isUnFlat */, pos.dataChunkPos, (uint32_t)sizeof(common::overflow_value_t));
+        }
+        probeDataInfo.probeSideTableSchema->appendColumn(std::move(columnSchema));
+        probeDataInfo.probeSideDataPos.push_back(pos);
+    }
+    // The last column keeps the multiplicity of the result set for each tuple.
+    probeDataInfo.probeSideTableSchema->appendColumn(std::make_unique<ColumnSchema>(
+        false /* isUnFlat */, probeKeysDataPos[0].dataChunkPos, (uint32_t)sizeof(uint64_t)));
     if (hashJoin->getJoinType() == common::JoinType::MARK) {
         auto mark = hashJoin->getMark();
         auto markOutputPos = DataPos(outSchema->getExpressionPos(*mark));
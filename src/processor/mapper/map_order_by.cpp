@@ -3,6 +3,7 @@
 #include "processor/operator/order_by/order_by.h"
 #include "processor/operator/order_by/order_by_merge.h"
 #include "processor/operator/order_by/order_by_scan.h"
+#include "processor/operator/order_by/top_k.h"
 
 using namespace kuzu::planner;
 
@@ -34,15 +35,27 @@ std::unique_ptr<PhysicalOperator> PlanMapper::mapOrderBy(LogicalOperator* logica
     auto orderByDataInfo = OrderByDataInfo(keysPosAndType, payloadsPosAndType, isPayloadFlat,
         logicalOrderBy.getIsAscOrders(), mayContainUnflatKey);
     auto orderBySharedState = std::make_shared<SharedFactorizedTablesAndSortedKeyBlocks>();
-
-    auto orderBy =
-        make_unique<OrderBy>(std::make_unique<ResultSetDescriptor>(inSchema), orderByDataInfo,
-            orderBySharedState, std::move(prevOperator), getOperatorID(), paramsString);
-    auto dispatcher = std::make_shared<KeyBlockMergeTaskDispatcher>();
-    auto orderByMerge = make_unique<OrderByMerge>(orderBySharedState, std::move(dispatcher),
-        std::move(orderBy), getOperatorID(), paramsString);
-    auto orderByScan = make_unique<OrderByScan>(
-        outVectorPos, orderBySharedState, std::move(orderByMerge), getOperatorID(), paramsString);
+    // TopK keeps the first limitNumber tuples of the factorizedTable, which are the first
+    // limitNumber output tuples only if there is no unflat column in the factorizedTable.
+    auto hasUnflatPayload = false;
+    for (auto isFlat : isPayloadFlat) {
+        hasUnflatPayload |= !isFlat && !mayContainUnflatKey;
+    }
+    std::unique_ptr<PhysicalOperator> sortedKeyBlocksProducer;
+    if (logicalOrderBy.hasLimitNumber() && !hasUnflatPayload) {
+        sortedKeyBlocksProducer = make_unique<TopK>(std::make_unique<ResultSetDescriptor>(inSchema),
+            orderByDataInfo, orderBySharedState, logicalOrderBy.getLimitNumber(),
+            std::move(prevOperator), getOperatorID(), paramsString);
+    } else {
+        auto orderBy =
+            make_unique<OrderBy>(std::make_unique<ResultSetDescriptor>(inSchema), orderByDataInfo,
+                orderBySharedState, std::move(prevOperator), getOperatorID(), paramsString);
+        auto dispatcher = std::make_shared<KeyBlockMergeTaskDispatcher>();
+        sortedKeyBlocksProducer = make_unique<OrderByMerge>(orderBySharedState,
+            std::move(dispatcher), std::move(orderBy), getOperatorID(), paramsString);
+    }
+    auto orderByScan = make_unique<OrderByScan>(outVectorPos, orderBySharedState,
+        std::move(sortedKeyBlocksProducer), getOperatorID(), paramsString);
     return orderByScan;
 }
 
@@ -9,13 +9,19 @@ namespace kuzu {
 namespace processor {
 
 static std::shared_ptr<RecursiveJoinSharedState> createSharedState(
-    const binder::NodeExpression& nbrNode, const storage::StorageManager& storageManager) {
+    const binder::NodeExpression& nbrNode, const binder::NodeExpression& recursiveNode,
+    const storage::StorageManager& storageManager) {
     std::vector<std::unique_ptr<NodeOffsetSemiMask>> semiMasks;
     for (auto tableID : nbrNode.getTableIDs()) {
         auto nodeTable = storageManager.getNodesStore().getNodeTable(tableID);
         semiMasks.push_back(std::make_unique<NodeOffsetSemiMask>(nodeTable));
     }
-    return std::make_shared<RecursiveJoinSharedState>(std::move(semiMasks));
+    std::vector<storage::NodeTable*> recursiveNodeTables;
+    for (auto tableID : recursiveNode.getTableIDs()) {
+        recursiveNodeTables.push_back(storageManager.getNodesStore().getNodeTable(tableID));
+    }
+    return std::make_shared<RecursiveJoinSharedState>(
+        std::move(semiMasks), std::move(recursiveNodeTables));
 }
 
 std::unique_ptr<PhysicalOperator> PlanMapper::mapRecursiveExtend(
@@ -42,7 +48,7 @@ std::unique_ptr<PhysicalOperator> PlanMapper::mapRecursiveExtend(
     auto boundNodeIDPos = DataPos(inSchema->getExpressionPos(*boundNode->getInternalIDProperty()));
     auto nbrNodeIDPos = DataPos(outSchema->getExpressionPos(*nbrNode->getInternalIDProperty()));
     auto lengthPos = DataPos(outSchema->getExpressionPos(*lengthExpression));
-    auto sharedState = createSharedState(*nbrNode, storageManager);
+    auto sharedState = createSharedState(*nbrNode, *recursiveInfo->node, storageManager);
     auto pathPos = DataPos();
     if (extend->getJoinType() == planner::RecursiveJoinType::TRACK_PATH) {
         pathPos = DataPos(outSchema->getExpressionPos(*rel));
@@ -50,11 +56,25 @@ std::unique_ptr<PhysicalOperator> PlanMapper::mapRecursiveExtend(
     auto dataInfo = std::make_unique<RecursiveJoinDataInfo>(boundNodeIDPos, nbrNodeIDPos,
         nbrNode->getTableIDsSet(), lengthPos, std::move(recursivePlanResultSetDescriptor),
         recursiveDstNodeIDPos, recursiveInfo->node->getTableIDsSet(), recursiveEdgeIDPos, pathPos);
+    dataInfo->isMultiSourceBFS = extend->isMultiSourceBFS();
+    // Map reverse recursive plan. The multi-source BFS only extends top-down.
+    std::unique_ptr<PhysicalOperator> reverseRecursiveRoot;
+    auto logicalReverseRecursiveRoot = extend->getReverseRecursiveChild();
+    if (logicalReverseRecursiveRoot != nullptr && !dataInfo->isMultiSourceBFS) {
+        reverseRecursiveRoot = mapOperator(logicalReverseRecursiveRoot.get());
+        auto reverseRecursivePlanSchema = logicalReverseRecursiveRoot->getSchema();
+        dataInfo->setReverseRecursiveInfo(
+            std::make_unique<ResultSetDescriptor>(reverseRecursivePlanSchema),
+            DataPos(reverseRecursivePlanSchema->getExpressionPos(
+                *recursiveInfo->node->getInternalIDProperty())),
+            DataPos(reverseRecursivePlanSchema->getExpressionPos(
+                *recursiveInfo->rel->getInternalIDProperty())));
+    }
     auto prevOperator = mapOperator(logicalOperator->getChild(0).get());
     return std::make_unique<RecursiveJoin>(rel->getLowerBound(), rel->getUpperBound(),
         rel->getRelType(), extend->getJoinType(), sharedState, std::move(dataInfo),
         std::move(prevOperator), getOperatorID(), extend->getExpressionsForPrinting(),
-        std::move(recursiveRoot));
+        std::move(recursiveRoot), std::move(reverseRecursiveRoot));
 }
 
 } // namespace processor
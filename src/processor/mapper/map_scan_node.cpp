@@ -1,13 +1,60 @@
+#include "binder/expression/literal_expression.h"
+#include "binder/expression/property_expression.h"
 #include "planner/logical_plan/logical_operator/logical_scan_node.h"
 #include "processor/mapper/plan_mapper.h"
 #include "processor/operator/index_scan.h"
 #include "processor/operator/scan_node_id.h"
 
+using namespace kuzu::binder;
+using namespace kuzu::common;
 using namespace kuzu::planner;
+using namespace kuzu::storage;
 
 namespace kuzu {
 namespace processor {
 
+// Returns the comparison with the operands swapped, e.g., `10 > a.age` is `a.age < 10`.
+static ExpressionType reverseComparison(ExpressionType comparisonType) {
+    switch (comparisonType) {
+    case GREATER_THAN:
+        return LESS_THAN;
+    case GREATER_THAN_EQUALS:
+        return LESS_THAN_EQUALS;
+    case LESS_THAN:
+        return GREATER_THAN;
+    case LESS_THAN_EQUALS:
+        return GREATER_THAN_EQUALS;
+    default:
+        return comparisonType;
+    }
+}
+
+static void addZoneMapPredicate(
+    NodeTableScanState* tableState, const Expression& predicateExpression) {
+    auto comparisonType = predicateExpression.expressionType;
+    auto property = predicateExpression.getChild(0);
+    ZoneMapValue value{0};
+    if (predicateExpression.getNumChildren() == 2) {
+        auto literal = predicateExpression.getChild(1);
+        if (property->expressionType == LITERAL) {
+            std::swap(property, literal);
+            comparisonType = reverseComparison(comparisonType);
+        }
+        value = ZoneMap::getZoneMapValue(*((LiteralExpression&)*literal).getValue());
+    }
+    auto tableID = tableState->getTable()->getTableID();
+    auto& propertyExpression = (PropertyExpression&)*property;
+    if (!propertyExpression.hasPropertyID(tableID)) {
+        return;
+    }
+    auto zoneMap = tableState->getTable()
+                       ->getPropertyColumn(propertyExpression.getPropertyID(tableID))
+                       ->getZoneMap();
+    if (zoneMap != nullptr) {
+        tableState->addZoneMapPredicate(zoneMap, ZoneMapPredicate{comparisonType, value});
+    }
+}
+
 std::unique_ptr<PhysicalOperator> PlanMapper::mapScanNode(LogicalOperator* logicalOperator) {
     auto logicalScan = (LogicalScanNode*)logicalOperator;
     auto outSchema = logicalScan->getSchema();
@@ -16,8 +63,10 @@ std::unique_ptr<PhysicalOperator> PlanMapper::mapScanNode(LogicalOperator* logic
     auto dataPos = DataPos(outSchema->getExpressionPos(*node->getInternalIDProperty()));
     auto sharedState = std::make_shared<ScanNodeIDSharedState>();
     for (auto& tableID : node->getTableIDs()) {
-        auto nodeTable = nodesStore.getNodeTable(tableID);
-        sharedState->addTableState(nodeTable);
+        auto tableState = sharedState->addTableState(nodesStore.getNodeTable(tableID));
+        for (auto& predicate : logicalScan->getZoneMapPredicates()) {
+            addZoneMapPredicate(tableState, *predicate);
+        }
     }
     return make_unique<ScanNodeID>(
         dataPos, sharedState, getOperatorID(), logicalScan->getExpressionsForPrinting());
@@ -70,6 +70,16 @@ bool AggregateHashTable::isAggregateValueDistinctForGroupByKeys(
 }
 
 void AggregateHashTable::merge(AggregateHashTable& other) {
+    mergeTuples(other, [](uint64_t i) { return i; }, other.factorizedTable->getNumTuples());
+}
+
+void AggregateHashTable::merge(
+    AggregateHashTable& other, const std::vector<ft_tuple_idx_t>& otherTupleIdxes) {
+    mergeTuples(other, [&](uint64_t i) { return otherTupleIdxes[i]; }, otherTupleIdxes.size());
+}
+
+void AggregateHashTable::mergeTuples(AggregateHashTable& other,
+    const std::function<ft_tuple_idx_t(uint64_t)>& getOtherTupleIdx, uint64_t numTuples) {
     std::shared_ptr<DataChunkState> vectorsToScanState = std::make_shared<DataChunkState>();
     std::vector<ValueVector*> vectorsToScan(keyDataTypes.size() + dependentKeyDataTypes.size());
     std::vector<ValueVector*> groupByHashVectors(keyDataTypes.size());
@@ -99,23 +109,142 @@ void AggregateHashTable::merge(AggregateHashTable& other) {
     iota(colIdxesToScan.begin(), colIdxesToScan.end(), 0);
     // Note: we store hash values at the last column of factorizedTable.
     colIdxesToScan.push_back(factorizedTable->getTableSchema()->getNumColumns() - 1);
-    uint64_t startTupleIdx = 0;
-    while (startTupleIdx < other.factorizedTable->getNumTuples()) {
-        auto numTuplesToScan = std::min(
-            other.factorizedTable->getNumTuples() - startTupleIdx, DEFAULT_VECTOR_CAPACITY);
-        other.factorizedTable->scan(vectorsToScan, startTupleIdx, numTuplesToScan, colIdxesToScan);
+    auto tuplesToRead = std::make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
+    uint64_t startPos = 0;
+    while (startPos < numTuples) {
+        auto numTuplesToScan = std::min(numTuples - startPos, DEFAULT_VECTOR_CAPACITY);
+        for (auto i = 0u; i < numTuplesToScan; i++) {
+            tuplesToRead[i] = other.factorizedTable->getTuple(getOtherTupleIdx(startPos + i));
+        }
+        other.factorizedTable->lookup(
+            vectorsToScan, colIdxesToScan, tuplesToRead.get(), 0 /* startPos */, numTuplesToScan);
         findHashSlots(std::vector<ValueVector*>(), groupByHashVectors, groupByNonHashVectors);
         auto aggregateStateOffset = aggStateColOffsetInFT;
         for (auto& aggregateFunction : aggregateFunctions) {
             for (auto i = 0u; i < numTuplesToScan; i++) {
                 aggregateFunction->combineState(
                     hashSlotsToUpdateAggState[i]->entry + aggregateStateOffset,
-                    other.factorizedTable->getTuple(startTupleIdx + i) + aggregateStateOffset,
-                    &memoryManager);
+                    tuplesToRead[i] + aggregateStateOffset, &memoryManager);
             }
             aggregateStateOffset += aggregateFunction->getAggregateStateSize();
         }
-        startTupleIdx += numTuplesToScan;
+        startPos += numTuplesToScan;
+    }
+}
+
+std::vector<std::vector<ft_tuple_idx_t>> AggregateHashTable::partitionTuplesByHash(
+    uint64_t numPartitionsLog2) {
+    std::vector<std::vector<ft_tuple_idx_t>> partitions((uint64_t)1 << numPartitionsLog2);
+    // The least significant bits decide the hash slot, so we partition by the most significant
+    // bits to keep the tuples of a partition spread over the slots of the partition's table.
+    auto shift = sizeof(hash_t) * 8 - numPartitionsLog2;
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    ft_tuple_idx_t tupleIdx = 0;
+    for (auto& tupleBlock : factorizedTable->getTupleDataBlocks()) {
+        uint8_t* tuple = tupleBlock->getData();
+        for (auto i = 0u; i < tupleBlock->numTuples; i++) {
+            auto hash = *(hash_t*)(tuple + hashColOffsetInFT);
+            partitions[numPartitionsLog2 == 0 ? 0 : hash >> shift].push_back(tupleIdx++);
+            tuple += numBytesPerTuple;
+        }
+    }
+    return partitions;
+}
+
+std::vector<ft_tuple_idx_t> AggregateHashTable::appendDistinctTuples(
+    AggregateHashTable& other, const std::vector<ft_tuple_idx_t>& otherTupleIdxes) {
+    assert(aggregateFunctions.empty() && keyDataTypes.size() == other.keyDataTypes.size());
+    // Keys are read into vectors and written back with updateFlatCell, which copies var-sized
+    // values into the overflow buffer of this table.
+    auto keyVectorsState = std::make_shared<DataChunkState>();
+    std::vector<std::unique_ptr<ValueVector>> keyVectors(keyDataTypes.size());
+    std::vector<ValueVector*> vectorsToRead(keyDataTypes.size());
+    for (auto i = 0u; i < keyDataTypes.size(); i++) {
+        keyVectors[i] = std::make_unique<ValueVector>(keyDataTypes[i], &memoryManager);
+        keyVectors[i]->state = keyVectorsState;
+        vectorsToRead[i] = keyVectors[i].get();
+    }
+    std::vector<uint32_t> colIdxesToRead(keyDataTypes.size());
+    iota(colIdxesToRead.begin(), colIdxesToRead.end(), 0);
+    auto tuplesToRead = std::make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
+    std::vector<ft_tuple_idx_t> appendedTupleIdxes;
+    uint64_t startPos = 0;
+    while (startPos < otherTupleIdxes.size()) {
+        auto numTuplesToRead =
+            std::min(otherTupleIdxes.size() - startPos, DEFAULT_VECTOR_CAPACITY);
+        for (auto i = 0u; i < numTuplesToRead; i++) {
+            tuplesToRead[i] = other.factorizedTable->getTuple(otherTupleIdxes[startPos + i]);
+        }
+        other.factorizedTable->lookup(
+            vectorsToRead, colIdxesToRead, tuplesToRead.get(), 0 /* startPos */, numTuplesToRead);
+        for (auto i = 0u; i < numTuplesToRead; i++) {
+            auto otherEntry = tuplesToRead[i];
+            auto hash = *(hash_t*)(otherEntry + hashColOffsetInFT);
+            if (findEntryInDistinctHT(otherEntry, hash) != nullptr) {
+                continue;
+            }
+            resizeHashTableIfNecessary(1);
+            auto entry = factorizedTable->appendEmptyTuple();
+            for (auto colIdx = 0u; colIdx < keyVectors.size(); colIdx++) {
+                factorizedTable->updateFlatCell(entry, colIdx, keyVectors[colIdx].get(), i);
+            }
+            factorizedTable->updateFlatCellNoNull(entry, hashColIdxInFT, &hash);
+            fillHashSlot(hash, entry);
+            appendedTupleIdxes.push_back(otherTupleIdxes[startPos + i]);
+        }
+        startPos += numTuplesToRead;
+    }
+    return appendedTupleIdxes;
+}
+
+void AggregateHashTable::combineDistinctAggState(uint32_t aggregateFunctionIdx,
+    AggregateHashTable& distinctHT, const std::vector<ft_tuple_idx_t>& tupleIdxes) {
+    auto& aggregateFunction = aggregateFunctions[aggregateFunctionIdx];
+    assert(aggregateFunction->isFunctionDistinct());
+    auto aggregateStateOffset = aggStateColOffsetInFT;
+    for (auto i = 0u; i < aggregateFunctionIdx; i++) {
+        aggregateStateOffset += aggregateFunctions[i]->getAggregateStateSize();
+    }
+    // Distinct hash table entry layout: [groupKey1, ... groupKeyN, aggregateValue, hashValue].
+    std::shared_ptr<DataChunkState> vectorsToScanState = std::make_shared<DataChunkState>();
+    std::vector<ValueVector*> vectorsToScan(keyDataTypes.size() + 1);
+    std::vector<ValueVector*> groupByHashVectors(keyDataTypes.size());
+    std::vector<std::unique_ptr<ValueVector>> hashKeyVectors(keyDataTypes.size());
+    for (auto i = 0u; i < keyDataTypes.size(); i++) {
+        auto hashKeyVec = std::make_unique<ValueVector>(keyDataTypes[i], &memoryManager);
+        hashKeyVec->state = vectorsToScanState;
+        vectorsToScan[i] = hashKeyVec.get();
+        groupByHashVectors[i] = hashKeyVec.get();
+        hashKeyVectors[i] = std::move(hashKeyVec);
+    }
+    auto aggregateVector = std::make_unique<ValueVector>(
+        distinctHT.keyDataTypes[keyDataTypes.size()], &memoryManager);
+    aggregateVector->state = vectorsToScanState;
+    vectorsToScan[keyDataTypes.size()] = aggregateVector.get();
+    std::vector<uint32_t> colIdxesToScan(vectorsToScan.size());
+    iota(colIdxesToScan.begin(), colIdxesToScan.end(), 0);
+    auto tuplesToRead = std::make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
+    uint64_t startPos = 0;
+    while (startPos < tupleIdxes.size()) {
+        auto numTuplesToRead = std::min(tupleIdxes.size() - startPos, DEFAULT_VECTOR_CAPACITY);
+        for (auto i = 0u; i < numTuplesToRead; i++) {
+            tuplesToRead[i] = distinctHT.factorizedTable->getTuple(tupleIdxes[startPos + i]);
+        }
+        distinctHT.factorizedTable->lookup(
+            vectorsToScan, colIdxesToScan, tuplesToRead.get(), 0 /* startPos */, numTuplesToRead);
+        // All groups have been created when merging the hash tables of all threads, so finding
+        // the hash slots does not create new entries.
+        computeVectorHashes(std::vector<ValueVector*>(), groupByHashVectors);
+        findHashSlots(std::vector<ValueVector*>(), groupByHashVectors, std::vector<ValueVector*>());
+        // Distinct aggregate should ignore multiplicity.
+        for (auto i = 0u; i < numTuplesToRead; i++) {
+            if (!aggregateVector->isNull(i)) {
+                aggregateFunction->updatePosState(
+                    hashSlotsToUpdateAggState[i]->entry + aggregateStateOffset,
+                    aggregateVector.get(), 1 /* multiplicity */, i, &memoryManager);
+            }
+        }
+        startPos += numTuplesToRead;
     }
 }
 
@@ -213,6 +342,34 @@ uint8_t* AggregateHashTable::findEntryInDistinctHT(
     }
 }
 
+uint8_t* AggregateHashTable::findEntryInDistinctHT(const uint8_t* otherEntry, hash_t hash) {
+    auto slotIdx = getSlotIdxForHash(hash);
+    while (true) {
+        auto slot = (HashSlot*)getHashSlot(slotIdx);
+        if (slot->entry == nullptr) {
+            return nullptr;
+        } else if ((slot->hash == hash) && matchDistinctEntries(slot->entry, otherEntry)) {
+            return slot->entry;
+        }
+        increaseSlotIdx(slotIdx);
+    }
+}
+
+void AggregateHashTable::unpinBlocks() {
+    for (auto& block : hashSlotsBlocks) {
+        block->unpin();
+    }
+    factorizedTable->unpinBlocks();
+}
+
+uint64_t AggregateHashTable::pinBlocks() {
+    uint64_t numBytesRead = 0;
+    for (auto& block : hashSlotsBlocks) {
+        numBytesRead += block->pin();
+    }
+    return numBytesRead + factorizedTable->pinBlocks();
+}
+
 void AggregateHashTable::resize(uint64_t newSize) {
     maxNumHashSlots = newSize;
     bitmask = maxNumHashSlots - 1;
@@ -302,12 +459,15 @@ void AggregateHashTable::initializeFTEntries(
 
 uint8_t* AggregateHashTable::createEntryInDistinctHT(
     const std::vector<ValueVector*>& groupByHashKeyVectors, hash_t hash) {
+    resizeHashTableIfNecessary(1);
     auto entry = factorizedTable->appendEmptyTuple();
     for (auto i = 0u; i < groupByHashKeyVectors.size(); i++) {
         factorizedTable->updateFlatCell(entry, i, groupByHashKeyVectors[i],
             groupByHashKeyVectors[i]->state->selVector->selectedPositions[0]);
     }
     fillEntryWithInitialNullAggregateState(entry);
+    // The hash is kept in the entry for resizing and for partitioning the table by hash.
+    factorizedTable->updateFlatCellNoNull(entry, hashColIdxInFT, &hash);
     fillHashSlot(hash, entry);
     return entry;
 }
@@ -418,28 +578,15 @@ void AggregateHashTable::computeVectorHashes(
 
 void AggregateHashTable::updateDistinctAggState(
     const std::vector<ValueVector*>& groupByFlatHashKeyVectors,
-    const std::vector<ValueVector*>& groupByUnflatHashKeyVectors,
-    std::unique_ptr<AggregateFunction>& aggregateFunction, ValueVector* aggregateVector,
-    uint64_t multiplicity, uint32_t colIdx, uint32_t aggStateOffset) {
+    const std::vector<ValueVector*>& /*groupByUnFlatHashKeyVectors*/,
+    std::unique_ptr<AggregateFunction>& /*aggregateFunction*/, ValueVector* aggregateVector,
+    uint64_t /*multiplicity*/, uint32_t colIdx, uint32_t /*aggStateOffset*/) {
+    // A value may be distinct within a thread but not across threads. So we only record it in
+    // the distinct hash table here. The aggregate state is updated once all distinct hash tables
+    // have been combined (see combineDistinctAggState).
     auto distinctHT = distinctHashTables[colIdx].get();
     assert(distinctHT != nullptr);
-    if (distinctHT->isAggregateValueDistinctForGroupByKeys(
-            groupByFlatHashKeyVectors, aggregateVector)) {
-        auto pos = aggregateVector->state->selVector->selectedPositions[0];
-        if (!aggregateVector->isNull(pos)) {
-            aggregateFunction->updatePosState(
-                hashSlotsToUpdateAggState[groupByFlatHashKeyVectors.empty() ?
-                                              0 :
-                                              groupByFlatHashKeyVectors[0]
-                                                  ->state->selVector->selectedPositions[0]]
-                        ->entry +
-                    aggStateOffset,
-                aggregateVector, 1 /* Distinct aggregate should ignore multiplicity
-                                          since they are known to be non-distinct. */
-                ,
-                pos, &memoryManager);
-        }
-    }
+    distinctHT->isAggregateValueDistinctForGroupByKeys(groupByFlatHashKeyVectors, aggregateVector);
 }
 
 void AggregateHashTable::updateAggState(const std::vector<ValueVector*>& groupByFlatHashKeyVectors,
@@ -512,6 +659,25 @@ bool AggregateHashTable::matchFlatGroupByKeys(
     return true;
 }
 
+bool AggregateHashTable::matchDistinctEntries(const uint8_t* entry, const uint8_t* otherEntry) {
+    auto nullMapOffset = factorizedTable->getTableSchema()->getNullMapOffset();
+    for (auto i = 0u; i < keyDataTypes.size(); i++) {
+        auto isEntryKeyNull = factorizedTable->isNonOverflowColNull(entry + nullMapOffset, i);
+        auto isOtherEntryKeyNull =
+            factorizedTable->isNonOverflowColNull(otherEntry + nullMapOffset, i);
+        if (isEntryKeyNull && isOtherEntryKeyNull) {
+            continue;
+        } else if (isEntryKeyNull != isOtherEntryKeyNull) {
+            return false;
+        }
+        auto colOffset = factorizedTable->getTableSchema()->getColOffset(i);
+        if (!compareFuncs[i](otherEntry + colOffset, entry + colOffset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
     ValueVector* vector, uint64_t numMayMatches, uint64_t& numNoMatches, uint32_t colIdx) {
     assert(!vector->state->isFlat());
@@ -7,10 +7,59 @@ namespace processor {
 
 BaseAggregateSharedState::BaseAggregateSharedState(
     const std::vector<std::unique_ptr<AggregateFunction>>& aggregateFunctions)
-    : currentOffset{0} {
+    : currentOffset{0}, numCombinedDistinctHashTables{0} {
     for (auto& aggregateFunction : aggregateFunctions) {
         this->aggregateFunctions.push_back(aggregateFunction->clone());
+        std::vector<std::unique_ptr<DistinctHashTablePartition>> partitions;
+        if (aggregateFunction->isFunctionDistinct()) {
+            for (auto i = 0u; i < ((uint64_t)1 << DISTINCT_NUM_PARTITIONS_LOG2); i++) {
+                partitions.push_back(std::make_unique<DistinctHashTablePartition>());
+            }
+        }
+        distinctPartitions.push_back(std::move(partitions));
+    }
+}
+
+std::vector<std::vector<ft_tuple_idx_t>> BaseAggregateSharedState::combineDistinctHashTables(
+    const std::vector<std::unique_ptr<AggregateHashTable>>& distinctHashTables,
+    storage::MemoryManager& memoryManager) {
+    assert(distinctHashTables.size() == distinctPartitions.size());
+    uint64_t startPartitionIdx;
+    {
+        std::unique_lock lck{mtx};
+        // Threads start from different partitions to avoid waiting on each other.
+        startPartitionIdx = numCombinedDistinctHashTables++;
+    }
+    std::vector<std::vector<ft_tuple_idx_t>> distinctTupleIdxes(distinctHashTables.size());
+    for (auto i = 0u; i < distinctHashTables.size(); i++) {
+        auto localHT = distinctHashTables[i].get();
+        if (localHT == nullptr) {
+            continue;
+        }
+        auto& partitions = distinctPartitions[i];
+        auto partitionedTupleIdxes = localHT->partitionTuplesByHash(DISTINCT_NUM_PARTITIONS_LOG2);
+        auto& tupleIdxes = distinctTupleIdxes[i];
+        for (auto j = 0u; j < partitions.size(); j++) {
+            auto partitionIdx = (startPartitionIdx + j) % partitions.size();
+            if (partitionedTupleIdxes[partitionIdx].empty()) {
+                continue;
+            }
+            auto& partition = partitions[partitionIdx];
+            std::unique_lock lck{partition->mtx};
+            if (partition->hashTable == nullptr) {
+                partition->hashTable = std::make_unique<AggregateHashTable>(memoryManager,
+                    localHT->getKeyDataTypes(), std::vector<std::unique_ptr<AggregateFunction>>{},
+                    0 /* numEntriesToAllocate */);
+            }
+            auto appendedTupleIdxes = partition->hashTable->appendDistinctTuples(
+                *localHT, partitionedTupleIdxes[partitionIdx]);
+            tupleIdxes.insert(
+                tupleIdxes.end(), appendedTupleIdxes.begin(), appendedTupleIdxes.end());
+        }
+        // Keep the order in which the thread saw the values, e.g., for collect(DISTINCT ...).
+        std::sort(tupleIdxes.begin(), tupleIdxes.end());
     }
+    return distinctTupleIdxes;
 }
 
 bool BaseAggregate::containDistinctAggregate() const {
@@ -1,5 +1,7 @@
 #include "processor/operator/aggregate/hash_aggregate.h"
 
+#include "storage/buffer_manager/buffer_manager.h"
+
 using namespace kuzu::common;
 using namespace kuzu::function;
 using namespace kuzu::storage;
@@ -13,38 +15,131 @@ void HashAggregateSharedState::appendAggregateHashTable(
     localAggregateHashTables.push_back(std::move(aggregateHashTable));
 }
 
-void HashAggregateSharedState::combineAggregateHashTable(MemoryManager& memoryManager) {
+uint64_t HashAggregateSharedState::combineAggregateHashTable(MemoryManager& memoryManager) {
     std::unique_lock lck{mtx};
-    if (localAggregateHashTables.size() == 1) {
-        globalAggregateHashTable = std::move(localAggregateHashTables[0]);
-    } else {
+    uint64_t numBytesOfLocalTables = 0;
+    for (auto& ht : localAggregateHashTables) {
+        numBytesOfLocalTables += ht->getNumBytes();
+    }
+    auto memoryLimit = (uint64_t)(memoryManager.getBufferManager()->getBufferPoolSize() *
+                                  BufferPoolConstants::HASH_AGGREGATE_MEMORY_RATIO);
+    if (memoryManager.canSpill() && numBytesOfLocalTables > memoryLimit) {
+        return combineAggregateHashTablePartitions(memoryManager);
+    }
+    // Local hash tables are unpinned once they are built, so the buffer manager may have spilled
+    // them. We pin them back one at a time and release each of them right after it is merged.
+    auto numBytesSpilled = localAggregateHashTables[0]->pinBlocks();
+    if (localAggregateHashTables.size() > 1) {
         auto numEntries = 0u;
         for (auto& ht : localAggregateHashTables) {
             numEntries += ht->getNumEntries();
         }
         localAggregateHashTables[0]->resize(nextPowerOfTwo(numEntries));
-        globalAggregateHashTable = std::move(localAggregateHashTables[0]);
         for (auto i = 1u; i < localAggregateHashTables.size(); i++) {
-            globalAggregateHashTable->merge(*localAggregateHashTables[i]);
+            numBytesSpilled += localAggregateHashTables[i]->pinBlocks();
+            localAggregateHashTables[0]->merge(*localAggregateHashTables[i]);
+            localAggregateHashTables[i].reset();
         }
     }
+    localAggregateHashTables[0]->finalizeAggregateStates();
+    globalAggregateHashTables.push_back(std::move(localAggregateHashTables[0]));
+    localAggregateHashTables.clear();
+    return numBytesSpilled;
 }
 
-void HashAggregateSharedState::finalizeAggregateHashTable() {
-    std::unique_lock lck{mtx};
-    globalAggregateHashTable->finalizeAggregateStates();
+uint64_t HashAggregateSharedState::combineAggregateHashTablePartitions(
+    MemoryManager& memoryManager) {
+    auto& keyDataTypes = localAggregateHashTables[0]->getKeyDataTypes();
+    auto& dependentKeyDataTypes = localAggregateHashTables[0]->getDependentKeyDataTypes();
+    auto createHashTable = [&](uint64_t numEntriesToAllocate) {
+        auto hashTable = std::make_unique<AggregateHashTable>(memoryManager, keyDataTypes,
+            dependentKeyDataTypes, aggregateFunctions, numEntriesToAllocate);
+        // Distinct aggregate states are combined before the local tables are appended.
+        hashTable->moveDistinctHashTables();
+        return hashTable;
+    };
+    auto numPartitions = (uint64_t)1 << NUM_PARTITIONS_LOG2;
+    // Each local table is split into its partitions, which are unpinned right after they are
+    // created, so that only one local table needs to be in memory.
+    std::vector<std::vector<std::unique_ptr<AggregateHashTable>>> partitionsOfLocalTables(
+        numPartitions);
+    uint64_t numBytesSpilled = 0;
+    for (auto& localHashTable : localAggregateHashTables) {
+        numBytesSpilled += localHashTable->pinBlocks();
+        auto partitionedTupleIdxes = localHashTable->partitionTuplesByHash(NUM_PARTITIONS_LOG2);
+        for (auto i = 0u; i < numPartitions; i++) {
+            if (partitionedTupleIdxes[i].empty()) {
+                continue;
+            }
+            auto partition = createHashTable(partitionedTupleIdxes[i].size());
+            partition->merge(*localHashTable, partitionedTupleIdxes[i]);
+            partition->unpinBlocks();
+            partitionsOfLocalTables[i].push_back(std::move(partition));
+        }
+        localHashTable.reset();
+    }
+    localAggregateHashTables.clear();
+    // Each partition of the global table is combined from the partitions of the local tables and
+    // unpinned before the next one is combined.
+    for (auto& partitions : partitionsOfLocalTables) {
+        if (partitions.empty()) {
+            continue;
+        }
+        auto numEntries = 0u;
+        for (auto& partition : partitions) {
+            numEntries += partition->getNumEntries();
+        }
+        auto globalPartition = createHashTable(numEntries);
+        for (auto& partition : partitions) {
+            numBytesSpilled += partition->pinBlocks();
+            globalPartition->merge(*partition);
+            partition.reset();
+        }
+        globalPartition->finalizeAggregateStates();
+        globalPartition->unpinBlocks();
+        globalAggregateHashTables.push_back(std::move(globalPartition));
+    }
+    if (!globalAggregateHashTables.empty()) {
+        numBytesSpilled += globalAggregateHashTables[0]->pinBlocks();
+    }
+    return numBytesSpilled;
 }
 
-std::pair<uint64_t, uint64_t> HashAggregateSharedState::getNextRangeToRead() {
+std::tuple<AggregateHashTable*, uint64_t, uint64_t>
+HashAggregateSharedState::getNextRangeToRead() {
     std::unique_lock lck{mtx};
-    if (currentOffset >= globalAggregateHashTable->getNumEntries()) {
-        return std::make_pair(currentOffset, currentOffset);
+    while (currentPartitionIdx < globalAggregateHashTables.size()) {
+        auto hashTable = globalAggregateHashTables[currentPartitionIdx].get();
+        if (currentOffset < hashTable->getNumEntries()) {
+            auto startOffset = currentOffset;
+            auto range =
+                std::min(DEFAULT_VECTOR_CAPACITY, hashTable->getNumEntries() - currentOffset);
+            currentOffset += range;
+            numThreadsReadingRanges++;
+            return std::make_tuple(hashTable, startOffset, startOffset + range);
+        }
+        if (currentPartitionIdx + 1 == globalAggregateHashTables.size()) {
+            break;
+        }
+        // The next partition is pinned in place of this one once no thread reads this one.
+        auto partitionIdx = currentPartitionIdx;
+        rangeReleased.wait(lck, [&] { return numThreadsReadingRanges == 0; });
+        if (partitionIdx != currentPartitionIdx) {
+            // Another thread has moved on to the next partition.
+            continue;
+        }
+        hashTable->unpinBlocks();
+        currentPartitionIdx++;
+        currentOffset = 0;
+        globalAggregateHashTables[currentPartitionIdx]->pinBlocks();
     }
-    auto startOffset = currentOffset;
-    auto range = std::min(
-        DEFAULT_VECTOR_CAPACITY, globalAggregateHashTable->getNumEntries() - currentOffset);
-    currentOffset += range;
-    return std::make_pair(startOffset, startOffset + range);
+    return std::make_tuple(nullptr, currentOffset, currentOffset);
+}
+
+void HashAggregateSharedState::releaseRangeToRead() {
+    std::unique_lock lck{mtx};
+    numThreadsReadingRanges--;
+    rangeReleased.notify_all();
 }
 
 void HashAggregate::initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) {
@@ -75,12 +170,28 @@ void HashAggregate::executeInternal(ExecutionContext* context) {
         localAggregateHashTable->append(flatKeyVectors, unFlatKeyVectors, dependentKeyVectors,
             aggregateInputs, resultSet->multiplicity);
     }
+    if (containDistinctAggregate()) {
+        // The groups of the distinct tuples of this thread exist in its local hash table, so the
+        // distinct aggregate states are updated locally and combined with the other states when
+        // the local hash tables are merged. The distinct hash tables are freed right after.
+        auto distinctHashTables = localAggregateHashTable->moveDistinctHashTables();
+        auto distinctTupleIdxes =
+            sharedState->combineDistinctHashTables(distinctHashTables, *context->memoryManager);
+        for (auto i = 0u; i < aggregateFunctions.size(); i++) {
+            if (distinctHashTables[i] != nullptr) {
+                localAggregateHashTable->combineDistinctAggState(
+                    i, *distinctHashTables[i], distinctTupleIdxes[i]);
+            }
+        }
+    }
+    localAggregateHashTable->unpinBlocks();
     sharedState->appendAggregateHashTable(std::move(localAggregateHashTable));
 }
 
 void HashAggregate::finalize(ExecutionContext* context) {
-    sharedState->combineAggregateHashTable(*context->memoryManager);
-    sharedState->finalizeAggregateHashTable();
+    auto numBytesSpilled = sharedState->combineAggregateHashTable(*context->memoryManager);
+    context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+        ->increase(numBytesSpilled);
 }
 
 } // namespace processor
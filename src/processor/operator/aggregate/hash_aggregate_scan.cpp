@@ -16,23 +16,24 @@ void HashAggregateScan::initLocalStateInternal(ResultSet* resultSet, ExecutionCo
 }
 
 bool HashAggregateScan::getNextTuplesInternal(ExecutionContext* context) {
-    auto [startOffset, endOffset] = sharedState->getNextRangeToRead();
-    if (startOffset >= endOffset) {
+    auto [hashTable, startOffset, endOffset] = sharedState->getNextRangeToRead();
+    if (hashTable == nullptr) {
         return false;
     }
     auto numRowsToScan = endOffset - startOffset;
-    sharedState->getFactorizedTable()->scan(
-        groupByKeyVectors, startOffset, numRowsToScan, groupByKeyVectorsColIdxes);
+    auto factorizedTable = hashTable->getFactorizedTable();
+    factorizedTable->scan(groupByKeyVectors, startOffset, numRowsToScan, groupByKeyVectorsColIdxes);
     for (auto pos = 0u; pos < numRowsToScan; ++pos) {
-        auto entry = sharedState->getRow(startOffset + pos);
-        auto offset = sharedState->getFactorizedTable()->getTableSchema()->getColOffset(
-            groupByKeyVectors.size());
+        auto entry = hashTable->getEntry(startOffset + pos);
+        auto offset = factorizedTable->getTableSchema()->getColOffset(groupByKeyVectors.size());
         for (auto& vector : aggregateVectors) {
             auto aggState = (AggregateState*)(entry + offset);
             writeAggregateResultToVector(*vector, pos, aggState);
             offset += aggState->getStateSize();
         }
     }
+    // Values are copied into the vectors, so the table may be unpinned once the range is read.
+    sharedState->releaseRangeToRead();
     metrics->numOutputTuple.increase(numRowsToScan);
     return true;
 }
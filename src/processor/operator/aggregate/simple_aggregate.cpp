@@ -56,29 +56,57 @@ void SimpleAggregate::executeInternal(ExecutionContext* context) {
         for (auto i = 0u; i < aggregateFunctions.size(); i++) {
             auto aggregateFunction = aggregateFunctions[i].get();
             if (aggregateFunction->isFunctionDistinct()) {
-                computeDistinctAggregate(distinctHashTables[i].get(), aggregateFunction,
-                    aggregateInputs[i].get(), localAggregateStates[i].get(),
-                    context->memoryManager);
+                computeDistinctAggregate(distinctHashTables[i].get(), aggregateInputs[i].get());
             } else {
                 computeAggregate(aggregateFunction, aggregateInputs[i].get(),
                     localAggregateStates[i].get(), context->memoryManager);
             }
         }
     }
+    if (containDistinctAggregate()) {
+        auto distinctTupleIdxes =
+            sharedState->combineDistinctHashTables(distinctHashTables, *context->memoryManager);
+        for (auto i = 0u; i < aggregateFunctions.size(); i++) {
+            if (distinctHashTables[i] != nullptr) {
+                updateDistinctAggregateState(i, distinctTupleIdxes[i], context->memoryManager);
+                distinctHashTables[i].reset();
+            }
+        }
+    }
     sharedState->combineAggregateStates(localAggregateStates, context->memoryManager);
 }
 
-void SimpleAggregate::computeDistinctAggregate(AggregateHashTable* distinctHT,
-    function::AggregateFunction* function, AggregateInput* input, function::AggregateState* state,
-    storage::MemoryManager* memoryManager) {
-    auto multiplicity = 1; // Distinct aggregate should ignore multiplicity.
-    if (distinctHT->isAggregateValueDistinctForGroupByKeys(
-            std::vector<ValueVector*>{}, input->aggregateVector)) {
-        auto pos = input->aggregateVector->state->selVector->selectedPositions[0];
-        if (!input->aggregateVector->isNull(pos)) {
-            function->updatePosState(
-                (uint8_t*)state, input->aggregateVector, multiplicity, pos, memoryManager);
+void SimpleAggregate::computeDistinctAggregate(
+    AggregateHashTable* distinctHT, AggregateInput* input) {
+    // Values are only recorded here. The aggregate state is updated after the distinct hash tables
+    // of all threads have been combined, since a value may have been seen by other threads.
+    distinctHT->isAggregateValueDistinctForGroupByKeys(
+        std::vector<ValueVector*>{}, input->aggregateVector);
+}
+
+void SimpleAggregate::updateDistinctAggregateState(uint32_t aggregateFunctionIdx,
+    const std::vector<ft_tuple_idx_t>& tupleIdxes, storage::MemoryManager* memoryManager) {
+    auto distinctHT = distinctHashTables[aggregateFunctionIdx].get();
+    auto factorizedTable = distinctHT->getFactorizedTable();
+    auto aggregateVector =
+        std::make_unique<ValueVector>(distinctHT->getKeyDataTypes()[0], memoryManager);
+    aggregateVector->state = std::make_shared<DataChunkState>();
+    std::vector<ValueVector*> vectorsToRead{aggregateVector.get()};
+    std::vector<uint32_t> colIdxesToRead{0};
+    auto tuplesToRead = std::make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
+    uint64_t startPos = 0;
+    while (startPos < tupleIdxes.size()) {
+        auto numTuplesToRead = std::min(tupleIdxes.size() - startPos, DEFAULT_VECTOR_CAPACITY);
+        for (auto i = 0u; i < numTuplesToRead; i++) {
+            tuplesToRead[i] = factorizedTable->getTuple(tupleIdxes[startPos + i]);
         }
+        factorizedTable->lookup(
+            vectorsToRead, colIdxesToRead, tuplesToRead.get(), 0 /* startPos */, numTuplesToRead);
+        // Distinct aggregate should ignore multiplicity.
+        aggregateFunctions[aggregateFunctionIdx]->updateAllState(
+            (uint8_t*)localAggregateStates[aggregateFunctionIdx].get(), aggregateVector.get(),
+            1 /* multiplicity */, memoryManager);
+        startPos += numTuplesToRead;
     }
 }
 
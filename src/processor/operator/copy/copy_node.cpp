@@ -45,7 +45,13 @@ void CopyNodeSharedState::initializeColumns(
         }
         auto fPath = StorageUtils::getNodePropertyColumnFName(
             directory, nodeTableSchema->tableID, property.propertyID, DBFileType::ORIGINAL);
-        columns.push_back(std::make_unique<InMemColumn>(fPath, property.dataType));
+        auto column = std::make_unique<InMemColumn>(fPath, property.dataType);
+        if (property.dataType.getLogicalTypeID() == LogicalTypeID::STRING) {
+            column->enableDictionaryEncoding();
+        } else if (ZoneMap::isSupported(property.dataType)) {
+            column->enableZoneMap();
+        }
+        columns.push_back(std::move(column));
     }
 }
 
@@ -140,28 +146,24 @@ void CopyNode::flushChunksAndPopulatePKIndex(
 template<>
 uint64_t CopyNode::appendToPKIndex<int64_t>(
     InMemColumnChunk* chunk, offset_t startOffset, uint64_t numValues) {
+    std::vector<const uint8_t*> keys(numValues);
     for (auto i = 0u; i < numValues; i++) {
-        auto offset = i + startOffset;
-        auto value = chunk->getValue<int64_t>(i);
-        if (!sharedState->pkIndex->append(value, offset)) {
-            return i;
-        }
+        keys[i] = chunk->getData() + i * sizeof(int64_t);
     }
-    return numValues;
+    return sharedState->pkIndex->append(keys, startOffset);
 }
 
 template<>
 uint64_t CopyNode::appendToPKIndex<ku_string_t, InMemOverflowFile*>(InMemColumnChunk* chunk,
     offset_t startOffset, uint64_t numValues, InMemOverflowFile* overflowFile) {
+    std::vector<std::string> keyStrings(numValues);
+    std::vector<const uint8_t*> keys(numValues);
     for (auto i = 0u; i < numValues; i++) {
-        auto offset = i + startOffset;
         auto value = chunk->getValue<ku_string_t>(i);
-        auto key = overflowFile->readString(&value);
-        if (!sharedState->pkIndex->append(key.c_str(), offset)) {
-            return i;
-        }
+        keyStrings[i] = overflowFile->readString(&value);
+        keys[i] = reinterpret_cast<const uint8_t*>(keyStrings[i].c_str());
     }
-    return numValues;
+    return sharedState->pkIndex->append(keys, startOffset);
 }
 
 void CopyNode::populatePKIndex(InMemColumnChunk* chunk, InMemOverflowFile* overflowFile,
@@ -176,24 +178,25 @@ void CopyNode::populatePKIndex(InMemColumnChunk* chunk, InMemOverflowFile* overf
                     (startRowIdxInFile + posInChunk), filePath));
         }
     }
-    // No nulls, so we can populate the index with actual values.
+    // No nulls, so we can populate the index with actual values. The index is partitioned, so
+    // copy threads append their keys in parallel.
     std::string errorPKValueStr;
     row_idx_t errorPKRowIdx = INVALID_ROW_IDX;
-    sharedState->pkIndex->lock();
     switch (chunk->getDataType().getLogicalTypeID()) {
     case LogicalTypeID::INT64: {
-        auto numAppended = appendToPKIndex<int64_t>(chunk, startOffset, numValues);
-        if (numAppended < numValues) {
-            errorPKValueStr = std::to_string(chunk->getValue<int64_t>(startOffset + numAppended));
-            errorPKRowIdx = startRowIdxInFile + numAppended;
+        auto duplicatePos = appendToPKIndex<int64_t>(chunk, startOffset, numValues);
+        if (duplicatePos < numValues) {
+            errorPKValueStr = std::to_string(chunk->getValue<int64_t>(duplicatePos));
+            errorPKRowIdx = startRowIdxInFile + duplicatePos;
         }
     } break;
     case LogicalTypeID::STRING: {
-        auto numAppended = appendToPKIndex<ku_string_t, InMemOverflowFile*>(
+        auto duplicatePos = appendToPKIndex<ku_string_t, InMemOverflowFile*>(
             chunk, startOffset, numValues, overflowFile);
-        if (numAppended < numValues) {
-            errorPKValueStr = chunk->getValue<ku_string_t>(startOffset + numAppended).getAsString();
-            errorPKRowIdx = startRowIdxInFile + numAppended;
+        if (duplicatePos < numValues) {
+            auto value = chunk->getValue<ku_string_t>(duplicatePos);
+            errorPKValueStr = overflowFile->readString(&value);
+            errorPKRowIdx = startRowIdxInFile + duplicatePos;
         }
     } break;
     default: {
@@ -203,7 +206,6 @@ void CopyNode::populatePKIndex(InMemColumnChunk* chunk, InMemOverflowFile* overf
                 LogicalTypeUtils::dataTypeToString(chunk->getDataType())));
     }
     }
-    sharedState->pkIndex->unlock();
     if (!errorPKValueStr.empty()) {
         assert(errorPKRowIdx != INVALID_ROW_IDX);
         throw CopyException(StringUtils::string_format(
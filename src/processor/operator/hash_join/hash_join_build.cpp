@@ -1,5 +1,7 @@
 #include "processor/operator/hash_join/hash_join_build.h"
 
+#include "storage/buffer_manager/buffer_manager.h"
+
 using namespace kuzu::common;
 using namespace kuzu::storage;
 
@@ -11,6 +13,30 @@ void HashJoinSharedState::mergeLocalHashTable(JoinHashTable& localHashTable) {
     hashTable->merge(localHashTable);
 }
 
+uint64_t HashJoinSharedState::acquireSpilledPartition(uint64_t partitionIdx) {
+    std::unique_lock lck{mtx};
+    spilledPartitionReleased.wait(lck, [&] {
+        return loadedPartitionIdx == partitionIdx || numThreadsHoldingLoadedPartition == 0;
+    });
+    numThreadsHoldingLoadedPartition++;
+    if (loadedPartitionIdx == partitionIdx) {
+        return 0;
+    }
+    if (loadedPartitionIdx != UINT64_MAX) {
+        hashTable->unloadSpilledPartition(loadedPartitionIdx);
+    }
+    loadedPartitionIdx = partitionIdx;
+    return hashTable->loadSpilledPartition(partitionIdx);
+}
+
+void HashJoinSharedState::releaseSpilledPartition() {
+    std::unique_lock lck{mtx};
+    // The partition stays loaded until another partition is acquired, so that threads that probe
+    // the same partition later do not load it again.
+    numThreadsHoldingLoadedPartition--;
+    spilledPartitionReleased.notify_all();
+}
+
 void HashJoinBuild::initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) {
     for (auto& pos : info->keysPos) {
         vectorsToAppend.push_back(resultSet->getValueVector(pos).get());
@@ -22,9 +48,18 @@ void HashJoinBuild::initLocalStateInternal(ResultSet* resultSet, ExecutionContex
 }
 
 void HashJoinBuild::finalize(ExecutionContext* context) {
-    auto numTuples = sharedState->getHashTable()->getNumTuples();
-    sharedState->getHashTable()->allocateHashSlots(numTuples);
-    sharedState->getHashTable()->buildHashSlots();
+    auto globalHashTable = sharedState->getHashTable();
+    // Merged tuples are unpinned, so the buffer manager may have spilled them while the build
+    // pipeline was running. The partitions that do not fit in memory stay spilled.
+    auto memoryLimit =
+        (uint64_t)(context->memoryManager->getBufferManager()->getBufferPoolSize() *
+                   BufferPoolConstants::HASH_JOIN_MEMORY_RATIO);
+    auto numBytesSpilled = globalHashTable->pinPartitions(memoryLimit);
+    context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+        ->increase(numBytesSpilled);
+    // The hash slots are built by the HashJoinPartitionTuplesTask and HashJoinBuildSlotsTask that
+    // are scheduled after this pipeline.
+    globalHashTable->allocateHashSlots(globalHashTable->getNumTuples());
 }
 
 void HashJoinBuild::executeInternal(ExecutionContext* context) {
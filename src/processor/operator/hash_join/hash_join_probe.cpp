@@ -31,6 +31,27 @@ void HashJoinProbe::initLocalStateInternal(ResultSet* resultSet, ExecutionContex
         tmpHashVector = std::make_unique<common::ValueVector>(
             common::LogicalTypeID::INT64, context->memoryManager);
     }
+    memoryManager = context->memoryManager;
+    for (auto& dataPos : probeDataInfo.probeSideDataPos) {
+        probeSideVectors.push_back(resultSet->getValueVector(dataPos).get());
+    }
+    probeSideColumnIdxs.resize(probeSideVectors.size());
+    iota(probeSideColumnIdxs.begin(), probeSideColumnIdxs.end(), 0);
+    multiplicityVector =
+        std::make_unique<common::ValueVector>(common::LogicalTypeID::INT64, memoryManager);
+    multiplicityVector->state = DataChunkState::getSingleValueDataChunkState();
+    vectorsToSpill = probeSideVectors;
+    vectorsToSpill.push_back(multiplicityVector.get());
+    spilledTuples.resize(JoinHashTable::getNumSpillPartitions());
+    spilledKeysSelVector = std::make_shared<SelectionVector>(DEFAULT_VECTOR_CAPACITY);
+    spillPartitionIdxes = std::make_unique<uint64_t[]>(DEFAULT_VECTOR_CAPACITY);
+}
+
+HashJoinProbe::~HashJoinProbe() {
+    // A pipeline may stop before all spilled tuples are probed, e.g., under a LIMIT.
+    if (holdsSpilledPartition) {
+        sharedState->releaseSpilledPartition();
+    }
 }
 
 bool HashJoinProbe::getMatchedTuplesForFlatKey(ExecutionContext* context) {
@@ -42,13 +63,9 @@ bool HashJoinProbe::getMatchedTuplesForFlatKey(ExecutionContext* context) {
         // We still need to save and restore for flat input because we are discarding NULL join keys
         // which changes the selected position.
         // TODO(Guodong): we have potential bugs here because all keys' states should be restored.
-        restoreSelVector(keyVectors[0]->state->selVector);
-        if (!children[0]->getNextTuple(context)) {
+        if (!probeNextTuples(context)) {
             return false;
         }
-        saveSelVector(keyVectors[0]->state->selVector);
-        sharedState->getHashTable()->probe(
-            keyVectors, hashVector.get(), tmpHashVector.get(), probeState->probedTuples.get());
     }
     auto numMatchedTuples = 0;
     while (probeState->probedTuples[0]) {
@@ -76,13 +93,9 @@ bool HashJoinProbe::getMatchedTuplesForFlatKey(ExecutionContext* context) {
 bool HashJoinProbe::getMatchedTuplesForUnFlatKey(ExecutionContext* context) {
     assert(keyVectors.size() == 1);
     auto keyVector = keyVectors[0];
-    restoreSelVector(keyVector->state->selVector);
-    if (!children[0]->getNextTuple(context)) {
+    if (!probeNextTuples(context)) {
         return false;
     }
-    saveSelVector(keyVector->state->selVector);
-    sharedState->getHashTable()->probe(
-        keyVectors, hashVector.get(), tmpHashVector.get(), probeState->probedTuples.get());
     auto numMatchedTuples = 0;
     auto keySelVector = keyVector->state->selVector.get();
     for (auto i = 0u; i < keySelVector->selectedSize; i++) {
@@ -105,6 +118,168 @@ bool HashJoinProbe::getMatchedTuplesForUnFlatKey(ExecutionContext* context) {
     return true;
 }
 
+bool HashJoinProbe::probeNextTuples(ExecutionContext* context) {
+    auto hashTable = sharedState->getHashTable();
+    while (true) {
+        restoreSelVector(keyVectors[0]->state->selVector);
+        if (!isProbingSpilledPartitions && !children[0]->getNextTuple(context)) {
+            // Spilled tuples are scanned with the multiplicity they were kept with.
+            isProbingSpilledPartitions = true;
+            resultSet->multiplicity = 1;
+        }
+        if (isProbingSpilledPartitions && !scanNextSpilledTuples(context)) {
+            return false;
+        }
+        saveSelVector(keyVectors[0]->state->selVector);
+        auto hasProbedKeys = hashTable->probe(keyVectors, hashVector.get(), tmpHashVector.get(),
+            probeState->probedTuples.get(), isProbingSpilledPartitions);
+        if (!hasProbedKeys || isProbingSpilledPartitions || !hashTable->hasSpilledPartitions() ||
+            keepTuplesOfSpilledPartitions()) {
+            return true;
+        }
+    }
+}
+
+bool HashJoinProbe::keepTuplesOfSpilledPartitions() {
+    auto hashTable = sharedState->getHashTable();
+    auto hashSelVector = hashVector->state->selVector.get();
+    if (flatProbe) {
+        auto hash = hashVector->getValue<hash_t>(hashSelVector->selectedPositions[0]);
+        if (!hashTable->isPartitionOfHashSpilled(hash)) {
+            return true;
+        }
+        appendToSpilledTuples(JoinHashTable::getSpillPartitionIdx(hash));
+        probeState->probedTuples[0] = nullptr;
+        return false;
+    }
+    // The hash vector shares the state of the only unflat key vector.
+    auto keySelVector = keyVectors[0]->state->selVector;
+    uint64_t spilledPartitionsMask = 0;
+    for (auto i = 0u; i < keySelVector->selectedSize; i++) {
+        auto hash = hashVector->getValue<hash_t>(keySelVector->selectedPositions[i]);
+        spillPartitionIdxes[i] = hashTable->isPartitionOfHashSpilled(hash) ?
+                                     JoinHashTable::getSpillPartitionIdx(hash) :
+                                     UINT64_MAX;
+        if (spillPartitionIdxes[i] != UINT64_MAX) {
+            spilledPartitionsMask |= (uint64_t)1 << spillPartitionIdxes[i];
+        }
+    }
+    if (spilledPartitionsMask == 0) {
+        return true;
+    }
+    // The tuples of each spilled partition are appended by selecting only their positions in the
+    // key data chunk.
+    for (auto partitionIdx = 0u; partitionIdx < spilledTuples.size(); partitionIdx++) {
+        if (!(spilledPartitionsMask & ((uint64_t)1 << partitionIdx))) {
+            continue;
+        }
+        spilledKeysSelVector->resetSelectorToValuePosBufferWithSize(0);
+        for (auto i = 0u; i < keySelVector->selectedSize; i++) {
+            if (spillPartitionIdxes[i] == partitionIdx) {
+                spilledKeysSelVector->selectedPositions[spilledKeysSelVector->selectedSize++] =
+                    keySelVector->selectedPositions[i];
+            }
+        }
+        keyVectors[0]->state->selVector = spilledKeysSelVector;
+        appendToSpilledTuples(partitionIdx);
+    }
+    keyVectors[0]->state->selVector = keySelVector;
+    // Remove the kept tuples from the probed keys, along with their probed tuples.
+    auto numProbedKeys = 0u;
+    auto keySelectedBuffer = keySelVector->getSelectedPositionsBuffer();
+    for (auto i = 0u; i < keySelVector->selectedSize; i++) {
+        if (spillPartitionIdxes[i] == UINT64_MAX) {
+            keySelectedBuffer[numProbedKeys] = keySelVector->selectedPositions[i];
+            probeState->probedTuples[numProbedKeys] = probeState->probedTuples[i];
+            numProbedKeys++;
+        }
+    }
+    keySelVector->selectedSize = numProbedKeys;
+    keySelVector->resetSelectorToValuePosBuffer();
+    return numProbedKeys > 0;
+}
+
+void HashJoinProbe::appendToSpilledTuples(uint64_t partitionIdx) {
+    auto& table = spilledTuples[partitionIdx];
+    if (table == nullptr) {
+        table = std::make_unique<FactorizedTable>(
+            memoryManager, probeDataInfo.probeSideTableSchema->copy());
+    }
+    multiplicityVector->setValue<int64_t>(0, (int64_t)resultSet->multiplicity);
+    table->append(vectorsToSpill);
+    table->unpinFullBlocks();
+}
+
+bool HashJoinProbe::scanNextSpilledTuples(ExecutionContext* context) {
+    while (spilledPartitionIdx < spilledTuples.size()) {
+        auto& table = spilledTuples[spilledPartitionIdx];
+        if (table == nullptr) {
+            spilledPartitionIdx++;
+            continue;
+        }
+        if (!holdsSpilledPartition) {
+            auto numBytesRead = sharedState->acquireSpilledPartition(spilledPartitionIdx);
+            holdsSpilledPartition = true;
+            numBytesRead += table->pinBlocks();
+            context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+                ->increase(numBytesRead);
+            nextSpilledTupleIdx = 0;
+        }
+        if (nextSpilledTupleIdx == table->getNumTuples()) {
+            releaseSpilledPartition();
+            table.reset();
+            spilledPartitionIdx++;
+            continue;
+        }
+        // Tuples are scanned one at a time unless all probe-side vectors are in the unflat key
+        // data chunk, in which case tuples kept with the same multiplicity are scanned together.
+        auto keyDataChunkPos = probeDataInfo.keysDataPos[0].dataChunkPos;
+        auto scanInBatch = !flatProbe && std::all_of(probeDataInfo.probeSideDataPos.begin(),
+                                             probeDataInfo.probeSideDataPos.end(),
+                                             [&](const DataPos& dataPos) {
+                                                 return dataPos.dataChunkPos == keyDataChunkPos;
+                                             });
+        auto multiplicity = getMultiplicityOfSpilledTuple(*table, nextSpilledTupleIdx);
+        auto numTuplesToScan = 1u;
+        while (scanInBatch && numTuplesToScan < DEFAULT_VECTOR_CAPACITY &&
+               nextSpilledTupleIdx + numTuplesToScan < table->getNumTuples() &&
+               getMultiplicityOfSpilledTuple(*table, nextSpilledTupleIdx + numTuplesToScan) ==
+                   multiplicity) {
+            numTuplesToScan++;
+        }
+        auto schema = table->getTableSchema();
+        for (auto i = 0u; i < probeSideVectors.size(); i++) {
+            auto state = probeSideVectors[i]->state.get();
+            auto dataChunkPos = probeDataInfo.probeSideDataPos[i].dataChunkPos;
+            if (schema->getColumn(i)->isFlat() && (flatProbe || dataChunkPos != keyDataChunkPos)) {
+                state->currIdx = 0;
+                state->selVector->resetSelectorToValuePosBufferWithSize(1);
+                state->selVector->selectedPositions[0] = 0;
+            } else {
+                state->currIdx = -1;
+                state->selVector->resetSelectorToUnselected();
+            }
+        }
+        table->scan(probeSideVectors, nextSpilledTupleIdx, numTuplesToScan, probeSideColumnIdxs);
+        nextSpilledTupleIdx += numTuplesToScan;
+        resultSet->multiplicity = multiplicity;
+        return true;
+    }
+    return false;
+}
+
+uint64_t HashJoinProbe::getMultiplicityOfSpilledTuple(
+    FactorizedTable& table, ft_tuple_idx_t tupleIdx) const {
+    auto multiplicityColIdx = table.getTableSchema()->getNumColumns() - 1;
+    return *(uint64_t*)(table.getTuple(tupleIdx) +
+                        table.getTableSchema()->getColOffset(multiplicityColIdx));
+}
+
+void HashJoinProbe::releaseSpilledPartition() {
+    sharedState->releaseSpilledPartition();
+    holdsSpilledPartition = false;
+}
+
 uint64_t HashJoinProbe::getInnerJoinResultForFlatKey() {
     if (probeState->matchedSelVector->selectedSize == 0) {
         return 0;
@@ -9,8 +9,10 @@ namespace kuzu {
 namespace processor {
 
 JoinHashTable::JoinHashTable(MemoryManager& memoryManager, uint64_t numKeyColumns,
-    std::unique_ptr<FactorizedTableSchema> tableSchema)
-    : BaseHashTable{memoryManager}, numKeyColumns{numKeyColumns} {
+    std::unique_ptr<FactorizedTableSchema> tableSchema, bool canSpillPartitions)
+    : BaseHashTable{memoryManager}, numKeyColumns{numKeyColumns}, numPartitionsLog2{0},
+      numSlotsPerPartitionLog2{0}, slotIdxInPartitionMask{0}, nextBlockIdxToPartition{0},
+      nextPartitionIdxToBuild{0}, canSpill{canSpillPartitions} {
     auto numSlotsPerBlock = BufferPoolConstants::PAGE_256KB_SIZE / sizeof(uint8_t*);
     assert(numSlotsPerBlock == nextPowerOfTwo(numSlotsPerBlock));
     numSlotsPerBlockLog2 = std::log2(numSlotsPerBlock);
@@ -39,58 +41,288 @@ void JoinHashTable::append(const std::vector<ValueVector*>& vectorsToAppend) {
     if (!discardNullFromKeys(vectorsToAppend, numKeyColumns)) {
         return;
     }
+    if (!partitionTables.empty()) {
+        appendToPartitions(vectorsToAppend);
+        return;
+    }
+    appendToTable(*factorizedTable, vectorsToAppend);
+    if (canSpill && memoryManager.canSpill() &&
+        factorizedTable->getNumTuples() >= factorizedTable->getNumTuplesPerBlock()) {
+        for (auto i = 0u; i < getNumSpillPartitions(); i++) {
+            partitionTables.push_back(std::make_unique<FactorizedTable>(
+                &memoryManager, factorizedTable->getTableSchema()->copy()));
+            partitionSelVectors.push_back(
+                std::make_shared<SelectionVector>(DEFAULT_VECTOR_CAPACITY));
+        }
+    }
+}
+
+void JoinHashTable::appendToTable(
+    FactorizedTable& table, const std::vector<ValueVector*>& vectors) {
     // TODO(Guodong): use compiling information to remove the for loop.
     auto numTuplesToAppend = 1;
     for (auto i = 0u; i < numKeyColumns; i++) {
         // At most one unFlat key data chunk. If there are multiple unFlat key vectors, they must
         // share the same state.
-        if (!vectorsToAppend[i]->state->isFlat()) {
-            numTuplesToAppend = vectorsToAppend[i]->state->selVector->selectedSize;
+        if (!vectors[i]->state->isFlat()) {
+            numTuplesToAppend = vectors[i]->state->selVector->selectedSize;
             break;
         }
     }
-    auto appendInfos = factorizedTable->allocateFlatTupleBlocks(numTuplesToAppend);
-    for (auto i = 0u; i < vectorsToAppend.size(); i++) {
+    auto appendInfos = table.allocateFlatTupleBlocks(numTuplesToAppend);
+    for (auto i = 0u; i < vectors.size(); i++) {
         auto numAppendedTuples = 0ul;
         for (auto& blockAppendInfo : appendInfos) {
-            factorizedTable->copyVectorToColumn(
-                *vectorsToAppend[i], blockAppendInfo, numAppendedTuples, i);
+            table.copyVectorToColumn(*vectors[i], blockAppendInfo, numAppendedTuples, i);
             numAppendedTuples += blockAppendInfo.numTuplesToAppend;
         }
     }
-    factorizedTable->numTuples += numTuplesToAppend;
+    table.numTuples += numTuplesToAppend;
+}
+
+void JoinHashTable::appendToPartitions(const std::vector<ValueVector*>& vectorsToAppend) {
+    // Keys are either all flat, or they share the state of the only unflat key data chunk.
+    ValueVector* unflatKeyVector = nullptr;
+    for (auto i = 0u; i < numKeyColumns; i++) {
+        if (!vectorsToAppend[i]->state->isFlat()) {
+            unflatKeyVector = vectorsToAppend[i];
+            break;
+        }
+    }
+    std::vector<nodeID_t> keys(numKeyColumns);
+    auto getSpillPartitionIdxOfKeys = [&](sel_t pos) {
+        for (auto i = 0u; i < numKeyColumns; i++) {
+            auto keyVector = vectorsToAppend[i];
+            keys[i] = keyVector->getValue<nodeID_t>(
+                keyVector->state->isFlat() ? keyVector->state->selVector->selectedPositions[0] :
+                                             pos);
+        }
+        return getSpillPartitionIdx(getHash(keys.data()));
+    };
+    if (unflatKeyVector == nullptr) {
+        auto& table = partitionTables[getSpillPartitionIdxOfKeys(0 /* pos */)];
+        appendToTable(*table, vectorsToAppend);
+        table->unpinFullBlocks();
+        return;
+    }
+    for (auto& selVector : partitionSelVectors) {
+        selVector->resetSelectorToValuePosBufferWithSize(0);
+    }
+    auto& keySelVector = unflatKeyVector->state->selVector;
+    for (auto i = 0u; i < keySelVector->selectedSize; i++) {
+        auto pos = keySelVector->selectedPositions[i];
+        auto& selVector = partitionSelVectors[getSpillPartitionIdxOfKeys(pos)];
+        selVector->selectedPositions[selVector->selectedSize++] = pos;
+    }
+    // The keys of each partition are appended by selecting only their positions in the key data
+    // chunk.
+    auto originalSelVector = keySelVector;
+    for (auto partitionIdx = 0u; partitionIdx < partitionTables.size(); partitionIdx++) {
+        if (partitionSelVectors[partitionIdx]->selectedSize == 0) {
+            continue;
+        }
+        keySelVector = partitionSelVectors[partitionIdx];
+        appendToTable(*partitionTables[partitionIdx], vectorsToAppend);
+        partitionTables[partitionIdx]->unpinFullBlocks();
+    }
+    keySelVector = originalSelVector;
+}
+
+void JoinHashTable::merge(JoinHashTable& other) {
+    factorizedTable->merge(*other.factorizedTable);
+    factorizedTable->unpinBlocksExceptLastFlatTupleBlock();
+    for (auto i = 0u; i < other.partitionTables.size(); i++) {
+        if (partitionTables.size() <= i) {
+            partitionTables.push_back(std::make_unique<FactorizedTable>(
+                &memoryManager, factorizedTable->getTableSchema()->copy()));
+        }
+        partitionTables[i]->merge(*other.partitionTables[i]);
+        partitionTables[i]->unpinBlocksExceptLastFlatTupleBlock();
+    }
+}
+
+uint64_t JoinHashTable::getNumTuples() const {
+    auto numTuples = factorizedTable->getNumTuples();
+    for (auto& table : partitionTables) {
+        numTuples += table->getNumTuples();
+    }
+    return numTuples;
+}
+
+uint64_t JoinHashTable::pinPartitions(uint64_t memoryLimit) {
+    auto numBytesRead = factorizedTable->pinBlocks();
+    isPartitionSpilled.assign(partitionTables.size(), false);
+    if (partitionTables.empty()) {
+        return numBytesRead;
+    }
+    // A partition takes the blocks of its tuples and its share of the hash slots, which are at
+    // most 4 slots per tuple.
+    auto getNumBytes = [&](const FactorizedTable& table) {
+        return table.getNumBlocks() * BufferPoolConstants::PAGE_256KB_SIZE +
+               table.getNumTuples() * 4 * sizeof(uint8_t*);
+    };
+    auto numBytesInMemory = getNumBytes(*factorizedTable);
+    for (auto i = 0u; i < partitionTables.size(); i++) {
+        auto& table = partitionTables[i];
+        // Tuples are looked up through factorizedTable, so its columns must not guarantee no
+        // nulls if the columns of any partition contain nulls.
+        factorizedTable->mergeMayContainNulls(*table);
+        auto numBytes = getNumBytes(*table);
+        if (numBytesInMemory + numBytes > memoryLimit) {
+            isPartitionSpilled[i] = true;
+            table->unpinBlocks();
+        } else {
+            numBytesInMemory += numBytes;
+            numBytesRead += table->pinBlocks();
+        }
+    }
+    return numBytesRead;
 }
 
 void JoinHashTable::allocateHashSlots(uint64_t numTuples) {
     maxNumHashSlots = nextPowerOfTwo(numTuples * 2);
+    if (hasSpilledPartitions()) {
+        maxNumHashSlots = std::max(
+            maxNumHashSlots, (uint64_t)1 << (NUM_SPILL_PARTITIONS_LOG2 + numSlotsPerBlockLog2));
+    }
     bitmask = maxNumHashSlots - 1;
+    // Split the hash slots into partitions of at most one block, so each partition fits in cache
+    // while it is being built.
+    auto numSlotsLog2 = maxNumHashSlots == 0 ? 0 : (uint64_t)std::log2(maxNumHashSlots);
+    numPartitionsLog2 = 0;
+    if (numSlotsLog2 > numSlotsPerBlockLog2) {
+        numPartitionsLog2 =
+            std::min(numSlotsLog2 - numSlotsPerBlockLog2, NUM_RADIX_PARTITIONS_LOG2);
+    }
+    numSlotsPerPartitionLog2 = numSlotsLog2 - numPartitionsLog2;
+    nextBlockIdxToPartition = 0;
+    nextPartitionIdxToBuild = 0;
+    slotIdxInPartitionMask =
+        BitmaskUtils::all1sMaskForLeastSignificantBits(numSlotsPerPartitionLog2);
     auto numSlotsPerBlock = (uint64_t)1 << numSlotsPerBlockLog2;
     auto numBlocksNeeded = (maxNumHashSlots + numSlotsPerBlock - 1) / numSlotsPerBlock;
-    while (hashSlotsBlocks.size() < numBlocksNeeded) {
-        hashSlotsBlocks.emplace_back(std::make_unique<DataBlock>(&memoryManager));
+    hashSlotsBlocks.resize(numBlocksNeeded);
+    auto hasSpilled = hasSpilledPartitions();
+    for (auto blockIdx = 0u; blockIdx < numBlocksNeeded; blockIdx++) {
+        // The hash slots of a spilled partition are allocated when the partition is loaded.
+        if (!hasSpilled ||
+            !isPartitionSpilled[blockIdx / (numBlocksNeeded >> NUM_SPILL_PARTITIONS_LOG2)]) {
+            hashSlotsBlocks[blockIdx] = std::make_unique<DataBlock>(&memoryManager);
+        }
+    }
+    tupleBlocksToPartition.clear();
+    for (auto& block : factorizedTable->getTupleDataBlocks()) {
+        tupleBlocksToPartition.push_back(block.get());
+    }
+    for (auto i = 0u; i < partitionTables.size(); i++) {
+        if (hasSpilled && isPartitionSpilled[i]) {
+            continue;
+        }
+        for (auto& block : partitionTables[i]->getTupleDataBlocks()) {
+            tupleBlocksToPartition.push_back(block.get());
+        }
+    }
+}
+
+bool JoinHashTable::partitionTuplesOfNextBlock(
+    std::vector<std::vector<uint8_t*>>& partitionedTuples) {
+    auto blockIdx = nextBlockIdxToPartition++;
+    if (blockIdx >= tupleBlocksToPartition.size()) {
+        return false;
+    }
+    partitionedTuples.resize(getNumRadixPartitions());
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    auto tuple = tupleBlocksToPartition[blockIdx]->getData();
+    for (auto i = 0u; i < tupleBlocksToPartition[blockIdx]->numTuples; i++) {
+        partitionedTuples[getPartitionIdx(getHash((nodeID_t*)tuple), NUM_RADIX_PARTITIONS_LOG2)]
+            .push_back(tuple);
+        tuple += numBytesPerTuple;
+    }
+    return true;
+}
+
+void JoinHashTable::appendPartitionedTuples(
+    std::vector<std::vector<uint8_t*>> partitionedTuples) {
+    if (partitionedTuples.empty()) {
+        return;
+    }
+    std::unique_lock lck{mtx};
+    partitionedTuplesOfThreads.push_back(std::move(partitionedTuples));
+}
+
+bool JoinHashTable::buildHashSlotsOfNextPartition() {
+    auto partitionIdx = nextPartitionIdxToBuild++;
+    if (partitionIdx >= getNumPartitions()) {
+        return false;
     }
+    // Tuples of factorizedTable that are in spilled partitions are inserted when the partitions
+    // are loaded.
+    if (!hasSpilledPartitions() ||
+        !isPartitionSpilled[partitionIdx >> (numPartitionsLog2 - NUM_SPILL_PARTITIONS_LOG2)]) {
+        buildHashSlotsForPartition(partitionIdx);
+    }
+    return true;
 }
 
-void JoinHashTable::buildHashSlots() {
-    for (auto& tupleBlock : factorizedTable->getTupleDataBlocks()) {
-        uint8_t* tuple = tupleBlock->getData();
-        for (auto i = 0u; i < tupleBlock->numTuples; i++) {
-            auto lastSlotEntryInHT = insertEntry(tuple);
-            auto prevPtr = getPrevTuple(tuple);
-            memcpy(prevPtr, &lastSlotEntryInHT, sizeof(uint8_t*));
-            tuple += factorizedTable->getTableSchema()->getNumBytesPerTuple();
+void JoinHashTable::buildHashSlotsForPartition(uint64_t partitionIdx) {
+    auto numRadixPartitionsPerPartition = (uint64_t)1
+                                          << (NUM_RADIX_PARTITIONS_LOG2 - numPartitionsLog2);
+    auto startRadixPartitionIdx = partitionIdx * numRadixPartitionsPerPartition;
+    for (auto& partitionedTuples : partitionedTuplesOfThreads) {
+        for (auto i = startRadixPartitionIdx;
+             i < startRadixPartitionIdx + numRadixPartitionsPerPartition; i++) {
+            for (auto tuple : partitionedTuples[i]) {
+                insertTuple(tuple);
+            }
         }
     }
 }
 
-void JoinHashTable::probe(const std::vector<ValueVector*>& keyVectors,
-    common::ValueVector* hashVector, common::ValueVector* tmpHashVector, uint8_t** probedTuples) {
+uint64_t JoinHashTable::loadSpilledPartition(uint64_t partitionIdx) {
+    assert(isPartitionSpilled[partitionIdx]);
+    auto& table = partitionTables[partitionIdx];
+    auto numBytesRead = table->pinBlocks();
+    auto [startBlockIdx, endBlockIdx] = getHashSlotsBlocksOfSpillPartition(partitionIdx);
+    for (auto blockIdx = startBlockIdx; blockIdx < endBlockIdx; blockIdx++) {
+        hashSlotsBlocks[blockIdx] = std::make_unique<DataBlock>(&memoryManager);
+    }
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    for (auto& block : table->getTupleDataBlocks()) {
+        auto tuple = block->getData();
+        for (auto i = 0u; i < block->numTuples; i++) {
+            insertTuple(tuple);
+            tuple += numBytesPerTuple;
+        }
+    }
+    for (auto& block : factorizedTable->getTupleDataBlocks()) {
+        auto tuple = block->getData();
+        for (auto i = 0u; i < block->numTuples; i++) {
+            if (getSpillPartitionIdx(getHash((nodeID_t*)tuple)) == partitionIdx) {
+                insertTuple(tuple);
+            }
+            tuple += numBytesPerTuple;
+        }
+    }
+    return numBytesRead;
+}
+
+void JoinHashTable::unloadSpilledPartition(uint64_t partitionIdx) {
+    auto [startBlockIdx, endBlockIdx] = getHashSlotsBlocksOfSpillPartition(partitionIdx);
+    for (auto blockIdx = startBlockIdx; blockIdx < endBlockIdx; blockIdx++) {
+        hashSlotsBlocks[blockIdx].reset();
+    }
+    partitionTables[partitionIdx]->unpinBlocks();
+}
+
+bool JoinHashTable::probe(const std::vector<ValueVector*>& keyVectors,
+    common::ValueVector* hashVector, common::ValueVector* tmpHashVector, uint8_t** probedTuples,
+    bool probeSpilledPartition) {
     assert(keyVectors.size() == numKeyColumns);
     if (getNumTuples() == 0) {
-        return;
+        return false;
     }
     if (!discardNullFromKeys(keyVectors, numKeyColumns)) {
-        return;
+        return false;
     }
     function::VectorHashFunction::computeHash(keyVectors[0], hashVector);
     for (auto i = 1u; i < numKeyColumns; i++) {
@@ -99,11 +331,15 @@ void JoinHashTable::probe(const std::vector<ValueVector*>& keyVectors,
     }
     for (auto i = 0u; i < hashVector->state->selVector->selectedSize; i++) {
         auto pos = hashVector->state->selVector->selectedPositions[i];
-        probedTuples[i] = getTupleForHash(hashVector->getValue<hash_t>(pos));
+        auto hash = hashVector->getValue<hash_t>(pos);
+        probedTuples[i] = !probeSpilledPartition && isPartitionOfHashSpilled(hash) ?
+                              nullptr :
+                              getTupleForHash(hash);
     }
+    return true;
 }
 
-uint8_t** JoinHashTable::findHashSlot(nodeID_t* nodeIDs) const {
+hash_t JoinHashTable::getHash(const nodeID_t* nodeIDs) const {
     hash_t hash;
     function::Hash::operation<nodeID_t>(nodeIDs[0], false /* isNull */, hash);
     for (auto i = 1u; i < numKeyColumns; i++) {
@@ -111,7 +347,11 @@ uint8_t** JoinHashTable::findHashSlot(nodeID_t* nodeIDs) const {
         function::Hash::operation<nodeID_t>(nodeIDs[i], false /* isNull */, newHash);
         function::CombineHash::operation(hash, newHash, hash);
     }
-    auto slotIdx = getSlotIdxForHash(hash);
+    return hash;
+}
+
+uint8_t** JoinHashTable::findHashSlot(nodeID_t* nodeIDs) const {
+    auto slotIdx = getPartitionedSlotIdxForHash(getHash(nodeIDs));
     return (uint8_t**)(hashSlotsBlocks[slotIdx >> numSlotsPerBlockLog2]->getData() +
                        (slotIdx & slotIdxInBlockMask) * sizeof(uint8_t*));
 }
@@ -11,6 +11,7 @@ void IndexScan::initLocalStateInternal(ResultSet* resultSet, ExecutionContext* c
     assert(indexDataPos.dataChunkPos == outDataPos.dataChunkPos);
     indexVector = resultSet->getValueVector(indexDataPos);
     outVector = resultSet->getValueVector(outDataPos);
+    nodeOffsets = std::make_unique<offset_t[]>(DEFAULT_VECTOR_CAPACITY);
 }
 
 bool IndexScan::getNextTuplesInternal(ExecutionContext* context) {
@@ -22,12 +23,12 @@ bool IndexScan::getNextTuplesInternal(ExecutionContext* context) {
         }
         saveSelVector(outVector->state->selVector);
         numSelectedValues = 0u;
+        pkIndex->lookup(transaction, indexVector.get(), nodeOffsets.get());
         for (auto i = 0; i < indexVector->state->selVector->selectedSize; ++i) {
             auto pos = indexVector->state->selVector->selectedPositions[i];
             outVector->state->selVector->getSelectedPositionsBuffer()[numSelectedValues] = pos;
-            offset_t nodeOffset = INVALID_OFFSET;
-            numSelectedValues += pkIndex->lookup(transaction, indexVector.get(), pos, nodeOffset);
-            nodeID_t nodeID{nodeOffset, tableID};
+            numSelectedValues += nodeOffsets[pos] != INVALID_OFFSET;
+            nodeID_t nodeID{nodeOffsets[pos], tableID};
             outVector->setValue<nodeID_t>(pos, nodeID);
         }
         if (!outVector->state->isFlat() && outVector->state->selVector->isUnfiltered()) {
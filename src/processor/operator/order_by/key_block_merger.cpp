@@ -16,8 +16,11 @@ MergedKeyBlocks::MergedKeyBlocks(
       numTuples{numTuples}, endTupleOffset{numTuplesPerBlock * numBytesPerTuple} {
     auto numKeyBlocks = numTuples / numTuplesPerBlock + (numTuples % numTuplesPerBlock ? 1 : 0);
     for (auto i = 0u; i < numKeyBlocks; i++) {
-        keyBlocks.emplace_back(std::make_shared<DataBlock>(memoryManager));
+        auto keyBlock = std::make_shared<DataBlock>(memoryManager);
+        keyBlock->unpin();
+        keyBlocks.emplace_back(std::move(keyBlock));
     }
+    numPinsPerBlock.resize(keyBlocks.size(), 0);
 }
 
 // This constructor is used to convert a keyBlock to a MergedKeyBlocks.
@@ -25,7 +28,36 @@ MergedKeyBlocks::MergedKeyBlocks(uint32_t numBytesPerTuple, std::shared_ptr<Data
     : numBytesPerTuple{numBytesPerTuple},
       numTuplesPerBlock{(uint32_t)(BufferPoolConstants::PAGE_256KB_SIZE / numBytesPerTuple)},
       numTuples{keyBlock->numTuples}, endTupleOffset{numTuplesPerBlock * numBytesPerTuple} {
+    keyBlock->unpin();
     keyBlocks.emplace_back(keyBlock);
+    numPinsPerBlock.resize(1, 0);
+}
+
+uint64_t MergedKeyBlocks::pinBlocks(uint64_t startTupleIdx, uint64_t endTupleIdx) {
+    uint64_t numBytesRead = 0;
+    if (startTupleIdx >= endTupleIdx) {
+        return numBytesRead;
+    }
+    for (auto blockIdx = startTupleIdx / numTuplesPerBlock;
+         blockIdx <= (endTupleIdx - 1) / numTuplesPerBlock; blockIdx++) {
+        if (numPinsPerBlock[blockIdx]++ == 0) {
+            numBytesRead += keyBlocks[blockIdx]->pin();
+        }
+    }
+    return numBytesRead;
+}
+
+void MergedKeyBlocks::unpinBlocks(uint64_t startTupleIdx, uint64_t endTupleIdx) {
+    if (startTupleIdx >= endTupleIdx) {
+        return;
+    }
+    for (auto blockIdx = startTupleIdx / numTuplesPerBlock;
+         blockIdx <= (endTupleIdx - 1) / numTuplesPerBlock; blockIdx++) {
+        assert(numPinsPerBlock[blockIdx] > 0);
+        if (--numPinsPerBlock[blockIdx] == 0) {
+            keyBlocks[blockIdx]->unpin();
+        }
+    }
 }
 
 uint8_t* MergedKeyBlocks::getBlockEndTuplePtr(
@@ -38,6 +70,121 @@ uint8_t* MergedKeyBlocks::getBlockEndTuplePtr(
                                           getKeyBlockBuffer(blockIdx) + endTupleOffset;
 }
 
+SortedRunWriter::SortedRunWriter(MemoryManager* memoryManager,
+    const FactorizedTableSchema& payloadTableSchema, const std::vector<LogicalType>& payloadTypes,
+    uint32_t numBytesPerTuple, uint64_t numTuples)
+    : memoryManager{memoryManager}, payloadTableSchema{payloadTableSchema},
+      sortedRun{std::make_shared<SortedRun>(
+          std::make_shared<MergedKeyBlocks>(numBytesPerTuple, numTuples, memoryManager))},
+      numBytesPerTuple{numBytesPerTuple}, numTuplesAppended{0}, copySingleTuple{false},
+      numBytesSpilled{0} {
+    assert(payloadTypes.size() == payloadTableSchema.getNumColumns());
+    for (auto i = 0u; i < payloadTableSchema.getNumColumns(); i++) {
+        copySingleTuple |= !payloadTableSchema.getColumn(i)->isFlat();
+    }
+    // Each unflat column is read into a vector of its own state. Flat columns are read into
+    // vectors sharing a state, which is flat if tuples are copied one at a time.
+    auto flatColsState = copySingleTuple ? DataChunkState::getSingleValueDataChunkState() :
+                                           std::make_shared<DataChunkState>();
+    for (auto i = 0u; i < payloadTypes.size(); i++) {
+        auto vector = std::make_unique<ValueVector>(payloadTypes[i], memoryManager);
+        vector->state = payloadTableSchema.getColumn(i)->isFlat() ?
+                            flatColsState :
+                            std::make_shared<DataChunkState>();
+        payloadVectorsToCopy.push_back(vector.get());
+        payloadVectors.push_back(std::move(vector));
+        payloadColIdxes.push_back(i);
+    }
+}
+
+void SortedRunWriter::append(const uint8_t* keyTuplePtr, uint8_t* payloadTuple) {
+    auto& keyBlocks = *sortedRun->keyBlocks;
+    assert(numTuplesAppended < keyBlocks.getNumTuples());
+    if (numTuplesAppended % keyBlocks.getNumTuplesPerBlock() == 0) {
+        if (numTuplesAppended > 0) {
+            keyBlocks.unpinBlocks(numTuplesAppended - 1, numTuplesAppended);
+        }
+        numBytesSpilled += keyBlocks.pinBlocks(numTuplesAppended, numTuplesAppended + 1);
+    }
+    memcpy(keyBlocks.getTuple(numTuplesAppended), keyTuplePtr, numBytesPerTuple);
+    numTuplesAppended++;
+    payloadTuplesToCopy.push_back(payloadTuple);
+    if (payloadTuplesToCopy.size() == (copySingleTuple ? 1 : DEFAULT_VECTOR_CAPACITY)) {
+        flushPayloads();
+    }
+}
+
+void SortedRunWriter::flushPayloads() {
+    uint64_t numTuplesCopied = 0;
+    while (numTuplesCopied < payloadTuplesToCopy.size()) {
+        auto& payloadTable = getPayloadTableToAppend();
+        auto numTuplesLeftInTable =
+            payloadTable.getNumTuplesPerBlock() - payloadTable.getNumTuples();
+        auto numTuplesToCopy =
+            copySingleTuple ?
+                1 :
+                std::min(payloadTuplesToCopy.size() - numTuplesCopied, numTuplesLeftInTable);
+        payloadTable.lookup(payloadVectorsToCopy, payloadColIdxes, payloadTuplesToCopy.data(),
+            numTuplesCopied, numTuplesToCopy);
+        payloadTable.append(payloadVectorsToCopy);
+        numTuplesCopied += numTuplesToCopy;
+    }
+    payloadTuplesToCopy.clear();
+}
+
+std::shared_ptr<SortedRun> SortedRunWriter::finish() {
+    assert(numTuplesAppended > 0 && numTuplesAppended == sortedRun->getNumTuples());
+    flushPayloads();
+    sortedRun->keyBlocks->unpinBlocks(numTuplesAppended - 1, numTuplesAppended);
+    sortedRun->payloadTables.back()->unpinBlocks();
+    return std::move(sortedRun);
+}
+
+FactorizedTable& SortedRunWriter::getPayloadTableToAppend() {
+    auto& payloadTables = sortedRun->payloadTables;
+    if (!payloadTables.empty()) {
+        auto& payloadTable = *payloadTables.back();
+        if (payloadTable.getNumTuples() < payloadTable.getNumTuplesPerBlock() &&
+            payloadTable.getNumBlocks() < SortedRun::MAX_NUM_BLOCKS_PER_PAYLOAD_TABLE) {
+            return payloadTable;
+        }
+        payloadTable.unpinBlocks();
+    }
+    payloadTables.push_back(
+        std::make_unique<FactorizedTable>(memoryManager, payloadTableSchema.copy()));
+    return *payloadTables.back();
+}
+
+SortedRunReader::SortedRunReader(std::shared_ptr<SortedRun> sortedRun)
+    : sortedRun{std::move(sortedRun)}, nextTupleIdx{0}, payloadTableIdx{0},
+      nextTupleIdxInPayloadTable{0}, numBytesSpilled{0} {
+    if (hasMoreTuples()) {
+        numBytesSpilled += this->sortedRun->keyBlocks->pinBlocks(0, 1);
+        numBytesSpilled += this->sortedRun->payloadTables[0]->pinBlocks();
+    }
+}
+
+void SortedRunReader::moveToNextTuple() {
+    assert(hasMoreTuples());
+    auto& keyBlocks = *sortedRun->keyBlocks;
+    nextTupleIdx++;
+    if (nextTupleIdx % keyBlocks.getNumTuplesPerBlock() == 0 || !hasMoreTuples()) {
+        keyBlocks.unpinBlocks(nextTupleIdx - 1, nextTupleIdx);
+        if (hasMoreTuples()) {
+            numBytesSpilled += keyBlocks.pinBlocks(nextTupleIdx, nextTupleIdx + 1);
+        }
+    }
+    auto& payloadTables = sortedRun->payloadTables;
+    if (++nextTupleIdxInPayloadTable == payloadTables[payloadTableIdx]->getNumTuples()) {
+        payloadTables[payloadTableIdx]->unpinBlocks();
+        payloadTableIdx++;
+        nextTupleIdxInPayloadTable = 0;
+        if (hasMoreTuples()) {
+            numBytesSpilled += payloadTables[payloadTableIdx]->pinBlocks();
+        }
+    }
+}
+
 void BlockPtrInfo::updateTuplePtrIfNecessary() {
     if (curTuplePtr == curBlockEndTuplePtr) {
         curBlockIdx++;
@@ -59,12 +206,10 @@ uint64_t KeyBlockMergeTask::findRightKeyBlockIdx(uint8_t* leftEndTuplePtr) {
 
     while (startIdx <= endIdx) {
         uint64_t curTupleIdx = (startIdx + endIdx) / 2;
-        uint8_t* curTuplePtr = rightKeyBlock->getTuple(curTupleIdx);
 
-        if (keyBlockMerger.compareTuplePtr(leftEndTuplePtr, curTuplePtr)) {
+        if (isLeftEndTupleLarger(leftEndTuplePtr, curTupleIdx)) {
             if (curTupleIdx == rightKeyBlock->getNumTuples() - 1 ||
-                !keyBlockMerger.compareTuplePtr(
-                    leftEndTuplePtr, rightKeyBlock->getTuple(curTupleIdx + 1))) {
+                !isLeftEndTupleLarger(leftEndTuplePtr, curTupleIdx + 1)) {
                 // If the current tuple is the last tuple or the value of next tuple is larger than
                 // the value of leftEndTuple, return the curTupleIdx.
                 return curTupleIdx;
@@ -79,6 +224,14 @@ uint64_t KeyBlockMergeTask::findRightKeyBlockIdx(uint8_t* leftEndTuplePtr) {
     return -1;
 }
 
+bool KeyBlockMergeTask::isLeftEndTupleLarger(uint8_t* leftEndTuplePtr, uint64_t rightTupleIdx) {
+    numBytesSpilled += rightKeyBlock->pinBlocks(rightTupleIdx, rightTupleIdx + 1);
+    auto result =
+        keyBlockMerger.compareTuplePtr(leftEndTuplePtr, rightKeyBlock->getTuple(rightTupleIdx));
+    rightKeyBlock->unpinBlocks(rightTupleIdx, rightTupleIdx + 1);
+    return result;
+}
+
 std::unique_ptr<KeyBlockMergeMorsel> KeyBlockMergeTask::getMorsel() {
     // We grab a batch of tuples from the left memory block, then do a binary search on the
     // right memory block to find the range of tuples to merge.
@@ -106,8 +259,10 @@ std::unique_ptr<KeyBlockMergeMorsel> KeyBlockMergeTask::getMorsel() {
         return keyBlockMergeMorsel;
     } else {
         // Conduct a binary search to find the ending index in the right memory block.
-        auto leftEndIdxPtr = leftKeyBlock->getTuple(leftKeyBlockNextIdx - 1);
-        auto rightEndIdx = findRightKeyBlockIdx(leftEndIdxPtr);
+        auto leftEndIdx = leftKeyBlockNextIdx - 1;
+        numBytesSpilled += leftKeyBlock->pinBlocks(leftEndIdx, leftEndIdx + 1);
+        auto rightEndIdx = findRightKeyBlockIdx(leftKeyBlock->getTuple(leftEndIdx));
+        leftKeyBlock->unpinBlocks(leftEndIdx, leftEndIdx + 1);
 
         auto keyBlockMergeMorsel = std::make_unique<KeyBlockMergeMorsel>(leftKeyBlockStartIdx,
             std::min(leftKeyBlockNextIdx, leftKeyBlock->getNumTuples()), rightKeyBlockNextIdx,
@@ -163,10 +318,53 @@ void KeyBlockMerger::mergeKeyBlocks(KeyBlockMergeMorsel& keyBlockMergeMorsel) co
     copyRemainingBlockDataToResult(leftBlockPtrInfo, resultBlockPtrInfo);
 }
 
+uint64_t KeyBlockMerger::mergeSortedRuns(
+    const std::vector<std::shared_ptr<SortedRun>>& sortedRuns, SortedRunWriter& writer) const {
+    // The heap keeps the reader of the smallest tuple at its top.
+    auto isLarger = [&](SortedRunReader* left, SortedRunReader* right) {
+        return compareTuplePtr(left->getKeyTuplePtr(), right->getKeyTuplePtr(),
+            left->getPayloadTuple(), right->getPayloadTuple());
+    };
+    std::priority_queue<SortedRunReader*, std::vector<SortedRunReader*>, decltype(isLarger)> heap{
+        isLarger};
+    std::vector<std::unique_ptr<SortedRunReader>> readers;
+    for (auto& sortedRun : sortedRuns) {
+        readers.push_back(std::make_unique<SortedRunReader>(sortedRun));
+        if (readers.back()->hasMoreTuples()) {
+            heap.push(readers.back().get());
+        }
+    }
+    while (!heap.empty()) {
+        auto reader = heap.top();
+        heap.pop();
+        writer.append(reader->getKeyTuplePtr(), reader->getPayloadTuple());
+        if (reader->isLastTupleInPayloadTable()) {
+            // The reader unpins its payload table when it moves to the next tuple, so the payload
+            // tuples buffered by the writer are copied before.
+            writer.flushPayloads();
+        }
+        reader->moveToNextTuple();
+        if (reader->hasMoreTuples()) {
+            heap.push(reader);
+        }
+    }
+    uint64_t numBytesSpilled = 0;
+    for (auto& reader : readers) {
+        numBytesSpilled += reader->getNumBytesSpilled();
+    }
+    return numBytesSpilled;
+}
+
 // This function returns true if the value in the leftTuplePtr is larger than the value in the
 // rightTuplePtr.
 bool KeyBlockMerger::compareTuplePtrWithStringCol(
     uint8_t* leftTuplePtr, uint8_t* rightTuplePtr) const {
+    return compareTuplePtrWithStringCol(leftTuplePtr, rightTuplePtr,
+        nullptr /* leftPayloadTuple */, nullptr /* rightPayloadTuple */);
+}
+
+bool KeyBlockMerger::compareTuplePtrWithStringCol(uint8_t* leftTuplePtr, uint8_t* rightTuplePtr,
+    uint8_t* leftPayloadTuple, uint8_t* rightPayloadTuple) const {
     // We can't simply use memcmp to compare tuples if there are string columns.
     // We should only compare the binary strings starting from the last compared string column
     // till the next string column.
@@ -204,22 +402,15 @@ bool KeyBlockMerger::compareTuplePtrWithStringCol(
                 return !strKeyColInfo.isAscOrder;
             }
 
-            auto leftTupleInfo = leftTuplePtr + numBytesToCompare;
-            auto rightTupleInfo = rightTuplePtr + numBytesToCompare;
-            auto leftBlockIdx = OrderByKeyEncoder::getEncodedFTBlockIdx(leftTupleInfo);
-            auto leftBlockOffset = OrderByKeyEncoder::getEncodedFTBlockOffset(leftTupleInfo);
-            auto rightBlockIdx = OrderByKeyEncoder::getEncodedFTBlockIdx(rightTupleInfo);
-            auto rightBlockOffset = OrderByKeyEncoder::getEncodedFTBlockOffset(rightTupleInfo);
-
-            auto& leftFactorizedTable =
-                factorizedTables[OrderByKeyEncoder::getEncodedFTIdx(leftTupleInfo)];
-            auto& rightFactorizedTable =
-                factorizedTables[OrderByKeyEncoder::getEncodedFTIdx(rightTupleInfo)];
+            if (leftPayloadTuple == nullptr) {
+                leftPayloadTuple = getPayloadTuple(leftTuplePtr);
+            }
+            if (rightPayloadTuple == nullptr) {
+                rightPayloadTuple = getPayloadTuple(rightTuplePtr);
+            }
             uint8_t result;
-            auto leftStr = leftFactorizedTable->getData<ku_string_t>(
-                leftBlockIdx, leftBlockOffset, strKeyColInfo.colOffsetInFT);
-            auto rightStr = rightFactorizedTable->getData<ku_string_t>(
-                rightBlockIdx, rightBlockOffset, strKeyColInfo.colOffsetInFT);
+            auto leftStr = *(ku_string_t*)(leftPayloadTuple + strKeyColInfo.colOffsetInFT);
+            auto rightStr = *(ku_string_t*)(rightPayloadTuple + strKeyColInfo.colOffsetInFT);
             result = (leftStr == rightStr);
             if (result) {
                 // If the tie can't be solved, we need to check the next string column.
@@ -237,6 +428,15 @@ bool KeyBlockMerger::compareTuplePtrWithStringCol(
     return false;
 }
 
+uint8_t* KeyBlockMerger::getPayloadTuple(uint8_t* tuplePtr) const {
+    auto tupleInfo = tuplePtr + numBytesToCompare;
+    auto& factorizedTable = factorizedTables[OrderByKeyEncoder::getEncodedFTIdx(tupleInfo)];
+    auto blockIdx = OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfo);
+    auto blockOffset = OrderByKeyEncoder::getEncodedFTBlockOffset(tupleInfo);
+    return factorizedTable->getTuple(
+        blockIdx * factorizedTable->getNumTuplesPerBlock() + blockOffset);
+}
+
 void KeyBlockMerger::copyRemainingBlockDataToResult(
     BlockPtrInfo& blockToCopy, BlockPtrInfo& resultBlock) const {
     while (blockToCopy.curBlockIdx <= blockToCopy.endBlockIdx) {
@@ -262,6 +462,7 @@ std::unique_ptr<KeyBlockMergeMorsel> KeyBlockMergeTaskDispatcher::getMorsel() {
         // If there are morsels left in the lastMergeTask, just give it to the caller.
         auto morsel = activeKeyBlockMergeTasks.back()->getMorsel();
         morsel->keyBlockMergeTask = activeKeyBlockMergeTasks.back();
+        pinKeyBlocks(*morsel);
         return morsel;
     } else if (sortedKeyBlocks->size() > 1) {
         // If there are no morsels left in the lastMergeTask, we just create a new merge task.
@@ -276,6 +477,7 @@ std::unique_ptr<KeyBlockMergeMorsel> KeyBlockMergeTaskDispatcher::getMorsel() {
         activeKeyBlockMergeTasks.emplace_back(newMergeTask);
         auto morsel = newMergeTask->getMorsel();
         morsel->keyBlockMergeTask = newMergeTask;
+        pinKeyBlocks(*morsel);
         return morsel;
     } else {
         // There is no morsel can be given at this time, just wait for the ongoing merge
@@ -286,22 +488,74 @@ std::unique_ptr<KeyBlockMergeMorsel> KeyBlockMergeTaskDispatcher::getMorsel() {
 
 void KeyBlockMergeTaskDispatcher::doneMorsel(std::unique_ptr<KeyBlockMergeMorsel> morsel) {
     std::lock_guard<std::mutex> keyBlockMergeDispatcherLock{mtx};
+    unpinKeyBlocks(*morsel);
     // If there is no active and morsels left tin the keyBlockMergeTask, just remove it from
     // the active keyBlockMergeTask and add the result key block to the sortedKeyBlocks queue.
     if ((--morsel->keyBlockMergeTask->activeMorsels) == 0 &&
         !morsel->keyBlockMergeTask->hasMorselLeft()) {
+        numBytesSpilled += morsel->keyBlockMergeTask->numBytesSpilled;
         erase(activeKeyBlockMergeTasks, morsel->keyBlockMergeTask);
         sortedKeyBlocks->emplace(morsel->keyBlockMergeTask->resultKeyBlock);
     }
 }
 
+std::vector<std::shared_ptr<SortedRun>> KeyBlockMergeTaskDispatcher::getSortedRunsToMerge() {
+    std::lock_guard<std::mutex> keyBlockMergeDispatcherLock{mtx};
+    std::vector<std::shared_ptr<SortedRun>> sortedRunsToMerge;
+    auto numRunsToMerge = std::min(
+        (uint64_t)sortedRuns->size(), maxNumSortedRunsToMerge - numSortedRunsBeingMerged);
+    if (numRunsToMerge < 2) {
+        return sortedRunsToMerge;
+    }
+    for (auto i = 0u; i < numRunsToMerge; i++) {
+        sortedRunsToMerge.push_back(std::move(sortedRuns->front()));
+        sortedRuns->pop();
+    }
+    numSortedRunsBeingMerged += numRunsToMerge;
+    return sortedRunsToMerge;
+}
+
+void KeyBlockMergeTaskDispatcher::doneSortedRunsMerge(std::shared_ptr<SortedRun> mergedRun,
+    uint64_t numRunsMerged, uint64_t numBytesSpilledOfMerge) {
+    std::lock_guard<std::mutex> keyBlockMergeDispatcherLock{mtx};
+    assert(numSortedRunsBeingMerged >= numRunsMerged);
+    numSortedRunsBeingMerged -= numRunsMerged;
+    numBytesSpilled += numBytesSpilledOfMerge;
+    sortedRuns->emplace(std::move(mergedRun));
+}
+
+void KeyBlockMergeTaskDispatcher::pinKeyBlocks(KeyBlockMergeMorsel& morsel) {
+    auto& task = *morsel.keyBlockMergeTask;
+    numBytesSpilled +=
+        task.leftKeyBlock->pinBlocks(morsel.leftKeyBlockStartIdx, morsel.leftKeyBlockEndIdx);
+    numBytesSpilled +=
+        task.rightKeyBlock->pinBlocks(morsel.rightKeyBlockStartIdx, morsel.rightKeyBlockEndIdx);
+    numBytesSpilled += task.resultKeyBlock->pinBlocks(
+        morsel.leftKeyBlockStartIdx + morsel.rightKeyBlockStartIdx,
+        morsel.leftKeyBlockEndIdx + morsel.rightKeyBlockEndIdx);
+}
+
+void KeyBlockMergeTaskDispatcher::unpinKeyBlocks(KeyBlockMergeMorsel& morsel) {
+    auto& task = *morsel.keyBlockMergeTask;
+    task.leftKeyBlock->unpinBlocks(morsel.leftKeyBlockStartIdx, morsel.leftKeyBlockEndIdx);
+    task.rightKeyBlock->unpinBlocks(morsel.rightKeyBlockStartIdx, morsel.rightKeyBlockEndIdx);
+    task.resultKeyBlock->unpinBlocks(morsel.leftKeyBlockStartIdx + morsel.rightKeyBlockStartIdx,
+        morsel.leftKeyBlockEndIdx + morsel.rightKeyBlockEndIdx);
+}
+
 void KeyBlockMergeTaskDispatcher::init(MemoryManager* memoryManager,
     std::shared_ptr<std::queue<std::shared_ptr<MergedKeyBlocks>>> sortedKeyBlocks,
+    std::shared_ptr<std::queue<std::shared_ptr<SortedRun>>> sortedRuns,
     std::vector<std::shared_ptr<FactorizedTable>>& factorizedTables,
-    std::vector<StrKeyColInfo>& strKeyColsInfo, uint64_t numBytesPerTuple) {
+    std::vector<StrKeyColInfo>& strKeyColsInfo, uint64_t numBytesPerTuple,
+    uint64_t memoryBudget) {
     assert(this->keyBlockMerger == nullptr);
     this->memoryManager = memoryManager;
     this->sortedKeyBlocks = sortedKeyBlocks;
+    this->sortedRuns = sortedRuns;
+    // One reader or writer of the budget is left for the writer of the merge.
+    this->maxNumSortedRunsToMerge =
+        std::max((uint64_t)3, memoryBudget / SortedRun::NUM_BYTES_TO_READ_OR_WRITE) - 1;
     this->keyBlockMerger =
         std::make_unique<KeyBlockMerger>(factorizedTables, strKeyColsInfo, numBytesPerTuple);
 }
@@ -1,11 +1,27 @@
 #include "processor/operator/order_by/order_by.h"
 
+#include "storage/buffer_manager/buffer_manager.h"
+
 using namespace kuzu::common;
+using namespace kuzu::storage;
 
 namespace kuzu {
 namespace processor {
 
 void OrderBy::initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) {
+    initLocalFactorizedTableAndEncoder(resultSet, context);
+    radixSorter = std::make_unique<RadixSort>(context->memoryManager, *localFactorizedTable,
+        *orderByKeyEncoder, sharedState->strKeyColsInfo);
+    memoryBudget = getMemoryBudget(context) / context->numThreads;
+}
+
+uint64_t OrderBy::getMemoryBudget(ExecutionContext* context) {
+    return std::min(context->clientContext->getOrderByMemoryBudget(),
+        (uint64_t)(context->memoryManager->getBufferManager()->getBufferPoolSize() *
+                   BufferPoolConstants::ORDER_BY_MEMORY_RATIO));
+}
+
+void OrderBy::initLocalFactorizedTableAndEncoder(ResultSet* resultSet, ExecutionContext* context) {
     for (auto [dataPos, _] : orderByDataInfo.payloadsPosAndType) {
         auto vector = resultSet->getValueVector(dataPos);
         vectorsToAppend.push_back(vector.get());
@@ -24,8 +40,6 @@ void OrderBy::initLocalStateInternal(ResultSet* resultSet, ExecutionContext* con
     orderByKeyEncoder = std::make_unique<OrderByKeyEncoder>(keyVectors, orderByDataInfo.isAscOrder,
         context->memoryManager, factorizedTableIdx, localFactorizedTable->getNumTuplesPerBlock(),
         sharedState->numBytesPerTuple);
-    radixSorter = std::make_unique<RadixSort>(context->memoryManager, *localFactorizedTable,
-        *orderByKeyEncoder, sharedState->strKeyColsInfo);
 }
 
 std::unique_ptr<FactorizedTableSchema> OrderBy::populateTableSchema() {
@@ -70,6 +84,13 @@ void OrderBy::initGlobalStateInternal(kuzu::processor::ExecutionContext* context
     // TODO(Ziyi): comment about +8
     auto numBytesPerTuple = encodedKeyBlockColOffset + 8;
     sharedState->setNumBytesPerTuple(numBytesPerTuple);
+    for (auto i = 0u; i < tableSchema->getNumColumns(); i++) {
+        tableSchema->setMayContainsNullsToTrue(i);
+    }
+    sharedState->payloadTableSchema = std::move(tableSchema);
+    for (auto& [_, dataType] : orderByDataInfo.payloadsPosAndType) {
+        sharedState->payloadTypes.push_back(dataType);
+    }
 }
 
 void OrderBy::executeInternal(ExecutionContext* context) {
@@ -86,6 +107,11 @@ void OrderBy::executeInternal(ExecutionContext* context) {
             // factorized table if and only if its corresponding vector is flat.
             localFactorizedTable->append(vectorsToAppend);
         }
+        if ((localFactorizedTable->getNumBlocks() + orderByKeyEncoder->getKeyBlocks().size()) *
+                BufferPoolConstants::PAGE_256KB_SIZE >
+            memoryBudget) {
+            writeSortedRuns(context);
+        }
     }
     for (auto& keyBlock : orderByKeyEncoder->getKeyBlocks()) {
         if (keyBlock->numTuples > 0) {
@@ -94,6 +120,85 @@ void OrderBy::executeInternal(ExecutionContext* context) {
                 make_shared<MergedKeyBlocks>(orderByKeyEncoder->getNumBytesPerTuple(), keyBlock));
         }
     }
+    localFactorizedTable->unpinBlocks();
+}
+
+void OrderBy::writeSortedRuns(ExecutionContext* context) {
+    uint64_t numBytesSpilled = 0;
+    for (auto& keyBlock : orderByKeyEncoder->getKeyBlocks()) {
+        if (keyBlock->numTuples > 0) {
+            radixSorter->sortSingleKeyBlock(*keyBlock);
+            numBytesSpilled += writeSortedRun(keyBlock->getData(), keyBlock->numTuples,
+                *localFactorizedTable, context->memoryManager);
+        }
+    }
+    localFactorizedTable->clear();
+    orderByKeyEncoder->clear();
+    context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+        ->increase(numBytesSpilled);
+}
+
+uint64_t OrderBy::writeSortedRun(const uint8_t* keys, uint64_t numTuples,
+    FactorizedTable& factorizedTable, MemoryManager* memoryManager) {
+    auto numBytesPerTuple = sharedState->numBytesPerTuple;
+    SortedRunWriter writer{memoryManager, *sharedState->payloadTableSchema,
+        sharedState->payloadTypes, numBytesPerTuple, numTuples};
+    for (auto i = 0u; i < numTuples; i++) {
+        auto keyTuplePtr = keys + i * numBytesPerTuple;
+        auto tupleInfo = keyTuplePtr + numBytesPerTuple - 8;
+        auto payloadTuple = factorizedTable.getTuple(
+            OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfo) *
+                factorizedTable.getNumTuplesPerBlock() +
+            OrderByKeyEncoder::getEncodedFTBlockOffset(tupleInfo));
+        writer.append(keyTuplePtr, payloadTuple);
+    }
+    sharedState->appendSortedRun(writer.finish());
+    return writer.getNumBytesSpilled();
+}
+
+void OrderBy::finalize(ExecutionContext* context) {
+    // TODO(Ziyi): we always call lookup function on the first factorizedTable in sharedState
+    // and that lookup function may read tuples in other factorizedTable, So we need to combine
+    // hasNoNullGuarantee with other factorizedTables. This is not a good way to solve this
+    // problem, and should be changed later.
+    sharedState->combineFTHasNoNullGuarantee();
+    if (sharedState->isExternalSort()) {
+        // The key blocks sorted at the end of the threads are written into sorted runs as well,
+        // one factorizedTable at a time, so that all runs are merged by OrderByMerge.
+        auto& sortedKeyBlocks = *sharedState->sortedKeyBlocks;
+        std::vector<std::vector<std::shared_ptr<MergedKeyBlocks>>> sortedKeyBlocksPerTable(
+            sharedState->factorizedTables.size());
+        while (!sortedKeyBlocks.empty()) {
+            auto& keyBlocks = sortedKeyBlocks.front();
+            keyBlocks->pinBlocks(0, keyBlocks->getNumTuples());
+            auto ftIdx = OrderByKeyEncoder::getEncodedFTIdx(
+                keyBlocks->getTuple(0) + sharedState->numBytesPerTuple - 8);
+            keyBlocks->unpinBlocks(0, keyBlocks->getNumTuples());
+            sortedKeyBlocksPerTable[ftIdx].push_back(std::move(keyBlocks));
+            sortedKeyBlocks.pop();
+        }
+        uint64_t numBytesSpilled = 0;
+        for (auto i = 0u; i < sortedKeyBlocksPerTable.size(); i++) {
+            auto& factorizedTable = *sharedState->factorizedTables[i];
+            numBytesSpilled += factorizedTable.pinBlocks();
+            for (auto& keyBlocks : sortedKeyBlocksPerTable[i]) {
+                numBytesSpilled += keyBlocks->pinBlocks(0, keyBlocks->getNumTuples());
+                numBytesSpilled += writeSortedRun(keyBlocks->getKeyBlockBuffer(0),
+                    keyBlocks->getNumTuples(), factorizedTable, context->memoryManager);
+            }
+            sortedKeyBlocksPerTable[i].clear();
+            factorizedTable.clear();
+        }
+        context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+            ->increase(numBytesSpilled);
+        return;
+    }
+    // Ties of string keys are resolved by reading the strings from factorizedTables, so they have
+    // to stay in memory while key blocks are merged. Otherwise, they are pinned by OrderByScan.
+    if (!sharedState->strKeyColsInfo.empty()) {
+        context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+            ->increase(sharedState->pinFactorizedTables());
+    }
 }
 
 } // namespace processor
@@ -58,6 +58,13 @@ void OrderByKeyEncoder::encodeKeys() {
     }
 }
 
+void OrderByKeyEncoder::clear() {
+    keyBlocks.resize(1);
+    keyBlocks[0]->numTuples = 0;
+    ftBlockIdx = 0;
+    ftBlockOffset = 0;
+}
+
 uint32_t OrderByKeyEncoder::getNumBytesPerTuple(const std::vector<ValueVector*>& keyVectors) {
     uint32_t result = 0u;
     for (auto& vector : keyVectors) {
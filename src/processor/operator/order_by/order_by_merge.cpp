@@ -3,6 +3,7 @@
 #include "common/constants.h"
 
 using namespace kuzu::common;
+using namespace kuzu::storage;
 
 namespace kuzu {
 namespace processor {
@@ -16,6 +17,11 @@ void OrderByMerge::initLocalStateInternal(ResultSet* resultSet, ExecutionContext
 
 void OrderByMerge::executeInternal(ExecutionContext* context) {
     while (!sharedDispatcher->isDoneMerge()) {
+        auto sortedRuns = sharedDispatcher->getSortedRunsToMerge();
+        if (!sortedRuns.empty()) {
+            mergeSortedRuns(std::move(sortedRuns), context->memoryManager);
+            continue;
+        }
         auto keyBlockMergeMorsel = sharedDispatcher->getMorsel();
         if (keyBlockMergeMorsel == nullptr) {
             std::this_thread::sleep_for(
@@ -27,10 +33,33 @@ void OrderByMerge::executeInternal(ExecutionContext* context) {
     }
 }
 
+void OrderByMerge::mergeSortedRuns(
+    std::vector<std::shared_ptr<SortedRun>> sortedRuns, MemoryManager* memoryManager) {
+    uint64_t numTuples = 0;
+    for (auto& sortedRun : sortedRuns) {
+        numTuples += sortedRun->getNumTuples();
+    }
+    SortedRunWriter writer{memoryManager, *sharedState->payloadTableSchema,
+        sharedState->payloadTypes, sharedState->numBytesPerTuple, numTuples};
+    auto numBytesSpilled = localMerger->mergeSortedRuns(sortedRuns, writer);
+    auto numRunsMerged = sortedRuns.size();
+    // The merged runs are released before the merge is done, so that their blocks are freed.
+    sortedRuns.clear();
+    auto mergedRun = writer.finish();
+    sharedDispatcher->doneSortedRunsMerge(
+        std::move(mergedRun), numRunsMerged, numBytesSpilled + writer.getNumBytesSpilled());
+}
+
+void OrderByMerge::finalize(ExecutionContext* context) {
+    context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+        ->increase(sharedDispatcher->getNumBytesSpilled());
+}
+
 void OrderByMerge::initGlobalStateInternal(ExecutionContext* context) {
     // TODO(Ziyi): directly feed sharedState to merger and dispatcher.
     sharedDispatcher->init(context->memoryManager, sharedState->sortedKeyBlocks,
-        sharedState->factorizedTables, sharedState->strKeyColsInfo, sharedState->numBytesPerTuple);
+        sharedState->sortedRuns, sharedState->factorizedTables, sharedState->strKeyColsInfo,
+        sharedState->numBytesPerTuple, OrderBy::getMemoryBudget(context));
 }
 
 } // namespace processor
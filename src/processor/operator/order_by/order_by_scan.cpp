@@ -10,10 +10,27 @@ void OrderByScan::initLocalStateInternal(ResultSet* resultSet, ExecutionContext*
         auto valueVector = resultSet->getValueVector(dataPos);
         vectorsToRead.push_back(valueVector.get());
     }
+    numBytesSpilled = context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey());
+    if (!sharedState->sortedRuns->empty()) {
+        // The sort is external, and OrderByMerge has merged all runs into a single run.
+        assert(sharedState->sortedRuns->size() == 1);
+        sortedRunScanState = std::make_unique<SortedRunScanState>();
+        sortedRunScanState->sortedRun = sharedState->sortedRuns->front();
+        sortedRunScanState->nextPayloadTableIdx = 0;
+        sortedRunScanState->nextTupleIdxInPayloadTable = 0;
+        return;
+    }
     initMergedKeyBlockScanState();
+    // Tuples are read in the order of the merged key block, which is random with respect to the
+    // factorizedTables, so all of them are pinned for the scan. The merged key block is read
+    // sequentially, so only the key blocks of the tuples being read are pinned.
+    numBytesSpilled->increase(sharedState->pinFactorizedTables());
 }
 
 bool OrderByScan::getNextTuplesInternal(ExecutionContext* context) {
+    if (sortedRunScanState != nullptr) {
+        return getNextTuplesFromSortedRun();
+    }
     // If there is no more tuples to read, just return false.
     if (mergedKeyBlockScanState == nullptr ||
         mergedKeyBlockScanState->nextTupleIdxToReadInMergedKeyBlock >=
@@ -23,7 +40,10 @@ bool OrderByScan::getNextTuplesInternal(ExecutionContext* context) {
         // If there is an unflat col in factorizedTable, we can only read one
         // tuple at a time. Otherwise, we can read min(DEFAULT_VECTOR_CAPACITY,
         // numTuplesRemainingInMemBlock) tuples.
+        auto mergedKeyBlock = mergedKeyBlockScanState->mergedKeyBlock;
+        auto startTupleIdx = mergedKeyBlockScanState->nextTupleIdxToReadInMergedKeyBlock;
         if (mergedKeyBlockScanState->scanSingleTuple) {
+            numBytesSpilled->increase(mergedKeyBlock->pinBlocks(startTupleIdx, startTupleIdx + 1));
             auto tupleInfoBuffer = mergedKeyBlockScanState->blockPtrInfo->curTuplePtr +
                                    mergedKeyBlockScanState->tupleIdxAndFactorizedTableIdxOffset;
             auto blockIdx = OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfoBuffer);
@@ -36,11 +56,13 @@ bool OrderByScan::getNextTuplesInternal(ExecutionContext* context) {
                 mergedKeyBlockScanState->mergedKeyBlock->getNumBytesPerTuple();
             mergedKeyBlockScanState->blockPtrInfo->updateTuplePtrIfNecessary();
             mergedKeyBlockScanState->nextTupleIdxToReadInMergedKeyBlock++;
+            mergedKeyBlock->unpinBlocks(startTupleIdx, startTupleIdx + 1);
             metrics->numOutputTuple.increase(1);
         } else {
-            auto numTuplesToRead = std::min(DEFAULT_VECTOR_CAPACITY,
-                mergedKeyBlockScanState->mergedKeyBlock->getNumTuples() -
-                    mergedKeyBlockScanState->nextTupleIdxToReadInMergedKeyBlock);
+            auto numTuplesToRead = std::min(
+                DEFAULT_VECTOR_CAPACITY, mergedKeyBlock->getNumTuples() - startTupleIdx);
+            numBytesSpilled->increase(
+                mergedKeyBlock->pinBlocks(startTupleIdx, startTupleIdx + numTuplesToRead));
             auto numTuplesRead = 0;
             while (numTuplesRead < numTuplesToRead) {
                 auto numTuplesToReadInCurBlock = std::min(numTuplesToRead - numTuplesRead,
@@ -71,6 +93,7 @@ bool OrderByScan::getNextTuplesInternal(ExecutionContext* context) {
             sharedState->factorizedTables[0]->lookup(vectorsToRead,
                 mergedKeyBlockScanState->colsToScan, mergedKeyBlockScanState->tuplesToRead.get(), 0,
                 numTuplesToRead);
+            mergedKeyBlock->unpinBlocks(startTupleIdx, startTupleIdx + numTuplesToRead);
             metrics->numOutputTuple.increase(numTuplesToRead);
             mergedKeyBlockScanState->nextTupleIdxToReadInMergedKeyBlock += numTuplesToRead;
         }
@@ -78,6 +101,32 @@ bool OrderByScan::getNextTuplesInternal(ExecutionContext* context) {
     }
 }
 
+bool OrderByScan::getNextTuplesFromSortedRun() {
+    auto& payloadTables = sortedRunScanState->sortedRun->payloadTables;
+    if (sortedRunScanState->nextPayloadTableIdx >= payloadTables.size()) {
+        return false;
+    }
+    auto& payloadTable = *payloadTables[sortedRunScanState->nextPayloadTableIdx];
+    auto startTupleIdx = sortedRunScanState->nextTupleIdxInPayloadTable;
+    if (startTupleIdx == 0) {
+        numBytesSpilled->increase(payloadTable.pinBlocks());
+    }
+    // If there is an unflat col in the payload table, we can only read one tuple at a time.
+    auto numTuplesToRead =
+        payloadTable.hasUnflatCol() ?
+            1 :
+            std::min(DEFAULT_VECTOR_CAPACITY, payloadTable.getNumTuples() - startTupleIdx);
+    payloadTable.scan(vectorsToRead, startTupleIdx, numTuplesToRead);
+    sortedRunScanState->nextTupleIdxInPayloadTable += numTuplesToRead;
+    if (sortedRunScanState->nextTupleIdxInPayloadTable == payloadTable.getNumTuples()) {
+        payloadTable.unpinBlocks();
+        sortedRunScanState->nextPayloadTableIdx++;
+        sortedRunScanState->nextTupleIdxInPayloadTable = 0;
+    }
+    metrics->numOutputTuple.increase(numTuplesToRead);
+    return true;
+}
+
 void OrderByScan::initMergedKeyBlockScanState() {
     if (sharedState->sortedKeyBlocks->empty()) {
         return;
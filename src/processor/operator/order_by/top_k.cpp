@@ -0,0 +1,176 @@
+#include "processor/operator/order_by/top_k.h"
+
+using namespace kuzu::common;
+using namespace kuzu::storage;
+
+namespace kuzu {
+namespace processor {
+
+void TopK::initLocalStateInternal(ResultSet* resultSet, ExecutionContext* context) {
+    initLocalFactorizedTableAndEncoder(resultSet, context);
+    candidateKeyEncoder = std::make_unique<OrderByKeyEncoder>(keyVectors,
+        orderByDataInfo.isAscOrder, context->memoryManager, factorizedTableIdx,
+        localFactorizedTable->getNumTuplesPerBlock(), sharedState->numBytesPerTuple);
+    localFactorizedTables.resize(factorizedTableIdx + 1);
+    localFactorizedTables[factorizedTableIdx] = localFactorizedTable;
+    localMerger = std::make_unique<KeyBlockMerger>(
+        localFactorizedTables, sharedState->strKeyColsInfo, sharedState->numBytesPerTuple);
+}
+
+void TopK::executeInternal(ExecutionContext* context) {
+    auto& keyBlocks = orderByKeyEncoder->getKeyBlocks();
+    auto numBytesPerTuple = orderByKeyEncoder->getNumBytesPerTuple();
+    while (children[0]->getNextTuple(context)) {
+        for (auto i = 0u; i < resultSet->multiplicity; i++) {
+            if (!selectCandidates()) {
+                // The heap only gets better, so the following iterations can't enter it either.
+                break;
+            }
+            auto blockIdx = keyBlocks.size() - 1;
+            auto tupleIdx = keyBlocks.back()->numTuples;
+            orderByKeyEncoder->encodeKeys();
+            // See comment in OrderBy::executeInternal.
+            localFactorizedTable->append(vectorsToAppend);
+            // String ties are resolved by reading the factorizedTable, so the encoded tuples are
+            // pushed to the heap after the tuples are appended.
+            for (; blockIdx < keyBlocks.size(); blockIdx++, tupleIdx = 0) {
+                auto keyBlockBuffer = keyBlocks[blockIdx]->getData();
+                for (; tupleIdx < keyBlocks[blockIdx]->numTuples; tupleIdx++) {
+                    pushToHeap(keyBlockBuffer + tupleIdx * numBytesPerTuple);
+                }
+            }
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), [&](uint8_t* left, uint8_t* right) {
+        return localMerger->compareTuplePtr(right, left);
+    });
+    if (!heap.empty()) {
+        sharedState->appendSortedKeyBlock(createSortedRun(heap, context->memoryManager));
+    }
+    heap.clear();
+    localFactorizedTable->unpinBlocks();
+}
+
+void TopK::finalize(ExecutionContext* context) {
+    OrderBy::finalize(context);
+    auto& sortedRuns = *sharedState->sortedKeyBlocks;
+    if (sortedRuns.size() <= 1) {
+        return;
+    }
+    uint64_t numBytesSpilled = 0;
+    std::vector<std::shared_ptr<MergedKeyBlocks>> runs;
+    std::vector<uint8_t*> tuples;
+    while (!sortedRuns.empty()) {
+        auto run = std::move(sortedRuns.front());
+        sortedRuns.pop();
+        numBytesSpilled += run->pinBlocks(0 /* startTupleIdx */, run->getNumTuples());
+        for (auto i = 0u; i < run->getNumTuples(); i++) {
+            tuples.push_back(run->getTuple(i));
+        }
+        runs.push_back(std::move(run));
+    }
+    // Each run holds at most limitNumber tuples, so sorting all of them is cheap.
+    KeyBlockMerger merger{
+        sharedState->factorizedTables, sharedState->strKeyColsInfo, sharedState->numBytesPerTuple};
+    auto numTuples = std::min(limitNumber, (uint64_t)tuples.size());
+    std::partial_sort(tuples.begin(), tuples.begin() + (int64_t)numTuples, tuples.end(),
+        [&](uint8_t* left, uint8_t* right) { return merger.compareTuplePtr(right, left); });
+    tuples.resize(numTuples);
+    sharedState->appendSortedKeyBlock(createSortedRun(tuples, context->memoryManager));
+    for (auto& run : runs) {
+        run->unpinBlocks(0 /* startTupleIdx */, run->getNumTuples());
+    }
+    context->profiler->registerNumericMetric(getNumBytesSpilledMetricKey())
+        ->increase(numBytesSpilled);
+}
+
+bool TopK::selectCandidates() {
+    if (limitNumber == 0) {
+        return false;
+    }
+    if (heap.size() < limitNumber) {
+        return true;
+    }
+    candidateKeyEncoder->clear();
+    candidateKeyEncoder->encodeKeys();
+    auto& candidateKeyBlocks = candidateKeyEncoder->getKeyBlocks();
+    auto state = keyVectors[0]->state.get();
+    if (state->isFlat()) {
+        return !isDominatedByHeapTop(candidateKeyBlocks[0]->getData());
+    }
+    // If the keys are unflat, all keys and payloads are in the same data chunk (see
+    // LogicalOrderBy::getGroupsPosToFlatten), so its selection vector filters all of them.
+    auto selVector = state->selVector.get();
+    auto selectedPosBuffer = selVector->getSelectedPositionsBuffer();
+    auto isUnfiltered = selVector->isUnfiltered();
+    auto numTuplesPerBlock = candidateKeyEncoder->getMaxNumTuplesPerBlock();
+    auto numBytesPerTuple = candidateKeyEncoder->getNumBytesPerTuple();
+    auto numSelected = 0u;
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        auto candidateKey = candidateKeyBlocks[i / numTuplesPerBlock]->getData() +
+                            (i % numTuplesPerBlock) * numBytesPerTuple;
+        if (!isDominatedByHeapTop(candidateKey)) {
+            selectedPosBuffer[numSelected++] = selVector->selectedPositions[i];
+        }
+    }
+    if (numSelected == 0) {
+        return false;
+    }
+    if (isUnfiltered) {
+        selVector->resetSelectorToValuePosBuffer();
+    }
+    selVector->selectedSize = numSelected;
+    return true;
+}
+
+bool TopK::isDominatedByHeapTop(const uint8_t* candidateKey) const {
+    auto heapTop = heap.front();
+    uint32_t numBytesCompared = 0;
+    for (auto& strKeyColInfo : sharedState->strKeyColsInfo) {
+        auto strColEnd = strKeyColInfo.colOffsetInEncodedKeyBlock + strKeyColInfo.getEncodingSize();
+        auto result = memcmp(candidateKey + numBytesCompared, heapTop + numBytesCompared,
+            strColEnd - numBytesCompared);
+        if (result != 0) {
+            return result > 0;
+        }
+        auto strColPtr = candidateKey + strKeyColInfo.colOffsetInEncodedKeyBlock;
+        if (!OrderByKeyEncoder::isNullVal(strColPtr, strKeyColInfo.isAscOrder) &&
+            OrderByKeyEncoder::isLongStr(strColPtr, strKeyColInfo.isAscOrder)) {
+            return false;
+        }
+        numBytesCompared = strColEnd;
+    }
+    // A candidate equal to the worst key in the heap can't improve the heap either.
+    return memcmp(candidateKey + numBytesCompared, heapTop + numBytesCompared,
+               sharedState->numBytesPerTuple - 8 - numBytesCompared) >= 0;
+}
+
+void TopK::pushToHeap(uint8_t* tuple) {
+    auto isSmaller = [&](uint8_t* left, uint8_t* right) {
+        return localMerger->compareTuplePtr(right, left);
+    };
+    if (heap.size() < limitNumber) {
+        heap.push_back(tuple);
+        std::push_heap(heap.begin(), heap.end(), isSmaller);
+    } else if (isSmaller(tuple, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), isSmaller);
+        heap.back() = tuple;
+        std::push_heap(heap.begin(), heap.end(), isSmaller);
+    }
+}
+
+std::shared_ptr<MergedKeyBlocks> TopK::createSortedRun(
+    const std::vector<uint8_t*>& tuples, MemoryManager* memoryManager) const {
+    auto numBytesPerTuple = sharedState->numBytesPerTuple;
+    auto sortedRun =
+        std::make_shared<MergedKeyBlocks>(numBytesPerTuple, tuples.size(), memoryManager);
+    sortedRun->pinBlocks(0 /* startTupleIdx */, tuples.size());
+    for (auto i = 0u; i < tuples.size(); i++) {
+        memcpy(sortedRun->getTuple(i), tuples[i], numBytesPerTuple);
+    }
+    sortedRun->unpinBlocks(0 /* startTupleIdx */, tuples.size());
+    return sortedRun;
+}
+
+} // namespace processor
+} // namespace kuzu
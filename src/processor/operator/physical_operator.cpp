@@ -161,6 +161,9 @@ std::string PhysicalOperatorUtils::operatorTypeToString(PhysicalOperatorType ope
     case PhysicalOperatorType::ORDER_BY_SCAN: {
         return "ORDER_BY_SCAN";
     }
+    case PhysicalOperatorType::TOP_K: {
+        return "TOP_K";
+    }
     case PhysicalOperatorType::UNION_ALL_SCAN: {
         return "UNION_ALL_SCAN";
     }
@@ -234,12 +237,27 @@ void PhysicalOperator::initLocalState(ResultSet* resultSet_, ExecutionContext* c
     initLocalStateInternal(resultSet_, context);
 }
 
+void PhysicalOperator::resetInputState() {
+    if (!isSource()) {
+        children[0]->resetInputState();
+    }
+    resetInputStateInternal();
+}
+
 void PhysicalOperator::registerProfilingMetrics(Profiler* profiler) {
     auto executionTime = profiler->registerTimeMetric(getTimeMetricKey());
     auto numOutputTuple = profiler->registerNumericMetric(getNumTupleMetricKey());
     metrics = std::make_unique<OperatorMetrics>(*executionTime, *numOutputTuple);
 }
 
+void PhysicalOperator::registerPrefetchMetrics(Profiler* profiler) {
+    auto numPageHits = profiler->registerNumericMetric(getNumPageHitsMetricKey());
+    auto numPageMisses = profiler->registerNumericMetric(getNumPageMissesMetricKey());
+    auto numPagesPrefetched = profiler->registerNumericMetric(getNumPagesPrefetchedMetricKey());
+    prefetchMetrics =
+        std::make_unique<PrefetchMetrics>(*numPageHits, *numPageMisses, *numPagesPrefetched);
+}
+
 double PhysicalOperator::getExecutionTime(Profiler& profiler) const {
     auto executionTime = profiler.sumAllTimeMetricsWithKey(getTimeMetricKey());
     if (!isSource()) {
@@ -252,11 +270,28 @@ uint64_t PhysicalOperator::getNumOutputTuples(Profiler& profiler) const {
     return profiler.sumAllNumericMetricsWithKey(getNumTupleMetricKey());
 }
 
+uint64_t PhysicalOperator::getNumBytesSpilled(Profiler& profiler) const {
+    return profiler.sumAllNumericMetricsWithKey(getNumBytesSpilledMetricKey());
+}
+
 std::unordered_map<std::string, std::string> PhysicalOperator::getProfilerKeyValAttributes(
     Profiler& profiler) const {
     std::unordered_map<std::string, std::string> result;
     result.insert({"ExecutionTime", std::to_string(getExecutionTime(profiler))});
     result.insert({"NumOutputTuples", std::to_string(getNumOutputTuples(profiler))});
+    auto numBytesSpilled = getNumBytesSpilled(profiler);
+    if (numBytesSpilled > 0) {
+        result.insert({"NumBytesSpilled", std::to_string(numBytesSpilled)});
+    }
+    auto numPageHits = profiler.sumAllNumericMetricsWithKey(getNumPageHitsMetricKey());
+    auto numPageMisses = profiler.sumAllNumericMetricsWithKey(getNumPageMissesMetricKey());
+    if (numPageHits + numPageMisses > 0) {
+        auto numPagesPrefetched =
+            profiler.sumAllNumericMetricsWithKey(getNumPagesPrefetchedMetricKey());
+        result.insert({"NumPageHits", std::to_string(numPageHits)});
+        result.insert({"NumPageMisses", std::to_string(numPageMisses)});
+        result.insert({"NumPagesPrefetched", std::to_string(numPagesPrefetched)});
+    }
     return result;
 }
 
@@ -3,22 +3,151 @@
 namespace kuzu {
 namespace processor {
 
+Frontier::Frontier(const std::vector<uint64_t>* numNodesPerTable)
+    : numNodesPerTable{numNodesPerTable}, denseThreshold{0}, isDense{false}, isFinalized{false} {
+    if (numNodesPerTable != nullptr) {
+        for (auto numNodes : *numNodesPerTable) {
+            tableStartDenseIdx.push_back(denseThreshold);
+            denseThreshold += numNodes;
+        }
+        denseThreshold /= DENSE_THRESHOLD_DIVISOR;
+    }
+}
+
+void Frontier::resetState() {
+    if (isDense) {
+        // Only entries of nodes in the frontier are set, so there is no need to clear the arrays.
+        for (auto& nodeID : nodeIDs) {
+            if (!denseNumBwdEdges.empty() && hasDenseIdx(nodeID)) {
+                denseNumBwdEdges[getDenseIdx(nodeID)] = 0;
+            }
+            if (!denseMultiplicities.empty()) {
+                denseMultiplicities[nodeID.tableID][nodeID.offset] = 0;
+            }
+        }
+        denseBwdEdgeList.clear();
+        denseBwdEdges.clear();
+    }
+    bwdEdges.clear();
+    nodeIDToMultiplicity.clear();
+    nodeIDs.clear();
+    isFinalized = false;
+}
+
+void Frontier::finalize() {
+    if (isFinalized) {
+        return;
+    }
+    isFinalized = true;
+    if (denseBwdEdgeList.empty()) {
+        return;
+    }
+    // The edges of the frontier nodes are laid out in the order of nodeIDs.
+    uint64_t numEdges = 0;
+    for (auto& nodeID : nodeIDs) {
+        if (!hasDenseIdx(nodeID)) {
+            continue;
+        }
+        auto denseIdx = getDenseIdx(nodeID);
+        denseBwdEdgeOffsets[denseIdx] = numEdges;
+        numEdges += denseNumBwdEdges[denseIdx];
+    }
+    // Offsets are used as write cursors while scattering the edge list, and moved back to the start
+    // of each node's edges afterwards.
+    denseBwdEdges.resize(numEdges);
+    for (auto& [denseIdx, edge] : denseBwdEdgeList) {
+        denseBwdEdges[denseBwdEdgeOffsets[denseIdx]++] = edge;
+    }
+    for (auto& nodeID : nodeIDs) {
+        if (hasDenseIdx(nodeID)) {
+            auto denseIdx = getDenseIdx(nodeID);
+            denseBwdEdgeOffsets[denseIdx] -= denseNumBwdEdges[denseIdx];
+        }
+    }
+    denseBwdEdgeList.clear();
+}
+
 void Frontier::addEdge(
     common::nodeID_t boundNodeID, common::nodeID_t nbrNodeID, common::nodeID_t relID) {
+    assert(!isFinalized);
+    if (isDense && hasDenseIdx(nbrNodeID)) {
+        addDenseEdge(boundNodeID, nbrNodeID, relID);
+        return;
+    }
     if (!bwdEdges.contains(nbrNodeID)) {
         nodeIDs.push_back(nbrNodeID);
         bwdEdges.insert({nbrNodeID, std::vector<frontier::node_rel_id_t>{}});
     }
     bwdEdges.at(nbrNodeID).emplace_back(boundNodeID, relID);
+    if (shouldSwitchToDense()) {
+        switchToDense();
+    }
+}
+
+void Frontier::addDenseEdge(
+    common::nodeID_t boundNodeID, common::nodeID_t nbrNodeID, common::nodeID_t relID) {
+    if (denseNumBwdEdges.empty()) {
+        initDenseBwdEdgeArrays();
+    }
+    auto denseIdx = getDenseIdx(nbrNodeID);
+    auto& numEdges = denseNumBwdEdges[denseIdx];
+    if (numEdges == 0) {
+        nodeIDs.push_back(nbrNodeID);
+    }
+    numEdges++;
+    denseBwdEdgeList.emplace_back(denseIdx, frontier::node_rel_id_t{boundNodeID, relID});
 }
 
 void Frontier::addNodeWithMultiplicity(common::nodeID_t nodeID, uint64_t multiplicity) {
+    if (isDense) {
+        if (denseMultiplicities.empty()) {
+            initDenseArrays(denseMultiplicities);
+        }
+        auto& nodeMultiplicity = getDenseEntry(denseMultiplicities, nodeID);
+        if (nodeMultiplicity == 0) {
+            nodeIDs.push_back(nodeID);
+        }
+        nodeMultiplicity += multiplicity;
+        return;
+    }
     if (nodeIDToMultiplicity.contains(nodeID)) {
         nodeIDToMultiplicity.at(nodeID) += multiplicity;
     } else {
         nodeIDToMultiplicity.insert({nodeID, multiplicity});
         nodeIDs.push_back(nodeID);
     }
+    if (shouldSwitchToDense()) {
+        switchToDense();
+    }
+}
+
+void Frontier::switchToDense() {
+    isDense = true;
+    if (!bwdEdges.empty()) {
+        // Nodes are already in nodeIDs, so their edges are moved without addDenseEdge().
+        for (auto& nodeID : nodeIDs) {
+            if (!hasDenseIdx(nodeID)) {
+                continue;
+            }
+            if (denseNumBwdEdges.empty()) {
+                initDenseBwdEdgeArrays();
+            }
+            auto denseIdx = getDenseIdx(nodeID);
+            auto& edges = bwdEdges.at(nodeID);
+            denseNumBwdEdges[denseIdx] = edges.size();
+            for (auto& edge : edges) {
+                denseBwdEdgeList.emplace_back(denseIdx, edge);
+            }
+            bwdEdges.erase(nodeID);
+        }
+    }
+    if (!nodeIDToMultiplicity.empty()) {
+        initDenseArrays(denseMultiplicities);
+        for (auto& [nodeID, multiplicity] : nodeIDToMultiplicity) {
+            getDenseEntry(denseMultiplicities, nodeID) = multiplicity;
+        }
+        nodeIDToMultiplicity.clear();
+    }
 }
 
 } // namespace processor
@@ -58,8 +58,8 @@ void PathScanner::scanFromDstOffset(RecursiveJoinVectors* vectors, common::sel_t
     while (!nbrsStack.empty()) {
         auto& cursor = cursorStack.top();
         cursor++;
-        if (cursor < nbrsStack.top()->size()) { // Found a new nbr
-            auto& nbr = nbrsStack.top()->at(cursor);
+        if (cursor < nbrsStack.top().size()) { // Found a new nbr
+            auto& nbr = nbrsStack.top()[cursor];
             nodeIDs[level] = nbr.first;
             relIDs[level] = nbr.second;
             if (level == 0) { // Found a new nbr at level 0. Found a new path.
@@ -71,7 +71,7 @@ void PathScanner::scanFromDstOffset(RecursiveJoinVectors* vectors, common::sel_t
             }
             // Push new stack.
             cursorStack.push(-1);
-            nbrsStack.push(&frontiers[level]->bwdEdges.at(nbr.first));
+            nbrsStack.push(frontiers[level]->getBwdEdges(nbr.first));
             level--;
         } else { // Failed to find a nbr. Pop stack.
             cursorStack.pop();
@@ -88,10 +88,10 @@ void PathScanner::initDfs(const frontier::node_rel_id_t& nodeAndRelID, size_t cu
         cursorStack.top() = -1;
         return;
     }
-    auto nbrs = &frontiers[currentDepth]->bwdEdges.at(nodeAndRelID.first);
+    auto nbrs = frontiers[currentDepth]->getBwdEdges(nodeAndRelID.first);
     nbrsStack.push(nbrs);
     cursorStack.push(0);
-    initDfs(nbrs->at(0), currentDepth - 1);
+    initDfs(nbrs[0], currentDepth - 1);
 }
 
 void PathScanner::writePathToVector(RecursiveJoinVectors* vectors, common::sel_t& vectorPos,
@@ -119,7 +119,6 @@ void PathScanner::writePathToVector(RecursiveJoinVectors* vectors, common::sel_t
 void DstNodeWithMultiplicityScanner::scanFromDstOffset(RecursiveJoinVectors* vectors,
     common::sel_t& vectorPos, common::sel_t& nodeIDDataVectorPos,
     common::sel_t& relIDDataVectorPos) {
-    auto& multiplicity = frontiers[k]->nodeIDToMultiplicity.at(currentDstNodeID);
     while (multiplicity > 0 && vectorPos < common::DEFAULT_VECTOR_CAPACITY) {
         writeDstNodeOffsetAndLength(vectors->dstNodeIDVector, vectors->pathLengthVector, vectorPos);
         vectorPos++;
@@ -0,0 +1,134 @@
+#include "processor/operator/recursive_extend/multi_source_shortest_path_state.h"
+
+#include <bit>
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace processor {
+
+void MultiSourceShortestPathState::resetState() {
+    // Only masks of visited nodes are set, so there is no need to clear the whole arrays.
+    auto& visitedFrontiers = isScanStarted ? levelFrontiers : frontiers;
+    for (auto i = 0u; i < levelMasks.size(); ++i) {
+        for (auto& nodeID : visitedFrontiers[i]->nodeIDs) {
+            if (nodeID.tableID == tableID) {
+                visitedMasks[nodeID.offset] = 0;
+                frontierMasks[nodeID.offset] = 0;
+            }
+        }
+    }
+    if (isScanStarted) {
+        std::swap(frontiers, levelFrontiers);
+        isScanStarted = false;
+    }
+    levelMasks.clear();
+    BaseBFSState::resetState();
+    levelMasks.emplace_back();
+    numSrcNodes = 0;
+    numSrcNodesWithAllDstReached = 0;
+    numVisitedDstNodes.fill(0);
+}
+
+void MultiSourceShortestPathState::markSrc(nodeID_t nodeID) {
+    assert(numSrcNodes < MAX_NUM_SRC_NODES && currentLevel == 0);
+    auto srcMask = (uint64_t)1 << numSrcNodes++;
+    if (nodeID.tableID != tableID) {
+        // The src node has no recursive rels, so it is only kept in the first frontier.
+        currentFrontier->addNode(nodeID);
+        levelMasks[0].push_back(srcMask);
+        markDstVisited(nodeID, srcMask);
+        return;
+    }
+    ensureCapacity(nodeID.offset);
+    if (visitedMasks[nodeID.offset] == 0) {
+        currentFrontier->addNode(nodeID);
+        levelMasks[0].push_back(srcMask);
+    } else {
+        // The same src node appears more than once in the batch.
+        auto& nodeIDs = currentFrontier->nodeIDs;
+        auto idx = std::find(nodeIDs.begin(), nodeIDs.end(), nodeID) - nodeIDs.begin();
+        levelMasks[0][idx] |= srcMask;
+    }
+    visitedMasks[nodeID.offset] |= srcMask;
+    frontierMasks[nodeID.offset] |= srcMask;
+    markDstVisited(nodeID, srcMask);
+}
+
+void MultiSourceShortestPathState::markVisited(
+    nodeID_t boundNodeID, nodeID_t nbrNodeID, relID_t relID, uint64_t multiplicity) {
+    ensureCapacity(nbrNodeID.offset);
+    auto newMask = frontierMasks[boundNodeID.offset] & ~visitedMasks[nbrNodeID.offset];
+    if (newMask == 0) {
+        return;
+    }
+    if (nextFrontierMasks[nbrNodeID.offset] == 0) {
+        nextFrontier->addNode(nbrNodeID);
+    }
+    nextFrontierMasks[nbrNodeID.offset] |= newMask;
+    visitedMasks[nbrNodeID.offset] |= newMask;
+    markDstVisited(nbrNodeID, newMask);
+}
+
+void MultiSourceShortestPathState::finalizeCurrentLevel() {
+    auto& nextNodeIDs = nextFrontier->nodeIDs;
+    std::sort(nextNodeIDs.begin(), nextNodeIDs.end());
+    std::vector<uint64_t> masks;
+    masks.reserve(nextNodeIDs.size());
+    for (auto& nodeID : nextNodeIDs) {
+        masks.push_back(nextFrontierMasks[nodeID.offset]);
+    }
+    levelMasks.push_back(std::move(masks));
+    for (auto& nodeID : currentFrontier->nodeIDs) {
+        if (nodeID.tableID == tableID) {
+            frontierMasks[nodeID.offset] = 0;
+        }
+    }
+    std::swap(frontierMasks, nextFrontierMasks);
+    moveNextLevelAsCurrentLevel();
+}
+
+void MultiSourceShortestPathState::initScanFromSrc(uint32_t srcIdx) {
+    assert(srcIdx < numSrcNodes);
+    if (!isScanStarted) {
+        std::swap(frontiers, levelFrontiers);
+        isScanStarted = true;
+    }
+    numFrontiers = 0;
+    auto srcMask = (uint64_t)1 << srcIdx;
+    for (auto i = 0u; i < levelMasks.size(); ++i) {
+        auto frontier = getNewFrontier();
+        auto& nodeIDs = levelFrontiers[i]->nodeIDs;
+        for (auto j = 0u; j < nodeIDs.size(); ++j) {
+            if (levelMasks[i][j] & srcMask) {
+                frontier->addNode(nodeIDs[j]);
+            }
+        }
+    }
+}
+
+void MultiSourceShortestPathState::ensureCapacity(offset_t offset) {
+    if (offset < visitedMasks.size()) {
+        return;
+    }
+    auto capacity = std::max(offset + 1, 2 * visitedMasks.size());
+    visitedMasks.resize(capacity, 0);
+    frontierMasks.resize(capacity, 0);
+    nextFrontierMasks.resize(capacity, 0);
+}
+
+void MultiSourceShortestPathState::markDstVisited(nodeID_t nodeID, uint64_t srcMask) {
+    if (!targetDstNodes->contains(nodeID)) {
+        return;
+    }
+    while (srcMask != 0) {
+        auto srcIdx = std::countr_zero(srcMask);
+        if (++numVisitedDstNodes[srcIdx] == targetDstNodes->getNumNodes()) {
+            numSrcNodesWithAllDstReached++;
+        }
+        srcMask &= srcMask - 1;
+    }
+}
+
+} // namespace processor
+} // namespace kuzu
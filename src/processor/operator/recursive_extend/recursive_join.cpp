@@ -12,6 +12,7 @@ namespace processor {
 
 void RecursiveJoin::initLocalStateInternal(ResultSet* resultSet_, ExecutionContext* context) {
     populateTargetDstNodes();
+    populateNumNodesPerTable();
     vectors = std::make_unique<RecursiveJoinVectors>();
     vectors->srcNodeIDVector = resultSet->getValueVector(dataInfo->srcNodePos).get();
     vectors->dstNodeIDVector = resultSet->getValueVector(dataInfo->dstNodePos).get();
@@ -23,14 +24,14 @@ void RecursiveJoin::initLocalStateInternal(ResultSet* resultSet_, ExecutionConte
         case planner::RecursiveJoinType::TRACK_PATH: {
             vectors->pathVector = resultSet->getValueVector(dataInfo->pathPos).get();
             bfsState = std::make_unique<VariableLengthState<true /* TRACK_PATH */>>(
-                upperBound, targetDstNodes.get());
+                upperBound, targetDstNodes.get(), &numNodesPerTable);
             for (auto i = lowerBound; i <= upperBound; ++i) {
                 scanners.push_back(std::make_unique<PathScanner>(targetDstNodes.get(), i));
             }
         } break;
         case planner::RecursiveJoinType::TRACK_NONE: {
             bfsState = std::make_unique<VariableLengthState<false /* TRACK_PATH */>>(
-                upperBound, targetDstNodes.get());
+                upperBound, targetDstNodes.get(), &numNodesPerTable);
             for (auto i = lowerBound; i <= upperBound; ++i) {
                 scanners.push_back(
                     std::make_unique<DstNodeWithMultiplicityScanner>(targetDstNodes.get(), i));
@@ -45,14 +46,22 @@ void RecursiveJoin::initLocalStateInternal(ResultSet* resultSet_, ExecutionConte
         case planner::RecursiveJoinType::TRACK_PATH: {
             vectors->pathVector = resultSet->getValueVector(dataInfo->pathPos).get();
             bfsState = std::make_unique<ShortestPathState<true /* TRACK_PATH */>>(
-                upperBound, targetDstNodes.get());
+                upperBound, targetDstNodes.get(), &numNodesPerTable);
             for (auto i = lowerBound; i <= upperBound; ++i) {
                 scanners.push_back(std::make_unique<PathScanner>(targetDstNodes.get(), i));
             }
         } break;
         case planner::RecursiveJoinType::TRACK_NONE: {
-            bfsState = std::make_unique<ShortestPathState<false /* TRACK_PATH */>>(
-                upperBound, targetDstNodes.get());
+            if (dataInfo->isMultiSourceBFS) {
+                auto state = std::make_unique<MultiSourceShortestPathState>(upperBound,
+                    targetDstNodes.get(), *dataInfo->recursiveDstNodeTableIDs.begin());
+                multiSourceBFSState = state.get();
+                bfsState = std::move(state);
+                currentSelVector->resetSelectorToValuePosBufferWithSize(1 /* size */);
+            } else {
+                bfsState = std::make_unique<ShortestPathState<false /* TRACK_PATH */>>(
+                    upperBound, targetDstNodes.get(), &numNodesPerTable);
+            }
             for (auto i = lowerBound; i <= upperBound; ++i) {
                 scanners.push_back(std::make_unique<DstNodeScanner>(targetDstNodes.get(), i));
             }
@@ -66,14 +75,14 @@ void RecursiveJoin::initLocalStateInternal(ResultSet* resultSet_, ExecutionConte
         case planner::RecursiveJoinType::TRACK_PATH: {
             vectors->pathVector = resultSet->getValueVector(dataInfo->pathPos).get();
             bfsState = std::make_unique<AllShortestPathState<true /* TRACK_PATH */>>(
-                upperBound, targetDstNodes.get());
+                upperBound, targetDstNodes.get(), &numNodesPerTable);
             for (auto i = lowerBound; i <= upperBound; ++i) {
                 scanners.push_back(std::make_unique<PathScanner>(targetDstNodes.get(), i));
             }
         } break;
         case planner::RecursiveJoinType::TRACK_NONE: {
             bfsState = std::make_unique<AllShortestPathState<false /* TRACK_PATH */>>(
-                upperBound, targetDstNodes.get());
+                upperBound, targetDstNodes.get(), &numNodesPerTable);
             for (auto i = lowerBound; i <= upperBound; ++i) {
                 scanners.push_back(
                     std::make_unique<DstNodeWithMultiplicityScanner>(targetDstNodes.get(), i));
@@ -137,6 +146,12 @@ bool RecursiveJoin::getNextTuplesInternal(ExecutionContext* context) {
         if (scanOutput()) { // Phase 2
             return true;
         }
+        if (multiSourceBFSState != nullptr) {
+            if (!scanNextSrcNode(context)) {
+                return false;
+            }
+            continue;
+        }
         if (!children[0]->getNextTuple(context)) {
             return false;
         }
@@ -166,7 +181,66 @@ void RecursiveJoin::computeBFS(ExecutionContext* context) {
     auto nodeID = vectors->srcNodeIDVector->getValue<common::nodeID_t>(
         vectors->srcNodeIDVector->state->selVector->selectedPositions[0]);
     bfsState->markSrc(nodeID);
+    extendFrontiers(context);
+}
+
+bool RecursiveJoin::scanNextSrcNode(ExecutionContext* context) {
+    auto srcNodeState = vectors->srcNodeIDVector->state.get();
+    while (nextSrcNodeIdx == batchEndIdx) {
+        if (batchEndIdx == numSrcNodesInChunk) {
+            if (!isSrcNodeChunkFlat) {
+                srcNodeState->currIdx = -1;
+                restoreSelVector(srcNodeState->selVector);
+            }
+            if (!children[0]->getNextTuple(context)) {
+                return false;
+            }
+            isSrcNodeChunkFlat = srcNodeState->isFlat();
+            if (isSrcNodeChunkFlat) {
+                numSrcNodesInChunk = 1;
+            } else {
+                saveSelVector(srcNodeState->selVector);
+                numSrcNodesInChunk = prevSelVector->selectedSize;
+            }
+            batchEndIdx = 0;
+            nextSrcNodeIdx = 0;
+        }
+        computeMultiSourceBFS(context);
+    }
+    if (!isSrcNodeChunkFlat) {
+        srcNodeState->currIdx = (int64_t)nextSrcNodeIdx;
+        currentSelVector->selectedPositions[0] = prevSelVector->selectedPositions[nextSrcNodeIdx];
+    }
+    multiSourceBFSState->initScanFromSrc(nextSrcNodeIdx - batchStartIdx);
+    frontiersScanner->resetState(*bfsState);
+    nextSrcNodeIdx++;
+    return true;
+}
+
+void RecursiveJoin::computeMultiSourceBFS(ExecutionContext* context) {
+    batchStartIdx = batchEndIdx;
+    batchEndIdx = std::min(numSrcNodesInChunk,
+        batchStartIdx + MultiSourceShortestPathState::MAX_NUM_SRC_NODES);
+    if (batchStartIdx == batchEndIdx) {
+        return;
+    }
+    auto srcNodeSelVector = isSrcNodeChunkFlat ? vectors->srcNodeIDVector->state->selVector.get() :
+                                                 prevSelVector.get();
+    bfsState->resetState();
+    for (auto i = batchStartIdx; i < batchEndIdx; ++i) {
+        auto pos = srcNodeSelVector->selectedPositions[isSrcNodeChunkFlat ? 0 : i];
+        bfsState->markSrc(vectors->srcNodeIDVector->getValue<common::nodeID_t>(pos));
+    }
+    extendFrontiers(context);
+}
+
+void RecursiveJoin::extendFrontiers(ExecutionContext* context) {
     while (!bfsState->isComplete()) {
+        if (reverseRecursiveRoot != nullptr && bfsState->shouldExtendBottomUp()) {
+            extendCurrentFrontierBottomUp(context);
+            bfsState->finalizeCurrentLevel();
+            continue;
+        }
         auto boundNodeID = bfsState->getNextNodeID();
         if (boundNodeID.offset != common::INVALID_OFFSET) {
             // Found a starting node from current frontier.
@@ -181,6 +255,40 @@ void RecursiveJoin::computeBFS(ExecutionContext* context) {
     }
 }
 
+void RecursiveJoin::extendCurrentFrontierBottomUp(ExecutionContext* context) {
+    for (auto tableID = 0u; tableID < numNodesPerTable.size(); ++tableID) {
+        for (auto offset = 0u; offset < numNodesPerTable[tableID]; ++offset) {
+            auto nodeID = common::nodeID_t{offset, tableID};
+            if (!bfsState->isVisited(nodeID)) {
+                extendBottomUp(nodeID, context);
+            }
+        }
+    }
+}
+
+void RecursiveJoin::extendBottomUp(common::nodeID_t nodeID, ExecutionContext* context) {
+    // Any nbr in the current frontier gives a shortest path to the node, so the scan stops at the
+    // first one. If the node has several nbrs in the frontier, the recorded path may differ from
+    // the one recorded by top-down extension.
+    auto nbrNodeIDVector = vectors->reverseRecursiveNbrNodeIDVector;
+    reverseScanFrontier->setNodeID(nodeID);
+    while (reverseRecursiveRoot->getNextTuple(context)) {
+        auto selVector = nbrNodeIDVector->state->selVector.get();
+        for (auto i = 0u; i < selVector->selectedSize; ++i) {
+            auto pos = selVector->selectedPositions[i];
+            auto nbrNodeID = nbrNodeIDVector->getValue<common::nodeID_t>(pos);
+            if (bfsState->isOnCurrentFrontier(nbrNodeID)) {
+                auto edgeID = vectors->reverseRecursiveEdgeIDVector->getValue<common::relID_t>(pos);
+                bfsState->markVisited(nbrNodeID, nodeID, edgeID, 1 /* multiplicity */);
+                // Scans of adjacency lists resume from their previous position, so the remaining
+                // nbrs of the node are dropped before the next node is scanned.
+                reverseRecursiveRoot->resetInputState();
+                return;
+            }
+        }
+    }
+}
+
 void RecursiveJoin::updateVisitedNodes(common::nodeID_t boundNodeID) {
     auto boundNodeMultiplicity = bfsState->getMultiplicity(boundNodeID);
     for (auto i = 0u; i < vectors->recursiveDstNodeIDVector->state->selVector->selectedSize; ++i) {
@@ -191,6 +299,10 @@ void RecursiveJoin::updateVisitedNodes(common::nodeID_t boundNodeID) {
     }
 }
 
+void RecursiveJoin::resetToCurrentSelVector(std::shared_ptr<SelectionVector>& selVector) {
+    selVector = currentSelVector;
+}
+
 void RecursiveJoin::initLocalRecursivePlan(ExecutionContext* context) {
     auto op = recursiveRoot.get();
     while (!op->isSource()) {
@@ -205,6 +317,32 @@ void RecursiveJoin::initLocalRecursivePlan(ExecutionContext* context) {
     vectors->recursiveEdgeIDVector =
         localResultSet->getValueVector(dataInfo->recursiveEdgeIDPos).get();
     recursiveRoot->initLocalState(localResultSet.get(), context);
+    if (reverseRecursiveRoot == nullptr) {
+        return;
+    }
+    op = reverseRecursiveRoot.get();
+    while (!op->isSource()) {
+        assert(op->getNumChildren() == 1);
+        op = op->getChild(0);
+    }
+    reverseScanFrontier = (ScanFrontier*)op;
+    reverseLocalResultSet = std::make_unique<ResultSet>(
+        dataInfo->reverseLocalResultSetDescriptor.get(), context->memoryManager);
+    vectors->reverseRecursiveNbrNodeIDVector =
+        reverseLocalResultSet->getValueVector(dataInfo->reverseRecursiveNbrNodeIDPos).get();
+    vectors->reverseRecursiveEdgeIDVector =
+        reverseLocalResultSet->getValueVector(dataInfo->reverseRecursiveEdgeIDPos).get();
+    reverseRecursiveRoot->initLocalState(reverseLocalResultSet.get(), context);
+}
+
+void RecursiveJoin::populateNumNodesPerTable() {
+    for (auto nodeTable : sharedState->recursiveNodeTables) {
+        auto tableID = nodeTable->getTableID();
+        if (tableID >= numNodesPerTable.size()) {
+            numNodesPerTable.resize(tableID + 1, 0);
+        }
+        numNodesPerTable[tableID] = nodeTable->getMaxNodeOffset(transaction) + 1;
+    }
 }
 
 void RecursiveJoin::populateTargetDstNodes() {
@@ -14,6 +14,14 @@ void RelTableCollectionScanner::init() {
     }
 }
 
+void RelTableCollectionScanner::resetListSyncStates() {
+    for (auto& scanState : scanStates) {
+        if (scanState->relTableDataType == storage::RelTableDataType::LISTS) {
+            scanState->syncState->resetState();
+        }
+    }
+}
+
 bool RelTableCollectionScanner::scan(ValueVector* inVector,
     const std::vector<ValueVector*>& outputVectors, Transaction* transaction) {
     do {
@@ -89,6 +97,13 @@ std::unique_ptr<PhysicalOperator> ScanMultiRelTable::clone() {
         posInfo->copy(), std::move(clonedScanners), children[0]->clone(), id, paramsString);
 }
 
+void ScanMultiRelTable::resetInputStateInternal() {
+    resetState();
+    for (auto& [_, scanner] : scannerPerNodeTable) {
+        scanner->resetListSyncStates();
+    }
+}
+
 void ScanMultiRelTable::resetState() {
     currentScanner = nullptr;
     for (auto& [_, scanner] : scannerPerNodeTable) {
@@ -9,6 +9,16 @@ void ScanColumns::initLocalStateInternal(ResultSet* resultSet, ExecutionContext*
         auto vector = resultSet->getValueVector(dataPos);
         outPropertyVectors.push_back(vector.get());
     }
+    registerPrefetchMetrics(context->profiler);
+}
+
+void ScanColumns::readAhead(storage::NodeTable* table, const std::vector<uint32_t>& columnIds) {
+    auto startOffset = inputNodeIDVector->getValue<common::nodeID_t>(0).offset;
+    storage::PrefetchStats stats;
+    table->prefetch(startOffset,
+        common::BufferPoolConstants::NUM_VECTORS_TO_READ_AHEAD * common::DEFAULT_VECTOR_CAPACITY,
+        columnIds, stats);
+    prefetchMetrics->collect(stats);
 }
 
 } // namespace processor
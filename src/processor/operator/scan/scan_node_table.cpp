@@ -9,6 +9,9 @@ bool ScanSingleNodeTable::getNextTuplesInternal(ExecutionContext* context) {
     if (!children[0]->getNextTuple(context)) {
         return false;
     }
+    if (shouldReadAhead()) {
+        readAhead(table, propertyColumnIds);
+    }
     table->scan(transaction, inputNodeIDVector, propertyColumnIds, outPropertyVectors);
     return true;
 }
@@ -21,6 +24,9 @@ bool ScanMultiNodeTables::getNextTuplesInternal(ExecutionContext* context) {
         inputNodeIDVector
             ->getValue<nodeID_t>(inputNodeIDVector->state->selVector->selectedPositions[0])
             .tableID;
+    if (shouldReadAhead()) {
+        readAhead(tables.at(tableID), tableIDToScanColumnIds.at(tableID));
+    }
     tables.at(tableID)->scan(
         transaction, inputNodeIDVector, tableIDToScanColumnIds.at(tableID), outPropertyVectors);
     return true;
@@ -7,12 +7,14 @@ void ScanRelTableLists::initLocalStateInternal(ResultSet* resultSet, ExecutionCo
     ScanRelTable::initLocalStateInternal(resultSet, context);
     scanState = std::make_unique<storage::RelTableScanState>(
         scanInfo->relStats, scanInfo->propertyIds, storage::RelTableDataType::LISTS);
+    registerPrefetchMetrics(context->profiler);
 }
 
 bool ScanRelTableLists::getNextTuplesInternal(ExecutionContext* context) {
     do {
         if (scanState->syncState->hasMoreAndSwitchSourceIfNecessary()) {
             scanInfo->tableData->scan(transaction, *scanState, inNodeVector, outVectors);
+            prefetchMetrics->collect(scanState->syncState->getPrefetchStats());
             metrics->numOutputTuple.increase(outVectors[0]->state->selVector->selectedSize);
             return true;
         }
@@ -22,6 +24,7 @@ bool ScanRelTableLists::getNextTuplesInternal(ExecutionContext* context) {
         }
         scanState->syncState->resetState();
         scanInfo->tableData->scan(transaction, *scanState, inNodeVector, outVectors);
+        prefetchMetrics->collect(scanState->syncState->getPrefetchStats());
     } while (outVectors[0]->state->selVector->selectedSize == 0);
     metrics->numOutputTuple.increase(outVectors[0]->state->selVector->selectedSize);
     return true;
@@ -5,18 +5,25 @@ using namespace kuzu::common;
 namespace kuzu {
 namespace processor {
 
+static_assert(storage::ZoneMap::NUM_VALUES_PER_ZONE == DEFAULT_VECTOR_CAPACITY,
+    "Zones of zone maps are skipped as morsels.");
+
 std::pair<offset_t, offset_t> NodeTableScanState::getNextRangeToRead() {
     // Note: we use maxNodeOffset=UINT64_MAX to represent an empty table.
     if (currentNodeOffset > maxNodeOffset || maxNodeOffset == INVALID_OFFSET) {
         return std::make_pair(currentNodeOffset, currentNodeOffset);
     }
-    if (isSemiMaskEnabled()) {
+    if (isSemiMaskEnabled() || !zoneMapPredicates.empty()) {
         auto currentMorselIdx = MaskUtil::getMorselIdx(currentNodeOffset);
         assert(currentNodeOffset % DEFAULT_VECTOR_CAPACITY == 0);
-        while (currentMorselIdx <= maxMorselIdx && !semiMask->isMorselMasked(currentMorselIdx)) {
+        while (currentMorselIdx <= maxMorselIdx && !isMorselSelected(currentMorselIdx)) {
             currentMorselIdx++;
         }
-        currentNodeOffset = std::min(currentMorselIdx * DEFAULT_VECTOR_CAPACITY, maxNodeOffset);
+        if (currentMorselIdx > maxMorselIdx) {
+            currentNodeOffset = maxNodeOffset + 1;
+            return std::make_pair(currentNodeOffset, currentNodeOffset);
+        }
+        currentNodeOffset = currentMorselIdx * DEFAULT_VECTOR_CAPACITY;
     }
     auto startOffset = currentNodeOffset;
     auto range = std::min(DEFAULT_VECTOR_CAPACITY, maxNodeOffset + 1 - currentNodeOffset);
@@ -24,6 +31,18 @@ std::pair<offset_t, offset_t> NodeTableScanState::getNextRangeToRead() {
     return std::make_pair(startOffset, startOffset + range);
 }
 
+bool NodeTableScanState::isMorselSelected(uint64_t morselIdx) {
+    if (isSemiMaskEnabled() && !semiMask->isMorselMasked(morselIdx)) {
+        return false;
+    }
+    for (auto& [zoneMap, predicate] : zoneMapPredicates) {
+        if (!zoneMap->mayMatch(morselIdx, predicate)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 std::tuple<NodeTableScanState*, offset_t, offset_t> ScanNodeIDSharedState::getNextRangeToRead() {
     std::unique_lock lck{mtx};
     if (currentStateIdx == tableStates.size()) {
@@ -1,8 +1,8 @@
 #include "processor/processor.h"
 
-#include "processor/operator/aggregate/base_aggregate.h"
 #include "processor/operator/copy/copy.h"
 #include "processor/operator/copy/copy_node.h"
+#include "processor/operator/hash_join/hash_join_build.h"
 #include "processor/operator/result_collector.h"
 #include "processor/operator/sink.h"
 #include "processor/processor_task.h"
@@ -13,12 +13,13 @@ using namespace kuzu::storage;
 namespace kuzu {
 namespace processor {
 
-QueryProcessor::QueryProcessor(uint64_t numThreads) {
-    taskScheduler = std::make_unique<TaskScheduler>(numThreads);
+QueryProcessor::QueryProcessor(uint64_t numThreads, bool pinThreadsToNUMANodes) {
+    taskScheduler = std::make_unique<TaskScheduler>(numThreads, pinThreadsToNUMANodes);
 }
 
 std::shared_ptr<FactorizedTable> QueryProcessor::execute(
     PhysicalPlan* physicalPlan, ExecutionContext* context) {
+    context->taskScheduler = taskScheduler.get();
     if (physicalPlan->isCopyRel()) {
         auto copy = (Copy*)physicalPlan->lastOperator.get();
         auto outputMsg = copy->execute(taskScheduler.get(), context);
@@ -36,6 +37,9 @@ std::shared_ptr<FactorizedTable> QueryProcessor::execute(
         // one.
         auto task = std::make_shared<ProcessorTask>(resultCollector, context);
         decomposePlanIntoTasks(lastOperator, nullptr, task.get(), context);
+        if (canExecuteChildTasksConcurrently(lastOperator)) {
+            setIndependentChildTasks(task.get());
+        }
         taskScheduler->scheduleTaskAndWaitOrError(task, context);
         return resultCollector->getResultFactorizedTable();
     }
@@ -45,15 +49,22 @@ void QueryProcessor::decomposePlanIntoTasks(
     PhysicalOperator* op, PhysicalOperator* parent, Task* parentTask, ExecutionContext* context) {
     if (op->isSink() && parent != nullptr) {
         auto childTask = std::make_unique<ProcessorTask>(reinterpret_cast<Sink*>(op), context);
-        if (op->getOperatorType() == PhysicalOperatorType::AGGREGATE) {
-            auto aggregate = (BaseAggregate*)op;
-            if (aggregate->containDistinctAggregate()) {
-                // Distinct aggregate should be executed in single-thread mode.
-                childTask->setSingleThreadedTask();
-            }
-        }
         decomposePlanIntoTasks(op->getChild(0), op, childTask.get(), context);
-        parentTask->addChildTask(std::move(childTask));
+        if (op->getOperatorType() == PhysicalOperatorType::HASH_JOIN_BUILD ||
+            op->getOperatorType() == PhysicalOperatorType::INTERSECT_BUILD) {
+            // The hash slots of the join hash table are built in parallel by separate tasks once
+            // the build pipeline has merged all its tuples.
+            auto hashTable = reinterpret_cast<HashJoinBuild*>(op)->getSharedState()->getHashTable();
+            auto partitionTuplesTask =
+                std::make_unique<HashJoinPartitionTuplesTask>(hashTable, context->numThreads);
+            partitionTuplesTask->addChildTask(std::move(childTask));
+            auto buildSlotsTask =
+                std::make_unique<HashJoinBuildSlotsTask>(hashTable, context->numThreads);
+            buildSlotsTask->addChildTask(std::move(partitionTuplesTask));
+            parentTask->addChildTask(std::move(buildSlotsTask));
+        } else {
+            parentTask->addChildTask(std::move(childTask));
+        }
     } else {
         // Schedule the right most side (e.g., build side of the hash join) first.
         for (auto i = (int64_t)op->getNumChildren() - 1; i >= 0; --i) {
@@ -88,5 +99,48 @@ void QueryProcessor::decomposePlanIntoTasks(
     }
 }
 
+bool QueryProcessor::canExecuteChildTasksConcurrently(PhysicalOperator* op) {
+    switch (op->getOperatorType()) {
+        // Semi maskers pass information sideways from one pipeline to another (e.g., from the
+        // accumulated probe side to the build side of a hash join). Such pipelines rely on being
+        // executed in the order they are decomposed.
+    case PhysicalOperatorType::SEMI_MASKER:
+        // Pipelines of updates and DDL may conflict with each other and are executed in order.
+    case PhysicalOperatorType::CREATE_NODE_TABLE:
+    case PhysicalOperatorType::CREATE_REL_TABLE:
+    case PhysicalOperatorType::DROP_TABLE:
+    case PhysicalOperatorType::DROP_PROPERTY:
+    case PhysicalOperatorType::ADD_PROPERTY:
+    case PhysicalOperatorType::RENAME_PROPERTY:
+    case PhysicalOperatorType::RENAME_TABLE:
+    case PhysicalOperatorType::SET_NODE_PROPERTY:
+    case PhysicalOperatorType::SET_REL_PROPERTY:
+    case PhysicalOperatorType::CREATE_NODE:
+    case PhysicalOperatorType::CREATE_REL:
+    case PhysicalOperatorType::DELETE_NODE:
+    case PhysicalOperatorType::DELETE_REL:
+    case PhysicalOperatorType::COPY_NODE:
+    case PhysicalOperatorType::COPY_NPY:
+    case PhysicalOperatorType::STANDALONE_CALL:
+    case PhysicalOperatorType::CREATE_MACRO:
+        return false;
+    default:
+        break;
+    }
+    for (auto i = 0u; i < op->getNumChildren(); ++i) {
+        if (!canExecuteChildTasksConcurrently(op->getChild(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void QueryProcessor::setIndependentChildTasks(Task* task) {
+    task->setIndependentChildTasks();
+    for (auto& child : task->children) {
+        setIndependentChildTasks(child.get());
+    }
+}
+
 } // namespace processor
 } // namespace kuzu
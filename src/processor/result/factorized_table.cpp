@@ -86,6 +86,30 @@ void DataBlockCollection::merge(DataBlockCollection& other) {
     }
 }
 
+void DataBlockCollection::unpinBlocks(bool keepLastBlockPinned) {
+    auto numBlocksToUnpin =
+        keepLastBlockPinned && !blocks.empty() ? blocks.size() - 1 : blocks.size();
+    for (auto i = 0u; i < numBlocksToUnpin; i++) {
+        blocks[i]->unpin();
+    }
+}
+
+void DataBlockCollection::unpinFullBlocks() {
+    // Blocks are unpinned as soon as the next block is appended, so the blocks before an unpinned
+    // block are unpinned already.
+    for (auto i = (int64_t)blocks.size() - 2; i >= 0 && blocks[i]->isPinned(); i--) {
+        blocks[i]->unpin();
+    }
+}
+
+uint64_t DataBlockCollection::pinBlocks() {
+    uint64_t numBytesRead = 0;
+    for (auto& block : blocks) {
+        numBytesRead += block->pin();
+    }
+    return numBytesRead;
+}
+
 FactorizedTable::FactorizedTable(
     MemoryManager* memoryManager, std::unique_ptr<FactorizedTableSchema> tableSchema)
     : memoryManager{memoryManager}, tableSchema{std::move(tableSchema)}, numTuples{0} {
@@ -204,6 +228,50 @@ void FactorizedTable::merge(FactorizedTable& other) {
     numTuples += other.numTuples;
 }
 
+void FactorizedTable::unpinBlocks() {
+    if (tableSchema->isEmpty()) {
+        return;
+    }
+    flatTupleBlockCollection->unpinBlocks();
+    unflatTupleBlockCollection->unpinBlocks();
+    inMemOverflowBuffer->unpinBlocks();
+}
+
+void FactorizedTable::unpinBlocksExceptLastFlatTupleBlock() {
+    if (tableSchema->isEmpty()) {
+        return;
+    }
+    flatTupleBlockCollection->unpinBlocks(true /* keepLastBlockPinned */);
+    unflatTupleBlockCollection->unpinBlocks();
+    inMemOverflowBuffer->unpinBlocks();
+}
+
+void FactorizedTable::unpinFullBlocks() {
+    // Unpinning is a no-op without a spill file, so we skip going over the blocks.
+    if (tableSchema->isEmpty() || !memoryManager->canSpill()) {
+        return;
+    }
+    flatTupleBlockCollection->unpinFullBlocks();
+    unflatTupleBlockCollection->unpinFullBlocks();
+    inMemOverflowBuffer->unpinFullBlocks();
+}
+
+uint64_t FactorizedTable::getNumBlocks() const {
+    if (tableSchema->isEmpty()) {
+        return 0;
+    }
+    return flatTupleBlockCollection->getNumBlocks() + unflatTupleBlockCollection->getNumBlocks() +
+           inMemOverflowBuffer->getNumBlocks();
+}
+
+uint64_t FactorizedTable::pinBlocks() {
+    if (tableSchema->isEmpty()) {
+        return 0;
+    }
+    return flatTupleBlockCollection->pinBlocks() + unflatTupleBlockCollection->pinBlocks() +
+           inMemOverflowBuffer->pinBlocks();
+}
+
 bool FactorizedTable::hasUnflatCol() const {
     std::vector<ft_col_idx_t> colIdxes(tableSchema->getNumColumns());
     iota(colIdxes.begin(), colIdxes.end(), 0);
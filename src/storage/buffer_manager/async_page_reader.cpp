@@ -0,0 +1,62 @@
+#include "storage/buffer_manager/async_page_reader.h"
+
+#include "common/exception.h"
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace storage {
+
+AsyncPageReader::AsyncPageReader(uint64_t numThreads) : stopThreads{false} {
+    for (auto i = 0u; i < numThreads; i++) {
+        threads.emplace_back([&] { runReaderThread(); });
+    }
+}
+
+AsyncPageReader::~AsyncPageReader() {
+    {
+        std::unique_lock lck{mtx};
+        stopThreads = true;
+    }
+    cv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void AsyncPageReader::submit(std::vector<PageReadRequest> requestsToSubmit) {
+    if (requestsToSubmit.empty()) {
+        return;
+    }
+    {
+        std::unique_lock lck{mtx};
+        for (auto& request : requestsToSubmit) {
+            requests.push_back(std::move(request));
+        }
+    }
+    cv.notify_all();
+}
+
+void AsyncPageReader::runReaderThread() {
+    while (true) {
+        std::unique_lock lck{mtx};
+        cv.wait(lck, [&] { return !requests.empty() || stopThreads; });
+        if (requests.empty()) {
+            return;
+        }
+        auto request = std::move(requests.front());
+        requests.pop_front();
+        lck.unlock();
+        auto isSuccessful = true;
+        try {
+            FileUtils::readFromFile(request.fileInfo, request.buffers, request.fileOffset);
+        } catch (Exception& e) {
+            // The pages are read again synchronously when pinned, which reports the error.
+            isSuccessful = false;
+        }
+        request.onCompletion(isSuccessful);
+    }
+}
+
+} // namespace storage
+} // namespace kuzu
@@ -17,8 +17,8 @@ WALPageIdxGroup::WALPageIdxGroup() {
 
 BMFileHandle::BMFileHandle(const std::string& path, uint8_t flags, BufferManager* bm,
     common::PageSizeClass pageSizeClass, FileVersionedType fileVersionedType)
-    : FileHandle{path, flags}, bm{bm}, pageSizeClass{pageSizeClass}, fileVersionedType{
-                                                                         fileVersionedType} {
+    : FileHandle{path, flags}, bm{bm}, pageSizeClass{pageSizeClass},
+      fileVersionedType{fileVersionedType}, numPendingPageReads{0} {
     initPageStatesAndGroups();
 }
 
@@ -73,6 +73,7 @@ void BMFileHandle::resetToZeroPagesAndPageCapacity() {
 }
 
 void BMFileHandle::removePageIdxAndTruncateIfNecessary(common::page_idx_t pageIdx) {
+    waitForPendingPageReads();
     std::unique_lock xLck{fhSharedMutex};
     if (numPages <= pageIdx) {
         return;
@@ -14,9 +14,9 @@ namespace storage {
 // remove the candidate from the queue.
 // 2) If the candidate page's state is UNLOCKED, and its page version hasn't changed, which means
 // the page was optimistically read, we give a second chance to evict the page by marking the page
-// as MARKED, and moving the candidate to the back of the queue.
+// as MARKED, and moving the candidate to the back of the secondChanceQueue.
 // 3) If the candidate page's state is LOCKED, we remove the candidate from the queue.
-void EvictionQueue::removeNonEvictableCandidates() {
+void EvictionQueue::removeNonEvictableCandidates(EvictionQueue& secondChanceQueue) {
     std::shared_lock sLck{mtx};
     while (true) {
         EvictionCandidate evictionCandidate;
@@ -30,7 +30,11 @@ void EvictionQueue::removeNonEvictableCandidates() {
         } else if (evictionCandidate.isSecondChanceEvictable(pageStateAndVersion)) {
             // The page was optimistically read, mark it as MARKED, and enqueue to be evicted later.
             evictionCandidate.pageState->tryMark(pageStateAndVersion);
-            queue->enqueue(evictionCandidate);
+            if (&secondChanceQueue == this) {
+                queue->enqueue(evictionCandidate);
+            } else {
+                secondChanceQueue.enqueue(evictionCandidate);
+            }
             continue;
         } else {
             // Cases to remove the candidate from the queue:
@@ -56,9 +60,10 @@ void EvictionQueue::removeCandidatesForFile(kuzu::storage::BMFileHandle& fileHan
     }
 }
 
-BufferManager::BufferManager(uint64_t bufferPoolSize)
+BufferManager::BufferManager(uint64_t bufferPoolSize, EvictionPolicy evictionPolicy)
     : logger{LoggerUtils::getLogger(common::LoggerConstants::LoggerEnum::BUFFER_MANAGER)},
-      usedMemory{0}, bufferPoolSize{bufferPoolSize}, numEvictionQueueInsertions{0} {
+      usedMemory{0}, bufferPoolSize{bufferPoolSize}, numEvictionQueueInsertions{0},
+      evictionPolicy{evictionPolicy} {
     logger->info("Done initializing buffer manager.");
     if (bufferPoolSize < BufferPoolConstants::PAGE_4KB_SIZE) {
         throw BufferManagerException("The given buffer pool size should be at least 4KB.");
@@ -66,9 +71,19 @@ BufferManager::BufferManager(uint64_t bufferPoolSize)
     vmRegions.resize(2);
     vmRegions[0] = std::make_unique<VMRegion>(
         PageSizeClass::PAGE_4KB, BufferPoolConstants::DEFAULT_VM_REGION_MAX_SIZE);
-    vmRegions[1] = std::make_unique<VMRegion>(PageSizeClass::PAGE_256KB, bufferPoolSize);
+    // The 256KB region is not capped by the buffer pool size, because pages of the spill file of
+    // the MemoryManager are addressable even if most of them are evicted to disk.
+    vmRegions[1] = std::make_unique<VMRegion>(
+        PageSizeClass::PAGE_256KB, BufferPoolConstants::DEFAULT_VM_REGION_MAX_SIZE);
     evictionQueue =
         std::make_unique<EvictionQueue>(bufferPoolSize / BufferPoolConstants::PAGE_4KB_SIZE);
+    probationaryEvictionQueue = std::make_unique<EvictionQueue>(
+        evictionPolicy == EvictionPolicy::SCAN_RESISTANT ?
+            bufferPoolSize / BufferPoolConstants::PAGE_4KB_SIZE /
+                BufferPoolConstants::PROBATIONARY_EVICTION_QUEUE_SIZE_DIVISOR :
+            0);
+    asyncPageReader =
+        std::make_unique<AsyncPageReader>(BufferPoolConstants::NUM_ASYNC_PAGE_READER_THREADS);
 }
 
 // Important Note: Pin returns a raw pointer to the frame. This is potentially very dangerous and
@@ -109,7 +124,7 @@ uint8_t* BufferManager::pin(
 }
 
 void BufferManager::optimisticRead(BMFileHandle& fileHandle, common::page_idx_t pageIdx,
-    const std::function<void(uint8_t*)>& func) {
+    const std::function<void(uint8_t*)>& func, AccessHint accessHint) {
     auto pageState = fileHandle.getPageState(pageIdx);
     while (true) {
         auto currStateAndVersion = pageState->getStateAndVersion();
@@ -121,6 +136,14 @@ void BufferManager::optimisticRead(BMFileHandle& fileHandle, common::page_idx_t
             }
         } break;
         case PageState::MARKED: {
+            if (isScanResistantAccess(accessHint)) {
+                // Scans read marked pages like unlocked ones, so the pages stay evictable.
+                func(getFrame(fileHandle, pageIdx));
+                if (pageState->getStateAndVersion() == currStateAndVersion) {
+                    return;
+                }
+                break;
+            }
             // If the page is marked, we try to switch to unlocked. If we succeed, we read the page.
             if (pageState->tryClearMark(currStateAndVersion)) {
                 func(getFrame(fileHandle, pageIdx));
@@ -129,7 +152,7 @@ void BufferManager::optimisticRead(BMFileHandle& fileHandle, common::page_idx_t
         } break;
         case PageState::EVICTED: {
             pin(fileHandle, pageIdx, PageReadPolicy::READ_PAGE);
-            unpin(fileHandle, pageIdx);
+            unpin(fileHandle, pageIdx, accessHint);
         } break;
         default: {
             // When locked, continue the spinning.
@@ -139,10 +162,92 @@ void BufferManager::optimisticRead(BMFileHandle& fileHandle, common::page_idx_t
     }
 }
 
-void BufferManager::unpin(BMFileHandle& fileHandle, page_idx_t pageIdx) {
+void BufferManager::unpin(BMFileHandle& fileHandle, page_idx_t pageIdx, AccessHint accessHint) {
     auto pageState = fileHandle.getPageState(pageIdx);
     pageState->unlock();
-    addToEvictionQueue(&fileHandle, pageIdx, pageState);
+    addToEvictionQueue(&fileHandle, pageIdx, pageState, accessHint);
+}
+
+void BufferManager::prefetch(BMFileHandle& fileHandle, page_idx_t startPageIdx, uint64_t numPages,
+    PrefetchStats& stats) {
+    auto endPageIdx = std::min(startPageIdx + numPages, (uint64_t)fileHandle.getNumPages());
+    std::vector<PageReadRequest> requests;
+    // Consecutive evicted pages are read as a single extent.
+    page_idx_t extentStartPageIdx = 0;
+    std::vector<PageState*> extentPageStates;
+    auto appendExtentReadRequest = [&]() {
+        if (!extentPageStates.empty()) {
+            stats.numPagesPrefetched += extentPageStates.size();
+            requests.push_back(createExtentReadRequest(
+                fileHandle, extentStartPageIdx, std::move(extentPageStates)));
+            extentPageStates.clear();
+        }
+    };
+    for (auto pageIdx = startPageIdx; pageIdx < endPageIdx; pageIdx++) {
+        auto pageState = fileHandle.getPageState(pageIdx);
+        auto currStateAndVersion = pageState->getStateAndVersion();
+        if (PageState::getState(currStateAndVersion) != PageState::EVICTED ||
+            !pageState->tryLock(currStateAndVersion)) {
+            // The page is cached, or another thread is reading it.
+            stats.numPageHits++;
+            appendExtentReadRequest();
+            continue;
+        }
+        stats.numPageMisses++;
+        if (!claimAFrame(fileHandle, pageIdx, PageReadPolicy::DONT_READ_PAGE)) {
+            // The buffer pool is full of pinned pages, so the remaining pages are not requested.
+            pageState->resetToEvicted();
+            break;
+        }
+        if (extentPageStates.size() == BufferPoolConstants::MAX_NUM_PAGES_PER_EXTENT) {
+            appendExtentReadRequest();
+        }
+        if (extentPageStates.empty()) {
+            extentStartPageIdx = pageIdx;
+        }
+        extentPageStates.push_back(pageState);
+    }
+    appendExtentReadRequest();
+    asyncPageReader->submit(std::move(requests));
+}
+
+PageReadRequest BufferManager::createExtentReadRequest(
+    BMFileHandle& fileHandle, page_idx_t startPageIdx, std::vector<PageState*> pageStates) {
+    auto buffers = getExtentBuffers(fileHandle, startPageIdx, pageStates.size());
+    fileHandle.numPendingPageReads += pageStates.size();
+    return PageReadRequest{fileHandle.getFileInfo(), startPageIdx * fileHandle.getPageSize(),
+        std::move(buffers),
+        [this, &fileHandle, startPageIdx, pageStates = std::move(pageStates)](bool isSuccessful) {
+            for (auto i = 0u; i < pageStates.size(); i++) {
+                auto pageIdx = startPageIdx + i;
+                if (isSuccessful) {
+                    pageStates[i]->unlock();
+                    addToEvictionQueue(&fileHandle, pageIdx, pageStates[i], AccessHint::SCAN);
+                } else {
+                    releaseFrameForPage(fileHandle, pageIdx);
+                    freeUsedMemory(fileHandle.getPageSize());
+                    pageStates[i]->resetToEvicted();
+                }
+            }
+            fileHandle.numPendingPageReads -= pageStates.size();
+        }};
+}
+
+std::vector<FileBuffer> BufferManager::getExtentBuffers(
+    BMFileHandle& fileHandle, page_idx_t startPageIdx, uint64_t numPages) {
+    // Frames of pages in the same page group are contiguous in the VMRegion, so they share a single
+    // buffer. A new buffer only starts at the first page of each page group.
+    auto pageSize = fileHandle.getPageSize();
+    std::vector<FileBuffer> buffers;
+    for (auto pageIdx = startPageIdx; pageIdx < startPageIdx + numPages; pageIdx++) {
+        auto frame = getFrame(fileHandle, pageIdx);
+        if (!buffers.empty() && buffers.back().buffer + buffers.back().numBytes == frame) {
+            buffers.back().numBytes += pageSize;
+        } else {
+            buffers.push_back(FileBuffer{frame, pageSize});
+        }
+    }
+    return buffers;
 }
 
 // This function tries to load the given page into a frame. Due to our design of mmap, each page is
@@ -150,21 +255,32 @@ void BufferManager::unpin(BMFileHandle& fileHandle, page_idx_t pageIdx) {
 // memory is available.
 // First, we reserve the memory for the page, which increments the atomic counter `usedMemory`.
 // Then, we check if there is enough memory available. If not, we evict pages until we have enough
-// or we can find no more pages to be evicted.
+// or we can find no more pages to be evicted. Candidates of the probationary queue are evicted
+// before those of the main queue, and second chance evictable candidates are moved to the main
+// queue.
 // Lastly, we double check if the needed memory is available. If not, we free the memory we reserved
 // and return false, otherwise, we load the page to its corresponding frame and return true.
 bool BufferManager::claimAFrame(
     BMFileHandle& fileHandle, common::page_idx_t pageIdx, PageReadPolicy pageReadPolicy) {
-    page_offset_t pageSizeToClaim = fileHandle.getPageSize();
-    // Reserve the memory for the page.
-    auto currentUsedMem = reserveUsedMemory(pageSizeToClaim);
+    if (!reserveMemory(fileHandle.getPageSize())) {
+        return false;
+    }
+    // Have enough memory available now, load the page into its corresponding frame.
+    cachePageIntoFrame(fileHandle, pageIdx, pageReadPolicy);
+    return true;
+}
+
+bool BufferManager::reserveMemory(uint64_t size) {
+    auto currentUsedMem = reserveUsedMemory(size);
     uint64_t claimedMemory = 0;
     // Evict pages if necessary until we have enough memory.
-    while ((currentUsedMem + pageSizeToClaim - claimedMemory) > bufferPoolSize.load()) {
+    while ((currentUsedMem + size - claimedMemory) > bufferPoolSize.load()) {
         EvictionCandidate evictionCandidate;
-        if (!evictionQueue->dequeue(evictionCandidate)) {
-            // Cannot find more pages to be evicted. Free the memory we reserved and return false.
-            freeUsedMemory(pageSizeToClaim);
+        if (!probationaryEvictionQueue->dequeue(evictionCandidate) &&
+            !evictionQueue->dequeue(evictionCandidate)) {
+            // Cannot find more pages to be evicted. Free the memory we reserved, as well as the
+            // memory of the evicted pages, and return false.
+            freeUsedMemory(size + claimedMemory);
             return false;
         }
         auto pageStateAndVersion = evictionCandidate.pageState->getStateAndVersion();
@@ -181,29 +297,51 @@ bool BufferManager::claimAFrame(
         claimedMemory += tryEvictPage(evictionCandidate);
         currentUsedMem = usedMemory.load();
     }
-    if ((currentUsedMem + pageSizeToClaim - claimedMemory) > bufferPoolSize.load()) {
+    if ((currentUsedMem + size - claimedMemory) > bufferPoolSize.load()) {
         // Cannot claim the memory needed. Free the memory we reserved and return false.
-        freeUsedMemory(pageSizeToClaim);
+        freeUsedMemory(size + claimedMemory);
         return false;
     }
-    // Have enough memory available now, load the page into its corresponding frame.
-    cachePageIntoFrame(fileHandle, pageIdx, pageReadPolicy);
     freeUsedMemory(claimedMemory);
     return true;
 }
 
-void BufferManager::addToEvictionQueue(
-    BMFileHandle* fileHandle, common::page_idx_t pageIdx, PageState* pageState) {
+void BufferManager::addToEvictionQueue(BMFileHandle* fileHandle, common::page_idx_t pageIdx,
+    PageState* pageState, AccessHint accessHint) {
     auto currStateAndVersion = pageState->getStateAndVersion();
     if (++numEvictionQueueInsertions == BufferPoolConstants::EVICTION_QUEUE_PURGING_INTERVAL) {
-        evictionQueue->removeNonEvictableCandidates();
+        probationaryEvictionQueue->removeNonEvictableCandidates(*evictionQueue);
+        evictionQueue->removeNonEvictableCandidates(*evictionQueue);
         numEvictionQueueInsertions = 0;
     }
     pageState->tryMark(currStateAndVersion);
-    evictionQueue->enqueue(
+    if (!isScanResistantAccess(accessHint)) {
+        evictionQueue->enqueue(
+            fileHandle, pageIdx, pageState, PageState::getVersion(currStateAndVersion));
+        return;
+    }
+    if (probationaryEvictionQueue->isFull()) {
+        evictOrPromoteProbationaryCandidate();
+    }
+    probationaryEvictionQueue->enqueue(
         fileHandle, pageIdx, pageState, PageState::getVersion(currStateAndVersion));
 }
 
+void BufferManager::evictOrPromoteProbationaryCandidate() {
+    EvictionCandidate candidate;
+    if (!probationaryEvictionQueue->dequeue(candidate)) {
+        return;
+    }
+    auto pageStateAndVersion = candidate.pageState->getStateAndVersion();
+    if (candidate.isEvictable(pageStateAndVersion)) {
+        freeUsedMemory(tryEvictPage(candidate));
+    } else if (candidate.isSecondChanceEvictable(pageStateAndVersion)) {
+        candidate.pageState->tryMark(pageStateAndVersion);
+        evictionQueue->enqueue(candidate);
+    }
+    // Otherwise, the page is pinned, or it was pinned and unpinned and has a newer candidate.
+}
+
 uint64_t BufferManager::tryEvictPage(EvictionCandidate& candidate) {
     auto& pageState = *candidate.pageState;
     auto currStateAndVersion = pageState.getStateAndVersion();
@@ -240,20 +378,56 @@ void BufferManager::flushIfDirtyWithoutLock(BMFileHandle& fileHandle, common::pa
 }
 
 void BufferManager::removeFilePagesFromFrames(BMFileHandle& fileHandle) {
+    fileHandle.waitForPendingPageReads();
     evictionQueue->removeCandidatesForFile(fileHandle);
+    probationaryEvictionQueue->removeCandidatesForFile(fileHandle);
     for (auto pageIdx = 0u; pageIdx < fileHandle.getNumPages(); ++pageIdx) {
         removePageFromFrame(fileHandle, pageIdx, false /* do not flush */);
     }
 }
 
 void BufferManager::flushAllDirtyPagesInFrames(BMFileHandle& fileHandle) {
+    fileHandle.waitForPendingPageReads();
+    // Runs of consecutive dirty pages are written as extents. Pages of an extent stay LOCKED until
+    // the extent is written.
+    page_idx_t extentStartPageIdx = 0;
+    uint64_t numPagesInExtent = 0;
+    auto flushExtent = [&]() {
+        if (numPagesInExtent == 0) {
+            return;
+        }
+        FileUtils::writeToFile(fileHandle.getFileInfo(),
+            getExtentBuffers(fileHandle, extentStartPageIdx, numPagesInExtent),
+            extentStartPageIdx * fileHandle.getPageSize());
+        for (auto i = 0u; i < numPagesInExtent; i++) {
+            releaseFrameForPage(fileHandle, extentStartPageIdx + i);
+            fileHandle.getPageState(extentStartPageIdx + i)->resetToEvicted();
+        }
+        numPagesInExtent = 0;
+    };
     for (auto pageIdx = 0u; pageIdx < fileHandle.getNumPages(); ++pageIdx) {
-        removePageFromFrame(fileHandle, pageIdx, true /* flush */);
+        auto pageState = fileHandle.getPageState(pageIdx);
+        pageState->spinLock(pageState->getStateAndVersion());
+        if (!pageState->isDirty()) {
+            flushExtent();
+            releaseFrameForPage(fileHandle, pageIdx);
+            pageState->resetToEvicted();
+            continue;
+        }
+        if (numPagesInExtent == BufferPoolConstants::MAX_NUM_PAGES_PER_EXTENT) {
+            flushExtent();
+        }
+        if (numPagesInExtent == 0) {
+            extentStartPageIdx = pageIdx;
+        }
+        numPagesInExtent++;
     }
+    flushExtent();
 }
 
 void BufferManager::updateFrameIfPageIsInFrameWithoutLock(
     BMFileHandle& fileHandle, uint8_t* newPage, page_idx_t pageIdx) {
+    fileHandle.waitForPendingPageReads();
     auto pageState = fileHandle.getPageState(pageIdx);
     if (pageState) {
         memcpy(getFrame(fileHandle, pageIdx), newPage, BufferPoolConstants::PAGE_4KB_SIZE);
@@ -264,6 +438,7 @@ void BufferManager::removePageFromFrameIfNecessary(BMFileHandle& fileHandle, pag
     if (pageIdx >= fileHandle.getNumPages()) {
         return;
     }
+    fileHandle.waitForPendingPageReads();
     removePageFromFrame(fileHandle, pageIdx, false /* do not flush */);
 }
 
@@ -1,9 +1,15 @@
 #include "storage/buffer_manager/memory_manager.h"
 
+#include <fcntl.h>
+
 #include <cstring>
+#include <random>
 
+#include "common/exception.h"
+#include "common/file_utils.h"
 #include "common/utils.h"
 #include "storage/buffer_manager/buffer_manager.h"
+#include "storage/storage_utils.h"
 
 using namespace kuzu::common;
 
@@ -11,21 +17,72 @@ namespace kuzu {
 namespace storage {
 
 MemoryBuffer::MemoryBuffer(MemoryAllocator* allocator, page_idx_t pageIdx, uint8_t* buffer)
-    : buffer{buffer}, pageIdx{pageIdx}, allocator{allocator} {}
+    : buffer{buffer}, pageIdx{pageIdx}, allocator{allocator}, pinned{true} {}
 
 MemoryBuffer::~MemoryBuffer() {
     if (buffer != nullptr) {
-        allocator->freeBlock(pageIdx);
+        allocator->freeBlock(pageIdx, pinned);
+    }
+}
+
+void MemoryBuffer::unpin() {
+    if (!pinned || !allocator->canSpill()) {
+        return;
     }
+    allocator->unpinBlock(pageIdx);
+    pinned = false;
 }
 
-MemoryAllocator::MemoryAllocator(BufferManager* bm) : bm{bm} {
+uint64_t MemoryBuffer::pin() {
+    if (pinned) {
+        return 0;
+    }
+    auto numBytesRead = allocator->pinBlock(pageIdx);
+    pinned = true;
+    return numBytesRead;
+}
+
+MemoryAllocator::MemoryAllocator(BufferManager* bm, const std::string& spillDirectory) : bm{bm} {
     pageSize = BufferPoolConstants::PAGE_256KB_SIZE;
-    fh = bm->getBMFileHandle("mm-256KB", FileHandle::O_IN_MEM_TEMP_FILE,
-        BMFileHandle::FileVersionedType::NON_VERSIONED_FILE, PAGE_256KB);
+    if (!spillDirectory.empty()) {
+        spillFilePath = createSpillFile(spillDirectory);
+        fh = bm->getBMFileHandle(spillFilePath,
+            FileHandle::O_PERSISTENT_LARGE_PAGED_FILE_CREATE_NOT_EXISTS,
+            BMFileHandle::FileVersionedType::NON_VERSIONED_FILE, PAGE_256KB);
+    } else {
+        fh = bm->getBMFileHandle("mm-256KB", FileHandle::O_IN_MEM_TEMP_FILE,
+            BMFileHandle::FileVersionedType::NON_VERSIONED_FILE, PAGE_256KB);
+    }
 }
 
-MemoryAllocator::~MemoryAllocator() = default;
+MemoryAllocator::~MemoryAllocator() {
+    fh.reset();
+    if (canSpill()) {
+        FileUtils::removeFileIfExists(spillFilePath);
+    }
+}
+
+std::string MemoryAllocator::createSpillFile(const std::string& directory) {
+    std::random_device randomDevice;
+    std::mt19937_64 generator{randomDevice()};
+    while (true) {
+        auto path = StorageUtils::getSpillFilePath(directory, generator());
+        // Spill files left by processes that did not shut down cleanly are never reused, because
+        // another process may still own them.
+        if (FileUtils::fileOrPathExists(path)) {
+            continue;
+        }
+        try {
+            FileUtils::openFile(path, O_RDWR | O_CREAT | O_EXCL);
+            return path;
+        } catch (Exception& e) {
+            // Another memory manager created a file with the same name in the meantime.
+            if (!FileUtils::fileOrPathExists(path)) {
+                throw;
+            }
+        }
+    }
+}
 
 std::unique_ptr<MemoryBuffer> MemoryAllocator::allocateBuffer(bool initializeToZero) {
     std::unique_lock<std::mutex> lock(allocatorLock);
@@ -44,11 +101,27 @@ std::unique_ptr<MemoryBuffer> MemoryAllocator::allocateBuffer(bool initializeToZ
     return memoryBuffer;
 }
 
-void MemoryAllocator::freeBlock(page_idx_t pageIdx) {
+void MemoryAllocator::freeBlock(page_idx_t pageIdx, bool pinned) {
     std::unique_lock<std::mutex> lock(allocatorLock);
-    bm->unpin(*fh, pageIdx);
+    // An unpinned block is already evictable, and its content is not needed anymore. The next
+    // allocation of the page pins it without reading it back from the spill file.
+    if (pinned) {
+        bm->unpin(*fh, pageIdx);
+    }
     freePages.push(pageIdx);
 }
 
+void MemoryAllocator::unpinBlock(page_idx_t pageIdx) {
+    // The page is written to the spill file only if the buffer manager decides to evict it.
+    fh->setLockedPageDirty(pageIdx);
+    bm->unpin(*fh, pageIdx);
+}
+
+uint64_t MemoryAllocator::pinBlock(page_idx_t pageIdx) {
+    auto isSpilled = fh->isPageEvicted(pageIdx);
+    bm->pin(*fh, pageIdx, BufferManager::PageReadPolicy::READ_PAGE);
+    return isSpilled ? pageSize : 0;
+}
+
 } // namespace storage
 } // namespace kuzu
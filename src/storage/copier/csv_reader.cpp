@@ -0,0 +1,543 @@
+#include "storage/copier/csv_reader.h"
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <deque>
+
+#include "common/string_utils.h"
+#include "common/task_system/parallel_for_task.h"
+#include "storage/copier/table_copy_utils.h"
+#include <arrow/buffer_builder.h>
+#include <arrow/util/bit_util.h>
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace storage {
+
+static constexpr uint64_t LOW_BITS_OF_BYTES = 0x0101010101010101ull;
+static constexpr uint64_t HIGH_BITS_OF_BYTES = 0x8080808080808080ull;
+
+// Up to 4 characters, which are searched 8 bytes at a time.
+class CSVSpecialChars {
+public:
+    CSVSpecialChars(char c0, char c1, char c2, char c3) : chars{c0, c1, c2, c3} {
+        for (auto i = 0u; i < 4; i++) {
+            patterns[i] = LOW_BITS_OF_BYTES * (uint8_t)chars[i];
+        }
+    }
+
+    // Returns the position of the first special character in [data, end), or end.
+    inline const char* findFirst(const char* data, const char* end) const {
+        while (end - data >= 8) {
+            uint64_t word;
+            memcpy(&word, data, 8);
+            if (hasByte(word, patterns[0]) | hasByte(word, patterns[1]) |
+                hasByte(word, patterns[2]) | hasByte(word, patterns[3])) {
+                break;
+            }
+            data += 8;
+        }
+        while (data < end && !contains(*data)) {
+            data++;
+        }
+        return data;
+    }
+
+private:
+    inline bool contains(char c) const {
+        return c == chars[0] || c == chars[1] || c == chars[2] || c == chars[3];
+    }
+
+    // Non-zero iff a byte of the word is the byte repeated in the pattern.
+    static inline uint64_t hasByte(uint64_t word, uint64_t pattern) {
+        auto x = word ^ pattern;
+        return (x - LOW_BITS_OF_BYTES) & ~x & HIGH_BITS_OF_BYTES;
+    }
+
+private:
+    char chars[4];
+    uint64_t patterns[4];
+};
+
+struct CSVField {
+    std::string_view value;
+    bool isQuoted;
+};
+
+// Splits rows into fields, and removes the quotes and escapes of the fields.
+class CSVRowTokenizer {
+public:
+    explicit CSVRowTokenizer(const CSVReaderConfig& csvReaderConfig)
+        : delimiter{csvReaderConfig.delimiter}, quoteChar{csvReaderConfig.quoteChar},
+          unquotedSpecialChars{csvReaderConfig.delimiter, csvReaderConfig.quoteChar,
+              csvReaderConfig.escapeChar, '\n'},
+          quotedSpecialChars{csvReaderConfig.quoteChar, csvReaderConfig.escapeChar,
+              csvReaderConfig.quoteChar, csvReaderConfig.escapeChar},
+          numFields{0} {}
+
+    // Returns the position after the terminator of the row that starts at data.
+    inline const char* tokenize(const char* data, const char* end) {
+        numFields = 0;
+        auto isLastField = false;
+        while (!isLastField) {
+            data = tokenizeField(data, end, isLastField);
+        }
+        return data;
+    }
+
+    inline uint64_t getNumFields() const { return numFields; }
+    inline const CSVField& getField(uint64_t fieldIdx) const { return fields[fieldIdx]; }
+
+private:
+    const char* tokenizeField(const char* data, const char* end, bool& isLastField);
+
+private:
+    char delimiter;
+    char quoteChar;
+    CSVSpecialChars unquotedSpecialChars;
+    CSVSpecialChars quotedSpecialChars;
+    std::vector<CSVField> fields;
+    // The values of the fields with quotes or escapes. Other fields are views of the row. A deque
+    // keeps the values in place when it grows, so the views of the values stay valid.
+    std::deque<std::string> unescapedValues;
+    uint64_t numFields;
+};
+
+const char* CSVRowTokenizer::tokenizeField(const char* data, const char* end, bool& isLastField) {
+    if (numFields == fields.size()) {
+        fields.emplace_back();
+        unescapedValues.emplace_back();
+    }
+    auto& field = fields[numFields];
+    auto& unescapedValue = unescapedValues[numFields];
+    numFields++;
+    field.isQuoted = false;
+    auto hasUnescapedValue = false;
+    auto inQuote = false;
+    const char* closingQuote = nullptr;
+    auto runStart = data;
+    auto pos = data;
+    while (true) {
+        pos = inQuote ? quotedSpecialChars.findFirst(pos, end) :
+                        unquotedSpecialChars.findFirst(pos, end);
+        if (pos == end || (!inQuote && (*pos == delimiter || *pos == '\n'))) {
+            isLastField = pos == end || *pos == '\n';
+            auto runEnd = pos;
+            if (isLastField && runEnd > runStart && runEnd[-1] == '\r') {
+                runEnd--;
+            }
+            if (hasUnescapedValue) {
+                unescapedValue.append(runStart, runEnd);
+                field.value = unescapedValue;
+            } else {
+                field.value = std::string_view(runStart, runEnd - runStart);
+            }
+            return pos == end ? end : pos + 1;
+        }
+        if (!inQuote && *pos == quoteChar && pos != data && closingQuote != pos - 1) {
+            // A quote in the middle of a field is a literal.
+            pos++;
+            continue;
+        }
+        if (!hasUnescapedValue) {
+            unescapedValue.clear();
+            hasUnescapedValue = true;
+        }
+        unescapedValue.append(runStart, pos);
+        if (*pos == quoteChar) {
+            if (inQuote) {
+                closingQuote = pos;
+            } else if (closingQuote == pos - 1) {
+                // Two quotes in a row inside quotes.
+                unescapedValue += quoteChar;
+            }
+            field.isQuoted = true;
+            inQuote = !inQuote;
+            pos++;
+        } else {
+            // The escape character.
+            if (pos + 1 < end) {
+                unescapedValue += pos[1];
+            }
+            pos = std::min(pos + 2, end);
+        }
+        runStart = pos;
+    }
+}
+
+// Parses the fields of a column into the buffers of an arrow array.
+class CSVColumnBuilder {
+public:
+    CSVColumnBuilder(std::shared_ptr<arrow::DataType> type, uint64_t columnIdx, row_idx_t numRows)
+        : type{std::move(type)}, columnIdx{columnIdx}, numRows{numRows}, nullCount{0} {
+        TableCopyUtils::throwCopyExceptionIfNotOK(
+            arrow::AllocateEmptyBitmap((int64_t)numRows).Value(&validity));
+    }
+    virtual ~CSVColumnBuilder() = default;
+
+    inline void append(row_idx_t rowIdx, const CSVField& field) {
+        // Only the empty string is treated as NULL.
+        if (field.value.empty() && !field.isQuoted) {
+            nullCount++;
+            appendNull(rowIdx);
+            return;
+        }
+        arrow::bit_util::SetBit(validity->mutable_data(), (int64_t)rowIdx);
+        appendValue(rowIdx, field.value);
+    }
+
+    inline std::shared_ptr<arrow::Array> finish() {
+        std::vector<std::shared_ptr<arrow::Buffer>> buffers{nullCount > 0 ? validity : nullptr};
+        appendBuffers(buffers);
+        return arrow::MakeArray(
+            arrow::ArrayData::Make(type, (int64_t)numRows, std::move(buffers), nullCount));
+    }
+
+protected:
+    virtual void appendNull(row_idx_t rowIdx) = 0;
+    virtual void appendValue(row_idx_t rowIdx, std::string_view value) = 0;
+    virtual void appendBuffers(std::vector<std::shared_ptr<arrow::Buffer>>& buffers) = 0;
+
+    inline void throwConversionError(std::string_view value) const {
+        throw CopyException(StringUtils::string_format(
+            "Invalid: In CSV column #{}: CSV conversion error to {}: invalid value '{}'", columnIdx,
+            type->ToString(), value));
+    }
+
+protected:
+    std::shared_ptr<arrow::DataType> type;
+    uint64_t columnIdx;
+    row_idx_t numRows;
+    int64_t nullCount;
+    std::shared_ptr<arrow::Buffer> validity;
+};
+
+template<typename T>
+class CSVNumericColumnBuilder : public CSVColumnBuilder {
+public:
+    CSVNumericColumnBuilder(
+        std::shared_ptr<arrow::DataType> type, uint64_t columnIdx, row_idx_t numRows)
+        : CSVColumnBuilder{std::move(type), columnIdx, numRows} {
+        TableCopyUtils::throwCopyExceptionIfNotOK(
+            arrow::AllocateBuffer((int64_t)(numRows * sizeof(T))).Value(&values));
+    }
+
+protected:
+    inline void appendNull(row_idx_t rowIdx) override { getValues()[rowIdx] = 0; }
+
+    inline void appendValue(row_idx_t rowIdx, std::string_view value) override {
+        auto begin = value.data();
+        auto end = begin + value.size();
+        if (value.size() > 1 && *begin == '+') {
+            begin++;
+        }
+        auto [ptr, errorCode] = std::from_chars(begin, end, getValues()[rowIdx]);
+        if (errorCode != std::errc() || ptr != end) {
+            throwConversionError(value);
+        }
+    }
+
+    inline void appendBuffers(std::vector<std::shared_ptr<arrow::Buffer>>& buffers) override {
+        buffers.push_back(values);
+    }
+
+private:
+    inline T* getValues() { return reinterpret_cast<T*>(values->mutable_data()); }
+
+private:
+    std::shared_ptr<arrow::Buffer> values;
+};
+
+class CSVBoolColumnBuilder : public CSVColumnBuilder {
+public:
+    CSVBoolColumnBuilder(
+        std::shared_ptr<arrow::DataType> type, uint64_t columnIdx, row_idx_t numRows)
+        : CSVColumnBuilder{std::move(type), columnIdx, numRows} {
+        TableCopyUtils::throwCopyExceptionIfNotOK(
+            arrow::AllocateEmptyBitmap((int64_t)numRows).Value(&values));
+    }
+
+protected:
+    inline void appendNull(row_idx_t rowIdx) override {}
+
+    inline void appendValue(row_idx_t rowIdx, std::string_view value) override {
+        if (value == "true" || value == "True" || value == "TRUE" || value == "1") {
+            arrow::bit_util::SetBit(values->mutable_data(), (int64_t)rowIdx);
+        } else if (value != "false" && value != "False" && value != "FALSE" && value != "0") {
+            throwConversionError(value);
+        }
+    }
+
+    inline void appendBuffers(std::vector<std::shared_ptr<arrow::Buffer>>& buffers) override {
+        buffers.push_back(values);
+    }
+
+private:
+    std::shared_ptr<arrow::Buffer> values;
+};
+
+class CSVStringColumnBuilder : public CSVColumnBuilder {
+public:
+    CSVStringColumnBuilder(
+        std::shared_ptr<arrow::DataType> type, uint64_t columnIdx, row_idx_t numRows)
+        : CSVColumnBuilder{std::move(type), columnIdx, numRows} {
+        TableCopyUtils::throwCopyExceptionIfNotOK(
+            arrow::AllocateBuffer((int64_t)((numRows + 1) * sizeof(int32_t))).Value(&offsets));
+        getOffsets()[0] = 0;
+    }
+
+protected:
+    inline void appendNull(row_idx_t rowIdx) override {
+        getOffsets()[rowIdx + 1] = (int32_t)data.length();
+    }
+
+    inline void appendValue(row_idx_t rowIdx, std::string_view value) override {
+        if (data.length() + value.size() > INT32_MAX) {
+            throw CopyException("Strings of a CSV block are longer than 2GB in total.");
+        }
+        TableCopyUtils::throwCopyExceptionIfNotOK(data.Append(value.data(), value.size()));
+        getOffsets()[rowIdx + 1] = (int32_t)data.length();
+    }
+
+    inline void appendBuffers(std::vector<std::shared_ptr<arrow::Buffer>>& buffers) override {
+        buffers.push_back(offsets);
+        std::shared_ptr<arrow::Buffer> values;
+        TableCopyUtils::throwCopyExceptionIfNotOK(data.Finish(&values));
+        buffers.push_back(std::move(values));
+    }
+
+private:
+    inline int32_t* getOffsets() { return reinterpret_cast<int32_t*>(offsets->mutable_data()); }
+
+private:
+    std::shared_ptr<arrow::Buffer> offsets;
+    arrow::BufferBuilder data;
+};
+
+static std::unique_ptr<CSVColumnBuilder> createColumnBuilder(
+    const std::shared_ptr<arrow::DataType>& type, uint64_t columnIdx, row_idx_t numRows) {
+    switch (type->id()) {
+    case arrow::Type::BOOL: {
+        return std::make_unique<CSVBoolColumnBuilder>(type, columnIdx, numRows);
+    }
+    case arrow::Type::INT16: {
+        return std::make_unique<CSVNumericColumnBuilder<int16_t>>(type, columnIdx, numRows);
+    }
+    case arrow::Type::INT32: {
+        return std::make_unique<CSVNumericColumnBuilder<int32_t>>(type, columnIdx, numRows);
+    }
+    case arrow::Type::INT64: {
+        return std::make_unique<CSVNumericColumnBuilder<int64_t>>(type, columnIdx, numRows);
+    }
+    case arrow::Type::FLOAT: {
+        return std::make_unique<CSVNumericColumnBuilder<float>>(type, columnIdx, numRows);
+    }
+    case arrow::Type::DOUBLE: {
+        return std::make_unique<CSVNumericColumnBuilder<double>>(type, columnIdx, numRows);
+    }
+    case arrow::Type::STRING: {
+        return std::make_unique<CSVStringColumnBuilder>(type, columnIdx, numRows);
+    }
+    default: {
+        throw CopyException(StringUtils::string_format(
+            "Unsupported data type {} for CSV files.", type->ToString()));
+    }
+    }
+}
+
+CSVReader::CSVReader(const std::string& filePath, const CSVReaderConfig& csvReaderConfig,
+    catalog::TableSchema* tableSchema)
+    : filePath{filePath}, csvReaderConfig{csvReaderConfig}, numRows{0} {
+    schema = TableCopyUtils::getCSVSchema(tableSchema);
+    fileInfo = FileUtils::openFile(filePath, O_RDONLY);
+}
+
+void CSVReader::splitIntoBlocks(
+    TaskScheduler& taskScheduler, uint64_t numThreads, uint64_t blockSize) {
+    auto fileSize = (uint64_t)fileInfo->getFileSize();
+    auto startOffset = getStartOffsetOfRows(fileSize);
+    auto numChunks = (fileSize - startOffset + blockSize - 1) / blockSize;
+    // The scans of each chunk, assuming that it starts outside and inside quotes.
+    std::vector<std::array<ChunkScanResult, 2>> scanResults(numChunks);
+    if (numChunks > 0) {
+        auto task = std::make_shared<ParallelForTask>(numChunks,
+            std::min(std::max<uint64_t>(numThreads, 1), numChunks), [&](uint64_t chunkIdx) {
+                auto chunkStartOffset = startOffset + chunkIdx * blockSize;
+                auto numBytes = std::min(blockSize, fileSize - chunkStartOffset);
+                auto buffer = std::make_unique<char[]>(numBytes);
+                FileUtils::readFromFile(fileInfo.get(), buffer.get(), numBytes, chunkStartOffset);
+                // Only the first chunk is known to start at the start of a field.
+                for (auto inQuote : {false, true}) {
+                    scanResults[chunkIdx][inQuote] = scanRowTerminators(buffer.get(), numBytes,
+                        chunkStartOffset, ScanState{inQuote, false, !inQuote && chunkIdx == 0});
+                }
+            });
+        taskScheduler.scheduleTaskAndWaitOrError(task, nullptr /* executionContext */);
+    }
+    // Follow the quote state through the chunks.
+    std::unique_ptr<char[]> buffer;
+    ScanState state;
+    auto blockStartOffset = startOffset;
+    for (auto chunkIdx = 0u; chunkIdx < numChunks; chunkIdx++) {
+        auto chunkStartOffset = startOffset + chunkIdx * blockSize;
+        ChunkScanResult scanResult;
+        // Rescan the chunk if it starts in a state that its scans didn't assume.
+        if (state.escaped ||
+            (state.canOpenQuote != (chunkIdx == 0) && scanResults[chunkIdx][0].startsWithQuote)) {
+            if (!buffer) {
+                buffer = std::make_unique<char[]>(blockSize);
+            }
+            scanResult = scanChunk(chunkStartOffset,
+                std::min(blockSize, fileSize - chunkStartOffset), state, buffer.get());
+        } else {
+            scanResult = scanResults[chunkIdx][state.inQuote];
+        }
+        if (scanResult.numRows > 0) {
+            blocks.emplace_back(
+                blockStartOffset, scanResult.endOffsetOfLastRow, scanResult.numRows);
+            blockStartOffset = scanResult.endOffsetOfLastRow;
+        }
+        state = scanResult.endState;
+    }
+    if (state.inQuote) {
+        throw CopyException(
+            StringUtils::string_format("Unterminated quote at the end of file {}.", filePath));
+    }
+    if (blockStartOffset < fileSize) {
+        // The last row doesn't end with a newline.
+        if (!blocks.empty() && blocks.back().endOffset == blockStartOffset) {
+            blocks.back().endOffset = fileSize;
+            blocks.back().numRows++;
+        } else {
+            blocks.emplace_back(blockStartOffset, fileSize, 1 /* numRows */);
+        }
+    }
+    for (auto& block : blocks) {
+        numRows += block.numRows;
+    }
+}
+
+std::shared_ptr<arrow::RecordBatch> CSVReader::readBlock(block_idx_t blockIdx) const {
+    auto& block = blocks[blockIdx];
+    auto numBytes = block.endOffset - block.startOffset;
+    auto buffer = std::make_unique<char[]>(numBytes);
+    FileUtils::readFromFile(fileInfo.get(), buffer.get(), numBytes, block.startOffset);
+    auto numColumns = (uint64_t)schema->num_fields();
+    std::vector<std::unique_ptr<CSVColumnBuilder>> columnBuilders(numColumns);
+    for (auto i = 0u; i < numColumns; i++) {
+        columnBuilders[i] = createColumnBuilder(schema->field((int)i)->type(), i, block.numRows);
+    }
+    CSVRowTokenizer tokenizer{csvReaderConfig};
+    const char* data = buffer.get();
+    auto end = data + numBytes;
+    for (auto rowIdx = 0u; rowIdx < block.numRows; rowIdx++) {
+        auto rowStart = data;
+        data = tokenizer.tokenize(data, end);
+        if (tokenizer.getNumFields() != numColumns) {
+            auto row = std::string_view(rowStart, data - rowStart);
+            while (!row.empty() && (row.back() == '\n' || row.back() == '\r')) {
+                row.remove_suffix(1);
+            }
+            throw CopyException(StringUtils::string_format(
+                "Invalid: CSV parse error: Expected {} columns, got {}: {}", numColumns,
+                tokenizer.getNumFields(), row));
+        }
+        for (auto i = 0u; i < numColumns; i++) {
+            columnBuilders[i]->append(rowIdx, tokenizer.getField(i));
+        }
+    }
+    assert(data == end);
+    std::vector<std::shared_ptr<arrow::Array>> columns(numColumns);
+    for (auto i = 0u; i < numColumns; i++) {
+        columns[i] = columnBuilders[i]->finish();
+    }
+    return arrow::RecordBatch::Make(schema, (int64_t)block.numRows, std::move(columns));
+}
+
+uint64_t CSVReader::getStartOffsetOfRows(uint64_t fileSize) {
+    if (!csvReaderConfig.hasHeader) {
+        return 0;
+    }
+    // The header is a row, so it ends at the first row terminator.
+    auto bufferSize = std::min<uint64_t>(fileSize, BufferPoolConstants::PAGE_4KB_SIZE);
+    auto buffer = std::make_unique<char[]>(bufferSize);
+    ScanState state;
+    for (uint64_t offset = 0; offset < fileSize; offset += bufferSize) {
+        auto numBytes = std::min(bufferSize, fileSize - offset);
+        FileUtils::readFromFile(fileInfo.get(), buffer.get(), numBytes, offset);
+        for (auto i = 0u; i < numBytes; i++) {
+            auto c = buffer[i];
+            auto canOpenQuote = state.canOpenQuote;
+            state.canOpenQuote = false;
+            if (state.escaped) {
+                state.escaped = false;
+            } else if (c == csvReaderConfig.quoteChar) {
+                // Other quotes are literals in the middle of a field.
+                if (state.inQuote || canOpenQuote) {
+                    state.canOpenQuote = state.inQuote;
+                    state.inQuote = !state.inQuote;
+                }
+            } else if (c == csvReaderConfig.escapeChar) {
+                state.escaped = true;
+            } else if (c == csvReaderConfig.delimiter && !state.inQuote) {
+                state.canOpenQuote = true;
+            } else if (c == '\n' && !state.inQuote) {
+                return offset + i + 1;
+            }
+        }
+    }
+    return fileSize;
+}
+
+CSVReader::ChunkScanResult CSVReader::scanChunk(
+    uint64_t startOffset, uint64_t numBytes, ScanState startState, char* buffer) const {
+    FileUtils::readFromFile(fileInfo.get(), buffer, numBytes, startOffset);
+    return scanRowTerminators(buffer, numBytes, startOffset, startState);
+}
+
+CSVReader::ChunkScanResult CSVReader::scanRowTerminators(
+    const char* data, uint64_t numBytes, uint64_t startOffset, ScanState state) const {
+    CSVSpecialChars specialChars{
+        csvReaderConfig.quoteChar, csvReaderConfig.escapeChar, '\n', csvReaderConfig.delimiter};
+    ChunkScanResult result;
+    result.startsWithQuote = numBytes > 0 && *data == csvReaderConfig.quoteChar;
+    auto pos = data;
+    auto end = data + numBytes;
+    // The position where a quote starts a quoted part of a field.
+    auto openQuotePos = state.canOpenQuote ? pos : nullptr;
+    if (state.escaped && pos < end) {
+        pos++;
+        state.escaped = false;
+    }
+    while ((pos = specialChars.findFirst(pos, end)) < end) {
+        if (*pos == csvReaderConfig.quoteChar) {
+            if (state.inQuote) {
+                state.inQuote = false;
+                openQuotePos = pos + 1;
+            } else if (pos == openQuotePos) {
+                state.inQuote = true;
+            }
+        } else if (*pos == csvReaderConfig.escapeChar) {
+            if (pos + 1 == end) {
+                state.escaped = true;
+                break;
+            }
+            pos++;
+        } else if (!state.inQuote) {
+            if (*pos == '\n') {
+                result.numRows++;
+                result.endOffsetOfLastRow = startOffset + (pos - data) + 1;
+            }
+            openQuotePos = pos + 1;
+        }
+        pos++;
+    }
+    state.canOpenQuote = !state.inQuote && !state.escaped && openQuotePos == end;
+    result.endState = state;
+    return result;
+}
+
+} // namespace storage
+} // namespace kuzu
@@ -7,24 +7,18 @@ using namespace kuzu::common;
 namespace kuzu {
 namespace storage {
 
-void ReadCSVSharedState::countNumRows() {
-    for (auto& filePath : filePaths) {
-        auto csvStreamingReader =
-            TableCopyUtils::createCSVReader(filePath, &csvReaderConfig, tableSchema);
-        std::shared_ptr<arrow::RecordBatch> currBatch;
-        uint64_t numBlocks = 0;
-        std::vector<uint64_t> numRowsPerBlock;
-        while (true) {
-            TableCopyUtils::throwCopyExceptionIfNotOK(csvStreamingReader->ReadNext(&currBatch));
-            if (currBatch == nullptr) {
-                break;
-            }
-            ++numBlocks;
-            auto currNumRows = currBatch->num_rows();
-            numRowsPerBlock.push_back(currNumRows);
-            numRows += currNumRows;
+void ReadCSVSharedState::countNumRows(processor::ExecutionContext* context) {
+    for (auto fileIdx = 0u; fileIdx < filePaths.size(); fileIdx++) {
+        auto& reader = readers[fileIdx];
+        reader = std::make_shared<CSVReader>(filePaths[fileIdx], csvReaderConfig, tableSchema);
+        reader->splitIntoBlocks(*context->taskScheduler, context->numThreads);
+        std::vector<uint64_t> numRowsPerBlock(reader->getNumBlocks());
+        for (auto blockIdx = 0u; blockIdx < reader->getNumBlocks(); blockIdx++) {
+            numRowsPerBlock[blockIdx] = reader->getNumRowsInBlock(blockIdx);
         }
-        fileBlockInfos.emplace(filePath, FileBlockInfo{numBlocks, numRowsPerBlock});
+        fileBlockInfos.emplace(
+            filePaths[fileIdx], FileBlockInfo{reader->getNumBlocks(), numRowsPerBlock});
+        numRows += reader->getNumRows();
     }
 }
 
@@ -37,30 +31,27 @@ std::unique_ptr<ReadFileMorsel> ReadCSVSharedState::getMorsel() {
             return nullptr;
         }
         auto filePath = filePaths[currFileIdx];
-        if (!reader) {
-            reader = TableCopyUtils::createCSVReader(filePath, &csvReaderConfig, tableSchema);
-        }
-        std::shared_ptr<arrow::RecordBatch> recordBatch;
-        TableCopyUtils::throwCopyExceptionIfNotOK(reader->ReadNext(&recordBatch));
-        if (recordBatch == nullptr) {
-            // No more blocks to read in this file.
+        auto& reader = readers[currFileIdx];
+        assert(reader);
+        if (currBlockIdx >= reader->getNumBlocks()) {
+            // No more blocks to read in this file. Morsels keep the reader until they are read.
+            reader.reset();
             currFileIdx++;
             currBlockIdx = 0;
             currRowIdxInCurrFile = 1;
-            reader.reset();
             continue;
         }
-        auto numRowsInBatch = recordBatch->num_rows();
+        auto numRowsInBlock = reader->getNumRowsInBlock(currBlockIdx);
         auto result = std::make_unique<ReadCSVMorsel>(
-            currRowIdx, filePath, currRowIdxInCurrFile, std::move(recordBatch));
-        currRowIdx += numRowsInBatch;
-        currRowIdxInCurrFile += numRowsInBatch;
+            currRowIdx, currBlockIdx, numRowsInBlock, filePath, currRowIdxInCurrFile, reader);
+        currRowIdx += numRowsInBlock;
+        currRowIdxInCurrFile += numRowsInBlock;
         currBlockIdx++;
         return result;
     }
 }
 
-void ReadParquetSharedState::countNumRows() {
+void ReadParquetSharedState::countNumRows(processor::ExecutionContext* context) {
     for (auto& filePath : filePaths) {
         std::unique_ptr<parquet::arrow::FileReader> reader =
             TableCopyUtils::createParquetReader(filePath, tableSchema);
@@ -102,7 +93,7 @@ std::unique_ptr<ReadFileMorsel> ReadParquetSharedState::getMorsel() {
     }
 }
 
-void ReadNPYSharedState::countNumRows() {
+void ReadNPYSharedState::countNumRows(processor::ExecutionContext* context) {
     uint8_t idx = 0;
     uint64_t firstFileRows;
     for (auto& filePath : filePaths) {
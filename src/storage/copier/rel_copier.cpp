@@ -1,5 +1,10 @@
 #include "storage/copier/rel_copier.h"
 
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/util/byte_size.h>
+
 #include "common/string_utils.h"
 #include "storage/copier/rel_copy_executor.h"
 
@@ -20,6 +25,126 @@ PropertyCopyState::PropertyCopyState(LogicalType& dataType) {
     }
 }
 
+uint64_t BufferedRelsMorsel::getNumBytes() const {
+    return arrow::util::TotalBufferSize(*recordBatch) + 2 * numRows * sizeof(offset_t);
+}
+
+void BufferedRelsMorsel::spill(MemoryManager& memoryManager) {
+    assert(!isSpilled);
+    std::shared_ptr<arrow::io::BufferOutputStream> stream;
+    TableCopyUtils::throwCopyExceptionIfNotOK(
+        arrow::io::BufferOutputStream::Create().Value(&stream));
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    TableCopyUtils::throwCopyExceptionIfNotOK(
+        arrow::ipc::MakeStreamWriter(stream, recordBatch->schema()).Value(&writer));
+    TableCopyUtils::throwCopyExceptionIfNotOK(writer->WriteRecordBatch(*recordBatch));
+    TableCopyUtils::throwCopyExceptionIfNotOK(writer->Close());
+    std::shared_ptr<arrow::Buffer> serializedRecordBatch;
+    TableCopyUtils::throwCopyExceptionIfNotOK(stream->Finish().Value(&serializedRecordBatch));
+    appendToSpillBuffers(memoryManager, reinterpret_cast<const uint8_t*>(srcNodeOffsets.data()),
+        numRows * sizeof(offset_t));
+    appendToSpillBuffers(memoryManager, reinterpret_cast<const uint8_t*>(dstNodeOffsets.data()),
+        numRows * sizeof(offset_t));
+    appendToSpillBuffers(
+        memoryManager, serializedRecordBatch->data(), serializedRecordBatch->size());
+    if (!spillBuffers.empty()) {
+        spillBuffers.back()->unpin();
+    }
+    recordBatch.reset();
+    srcNodeOffsets = std::vector<offset_t>{};
+    dstNodeOffsets = std::vector<offset_t>{};
+    isSpilled = true;
+}
+
+void BufferedRelsMorsel::unspillIfNecessary() {
+    if (!isSpilled) {
+        return;
+    }
+    srcNodeOffsets.resize(numRows);
+    dstNodeOffsets.resize(numRows);
+    auto numOffsetBytes = numRows * sizeof(offset_t);
+    readFromSpillBuffers(reinterpret_cast<uint8_t*>(srcNodeOffsets.data()), 0, numOffsetBytes);
+    readFromSpillBuffers(
+        reinterpret_cast<uint8_t*>(dstNodeOffsets.data()), numOffsetBytes, numOffsetBytes);
+    // The arrays of the record batch point into the buffer, so the buffer is owned by Arrow.
+    std::shared_ptr<arrow::Buffer> serializedRecordBatch;
+    TableCopyUtils::throwCopyExceptionIfNotOK(
+        arrow::AllocateBuffer((int64_t)(numSpilledBytes - 2 * numOffsetBytes))
+            .Value(&serializedRecordBatch));
+    readFromSpillBuffers(serializedRecordBatch->mutable_data(), 2 * numOffsetBytes,
+        serializedRecordBatch->size());
+    spillBuffers.clear();
+    std::shared_ptr<arrow::ipc::RecordBatchStreamReader> reader;
+    TableCopyUtils::throwCopyExceptionIfNotOK(
+        arrow::ipc::RecordBatchStreamReader::Open(
+            std::make_shared<arrow::io::BufferReader>(std::move(serializedRecordBatch)))
+            .Value(&reader));
+    TableCopyUtils::throwCopyExceptionIfNotOK(reader->ReadNext(&recordBatch));
+    isSpilled = false;
+}
+
+void BufferedRelsMorsel::appendToSpillBuffers(
+    MemoryManager& memoryManager, const uint8_t* data, uint64_t size) {
+    auto bufferSize = BufferPoolConstants::PAGE_256KB_SIZE;
+    while (size > 0) {
+        auto offsetInBuffer = numSpilledBytes % bufferSize;
+        if (offsetInBuffer == 0) {
+            // Only the buffer being written is pinned.
+            if (!spillBuffers.empty()) {
+                spillBuffers.back()->unpin();
+            }
+            spillBuffers.push_back(memoryManager.allocateBuffer());
+        }
+        auto numBytesToCopy = std::min(size, bufferSize - offsetInBuffer);
+        memcpy(spillBuffers.back()->buffer + offsetInBuffer, data, numBytesToCopy);
+        data += numBytesToCopy;
+        size -= numBytesToCopy;
+        numSpilledBytes += numBytesToCopy;
+    }
+}
+
+void BufferedRelsMorsel::readFromSpillBuffers(uint8_t* data, uint64_t offset, uint64_t size) {
+    auto bufferSize = BufferPoolConstants::PAGE_256KB_SIZE;
+    while (size > 0) {
+        auto& spillBuffer = spillBuffers[offset / bufferSize];
+        auto offsetInBuffer = offset % bufferSize;
+        auto numBytesToCopy = std::min(size, bufferSize - offsetInBuffer);
+        spillBuffer->pin();
+        memcpy(data, spillBuffer->buffer + offsetInBuffer, numBytesToCopy);
+        data += numBytesToCopy;
+        offset += numBytesToCopy;
+        size -= numBytesToCopy;
+    }
+}
+
+void BufferedRelsSharedState::append(std::unique_ptr<BufferedRelsMorsel> morsel) {
+    auto numBytesOfMorsel = morsel->getNumBytes();
+    {
+        std::unique_lock lck{mtx};
+        if (!isMemoryFull) {
+            if (numBytes + numBytesOfMorsel <= maxNumBytes &&
+                memoryManager->getBufferManager()->reserveMemory(numBytesOfMorsel)) {
+                numBytes += numBytesOfMorsel;
+                morsels.push_back(std::move(morsel));
+                return;
+            }
+            isMemoryFull = true;
+        }
+    }
+    morsel->spill(*memoryManager);
+    std::unique_lock lck{mtx};
+    morsels.push_back(std::move(morsel));
+}
+
+std::unique_ptr<ReadFileMorsel> BufferedRelsSharedState::getMorsel() {
+    std::unique_lock lck{mtx};
+    if (nextMorselIdx >= morsels.size()) {
+        // No more morsels.
+        return nullptr;
+    }
+    return std::move(morsels[nextMorselIdx++]);
+}
+
 void RelCopier::execute(ExecutionContext* executionContext) {
     while (true) {
         if (executionContext->clientContext->isInterrupted()) {
@@ -70,35 +195,35 @@ void RelCopier::indexLookup(arrow::Array* pkArray, const LogicalType& pkColumnTy
         }
     } break;
     case LogicalTypeID::INT64: {
-        auto numKeysFound = 0u;
+        auto int64Array = dynamic_cast<arrow::Int64Array*>(pkArray);
+        std::vector<const uint8_t*> keys(length);
         for (auto i = 0u; i < length; i++) {
-            auto val = dynamic_cast<arrow::Int64Array*>(pkArray)->Value(i);
-            numKeysFound += pkIndex->lookup(&transaction::DUMMY_READ_TRANSACTION, val, offsets[i]);
+            keys[i] = reinterpret_cast<const uint8_t*>(int64Array->raw_values() + i);
         }
-        if (numKeysFound != length) {
+        if (pkIndex->lookup(&transaction::DUMMY_READ_TRANSACTION, keys, offsets) != length) {
             for (auto i = 0u; i < length; i++) {
-                auto val = dynamic_cast<arrow::Int64Array*>(pkArray)->Value(i);
-                if (!pkIndex->lookup(&transaction::DUMMY_READ_TRANSACTION, val, offsets[i])) {
-                    errorPKValueStr = std::to_string(val);
+                if (offsets[i] == INVALID_OFFSET) {
+                    errorPKValueStr = std::to_string(int64Array->Value(i));
                     errorPKRowIdx = startRowIdxInFile + i;
+                    break;
                 }
             }
         }
     } break;
     case LogicalTypeID::STRING: {
-        auto numKeysFound = 0u;
+        // The index expects null-terminated keys.
+        std::vector<std::string> stringKeys(length);
+        std::vector<const uint8_t*> keys(length);
         for (auto i = 0u; i < length; i++) {
-            auto val = std::string(dynamic_cast<arrow::StringArray*>(pkArray)->GetView(i));
-            numKeysFound +=
-                pkIndex->lookup(&transaction::DUMMY_READ_TRANSACTION, val.c_str(), offsets[i]);
+            stringKeys[i] = std::string(dynamic_cast<arrow::StringArray*>(pkArray)->GetView(i));
+            keys[i] = reinterpret_cast<const uint8_t*>(stringKeys[i].c_str());
         }
-        if (numKeysFound != length) {
+        if (pkIndex->lookup(&transaction::DUMMY_READ_TRANSACTION, keys, offsets) != length) {
             for (auto i = 0u; i < length; i++) {
-                auto val = std::string(dynamic_cast<arrow::StringArray*>(pkArray)->GetView(i));
-                if (!pkIndex->lookup(
-                        &transaction::DUMMY_READ_TRANSACTION, val.c_str(), offsets[i])) {
-                    errorPKValueStr = val;
+                if (offsets[i] == INVALID_OFFSET) {
+                    errorPKValueStr = stringKeys[i];
                     errorPKRowIdx = startRowIdxInFile + i;
+                    break;
                 }
             }
         }
@@ -148,10 +273,13 @@ void RelCopier::copyRelColumns(offset_t rowIdx, arrow::RecordBatch* recordBatch,
 void RelCopier::countRelListsSize(
     RelDataDirection direction, const std::vector<std::unique_ptr<arrow::Array>>& pkOffsets) {
     auto boundPKOffsets = pkOffsets[direction == FWD ? 0 : 1].get();
+    auto adjPKOffsets = pkOffsets[direction == FWD ? 1 : 0].get();
     auto relData = direction == FWD ? fwdRelData : bwdRelData;
     auto offsets = boundPKOffsets->data()->GetValues<offset_t>(1 /* value buffer */);
+    auto adjOffsets = adjPKOffsets->data()->GetValues<offset_t>(1 /* value buffer */);
     for (auto i = 0u; i < boundPKOffsets->length(); i++) {
         InMemListsUtils::incrementListSize(*relData->lists->relListsSizes, offsets[i], 1);
+        relData->lists->adjList->updateMaxNbrOffset(offsets[i], adjOffsets[i]);
     }
 }
 
@@ -228,9 +356,21 @@ void RelListsCounterAndColumnCopier::finalize() {
     }
 }
 
+void RelListsCounterAndColumnCopier::bufferRelsIfNecessary(ReadFileMorsel* morsel,
+    std::shared_ptr<arrow::RecordBatch> recordBatch, std::vector<offset_t> srcNodeOffsets,
+    std::vector<offset_t> dstNodeOffsets) {
+    if (bufferedRels == nullptr) {
+        return;
+    }
+    bufferedRels->append(std::make_unique<BufferedRelsMorsel>(morsel->rowIdx, morsel->filePath,
+        morsel->rowIdxInFile, std::move(recordBatch), std::move(srcNodeOffsets),
+        std::move(dstNodeOffsets)));
+}
+
 void RelListsCounterAndColumnCopier::buildRelListsMetadata(
     DirectedInMemRelData* directedInMemRelData) {
     auto relListHeaders = directedInMemRelData->lists->adjList->getListHeadersBuilder().get();
+    directedInMemRelData->lists->adjList->initNbrOffsetBitWidths();
     buildRelListsMetadata(directedInMemRelData->lists->adjList.get(), relListHeaders);
     for (auto& [_, propertyRelLists] : directedInMemRelData->lists->propertyLists) {
         buildRelListsMetadata(propertyRelLists.get(), relListHeaders);
@@ -253,8 +393,8 @@ void RelListsCounterAndColumnCopier::buildRelListsMetadata(
     auto numBoundNodes = relListHeaders->getNumValues();
     auto numChunks = StorageUtils::getNumChunks(numBoundNodes);
     offset_t nodeOffset = 0;
-    auto numValuesPerPage = relLists->getNumElementsInAPage();
     for (auto chunkIdx = 0u; chunkIdx < numChunks; chunkIdx++) {
+        auto numValuesPerPage = relLists->getNumElementsInAPage(chunkIdx);
         auto numPagesForChunk = 0u, offsetInPage = 0u;
         auto lastNodeOffsetInChunk =
             std::min(nodeOffset + ListsMetadataConstants::LISTS_CHUNK_SIZE, numBoundNodes);
@@ -327,12 +467,13 @@ void ParquetRelListsCounterAndColumnsCopier::executeInternal(
     copyRelColumnsOrCountRelListsSize(morsel->rowIdx, recordBatch.get(), FWD, pkOffsetsArrays);
     copyRelColumnsOrCountRelListsSize(morsel->rowIdx, recordBatch.get(), BWD, pkOffsetsArrays);
     numRows += numRowsInBatch;
+    bufferRelsIfNecessary(morsel.get(), std::move(recordBatch), std::move(boundPKOffsets),
+        std::move(adjPKOffsets));
 }
 
 void CSVRelListsCounterAndColumnsCopier::executeInternal(std::unique_ptr<ReadFileMorsel> morsel) {
     assert(!morsel->filePath.empty());
-    auto csvRelCopyMorsel = reinterpret_cast<ReadCSVMorsel*>(morsel.get());
-    auto recordBatch = csvRelCopyMorsel->recordBatch;
+    auto recordBatch = reinterpret_cast<ReadCSVMorsel*>(morsel.get())->readRecordBatch();
     auto numRowsInBatch = recordBatch->num_rows();
     std::vector<offset_t> boundPKOffsets, adjPKOffsets;
     boundPKOffsets.resize(numRowsInBatch);
@@ -349,6 +490,8 @@ void CSVRelListsCounterAndColumnsCopier::executeInternal(std::unique_ptr<ReadFil
     copyRelColumnsOrCountRelListsSize(morsel->rowIdx, recordBatch.get(), FWD, pkOffsets);
     copyRelColumnsOrCountRelListsSize(morsel->rowIdx, recordBatch.get(), BWD, pkOffsets);
     numRows += numRowsInBatch;
+    bufferRelsIfNecessary(morsel.get(), std::move(recordBatch), std::move(boundPKOffsets),
+        std::move(adjPKOffsets));
 }
 
 void RelListsCopier::finalize() {
@@ -366,62 +509,21 @@ void RelListsCopier::finalize() {
     }
 }
 
-void ParquetRelListsCopier::executeInternal(std::unique_ptr<ReadFileMorsel> morsel) {
-    assert(!morsel->filePath.empty());
-    if (!reader || filePath != morsel->filePath) {
-        reader = TableCopyUtils::createParquetReader(morsel->filePath, schema);
-        filePath = morsel->filePath;
-    }
-    std::shared_ptr<arrow::Table> table;
-    TableCopyUtils::throwCopyExceptionIfNotOK(
-        reader->RowGroup(static_cast<int>(morsel->blockIdx))->ReadTable(&table));
-    arrow::TableBatchReader batchReader(*table);
-    std::shared_ptr<arrow::RecordBatch> recordBatch;
-    TableCopyUtils::throwCopyExceptionIfNotOK(batchReader.ReadNext(&recordBatch));
-    auto numRowsInBatch = recordBatch->num_rows();
-    std::vector<offset_t> boundPKOffsets, adjPKOffsets;
-    boundPKOffsets.resize(numRowsInBatch);
-    adjPKOffsets.resize(numRowsInBatch);
-    indexLookup(recordBatch->column(0).get(), schema->srcPKDataType, pkIndexes[0],
-        boundPKOffsets.data(), morsel->filePath, morsel->rowIdxInFile);
-    indexLookup(recordBatch->column(1).get(), schema->dstPKDataType, pkIndexes[1],
-        adjPKOffsets.data(), morsel->filePath, morsel->rowIdxInFile);
-    std::vector<std::unique_ptr<arrow::Array>> pkOffsets(2);
-    pkOffsets[0] = createArrowPrimitiveArray(
-        std::make_shared<arrow::Int64Type>(), (uint8_t*)boundPKOffsets.data(), numRowsInBatch);
-    pkOffsets[1] = createArrowPrimitiveArray(
-        std::make_shared<arrow::Int64Type>(), (uint8_t*)adjPKOffsets.data(), numRowsInBatch);
-    if (!fwdRelData->isColumns) {
-        copyRelLists(morsel->rowIdx, recordBatch.get(), FWD, pkOffsets);
-    }
-    if (!bwdRelData->isColumns) {
-        copyRelLists(morsel->rowIdx, recordBatch.get(), BWD, pkOffsets);
-    }
-    numRows += numRowsInBatch;
-}
-
-void CSVRelListsCopier::executeInternal(std::unique_ptr<ReadFileMorsel> morsel) {
-    assert(!morsel->filePath.empty());
-    auto csvRelCopyMorsel = reinterpret_cast<ReadCSVMorsel*>(morsel.get());
-    auto recordBatch = csvRelCopyMorsel->recordBatch;
+void BufferedRelListsCopier::executeInternal(std::unique_ptr<ReadFileMorsel> morsel) {
+    auto bufferedRelsMorsel = static_cast<BufferedRelsMorsel*>(morsel.get());
+    bufferedRelsMorsel->unspillIfNecessary();
+    auto recordBatch = bufferedRelsMorsel->recordBatch.get();
     auto numRowsInBatch = recordBatch->num_rows();
-    std::vector<offset_t> boundPKOffsets, adjPKOffsets;
-    boundPKOffsets.resize(numRowsInBatch);
-    adjPKOffsets.resize(numRowsInBatch);
-    indexLookup(recordBatch->column(0).get(), schema->srcPKDataType, pkIndexes[0],
-        boundPKOffsets.data(), morsel->filePath, morsel->rowIdxInFile);
-    indexLookup(recordBatch->column(1).get(), schema->dstPKDataType, pkIndexes[1],
-        adjPKOffsets.data(), morsel->filePath, morsel->rowIdxInFile);
     std::vector<std::unique_ptr<arrow::Array>> pkOffsets(2);
-    pkOffsets[0] = createArrowPrimitiveArray(
-        std::make_shared<arrow::Int64Type>(), (uint8_t*)boundPKOffsets.data(), numRowsInBatch);
-    pkOffsets[1] = createArrowPrimitiveArray(
-        std::make_shared<arrow::Int64Type>(), (uint8_t*)adjPKOffsets.data(), numRowsInBatch);
+    pkOffsets[0] = createArrowPrimitiveArray(std::make_shared<arrow::Int64Type>(),
+        (uint8_t*)bufferedRelsMorsel->srcNodeOffsets.data(), numRowsInBatch);
+    pkOffsets[1] = createArrowPrimitiveArray(std::make_shared<arrow::Int64Type>(),
+        (uint8_t*)bufferedRelsMorsel->dstNodeOffsets.data(), numRowsInBatch);
     if (!fwdRelData->isColumns) {
-        copyRelLists(morsel->rowIdx, recordBatch.get(), FWD, pkOffsets);
+        copyRelLists(morsel->rowIdx, recordBatch, FWD, pkOffsets);
     }
     if (!bwdRelData->isColumns) {
-        copyRelLists(morsel->rowIdx, recordBatch.get(), BWD, pkOffsets);
+        copyRelLists(morsel->rowIdx, recordBatch, BWD, pkOffsets);
     }
     numRows += numRowsInBatch;
 }
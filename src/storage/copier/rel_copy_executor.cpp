@@ -77,11 +77,18 @@ offset_t RelCopyExecutor::copy(processor::ExecutionContext* executionContext) {
     wal->logCopyRelRecord(table->getRelTableID());
     // We assume that COPY is a single-statement transaction, thus COPY rel is the only wal record.
     wal->flushAllPages();
+    auto hasRelLists = !tableSchema->isSingleMultiplicityInDirection(FWD) ||
+                       !tableSchema->isSingleMultiplicityInDirection(BWD);
+    if (hasRelLists) {
+        bufferedRels = std::make_shared<BufferedRelsSharedState>(copyDescription, tableSchema,
+            executionContext->clientContext->getCopyRelBufferSize(),
+            executionContext->memoryManager);
+    }
     auto numRows = countRelListsSizeAndPopulateColumns(executionContext);
-    if (!tableSchema->isSingleMultiplicityInDirection(FWD) ||
-        !tableSchema->isSingleMultiplicityInDirection(BWD)) {
+    if (hasRelLists) {
         auto numPopulatedRelLists = populateRelLists(executionContext);
         assert(numPopulatedRelLists == numRows);
+        bufferedRels.reset();
     }
     relsStatistics->setNumTuplesForTable(tableSchema->tableID, numRows);
     return numRows;
@@ -89,7 +96,7 @@ offset_t RelCopyExecutor::copy(processor::ExecutionContext* executionContext) {
 
 row_idx_t RelCopyExecutor::countRelListsSizeAndPopulateColumns(
     processor::ExecutionContext* executionContext) {
-    auto relCopier = createRelCopier(RelCopierType::REL_COLUMN_COPIER_AND_LIST_COUNTER);
+    auto relCopier = createRelCopier(executionContext);
     auto sharedState = relCopier->getSharedState();
     auto task = std::make_shared<RelCopyTask>(std::move(relCopier), executionContext);
     taskScheduler.scheduleTaskAndWaitOrError(task, executionContext);
@@ -97,30 +104,26 @@ row_idx_t RelCopyExecutor::countRelListsSizeAndPopulateColumns(
 }
 
 row_idx_t RelCopyExecutor::populateRelLists(processor::ExecutionContext* executionContext) {
-    auto relCopier = createRelCopier(RelCopierType::REL_LIST_COPIER);
+    auto relCopier = std::make_unique<BufferedRelListsCopier>(
+        bufferedRels, copyDescription, tableSchema, fwdRelData.get(), bwdRelData.get());
     auto sharedState = relCopier->getSharedState();
     auto task = std::make_shared<RelCopyTask>(std::move(relCopier), executionContext);
     taskScheduler.scheduleTaskAndWaitOrError(task, executionContext);
     return sharedState->numRows;
 }
 
-std::unique_ptr<RelCopier> RelCopyExecutor::createRelCopier(RelCopierType relCopierType) {
+std::unique_ptr<RelCopier> RelCopyExecutor::createRelCopier(
+    processor::ExecutionContext* executionContext) {
     std::shared_ptr<ReadFileSharedState> sharedState;
     std::unique_ptr<RelCopier> relCopier;
     switch (copyDescription.fileType) {
     case CopyDescription::FileType::CSV: {
         sharedState = std::make_shared<ReadCSVSharedState>(
             copyDescription.filePaths, *copyDescription.csvReaderConfig, tableSchema);
-        switch (relCopierType) {
-        case RelCopierType::REL_COLUMN_COPIER_AND_LIST_COUNTER: {
-            relCopier = std::make_unique<CSVRelListsCounterAndColumnsCopier>(sharedState,
-                copyDescription, tableSchema, fwdRelData.get(), bwdRelData.get(), pkIndexes);
-        } break;
-        case RelCopierType::REL_LIST_COPIER: {
-            relCopier = std::make_unique<CSVRelListsCopier>(std::move(sharedState), copyDescription,
-                tableSchema, fwdRelData.get(), bwdRelData.get(), pkIndexes);
-        } break;
-        }
+        sharedState->countNumRows(executionContext);
+        relCopier = std::make_unique<CSVRelListsCounterAndColumnsCopier>(std::move(sharedState),
+            copyDescription, tableSchema, fwdRelData.get(), bwdRelData.get(), pkIndexes,
+            bufferedRels);
     } break;
     case CopyDescription::FileType::PARQUET: {
         std::unordered_map<std::string, FileBlockInfo> fileBlockInfos;
@@ -128,16 +131,9 @@ std::unique_ptr<RelCopier> RelCopyExecutor::createRelCopier(RelCopierType relCop
         sharedState = std::make_shared<ReadParquetSharedState>(
             copyDescription.filePaths, *copyDescription.csvReaderConfig, tableSchema);
         sharedState->fileBlockInfos = std::move(fileBlockInfos);
-        switch (relCopierType) {
-        case RelCopierType::REL_COLUMN_COPIER_AND_LIST_COUNTER: {
-            relCopier = std::make_unique<ParquetRelListsCounterAndColumnsCopier>(sharedState,
-                copyDescription, tableSchema, fwdRelData.get(), bwdRelData.get(), pkIndexes);
-        } break;
-        case RelCopierType::REL_LIST_COPIER: {
-            relCopier = std::make_unique<ParquetRelListsCopier>(std::move(sharedState),
-                copyDescription, tableSchema, fwdRelData.get(), bwdRelData.get(), pkIndexes);
-        } break;
-        }
+        relCopier = std::make_unique<ParquetRelListsCounterAndColumnsCopier>(
+            std::move(sharedState), copyDescription, tableSchema, fwdRelData.get(),
+            bwdRelData.get(), pkIndexes, bufferedRels);
     } break;
     default: {
         throw NotImplementedException(StringUtils::string_format(
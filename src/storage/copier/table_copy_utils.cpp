@@ -15,9 +15,6 @@ row_idx_t TableCopyUtils::countNumLines(CopyDescription& copyDescription,
     catalog::TableSchema* tableSchema,
     std::unordered_map<std::string, FileBlockInfo>& fileBlockInfos) {
     switch (copyDescription.fileType) {
-    case CopyDescription::FileType::CSV: {
-        return countNumLinesCSV(copyDescription, tableSchema, fileBlockInfos);
-    }
     case CopyDescription::FileType::PARQUET: {
         return countNumLinesParquet(copyDescription, tableSchema, fileBlockInfos);
     }
@@ -31,32 +28,6 @@ row_idx_t TableCopyUtils::countNumLines(CopyDescription& copyDescription,
     }
 }
 
-row_idx_t TableCopyUtils::countNumLinesCSV(CopyDescription& copyDescription,
-    catalog::TableSchema* tableSchema,
-    std::unordered_map<std::string, FileBlockInfo>& fileBlockInfos) {
-    row_idx_t numRows = 0;
-    // TODO: Count each file as a task.
-    for (auto& filePath : copyDescription.filePaths) {
-        auto csvStreamingReader =
-            createCSVReader(filePath, copyDescription.csvReaderConfig.get(), tableSchema);
-        std::shared_ptr<arrow::RecordBatch> currBatch;
-        uint64_t numBlocks = 0;
-        std::vector<uint64_t> numLinesPerBlock;
-        while (true) {
-            throwCopyExceptionIfNotOK(csvStreamingReader->ReadNext(&currBatch));
-            if (currBatch == nullptr) {
-                break;
-            }
-            ++numBlocks;
-            auto currNumRows = currBatch->num_rows();
-            numLinesPerBlock.push_back(currNumRows);
-            numRows += currNumRows;
-        }
-        fileBlockInfos.emplace(filePath, FileBlockInfo{numBlocks, numLinesPerBlock});
-    }
-    return numRows;
-}
-
 row_idx_t TableCopyUtils::countNumLinesParquet(CopyDescription& copyDescription,
     catalog::TableSchema* tableSchema,
     std::unordered_map<std::string, FileBlockInfo>& fileBlockInfos) {
@@ -107,55 +78,22 @@ static bool skipCopyForProperty(const Property& property) {
            property.dataType.getLogicalTypeID() == LogicalTypeID::SERIAL;
 }
 
-std::shared_ptr<arrow::csv::StreamingReader> TableCopyUtils::createCSVReader(
-    const std::string& filePath, CSVReaderConfig* csvReaderConfig,
-    catalog::TableSchema* tableSchema) {
-    std::shared_ptr<arrow::io::InputStream> inputStream;
-    throwCopyExceptionIfNotOK(arrow::io::ReadableFile::Open(filePath).Value(&inputStream));
-    auto csvReadOptions = arrow::csv::ReadOptions::Defaults();
-    csvReadOptions.block_size = CopyConstants::CSV_READING_BLOCK_SIZE;
-    for (auto& columnName : getColumnNamesToRead(tableSchema)) {
-        csvReadOptions.column_names.push_back(columnName);
-    }
-    if (csvReaderConfig->hasHeader) {
-        csvReadOptions.skip_rows = 1;
-    }
-    auto csvParseOptions = arrow::csv::ParseOptions::Defaults();
-    csvParseOptions.delimiter = csvReaderConfig->delimiter;
-    csvParseOptions.escape_char = csvReaderConfig->escapeChar;
-    csvParseOptions.quote_char = csvReaderConfig->quoteChar;
-    csvParseOptions.ignore_empty_lines = false;
-    csvParseOptions.escaping = true;
-
-    auto csvConvertOptions = arrow::csv::ConvertOptions::Defaults();
-    csvConvertOptions.strings_can_be_null = true;
-    // Only the empty string is treated as NULL.
-    csvConvertOptions.null_values = {""};
-    csvConvertOptions.quoted_strings_can_be_null = false;
+std::shared_ptr<arrow::Schema> TableCopyUtils::getCSVSchema(catalog::TableSchema* tableSchema) {
+    arrow::FieldVector fields;
     if (tableSchema->tableType == TableType::REL) {
         auto relTableSchema = (RelTableSchema*)tableSchema;
-        csvConvertOptions.column_types[std::string(Property::REL_FROM_PROPERTY_NAME)] =
-            toArrowDataType(relTableSchema->srcPKDataType);
-        csvConvertOptions.column_types[std::string(Property::REL_TO_PROPERTY_NAME)] =
-            toArrowDataType(relTableSchema->dstPKDataType);
+        fields.push_back(arrow::field(std::string(Property::REL_FROM_PROPERTY_NAME),
+            toArrowDataType(relTableSchema->srcPKDataType)));
+        fields.push_back(arrow::field(std::string(Property::REL_TO_PROPERTY_NAME),
+            toArrowDataType(relTableSchema->dstPKDataType)));
     }
     for (auto& property : tableSchema->properties) {
-        if (property.name == Property::REL_FROM_PROPERTY_NAME ||
-            property.name == Property::REL_TO_PROPERTY_NAME) {
-            csvConvertOptions.column_types[property.name] = arrow::int64();
-            continue;
-        }
         if (skipCopyForProperty(property)) {
             continue;
         }
-        csvConvertOptions.column_types[property.name] = toArrowDataType(property.dataType);
+        fields.push_back(arrow::field(property.name, toArrowDataType(property.dataType)));
     }
-
-    std::shared_ptr<arrow::csv::StreamingReader> csvStreamingReader;
-    throwCopyExceptionIfNotOK(arrow::csv::StreamingReader::Make(arrow::io::default_io_context(),
-        inputStream, csvReadOptions, csvParseOptions, csvConvertOptions)
-                                  .Value(&csvStreamingReader));
-    return csvStreamingReader;
+    return arrow::schema(std::move(fields));
 }
 
 std::unique_ptr<parquet::arrow::FileReader> TableCopyUtils::createParquetReader(
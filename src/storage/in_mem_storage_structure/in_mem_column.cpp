@@ -9,8 +9,15 @@ using namespace kuzu::common;
 namespace kuzu {
 namespace storage {
 
+InMemColumnSegment::InMemColumnSegment(uint64_t numValues, uint64_t numBytesPerValue)
+    : numValuesCopied{0} {
+    values = std::make_unique<uint8_t[]>(numValues * numBytesPerValue);
+    isNull = std::make_unique<bool[]>(numValues);
+    memset(isNull.get(), true, numValues);
+}
+
 InMemColumn::InMemColumn(std::string filePath, LogicalType dataType, bool requireNullBits)
-    : filePath{std::move(filePath)}, dataType{std::move(dataType)} {
+    : filePath{std::move(filePath)}, dataType{std::move(dataType)}, numSegments{0} {
     // TODO(Guodong): Separate this as a function.
     switch (this->dataType.getPhysicalType()) {
     case PhysicalTypeID::STRUCT: {
@@ -32,6 +39,10 @@ InMemColumn::InMemColumn(std::string filePath, LogicalType dataType, bool requir
     default: {
         fileHandle = std::make_unique<FileHandle>(
             this->filePath, FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+        if (ColumnCompression::isCompressible(this->dataType)) {
+            compression = std::make_unique<ColumnCompression>(
+                StorageUtils::getDataTypeSize(this->dataType));
+        }
     }
     }
     if (requireNullBits) {
@@ -41,11 +52,33 @@ InMemColumn::InMemColumn(std::string filePath, LogicalType dataType, bool requir
     }
 }
 
+void InMemColumn::enableDictionaryEncoding() {
+    assert(dataType.getPhysicalType() == PhysicalTypeID::STRING);
+    dictionaryBuilder = std::make_unique<StringDictionaryBuilder>();
+    codesFileHandle =
+        std::make_unique<FileHandle>(StorageUtils::getPropertyDictionaryCodesFName(filePath),
+            FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+}
+
+void InMemColumn::enableZoneMap() {
+    zoneMap = std::make_unique<ZoneMap>(dataType);
+}
+
 void InMemColumn::flushChunk(InMemColumnChunk* chunk) {
-    if (fileHandle) {
+    if (compression) {
+        flushCompressedChunk(chunk);
+    } else if (fileHandle) {
         auto fileInfo = fileHandle->getFileInfo();
         chunk->flush(fileInfo);
     }
+    if (dictionaryBuilder) {
+        encodeChunk(chunk);
+    }
+    if (zoneMap) {
+        auto isNull = chunk->getNullChunk() ? (bool*)chunk->getNullChunk()->getData() : nullptr;
+        zoneMap->addValues(chunk->getStartNodeOffset(), chunk->getData(), isNull,
+            chunk->getNumBytes() / chunk->getNumBytesPerValue());
+    }
     if (!childColumns.empty()) {
         auto inMemStructColumnChunk = reinterpret_cast<InMemStructColumnChunk*>(chunk);
         for (auto i = 0u; i < childColumns.size(); i++) {
@@ -61,10 +94,155 @@ void InMemColumn::saveToFile() {
     if (inMemOverflowFile) {
         inMemOverflowFile->flush();
     }
+    if (dataType.getPhysicalType() == PhysicalTypeID::STRING) {
+        saveDictionary();
+    }
+    if (zoneMap) {
+        zoneMap->saveToFile(StorageUtils::getPropertyZoneMapFName(filePath));
+    }
+    if (compression) {
+        auto segmentBuffer = std::make_unique<uint8_t[]>(
+            StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT * BufferPoolConstants::PAGE_4KB_SIZE);
+        for (auto& [segmentIdx, segment] : partialSegments) {
+            flushSegment(
+                segmentIdx, segment->values.get(), segment->isNull.get(), segmentBuffer.get());
+        }
+        partialSegments.clear();
+        // Compressed segments only take their first pages. The file is extended to whole segments,
+        // as updates of the last segment may decompress it into all of its pages.
+        auto fileSize = numSegments * StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT *
+                        BufferPoolConstants::PAGE_4KB_SIZE;
+        if (fileHandle->getFileInfo()->getFileSize() < fileSize) {
+            FileUtils::truncateFileToSize(fileHandle->getFileInfo(), fileSize);
+        }
+    }
     for (auto& column : childColumns) {
         column->saveToFile();
     }
 }
 
+void InMemColumn::flushCompressedChunk(InMemColumnChunk* chunk) {
+    auto numBytesPerValue = chunk->getNumBytesPerValue();
+    auto numValues = chunk->getNumBytes() / numBytesPerValue;
+    if (numValues == 0) {
+        return;
+    }
+    auto numValuesPerSegment = compression->getNumValuesPerSegment();
+    auto isNull = chunk->getNullChunk() ? (bool*)chunk->getNullChunk()->getData() : nullptr;
+    auto segmentBuffer = std::make_unique<uint8_t[]>(
+        StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT * BufferPoolConstants::PAGE_4KB_SIZE);
+    uint64_t posInChunk = 0;
+    while (posInChunk < numValues) {
+        auto nodeOffset = chunk->getStartNodeOffset() + posInChunk;
+        auto segmentIdx = nodeOffset / numValuesPerSegment;
+        auto posInSegment = nodeOffset % numValuesPerSegment;
+        auto numValuesInSegment =
+            std::min(numValuesPerSegment - posInSegment, numValues - posInChunk);
+        auto values = chunk->getData() + posInChunk * numBytesPerValue;
+        auto isNullInSegment = isNull ? isNull + posInChunk : nullptr;
+        if (numValuesInSegment == numValuesPerSegment) {
+            flushSegment(segmentIdx, values, isNullInSegment, segmentBuffer.get());
+        } else {
+            copyToPartialSegment(segmentIdx, posInSegment, values, isNullInSegment,
+                numValuesInSegment, segmentBuffer.get());
+        }
+        posInChunk += numValuesInSegment;
+    }
+    auto lastSegmentIdx = (chunk->getStartNodeOffset() + numValues - 1) / numValuesPerSegment;
+    std::unique_lock lck{mtx};
+    numSegments = std::max(numSegments, lastSegmentIdx + 1);
+}
+
+void InMemColumn::copyToPartialSegment(uint64_t segmentIdx, uint64_t posInSegment,
+    const uint8_t* values, const bool* isNull, uint64_t numValues, uint8_t* segmentBuffer) {
+    auto numBytesPerValue = StorageUtils::getDataTypeSize(dataType);
+    auto numValuesPerSegment = compression->getNumValuesPerSegment();
+    std::unique_ptr<InMemColumnSegment> completedSegment;
+    {
+        std::unique_lock lck{mtx};
+        auto& segment = partialSegments[segmentIdx];
+        if (!segment) {
+            segment = std::make_unique<InMemColumnSegment>(numValuesPerSegment, numBytesPerValue);
+        }
+        memcpy(segment->values.get() + posInSegment * numBytesPerValue, values,
+            numValues * numBytesPerValue);
+        if (isNull) {
+            memcpy(segment->isNull.get() + posInSegment, isNull, numValues);
+        } else {
+            memset(segment->isNull.get() + posInSegment, false, numValues);
+        }
+        segment->numValuesCopied += numValues;
+        if (segment->numValuesCopied == numValuesPerSegment) {
+            completedSegment = std::move(segment);
+            partialSegments.erase(segmentIdx);
+        }
+    }
+    if (completedSegment) {
+        flushSegment(segmentIdx, completedSegment->values.get(), completedSegment->isNull.get(),
+            segmentBuffer);
+    }
+}
+
+void InMemColumn::flushSegment(
+    uint64_t segmentIdx, const uint8_t* values, const bool* isNull, uint8_t* segmentBuffer) {
+    auto numPages = compression->compressSegment(
+        values, isNull, compression->getNumValuesPerSegment(), segmentBuffer);
+    FileUtils::writeToFile(fileHandle->getFileInfo(), segmentBuffer,
+        numPages * BufferPoolConstants::PAGE_4KB_SIZE,
+        segmentIdx * StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT *
+            BufferPoolConstants::PAGE_4KB_SIZE);
+}
+
+void InMemColumn::encodeChunk(InMemColumnChunk* chunk) {
+    if (dictionaryBuilder->isAbandoned()) {
+        return;
+    }
+    auto numValues = chunk->getNumBytes() / chunk->getNumBytesPerValue();
+    // Values are first encoded with the indices of the distinct values of the chunk, which are
+    // then replaced by their codes in the dictionary.
+    std::vector<uint32_t> codes(numValues, StringDictionary::INVALID_CODE);
+    std::unordered_map<std::string, uint32_t> distinctValueIndices;
+    std::vector<std::string_view> distinctValues;
+    for (auto i = 0u; i < numValues; i++) {
+        if (chunk->isNull(i)) {
+            continue;
+        }
+        auto kuString = chunk->getValue<ku_string_t>(i);
+        auto [it, isInserted] = distinctValueIndices.emplace(
+            inMemOverflowFile->readString(&kuString), distinctValues.size());
+        if (isInserted) {
+            distinctValues.emplace_back(it->first);
+        }
+        codes[i] = it->second;
+    }
+    std::vector<uint32_t> distinctValueCodes;
+    if (!dictionaryBuilder->encode(distinctValues, distinctValueCodes)) {
+        return;
+    }
+    for (auto& code : codes) {
+        if (code != StringDictionary::INVALID_CODE) {
+            code = distinctValueCodes[code];
+        }
+    }
+    FileUtils::writeToFile(codesFileHandle->getFileInfo(), (uint8_t*)codes.data(),
+        numValues * sizeof(uint32_t), chunk->getStartNodeOffset() * sizeof(uint32_t));
+}
+
+void InMemColumn::saveDictionary() {
+    auto dictionaryFName = StorageUtils::getPropertyDictionaryFName(filePath);
+    auto codesFName = StorageUtils::getPropertyDictionaryCodesFName(filePath);
+    auto dictionary = dictionaryBuilder ? dictionaryBuilder->finalize() : nullptr;
+    codesFileHandle.reset();
+    if (dictionary) {
+        dictionary->saveToFile(dictionaryFName);
+    } else {
+        // The column has too many distinct values, or it is not dictionary-encoded. The files of
+        // a previous dictionary are removed, e.g., when the files of a table are recreated after
+        // its COPY is rolled back.
+        FileUtils::removeFileIfExists(dictionaryFName);
+        FileUtils::removeFileIfExists(codesFName);
+    }
+}
+
 } // namespace storage
 } // namespace kuzu
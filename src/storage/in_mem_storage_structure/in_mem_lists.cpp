@@ -14,9 +14,11 @@ PageElementCursor InMemLists::calcPageElementCursor(
     auto listSize = listHeadersBuilder->getListSize(nodeOffset);
     auto csrOffset = listHeadersBuilder->getCSROffset(nodeOffset);
     auto pos = listSize - reversePos;
-    cursor = PageUtils::getPageElementCursorForPos(csrOffset + pos, numElementsInAPage);
-    cursor.pageIdx = listsMetadataBuilder->getPageMapperForChunkIdx(
-        StorageUtils::getListChunkIdx(nodeOffset))((csrOffset + pos) / numElementsInAPage);
+    auto chunkIdx = StorageUtils::getListChunkIdx(nodeOffset);
+    auto numElementsInAPageOfChunk = getNumElementsInAPage(chunkIdx);
+    cursor = PageUtils::getPageElementCursorForPos(csrOffset + pos, numElementsInAPageOfChunk);
+    cursor.pageIdx = listsMetadataBuilder->getPageMapperForChunkIdx(chunkIdx)(
+        (csrOffset + pos) / numElementsInAPageOfChunk);
     return cursor;
 }
 
@@ -309,6 +311,38 @@ void InMemAdjLists::saveToFile() {
     InMemLists::saveToFile();
 }
 
+void InMemAdjLists::setValue(offset_t nodeOffset, uint64_t pos, uint8_t* val) {
+    auto bitWidth = getNbrOffsetBitWidth(StorageUtils::getListChunkIdx(nodeOffset));
+    if (bitWidth == ListsMetadata::UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH) {
+        InMemLists::setValue(nodeOffset, pos, val);
+        return;
+    }
+    auto cursor = calcPageElementCursor(pos, numBytesForElement, nodeOffset);
+    auto nbrOffset = *(offset_t*)val;
+    // The lists of different nodes share the words of a page and are set concurrently, so the bits
+    // of an offset are set with atomic ORs. This relies on pages being zeroed and on each position
+    // being set once.
+    auto words = (uint64_t*)inMemFile->getPage(cursor.pageIdx)->data;
+    auto bitOffset = (uint64_t)cursor.elemPosInPage * bitWidth;
+    auto wordIdx = bitOffset >> 6;
+    auto shift = bitOffset & 63;
+    std::atomic_ref<uint64_t>{words[wordIdx]}.fetch_or(
+        nbrOffset << shift, std::memory_order_relaxed);
+    if (shift + bitWidth > 64) {
+        std::atomic_ref<uint64_t>{words[wordIdx + 1]}.fetch_or(
+            nbrOffset >> (64 - shift), std::memory_order_relaxed);
+    }
+}
+
+void InMemAdjLists::initNbrOffsetBitWidths() {
+    nbrOffsetBitWidths.resize(maxNbrOffsetPerChunk.size());
+    for (auto chunkIdx = 0u; chunkIdx < maxNbrOffsetPerChunk.size(); chunkIdx++) {
+        nbrOffsetBitWidths[chunkIdx] = ListsMetadataBuilder::computeNbrOffsetBitWidth(
+            maxNbrOffsetPerChunk[chunkIdx].load(std::memory_order_relaxed));
+    }
+    listsMetadataBuilder->setNbrOffsetBitWidths(nbrOffsetBitWidths);
+}
+
 InMemListsWithOverflow::InMemListsWithOverflow(std::string fName, LogicalType dataType,
     uint64_t numNodes, std::shared_ptr<ListHeadersBuilder> listHeadersBuilder,
     const common::CopyDescription* copyDescription)
@@ -1,5 +1,8 @@
 #include "storage/index/hash_index.h"
 
+#include <algorithm>
+#include <bit>
+
 #include "common/exception.h"
 #include "storage/index/hash_index_utils.h"
 
@@ -174,6 +177,32 @@ bool HashIndex<T>::lookupInternal(Transaction* transaction, const uint8_t* key,
     }
 }
 
+template<typename T>
+uint64_t HashIndex<T>::lookupInternal(
+    Transaction* transaction, const std::vector<const uint8_t*>& keys, offset_t* results) {
+    uint64_t numKeysFound = 0;
+    std::vector<uint64_t> keyIdxsToLookupInPersistentIndex;
+    keyIdxsToLookupInPersistentIndex.reserve(keys.size());
+    for (auto i = 0u; i < keys.size(); i++) {
+        if (transaction->isReadOnly()) {
+            keyIdxsToLookupInPersistentIndex.push_back(i);
+            continue;
+        }
+        assert(transaction->isWriteTransaction());
+        auto localLookupState = localStorage->lookup(keys[i], results[i]);
+        if (localLookupState == HashIndexLocalLookupState::KEY_FOUND) {
+            numKeysFound++;
+        } else if (localLookupState == HashIndexLocalLookupState::KEY_DELETED) {
+            results[i] = INVALID_OFFSET;
+        } else {
+            assert(localLookupState == HashIndexLocalLookupState::KEY_NOT_EXIST);
+            keyIdxsToLookupInPersistentIndex.push_back(i);
+        }
+    }
+    return numKeysFound + lookupInPersistentIndex(transaction->getType(), keys,
+                              keyIdxsToLookupInPersistentIndex, results);
+}
+
 // For deletions, we don't check if the deleted keys exist or not. Thus, we don't need to check
 // in the persistent storage and directly delete keys in the local storage.
 template<typename T>
@@ -204,17 +233,17 @@ bool HashIndex<T>::insertInternal(const uint8_t* key, offset_t value) {
 template<typename T>
 template<ChainedSlotsAction action>
 bool HashIndex<T>::performActionInChainedSlots(TransactionType trxType, HashIndexHeader& header,
-    SlotInfo& slotInfo, const uint8_t* key, offset_t& result) {
+    SlotInfo& slotInfo, fingerprint_t fingerprint, const uint8_t* key, offset_t& result) {
     while (slotInfo.slotType == SlotType::PRIMARY || slotInfo.slotId != 0) {
         auto slot = getSlot(trxType, slotInfo);
         if constexpr (action == ChainedSlotsAction::FIND_FREE_SLOT) {
-            if (slot.header.numEntries < HashIndexConstants::SLOT_CAPACITY ||
+            if (slot.header.numEntries < Slot<T>::CAPACITY ||
                 slot.header.nextOvfSlotId == 0) {
                 // Found a slot with empty space.
                 break;
             }
         } else {
-            auto entryPos = findMatchedEntryInSlot(trxType, slot, key);
+            auto entryPos = findMatchedEntryInSlot(trxType, slot, fingerprint, key);
             if (entryPos != SlotHeader::INVALID_ENTRY_POS) {
                 if constexpr (action == ChainedSlotsAction::LOOKUP_IN_SLOTS) {
                     result =
@@ -240,9 +269,67 @@ bool HashIndex<T>::lookupInPersistentIndex(
     auto header = trxType == TransactionType::READ_ONLY ?
                       *indexHeader :
                       headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
-    SlotInfo slotInfo{getPrimarySlotIdForKey(header, key), SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    SlotInfo slotInfo{getPrimarySlotIdForHash(header, hash), SlotType::PRIMARY};
     return performActionInChainedSlots<ChainedSlotsAction::LOOKUP_IN_SLOTS>(
-        trxType, header, slotInfo, key, result);
+        trxType, header, slotInfo, getFingerprintForHash(hash), key, result);
+}
+
+// The primary slots of all keys are computed first, and the keys are probed in the order of their
+// primary slots. Each primary slot is read once for all keys hashed to it, and the slots in the
+// same page are read together, instead of following a slot of a random page for each key. Overflow
+// slots are rare, so they are read per key.
+template<typename T>
+uint64_t HashIndex<T>::lookupInPersistentIndex(TransactionType trxType,
+    const std::vector<const uint8_t*>& keys, std::vector<uint64_t>& keyIdxs, offset_t* results) {
+    if (keyIdxs.empty()) {
+        return 0;
+    }
+    auto header = trxType == TransactionType::READ_ONLY ?
+                      *indexHeader :
+                      headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
+    std::vector<slot_id_t> pSlotIds(keys.size());
+    std::vector<fingerprint_t> fingerprints(keys.size());
+    for (auto keyIdx : keyIdxs) {
+        auto hash = keyHashFunc(keys[keyIdx]);
+        pSlotIds[keyIdx] = getPrimarySlotIdForHash(header, hash);
+        fingerprints[keyIdx] = getFingerprintForHash(hash);
+    }
+    std::sort(keyIdxs.begin(), keyIdxs.end(),
+        [&](uint64_t a, uint64_t b) { return pSlotIds[a] < pSlotIds[b]; });
+    std::vector<slot_id_t> pSlotIdsToRead;
+    for (auto keyIdx : keyIdxs) {
+        if (pSlotIdsToRead.empty() || pSlotIdsToRead.back() != pSlotIds[keyIdx]) {
+            pSlotIdsToRead.push_back(pSlotIds[keyIdx]);
+        }
+    }
+    std::vector<Slot<T>> slots(pSlotIdsToRead.size());
+    pSlots->get(pSlotIdsToRead.data(), pSlotIdsToRead.size(), trxType, slots.data());
+    uint64_t numKeysFound = 0;
+    auto slotIdx = 0u;
+    for (auto keyIdx : keyIdxs) {
+        if (pSlotIdsToRead[slotIdx] != pSlotIds[keyIdx]) {
+            slotIdx++;
+        }
+        auto& slot = slots[slotIdx];
+        auto key = keys[keyIdx];
+        auto entryPos = findMatchedEntryInSlot(trxType, slot, fingerprints[keyIdx], key);
+        auto isFound = entryPos != SlotHeader::INVALID_ENTRY_POS;
+        if (isFound) {
+            results[keyIdx] =
+                *(offset_t*)(slot.entries[entryPos].data + indexHeader->numBytesPerKey);
+        } else if (slot.header.nextOvfSlotId != 0) {
+            SlotInfo slotInfo{slot.header.nextOvfSlotId, SlotType::OVF};
+            isFound = performActionInChainedSlots<ChainedSlotsAction::LOOKUP_IN_SLOTS>(
+                trxType, header, slotInfo, fingerprints[keyIdx], key, results[keyIdx]);
+        }
+        if (isFound) {
+            numKeysFound++;
+        } else {
+            results[keyIdx] = INVALID_OFFSET;
+        }
+    }
+    return numKeysFound;
 }
 
 template<typename T>
@@ -250,16 +337,17 @@ void HashIndex<T>::insertIntoPersistentIndex(const uint8_t* key, offset_t value)
     auto header = headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
     slot_id_t numRequiredEntries = getNumRequiredEntries(header.numEntries, 1);
     while (numRequiredEntries >
-           pSlots->getNumElements(TransactionType::WRITE) * HashIndexConstants::SLOT_CAPACITY) {
+           pSlots->getNumElements(TransactionType::WRITE) * Slot<T>::CAPACITY) {
         splitSlot(header);
     }
-    auto pSlotId = getPrimarySlotIdForKey(header, key);
-    SlotInfo slotInfo{pSlotId, SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    auto fingerprint = getFingerprintForHash(hash);
+    SlotInfo slotInfo{getPrimarySlotIdForHash(header, hash), SlotType::PRIMARY};
     offset_t result;
     performActionInChainedSlots<ChainedSlotsAction::FIND_FREE_SLOT>(
-        TransactionType::WRITE, header, slotInfo, key, result);
+        TransactionType::WRITE, header, slotInfo, fingerprint, key, result);
     Slot slot = getSlot(TransactionType::WRITE, slotInfo);
-    copyKVOrEntryToSlot(false /* insert kv */, slotInfo, slot, key, value);
+    copyKVOrEntryToSlot(false /* insert kv */, slotInfo, slot, fingerprint, key, value);
     header.numEntries++;
     headerArray->update(INDEX_HEADER_IDX_IN_ARRAY, header);
 }
@@ -267,10 +355,11 @@ void HashIndex<T>::insertIntoPersistentIndex(const uint8_t* key, offset_t value)
 template<typename T>
 void HashIndex<T>::deleteFromPersistentIndex(const uint8_t* key) {
     auto header = headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
-    SlotInfo slotInfo{getPrimarySlotIdForKey(header, key), SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    SlotInfo slotInfo{getPrimarySlotIdForHash(header, hash), SlotType::PRIMARY};
     offset_t result;
     performActionInChainedSlots<ChainedSlotsAction::DELETE_IN_SLOTS>(
-        TransactionType::WRITE, header, slotInfo, key, result);
+        TransactionType::WRITE, header, slotInfo, getFingerprintForHash(hash), key, result);
     headerArray->update(INDEX_HEADER_IDX_IN_ARRAY, header);
 }
 
@@ -278,8 +367,7 @@ template<typename T>
 void HashIndex<T>::loopChainedSlotsToFindOneWithFreeSpace(SlotInfo& slotInfo, Slot<T>& slot) {
     while (slotInfo.slotType == SlotType::PRIMARY || slotInfo.slotId > 0) {
         slot = getSlot(TransactionType::WRITE, slotInfo);
-        if (slot.header.numEntries < HashIndexConstants::SLOT_CAPACITY ||
-            slot.header.nextOvfSlotId == 0) {
+        if (slot.header.numEntries < Slot<T>::CAPACITY || slot.header.nextOvfSlotId == 0) {
             // Found a slot with empty space.
             break;
         }
@@ -302,7 +390,7 @@ void HashIndex<T>::rehashSlots(HashIndexHeader& header) {
         auto slotHeader = slot.header;
         slot.header.reset();
         updateSlot(slotInfo, slot);
-        for (auto entryPos = 0u; entryPos < HashIndexConstants::SLOT_CAPACITY; entryPos++) {
+        for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
             if (!slotHeader.isEntryValid(entryPos)) {
                 continue; // Skip invalid entries.
             }
@@ -315,17 +403,17 @@ void HashIndex<T>::rehashSlots(HashIndexHeader& header) {
                 hash = keyHashFunc(key);
             }
             auto newSlotId = hash & header.higherLevelHashMask;
-            copyEntryToSlot(newSlotId, key);
+            copyEntryToSlot(newSlotId, slot.fingerprints[entryPos], key);
         }
     }
 }
 
 template<typename T>
-void HashIndex<T>::copyEntryToSlot(slot_id_t slotId, uint8_t* entry) {
+void HashIndex<T>::copyEntryToSlot(slot_id_t slotId, fingerprint_t fingerprint, uint8_t* entry) {
     SlotInfo slotInfo{slotId, SlotType::PRIMARY};
     Slot<T> slot;
     loopChainedSlotsToFindOneWithFreeSpace(slotInfo, slot);
-    copyKVOrEntryToSlot(true /* copy entry */, slotInfo, slot, entry, UINT32_MAX);
+    copyKVOrEntryToSlot(true /* copy entry */, slotInfo, slot, fingerprint, entry, UINT32_MAX);
     updateSlot(slotInfo, slot);
 }
 
@@ -343,31 +431,32 @@ std::vector<std::pair<SlotInfo, Slot<T>>> HashIndex<T>::getChainedSlots(slot_id_
 }
 
 template<typename T>
-void HashIndex<T>::copyAndUpdateSlotHeader(
-    bool isCopyEntry, Slot<T>& slot, entry_pos_t entryPos, const uint8_t* key, offset_t value) {
+void HashIndex<T>::copyAndUpdateSlotHeader(bool isCopyEntry, Slot<T>& slot, entry_pos_t entryPos,
+    fingerprint_t fingerprint, const uint8_t* key, offset_t value) {
     if (isCopyEntry) {
         memcpy(slot.entries[entryPos].data, key, indexHeader->numBytesPerEntry);
     } else {
         keyInsertFunc(key, value, slot.entries[entryPos].data, diskOverflowFile.get());
     }
+    slot.fingerprints[entryPos] = fingerprint;
     slot.header.setEntryValid(entryPos);
     slot.header.numEntries++;
 }
 
 template<typename T>
-void HashIndex<T>::copyKVOrEntryToSlot(
-    bool isCopyEntry, const SlotInfo& slotInfo, Slot<T>& slot, const uint8_t* key, offset_t value) {
-    if (slot.header.numEntries == HashIndexConstants::SLOT_CAPACITY) {
+void HashIndex<T>::copyKVOrEntryToSlot(bool isCopyEntry, const SlotInfo& slotInfo, Slot<T>& slot,
+    fingerprint_t fingerprint, const uint8_t* key, offset_t value) {
+    if (slot.header.numEntries == Slot<T>::CAPACITY) {
         // Allocate a new oSlot, insert the entry to the new oSlot, and update slot's
         // nextOvfSlotId.
         Slot<T> newSlot;
         auto entryPos = 0u; // Always insert to the first entry when there is a new slot.
-        copyAndUpdateSlotHeader(isCopyEntry, newSlot, entryPos, key, value);
+        copyAndUpdateSlotHeader(isCopyEntry, newSlot, entryPos, fingerprint, key, value);
         slot.header.nextOvfSlotId = oSlots->pushBack(newSlot);
     } else {
-        for (auto entryPos = 0u; entryPos < HashIndexConstants::SLOT_CAPACITY; entryPos++) {
+        for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
             if (!slot.header.isEntryValid(entryPos)) {
-                copyAndUpdateSlotHeader(isCopyEntry, slot, entryPos, key, value);
+                copyAndUpdateSlotHeader(isCopyEntry, slot, entryPos, fingerprint, key, value);
                 break;
             }
         }
@@ -376,12 +465,12 @@ void HashIndex<T>::copyKVOrEntryToSlot(
 }
 
 template<typename T>
-entry_pos_t HashIndex<T>::findMatchedEntryInSlot(
-    TransactionType trxType, const Slot<T>& slot, const uint8_t* key) const {
-    for (auto entryPos = 0u; entryPos < HashIndexConstants::SLOT_CAPACITY; entryPos++) {
-        if (!slot.header.isEntryValid(entryPos)) {
-            continue;
-        }
+entry_pos_t HashIndex<T>::findMatchedEntryInSlot(TransactionType trxType, const Slot<T>& slot,
+    fingerprint_t fingerprint, const uint8_t* key) const {
+    auto entriesToCompare = slot.getEntriesWithFingerprint(fingerprint);
+    while (entriesToCompare != 0) {
+        entry_pos_t entryPos = std::countr_zero(entriesToCompare);
+        entriesToCompare &= entriesToCompare - 1;
         if (keyEqualsFunc(trxType, key, slot.entries[entryPos].data, diskOverflowFile.get())) {
             return entryPos;
         }
@@ -453,6 +542,31 @@ bool PrimaryKeyIndex::lookup(
     }
 }
 
+uint64_t PrimaryKeyIndex::lookup(Transaction* trx, ValueVector* keyVector, offset_t* results) {
+    auto selVector = keyVector->state->selVector.get();
+    std::vector<const uint8_t*> keys(selVector->selectedSize);
+    std::vector<std::string> stringKeys;
+    if (keyDataTypeID == LogicalTypeID::STRING) {
+        stringKeys.resize(selVector->selectedSize);
+    }
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        auto pos = selVector->selectedPositions[i];
+        assert(!keyVector->isNull(pos));
+        if (keyDataTypeID == LogicalTypeID::INT64) {
+            keys[i] = keyVector->getData() + pos * sizeof(int64_t);
+        } else {
+            stringKeys[i] = keyVector->getValue<ku_string_t>(pos).getAsString();
+            keys[i] = reinterpret_cast<const uint8_t*>(stringKeys[i].c_str());
+        }
+    }
+    std::vector<offset_t> resultsOfKeys(keys.size());
+    auto numKeysFound = lookup(trx, keys, resultsOfKeys.data());
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        results[selVector->selectedPositions[i]] = resultsOfKeys[i];
+    }
+    return numKeysFound;
+}
+
 void PrimaryKeyIndex::deleteKey(ValueVector* keyVector, uint64_t vectorPos) {
     assert(!keyVector->isNull(vectorPos));
     if (keyDataTypeID == LogicalTypeID::INT64) {
@@ -1,13 +1,16 @@
 #include "storage/index/hash_index_builder.h"
 
+#include <bit>
+
+#include "common/type_utils.h"
+
 using namespace kuzu::common;
 
 namespace kuzu {
 namespace storage {
 
-slot_id_t BaseHashIndex::getPrimarySlotIdForKey(
-    const HashIndexHeader& indexHeader_, const uint8_t* key) {
-    auto hash = keyHashFunc(key);
+slot_id_t BaseHashIndex::getPrimarySlotIdForHash(
+    const HashIndexHeader& indexHeader_, hash_t hash) {
     auto slotId = hash & indexHeader_.levelHashMask;
     if (slotId < indexHeader_.nextSplitSlotId) {
         slotId = hash & indexHeader_.higherLevelHashMask;
@@ -38,14 +41,14 @@ HashIndexBuilder<T>::HashIndexBuilder(const std::string& fName, const LogicalTyp
     }
     keyInsertFunc = InMemHashIndexUtils::initializeInsertFunc(indexHeader->keyDataTypeID);
     keyEqualsFunc = InMemHashIndexUtils::initializeEqualsFunc(indexHeader->keyDataTypeID);
+    initPartitions();
 }
 
 template<typename T>
 void HashIndexBuilder<T>::bulkReserve(uint32_t numEntries_) {
     slot_id_t numRequiredEntries = getNumRequiredEntries(numEntries.load(), numEntries_);
     // Build from scratch.
-    auto numRequiredSlots = (numRequiredEntries + HashIndexConstants::SLOT_CAPACITY - 1) /
-                            HashIndexConstants::SLOT_CAPACITY;
+    auto numRequiredSlots = (numRequiredEntries + Slot<T>::CAPACITY - 1) / Slot<T>::CAPACITY;
     auto numSlotsOfCurrentLevel = 1 << indexHeader->currentLevel;
     while ((numSlotsOfCurrentLevel << 1) < numRequiredSlots) {
         indexHeader->incrementLevel();
@@ -55,39 +58,115 @@ void HashIndexBuilder<T>::bulkReserve(uint32_t numEntries_) {
         indexHeader->nextSplitSlotId = numRequiredSlots - numSlotsOfCurrentLevel;
     }
     allocatePSlots(numRequiredSlots);
+    initPartitions();
+}
+
+template<typename T>
+void HashIndexBuilder<T>::initPartitions() {
+    numPSlotsOfPartitions = pSlots->getNumElements();
+    auto numPartitions = std::clamp<uint64_t>(
+        numPSlotsOfPartitions / MIN_NUM_P_SLOTS_PER_PARTITION, 1, MAX_NUM_PARTITIONS);
+    partitions.clear();
+    for (auto i = 0u; i < numPartitions; i++) {
+        auto partition = std::make_unique<Partition>();
+        if (inMemOverflowFile) {
+            partition->overflowFile = std::make_unique<InMemOverflowFile>();
+        }
+        partitions.push_back(std::move(partition));
+    }
 }
 
 template<typename T>
 bool HashIndexBuilder<T>::appendInternal(const uint8_t* key, offset_t value) {
-    SlotInfo pSlotInfo{getPrimarySlotIdForKey(*indexHeader, key), SlotType::PRIMARY};
-    auto currentSlotInfo = pSlotInfo;
+    auto hash = keyHashFunc(key);
+    auto& partition = *partitions[getPartitionIdx(getPrimarySlotIdForHash(*indexHeader, hash))];
+    std::unique_lock lck{partition.mtx};
+    if (!appendNoLock(partition, hash, key, value)) {
+        return false;
+    }
+    numEntries.fetch_add(1);
+    return true;
+}
+
+template<typename T>
+uint64_t HashIndexBuilder<T>::append(const std::vector<const uint8_t*>& keys, offset_t startValue) {
+    // Groups the positions of the keys by partition with a counting sort, which keeps the order of
+    // the keys within a partition.
+    std::vector<hash_t> hashes(keys.size());
+    std::vector<uint64_t> partitionIdxes(keys.size());
+    std::vector<uint64_t> startPosOfPartitions(partitions.size() + 1, 0);
+    for (auto i = 0u; i < keys.size(); i++) {
+        hashes[i] = keyHashFunc(keys[i]);
+        partitionIdxes[i] = getPartitionIdx(getPrimarySlotIdForHash(*indexHeader, hashes[i]));
+        startPosOfPartitions[partitionIdxes[i] + 1]++;
+    }
+    for (auto i = 0u; i < partitions.size(); i++) {
+        startPosOfPartitions[i + 1] += startPosOfPartitions[i];
+    }
+    std::vector<uint64_t> positions(keys.size());
+    auto nextPosOfPartitions = startPosOfPartitions;
+    for (auto i = 0u; i < keys.size(); i++) {
+        positions[nextPosOfPartitions[partitionIdxes[i]]++] = i;
+    }
+    auto duplicatePos = keys.size();
+    uint64_t numAppended = 0;
+    for (auto partitionIdx = 0u; partitionIdx < partitions.size(); partitionIdx++) {
+        auto startPos = startPosOfPartitions[partitionIdx];
+        auto endPos = startPosOfPartitions[partitionIdx + 1];
+        if (startPos == endPos) {
+            continue;
+        }
+        auto& partition = *partitions[partitionIdx];
+        std::unique_lock lck{partition.mtx};
+        for (auto i = startPos; i < endPos; i++) {
+            auto pos = positions[i];
+            if (!appendNoLock(partition, hashes[pos], keys[pos], startValue + pos)) {
+                duplicatePos = std::min(duplicatePos, pos);
+                break;
+            }
+            numAppended++;
+        }
+    }
+    numEntries.fetch_add(numAppended);
+    return duplicatePos;
+}
+
+template<typename T>
+bool HashIndexBuilder<T>::appendNoLock(
+    Partition& partition, hash_t hash, const uint8_t* key, offset_t value) {
+    auto fingerprint = getFingerprintForHash(hash);
+    SlotInfo currentSlotInfo{getPrimarySlotIdForHash(*indexHeader, hash), SlotType::PRIMARY};
     Slot<T>* currentSlot = nullptr;
     while (currentSlotInfo.slotType == SlotType::PRIMARY || currentSlotInfo.slotId != 0) {
-        currentSlot = getSlot(currentSlotInfo);
-        if (lookupOrExistsInSlotWithoutLock<false /* exists */>(currentSlot, key)) {
+        currentSlot = getSlot(partition, currentSlotInfo);
+        if (lookupOrExistsInSlotWithoutLock<false /* exists */>(
+                partition, currentSlot, fingerprint, key)) {
             // Key already exists. No append is allowed.
             return false;
         }
-        if (currentSlot->header.numEntries < HashIndexConstants::SLOT_CAPACITY) {
+        if (currentSlot->header.numEntries < Slot<T>::CAPACITY) {
             break;
         }
         currentSlotInfo.slotId = currentSlot->header.nextOvfSlotId;
         currentSlotInfo.slotType = SlotType::OVF;
     }
     assert(currentSlot);
-    insertToSlotWithoutLock(currentSlot, key, value);
-    numEntries.fetch_add(1);
+    insertToSlotWithoutLock(partition, currentSlot, fingerprint, key, value);
     return true;
 }
 
 template<typename T>
-bool HashIndexBuilder<T>::lookupInternalWithoutLock(const uint8_t* key, offset_t& result) {
-    SlotInfo pSlotInfo{getPrimarySlotIdForKey(*indexHeader, key), SlotType::PRIMARY};
-    SlotInfo currentSlotInfo = pSlotInfo;
+bool HashIndexBuilder<T>::lookupInternal(const uint8_t* key, offset_t& result) {
+    auto hash = keyHashFunc(key);
+    auto pSlotId = getPrimarySlotIdForHash(*indexHeader, hash);
+    auto& partition = *partitions[getPartitionIdx(pSlotId)];
+    std::unique_lock lck{partition.mtx};
+    SlotInfo currentSlotInfo{pSlotId, SlotType::PRIMARY};
     Slot<T>* currentSlot;
     while (currentSlotInfo.slotType == SlotType::PRIMARY || currentSlotInfo.slotId != 0) {
-        currentSlot = getSlot(currentSlotInfo);
-        if (lookupOrExistsInSlotWithoutLock<true /* lookup */>(currentSlot, key, &result)) {
+        currentSlot = getSlot(partition, currentSlotInfo);
+        if (lookupOrExistsInSlotWithoutLock<true /* lookup */>(
+                partition, currentSlot, getFingerprintForHash(hash), key, &result)) {
             return true;
         }
         currentSlotInfo.slotId = currentSlot->header.nextOvfSlotId;
@@ -105,32 +184,24 @@ uint32_t HashIndexBuilder<T>::allocatePSlots(uint32_t numSlotsToAllocate) {
 }
 
 template<typename T>
-uint32_t HashIndexBuilder<T>::allocateAOSlot() {
-    auto oldNumSlots = oSlots->getNumElements();
-    auto newNumSlots = oldNumSlots + 1;
-    oSlots->resize(newNumSlots, true /* setToZero */);
-    return oldNumSlots;
-}
-
-template<typename T>
-Slot<T>* HashIndexBuilder<T>::getSlot(const SlotInfo& slotInfo) {
+Slot<T>* HashIndexBuilder<T>::getSlot(Partition& partition, const SlotInfo& slotInfo) {
     if (slotInfo.slotType == SlotType::PRIMARY) {
         return &pSlots->operator[](slotInfo.slotId);
     } else {
-        return &oSlots->operator[](slotInfo.slotId);
+        return &partition.oSlots[slotInfo.slotId - 1];
     }
 }
 
 template<typename T>
 template<bool IS_LOOKUP>
-bool HashIndexBuilder<T>::lookupOrExistsInSlotWithoutLock(
-    Slot<T>* slot, const uint8_t* key, offset_t* result) {
-    for (auto entryPos = 0u; entryPos < HashIndexConstants::SLOT_CAPACITY; entryPos++) {
-        if (!slot->header.isEntryValid(entryPos)) {
-            continue;
-        }
+bool HashIndexBuilder<T>::lookupOrExistsInSlotWithoutLock(Partition& partition, Slot<T>* slot,
+    fingerprint_t fingerprint, const uint8_t* key, offset_t* result) {
+    auto entriesToCompare = slot->getEntriesWithFingerprint(fingerprint);
+    while (entriesToCompare != 0) {
+        auto entryPos = std::countr_zero(entriesToCompare);
+        entriesToCompare &= entriesToCompare - 1;
         auto& entry = slot->entries[entryPos];
-        if (keyEqualsFunc(key, entry.data, inMemOverflowFile.get())) {
+        if (keyEqualsFunc(key, entry.data, partition.overflowFile.get())) {
             if constexpr (IS_LOOKUP) {
                 memcpy(result, entry.data + indexHeader->numBytesPerKey, sizeof(offset_t));
             }
@@ -141,17 +212,19 @@ bool HashIndexBuilder<T>::lookupOrExistsInSlotWithoutLock(
 }
 
 template<typename T>
-void HashIndexBuilder<T>::insertToSlotWithoutLock(
-    Slot<T>* slot, const uint8_t* key, offset_t value) {
-    if (slot->header.numEntries == HashIndexConstants::SLOT_CAPACITY) {
-        // Allocate a new oSlot and change the nextOvfSlotId.
-        auto ovfSlotId = allocateAOSlot();
-        slot->header.nextOvfSlotId = ovfSlotId;
-        slot = getSlot(SlotInfo{ovfSlotId, SlotType::OVF});
-    }
-    for (auto entryPos = 0u; entryPos < HashIndexConstants::SLOT_CAPACITY; entryPos++) {
+void HashIndexBuilder<T>::insertToSlotWithoutLock(Partition& partition, Slot<T>* slot,
+    fingerprint_t fingerprint, const uint8_t* key, offset_t value) {
+    if (slot->header.numEntries == Slot<T>::CAPACITY) {
+        // Allocate a new oSlot and change the nextOvfSlotId. Growing the deque doesn't move the
+        // existing slots.
+        partition.oSlots.emplace_back();
+        slot->header.nextOvfSlotId = partition.oSlots.size();
+        slot = &partition.oSlots.back();
+    }
+    for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
         if (!slot->header.isEntryValid(entryPos)) {
-            keyInsertFunc(key, value, slot->entries[entryPos].data, inMemOverflowFile.get());
+            keyInsertFunc(key, value, slot->entries[entryPos].data, partition.overflowFile.get());
+            slot->fingerprints[entryPos] = fingerprint;
             slot->header.setEntryValid(entryPos);
             slot->header.numEntries++;
             break;
@@ -159,8 +232,59 @@ void HashIndexBuilder<T>::insertToSlotWithoutLock(
     }
 }
 
+template<typename T>
+void HashIndexBuilder<T>::mergePartitions() {
+    // The local slotIds of the overflow slots and the overflow pageIdxs of the strings of a
+    // partition are shifted by the number of overflow slots and pages of the partitions before it.
+    std::vector<slot_id_t> oSlotIdOffsets(partitions.size());
+    std::vector<page_idx_t> overflowPageIdxOffsets(partitions.size(), 0);
+    for (auto partitionIdx = 0u; partitionIdx < partitions.size(); partitionIdx++) {
+        auto& partition = *partitions[partitionIdx];
+        oSlotIdOffsets[partitionIdx] = oSlots->getNumElements() - 1;
+        if (partition.overflowFile) {
+            overflowPageIdxOffsets[partitionIdx] =
+                inMemOverflowFile->movePagesFrom(*partition.overflowFile);
+        }
+        oSlots->resize(oSlots->getNumElements() + partition.oSlots.size(), false /* setToZero */);
+        for (auto i = 0u; i < partition.oSlots.size(); i++) {
+            auto& oSlot = oSlots->operator[](oSlotIdOffsets[partitionIdx] + 1 + i);
+            oSlot = partition.oSlots[i];
+            relocateSlot(
+                oSlot, oSlotIdOffsets[partitionIdx], overflowPageIdxOffsets[partitionIdx]);
+        }
+        partition.oSlots.clear();
+    }
+    for (auto pSlotId = 0u; pSlotId < pSlots->getNumElements(); pSlotId++) {
+        auto partitionIdx = getPartitionIdx(pSlotId);
+        relocateSlot(pSlots->operator[](pSlotId), oSlotIdOffsets[partitionIdx],
+            overflowPageIdxOffsets[partitionIdx]);
+    }
+}
+
+template<typename T>
+void HashIndexBuilder<T>::relocateSlot(
+    Slot<T>& slot, slot_id_t oSlotIdOffset, page_idx_t overflowPageIdxOffset) {
+    if (slot.header.nextOvfSlotId != 0) {
+        slot.header.nextOvfSlotId += oSlotIdOffset;
+    }
+    if constexpr (std::is_same_v<T, ku_string_t>) {
+        for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
+            auto key = reinterpret_cast<ku_string_t*>(slot.entries[entryPos].data);
+            if (!slot.header.isEntryValid(entryPos) || ku_string_t::isShortString(key->len)) {
+                continue;
+            }
+            page_idx_t pageIdx;
+            uint16_t pageOffset;
+            TypeUtils::decodeOverflowPtr(key->overflowPtr, pageIdx, pageOffset);
+            TypeUtils::encodeOverflowPtr(
+                key->overflowPtr, pageIdx + overflowPageIdxOffset, pageOffset);
+        }
+    }
+}
+
 template<typename T>
 void HashIndexBuilder<T>::flush() {
+    mergePartitions();
     indexHeader->numEntries = numEntries.load();
     headerArray->resize(1, true /* setToZero */);
     headerArray->operator[](0) = *indexHeader;
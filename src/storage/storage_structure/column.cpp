@@ -21,6 +21,10 @@ Column::Column(const kuzu::storage::StorageStructureIDAndFName& structureIDAndFN
         nullColumn =
             std::make_unique<NullColumn>(nullColumnStructureIDAndFName, bufferManager, wal);
     }
+    auto zoneMapFName = StorageUtils::getPropertyZoneMapFName(structureIDAndFName.fName);
+    if (ZoneMap::isSupported(dataType) && FileUtils::fileOrPathExists(zoneMapFName)) {
+        zoneMap = ZoneMap::loadFromFile(dataType, zoneMapFName);
+    }
 }
 
 void Column::batchLookup(const common::offset_t* nodeOffsets, size_t size, uint8_t* result) {
@@ -57,40 +61,63 @@ void Column::write(common::ValueVector* nodeIDVector, common::ValueVector* vecto
     if (nodeIDVector->state->isFlat() && vectorToWriteFrom->state->isFlat()) {
         auto nodeOffset =
             nodeIDVector->readNodeOffset(nodeIDVector->state->selVector->selectedPositions[0]);
-        write(nodeOffset, vectorToWriteFrom,
+        writeValue(nodeOffset, vectorToWriteFrom,
             vectorToWriteFrom->state->selVector->selectedPositions[0]);
     } else if (nodeIDVector->state->isFlat() && !vectorToWriteFrom->state->isFlat()) {
         auto nodeOffset =
             nodeIDVector->readNodeOffset(nodeIDVector->state->selVector->selectedPositions[0]);
         auto lastPos = vectorToWriteFrom->state->selVector->selectedSize - 1;
-        write(nodeOffset, vectorToWriteFrom, lastPos);
+        writeValue(nodeOffset, vectorToWriteFrom, lastPos);
     } else if (!nodeIDVector->state->isFlat() && vectorToWriteFrom->state->isFlat()) {
         for (auto i = 0u; i < nodeIDVector->state->selVector->selectedSize; ++i) {
             auto nodeOffset =
                 nodeIDVector->readNodeOffset(nodeIDVector->state->selVector->selectedPositions[i]);
-            write(nodeOffset, vectorToWriteFrom,
+            writeValue(nodeOffset, vectorToWriteFrom,
                 vectorToWriteFrom->state->selVector->selectedPositions[0]);
         }
     } else if (!nodeIDVector->state->isFlat() && !vectorToWriteFrom->state->isFlat()) {
         for (auto i = 0u; i < nodeIDVector->state->selVector->selectedSize; ++i) {
             auto pos = nodeIDVector->state->selVector->selectedPositions[i];
             auto nodeOffset = nodeIDVector->readNodeOffset(pos);
-            write(nodeOffset, vectorToWriteFrom, pos);
+            writeValue(nodeOffset, vectorToWriteFrom, pos);
         }
     }
 }
 
+void Column::prefetch(offset_t startOffset, uint64_t numValues, PrefetchStats& stats) {
+    if (numValues == 0) {
+        return;
+    }
+    if (nullColumn) {
+        nullColumn->prefetch(startOffset, numValues, stats);
+    }
+    auto startPageIdx = startOffset / numElementsPerPage;
+    auto endPageIdx = (startOffset + numValues - 1) / numElementsPerPage;
+    bufferManager->prefetch(*fileHandle, startPageIdx, endPageIdx - startPageIdx + 1, stats);
+}
+
 bool Column::isNull(common::offset_t nodeOffset, transaction::Transaction* transaction) {
     return nullColumn->readValue(nodeOffset, transaction);
 }
 
 void Column::setNull(common::offset_t nodeOffset) {
     nullColumn->setValue(nodeOffset);
+    if (zoneMap) {
+        zoneMap->addNull(nodeOffset);
+    }
     auto walPageInfo = createWALVersionOfPageIfNecessaryForElement(nodeOffset, numElementsPerPage);
     bufferManager->unpin(*wal->fileHandle, walPageInfo.pageIdxInWAL);
     fileHandle->releaseWALPageIdxLock(walPageInfo.originalPageIdx);
 }
 
+void Column::prepareCommit() {
+    // Zone maps are only widened by updates, so the saved zone map is valid even if the
+    // transaction is rolled back after it is saved.
+    if (zoneMap && zoneMap->isDirty()) {
+        zoneMap->saveToFile(StorageUtils::getPropertyZoneMapFName(fileHandle->getFileInfo()->path));
+    }
+}
+
 Value Column::readValueForTestingOnly(offset_t offset) {
     auto cursor = PageUtils::getPageElementCursorForPos(offset, numElementsPerPage);
     Value retVal = Value::createDefaultValue(dataType);
@@ -133,10 +160,13 @@ void Column::scan(transaction::Transaction* transaction, common::ValueVector* no
             uint64_t numValuesToReadInPage =
                 std::min((uint64_t)numElementsPerPage - pageCursor.elemPosInPage,
                     numValuesToRead - numValuesRead);
-            readFromPage(transaction, pageCursor.pageIdx, [&](uint8_t* frame) -> void {
-                readDataFunc(transaction, frame, pageCursor, resultVector, numValuesRead,
-                    numValuesToReadInPage, diskOverflowFile.get());
-            });
+            readFromPage(
+                transaction, pageCursor.pageIdx,
+                [&](uint8_t* frame) -> void {
+                    readDataFunc(transaction, frame, pageCursor, resultVector, numValuesRead,
+                        numValuesToReadInPage, diskOverflowFile.get());
+                },
+                BufferManager::AccessHint::SCAN);
             numValuesRead += numValuesToReadInPage;
             pageCursor.nextPage();
         }
@@ -147,10 +177,13 @@ void Column::scan(transaction::Transaction* transaction, common::ValueVector* no
                     numValuesToRead - numValuesRead);
             if (isInRange(nodeIDVector->state->selVector->selectedPositions[posInSelVector],
                     numValuesRead, numValuesRead + numValuesToReadInPage)) {
-                readFromPage(transaction, pageCursor.pageIdx, [&](uint8_t* frame) -> void {
-                    readDataFunc(transaction, frame, pageCursor, resultVector, numValuesRead,
-                        numValuesToReadInPage, diskOverflowFile.get());
-                });
+                readFromPage(
+                    transaction, pageCursor.pageIdx,
+                    [&](uint8_t* frame) -> void {
+                        readDataFunc(transaction, frame, pageCursor, resultVector, numValuesRead,
+                            numValuesToReadInPage, diskOverflowFile.get());
+                    },
+                    BufferManager::AccessHint::SCAN);
             }
             numValuesRead += numValuesToReadInPage;
             pageCursor.nextPage();
@@ -185,12 +218,27 @@ void Column::write(common::offset_t nodeOffset, common::ValueVector* vectorToWri
     }
 }
 
+void Column::writeValue(
+    offset_t nodeOffset, ValueVector* vectorToWriteFrom, uint32_t posInVectorToWriteFrom) {
+    write(nodeOffset, vectorToWriteFrom, posInVectorToWriteFrom);
+    if (!zoneMap) {
+        return;
+    }
+    if (vectorToWriteFrom->isNull(posInVectorToWriteFrom)) {
+        zoneMap->addNull(nodeOffset);
+    } else {
+        auto numBytesPerValue = vectorToWriteFrom->getNumBytesPerValue();
+        zoneMap->addValue(
+            nodeOffset, vectorToWriteFrom->getData() + posInVectorToWriteFrom * numBytesPerValue);
+    }
+}
+
 void Column::readFromPage(transaction::Transaction* transaction, common::page_idx_t pageIdx,
-    const std::function<void(uint8_t*)>& func) {
+    const std::function<void(uint8_t*)>& func, BufferManager::AccessHint accessHint) {
     auto [fileHandleToPin, pageIdxToPin] =
         StorageStructureUtils::getFileHandleAndPhysicalPageIdxToPin(
             *fileHandle, pageIdx, *wal, transaction->getType());
-    bufferManager->optimisticRead(*fileHandleToPin, pageIdxToPin, func);
+    bufferManager->optimisticRead(*fileHandleToPin, pageIdxToPin, func, accessHint);
 }
 
 void Column::readValuesFromPage(transaction::Transaction* transaction, uint8_t* frame,
@@ -242,6 +290,144 @@ void NullColumn::readNullsFromPage(transaction::Transaction* transaction, uint8_
     }
 }
 
+void DictionaryCodeColumn::readCodes(
+    Transaction* transaction, offset_t startOffset, uint64_t numValues, uint32_t* codes) {
+    auto pageCursor = PageUtils::getPageElementCursorForPos(startOffset, numElementsPerPage);
+    uint64_t numValuesRead = 0;
+    while (numValuesRead < numValues) {
+        auto numValuesToReadInPage = std::min(
+            (uint64_t)numElementsPerPage - pageCursor.elemPosInPage, numValues - numValuesRead);
+        readFromPage(
+            transaction, pageCursor.pageIdx,
+            [&](uint8_t* frame) -> void {
+                memcpy(codes + numValuesRead, frame + pageCursor.elemPosInPage * sizeof(uint32_t),
+                    numValuesToReadInPage * sizeof(uint32_t));
+            },
+            BufferManager::AccessHint::SCAN);
+        numValuesRead += numValuesToReadInPage;
+        pageCursor.nextPage();
+    }
+}
+
+uint32_t DictionaryCodeColumn::readCode(Transaction* transaction, offset_t nodeOffset) {
+    auto pageCursor = PageUtils::getPageElementCursorForPos(nodeOffset, numElementsPerPage);
+    uint32_t code;
+    readFromPage(transaction, pageCursor.pageIdx, [&](uint8_t* frame) -> void {
+        memcpy(&code, frame + pageCursor.elemPosInPage * sizeof(uint32_t), sizeof(uint32_t));
+    });
+    return code;
+}
+
+void DictionaryCodeColumn::writeCode(offset_t nodeOffset, uint32_t code) {
+    auto walPageInfo = createWALVersionOfPageIfNecessaryForElement(nodeOffset, numElementsPerPage);
+    memcpy(walPageInfo.frame + walPageInfo.posInPage * sizeof(uint32_t), &code, sizeof(uint32_t));
+    StorageStructureUtils::unpinWALPageAndReleaseOriginalPageLock(
+        walPageInfo, *fileHandle, *bufferManager, *wal);
+}
+
+StringPropertyColumn::StringPropertyColumn(
+    const StorageStructureIDAndFName& structureIDAndFNameOfMainColumn,
+    const LogicalType& dataType, BufferManager* bufferManager, WAL* wal)
+    : PropertyColumnWithOverflow{structureIDAndFNameOfMainColumn, dataType, bufferManager, wal} {
+    writeDataFunc = StringPropertyColumn::writeStringToPage;
+    auto dictionaryFName =
+        StorageUtils::getPropertyDictionaryFName(structureIDAndFNameOfMainColumn.fName);
+    if (FileUtils::fileOrPathExists(dictionaryFName)) {
+        dictionary = StringDictionary::loadFromFile(dictionaryFName);
+        codesColumn = std::make_unique<DictionaryCodeColumn>(
+            StorageUtils::getDictionaryCodesColumnStructureIDAndFName(
+                structureIDAndFNameOfMainColumn),
+            bufferManager, wal);
+    }
+}
+
+void StringPropertyColumn::prefetch(
+    offset_t startOffset, uint64_t numValues, PrefetchStats& stats) {
+    if (!dictionary) {
+        Column::prefetch(startOffset, numValues, stats);
+        return;
+    }
+    // Values in the dictionary are not read from the column file.
+    if (numValues > 0) {
+        nullColumn->prefetch(startOffset, numValues, stats);
+    }
+    codesColumn->prefetch(startOffset, numValues, stats);
+}
+
+void StringPropertyColumn::setNull(offset_t nodeOffset) {
+    Column::setNull(nodeOffset);
+    if (dictionary) {
+        codesColumn->writeCode(nodeOffset, StringDictionary::INVALID_CODE);
+    }
+}
+
+void StringPropertyColumn::lookup(
+    Transaction* transaction, offset_t nodeOffset, ValueVector* resultVector, uint32_t vectorPos) {
+    resultVector->resetAuxiliaryBuffer();
+    if (!dictionary) {
+        lookupString(transaction, nodeOffset, resultVector, vectorPos);
+        return;
+    }
+    StringVector::setDictionary(resultVector, dictionary.get());
+    if (resultVector->isNull(vectorPos)) {
+        return;
+    }
+    auto code = codesColumn->readCode(transaction, nodeOffset);
+    StringVector::getDictionaryCodes(resultVector)[vectorPos] = code;
+    if (code != StringDictionary::INVALID_CODE) {
+        resultVector->getValue<ku_string_t>(vectorPos) = dictionary->getEntry(code);
+    } else {
+        lookupString(transaction, nodeOffset, resultVector, vectorPos);
+    }
+}
+
+void StringPropertyColumn::scan(
+    Transaction* transaction, ValueVector* nodeIDVector, ValueVector* resultVector) {
+    resultVector->resetAuxiliaryBuffer();
+    if (!dictionary) {
+        Column::scan(transaction, nodeIDVector, resultVector);
+        diskOverflowFile->scanStrings(transaction->getType(), *resultVector);
+        return;
+    }
+    StringVector::setDictionary(resultVector, dictionary.get());
+    auto startOffset = nodeIDVector->readNodeOffset(0);
+    auto codes = StringVector::getDictionaryCodes(resultVector);
+    codesColumn->readCodes(transaction, startOffset, nodeIDVector->state->originalSize, codes);
+    auto& selVector = nodeIDVector->state->selVector;
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        auto pos = selVector->selectedPositions[i];
+        if (resultVector->isNull(pos)) {
+            continue;
+        }
+        if (codes[pos] != StringDictionary::INVALID_CODE) {
+            resultVector->getValue<ku_string_t>(pos) = dictionary->getEntry(codes[pos]);
+        } else {
+            lookupString(transaction, startOffset + pos, resultVector, pos);
+        }
+    }
+}
+
+void StringPropertyColumn::write(
+    offset_t nodeOffset, ValueVector* vectorToWriteFrom, uint32_t posInVectorToWriteFrom) {
+    Column::write(nodeOffset, vectorToWriteFrom, posInVectorToWriteFrom);
+    if (dictionary) {
+        auto code = vectorToWriteFrom->isNull(posInVectorToWriteFrom) ?
+                        StringDictionary::INVALID_CODE :
+                        dictionary->getCode(
+                            vectorToWriteFrom->getValue<ku_string_t>(posInVectorToWriteFrom));
+        codesColumn->writeCode(nodeOffset, code);
+    }
+}
+
+void StringPropertyColumn::lookupString(
+    Transaction* transaction, offset_t nodeOffset, ValueVector* resultVector, uint32_t vectorPos) {
+    Column::lookup(transaction, nodeOffset, resultVector, vectorPos);
+    if (!resultVector->isNull(vectorPos)) {
+        diskOverflowFile->scanSingleStringOverflow(
+            transaction->getType(), *resultVector, vectorPos);
+    }
+}
+
 Value StringPropertyColumn::readValueForTestingOnly(offset_t offset) {
     ku_string_t kuString;
     auto cursor = PageUtils::getPageElementCursorForPos(offset, numElementsPerPage);
@@ -362,6 +548,179 @@ void InternalIDColumn::writeInternalIDToPage(uint8_t* frame, uint16_t posInFrame
     memcpy(frame + posInFrame * sizeof(offset_t), &relID.offset, sizeof(offset_t));
 }
 
+void CompressedColumn::batchLookup(const offset_t* nodeOffsets, size_t size, uint8_t* result) {
+    auto dummyReadOnlyTransaction = Transaction::getDummyReadOnlyTrx();
+    for (auto i = 0u; i < size; ++i) {
+        readValues(dummyReadOnlyTransaction.get(), nodeOffsets[i], 1, result + i * elementSize);
+    }
+}
+
+void CompressedColumn::prefetch(offset_t startOffset, uint64_t numValues, PrefetchStats& stats) {
+    if (numValues == 0) {
+        return;
+    }
+    nullColumn->prefetch(startOffset, numValues, stats);
+    // Only the first page of each segment is read ahead, as the number of pages taken by a
+    // segment is only known from its header.
+    auto numValuesPerSegment = compression.getNumValuesPerSegment();
+    auto startSegmentIdx = startOffset / numValuesPerSegment;
+    auto endSegmentIdx = (startOffset + numValues - 1) / numValuesPerSegment;
+    for (auto segmentIdx = startSegmentIdx; segmentIdx <= endSegmentIdx; segmentIdx++) {
+        bufferManager->prefetch(*fileHandle, getFirstPageIdxOfSegment(segmentIdx), 1, stats);
+    }
+}
+
+void CompressedColumn::setNull(offset_t nodeOffset) {
+    nullColumn->setValue(nodeOffset);
+    if (zoneMap) {
+        zoneMap->addNull(nodeOffset);
+    }
+    addSegmentIfNecessary(nodeOffset / compression.getNumValuesPerSegment());
+}
+
+Value CompressedColumn::readValueForTestingOnly(offset_t offset) {
+    Value retVal = Value::createDefaultValue(dataType);
+    std::vector<uint8_t> value(elementSize);
+    auto dummyReadOnlyTransaction = Transaction::getDummyReadOnlyTrx();
+    readValues(dummyReadOnlyTransaction.get(), offset, 1, value.data());
+    retVal.copyValueFrom(value.data());
+    return retVal;
+}
+
+void CompressedColumn::lookup(Transaction* transaction, offset_t nodeOffset,
+    ValueVector* resultVector, uint32_t vectorPos) {
+    readValues(transaction, nodeOffset, 1, resultVector->getData() + vectorPos * elementSize);
+}
+
+void CompressedColumn::scan(
+    Transaction* transaction, ValueVector* nodeIDVector, ValueVector* resultVector) {
+    auto& selVector = nodeIDVector->state->selVector;
+    if (selVector->selectedSize == 0) {
+        return;
+    }
+    // In sequential read, we fetch start offset regardless of selected position. Values before the
+    // first and after the last selected positions are not decompressed.
+    auto startPos = selVector->isUnfiltered() ? 0 : selVector->selectedPositions[0];
+    auto endPos = selVector->isUnfiltered() ?
+                      nodeIDVector->state->originalSize :
+                      selVector->selectedPositions[selVector->selectedSize - 1] + 1;
+    readValues(transaction, nodeIDVector->readNodeOffset(0) + startPos, endPos - startPos,
+        resultVector->getData() + startPos * elementSize, BufferManager::AccessHint::SCAN);
+}
+
+void CompressedColumn::write(
+    offset_t nodeOffset, ValueVector* vectorToWriteFrom, uint32_t posInVectorToWriteFrom) {
+    nullColumn->write(nodeOffset, vectorToWriteFrom, posInVectorToWriteFrom);
+    auto numValuesPerSegment = compression.getNumValuesPerSegment();
+    auto segmentIdx = nodeOffset / numValuesPerSegment;
+    // Nulls of new nodes also add their segment, as scans read the values at null positions.
+    addSegmentIfNecessary(segmentIdx);
+    if (vectorToWriteFrom->isNull(posInVectorToWriteFrom)) {
+        return;
+    }
+    auto posInSegment = nodeOffset % numValuesPerSegment;
+    auto value = vectorToWriteFrom->getData() + posInVectorToWriteFrom * elementSize;
+    auto dummyWriteTransaction = Transaction::getDummyWriteTrx();
+    auto header = readSegmentHeader(
+        dummyWriteTransaction.get(), segmentIdx, BufferManager::AccessHint::NORMAL);
+    if (!compression.canUpdateInPlace(header, value)) {
+        recompressSegment(segmentIdx, posInSegment, value);
+        return;
+    }
+    if (header.compressionType == CompressionType::CONSTANT) {
+        return;
+    }
+    auto cursor = compression.getCursor(header, posInSegment);
+    StorageStructureUtils::updatePage(*fileHandle, storageStructureID,
+        getFirstPageIdxOfSegment(segmentIdx) + cursor.pageIdxInSegment,
+        false /* isInsertingNewPage */, *bufferManager, *wal,
+        [&](uint8_t* frame) { compression.updateInPlace(frame, header, cursor, value); });
+}
+
+void CompressedColumn::readValues(Transaction* transaction, offset_t startOffset,
+    uint64_t numValues, uint8_t* result, BufferManager::AccessHint accessHint) {
+    auto numValuesPerSegment = compression.getNumValuesPerSegment();
+    uint64_t numValuesRead = 0;
+    while (numValuesRead < numValues) {
+        auto segmentIdx = (startOffset + numValuesRead) / numValuesPerSegment;
+        auto posInSegment = (startOffset + numValuesRead) % numValuesPerSegment;
+        auto numValuesToReadInSegment =
+            std::min(numValuesPerSegment - posInSegment, numValues - numValuesRead);
+        auto header = readSegmentHeader(transaction, segmentIdx, accessHint);
+        if (header.compressionType == CompressionType::CONSTANT) {
+            compression.decompressValues(nullptr /* frame */, header, SegmentCursor{},
+                numValuesToReadInSegment, result + numValuesRead * elementSize);
+            numValuesRead += numValuesToReadInSegment;
+            continue;
+        }
+        auto endPosInSegment = posInSegment + numValuesToReadInSegment;
+        while (posInSegment < endPosInSegment) {
+            auto cursor = compression.getCursor(header, posInSegment);
+            auto numValuesToReadInPage =
+                std::min(cursor.numValuesLeftInPage, endPosInSegment - posInSegment);
+            readFromPage(
+                transaction, getFirstPageIdxOfSegment(segmentIdx) + cursor.pageIdxInSegment,
+                [&](uint8_t* frame) {
+                    compression.decompressValues(frame, header, cursor, numValuesToReadInPage,
+                        result + numValuesRead * elementSize);
+                },
+                accessHint);
+            posInSegment += numValuesToReadInPage;
+            numValuesRead += numValuesToReadInPage;
+        }
+    }
+}
+
+SegmentHeader CompressedColumn::readSegmentHeader(
+    Transaction* transaction, uint64_t segmentIdx, BufferManager::AccessHint accessHint) {
+    SegmentHeader header;
+    readFromPage(
+        transaction, getFirstPageIdxOfSegment(segmentIdx),
+        [&](uint8_t* frame) { memcpy(&header, frame, sizeof(SegmentHeader)); }, accessHint);
+    return header;
+}
+
+void CompressedColumn::addSegmentIfNecessary(uint64_t segmentIdx) {
+    auto firstPageIdx = getFirstPageIdxOfSegment(segmentIdx);
+    if (firstPageIdx < fileHandle->getNumPages()) {
+        return;
+    }
+    assert(firstPageIdx == fileHandle->getNumPages());
+    for (auto i = 0u; i < StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT; i++) {
+        addNewPageToFileHandle();
+    }
+    // The contents of new pages are undefined, so the header is written explicitly.
+    auto header = compression.getUncompressedHeader();
+    StorageStructureUtils::updatePage(*fileHandle, storageStructureID, firstPageIdx,
+        true /* isInsertingNewPage */, *bufferManager, *wal,
+        [&](uint8_t* frame) { memcpy(frame, &header, sizeof(SegmentHeader)); });
+}
+
+void CompressedColumn::recompressSegment(
+    uint64_t segmentIdx, uint64_t posInSegment, const uint8_t* value) {
+    auto numValuesPerSegment = compression.getNumValuesPerSegment();
+    auto values = std::make_unique<uint8_t[]>(numValuesPerSegment * elementSize);
+    auto dummyWriteTransaction = Transaction::getDummyWriteTrx();
+    // Values at null positions are decompressed as values within the range of the segment, so
+    // they don't widen the compression.
+    readValues(
+        dummyWriteTransaction.get(), segmentIdx * numValuesPerSegment, numValuesPerSegment,
+        values.get());
+    memcpy(values.get() + posInSegment * elementSize, value, elementSize);
+    auto segmentBuffer = std::make_unique<uint8_t[]>(
+        StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT * BufferPoolConstants::PAGE_4KB_SIZE);
+    auto numPages = compression.compressSegment(
+        values.get(), nullptr /* isNull */, numValuesPerSegment, segmentBuffer.get());
+    for (auto i = 0u; i < numPages; i++) {
+        StorageStructureUtils::updatePage(*fileHandle, storageStructureID,
+            getFirstPageIdxOfSegment(segmentIdx) + i, false /* isInsertingNewPage */,
+            *bufferManager, *wal, [&](uint8_t* frame) {
+                memcpy(frame, segmentBuffer.get() + i * BufferPoolConstants::PAGE_4KB_SIZE,
+                    BufferPoolConstants::PAGE_4KB_SIZE);
+            });
+    }
+}
+
 void SerialColumn::read(transaction::Transaction* transaction, common::ValueVector* nodeIDVector,
     common::ValueVector* resultVector) {
     // Serial column cannot contain null values.
@@ -0,0 +1,227 @@
+#include "storage/storage_structure/column_compression.h"
+
+#include <bit>
+#include <cstring>
+
+#include "common/exception.h"
+#include "common/utils.h"
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace storage {
+
+static constexpr uint64_t NUM_BITS_PER_PAGE = BufferPoolConstants::PAGE_4KB_SIZE * 8;
+static constexpr uint64_t NUM_HEADER_BITS = sizeof(SegmentHeader) * 8;
+
+template<typename T>
+static void unpackValues(const uint8_t* frame, uint64_t bitOffset, uint8_t bitWidth,
+    int64_t reference, uint64_t numValues, T* result) {
+    for (auto i = 0u; i < numValues; i++) {
+        auto delta = BitPackingUtils::unpackValue(
+            frame, BufferPoolConstants::PAGE_4KB_SIZE, bitOffset, bitWidth);
+        result[i] = (T)((uint64_t)reference + delta);
+        bitOffset += bitWidth;
+    }
+}
+
+template<typename T>
+static SegmentHeader chooseCompressionForValues(
+    const T* values, const bool* isNull, uint64_t numValues) {
+    bool hasNonNullValue = false;
+    T minValue = 0, maxValue = 0;
+    for (auto i = 0u; i < numValues; i++) {
+        if (isNull && isNull[i]) {
+            continue;
+        }
+        if (!hasNonNullValue) {
+            minValue = maxValue = values[i];
+            hasNonNullValue = true;
+        } else {
+            minValue = std::min(minValue, values[i]);
+            maxValue = std::max(maxValue, values[i]);
+        }
+    }
+    if (!hasNonNullValue || minValue == maxValue) {
+        return SegmentHeader{
+            CompressionType::CONSTANT, 0 /* bitWidth */, hasNonNullValue ? minValue : 0};
+    }
+    auto range = (uint64_t)(int64_t)maxValue - (uint64_t)(int64_t)minValue;
+    auto bitWidth = (uint8_t)std::bit_width(range);
+    if (bitWidth >= sizeof(T) * 8) {
+        return SegmentHeader{CompressionType::UNCOMPRESSED, sizeof(T) * 8, 0 /* reference */};
+    }
+    return SegmentHeader{CompressionType::BIT_PACKING, bitWidth, minValue};
+}
+
+ColumnCompression::ColumnCompression(uint64_t numBytesPerValue)
+    : numBytesPerValue{numBytesPerValue} {
+    numValuesPerSegment = (StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT *
+                                  BufferPoolConstants::PAGE_4KB_SIZE -
+                              sizeof(SegmentHeader)) /
+                          numBytesPerValue;
+}
+
+bool ColumnCompression::isCompressible(const LogicalType& dataType) {
+    switch (dataType.getLogicalTypeID()) {
+    case LogicalTypeID::INT64:
+    case LogicalTypeID::INT32:
+    case LogicalTypeID::INT16:
+    case LogicalTypeID::DATE:
+    case LogicalTypeID::TIMESTAMP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+SegmentCursor ColumnCompression::getCursor(
+    const SegmentHeader& header, uint64_t posInSegment) const {
+    assert(header.compressionType != CompressionType::CONSTANT);
+    auto numValuesInFirstPage = (NUM_BITS_PER_PAGE - NUM_HEADER_BITS) / header.bitWidth;
+    if (posInSegment < numValuesInFirstPage) {
+        return SegmentCursor{0 /* pageIdxInSegment */,
+            NUM_HEADER_BITS + posInSegment * header.bitWidth, numValuesInFirstPage - posInSegment};
+    }
+    auto numValuesPerPage = NUM_BITS_PER_PAGE / header.bitWidth;
+    auto posInPages = posInSegment - numValuesInFirstPage;
+    auto posInPage = posInPages % numValuesPerPage;
+    return SegmentCursor{(page_idx_t)(1 + posInPages / numValuesPerPage),
+        posInPage * header.bitWidth, numValuesPerPage - posInPage};
+}
+
+uint64_t ColumnCompression::compressSegment(
+    const uint8_t* values, const bool* isNull, uint64_t numValues, uint8_t* segmentBuffer) const {
+    assert(numValues <= numValuesPerSegment);
+    auto header = chooseCompression(values, isNull, numValues);
+    uint64_t numPages = 1;
+    if (header.compressionType != CompressionType::CONSTANT && numValues > 0) {
+        numPages = getCursor(header, numValues - 1).pageIdxInSegment + 1;
+    }
+    memset(segmentBuffer, 0, numPages * BufferPoolConstants::PAGE_4KB_SIZE);
+    memcpy(segmentBuffer, &header, sizeof(SegmentHeader));
+    if (header.compressionType == CompressionType::CONSTANT) {
+        return numPages;
+    }
+    uint64_t numValuesWritten = 0;
+    while (numValuesWritten < numValues) {
+        auto cursor = getCursor(header, numValuesWritten);
+        auto numValuesToWrite = std::min(cursor.numValuesLeftInPage, numValues - numValuesWritten);
+        auto frame = segmentBuffer + cursor.pageIdxInSegment * BufferPoolConstants::PAGE_4KB_SIZE;
+        if (header.compressionType == CompressionType::UNCOMPRESSED) {
+            memcpy(frame + cursor.bitOffsetInPage / 8, values + numValuesWritten * numBytesPerValue,
+                numValuesToWrite * numBytesPerValue);
+        } else {
+            for (auto i = 0u; i < numValuesToWrite; i++) {
+                auto pos = numValuesWritten + i;
+                if (isNull && isNull[pos]) {
+                    continue;
+                }
+                auto delta = (uint64_t)readValue(values + pos * numBytesPerValue) -
+                             (uint64_t)header.reference;
+                BitPackingUtils::packValue(frame, cursor.bitOffsetInPage + i * header.bitWidth,
+                    header.bitWidth, delta);
+            }
+        }
+        numValuesWritten += numValuesToWrite;
+    }
+    return numPages;
+}
+
+void ColumnCompression::decompressValues(const uint8_t* frame, const SegmentHeader& header,
+    const SegmentCursor& cursor, uint64_t numValues, uint8_t* result) const {
+    switch (header.compressionType) {
+    case CompressionType::UNCOMPRESSED: {
+        memcpy(result, frame + cursor.bitOffsetInPage / 8, numValues * numBytesPerValue);
+    } break;
+    case CompressionType::CONSTANT: {
+        for (auto i = 0u; i < numValues; i++) {
+            memcpy(result + i * numBytesPerValue, &header.reference, numBytesPerValue);
+        }
+    } break;
+    case CompressionType::BIT_PACKING: {
+        switch (numBytesPerValue) {
+        case sizeof(int16_t): {
+            unpackValues(frame, cursor.bitOffsetInPage, header.bitWidth, header.reference,
+                numValues, (int16_t*)result);
+        } break;
+        case sizeof(int32_t): {
+            unpackValues(frame, cursor.bitOffsetInPage, header.bitWidth, header.reference,
+                numValues, (int32_t*)result);
+        } break;
+        default: {
+            unpackValues(frame, cursor.bitOffsetInPage, header.bitWidth, header.reference,
+                numValues, (int64_t*)result);
+        }
+        }
+    } break;
+    }
+}
+
+bool ColumnCompression::canUpdateInPlace(const SegmentHeader& header, const uint8_t* value) const {
+    switch (header.compressionType) {
+    case CompressionType::UNCOMPRESSED: {
+        return true;
+    }
+    case CompressionType::CONSTANT: {
+        return readValue(value) == header.reference;
+    }
+    case CompressionType::BIT_PACKING: {
+        // Values smaller than the reference wrap around to large differences.
+        return (uint64_t)readValue(value) - (uint64_t)header.reference <=
+               BitmaskUtils::all1sMaskForLeastSignificantBits(header.bitWidth);
+    }
+    default: {
+        throw NotImplementedException("ColumnCompression::canUpdateInPlace");
+    }
+    }
+}
+
+void ColumnCompression::updateInPlace(uint8_t* frame, const SegmentHeader& header,
+    const SegmentCursor& cursor, const uint8_t* value) const {
+    assert(canUpdateInPlace(header, value));
+    switch (header.compressionType) {
+    case CompressionType::UNCOMPRESSED: {
+        memcpy(frame + cursor.bitOffsetInPage / 8, value, numBytesPerValue);
+    } break;
+    case CompressionType::CONSTANT: {
+        // The value is already stored as the reference.
+    } break;
+    case CompressionType::BIT_PACKING: {
+        BitPackingUtils::packValue(frame, cursor.bitOffsetInPage, header.bitWidth,
+            (uint64_t)readValue(value) - (uint64_t)header.reference);
+    } break;
+    }
+}
+
+SegmentHeader ColumnCompression::chooseCompression(
+    const uint8_t* values, const bool* isNull, uint64_t numValues) const {
+    switch (numBytesPerValue) {
+    case sizeof(int16_t): {
+        return chooseCompressionForValues((int16_t*)values, isNull, numValues);
+    }
+    case sizeof(int32_t): {
+        return chooseCompressionForValues((int32_t*)values, isNull, numValues);
+    }
+    default: {
+        return chooseCompressionForValues((int64_t*)values, isNull, numValues);
+    }
+    }
+}
+
+int64_t ColumnCompression::readValue(const uint8_t* value) const {
+    switch (numBytesPerValue) {
+    case sizeof(int16_t): {
+        return *(int16_t*)value;
+    }
+    case sizeof(int32_t): {
+        return *(int32_t*)value;
+    }
+    default: {
+        return *(int64_t*)value;
+    }
+    }
+}
+
+} // namespace storage
+} // namespace kuzu
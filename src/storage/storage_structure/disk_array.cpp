@@ -97,6 +97,38 @@ U BaseDiskArray<U>::get(uint64_t idx, TransactionType trxType) {
     }
 }
 
+template<typename U>
+void BaseDiskArray<U>::get(
+    const uint64_t* idxs, uint64_t numIdxs, TransactionType trxType, U* values) {
+    std::shared_lock sLck{diskArraySharedMtx};
+    auto& bmFileHandle = (BMFileHandle&)fileHandle;
+    uint64_t startIdx = 0;
+    while (startIdx < numIdxs) {
+        checkOutOfBoundAccess(trxType, idxs[startIdx]);
+        auto apIdx = getAPIdxAndOffsetInAP(idxs[startIdx]).pageIdx;
+        auto endIdx = startIdx + 1;
+        while (endIdx < numIdxs && getAPIdxAndOffsetInAP(idxs[endIdx]).pageIdx == apIdx) {
+            checkOutOfBoundAccess(trxType, idxs[endIdx]);
+            endIdx++;
+        }
+        auto readElements = [&](const uint8_t* frame) -> void {
+            for (auto i = startIdx; i < endIdx; i++) {
+                values[i] = *(U*)(frame + getAPIdxAndOffsetInAP(idxs[i]).offsetInPage);
+            }
+        };
+        page_idx_t apPageIdx = getAPPageIdxNoLock(apIdx, trxType);
+        if (trxType == TransactionType::READ_ONLY || !hasTransactionalUpdates ||
+            !bmFileHandle.hasWALPageVersionNoWALPageIdxLock(apPageIdx)) {
+            bufferManager->optimisticRead(bmFileHandle, apPageIdx, readElements);
+        } else {
+            bmFileHandle.acquireWALPageIdxLock(apPageIdx);
+            StorageStructureUtils::readWALVersionOfPage(
+                bmFileHandle, apPageIdx, *bufferManager, *wal, readElements);
+        }
+        startIdx = endIdx;
+    }
+}
+
 template<typename U>
 void BaseDiskArray<U>::update(uint64_t idx, U val) {
     std::unique_lock xLck{diskArraySharedMtx};
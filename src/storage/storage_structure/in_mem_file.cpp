@@ -35,6 +35,15 @@ uint32_t InMemFile::addANewPage(bool setToZero) {
     return newPageIdx;
 }
 
+page_idx_t InMemFile::movePagesFrom(InMemFile& other) {
+    auto firstPageIdx = pages.size();
+    for (auto& page : other.pages) {
+        pages.push_back(std::move(page));
+    }
+    other.pages.clear();
+    return firstPageIdx;
+}
+
 void InMemFile::flush() {
     if (filePath.empty()) {
         throw CopyException("InMemPages: Empty filename");
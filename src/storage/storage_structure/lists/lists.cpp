@@ -25,6 +25,7 @@ void Lists::readValues(Transaction* transaction, ValueVector* valueVector, ListH
         if (listHandle.getStartElemOffset() == 0) {
             listHandle.setMapper(metadata);
         }
+        prefetchLargeList(listHandle, listHandle.getStartElemOffset());
         readFromList(valueVector, listHandle);
         if (transaction->isWriteTransaction()) {
             listsUpdatesStore->readUpdatesToPropertyVectorIfExists(
@@ -42,6 +43,36 @@ void Lists::readFromList(common::ValueVector* valueVector, ListHandle& listHandl
         Transaction::getDummyReadOnlyTrx().get(), valueVector, pageCursor, listHandle.mapper);
 }
 
+void Lists::prefetchLargeList(ListHandle& listHandle, uint32_t startElemOffset) {
+    auto numValuesInList = listHandle.getNumValuesInList();
+    if (numValuesInList <= DEFAULT_VECTOR_CAPACITY) {
+        return;
+    }
+    auto numValuesToPrefetch =
+        std::min(BufferPoolConstants::NUM_VECTORS_TO_READ_AHEAD * DEFAULT_VECTOR_CAPACITY,
+            (uint64_t)numValuesInList - startElemOffset);
+    auto csrOffset = headers->getCSROffset(listHandle.getBoundNodeOffset()) + startElemOffset;
+    auto numElementsPerPageOfList = getNumElementsPerPageForNode(listHandle.getBoundNodeOffset());
+    auto startPageIdx = csrOffset / numElementsPerPageOfList;
+    auto endPageIdx = (csrOffset + numValuesToPrefetch - 1) / numElementsPerPageOfList;
+    // Consecutive pages of a list are not necessarily consecutive in the file, so each run of
+    // consecutive physical pages is prefetched separately.
+    auto& stats = listHandle.getPrefetchStats();
+    auto runStartPageIdx = listHandle.mapper(startPageIdx);
+    uint64_t numPagesInRun = 1;
+    for (auto pageIdx = startPageIdx + 1; pageIdx <= endPageIdx; pageIdx++) {
+        auto physicalPageIdx = listHandle.mapper(pageIdx);
+        if (physicalPageIdx == runStartPageIdx + numPagesInRun) {
+            numPagesInRun++;
+            continue;
+        }
+        bufferManager->prefetch(*fileHandle, runStartPageIdx, numPagesInRun, stats);
+        runStartPageIdx = physicalPageIdx;
+        numPagesInRun = 1;
+    }
+    bufferManager->prefetch(*fileHandle, runStartPageIdx, numPagesInRun, stats);
+}
+
 uint64_t Lists::getNumElementsInPersistentStore(
     TransactionType transactionType, offset_t nodeOffset) {
     if (transactionType == TransactionType::WRITE &&
@@ -247,48 +278,66 @@ void AdjLists::readValues(
     }
 }
 
-std::unique_ptr<std::vector<nodeID_t>> AdjLists::readAdjacencyListOfNode(
-    // We read the adjacency list of a node in 2 steps: i) we read all the bytes from the pages
-    // that hold the list into a buffer; and (ii) we interpret the bytes in the buffer based on
-    // the nodeIDCompressionScheme into a std::vector of nodeID_t.
-    offset_t nodeOffset) {
-    auto pageMapper = ListHandle::getPageMapper(metadata, nodeOffset);
+template<typename FUNC>
+void AdjLists::readNbrOffsets(offset_t nodeOffset,
+    const std::function<uint32_t(uint32_t)>& pageMapper, uint64_t startElemOffset,
+    uint64_t numValues, FUNC&& func) {
+    auto bitWidth = getNbrOffsetBitWidth(nodeOffset);
+    auto numNbrOffsetsPerPage = ListsMetadata::getNumNbrOffsetsPerPage(bitWidth);
     auto pageCursor = PageUtils::getPageElementCursorForPos(
-        headers->getCSROffset(nodeOffset), numElementsPerPage);
-    // Step 1
-    auto numElementsInList = getNumElementsFromListHeader(nodeOffset);
-    auto listLenInBytes = numElementsInList * elementSize;
-    auto buffer = std::make_unique<uint8_t[]>(listLenInBytes);
-    auto sizeLeftToCopy = listLenInBytes;
-    auto bufferPtr = buffer.get();
-    while (sizeLeftToCopy) {
-        auto physicalPageIdx = pageMapper(pageCursor.pageIdx);
-        auto sizeToCopyInPage =
-            std::min(((uint64_t)(numElementsPerPage - pageCursor.elemPosInPage) * elementSize),
-                sizeLeftToCopy);
-        bufferManager->optimisticRead(*fileHandle, physicalPageIdx, [&](uint8_t* frame) {
-            memcpy(bufferPtr, frame + mapElementPosToByteOffset(pageCursor.elemPosInPage),
-                sizeToCopyInPage);
-        });
-        bufferPtr += sizeToCopyInPage;
-        sizeLeftToCopy -= sizeToCopyInPage;
+        headers->getCSROffset(nodeOffset) + startElemOffset, numNbrOffsetsPerPage);
+    uint64_t numValuesRead = 0;
+    while (numValuesRead < numValues) {
+        auto numValuesToReadInPage = std::min(
+            numValues - numValuesRead, numNbrOffsetsPerPage - pageCursor.elemPosInPage);
+        bufferManager->optimisticRead(
+            *fileHandle, pageMapper(pageCursor.pageIdx), [&](const uint8_t* frame) {
+                auto bitOffset = (uint64_t)pageCursor.elemPosInPage * bitWidth;
+                for (auto i = 0u; i < numValuesToReadInPage; i++) {
+                    func(numValuesRead + i,
+                        BitPackingUtils::unpackValue(
+                            frame, BufferPoolConstants::PAGE_4KB_SIZE, bitOffset, bitWidth));
+                    bitOffset += bitWidth;
+                }
+            });
+        numValuesRead += numValuesToReadInPage;
         pageCursor.nextPage();
     }
+}
 
-    // Step 2
-    std::unique_ptr<std::vector<nodeID_t>> retVal = std::make_unique<std::vector<nodeID_t>>();
-    auto sizeLeftToDecompress = listLenInBytes;
-    bufferPtr = buffer.get();
-    while (sizeLeftToDecompress) {
-        nodeID_t nodeID(0, nbrTableID);
-        nodeID.offset = *(offset_t*)bufferPtr;
-        bufferPtr += sizeof(offset_t);
-        retVal->emplace_back(nodeID);
-        sizeLeftToDecompress -= sizeof(offset_t);
-    }
+std::unique_ptr<std::vector<nodeID_t>> AdjLists::readAdjacencyListOfNode(offset_t nodeOffset) {
+    auto numElementsInList = getNumElementsFromListHeader(nodeOffset);
+    auto retVal = std::make_unique<std::vector<nodeID_t>>(numElementsInList);
+    readNbrOffsets(nodeOffset, ListHandle::getPageMapper(metadata, nodeOffset),
+        0 /* startElemOffset */, numElementsInList, [&](uint64_t pos, offset_t nbrOffset) {
+            (*retVal)[pos] = nodeID_t{nbrOffset, nbrTableID};
+        });
     return retVal;
 }
 
+void AdjLists::fillInMemListsFromPersistentStore(offset_t nodeOffset,
+    uint64_t numElementsInPersistentStore, InMemList& inMemList,
+    const std::unordered_set<list_offset_t>& deletedRelOffsetsInList,
+    UpdatedPersistentListOffsets* updatedPersistentListOffsets) {
+    assert(updatedPersistentListOffsets == nullptr);
+    auto pageMapper = ListHandle::getPageMapper(metadata, nodeOffset);
+    auto listData = (offset_t*)inMemList.getListData();
+    if (deletedRelOffsetsInList.empty()) {
+        readNbrOffsets(nodeOffset, pageMapper, 0 /* startElemOffset */,
+            numElementsInPersistentStore,
+            [&](uint64_t pos, offset_t nbrOffset) { listData[pos] = nbrOffset; });
+        return;
+    }
+    std::vector<offset_t> nbrOffsets(numElementsInPersistentStore);
+    readNbrOffsets(nodeOffset, pageMapper, 0 /* startElemOffset */, numElementsInPersistentStore,
+        [&](uint64_t pos, offset_t nbrOffset) { nbrOffsets[pos] = nbrOffset; });
+    for (auto relOffsetInList = 0u; relOffsetInList < nbrOffsets.size(); relOffsetInList++) {
+        if (!deletedRelOffsetsInList.contains(relOffsetInList)) {
+            *listData++ = nbrOffsets[relOffsetInList];
+        }
+    }
+}
+
 // Note: This function sets the original and selected size of the DataChunk into which it will
 // read a list of nodes and edges.
 void AdjLists::readFromList(ValueVector* valueVector, ListHandle& listHandle) {
@@ -296,18 +345,16 @@ void AdjLists::readFromList(ValueVector* valueVector, ListHandle& listHandle) {
     auto numValuesToRead = std::min(common::DEFAULT_VECTOR_CAPACITY,
         (uint64_t)listHandle.getNumValuesInList() - startOffsetToRead);
     valueVector->state->initOriginalAndSelectedSize(numValuesToRead);
-    // We store the updates for adjLists in listsUpdatesStore, however we store the
-    // updates for adjColumn in the WAL version of the page. The adjColumn needs to pass a
-    // transaction to readNodeIDsBySequentialCopy, so readNodeIDsBySequentialCopy can know
-    // whether to read the wal version or the original version of the page. AdjLists never reads
-    // the wal version of the page(since its updates are stored in listsUpdatesStore), so we
-    // simply pass a dummy read-only transaction to readNodeIDsBySequentialCopy.
-    auto dummyReadOnlyTrx = Transaction::getDummyReadOnlyTrx();
-    auto pageCursor = PageUtils::getPageElementCursorForPos(
-        headers->getCSROffset(listHandle.getBoundNodeOffset()) + startOffsetToRead,
-        numElementsPerPage);
-    readInternalIDsBySequentialCopy(dummyReadOnlyTrx.get(), valueVector, pageCursor,
-        listHandle.mapper, nbrTableID, true /* hasNoNullGuarantee */);
+    // We store the updates for adjLists in listsUpdatesStore, however we store the updates for
+    // adjColumn in the WAL version of the page. So AdjLists never reads the wal version of the
+    // page, and the neighbour offsets are unpacked from the original version of the page.
+    prefetchLargeList(listHandle, startOffsetToRead);
+    valueVector->setRangeNonNull(0 /* startPos */, numValuesToRead);
+    auto nbrNodeIDs = (nodeID_t*)valueVector->getData();
+    readNbrOffsets(listHandle.getBoundNodeOffset(), listHandle.mapper, startOffsetToRead,
+        numValuesToRead, [&](uint64_t pos, offset_t nbrOffset) {
+            nbrNodeIDs[pos] = nodeID_t{nbrOffset, nbrTableID};
+        });
     // We set the startIdx + numValuesToRead == numValuesInList in listSyncState to indicate to
     // the callers (e.g., the adj_list_extend or var_len_extend) that we have read the small
     // list already. This allows the callers to know when to switch to reading from the update
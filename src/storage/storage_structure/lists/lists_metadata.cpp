@@ -6,6 +6,7 @@
 #include "storage/storage_utils.h"
 
 using namespace kuzu::common;
+using namespace kuzu::transaction;
 
 namespace kuzu {
 namespace storage {
@@ -25,6 +26,17 @@ ListsMetadata::ListsMetadata(
     pageLists = std::make_unique<InMemDiskArray<page_idx_t>>(*metadataVersionedFileHandle,
         storageStructureIDAndFName.storageStructureID, CHUNK_PAGE_LIST_HEADER_PAGE_IDX,
         bufferManager, wal);
+    chunkToNbrOffsetBitWidthMap = std::make_unique<InMemDiskArray<uint32_t>>(
+        *metadataVersionedFileHandle, storageStructureIDAndFName.storageStructureID,
+        CHUNK_NBR_OFFSET_BIT_WIDTH_MAP_HEADER_PAGE_IDX, bufferManager, wal);
+}
+
+void ListsMetadata::setNbrOffsetBitWidth(uint64_t chunkIdx, uint32_t bitWidth) {
+    // Chunks without a bit width, which were created after COPY, are uncompressed.
+    while (chunkToNbrOffsetBitWidthMap->getNumElements(TransactionType::WRITE) <= chunkIdx) {
+        chunkToNbrOffsetBitWidthMap->pushBack(UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH);
+    }
+    chunkToNbrOffsetBitWidthMap->update(chunkIdx, bitWidth);
 }
 
 uint64_t BaseListsMetadata::getPageIdxFromAPageList(
@@ -46,17 +58,26 @@ ListsMetadataBuilder::ListsMetadataBuilder(const std::string& listBaseFName) : B
     // disk array in listsMetadata (so that these header pages are pre-allocated and not used
     // for another purpose)
     metadataFileHandleForBuilding->addNewPage(); // CHUNK_PAGE_LIST_HEAD_IDX_MAP_HEADER_PAGE_IDX=0
-    metadataFileHandleForBuilding
-        ->addNewPage(); // LARGE_LIST_IDX_TO_PAGE_LIST_HEAD_IDX_MAP_HEADER_PAGE_IDX
-    metadataFileHandleForBuilding->addNewPage(); // CHUNK_PAGE_LIST_HEADER_PAGE_IDX
+    metadataFileHandleForBuilding->addNewPage(); // CHUNK_PAGE_LIST_HEADER_PAGE_IDX=1
+    metadataFileHandleForBuilding->addNewPage(); // CHUNK_NBR_OFFSET_BIT_WIDTH_MAP_HEADER_PAGE_IDX=2
     // Initialize an empty page lists array for building
     pageListsBuilder = std::make_unique<InMemDiskArrayBuilder<page_idx_t>>(
         *metadataFileHandleForBuilding, CHUNK_PAGE_LIST_HEADER_PAGE_IDX, 0);
+    chunkToNbrOffsetBitWidthMapBuilder = std::make_unique<InMemDiskArrayBuilder<uint32_t>>(
+        *metadataFileHandleForBuilding, CHUNK_NBR_OFFSET_BIT_WIDTH_MAP_HEADER_PAGE_IDX, 0);
 }
 
 void ListsMetadataBuilder::saveToDisk() {
     chunkToPageListHeadIdxMapBuilder->saveToDisk();
     pageListsBuilder->saveToDisk();
+    chunkToNbrOffsetBitWidthMapBuilder->saveToDisk();
+}
+
+void ListsMetadataBuilder::setNbrOffsetBitWidths(const std::vector<uint32_t>& bitWidths) {
+    chunkToNbrOffsetBitWidthMapBuilder->resize(bitWidths.size(), false /* setToZero */);
+    for (auto chunkIdx = 0u; chunkIdx < bitWidths.size(); chunkIdx++) {
+        (*chunkToNbrOffsetBitWidthMapBuilder)[chunkIdx] = bitWidths[chunkIdx];
+    }
 }
 
 void ListsMetadataBuilder::initChunkPageLists(uint32_t numChunks_) {
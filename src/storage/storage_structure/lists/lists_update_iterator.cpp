@@ -57,6 +57,7 @@ void ListsUpdateIterator::seekToBeginningOfChunkIdx(uint64_t chunkIdx) {
     curChunkIdx = chunkIdx;
     curUnprocessedNodeOffset = StorageUtils::getChunkIdxBeginNodeOffset(curChunkIdx);
     curCSROffset = 0;
+    prepareChunk();
 }
 
 void ListsUpdateIterator::slideListsIfNecessary(uint64_t endNodeOffsetInclusive) {
@@ -66,7 +67,7 @@ void ListsUpdateIterator::slideListsIfNecessary(uint64_t endNodeOffsetInclusive)
             lists->headers->getCSROffset(nodeOffsetToSlide, TransactionType::READ_ONLY);
         auto listLen = lists->getHeaders()->getListSize(nodeOffsetToSlide);
         offset_t newCSROffset = curCSROffset;
-        if (newCSROffset != oldCSROffset) {
+        if (newCSROffset != oldCSROffset || mustRewriteListsInChunk()) {
             InMemList inMemList{listLen, lists->elementSize, lists->mayContainNulls()};
             const std::unordered_set<uint64_t> deletedRelOffsetsInList;
             lists->fillInMemListsFromPersistentStore(nodeOffsetToSlide,
@@ -112,7 +113,7 @@ bool ListsUpdateIterator::seekToNodeOffsetAndSlideListsIfNecessary(offset_t node
 void ListsUpdateIterator::writeInMemListToListPages(
     InMemList& inMemList, page_idx_t pageListHeadIdx) {
     auto [idxInPageList, elementOffsetInListPage] =
-        StorageUtils::getQuotientRemainder(curCSROffset, lists->numElementsPerPage);
+        StorageUtils::getQuotientRemainder(curCSROffset, getNumElementsPerPage());
     writeAtOffset(inMemList, pageListHeadIdx, idxInPageList, elementOffsetInListPage);
 }
 
@@ -223,7 +224,6 @@ page_idx_t ListsUpdateIterator::insertNewPageGroupAndSetHeadIdxMap(
 
 void ListsUpdateIterator::writeAtOffset(InMemList& inMemList, page_idx_t pageListHeadIdx,
     uint64_t idxInPageList, uint64_t elementOffsetInListPage) {
-    uint64_t elementSize = lists->elementSize;
     auto remainingNumElementsToWrite = inMemList.numElements;
     uint64_t numUpdatedElements = 0;
     bool firstIteration = true;
@@ -238,24 +238,63 @@ void ListsUpdateIterator::writeAtOffset(InMemList& inMemList, page_idx_t pageLis
         auto [listPageIdx, insertingNewPage] =
             findListPageIdxAndInsertListPageToPageListIfNecessary(idxInPageList, pageListHeadIdx);
         uint64_t numElementsToWriteToCurrentPage = std::min(
-            remainingNumElementsToWrite, lists->numElementsPerPage - elementOffsetInListPage);
+            remainingNumElementsToWrite, getNumElementsPerPage() - elementOffsetInListPage);
         StorageStructureUtils::updatePage(*(lists->getFileHandle()), lists->storageStructureID,
             listPageIdx, insertingNewPage, *lists->bufferManager, *(lists->wal),
-            [&inMemList, &elementOffsetInListPage, &numElementsToWriteToCurrentPage, &elementSize,
+            [&inMemList, &elementOffsetInListPage, &numElementsToWriteToCurrentPage,
                 &numUpdatedElements, this](uint8_t* frame) -> void {
-                auto dataToFill = inMemList.getListData() + numUpdatedElements * elementSize;
-                memcpy(frame + lists->getElemByteOffset(elementOffsetInListPage), dataToFill,
-                    numElementsToWriteToCurrentPage * elementSize);
-                if (inMemList.hasNullBuffer()) {
-                    NullMask::copyNullMask(inMemList.getNullMask(), numUpdatedElements,
-                        (uint64_t*)lists->getNullBufferInPage(frame), elementOffsetInListPage,
-                        numElementsToWriteToCurrentPage);
-                }
+                writeElementsToFrame(frame, inMemList, numUpdatedElements, elementOffsetInListPage,
+                    numElementsToWriteToCurrentPage);
             });
         remainingNumElementsToWrite -= numElementsToWriteToCurrentPage;
         numUpdatedElements += numElementsToWriteToCurrentPage;
     }
 }
 
+void ListsUpdateIterator::writeElementsToFrame(uint8_t* frame, InMemList& inMemList,
+    uint64_t posInList, uint64_t elementOffsetInListPage, uint64_t numElements) {
+    memcpy(frame + lists->getElemByteOffset(elementOffsetInListPage),
+        inMemList.getListData() + posInList * lists->elementSize, numElements * lists->elementSize);
+    if (inMemList.hasNullBuffer()) {
+        NullMask::copyNullMask(inMemList.getNullMask(), posInList,
+            (uint64_t*)lists->getNullBufferInPage(frame), elementOffsetInListPage, numElements);
+    }
+}
+
+void AdjListsUpdateIterator::prepareChunk() {
+    auto& metadata = lists->getListsMetadata();
+    nbrOffsetBitWidth = metadata.getNbrOffsetBitWidth(curChunkIdx, TransactionType::READ_ONLY);
+    rewriteListsInChunk = false;
+    if (nbrOffsetBitWidth == ListsMetadata::UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH) {
+        return;
+    }
+    auto maxInsertedNbrOffset = lists->listsUpdatesStore->getMaxInsertedNbrOffsetInChunk(
+        lists->storageStructureIDAndFName.storageStructureID.listFileID, curChunkIdx);
+    auto bitWidthOfInsertedNbrOffsets =
+        ListsMetadata::computeNbrOffsetBitWidth(maxInsertedNbrOffset);
+    if (bitWidthOfInsertedNbrOffsets > nbrOffsetBitWidth) {
+        // Lists are read from the original pages with the old bit width, and written to the WAL
+        // versions of the pages with the new one.
+        nbrOffsetBitWidth = bitWidthOfInsertedNbrOffsets;
+        metadata.setNbrOffsetBitWidth(curChunkIdx, nbrOffsetBitWidth);
+        rewriteListsInChunk = true;
+    }
+}
+
+void AdjListsUpdateIterator::writeElementsToFrame(uint8_t* frame, InMemList& inMemList,
+    uint64_t posInList, uint64_t elementOffsetInListPage, uint64_t numElements) {
+    if (nbrOffsetBitWidth == ListsMetadata::UNCOMPRESSED_NBR_OFFSET_BIT_WIDTH) {
+        ListsUpdateIterator::writeElementsToFrame(
+            frame, inMemList, posInList, elementOffsetInListPage, numElements);
+        return;
+    }
+    auto nbrOffsets = (offset_t*)inMemList.getListData() + posInList;
+    auto bitOffset = elementOffsetInListPage * nbrOffsetBitWidth;
+    for (auto i = 0u; i < numElements; i++) {
+        BitPackingUtils::packValue(frame, bitOffset, nbrOffsetBitWidth, nbrOffsets[i]);
+        bitOffset += nbrOffsetBitWidth;
+    }
+}
+
 } // namespace storage
 } // namespace kuzu
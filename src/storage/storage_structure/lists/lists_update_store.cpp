@@ -157,6 +157,26 @@ uint64_t ListsUpdatesStore::getNumInsertedRelsForNodeOffset(
     return listsUpdatesForNodeOffset->insertedRelsTupleIdxInFT.size();
 }
 
+offset_t ListsUpdatesStore::getMaxInsertedNbrOffsetInChunk(
+    ListFileID& listFileID, chunk_idx_t chunkIdx) const {
+    assert(listFileID.listType == ListType::ADJ_LISTS);
+    auto& listsUpdatesPerChunk =
+        listsUpdatesPerDirection[getRelNodeTableAndDirFromListFileID(listFileID).dir];
+    if (!listsUpdatesPerChunk.contains(chunkIdx)) {
+        return 0;
+    }
+    auto nbrNodeIDColOffset = ftOfInsertedRels->getTableSchema()->getColOffset(
+        getColIdxInFT(listFileID));
+    offset_t maxNbrOffset = 0;
+    for (auto& [_, listsUpdatesForNodeOffset] : listsUpdatesPerChunk.at(chunkIdx)) {
+        for (auto tupleIdx : listsUpdatesForNodeOffset->insertedRelsTupleIdxInFT) {
+            auto nbrNodeID = (nodeID_t*)(ftOfInsertedRels->getTuple(tupleIdx) + nbrNodeIDColOffset);
+            maxNbrOffset = std::max(maxNbrOffset, nbrNodeID->offset);
+        }
+    }
+    return maxNbrOffset;
+}
+
 void ListsUpdatesStore::readValues(
     ListFileID& listFileID, ListHandle& listHandle, ValueVector* valueVector) const {
     auto numTuplesToRead = listHandle.getNumValuesToRead();
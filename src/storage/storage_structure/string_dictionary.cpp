@@ -0,0 +1,91 @@
+#include "storage/storage_structure/string_dictionary.h"
+
+#include <fcntl.h>
+
+#include "common/constants.h"
+#include "common/ser_deser.h"
+#include "function/hash/hash_functions.h"
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace storage {
+
+StringDictionary::StringDictionary(std::vector<std::string> values) : values{std::move(values)} {
+    auto numEntries = this->values.size();
+    entries.resize(numEntries);
+    hashes.resize(numEntries);
+    codes.reserve(numEntries);
+    for (auto code = 0u; code < numEntries; code++) {
+        auto& value = this->values[code];
+        auto& entry = entries[code];
+        if (ku_string_t::isShortString(value.length())) {
+            entry.setShortString(value.data(), value.length());
+        } else {
+            // The entry points to the value instead of an overflow buffer.
+            entry.len = value.length();
+            memcpy(entry.prefix, value.data(), ku_string_t::PREFIX_LENGTH);
+            entry.overflowPtr = reinterpret_cast<uint64_t>(value.data());
+        }
+        function::Hash::operation(entry, hashes[code]);
+        codes.emplace(std::string_view{value}, code);
+    }
+}
+
+std::unique_ptr<StringDictionary> StringDictionary::loadFromFile(const std::string& fName) {
+    auto fileInfo = FileUtils::openFile(fName, O_RDONLY);
+    uint64_t offset = 0;
+    std::vector<std::string> values;
+    SerDeser::deserializeVector(values, fileInfo.get(), offset);
+    return std::make_unique<StringDictionary>(std::move(values));
+}
+
+void StringDictionary::saveToFile(const std::string& fName) const {
+    auto fileInfo = FileUtils::openFile(fName, O_WRONLY | O_CREAT | O_TRUNC);
+    uint64_t offset = 0;
+    SerDeser::serializeVector(values, fileInfo.get(), offset);
+}
+
+bool StringDictionaryBuilder::encode(
+    const std::vector<std::string_view>& distinctValues, std::vector<uint32_t>& valueCodes) {
+    std::unique_lock lck{mtx};
+    if (abandoned) {
+        return false;
+    }
+    valueCodes.resize(distinctValues.size());
+    for (auto i = 0u; i < distinctValues.size(); i++) {
+        auto it = codes.find(distinctValues[i]);
+        if (it != codes.end()) {
+            valueCodes[i] = it->second;
+            continue;
+        }
+        numBytes += distinctValues[i].length();
+        if (values.size() >= StorageConstants::MAX_NUM_STRING_DICTIONARY_ENTRIES ||
+            numBytes > StorageConstants::MAX_STRING_DICTIONARY_SIZE) {
+            abandoned = true;
+            values.clear();
+            codes.clear();
+            return false;
+        }
+        auto code = (uint32_t)values.size();
+        values.emplace_back(distinctValues[i]);
+        codes.emplace(std::string_view{values.back()}, code);
+        valueCodes[i] = code;
+    }
+    return true;
+}
+
+std::unique_ptr<StringDictionary> StringDictionaryBuilder::finalize() {
+    std::unique_lock lck{mtx};
+    if (abandoned) {
+        return nullptr;
+    }
+    codes.clear();
+    std::vector<std::string> dictionaryValues{
+        std::make_move_iterator(values.begin()), std::make_move_iterator(values.end())};
+    values.clear();
+    return std::make_unique<StringDictionary>(std::move(dictionaryValues));
+}
+
+} // namespace storage
+} // namespace kuzu
@@ -0,0 +1,221 @@
+#include "storage/storage_structure/zone_map.h"
+
+#include <fcntl.h>
+
+#include <cmath>
+#include <limits>
+
+#include "common/ser_deser.h"
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace storage {
+
+static inline bool isFloatingPoint(PhysicalTypeID physicalType) {
+    return physicalType == PhysicalTypeID::DOUBLE || physicalType == PhysicalTypeID::FLOAT;
+}
+
+bool ZoneMap::isSupported(const LogicalType& dataType) {
+    switch (dataType.getLogicalTypeID()) {
+    case LogicalTypeID::INT64:
+    case LogicalTypeID::INT32:
+    case LogicalTypeID::INT16:
+    case LogicalTypeID::DOUBLE:
+    case LogicalTypeID::FLOAT:
+    case LogicalTypeID::DATE:
+    case LogicalTypeID::TIMESTAMP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+ZoneMapValue ZoneMap::getZoneMapValue(const Value& value) {
+    assert(!value.isNull());
+    ZoneMapValue result;
+    switch (value.getDataType()->getLogicalTypeID()) {
+    case LogicalTypeID::INT64: {
+        result.int64Val = value.getValue<int64_t>();
+    } break;
+    case LogicalTypeID::INT32: {
+        result.int64Val = value.getValue<int32_t>();
+    } break;
+    case LogicalTypeID::INT16: {
+        result.int64Val = value.getValue<int16_t>();
+    } break;
+    case LogicalTypeID::DATE: {
+        result.int64Val = value.getValue<date_t>().days;
+    } break;
+    case LogicalTypeID::TIMESTAMP: {
+        result.int64Val = value.getValue<timestamp_t>().value;
+    } break;
+    case LogicalTypeID::DOUBLE: {
+        result.doubleVal = value.getValue<double>();
+    } break;
+    case LogicalTypeID::FLOAT: {
+        result.doubleVal = value.getValue<float>();
+    } break;
+    default:
+        throw NotImplementedException("ZoneMap::getZoneMapValue");
+    }
+    return result;
+}
+
+std::unique_ptr<ZoneMap> ZoneMap::loadFromFile(
+    const LogicalType& dataType, const std::string& fName) {
+    auto zoneMap = std::make_unique<ZoneMap>(dataType);
+    auto fileInfo = FileUtils::openFile(fName, O_RDONLY);
+    uint64_t offset = 0;
+    uint64_t numEntries;
+    SerDeser::deserializeValue(numEntries, fileInfo.get(), offset);
+    zoneMap->entries.resize(numEntries);
+    FileUtils::readFromFile(fileInfo.get(), (uint8_t*)zoneMap->entries.data(),
+        numEntries * sizeof(ZoneMapEntry), offset);
+    return zoneMap;
+}
+
+void ZoneMap::saveToFile(const std::string& fName) {
+    // The exclusive lock keeps entries from being added while they are written.
+    std::unique_lock lck{mtx};
+    // The entries are written to a temporary file that replaces the original one once synced, so
+    // a crash while saving leaves the previous zone map intact.
+    auto tmpFName = fName + ".tmp";
+    auto fileInfo = FileUtils::openFile(tmpFName, O_WRONLY | O_CREAT | O_TRUNC);
+    uint64_t offset = 0;
+    uint64_t numEntries = entries.size();
+    SerDeser::serializeValue(numEntries, fileInfo.get(), offset);
+    FileUtils::writeToFile(
+        fileInfo.get(), (uint8_t*)entries.data(), numEntries * sizeof(ZoneMapEntry), offset);
+    FileUtils::syncFile(fileInfo.get());
+    fileInfo.reset();
+    FileUtils::renameFileIfExists(tmpFName, fName);
+    dirty = false;
+}
+
+void ZoneMap::addValues(
+    offset_t startOffset, const uint8_t* values, const bool* isNull, uint64_t numValues) {
+    auto numBytesPerValue = PhysicalTypeUtils::getFixedTypeSize(physicalType);
+    std::unique_lock lck{mtx};
+    for (auto i = 0u; i < numValues; i++) {
+        auto& entry = getEntryToUpdate((startOffset + i) / NUM_VALUES_PER_ZONE);
+        if (isNull && isNull[i]) {
+            entry.numNulls++;
+        } else {
+            addValueNoLock(entry, values + i * numBytesPerValue);
+        }
+    }
+}
+
+void ZoneMap::addValue(offset_t nodeOffset, const uint8_t* value) {
+    std::unique_lock lck{mtx};
+    addValueNoLock(getEntryToUpdate(nodeOffset / NUM_VALUES_PER_ZONE), value);
+}
+
+void ZoneMap::addNull(offset_t nodeOffset) {
+    std::unique_lock lck{mtx};
+    getEntryToUpdate(nodeOffset / NUM_VALUES_PER_ZONE).numNulls++;
+}
+
+bool ZoneMap::mayMatch(uint64_t zoneIdx, const ZoneMapPredicate& predicate) {
+    std::shared_lock lck{mtx};
+    if (zoneIdx >= entries.size()) {
+        return true;
+    }
+    auto& entry = entries[zoneIdx];
+    switch (predicate.comparisonType) {
+    case IS_NULL: {
+        return entry.numNulls > 0;
+    }
+    case IS_NOT_NULL: {
+        return entry.hasValues;
+    }
+    default: {
+        // Comparisons with null are never true.
+        if (!entry.hasValues) {
+            return false;
+        }
+        return isFloatingPoint(physicalType) ?
+                   mayMatch(entry.min.doubleVal, entry.max.doubleVal, predicate.comparisonType,
+                       predicate.value.doubleVal) :
+                   mayMatch(entry.min.int64Val, entry.max.int64Val, predicate.comparisonType,
+                       predicate.value.int64Val);
+    }
+    }
+}
+
+ZoneMapEntry& ZoneMap::getEntryToUpdate(uint64_t zoneIdx) {
+    if (zoneIdx >= entries.size()) {
+        entries.resize(
+            zoneIdx + 1, ZoneMapEntry{{0}, {0}, 0 /* numNulls */, false /* hasValues */});
+    }
+    dirty = true;
+    return entries[zoneIdx];
+}
+
+void ZoneMap::addValueNoLock(ZoneMapEntry& entry, const uint8_t* value) const {
+    if (isFloatingPoint(physicalType)) {
+        auto doubleVal = physicalType == PhysicalTypeID::DOUBLE ? *(double*)value : *(float*)value;
+        auto minVal = doubleVal, maxVal = doubleVal;
+        if (std::isnan(doubleVal)) {
+            // NaN is not ordered, so the zone is not pruned by any comparison with a number.
+            minVal = -std::numeric_limits<double>::infinity();
+            maxVal = std::numeric_limits<double>::infinity();
+        }
+        if (!entry.hasValues) {
+            entry.min.doubleVal = minVal;
+            entry.max.doubleVal = maxVal;
+        } else {
+            entry.min.doubleVal = std::min(entry.min.doubleVal, minVal);
+            entry.max.doubleVal = std::max(entry.max.doubleVal, maxVal);
+        }
+    } else {
+        int64_t int64Val;
+        switch (physicalType) {
+        case PhysicalTypeID::INT16: {
+            int64Val = *(int16_t*)value;
+        } break;
+        case PhysicalTypeID::INT32: {
+            int64Val = *(int32_t*)value;
+        } break;
+        default: {
+            int64Val = *(int64_t*)value;
+        }
+        }
+        if (!entry.hasValues) {
+            entry.min.int64Val = entry.max.int64Val = int64Val;
+        } else {
+            entry.min.int64Val = std::min(entry.min.int64Val, int64Val);
+            entry.max.int64Val = std::max(entry.max.int64Val, int64Val);
+        }
+    }
+    entry.hasValues = true;
+}
+
+template<typename T>
+bool ZoneMap::mayMatch(T min, T max, ExpressionType comparisonType, T value) {
+    switch (comparisonType) {
+    case EQUALS: {
+        return min <= value && value <= max;
+    }
+    case GREATER_THAN: {
+        return max > value;
+    }
+    case GREATER_THAN_EQUALS: {
+        return max >= value;
+    }
+    case LESS_THAN: {
+        return min < value;
+    }
+    case LESS_THAN_EQUALS: {
+        return min <= value;
+    }
+    default: {
+        // Other comparisons don't prune zones.
+        return true;
+    }
+    }
+}
+
+} // namespace storage
+} // namespace kuzu
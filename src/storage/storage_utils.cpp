@@ -40,6 +40,18 @@ std::string StorageUtils::getPropertyNullFName(const std::string& filePath) {
     return appendSuffixOrInsertBeforeWALSuffix(filePath, ".null");
 }
 
+std::string StorageUtils::getPropertyDictionaryFName(const std::string& filePath) {
+    return appendSuffixOrInsertBeforeWALSuffix(filePath, ".dict");
+}
+
+std::string StorageUtils::getPropertyDictionaryCodesFName(const std::string& filePath) {
+    return appendSuffixOrInsertBeforeWALSuffix(filePath, ".codes");
+}
+
+std::string StorageUtils::getPropertyZoneMapFName(const std::string& filePath) {
+    return appendSuffixOrInsertBeforeWALSuffix(filePath, ".zonemap");
+}
+
 std::string StorageUtils::getAdjListsFName(const std::string& directory,
     const common::table_id_t& relTableID, const common::RelDataDirection& relDirection,
     common::DBFileType dbFileType) {
@@ -79,6 +91,11 @@ std::string StorageUtils::getAdjColumnFName(const std::string& directory,
 }
 
 std::unique_ptr<FileInfo> StorageUtils::getFileInfoForReadWrite(
+    const std::string& directory, StorageStructureID storageStructureID) {
+    return FileUtils::openFile(getStorageStructureFName(directory, storageStructureID), O_RDWR);
+}
+
+std::string StorageUtils::getStorageStructureFName(
     const std::string& directory, StorageStructureID storageStructureID) {
     std::string fName;
     switch (storageStructureID.storageStructureType) {
@@ -97,10 +114,10 @@ std::unique_ptr<FileInfo> StorageUtils::getFileInfoForReadWrite(
     } break;
     default: {
         throw RuntimeException("Unsupported StorageStructureID in "
-                               "StorageUtils::getFileInfoFromStorageStructureID.");
+                               "StorageUtils::getStorageStructureFName.");
     }
     }
-    return FileUtils::openFile(fName, O_RDWR);
+    return fName;
 }
 
 std::string StorageUtils::getColumnFName(
@@ -116,6 +133,8 @@ std::string StorageUtils::getColumnFName(
             fName = getOverflowFileName(fName);
         } else if (storageStructureID.isNullBits) {
             fName = getPropertyNullFName(fName);
+        } else if (storageStructureID.isDictionaryCodes) {
+            fName = getPropertyDictionaryCodesFName(fName);
         }
     } break;
     case ColumnType::ADJ_COLUMN: {
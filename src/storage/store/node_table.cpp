@@ -45,6 +45,15 @@ void NodeTable::scan(transaction::Transaction* transaction, ValueVector* inputID
     }
 }
 
+void NodeTable::prefetch(offset_t startOffset, uint64_t numNodes,
+    const std::vector<uint32_t>& columnIds, PrefetchStats& stats) {
+    for (auto columnId : columnIds) {
+        if (columnId != UINT32_MAX) {
+            propertyColumns.at(columnId)->prefetch(startOffset, numNodes, stats);
+        }
+    }
+}
+
 offset_t NodeTable::addNodeAndResetProperties() {
     auto nodeOffset = nodesStatisticsAndDeletedIDs->addNode(tableID);
     for (auto& [_, column] : propertyColumns) {
@@ -89,6 +98,9 @@ void NodeTable::prepareCommit() {
     if (pkIndex) {
         pkIndex->prepareCommit();
     }
+    for (auto& [_, column] : propertyColumns) {
+        column->prepareCommit();
+    }
 }
 
 void NodeTable::prepareRollback() {
@@ -0,0 +1,115 @@
+#include "storage/wal/commit_syncer.h"
+
+#include "common/exception.h"
+#include "common/file_utils.h"
+#include "common/utils.h"
+#include "spdlog/spdlog.h"
+
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace storage {
+
+CommitSyncer::CommitSyncer(DurabilityMode durabilityMode, uint64_t syncIntervalInMs)
+    : logger{LoggerUtils::getLogger(LoggerConstants::LoggerEnum::WAL)},
+      durabilityMode{durabilityMode}, syncIntervalInMs{syncIntervalInMs}, numStartedRounds{0},
+      numCompletedRounds{0}, lastWaitedRound{0}, lastFailedRound{0}, hasUnreportedError{false},
+      stopped{false} {
+    syncThread = std::thread(&CommitSyncer::runSyncLoop, this);
+}
+
+CommitSyncer::~CommitSyncer() {
+    {
+        std::unique_lock lck{mtx};
+        stopped = true;
+    }
+    filesRequestedCV.notify_one();
+    syncThread.join();
+}
+
+void CommitSyncer::sync(const std::vector<std::string>& filePaths) {
+    syncInternal(filePaths, durabilityMode == DurabilityMode::SYNC /* waitForRound */);
+}
+
+void CommitSyncer::syncAndWait(const std::vector<std::string>& filePaths) {
+    syncInternal(filePaths, true /* waitForRound */);
+}
+
+void CommitSyncer::syncInternal(const std::vector<std::string>& filePaths, bool waitForRound) {
+    std::unique_lock lck{mtx};
+    if (hasUnreportedError) {
+        hasUnreportedError = false;
+        throw StorageException("Syncing committed files in the background failed: " + lastError);
+    }
+    if (filePaths.empty()) {
+        return;
+    }
+    filesToSync.insert(filePaths.begin(), filePaths.end());
+    // The files are synced by the next round even if a round is in progress, because the round in
+    // progress took its files before they were added.
+    auto round = numStartedRounds + 1;
+    if (!waitForRound) {
+        filesRequestedCV.notify_one();
+        return;
+    }
+    lastWaitedRound = round;
+    filesRequestedCV.notify_one();
+    roundCompletedCV.wait(lck, [&] { return numCompletedRounds >= round; });
+    if (lastFailedRound >= round) {
+        // The failure is thrown here instead of by the next call.
+        hasUnreportedError = false;
+        throw StorageException("Syncing committed files failed: " + lastError);
+    }
+}
+
+void CommitSyncer::runSyncLoop() {
+    std::unique_lock lck{mtx};
+    while (true) {
+        filesRequestedCV.wait(lck, [&] { return stopped || !filesToSync.empty(); });
+        if (durabilityMode == DurabilityMode::RELAXED && !stopped) {
+            // Groups the requests of the sync interval into one round, unless a request waits for
+            // the round.
+            filesRequestedCV.wait_for(lck, std::chrono::milliseconds(syncIntervalInMs),
+                [&] { return stopped || lastWaitedRound > numStartedRounds; });
+        }
+        if (filesToSync.empty()) {
+            // Stopped and all requested files are synced.
+            return;
+        }
+        auto filePaths = std::move(filesToSync);
+        filesToSync.clear();
+        auto round = ++numStartedRounds;
+        lck.unlock();
+        auto error = syncFiles(filePaths);
+        lck.lock();
+        numCompletedRounds = round;
+        if (!error.empty()) {
+            lastFailedRound = round;
+            lastError = std::move(error);
+            hasUnreportedError = durabilityMode == DurabilityMode::RELAXED;
+        }
+        roundCompletedCV.notify_all();
+    }
+}
+
+std::string CommitSyncer::syncFiles(const std::unordered_set<std::string>& filePaths) {
+    std::string error;
+    for (auto& filePath : filePaths) {
+        if (!FileUtils::fileOrPathExists(filePath)) {
+            continue;
+        }
+        try {
+            auto fileInfo = FileUtils::openFile(filePath, O_RDWR);
+            FileUtils::syncFile(fileInfo.get());
+        } catch (Exception& e) {
+            logger->error("Cannot sync committed file {}: {}", filePath, e.what());
+            if (error.empty()) {
+                error = e.what();
+            }
+        }
+    }
+    return error;
+}
+
+} // namespace storage
+} // namespace kuzu
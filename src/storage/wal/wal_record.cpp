@@ -28,6 +28,7 @@ StorageStructureID StorageStructureID::newNodePropertyColumnID(
     retVal.storageStructureType = StorageStructureType::COLUMN;
     retVal.isOverflow = false;
     retVal.isNullBits = false;
+    retVal.isDictionaryCodes = false;
     retVal.columnFileID = ColumnFileID(NodePropertyColumnID(tableID, propertyID));
     return retVal;
 }
@@ -36,6 +37,7 @@ StorageStructureID StorageStructureID::newNodeIndexID(table_id_t tableID) {
     StorageStructureID retVal;
     retVal.isOverflow = false;
     retVal.isNullBits = false;
+    retVal.isDictionaryCodes = false;
     retVal.storageStructureType = StorageStructureType::NODE_INDEX;
     retVal.nodeIndexID = NodeIndexID(tableID);
     return retVal;
@@ -46,6 +48,7 @@ StorageStructureID StorageStructureID::newAdjListsID(
     StorageStructureID retVal;
     retVal.isOverflow = false;
     retVal.isNullBits = false;
+    retVal.isDictionaryCodes = false;
     retVal.storageStructureType = StorageStructureType::LISTS;
     retVal.listFileID = ListFileID(listFileType, AdjListsID(RelNodeTableAndDir(relTableID, dir)));
     return retVal;
@@ -56,6 +59,7 @@ StorageStructureID StorageStructureID::newRelPropertyListsID(table_id_t relTable
     StorageStructureID retVal;
     retVal.isOverflow = false;
     retVal.isNullBits = false;
+    retVal.isDictionaryCodes = false;
     retVal.storageStructureType = StorageStructureType::LISTS;
     retVal.listFileID = ListFileID(
         listFileType, RelPropertyListsID(RelNodeTableAndDir(relTableID, dir), propertyID));
@@ -67,6 +71,7 @@ StorageStructureID StorageStructureID::newRelPropertyColumnID(
     StorageStructureID retVal;
     retVal.isOverflow = false;
     retVal.isNullBits = false;
+    retVal.isDictionaryCodes = false;
     retVal.storageStructureType = StorageStructureType::COLUMN;
     retVal.columnFileID =
         ColumnFileID(RelPropertyColumnID(RelNodeTableAndDir(relTableID, dir), propertyID));
@@ -77,6 +82,7 @@ StorageStructureID StorageStructureID::newAdjColumnID(table_id_t relTableID, Rel
     StorageStructureID retVal;
     retVal.isOverflow = false;
     retVal.isNullBits = false;
+    retVal.isDictionaryCodes = false;
     retVal.storageStructureType = StorageStructureType::COLUMN;
     retVal.columnFileID = ColumnFileID(AdjColumnID(RelNodeTableAndDir(relTableID, dir)));
     return retVal;
@@ -1,5 +1,8 @@
 #include "storage/wal_replayer.h"
 
+#include "common/task_system/parallel_for_task.h"
+#include "common/timer.h"
+#include "spdlog/spdlog.h"
 #include "storage/storage_manager.h"
 #include "storage/storage_utils.h"
 #include "storage/wal_replayer_utils.h"
@@ -14,16 +17,18 @@ namespace storage {
 // ROLLBACK:            isCheckpoint = false, isRecovering = false
 // RECOVERY_CHECKPOINT: isCheckpoint = true,  isRecovering = true
 WALReplayer::WALReplayer(WAL* wal, StorageManager* storageManager, MemoryManager* memoryManager,
-    BufferManager* bufferManager, Catalog* catalog, WALReplayMode replayMode)
-    : isRecovering{replayMode == WALReplayMode::RECOVERY_CHECKPOINT},
+    BufferManager* bufferManager, Catalog* catalog, WALReplayMode replayMode,
+    TaskScheduler& taskScheduler)
+    : logger{LoggerUtils::getLogger(LoggerConstants::LoggerEnum::WAL)},
+      isRecovering{replayMode == WALReplayMode::RECOVERY_CHECKPOINT},
       isCheckpoint{replayMode != WALReplayMode::ROLLBACK}, storageManager{storageManager},
-      bufferManager{bufferManager}, memoryManager{memoryManager}, wal{wal}, catalog{catalog} {
+      bufferManager{bufferManager}, memoryManager{memoryManager}, wal{wal}, catalog{catalog},
+      taskScheduler{taskScheduler}, numReplayedPageRecords{0}, numReplayedPages{0} {
     init();
 }
 
 void WALReplayer::init() {
     walFileHandle = wal->fileHandle;
-    pageBuffer = std::make_unique<uint8_t[]>(BufferPoolConstants::PAGE_4KB_SIZE);
 }
 
 void WALReplayer::replay() {
@@ -34,12 +39,29 @@ void WALReplayer::replay() {
             "Cannot checkpointInMemory WAL because last logged record is not a commit record.");
     }
     if (!wal->isEmptyWAL()) {
+        Timer replayTimer;
+        replayTimer.start();
         auto walIterator = wal->getIterator();
         WALRecord walRecord;
         while (walIterator->hasNextRecord()) {
             walIterator->getNextRecord(walRecord);
+            if (walRecord.recordType != WALRecordType::PAGE_UPDATE_OR_INSERT_RECORD) {
+                // Records of other types can create, replace or remove the files of the pages.
+                replayBufferedPageUpdateOrInsertRecords();
+            }
             replayWALRecord(walRecord);
         }
+        replayBufferedPageUpdateOrInsertRecords();
+        replayTimer.stop();
+        if (numReplayedPages > 0) {
+            auto durationInMs = replayTimer.getDuration() / 1000;
+            auto replayedMB = (double)(numReplayedPages * BufferPoolConstants::PAGE_4KB_SIZE) /
+                              (1024 * 1024);
+            logger->info("Replayed {} page records to {} pages of {} files in {:.1f}ms ({:.1f} "
+                         "MB/s).",
+                numReplayedPageRecords, numReplayedPages, checkpointedFilePaths.size(),
+                durationInMs, durationInMs == 0 ? 0 : replayedMB * 1000 / durationInMs);
+        }
     }
 
     // We next perform an in-memory checkpointing or rolling back of node/relTables.
@@ -55,7 +77,11 @@ void WALReplayer::replay() {
 void WALReplayer::replayWALRecord(WALRecord& walRecord) {
     switch (walRecord.recordType) {
     case WALRecordType::PAGE_UPDATE_OR_INSERT_RECORD: {
-        replayPageUpdateOrInsertRecord(walRecord);
+        if (isCheckpoint) {
+            bufferPageUpdateOrInsertRecord(walRecord);
+        } else {
+            rollbackPageUpdateOrInsertRecord(walRecord);
+        }
     } break;
     case WALRecordType::TABLE_STATISTICS_RECORD: {
         replayTableStatisticsRecord(walRecord);
@@ -96,29 +122,102 @@ void WALReplayer::replayWALRecord(WALRecord& walRecord) {
     }
 }
 
-void WALReplayer::replayPageUpdateOrInsertRecord(const kuzu::storage::WALRecord& walRecord) {
-    // 1. As the first step we copy over the page on disk, regardless of if we are recovering
-    // (and checkpointing) or checkpointing while during regular execution.
-    auto storageStructureID = walRecord.pageInsertOrUpdateRecord.storageStructureID;
-    std::unique_ptr<FileInfo> fileInfoOfStorageStructure =
-        StorageUtils::getFileInfoForReadWrite(wal->getDirectory(), storageStructureID);
-    if (isCheckpoint) {
-        if (!wal->isLastLoggedRecordCommit()) {
-            // Nothing to undo.
-            return;
-        }
-        walFileHandle->readPage(pageBuffer.get(), walRecord.pageInsertOrUpdateRecord.pageIdxInWAL);
-        FileUtils::writeToFile(fileInfoOfStorageStructure.get(), pageBuffer.get(),
-            BufferPoolConstants::PAGE_4KB_SIZE,
-            walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile *
-                BufferPoolConstants::PAGE_4KB_SIZE);
+void WALReplayer::bufferPageUpdateOrInsertRecord(const WALRecord& walRecord) {
+    if (!wal->isLastLoggedRecordCommit()) {
+        // Nothing to redo.
+        return;
+    }
+    auto& pageRecord = walRecord.pageInsertOrUpdateRecord;
+    auto filePath =
+        StorageUtils::getStorageStructureFName(wal->getDirectory(), pageRecord.storageStructureID);
+    auto [it, isNewFile] =
+        pageRecordsOfFileIdxes.emplace(filePath, bufferedPageRecordsOfFiles.size());
+    if (isNewFile) {
+        bufferedPageRecordsOfFiles.push_back(
+            PageRecordsOfFile{pageRecord.storageStructureID, std::move(filePath)});
+    }
+    // A later record of the same page replaces the earlier one, as if they were replayed in order.
+    bufferedPageRecordsOfFiles[it->second]
+        .walPageIdxOfOriginalPageIdx[pageRecord.pageIdxInOriginalFile] = pageRecord.pageIdxInWAL;
+    numReplayedPageRecords++;
+}
+
+void WALReplayer::replayBufferedPageUpdateOrInsertRecords() {
+    if (bufferedPageRecordsOfFiles.empty()) {
+        return;
     }
     if (!isRecovering) {
-        // 2: If we are not recovering, we do any in-memory checkpointing or rolling back work
-        // to make sure that the system's in-memory structures are consistent with what is on
-        // disk. For example, we update the BM's image of the pages or InMemDiskArrays used by
-        // lists or the WALVersion pageIdxs of pages for VersionedFileHandles.
-        checkpointOrRollbackVersionedFileHandleAndBufferManager(walRecord, storageStructureID);
+        // If we are not recovering, we also do the in-memory checkpointing work to make sure that
+        // the system's in-memory structures are consistent with what is on disk, i.e., we update
+        // the BM's image of the pages and clear the WALVersion pageIdxs of VersionedFileHandles.
+        // The file handles are looked up before the parallel replay. Each file has its own file
+        // handle and BM frames, which are then only accessed by the thread of the file.
+        for (auto& pageRecordsOfFile : bufferedPageRecordsOfFiles) {
+            pageRecordsOfFile.fileHandle = getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(
+                pageRecordsOfFile.storageStructureID);
+        }
+    }
+    auto numThreads = std::min<uint64_t>(
+        bufferedPageRecordsOfFiles.size(), taskScheduler.getNumWorkerThreads());
+    auto task = std::make_shared<ParallelForTask>(
+        bufferedPageRecordsOfFiles.size(), numThreads, [&](uint64_t fileIdx) {
+            replayPagesOfFile(bufferedPageRecordsOfFiles[fileIdx]);
+        });
+    taskScheduler.scheduleTaskAndWaitOrError(task, nullptr /* executionContext */);
+    for (auto& pageRecordsOfFile : bufferedPageRecordsOfFiles) {
+        numReplayedPages += pageRecordsOfFile.walPageIdxOfOriginalPageIdx.size();
+        checkpointedFilePaths.insert(std::move(pageRecordsOfFile.filePath));
+    }
+    pageRecordsOfFileIdxes.clear();
+    bufferedPageRecordsOfFiles.clear();
+}
+
+void WALReplayer::replayPagesOfFile(const PageRecordsOfFile& pageRecordsOfFile) {
+    auto fileInfo = FileUtils::openFile(pageRecordsOfFile.filePath, O_RDWR);
+    auto pagesBuffer =
+        std::make_unique<uint8_t[]>(MAX_NUM_PAGES_PER_WRITE * BufferPoolConstants::PAGE_4KB_SIZE);
+    std::vector<FileBuffer> pages;
+    page_idx_t startPageIdx = 0;
+    auto writePages = [&]() {
+        FileUtils::writeToFile(
+            fileInfo.get(), pages, startPageIdx * BufferPoolConstants::PAGE_4KB_SIZE);
+        if (pageRecordsOfFile.fileHandle) {
+            for (auto i = 0u; i < pages.size(); i++) {
+                pageRecordsOfFile.fileHandle->clearWALPageIdxIfNecessary(startPageIdx + i);
+                // Update the page in buffer manager if it is in a frame.
+                bufferManager->updateFrameIfPageIsInFrameWithoutLock(
+                    *pageRecordsOfFile.fileHandle, pages[i].buffer, startPageIdx + i);
+            }
+        }
+        pages.clear();
+    };
+    for (auto [pageIdxInOriginalFile, pageIdxInWAL] :
+        pageRecordsOfFile.walPageIdxOfOriginalPageIdx) {
+        if (!pages.empty() && (pageIdxInOriginalFile != startPageIdx + pages.size() ||
+                                  pages.size() == MAX_NUM_PAGES_PER_WRITE)) {
+            writePages();
+        }
+        if (pages.empty()) {
+            startPageIdx = pageIdxInOriginalFile;
+        }
+        auto page = pagesBuffer.get() + pages.size() * BufferPoolConstants::PAGE_4KB_SIZE;
+        walFileHandle->readPage(page, pageIdxInWAL);
+        pages.push_back(FileBuffer{page, BufferPoolConstants::PAGE_4KB_SIZE});
+    }
+    if (!pages.empty()) {
+        writePages();
+    }
+}
+
+void WALReplayer::rollbackPageUpdateOrInsertRecord(const WALRecord& walRecord) {
+    // Rolling back doesn't touch the files on disk. We only roll back the in-memory structures,
+    // i.e., the WALVersion pageIdxs of VersionedFileHandles and the pages inserted to them.
+    auto fileHandle = getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(
+        walRecord.pageInsertOrUpdateRecord.storageStructureID);
+    if (fileHandle) {
+        fileHandle->clearWALPageIdxIfNecessary(
+            walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile);
+        truncateFileIfInsertion(fileHandle, walRecord.pageInsertOrUpdateRecord);
     }
 }
 
@@ -127,6 +226,8 @@ void WALReplayer::replayTableStatisticsRecord(const kuzu::storage::WALRecord& wa
         if (walRecord.tableStatisticsRecord.isNodeTable) {
             StorageUtils::overwriteNodesStatisticsAndDeletedIDsFileWithVersionFromWAL(
                 wal->getDirectory());
+            checkpointedFilePaths.insert(StorageUtils::getNodesStatisticsAndDeletedIDsFilePath(
+                wal->getDirectory(), DBFileType::ORIGINAL));
             if (!isRecovering) {
                 storageManager->getNodesStore()
                     .getNodesStatisticsAndDeletedIDs()
@@ -134,6 +235,8 @@ void WALReplayer::replayTableStatisticsRecord(const kuzu::storage::WALRecord& wa
             }
         } else {
             StorageUtils::overwriteRelsStatisticsFileWithVersionFromWAL(wal->getDirectory());
+            checkpointedFilePaths.insert(
+                StorageUtils::getRelsStatisticsFilePath(wal->getDirectory(), DBFileType::ORIGINAL));
             if (!isRecovering) {
                 storageManager->getRelsStore().getRelsStatistics().checkpointInMemoryIfNecessary();
             }
@@ -148,6 +251,8 @@ void WALReplayer::replayTableStatisticsRecord(const kuzu::storage::WALRecord& wa
 void WALReplayer::replayCatalogRecord() {
     if (isCheckpoint) {
         StorageUtils::overwriteCatalogFileWithVersionFromWAL(wal->getDirectory());
+        checkpointedFilePaths.insert(
+            StorageUtils::getCatalogFilePath(wal->getDirectory(), DBFileType::ORIGINAL));
         if (!isRecovering) {
             storageManager->getCatalog()->checkpointInMemory();
         }
@@ -472,25 +577,6 @@ void WALReplayer::truncateFileIfInsertion(
     }
 }
 
-void WALReplayer::checkpointOrRollbackVersionedFileHandleAndBufferManager(
-    const WALRecord& walRecord, const StorageStructureID& storageStructureID) {
-    BMFileHandle* fileHandle =
-        getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(storageStructureID);
-    if (fileHandle) {
-        fileHandle->clearWALPageIdxIfNecessary(
-            walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile);
-        if (isCheckpoint) {
-            // Update the page in buffer manager if it is in a frame. Note that we assume
-            // that the pageBuffer currently contains the contents of the WALVersion, so the
-            // caller needs to make sure that this assumption holds.
-            bufferManager->updateFrameIfPageIsInFrameWithoutLock(*fileHandle, pageBuffer.get(),
-                walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile);
-        } else {
-            truncateFileIfInsertion(fileHandle, walRecord.pageInsertOrUpdateRecord);
-        }
-    }
-}
-
 BMFileHandle* WALReplayer::getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(
     const StorageStructureID& storageStructureID) {
     switch (storageStructureID.storageStructureType) {
@@ -505,6 +591,9 @@ BMFileHandle* WALReplayer::getVersionedFileHandleIfWALVersionAndBMShouldBeCleare
                     ->getDiskOverflowFileHandle();
             } else if (storageStructureID.isNullBits) {
                 return column->getNullColumn()->getFileHandle();
+            } else if (storageStructureID.isDictionaryCodes) {
+                return reinterpret_cast<StringPropertyColumn*>(column)
+                    ->getDictionaryCodesFileHandle();
             } else {
                 return column->getFileHandle();
             }
@@ -164,6 +164,9 @@ void WALReplayerUtils::replaceOriginalListFilesWithWALVersionIfExists(
 void WALReplayerUtils::removeColumnFilesIfExists(const std::string& fileName) {
     FileUtils::removeFileIfExists(fileName);
     FileUtils::removeFileIfExists(StorageUtils::getOverflowFileName(fileName));
+    FileUtils::removeFileIfExists(StorageUtils::getPropertyDictionaryFName(fileName));
+    FileUtils::removeFileIfExists(StorageUtils::getPropertyDictionaryCodesFName(fileName));
+    FileUtils::removeFileIfExists(StorageUtils::getPropertyZoneMapFName(fileName));
 }
 
 void WALReplayerUtils::removeListFilesIfExists(const std::string& fileName) {
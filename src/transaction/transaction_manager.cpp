@@ -97,8 +97,11 @@ void TransactionManager::stopNewTransactionsAndWaitUntilAllReadTransactionsLeave
                     "and checkpointing a write transaction. If you have an open read transaction "
                     "close and try again.");
             }
+            // Read transactions need the lock to leave, so it is not held while sleeping.
+            lck.unlock();
             std::this_thread::sleep_for(
                 std::chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS));
+            lck.lock();
         } else {
             break;
         }
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include "common/task_system/task_scheduler.h"
+#include "gtest/gtest.h"
+
+using namespace kuzu::common;
+
+class CountingTask : public Task {
+public:
+    CountingTask(uint64_t maxNumThreads, std::atomic<uint64_t>& counter)
+        : Task{maxNumThreads}, counter{counter} {}
+
+    void run() override { counter++; }
+    void finalizeIfNecessary() override { finalized = true; }
+
+    bool finalized = false;
+
+private:
+    std::atomic<uint64_t>& counter;
+};
+
+class ThrowingTask : public Task {
+public:
+    ThrowingTask() : Task{1} {}
+
+    void run() override { throw std::runtime_error("task error"); }
+};
+
+// Waits until the given number of RendezvousTasks have started running, or gives up after a second.
+class RendezvousTask : public Task {
+public:
+    RendezvousTask(uint64_t numTasksToWaitFor, std::atomic<uint64_t>& numStartedTasks)
+        : Task{1}, numTasksToWaitFor{numTasksToWaitFor}, numStartedTasks{numStartedTasks} {}
+
+    void run() override {
+        numStartedTasks++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (numStartedTasks.load() < numTasksToWaitFor) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        metRendezvous = true;
+    }
+
+    bool metRendezvous = false;
+
+private:
+    uint64_t numTasksToWaitFor;
+    std::atomic<uint64_t>& numStartedTasks;
+};
+
+TEST(TaskSchedulerTest, RunTaskWithDependencies) {
+    TaskScheduler taskScheduler{4};
+    std::atomic<uint64_t> counter{0};
+    auto task = std::make_shared<CountingTask>(4, counter);
+    auto child = std::make_unique<CountingTask>(1, counter);
+    auto childPtr = child.get();
+    task->addChildTask(std::move(child));
+    taskScheduler.scheduleTaskAndWaitOrError(task, nullptr);
+    ASSERT_TRUE(task->isCompletedSuccessfully());
+    ASSERT_TRUE(task->finalized);
+    ASSERT_TRUE(childPtr->finalized);
+    ASSERT_GE(counter.load(), 2);
+}
+
+TEST(TaskSchedulerTest, RunManyTasks) {
+    TaskScheduler taskScheduler{4};
+    std::atomic<uint64_t> counter{0};
+    for (auto i = 0u; i < 1000; ++i) {
+        auto task = std::make_shared<CountingTask>(1, counter);
+        taskScheduler.scheduleTaskAndWaitOrError(task, nullptr);
+    }
+    ASSERT_EQ(counter.load(), 1000);
+}
+
+TEST(TaskSchedulerTest, RethrowTaskException) {
+    TaskScheduler taskScheduler{2};
+    auto task = std::make_shared<ThrowingTask>();
+    ASSERT_THROW(taskScheduler.scheduleTaskAndWaitOrError(task, nullptr), std::runtime_error);
+    // The scheduler must still be usable after a task errors.
+    std::atomic<uint64_t> counter{0};
+    taskScheduler.scheduleTaskAndWaitOrError(std::make_shared<CountingTask>(2, counter), nullptr);
+    ASSERT_GE(counter.load(), 1);
+}
+
+TEST(TaskSchedulerTest, PinThreadsToNUMANodes) {
+    TaskScheduler taskScheduler{2, true /* pinThreadsToNUMANodes */};
+    std::atomic<uint64_t> counter{0};
+    taskScheduler.scheduleTaskAndWaitOrError(std::make_shared<CountingTask>(2, counter), nullptr);
+    ASSERT_GE(counter.load(), 1);
+}
+
+TEST(TaskSchedulerTest, RunIndependentChildTasksConcurrently) {
+    TaskScheduler taskScheduler{2};
+    std::atomic<uint64_t> counter{0};
+    std::atomic<uint64_t> numStartedTasks{0};
+    auto task = std::make_shared<CountingTask>(2, counter);
+    std::vector<RendezvousTask*> children;
+    for (auto i = 0u; i < 2; ++i) {
+        auto child = std::make_unique<RendezvousTask>(2, numStartedTasks);
+        children.push_back(child.get());
+        task->addChildTask(std::move(child));
+    }
+    task->setIndependentChildTasks();
+    taskScheduler.scheduleTaskAndWaitOrError(task, nullptr);
+    ASSERT_TRUE(task->isCompletedSuccessfully());
+    for (auto child : children) {
+        ASSERT_TRUE(child->metRendezvous);
+    }
+}
+
+TEST(TaskSchedulerTest, RethrowIndependentChildTaskException) {
+    TaskScheduler taskScheduler{2};
+    std::atomic<uint64_t> counter{0};
+    auto task = std::make_shared<CountingTask>(2, counter);
+    task->addChildTask(std::make_unique<CountingTask>(1, counter));
+    task->addChildTask(std::make_unique<ThrowingTask>());
+    task->setIndependentChildTasks();
+    ASSERT_THROW(taskScheduler.scheduleTaskAndWaitOrError(task, nullptr), std::runtime_error);
+    ASSERT_FALSE(task->isCompleted());
+}
+
+// Records the order in which tasks finish, and the maximum number of threads that ran the task at
+// the same time.
+class OrderedTask : public Task {
+public:
+    OrderedTask(uint64_t maxNumThreads, std::vector<OrderedTask*>& finishedTasks, std::mutex& mtx)
+        : Task{maxNumThreads}, finishedTasks{finishedTasks}, mtx{mtx} {}
+
+    void run() override {
+        auto numThreads = ++numRunningThreads;
+        auto maxNumThreads = maxNumRunningThreads.load();
+        while (numThreads > maxNumThreads &&
+               !maxNumRunningThreads.compare_exchange_weak(maxNumThreads, numThreads)) {}
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        numRunningThreads--;
+    }
+    void finalizeIfNecessary() override {
+        lock_t lck{mtx};
+        finishedTasks.push_back(this);
+    }
+
+    std::atomic<uint64_t> numRunningThreads{0};
+    std::atomic<uint64_t> maxNumRunningThreads{0};
+
+private:
+    std::vector<OrderedTask*>& finishedTasks;
+    std::mutex& mtx;
+};
+
+TEST(TaskSchedulerTest, RunNestedTaskTrees) {
+    TaskScheduler taskScheduler{4};
+    std::vector<OrderedTask*> finishedTasks;
+    std::mutex mtx;
+    // root has independent children a and b. a has dependent children a1 and a2.
+    auto root = std::make_shared<OrderedTask>(4, finishedTasks, mtx);
+    auto a = std::make_unique<OrderedTask>(4, finishedTasks, mtx);
+    auto a1 = std::make_unique<OrderedTask>(4, finishedTasks, mtx);
+    auto a2 = std::make_unique<OrderedTask>(4, finishedTasks, mtx);
+    // b keeps its budget of one thread while it runs next to a's tree.
+    auto b = std::make_unique<OrderedTask>(1, finishedTasks, mtx);
+    auto aPtr = a.get(), a1Ptr = a1.get(), a2Ptr = a2.get(), bPtr = b.get();
+    a->addChildTask(std::move(a1));
+    a->addChildTask(std::move(a2));
+    root->addChildTask(std::move(a));
+    root->addChildTask(std::move(b));
+    root->setIndependentChildTasks();
+    taskScheduler.scheduleTaskAndWaitOrError(root, nullptr);
+    ASSERT_TRUE(root->isCompletedSuccessfully());
+    ASSERT_EQ(finishedTasks.size(), 5);
+    auto getPosition = [&](OrderedTask* task) {
+        return std::find(finishedTasks.begin(), finishedTasks.end(), task) - finishedTasks.begin();
+    };
+    ASSERT_LT(getPosition(a1Ptr), getPosition(a2Ptr));
+    ASSERT_LT(getPosition(a2Ptr), getPosition(aPtr));
+    ASSERT_EQ(getPosition(root.get()), 4);
+    ASSERT_EQ(bPtr->maxNumRunningThreads.load(), 1);
+}
+
+TEST(TaskSchedulerTest, DoNotScheduleDependentTasksAfterException) {
+    TaskScheduler taskScheduler{2};
+    std::atomic<uint64_t> counter{0};
+    auto task = std::make_shared<CountingTask>(2, counter);
+    task->addChildTask(std::make_unique<ThrowingTask>());
+    auto child = std::make_unique<CountingTask>(1, counter);
+    auto childPtr = child.get();
+    task->addChildTask(std::move(child));
+    ASSERT_THROW(taskScheduler.scheduleTaskAndWaitOrError(task, nullptr), std::runtime_error);
+    ASSERT_FALSE(childPtr->isCompleted());
+    ASSERT_EQ(counter.load(), 0);
+}
@@ -0,0 +1,125 @@
+#include <fstream>
+
+#include "common/exception.h"
+#include "graph_test/graph_test.h"
+#include "storage/copier/csv_reader.h"
+
+using namespace kuzu::catalog;
+using namespace kuzu::common;
+using namespace kuzu::storage;
+using namespace kuzu::testing;
+
+class CSVReaderTest : public Test {
+protected:
+    void SetUp() override {
+        filePath = TestHelper::appendKuzuRootPath(std::string(TestHelper::TMP_TEST_DIR) +
+                                                  "csv_reader_test" +
+                                                  TestHelper::getMillisecondsSuffix() + ".csv");
+        tableSchema = std::make_unique<NodeTableSchema>("person", 0 /* tableID */,
+            0 /* primaryPropertyId */,
+            std::vector<Property>{Property{"id", LogicalType{LogicalTypeID::INT64}},
+                Property{"name", LogicalType{LogicalTypeID::STRING}},
+                Property{"score", LogicalType{LogicalTypeID::DOUBLE}}});
+        taskScheduler = std::make_unique<TaskScheduler>(numThreads);
+    }
+
+    void TearDown() override { FileUtils::removeFileIfExists(filePath); }
+
+    void writeFile(const std::string& content) const {
+        std::ofstream file{filePath, std::ios::binary};
+        file << content;
+    }
+
+    // Reads all blocks of the file, and returns the rows as "id|name|score".
+    std::vector<std::string> readRows(const CSVReaderConfig& config, uint64_t blockSize) const {
+        CSVReader reader{filePath, config, tableSchema.get()};
+        reader.splitIntoBlocks(*taskScheduler, numThreads, blockSize);
+        std::vector<std::string> rows;
+        for (auto blockIdx = 0u; blockIdx < reader.getNumBlocks(); blockIdx++) {
+            auto recordBatch = reader.readBlock(blockIdx);
+            EXPECT_EQ(recordBatch->num_rows(), reader.getNumRowsInBlock(blockIdx));
+            auto ids = std::static_pointer_cast<arrow::Int64Array>(recordBatch->column(0));
+            auto names = std::static_pointer_cast<arrow::StringArray>(recordBatch->column(1));
+            auto scores = std::static_pointer_cast<arrow::DoubleArray>(recordBatch->column(2));
+            for (auto i = 0u; i < recordBatch->num_rows(); i++) {
+                rows.push_back((ids->IsNull(i) ? "NULL" : std::to_string(ids->Value(i))) + "|" +
+                               (names->IsNull(i) ? "NULL" : names->GetString(i)) + "|" +
+                               (scores->IsNull(i) ? "NULL" : std::to_string(scores->Value(i))));
+            }
+        }
+        EXPECT_EQ(rows.size(), reader.getNumRows());
+        return rows;
+    }
+
+public:
+    std::string filePath;
+    std::unique_ptr<TableSchema> tableSchema;
+    const uint64_t numThreads = 4;
+    std::unique_ptr<TaskScheduler> taskScheduler;
+};
+
+TEST_F(CSVReaderTest, QuotedNewlinesAcrossBlocks) {
+    writeFile("1,\"Alice\nSmith\",1.5\r\n"
+              "2,\"Bob \"\"the\"\" builder\",2\n"
+              "3,\"a,b\n\nc\",-3.25\n"
+              "4,Dan\\,iel,4\n"
+              "5,\"\",5");
+    std::vector<std::string> expectedRows{"1|Alice\nSmith|1.500000",
+        "2|Bob \"the\" builder|2.000000", "3|a,b\n\nc|-3.250000", "4|Dan,iel|4.000000",
+        "5||5.000000"};
+    CSVReaderConfig config;
+    config.hasHeader = false;
+    // Small blocks split the file inside quotes and right after escape characters.
+    for (auto blockSize : {1u, 2u, 3u, 5u, 7u, 16u, 1024u}) {
+        ASSERT_EQ(readRows(config, blockSize), expectedRows);
+    }
+}
+
+TEST_F(CSVReaderTest, QuotesInTheMiddleOfFieldsAreLiterals) {
+    writeFile("1,5'10\",1\n"
+              "2,\"a\"\"b\"c\"d,2\n"
+              "3,x\"\",3\n"
+              "4,\"q,\n\",4\n");
+    std::vector<std::string> expectedRows{"1|5'10\"|1.000000", "2|a\"bc\"d|2.000000",
+        "3|x\"\"|3.000000", "4|q,\n|4.000000"};
+    CSVReaderConfig config;
+    config.hasHeader = false;
+    for (auto blockSize : {1u, 2u, 3u, 5u, 7u, 1024u}) {
+        ASSERT_EQ(readRows(config, blockSize), expectedRows);
+    }
+}
+
+TEST_F(CSVReaderTest, HeaderAndNulls) {
+    writeFile("id,\"name\nof person\",score\n"
+              ",Alice,\n"
+              "2,,2.5\n");
+    CSVReaderConfig config;
+    config.hasHeader = true;
+    std::vector<std::string> expectedRows{"NULL|Alice|NULL", "2|NULL|2.500000"};
+    for (auto blockSize : {1u, 4u, 1024u}) {
+        ASSERT_EQ(readRows(config, blockSize), expectedRows);
+    }
+}
+
+TEST_F(CSVReaderTest, ParseErrors) {
+    CSVReaderConfig config;
+    config.hasHeader = false;
+    writeFile("1,Alice,1\n2,Bob\n");
+    try {
+        readRows(config, 1024);
+        FAIL();
+    } catch (CopyException& e) {
+        ASSERT_STREQ(e.what(), "Copy exception: Invalid: CSV parse error: Expected 3 columns, got "
+                               "2: 2,Bob");
+    }
+    writeFile("1,Alice,1\nBob,Bob,2\n");
+    try {
+        readRows(config, 1024);
+        FAIL();
+    } catch (CopyException& e) {
+        ASSERT_STREQ(e.what(), "Copy exception: Invalid: In CSV column #0: CSV conversion error "
+                               "to int64: invalid value 'Bob'");
+    }
+    writeFile("1,\"Alice,1\n");
+    ASSERT_THROW(readRows(config, 1024), CopyException);
+}
@@ -63,6 +63,12 @@ protected:
         return database.systemConfig.bufferPoolSize;
     }
     static inline storage::WAL* getWAL(main::Database& database) { return database.wal.get(); }
+    static inline common::LatencyHistogram* getCommitLatencyHistogram(main::Database& database) {
+        return database.commitLatencyHistogram.get();
+    }
+    static inline storage::CommitSyncer* getCommitSyncer(main::Database& database) {
+        return database.commitSyncer.get();
+    }
     static inline void commitAndCheckpointOrRollback(main::Database& database,
         transaction::Transaction* writeTransaction, bool isCommit,
         bool skipCheckpointForTestingRecovery = false) {
@@ -15,6 +15,8 @@ struct TestStatement {
     bool expectedOk = false;
     std::vector<std::string> expectedTuples;
     std::string errorMessage;
+    bool expectedContains = false;
+    std::string expectedSubstring;
     bool enumerate = false;
     bool checkOutputOrder = false;
     bool isBeginWriteTransaction = false;
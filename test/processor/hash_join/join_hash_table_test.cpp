@@ -0,0 +1,238 @@
+#include "common/task_system/task_scheduler.h"
+#include "gtest/gtest.h"
+#include "processor/operator/hash_join/hash_join_build.h"
+#include "test_helper/test_helper.h"
+
+using ::testing::Test;
+using namespace kuzu::common;
+using namespace kuzu::processor;
+using namespace kuzu::storage;
+using namespace kuzu::testing;
+
+class JoinHashTableTest : public Test {
+
+public:
+    void SetUp() override {
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::STORAGE);
+        bufferManager = std::make_unique<BufferManager>(
+            BufferPoolConstants::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+        memoryManager = std::make_unique<MemoryManager>(bufferManager.get());
+        // A node ID key column followed by the prev pointer column.
+        auto keyType = LogicalType(LogicalTypeID::INTERNAL_ID);
+        auto pointerType = LogicalType(LogicalTypeID::INT64);
+        tableSchema = std::make_unique<FactorizedTableSchema>();
+        tableSchema->appendColumn(std::make_unique<ColumnSchema>(false /* isUnFlat */,
+            0 /* dataChunkPos */, LogicalTypeUtils::getRowLayoutSize(keyType)));
+        tableSchema->appendColumn(std::make_unique<ColumnSchema>(false /* isUnFlat */,
+            INVALID_DATA_CHUNK_POS, LogicalTypeUtils::getRowLayoutSize(pointerType)));
+    }
+
+    void TearDown() override {
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::STORAGE);
+    }
+
+    std::unique_ptr<JoinHashTable> createHashTable(bool canSpillPartitions = false) {
+        return std::make_unique<JoinHashTable>(
+            *memoryManager, 1 /* numKeyColumns */, tableSchema->copy(), canSpillPartitions);
+    }
+
+    void createSpillingMemoryManager(uint64_t numFrames) {
+        spillDirectory = TestHelper::appendKuzuRootPath(std::string(TestHelper::TMP_TEST_DIR) +
+                                                        "join_hash_table_test" +
+                                                        TestHelper::getMillisecondsSuffix());
+        FileUtils::createDir(spillDirectory);
+        memoryManager.reset();
+        bufferManager =
+            std::make_unique<BufferManager>(numFrames * BufferPoolConstants::PAGE_256KB_SIZE);
+        memoryManager = std::make_unique<MemoryManager>(bufferManager.get(), spillDirectory);
+    }
+
+    // Appends keys [startOffset, startOffset + numKeys) to the hash table.
+    void appendKeys(JoinHashTable& hashTable, offset_t startOffset, uint64_t numKeys) {
+        auto keyVector = std::make_shared<ValueVector>(
+            LogicalType(LogicalTypeID::INTERNAL_ID), memoryManager.get());
+        keyVector->state = std::make_shared<DataChunkState>();
+        std::vector<ValueVector*> vectorsToAppend{keyVector.get()};
+        auto numAppendedKeys = 0u;
+        while (numAppendedKeys < numKeys) {
+            auto numKeysToAppend =
+                std::min<uint64_t>(DEFAULT_VECTOR_CAPACITY, numKeys - numAppendedKeys);
+            for (auto i = 0u; i < numKeysToAppend; i++) {
+                keyVector->setValue<nodeID_t>(
+                    i, nodeID_t{startOffset + numAppendedKeys + i, tableID});
+            }
+            keyVector->state->selVector->selectedSize = numKeysToAppend;
+            hashTable.append(vectorsToAppend);
+            numAppendedKeys += numKeysToAppend;
+        }
+    }
+
+    void mergeLocalTables(
+        JoinHashTable& globalHashTable, const std::vector<uint64_t>& numKeysOfLocalTables) {
+        auto startOffset = 0u;
+        for (auto numKeys : numKeysOfLocalTables) {
+            auto localHashTable = createHashTable(globalHashTable.canSpillPartitions());
+            appendKeys(*localHashTable, startOffset, numKeys);
+            globalHashTable.merge(*localHashTable);
+            startOffset += numKeys;
+        }
+    }
+
+    // Builds the hash slots with the same tasks that follow a hash join build pipeline.
+    static void buildHashSlots(JoinHashTable& globalHashTable, uint64_t numThreads) {
+        globalHashTable.allocateHashSlots(globalHashTable.getNumTuples());
+        auto partitionTuplesTask =
+            std::make_unique<HashJoinPartitionTuplesTask>(&globalHashTable, numThreads);
+        auto buildSlotsTask =
+            std::make_shared<HashJoinBuildSlotsTask>(&globalHashTable, numThreads);
+        buildSlotsTask->addChildTask(std::move(partitionTuplesTask));
+        TaskScheduler taskScheduler{numThreads};
+        taskScheduler.scheduleTaskAndWaitOrError(buildSlotsTask, nullptr);
+    }
+
+    void buildHashTable(JoinHashTable& globalHashTable,
+        const std::vector<uint64_t>& numKeysOfLocalTables, uint64_t numThreads) {
+        mergeLocalTables(globalHashTable, numKeysOfLocalTables);
+        buildHashSlots(globalHashTable, numThreads);
+    }
+
+    static hash_t getHash(nodeID_t key) {
+        hash_t hash;
+        kuzu::function::Hash::operation<nodeID_t>(key, false /* isNull */, hash);
+        return hash;
+    }
+
+    // Checks that the key is found exactly once by following its chain of tuples.
+    static void checkKeyFound(JoinHashTable& hashTable, nodeID_t key) {
+        auto numMatches = 0u;
+        for (auto tuple = hashTable.getTupleForHash(getHash(key)); tuple != nullptr;
+             tuple = *hashTable.getPrevTuple(tuple)) {
+            if (*(nodeID_t*)tuple == key) {
+                numMatches++;
+            }
+        }
+        ASSERT_EQ(numMatches, 1);
+    }
+
+    void checkAllKeysFound(JoinHashTable& hashTable, uint64_t numKeys) {
+        ASSERT_EQ(hashTable.getNumTuples(), numKeys);
+        for (auto offset = 0u; offset < numKeys; offset++) {
+            checkKeyFound(hashTable, nodeID_t{offset, tableID});
+        }
+    }
+
+public:
+    std::unique_ptr<BufferManager> bufferManager;
+    std::unique_ptr<MemoryManager> memoryManager;
+    std::unique_ptr<FactorizedTableSchema> tableSchema;
+    std::string spillDirectory;
+    const table_id_t tableID = 2;
+};
+
+TEST_F(JoinHashTableTest, BuildSingleThreaded) {
+    auto hashTable = createHashTable();
+    buildHashTable(*hashTable, {1000, 1000, 1000, 1000}, 1 /* numThreads */);
+    ASSERT_EQ(hashTable->getNumPartitions(), 1);
+    checkAllKeysFound(*hashTable, 4000);
+}
+
+TEST_F(JoinHashTableTest, BuildMultiThreaded) {
+    auto hashTable = createHashTable();
+    // 100000 tuples need more hash slots than fit in one block, so the slots are split into
+    // partitions that are built by different threads.
+    buildHashTable(*hashTable, {25000, 25000, 25000, 25000}, 4 /* numThreads */);
+    ASSERT_GT(hashTable->getNumPartitions(), 1);
+    checkAllKeysFound(*hashTable, 100000);
+}
+
+TEST_F(JoinHashTableTest, BuildMultiThreadedAfterMergesMoveTuples) {
+    auto hashTable = createHashTable();
+    // None of the local tables fills its last block, so each merge moves the tuples of the last
+    // block of the global table.
+    buildHashTable(*hashTable, {30001, 7, 29999, 1, 30000}, 4 /* numThreads */);
+    ASSERT_GT(hashTable->getNumPartitions(), 1);
+    checkAllKeysFound(*hashTable, 90008);
+}
+
+TEST_F(JoinHashTableTest, BuildMultiThreadedWithEmptyLocalTables) {
+    auto hashTable = createHashTable();
+    buildHashTable(*hashTable, {0, 50000, 0, 50000, 0}, 4 /* numThreads */);
+    checkAllKeysFound(*hashTable, 100000);
+}
+
+TEST_F(JoinHashTableTest, MergedTuplesAreSpilledAndRestored) {
+    auto numFrames = 32u;
+    createSpillingMemoryManager(numFrames);
+    auto hashTable = createHashTable();
+    mergeLocalTables(*hashTable, {30001, 29999, 40000});
+    {
+        // Only the last tuple block of the merged table stays pinned, so pinning nearly as many
+        // other buffers as the buffer pool can hold forces merged tuples out of memory.
+        std::vector<std::unique_ptr<MemoryBuffer>> buffers;
+        for (auto i = 0u; i < numFrames - 2; i++) {
+            buffers.push_back(memoryManager->allocateBuffer());
+        }
+    }
+    ASSERT_GT(hashTable->pinPartitions(UINT64_MAX /* memoryLimit */), 0);
+    buildHashSlots(*hashTable, 4 /* numThreads */);
+    checkAllKeysFound(*hashTable, 100000);
+    hashTable.reset();
+    memoryManager.reset();
+    FileUtils::removeDir(spillDirectory);
+}
+
+TEST_F(JoinHashTableTest, PartitionsThatFitInMemoryAreNotSpilled) {
+    createSpillingMemoryManager(64 /* numFrames */);
+    auto hashTable = createHashTable(true /* canSpillPartitions */);
+    mergeLocalTables(*hashTable, {30001, 29999, 40000});
+    hashTable->pinPartitions(UINT64_MAX /* memoryLimit */);
+    ASSERT_FALSE(hashTable->hasSpilledPartitions());
+    buildHashSlots(*hashTable, 4 /* numThreads */);
+    checkAllKeysFound(*hashTable, 100000);
+    hashTable.reset();
+    memoryManager.reset();
+    FileUtils::removeDir(spillDirectory);
+}
+
+TEST_F(JoinHashTableTest, SpilledPartitionsAreProbedOnceLoaded) {
+    createSpillingMemoryManager(64 /* numFrames */);
+    auto hashTable = createHashTable(true /* canSpillPartitions */);
+    auto numKeys = 100000u;
+    mergeLocalTables(*hashTable, {30001, 29999, 40000});
+    hashTable->pinPartitions(16 * BufferPoolConstants::PAGE_256KB_SIZE /* memoryLimit */);
+    ASSERT_TRUE(hashTable->hasSpilledPartitions());
+    buildHashSlots(*hashTable, 4 /* numThreads */);
+    ASSERT_EQ(hashTable->getNumTuples(), numKeys);
+    // Keys of spilled partitions are not in the hash slots until their partitions are loaded.
+    std::vector<std::vector<nodeID_t>> keysOfSpilledPartitions(
+        JoinHashTable::getNumSpillPartitions());
+    for (auto offset = 0u; offset < numKeys; offset++) {
+        nodeID_t key{offset, tableID};
+        auto hash = getHash(key);
+        if (hashTable->isPartitionOfHashSpilled(hash)) {
+            keysOfSpilledPartitions[JoinHashTable::getSpillPartitionIdx(hash)].push_back(key);
+        } else {
+            checkKeyFound(*hashTable, key);
+        }
+    }
+    auto numSpilledKeys = 0u;
+    for (auto partitionIdx = 0u; partitionIdx < keysOfSpilledPartitions.size(); partitionIdx++) {
+        auto& keys = keysOfSpilledPartitions[partitionIdx];
+        if (keys.empty()) {
+            continue;
+        }
+        hashTable->loadSpilledPartition(partitionIdx);
+        for (auto& key : keys) {
+            checkKeyFound(*hashTable, key);
+        }
+        hashTable->unloadSpilledPartition(partitionIdx);
+        numSpilledKeys += keys.size();
+    }
+    ASSERT_GT(numSpilledKeys, 0);
+    ASSERT_LT(numSpilledKeys, numKeys);
+    hashTable.reset();
+    memoryManager.reset();
+    FileUtils::removeDir(spillDirectory);
+}
@@ -5,6 +5,7 @@
 #include "common/assert.h"
 #include "common/constants.h"
 #include "common/data_chunk/data_chunk.h"
+#include "common/file_utils.h"
 #include "gtest/gtest.h"
 #include "processor/operator/order_by/key_block_merger.h"
 #include "processor/operator/order_by/order_by_key_encoder.h"
@@ -550,3 +551,127 @@ TEST_F(KeyBlockMergerTest, multipleStrKeyColsTest) {
         orderByKeyEncoder1.getNumBytesPerTuple(), expectedBlockOffsetOrder,
         expectedFactorizedTableIdxOrder);
 }
+
+TEST_F(KeyBlockMergerTest, pinSpilledKeyBlocksTest) {
+    auto numBlocks = 4u;
+    auto spillBufferManager =
+        std::make_unique<BufferManager>(numBlocks * BufferPoolConstants::PAGE_256KB_SIZE);
+    auto spillMemoryManager = std::make_unique<MemoryManager>(
+        spillBufferManager.get(), std::filesystem::temp_directory_path().string());
+    auto spillFilePath = spillMemoryManager->getSpillFilePath();
+    auto numTuplesPerBlock = BufferPoolConstants::PAGE_256KB_SIZE / sizeof(uint64_t);
+    auto keyBlocks = std::make_unique<MergedKeyBlocks>(
+        sizeof(uint64_t), numBlocks * numTuplesPerBlock, spillMemoryManager.get());
+    for (auto i = 0u; i < numBlocks; i++) {
+        keyBlocks->pinBlocks(i * numTuplesPerBlock, (i + 1) * numTuplesPerBlock);
+        for (auto j = i * numTuplesPerBlock; j < (i + 1) * numTuplesPerBlock; j++) {
+            *(uint64_t*)keyBlocks->getTuple(j) = j;
+        }
+        keyBlocks->unpinBlocks(i * numTuplesPerBlock, (i + 1) * numTuplesPerBlock);
+    }
+    // Pinning as many new buffers as the buffer pool can hold spills all key blocks.
+    std::vector<std::unique_ptr<MemoryBuffer>> buffers;
+    for (auto i = 0u; i < numBlocks; i++) {
+        buffers.push_back(spillMemoryManager->allocateBuffer());
+    }
+    buffers.clear();
+    // The second block is shared by both ranges, so it is only read back once.
+    auto numBytesRead = keyBlocks->pinBlocks(0, numTuplesPerBlock + 1);
+    numBytesRead += keyBlocks->pinBlocks(numTuplesPerBlock, 2 * numTuplesPerBlock);
+    ASSERT_EQ(numBytesRead, 2 * BufferPoolConstants::PAGE_256KB_SIZE);
+    for (auto i = 0u; i < 2 * numTuplesPerBlock; i++) {
+        ASSERT_EQ(*(uint64_t*)keyBlocks->getTuple(i), i);
+    }
+    keyBlocks->unpinBlocks(0, numTuplesPerBlock + 1);
+    // The second block stays pinned by the second range.
+    ASSERT_EQ(keyBlocks->pinBlocks(numTuplesPerBlock, numTuplesPerBlock + 1), 0);
+    keyBlocks->unpinBlocks(numTuplesPerBlock, numTuplesPerBlock + 1);
+    keyBlocks->unpinBlocks(numTuplesPerBlock, 2 * numTuplesPerBlock);
+    keyBlocks.reset();
+    spillMemoryManager.reset();
+    ASSERT_FALSE(FileUtils::fileOrPathExists(spillFilePath));
+}
+
+TEST_F(KeyBlockMergerTest, mergeSortedRunsTest) {
+    auto numBlocks = 32u;
+    auto spillBufferManager =
+        std::make_unique<BufferManager>(numBlocks * BufferPoolConstants::PAGE_256KB_SIZE);
+    auto spillMemoryManager = std::make_unique<MemoryManager>(
+        spillBufferManager.get(), std::filesystem::temp_directory_path().string());
+    auto spillFilePath = spillMemoryManager->getSpillFilePath();
+    auto payloadTableSchema = std::make_unique<FactorizedTableSchema>();
+    payloadTableSchema->appendColumn(std::make_unique<ColumnSchema>(
+        false /* isUnflat */, 0 /* dataChunkPos */, sizeof(int64_t)));
+    payloadTableSchema->appendColumn(std::make_unique<ColumnSchema>(
+        false /* isUnflat */, 0 /* dataChunkPos */, sizeof(ku_string_t)));
+    payloadTableSchema->setMayContainsNullsToTrue(0);
+    payloadTableSchema->setMayContainsNullsToTrue(1);
+    std::vector<LogicalType> payloadTypes{
+        LogicalType{LogicalTypeID::INT64}, LogicalType{LogicalTypeID::STRING}};
+    auto getPayloadStr = [](int64_t value) {
+        return "a string that is too long to be inlined " + std::to_string(value);
+    };
+    // Each run holds the values congruent to its index, so the merged run holds all values.
+    auto numRuns = 3u;
+    auto numTuplesPerRun = 10000u;
+    auto numBytesPerTuple = 2 * sizeof(uint64_t);
+    std::vector<std::shared_ptr<SortedRun>> sortedRuns;
+    for (auto runIdx = 0u; runIdx < numRuns; runIdx++) {
+        auto dataChunk = std::make_shared<DataChunk>(2);
+        auto valueVector =
+            std::make_shared<ValueVector>(LogicalTypeID::INT64, spillMemoryManager.get());
+        auto strVector =
+            std::make_shared<ValueVector>(LogicalTypeID::STRING, spillMemoryManager.get());
+        dataChunk->insert(0, valueVector);
+        dataChunk->insert(1, strVector);
+        auto factorizedTable = std::make_unique<FactorizedTable>(
+            spillMemoryManager.get(), payloadTableSchema->copy());
+        std::vector<ValueVector*> vectorsToAppend{valueVector.get(), strVector.get()};
+        for (auto i = 0u; i < numTuplesPerRun; i += DEFAULT_VECTOR_CAPACITY) {
+            auto numTuples = std::min(DEFAULT_VECTOR_CAPACITY, (uint64_t)numTuplesPerRun - i);
+            dataChunk->state->selVector->selectedSize = numTuples;
+            for (auto j = 0u; j < numTuples; j++) {
+                int64_t value = (i + j) * numRuns + runIdx;
+                valueVector->setValue(j, value);
+                strVector->setValue(j, getPayloadStr(value));
+            }
+            factorizedTable->append(vectorsToAppend);
+        }
+        SortedRunWriter writer{spillMemoryManager.get(), *payloadTableSchema, payloadTypes,
+            (uint32_t)numBytesPerTuple, numTuplesPerRun};
+        uint64_t key[2] = {0, 0};
+        for (auto i = 0u; i < numTuplesPerRun; i++) {
+            key[0] = BSWAP64(*(uint64_t*)factorizedTable->getTuple(i));
+            writer.append((uint8_t*)key, factorizedTable->getTuple(i));
+        }
+        sortedRuns.push_back(writer.finish());
+    }
+    // Pinning as many new buffers as the buffer pool can hold spills all runs.
+    std::vector<std::unique_ptr<MemoryBuffer>> buffers;
+    for (auto i = 0u; i < numBlocks; i++) {
+        buffers.push_back(spillMemoryManager->allocateBuffer());
+    }
+    buffers.clear();
+    {
+        std::vector<std::shared_ptr<FactorizedTable>> factorizedTables;
+        std::vector<StrKeyColInfo> strKeyColsInfo;
+        KeyBlockMerger keyBlockMerger{factorizedTables, strKeyColsInfo, (uint32_t)numBytesPerTuple};
+        SortedRunWriter writer{spillMemoryManager.get(), *payloadTableSchema, payloadTypes,
+            (uint32_t)numBytesPerTuple, numRuns * numTuplesPerRun};
+        ASSERT_GT(keyBlockMerger.mergeSortedRuns(sortedRuns, writer), 0);
+        sortedRuns.clear();
+        SortedRunReader reader{writer.finish()};
+        auto colOffset = payloadTableSchema->getColOffset(1);
+        for (auto value = 0u; value < numRuns * numTuplesPerRun; value++) {
+            ASSERT_TRUE(reader.hasMoreTuples());
+            ASSERT_EQ(BSWAP64(*(uint64_t*)reader.getKeyTuplePtr()), value);
+            ASSERT_EQ(*(int64_t*)reader.getPayloadTuple(), value);
+            ASSERT_EQ(((ku_string_t*)(reader.getPayloadTuple() + colOffset))->getAsString(),
+                getPayloadStr(value));
+            reader.moveToNextTuple();
+        }
+        ASSERT_FALSE(reader.hasMoreTuples());
+    }
+    spillMemoryManager.reset();
+    ASSERT_FALSE(FileUtils::fileOrPathExists(spillFilePath));
+}
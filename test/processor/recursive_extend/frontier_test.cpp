@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "processor/operator/recursive_extend/frontier.h"
+
+using namespace kuzu::common;
+using namespace kuzu::processor;
+
+class FrontierTest : public ::testing::Test {
+public:
+    // Two node tables with 16 and 8 nodes, so a frontier of more than 3 nodes is dense.
+    void SetUp() override { numNodesPerTable = {16, 8}; }
+
+    static nodeID_t nodeID(offset_t offset, table_id_t tableID) {
+        return nodeID_t{offset, tableID};
+    }
+
+    static relID_t relID(offset_t offset) { return relID_t{offset, 2 /* tableID */}; }
+
+    static void checkBwdEdges(const Frontier& frontier, nodeID_t nbrNodeID,
+        const std::vector<frontier::node_rel_id_t>& expectedEdges) {
+        auto edges = frontier.getBwdEdges(nbrNodeID);
+        ASSERT_EQ(edges.size(), expectedEdges.size());
+        for (auto i = 0u; i < edges.size(); ++i) {
+            ASSERT_EQ(edges[i].first, expectedEdges[i].first);
+            ASSERT_EQ(edges[i].second, expectedEdges[i].second);
+        }
+    }
+
+public:
+    std::vector<uint64_t> numNodesPerTable;
+};
+
+TEST_F(FrontierTest, SparseFrontierKeepsBwdEdgesInOrder) {
+    Frontier frontier{&numNodesPerTable};
+    frontier.addEdge(nodeID(1, 0), nodeID(5, 0), relID(0));
+    frontier.addEdge(nodeID(2, 0), nodeID(3, 1), relID(1));
+    frontier.addEdge(nodeID(3, 0), nodeID(5, 0), relID(2));
+    frontier.finalize();
+    ASSERT_EQ(frontier.nodeIDs, (std::vector<nodeID_t>{nodeID(5, 0), nodeID(3, 1)}));
+    checkBwdEdges(frontier, nodeID(5, 0), {{nodeID(1, 0), relID(0)}, {nodeID(3, 0), relID(2)}});
+    checkBwdEdges(frontier, nodeID(3, 1), {{nodeID(2, 0), relID(1)}});
+}
+
+TEST_F(FrontierTest, BwdEdgesAreKeptWhenSwitchingToDense) {
+    Frontier frontier{&numNodesPerTable};
+    // Edges of each nbr node are interleaved with the edges of the other nbr nodes, and edges are
+    // added both before and after the frontier becomes dense.
+    std::vector<nodeID_t> nbrNodeIDs{
+        nodeID(15, 0), nodeID(0, 1), nodeID(7, 1), nodeID(0, 0), nodeID(8, 0)};
+    for (auto round = 0u; round < 3; ++round) {
+        for (auto i = 0u; i < nbrNodeIDs.size(); ++i) {
+            frontier.addEdge(nodeID(round, 0), nbrNodeIDs[i], relID(round * 10 + i));
+        }
+    }
+    frontier.finalize();
+    ASSERT_EQ(frontier.nodeIDs, nbrNodeIDs);
+    for (auto i = 0u; i < nbrNodeIDs.size(); ++i) {
+        checkBwdEdges(frontier, nbrNodeIDs[i],
+            {{nodeID(0, 0), relID(i)}, {nodeID(1, 0), relID(10 + i)},
+                {nodeID(2, 0), relID(20 + i)}});
+    }
+    checkBwdEdges(frontier, nodeID(1, 0), {});
+}
+
+TEST_F(FrontierTest, NodesOutsideTheDenseArraysKeepSparseBwdEdges) {
+    Frontier frontier{&numNodesPerTable};
+    for (auto offset = 0u; offset < 4; ++offset) {
+        frontier.addEdge(nodeID(0, 1), nodeID(offset, 0), relID(offset));
+    }
+    // Nodes inserted after the node counts were read, and nodes of an unknown table.
+    frontier.addEdge(nodeID(0, 1), nodeID(16, 0), relID(4));
+    frontier.addEdge(nodeID(1, 1), nodeID(16, 0), relID(5));
+    frontier.addEdge(nodeID(0, 1), nodeID(0, 3), relID(6));
+    frontier.addEdge(nodeID(1, 1), nodeID(2, 0), relID(7));
+    frontier.finalize();
+    ASSERT_EQ(frontier.nodeIDs.size(), 6);
+    checkBwdEdges(frontier, nodeID(16, 0), {{nodeID(0, 1), relID(4)}, {nodeID(1, 1), relID(5)}});
+    checkBwdEdges(frontier, nodeID(0, 3), {{nodeID(0, 1), relID(6)}});
+    checkBwdEdges(frontier, nodeID(2, 0), {{nodeID(0, 1), relID(2)}, {nodeID(1, 1), relID(7)}});
+}
+
+TEST_F(FrontierTest, ResetDenseFrontierIsReused) {
+    Frontier frontier{&numNodesPerTable};
+    for (auto offset = 0u; offset < 16; ++offset) {
+        frontier.addEdge(nodeID(0, 1), nodeID(offset, 0), relID(offset));
+    }
+    frontier.finalize();
+    checkBwdEdges(frontier, nodeID(9, 0), {{nodeID(0, 1), relID(9)}});
+    frontier.resetState();
+    // The reused frontier stays dense, and nodes of the previous BFS are no longer in it.
+    frontier.addEdge(nodeID(1, 1), nodeID(9, 0), relID(20));
+    frontier.addEdge(nodeID(2, 1), nodeID(4, 1), relID(21));
+    frontier.addEdge(nodeID(3, 1), nodeID(9, 0), relID(22));
+    frontier.finalize();
+    ASSERT_EQ(frontier.nodeIDs, (std::vector<nodeID_t>{nodeID(9, 0), nodeID(4, 1)}));
+    checkBwdEdges(frontier, nodeID(9, 0), {{nodeID(1, 1), relID(20)}, {nodeID(3, 1), relID(22)}});
+    checkBwdEdges(frontier, nodeID(4, 1), {{nodeID(2, 1), relID(21)}});
+    checkBwdEdges(frontier, nodeID(8, 0), {});
+}
+
+TEST_F(FrontierTest, DenseMultiplicitiesAreAccumulated) {
+    Frontier frontier{&numNodesPerTable};
+    for (auto offset = 0u; offset < 8; ++offset) {
+        frontier.addNodeWithMultiplicity(nodeID(offset % 5, 0), offset + 1);
+    }
+    frontier.finalize();
+    ASSERT_EQ(frontier.nodeIDs.size(), 5);
+    ASSERT_EQ(frontier.getMultiplicity(nodeID(0, 0)), 1 + 6);
+    ASSERT_EQ(frontier.getMultiplicity(nodeID(4, 0)), 5);
+    frontier.resetState();
+    frontier.addNodeWithMultiplicity(nodeID(0, 0), 2);
+    ASSERT_EQ(frontier.getMultiplicity(nodeID(0, 0)), 2);
+}
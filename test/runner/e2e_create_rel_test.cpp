@@ -190,6 +190,52 @@ public:
         sortAndCheckTestResults(actualResult, expectedResult);
     }
 
+    // The neighbour offsets of fwd chunk 0 take 12 bits, as persons 0 and 1 know persons up to
+    // 2300. The lists of the other fwd chunks are empty and all bwd lists hold persons 0 or 1, so
+    // the other chunks take 1 bit. The inserted rels don't fit into the bit widths of their fwd
+    // and bwd chunks, so these chunks are widened and all their lists are written again.
+    void insertRelsBeyondNbrOffsetBitWidth(bool isCommit, TransactionTestType transactionTestType) {
+        conn->beginWriteTransaction();
+        insertRel("person" /* srcNode */, 2400 /* srcPK */, "person" /* dstNode */,
+            2200 /* dstPK */, "knows" /* relation */, "{length: 2400}" /* propertyValues */);
+        insertRel("person" /* srcNode */, 700 /* srcPK */, "person" /* dstNode */, 3 /* dstPK */,
+            "knows" /* relation */, "{length: 700}" /* propertyValues */);
+        commitOrRollbackConnectionAndInitDBIfNecessary(isCommit, transactionTestType);
+        checkRelsInWidenedChunks(isCommit);
+        // The bit widths of the chunks are read from disk after the database is reopened.
+        conn->commit();
+        createDBAndConn();
+        checkRelsInWidenedChunks(isCommit);
+    }
+
+    void checkRelsInWidenedChunks(bool isCommit) {
+        auto result = conn->query("MATCH (a:person)-[e:knows]->(b:person) WHERE a.ID > 1 RETURN "
+                                  "a.ID, b.ID, e.length");
+        auto actualResult = TestHelper::convertResultToString(*result, false /* checkOrder */);
+        std::vector<std::string> expectedResult =
+            isCommit ? std::vector<std::string>{"2400|2200|2400", "700|3|700"} :
+                       std::vector<std::string>{};
+        sortAndCheckTestResults(actualResult, expectedResult);
+        // Bwd lists of chunks 0 and 4, which hold persons 3 and 2200.
+        result = conn->query("MATCH (a:person)<-[e:knows]-(b:person) WHERE a.ID < 512 OR "
+                             "a.ID >= 2048 RETURN a.ID, b.ID, e.length");
+        actualResult = TestHelper::convertResultToString(*result, false /* checkOrder */);
+        expectedResult.clear();
+        for (auto i = 0; i <= 50; i++) {
+            expectedResult.push_back(kuzu::common::StringUtils::string_format("{}|1|{}", i, i));
+        }
+        for (auto i = 1; i <= 2300; i++) {
+            if (i < 512 || i >= 2048) {
+                expectedResult.push_back(kuzu::common::StringUtils::string_format("{}|0|{}", i, i));
+            }
+        }
+        if (isCommit) {
+            expectedResult.emplace_back("2200|2400|2400");
+            expectedResult.emplace_back("3|700|700");
+        }
+        sortAndCheckTestResults(actualResult, expectedResult);
+    }
+
     void validateExceptionMessage(std::string query, std::string expectedException) {
         auto result = conn->query(query);
         ASSERT_FALSE(result->isSuccess());
@@ -311,6 +357,22 @@ TEST_F(CreateRelTest, InsertRelsToNewlyAddedNodeRollbackRecovery) {
     insertRelsToNewlyAddedNode(false /* isCommit */, TransactionTestType::RECOVERY);
 }
 
+TEST_F(CreateRelTest, InsertRelsBeyondNbrOffsetBitWidthCommitNormalExecution) {
+    insertRelsBeyondNbrOffsetBitWidth(true /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CreateRelTest, InsertRelsBeyondNbrOffsetBitWidthCommitRecovery) {
+    insertRelsBeyondNbrOffsetBitWidth(true /* isCommit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CreateRelTest, InsertRelsBeyondNbrOffsetBitWidthRollbackNormalExecution) {
+    insertRelsBeyondNbrOffsetBitWidth(false /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CreateRelTest, InsertRelsBeyondNbrOffsetBitWidthRollbackRecovery) {
+    insertRelsBeyondNbrOffsetBitWidth(false /* isCommit */, TransactionTestType::RECOVERY);
+}
+
 TEST_F(CreateRelTest, ViolateManyOneMultiplicityError) {
     conn->beginWriteTransaction();
     validateExceptionMessage(
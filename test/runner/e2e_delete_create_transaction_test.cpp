@@ -1,5 +1,8 @@
 #include "graph_test/graph_test.h"
+#include "storage/index/hash_index_utils.h"
 
+using namespace kuzu::common;
+using namespace kuzu::storage;
 using namespace kuzu::testing;
 
 class BaseDeleteCreateTrxTest : public DBTest {
@@ -80,6 +83,79 @@ public:
         ASSERT_EQ(getCount(connection, query), exist ? 1 : 0);
     }
 
+    // Returns the keys in [startKey, endKey) whose hashes have the same fingerprint, i.e., the
+    // most significant byte of the hash, as the hash of fingerprintKey.
+    static std::vector<std::string> getKeysWithFingerprintOf(
+        uint64_t fingerprintKey, uint64_t startKey, uint64_t endKey, bool isStringPK) {
+        auto getFingerprint = [&](uint64_t key) {
+            hash_t hash;
+            if (isStringPK) {
+                auto stringKey = std::to_string(key);
+                hash = HashIndexUtils::hashFuncForString((const uint8_t*)stringKey.c_str());
+            } else {
+                auto int64Key = (int64_t)key;
+                hash = HashIndexUtils::hashFuncForInt64((const uint8_t*)&int64Key);
+            }
+            return hash >> 56;
+        };
+        auto fingerprint = getFingerprint(fingerprintKey);
+        std::vector<std::string> keys;
+        for (auto key = startKey; key < endKey; key++) {
+            if (getFingerprint(key) == fingerprint) {
+                keys.push_back(isStringPK ? "'" + std::to_string(key) + "'" : std::to_string(key));
+            }
+        }
+        return keys;
+    }
+
+    // The 10000 keys of the dataset are [firstKey, firstKey + 10000). Keys whose fingerprint
+    // collides with the fingerprint of firstKey are deleted and inserted, so lookups compare the
+    // keys of entries with equal fingerprints in the same slot, also after the inserts split slots
+    // and rehash their entries at commit and after deletes invalidate entries of split slots.
+    void testFingerprintCollisionsOfKeys(
+        bool isCommit, TransactionTestType trxTestType, uint64_t firstKey, bool isStringPK) {
+        auto builtKeys =
+            getKeysWithFingerprintOf(firstKey, firstKey, firstKey + 10000, isStringPK);
+        auto newKeys =
+            getKeysWithFingerprintOf(firstKey, firstKey + 10000, firstKey + 200000, isStringPK);
+        std::vector<std::string> keysToDelete, keysToKeep, keysToInsert, keysNotInserted;
+        for (auto i = 0u; i < builtKeys.size(); i++) {
+            (i % 2 == 0 ? keysToDelete : keysToKeep).push_back(builtKeys[i]);
+        }
+        for (auto i = 0u; i < newKeys.size(); i++) {
+            (i % 4 == 3 ? keysNotInserted : keysToInsert).push_back(newKeys[i]);
+        }
+        conn->beginWriteTransaction();
+        deleteNodes(keysToDelete);
+        createNodes(keysToInsert);
+        validateNodesExistOrNot(conn.get(), keysToDelete, false /* exist */);
+        validateNodesExistOrNot(conn.get(), keysToKeep, true /* exist */);
+        validateNodesExistOrNot(conn.get(), keysToInsert, true /* exist */);
+        validateNodesExistOrNot(conn.get(), keysNotInserted, false /* exist */);
+        validateNodesExistOrNot(readConn.get(), keysToDelete, true /* exist */);
+        validateNodesExistOrNot(readConn.get(), keysToInsert, false /* exist */);
+        commitOrRollbackConnectionAndInitDBIfNecessary(isCommit, trxTestType);
+        validateNodesExistOrNot(conn.get(), keysToDelete, !isCommit /* exist */);
+        validateNodesExistOrNot(conn.get(), keysToKeep, true /* exist */);
+        validateNodesExistOrNot(conn.get(), keysToInsert, isCommit /* exist */);
+        validateNodesExistOrNot(conn.get(), keysNotInserted, false /* exist */);
+        if (!isCommit) {
+            return;
+        }
+        // Deletes half of the inserted keys from the split slots.
+        std::vector<std::string> insertedKeysToDelete, insertedKeysToKeep;
+        for (auto i = 0u; i < keysToInsert.size(); i++) {
+            (i % 2 == 0 ? insertedKeysToDelete : insertedKeysToKeep).push_back(keysToInsert[i]);
+        }
+        deleteNodes(insertedKeysToDelete);
+        commitOrRollbackConnectionAndInitDBIfNecessary(isCommit, trxTestType);
+        validateNodesExistOrNot(conn.get(), insertedKeysToDelete, false /* exist */);
+        validateNodesExistOrNot(conn.get(), insertedKeysToKeep, true /* exist */);
+        validateNodesExistOrNot(conn.get(), keysToKeep, true /* exist */);
+        ASSERT_EQ(getNumNodes(conn.get()),
+            10000 - keysToDelete.size() + insertedKeysToKeep.size());
+    }
+
 public:
     std::unique_ptr<Connection> readConn;
 };
@@ -179,6 +255,11 @@ public:
             validateNodeExistOrNot(conn.get(), "10000099", false /* not exist */);
         }
     }
+
+    void testFingerprintCollisions(bool isCommit, TransactionTestType trxTestType) {
+        testFingerprintCollisionsOfKeys(
+            isCommit, trxTestType, 0 /* firstKey */, false /* isStringPK */);
+    }
 };
 
 class CreateDeleteStringNodeTrxTest : public BaseDeleteCreateTrxTest {
@@ -278,6 +359,11 @@ public:
             validateNodeExistOrNot(conn.get(), "'key0'", false /* not exist */);
         }
     }
+
+    void testFingerprintCollisions(bool isCommit, TransactionTestType trxTestType) {
+        testFingerprintCollisionsOfKeys(
+            isCommit, trxTestType, 999999995000 /* firstKey */, true /* isStringPK */);
+    }
 };
 
 class DeleteNodeWithEdgesErrorTest : public EmptyDBTest {
@@ -467,6 +553,38 @@ TEST_F(CreateDeleteStringNodeTrxTest, MixedInsertDeleteRollbackRecovery) {
     testMixedDeleteAndInsert(false /* rollback */, TransactionTestType::RECOVERY);
 }
 
+TEST_F(CreateDeleteInt64NodeTrxTest, FingerprintCollisionsCommitNormalExecution) {
+    testFingerprintCollisions(true /* commit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CreateDeleteInt64NodeTrxTest, FingerprintCollisionsCommitRecovery) {
+    testFingerprintCollisions(true /* commit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CreateDeleteInt64NodeTrxTest, FingerprintCollisionsRollbackNormalExecution) {
+    testFingerprintCollisions(false /* rollback */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CreateDeleteInt64NodeTrxTest, FingerprintCollisionsRollbackRecovery) {
+    testFingerprintCollisions(false /* rollback */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CreateDeleteStringNodeTrxTest, FingerprintCollisionsCommitNormalExecution) {
+    testFingerprintCollisions(true /* commit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CreateDeleteStringNodeTrxTest, FingerprintCollisionsCommitRecovery) {
+    testFingerprintCollisions(true /* commit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CreateDeleteStringNodeTrxTest, FingerprintCollisionsRollbackNormalExecution) {
+    testFingerprintCollisions(false /* rollback */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CreateDeleteStringNodeTrxTest, FingerprintCollisionsRollbackRecovery) {
+    testFingerprintCollisions(false /* rollback */, TransactionTestType::RECOVERY);
+}
+
 TEST_F(NodeInsertionDeletionSerialPKTest, NodeInsertionDeletionWithSerial) {
     // Firstly, we insert two nodes with serial as primary key to movie table.
     ASSERT_TRUE(conn->query("CREATE(m : movies {length: 32})")->isSuccess());
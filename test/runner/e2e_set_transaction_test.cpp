@@ -51,6 +51,42 @@ public:
         ASSERT_EQ(result->getNext()->getValue(0)->getValue<std::string>(),
             "abcdefghijklmnopqrstuvwxyz" + std::to_string(numWriteQueries + 2));
     }
+
+    // fName is dictionary-encoded by COPY. Persons 0 and 3 are set to a value that is not in the
+    // dictionary and to a value that is, so filters and group-bys see both kinds of values.
+    void setEncodedStringProp(bool isCommit, TransactionTestType transactionTestType) {
+        conn->beginWriteTransaction();
+        conn->query("MATCH (a:person) WHERE a.ID = 0 SET a.fName = 'Zed'");
+        conn->query("MATCH (a:person) WHERE a.ID = 3 SET a.fName = 'Bob'");
+        checkEncodedStringProp(true /* isUpdated */);
+        commitOrRollbackConnectionAndInitDBIfNecessary(isCommit, transactionTestType);
+        checkEncodedStringProp(isCommit /* isUpdated */);
+        // The dictionary and the codes are read from disk after the database is reopened.
+        conn->commit();
+        createDBAndConn();
+        checkEncodedStringProp(isCommit /* isUpdated */);
+    }
+
+    void checkEncodedStringProp(bool isUpdated) {
+        auto result = conn->query("MATCH (a:person) WHERE a.fName = 'Zed' RETURN a.ID");
+        auto actualResult = TestHelper::convertResultToString(*result, false /* checkOrder */);
+        auto expectedResult =
+            isUpdated ? std::vector<std::string>{"0"} : std::vector<std::string>{};
+        sortAndCheckTestResults(actualResult, expectedResult);
+        result = conn->query("MATCH (a:person) WHERE a.fName = 'Bob' RETURN a.ID");
+        actualResult = TestHelper::convertResultToString(*result, false /* checkOrder */);
+        expectedResult =
+            isUpdated ? std::vector<std::string>{"2", "3"} : std::vector<std::string>{"2"};
+        sortAndCheckTestResults(actualResult, expectedResult);
+        result = conn->query("MATCH (:person)-[:knows]->(b:person) RETURN b.fName, count(*)");
+        actualResult = TestHelper::convertResultToString(*result, false /* checkOrder */);
+        expectedResult = isUpdated ?
+                             std::vector<std::string>{"Zed|3", "Bob|6", "Dan|3", "Farooq|1",
+                                 "Greg|1"} :
+                             std::vector<std::string>{"Alice|3", "Bob|3", "Carol|3", "Dan|3",
+                                 "Farooq|1", "Greg|1"};
+        sortAndCheckTestResults(actualResult, expectedResult);
+    }
 };
 
 TEST_F(SetNodeStructuredPropTransactionTest,
@@ -205,3 +241,19 @@ TEST_F(SetNodeStructuredPropTransactionTest, SetManyNodeLongStringPropRollbackTe
     auto result = conn->query("MATCH (a:person) WHERE a.ID=0 RETURN a.fName");
     ASSERT_EQ(result->getNext()->getValue(0)->getValue<std::string>(), "Alice");
 }
+
+TEST_F(SetNodeStructuredPropTransactionTest, SetEncodedStringPropCommitNormalExecution) {
+    setEncodedStringProp(true /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(SetNodeStructuredPropTransactionTest, SetEncodedStringPropCommitRecovery) {
+    setEncodedStringProp(true /* isCommit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(SetNodeStructuredPropTransactionTest, SetEncodedStringPropRollbackNormalExecution) {
+    setEncodedStringProp(false /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(SetNodeStructuredPropTransactionTest, SetEncodedStringPropRollbackRecovery) {
+    setEncodedStringProp(false /* isCommit */, TransactionTestType::RECOVERY);
+}
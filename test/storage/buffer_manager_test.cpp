@@ -0,0 +1,176 @@
+#include "graph_test/graph_test.h"
+#include "storage/buffer_manager/buffer_manager.h"
+
+using namespace kuzu::common;
+using namespace kuzu::testing;
+using namespace kuzu::storage;
+
+class BufferManagerTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        FileUtils::createDir(databasePath);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+        initBufferManager(EvictionPolicy::SECOND_CHANCE);
+        std::vector<uint8_t> page(BufferPoolConstants::PAGE_4KB_SIZE);
+        for (auto i = 0u; i < NUM_PAGES; i++) {
+            memset(page.data(), i + 1, BufferPoolConstants::PAGE_4KB_SIZE);
+            fileHandle->writePage(page.data(), fileHandle->addNewPage());
+        }
+    }
+
+    void TearDown() override {
+        fileHandle.reset();
+        bufferManager.reset();
+        EmptyDBTest::TearDown();
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+    }
+
+    void initBufferManager(EvictionPolicy evictionPolicy) {
+        fileHandle.reset();
+        bufferManager = std::make_unique<BufferManager>(
+            NUM_FRAMES * BufferPoolConstants::PAGE_4KB_SIZE, evictionPolicy);
+        fileHandle = bufferManager->getBMFileHandle(databasePath + "/test_file.col",
+            FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS,
+            BMFileHandle::FileVersionedType::NON_VERSIONED_FILE);
+    }
+
+    void checkPageContents(page_idx_t startPageIdx, page_idx_t endPageIdx,
+        BufferManager::AccessHint accessHint = BufferManager::AccessHint::NORMAL) {
+        std::vector<uint8_t> expectedContent(BufferPoolConstants::PAGE_4KB_SIZE);
+        for (auto i = startPageIdx; i < endPageIdx; i++) {
+            memset(expectedContent.data(), i + 1, BufferPoolConstants::PAGE_4KB_SIZE);
+            auto checkFrame = [&](uint8_t* frame) {
+                ASSERT_EQ(memcmp(frame, expectedContent.data(), BufferPoolConstants::PAGE_4KB_SIZE),
+                    0);
+            };
+            bufferManager->optimisticRead(*fileHandle, i, checkFrame, accessHint);
+        }
+    }
+
+public:
+    static constexpr uint64_t NUM_FRAMES = 32;
+    static constexpr uint64_t NUM_PAGES = 2 * NUM_FRAMES;
+    static constexpr uint64_t NUM_HOT_PAGES = NUM_FRAMES / 4;
+    std::unique_ptr<BufferManager> bufferManager;
+    std::unique_ptr<BMFileHandle> fileHandle;
+};
+
+TEST_F(BufferManagerTest, PrefetchedPagesAreReadAsynchronously) {
+    PrefetchStats stats;
+    bufferManager->prefetch(*fileHandle, 0 /* startPageIdx */, NUM_FRAMES, stats);
+    ASSERT_EQ(stats.numPageHits, 0);
+    ASSERT_EQ(stats.numPageMisses, NUM_FRAMES);
+    ASSERT_EQ(stats.numPagesPrefetched, NUM_FRAMES);
+    // Pages whose reads are not complete are LOCKED, so reads wait for the prefetched contents.
+    checkPageContents(0 /* startPageIdx */, NUM_FRAMES);
+    stats = PrefetchStats{};
+    // Pages beyond the end of the file are ignored, and cached pages are evicted to make room for
+    // the prefetched pages.
+    bufferManager->prefetch(*fileHandle, NUM_FRAMES / 2, NUM_PAGES, stats);
+    ASSERT_EQ(stats.numPageHits, NUM_FRAMES / 2);
+    ASSERT_EQ(stats.numPageMisses, NUM_PAGES - NUM_FRAMES);
+    ASSERT_EQ(stats.numPagesPrefetched, NUM_PAGES - NUM_FRAMES);
+    checkPageContents(NUM_FRAMES, NUM_PAGES);
+}
+
+TEST_F(BufferManagerTest, PrefetchStopsWhenBufferPoolIsFullOfPinnedPages) {
+    for (auto i = 0u; i < NUM_FRAMES / 2; i++) {
+        bufferManager->pin(*fileHandle, i);
+    }
+    PrefetchStats stats;
+    bufferManager->prefetch(*fileHandle, 0 /* startPageIdx */, NUM_PAGES, stats);
+    ASSERT_EQ(stats.numPageHits, NUM_FRAMES / 2);
+    ASSERT_EQ(stats.numPagesPrefetched, NUM_FRAMES / 2);
+    for (auto i = 0u; i < NUM_FRAMES / 2; i++) {
+        bufferManager->unpin(*fileHandle, i);
+    }
+    checkPageContents(0 /* startPageIdx */, NUM_PAGES);
+}
+
+TEST_F(BufferManagerTest, ConsecutiveDirtyPagesAreFlushed) {
+    // Every third page is left clean, which splits the dirty pages into multiple extents.
+    for (auto i = 0u; i < NUM_FRAMES; i++) {
+        auto frame = bufferManager->pin(*fileHandle, i);
+        if (i % 3 != 0) {
+            memset(frame, i + NUM_PAGES + 1, BufferPoolConstants::PAGE_4KB_SIZE);
+            fileHandle->setLockedPageDirty(i);
+        }
+        bufferManager->unpin(*fileHandle, i);
+    }
+    bufferManager->flushAllDirtyPagesInFrames(*fileHandle);
+    std::vector<uint8_t> page(BufferPoolConstants::PAGE_4KB_SIZE);
+    std::vector<uint8_t> expectedContent(BufferPoolConstants::PAGE_4KB_SIZE);
+    for (auto i = 0u; i < NUM_PAGES; i++) {
+        ASSERT_TRUE(fileHandle->isPageEvicted(i));
+        fileHandle->readPage(page.data(), i);
+        auto expectedByte = (i < NUM_FRAMES && i % 3 != 0) ? i + NUM_PAGES + 1 : i + 1;
+        memset(expectedContent.data(), expectedByte, BufferPoolConstants::PAGE_4KB_SIZE);
+        ASSERT_EQ(
+            memcmp(page.data(), expectedContent.data(), BufferPoolConstants::PAGE_4KB_SIZE), 0);
+    }
+}
+
+TEST_F(BufferManagerTest, ScanDoesNotEvictHotPagesWithScanResistantPolicy) {
+    initBufferManager(EvictionPolicy::SCAN_RESISTANT);
+    checkPageContents(0 /* startPageIdx */, NUM_HOT_PAGES);
+    // A page loaded by a scan is promoted to the main eviction queue once it is read again without
+    // the scan hint.
+    checkPageContents(NUM_HOT_PAGES, NUM_HOT_PAGES + 1, BufferManager::AccessHint::SCAN);
+    checkPageContents(NUM_HOT_PAGES, NUM_HOT_PAGES + 1);
+    checkPageContents(NUM_HOT_PAGES + 1, NUM_PAGES, BufferManager::AccessHint::SCAN);
+    for (auto i = 0u; i <= NUM_HOT_PAGES; i++) {
+        ASSERT_FALSE(fileHandle->isPageEvicted(i));
+    }
+    ASSERT_TRUE(fileHandle->isPageEvicted(NUM_HOT_PAGES + 1));
+}
+
+TEST_F(BufferManagerTest, ScanEvictsHotPagesWithSecondChancePolicy) {
+    checkPageContents(0 /* startPageIdx */, NUM_HOT_PAGES);
+    checkPageContents(NUM_HOT_PAGES, NUM_PAGES, BufferManager::AccessHint::SCAN);
+    for (auto i = 0u; i < NUM_HOT_PAGES; i++) {
+        ASSERT_TRUE(fileHandle->isPageEvicted(i));
+    }
+}
+
+TEST_F(BufferManagerTest, FullProbationaryQueueEvictsOrPromotesItsOldestPage) {
+    initBufferManager(EvictionPolicy::SCAN_RESISTANT);
+    auto maxNumProbationaryPages =
+        NUM_FRAMES / BufferPoolConstants::PROBATIONARY_EVICTION_QUEUE_SIZE_DIVISOR;
+    // The first scanned page is read again without the scan hint, so it is promoted to the main
+    // eviction queue when it leaves the probationary queue.
+    checkPageContents(0 /* startPageIdx */, 1, BufferManager::AccessHint::SCAN);
+    checkPageContents(0 /* startPageIdx */, 1);
+    // The buffer pool has free frames left, but each page scanned once the probationary queue is
+    // full evicts the oldest probationary page.
+    checkPageContents(1 /* startPageIdx */, 2 * maxNumProbationaryPages,
+        BufferManager::AccessHint::SCAN);
+    ASSERT_FALSE(fileHandle->isPageEvicted(0));
+    for (auto i = 1u; i < maxNumProbationaryPages; i++) {
+        ASSERT_TRUE(fileHandle->isPageEvicted(i));
+    }
+    for (auto i = maxNumProbationaryPages; i < 2 * maxNumProbationaryPages; i++) {
+        ASSERT_FALSE(fileHandle->isPageEvicted(i));
+    }
+}
+
+TEST_F(BufferManagerTest, ReservedMemoryEvictsUnpinnedPages) {
+    checkPageContents(0 /* startPageIdx */, NUM_FRAMES);
+    for (auto i = 0u; i < NUM_FRAMES / 2; i++) {
+        bufferManager->pin(*fileHandle, i);
+    }
+    // Only the unpinned half of the pages can be evicted for the reserved memory.
+    auto halfOfPool = NUM_FRAMES / 2 * BufferPoolConstants::PAGE_4KB_SIZE;
+    ASSERT_FALSE(bufferManager->reserveMemory(halfOfPool + 1));
+    ASSERT_TRUE(bufferManager->reserveMemory(halfOfPool));
+    for (auto i = NUM_FRAMES / 2; i < NUM_FRAMES; i++) {
+        ASSERT_TRUE(fileHandle->isPageEvicted(i));
+    }
+    for (auto i = 0u; i < NUM_FRAMES / 2; i++) {
+        bufferManager->unpin(*fileHandle, i);
+    }
+    // Pages are read again once the reserved memory is released.
+    bufferManager->releaseMemory(halfOfPool);
+    checkPageContents(NUM_FRAMES / 2, NUM_FRAMES);
+}
@@ -0,0 +1,194 @@
+#include "gtest/gtest.h"
+#include "storage/in_mem_storage_structure/in_mem_column.h"
+#include "storage/storage_structure/column_compression.h"
+#include "test_helper/test_helper.h"
+
+using namespace kuzu::common;
+using namespace kuzu::storage;
+using namespace kuzu::testing;
+using ::testing::Test;
+
+class ColumnCompressionTest : public Test {
+
+protected:
+    void SetUp() override {
+        segmentBuffer = std::make_unique<uint8_t[]>(
+            StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT * BufferPoolConstants::PAGE_4KB_SIZE);
+    }
+
+    void TearDown() override {}
+
+public:
+    template<typename T>
+    uint64_t compressAndCheckValues(const std::vector<T>& values, const bool* isNull,
+        CompressionType expectedCompressionType) {
+        ColumnCompression compression{sizeof(T)};
+        auto numPages = compression.compressSegment(
+            (uint8_t*)values.data(), isNull, values.size(), segmentBuffer.get());
+        auto header = getHeader();
+        EXPECT_EQ(header.compressionType, expectedCompressionType);
+        std::vector<T> result(values.size());
+        for (auto i = 0u; i < values.size(); i++) {
+            if (header.compressionType == CompressionType::CONSTANT) {
+                compression.decompressValues(
+                    nullptr /* frame */, header, SegmentCursor{}, 1, (uint8_t*)&result[i]);
+            } else {
+                auto cursor = compression.getCursor(header, i);
+                EXPECT_LT(cursor.pageIdxInSegment, numPages);
+                compression.decompressValues(getFrame(cursor.pageIdxInSegment), header, cursor,
+                    1, (uint8_t*)&result[i]);
+            }
+            if (!isNull || !isNull[i]) {
+                EXPECT_EQ(result[i], values[i]);
+            }
+        }
+        return numPages;
+    }
+
+    inline SegmentHeader getHeader() const {
+        SegmentHeader header;
+        memcpy(&header, segmentBuffer.get(), sizeof(SegmentHeader));
+        return header;
+    }
+    inline uint8_t* getFrame(page_idx_t pageIdxInSegment) const {
+        return segmentBuffer.get() + pageIdxInSegment * BufferPoolConstants::PAGE_4KB_SIZE;
+    }
+
+    std::unique_ptr<uint8_t[]> segmentBuffer;
+};
+
+TEST_F(ColumnCompressionTest, EqualValuesAreCompressedAsConstant) {
+    ColumnCompression compression{sizeof(int64_t)};
+    std::vector<int64_t> values(compression.getNumValuesPerSegment(), -42);
+    ASSERT_EQ(compressAndCheckValues(values, nullptr /* isNull */, CompressionType::CONSTANT), 1);
+}
+
+TEST_F(ColumnCompressionTest, SortedValuesAreBitPacked) {
+    ColumnCompression compression{sizeof(int64_t)};
+    std::vector<int64_t> values(compression.getNumValuesPerSegment());
+    for (auto i = 0u; i < values.size(); i++) {
+        values[i] = 1000000 + i;
+    }
+    // 4094 values take 12 bits each, which fit into 2 pages.
+    ASSERT_EQ(
+        compressAndCheckValues(values, nullptr /* isNull */, CompressionType::BIT_PACKING), 2);
+    ASSERT_EQ(getHeader().bitWidth, 12);
+    ASSERT_EQ(getHeader().reference, 1000000);
+}
+
+TEST_F(ColumnCompressionTest, NegativeValuesAreBitPacked) {
+    ColumnCompression compression{sizeof(int32_t)};
+    std::vector<int32_t> values(compression.getNumValuesPerSegment());
+    for (auto i = 0u; i < values.size(); i++) {
+        values[i] = (int32_t)(i % 7) - 3;
+    }
+    compressAndCheckValues(values, nullptr /* isNull */, CompressionType::BIT_PACKING);
+    ASSERT_EQ(getHeader().bitWidth, 3);
+    ASSERT_EQ(getHeader().reference, -3);
+}
+
+TEST_F(ColumnCompressionTest, ValuesOfFullRangeAreNotCompressed) {
+    ColumnCompression compression{sizeof(int16_t)};
+    std::vector<int16_t> values(compression.getNumValuesPerSegment());
+    for (auto i = 0u; i < values.size(); i++) {
+        values[i] = (int16_t)(i % 2 == 0 ? INT16_MIN : INT16_MAX);
+    }
+    ASSERT_EQ(compressAndCheckValues(values, nullptr /* isNull */, CompressionType::UNCOMPRESSED),
+        StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT);
+}
+
+TEST_F(ColumnCompressionTest, NullValuesAreIgnored) {
+    ColumnCompression compression{sizeof(int64_t)};
+    std::vector<int64_t> values(compression.getNumValuesPerSegment(), 7);
+    auto isNull = std::make_unique<bool[]>(values.size());
+    for (auto i = 0u; i < values.size(); i++) {
+        isNull[i] = i % 3 == 0;
+        if (isNull[i]) {
+            values[i] = INT64_MAX;
+        }
+    }
+    compressAndCheckValues(values, isNull.get(), CompressionType::CONSTANT);
+    values[1] = 8;
+    compressAndCheckValues(values, isNull.get(), CompressionType::BIT_PACKING);
+    ASSERT_EQ(getHeader().bitWidth, 1);
+}
+
+TEST_F(ColumnCompressionTest, ValuesWithinTheBitWidthAreUpdatedInPlace) {
+    ColumnCompression compression{sizeof(int64_t)};
+    std::vector<int64_t> values(compression.getNumValuesPerSegment());
+    for (auto i = 0u; i < values.size(); i++) {
+        values[i] = 100 + i % 16;
+    }
+    compressAndCheckValues(values, nullptr /* isNull */, CompressionType::BIT_PACKING);
+    auto header = getHeader();
+    int64_t valueToWrite = 115, valueRead;
+    ASSERT_TRUE(compression.canUpdateInPlace(header, (uint8_t*)&valueToWrite));
+    auto cursor = compression.getCursor(header, values.size() - 1);
+    compression.updateInPlace(
+        getFrame(cursor.pageIdxInSegment), header, cursor, (uint8_t*)&valueToWrite);
+    compression.decompressValues(
+        getFrame(cursor.pageIdxInSegment), header, cursor, 1, (uint8_t*)&valueRead);
+    ASSERT_EQ(valueRead, valueToWrite);
+    // Values below the reference or beyond the bit width don't fit into the segment.
+    valueToWrite = 99;
+    ASSERT_FALSE(compression.canUpdateInPlace(header, (uint8_t*)&valueToWrite));
+    valueToWrite = 116;
+    ASSERT_FALSE(compression.canUpdateInPlace(header, (uint8_t*)&valueToWrite));
+}
+
+TEST_F(ColumnCompressionTest, SegmentsSpanningChunksAreCompressedOnceCopied) {
+    auto directory = TestHelper::appendKuzuRootPath(std::string(TestHelper::TMP_TEST_DIR) +
+                                                    "column_compression_test" +
+                                                    TestHelper::getMillisecondsSuffix());
+    FileUtils::createDir(directory);
+    auto filePath = FileUtils::joinPath(directory, "column.col");
+    ColumnCompression compression{sizeof(int64_t)};
+    auto numValuesPerSegment = compression.getNumValuesPerSegment();
+    // The last of the 4 segments is half full. Chunks don't align with segments, so only the first
+    // segment is within a single chunk, and chunks are flushed in reverse order.
+    auto numValues = numValuesPerSegment * 7 / 2;
+    auto numValuesPerChunk = 5000u;
+    {
+        InMemColumn column{filePath, LogicalType{LogicalTypeID::INT64}};
+        auto numChunks = (numValues + numValuesPerChunk - 1) / numValuesPerChunk;
+        for (auto chunkIdx = numChunks; chunkIdx-- > 0;) {
+            auto startOffset = chunkIdx * numValuesPerChunk;
+            auto endOffset = std::min<offset_t>(startOffset + numValuesPerChunk, numValues) - 1;
+            auto chunk =
+                column.createInMemColumnChunk(startOffset, endOffset, nullptr /* copyDesc */);
+            for (auto offset = startOffset; offset <= endOffset; offset++) {
+                if (offset % 97 != 0) {
+                    int64_t value = 1000 + offset;
+                    chunk->setValueAtPos((uint8_t*)&value, offset - startOffset);
+                }
+            }
+            column.flushChunk(chunk.get());
+        }
+        column.saveToFile();
+    }
+    auto fileInfo = FileUtils::openFile(filePath, O_RDONLY);
+    auto segmentSize =
+        StorageConstants::NUM_PAGES_PER_COLUMN_SEGMENT * BufferPoolConstants::PAGE_4KB_SIZE;
+    ASSERT_EQ(fileInfo->getFileSize(), 4 * segmentSize);
+    for (auto segmentIdx = 0u; segmentIdx < 4; segmentIdx++) {
+        FileUtils::readFromFile(
+            fileInfo.get(), segmentBuffer.get(), segmentSize, segmentIdx * segmentSize);
+        auto header = getHeader();
+        ASSERT_EQ(header.compressionType, CompressionType::BIT_PACKING);
+        auto numValuesInSegment =
+            std::min(numValuesPerSegment, numValues - segmentIdx * numValuesPerSegment);
+        for (auto posInSegment = 0u; posInSegment < numValuesInSegment; posInSegment++) {
+            auto offset = segmentIdx * numValuesPerSegment + posInSegment;
+            if (offset % 97 == 0) {
+                continue;
+            }
+            int64_t value;
+            auto cursor = compression.getCursor(header, posInSegment);
+            compression.decompressValues(
+                getFrame(cursor.pageIdxInSegment), header, cursor, 1, (uint8_t*)&value);
+            ASSERT_EQ(value, 1000 + offset);
+        }
+    }
+    fileInfo.reset();
+    FileUtils::removeDir(directory);
+}
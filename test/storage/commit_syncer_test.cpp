@@ -0,0 +1,153 @@
+#include "common/metric.h"
+#include "graph_test/graph_test.h"
+#include "storage/wal/commit_syncer.h"
+
+using namespace kuzu::common;
+using namespace kuzu::main;
+using namespace kuzu::testing;
+using namespace kuzu::storage;
+
+class CommitSyncerTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        FileUtils::createDir(databasePath);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::WAL);
+    }
+
+    void TearDown() override {
+        EmptyDBTest::TearDown();
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::WAL);
+    }
+
+    std::string createFile(const std::string& fileName) {
+        auto filePath = FileUtils::joinPath(databasePath, fileName);
+        FileUtils::createFileWithSize(filePath, BufferPoolConstants::PAGE_4KB_SIZE);
+        return filePath;
+    }
+};
+
+TEST_F(CommitSyncerTest, SyncModeWaitsForTheRoundOfItsFiles) {
+    CommitSyncer commitSyncer{DurabilityMode::SYNC, 0 /* syncIntervalInMs */};
+    auto filePath = createFile("file1");
+    commitSyncer.sync({filePath, filePath});
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 1);
+    // Files that don't exist are skipped.
+    commitSyncer.sync({createFile("file2"), FileUtils::joinPath(databasePath, "removed")});
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 2);
+    commitSyncer.sync({});
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 2);
+}
+
+TEST_F(CommitSyncerTest, SyncModeThrowsIfSyncFails) {
+    CommitSyncer commitSyncer{DurabilityMode::SYNC, 0 /* syncIntervalInMs */};
+    // A directory can't be opened for writing.
+    ASSERT_THROW(commitSyncer.sync({databasePath}), StorageException);
+    commitSyncer.sync({createFile("file1")});
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 2);
+}
+
+TEST_F(CommitSyncerTest, RelaxedModeGroupsRequestsOfTheSyncInterval) {
+    CommitSyncer commitSyncer{DurabilityMode::RELAXED, 500 /* syncIntervalInMs */};
+    for (auto i = 0u; i < 10; i++) {
+        commitSyncer.sync({createFile("file" + std::to_string(i))});
+    }
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 0);
+    while (commitSyncer.getNumCompletedRounds() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 1);
+}
+
+TEST_F(CommitSyncerTest, RelaxedModeThrowsBackgroundFailuresInTheNextSync) {
+    CommitSyncer commitSyncer{DurabilityMode::RELAXED, 1 /* syncIntervalInMs */};
+    commitSyncer.sync({databasePath});
+    while (commitSyncer.getNumCompletedRounds() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_THROW(commitSyncer.sync({createFile("file1")}), StorageException);
+    // The failure is reported once.
+    commitSyncer.sync({createFile("file2")});
+}
+
+TEST_F(CommitSyncerTest, SyncAndWaitDoesNotWaitForTheSyncInterval) {
+    CommitSyncer commitSyncer{DurabilityMode::RELAXED, 60000 /* syncIntervalInMs */};
+    commitSyncer.sync({createFile("file1")});
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 0);
+    // The round also syncs the file of the earlier request.
+    commitSyncer.syncAndWait({createFile("file2")});
+    ASSERT_EQ(commitSyncer.getNumCompletedRounds(), 1);
+    ASSERT_THROW(commitSyncer.syncAndWait({databasePath}), StorageException);
+    // The failure is not thrown again by the next call.
+    commitSyncer.sync({createFile("file3")});
+}
+
+TEST_F(CommitSyncerTest, RelaxedDurabilityRequiresBackgroundCheckpointing) {
+    systemConfig->durabilityMode = DurabilityMode::RELAXED;
+    ASSERT_THROW(createDBAndConn(), RuntimeException);
+}
+
+TEST_F(CommitSyncerTest, RelaxedDurabilityCommitsReturnBeforeTheirFilesAreSynced) {
+    systemConfig->durabilityMode = DurabilityMode::RELAXED;
+    systemConfig->relaxedDurabilitySyncIntervalInMs = 60000;
+    systemConfig->enableBackgroundCheckpointing = true;
+    systemConfig->maxBackgroundCheckpointDelayInMs = 60000;
+    createDBAndConn();
+    auto commitSyncer = getCommitSyncer(*database);
+    ASSERT_TRUE(conn->query("CREATE NODE TABLE person(ID INT64, PRIMARY KEY(ID))")->isSuccess());
+    // Waits for the checkpoint of the table creation.
+    ASSERT_TRUE(conn->query("MATCH (p:person) RETURN COUNT(*)")->isSuccess());
+    auto numRounds = commitSyncer->getNumCompletedRounds();
+    auto readConn = std::make_unique<Connection>(database.get());
+    // readConn keeps the checkpoint waiting, and the commit doesn't wait for the checkpoint or
+    // the sync interval, so no round syncs the WAL or the checkpointed files before it returns.
+    readConn->beginReadOnlyTransaction();
+    ASSERT_TRUE(conn->query("CREATE (:person {ID: 7})")->isSuccess());
+    ASSERT_EQ(commitSyncer->getNumCompletedRounds(), numRounds);
+    ASSERT_FALSE(getWAL(*database)->isEmptyWAL());
+    readConn->commit();
+    // The checkpoint waits for the round that syncs its files before clearing the WAL.
+    auto result = conn->query("MATCH (p:person) RETURN p.ID");
+    ASSERT_TRUE(result->hasNext());
+    ASSERT_EQ(result->getNext()->getValue(0)->getValue<int64_t>(), 7);
+    ASSERT_EQ(commitSyncer->getNumCompletedRounds(), numRounds + 1);
+    ASSERT_TRUE(getWAL(*database)->isEmptyWAL());
+    readConn.reset();
+}
+
+TEST_F(CommitSyncerTest, RelaxedDurabilityCommitsAreSyncedOnClose) {
+    systemConfig->durabilityMode = DurabilityMode::RELAXED;
+    systemConfig->relaxedDurabilitySyncIntervalInMs = 60000;
+    systemConfig->enableBackgroundCheckpointing = true;
+    createDBAndConn();
+    ASSERT_TRUE(conn->query("CREATE NODE TABLE person(ID INT64, PRIMARY KEY(ID))")->isSuccess());
+    ASSERT_TRUE(conn->query("CREATE (:person {ID: 7})")->isSuccess());
+    auto commitLatencyHistogram = getCommitLatencyHistogram(*database);
+    ASSERT_EQ(commitLatencyHistogram->getNumRecorded(), 2);
+    ASSERT_GT(commitLatencyHistogram->getPercentileUpperBoundInMicros(100), 0);
+    // Closing the database syncs the committed files without waiting for the sync interval.
+    createDBAndConn();
+    auto result = conn->query("MATCH (p:person) RETURN p.ID");
+    ASSERT_TRUE(result->hasNext());
+    ASSERT_EQ(result->getNext()->getValue(0)->getValue<int64_t>(), 7);
+}
+
+TEST(LatencyHistogramTest, PercentilesAreBucketUpperBounds) {
+    LatencyHistogram histogram;
+    ASSERT_EQ(histogram.getPercentileUpperBoundInMicros(50), 0);
+    histogram.record(0);
+    for (auto i = 0u; i < 98; i++) {
+        histogram.record(100);
+    }
+    histogram.record(5000);
+    ASSERT_EQ(histogram.getNumRecorded(), 100);
+    ASSERT_EQ(histogram.getBucketCount(0), 1);
+    ASSERT_EQ(histogram.getBucketCount(7), 98);
+    ASSERT_EQ(histogram.getPercentileUpperBoundInMicros(0), 1);
+    ASSERT_EQ(histogram.getPercentileUpperBoundInMicros(50), 128);
+    ASSERT_EQ(histogram.getPercentileUpperBoundInMicros(99), 128);
+    ASSERT_EQ(histogram.getPercentileUpperBoundInMicros(100), 8192);
+    histogram.record(UINT64_MAX);
+    ASSERT_EQ(histogram.getBucketCount(LatencyHistogram::NUM_BUCKETS - 1), 1);
+}
@@ -0,0 +1,155 @@
+#include "graph_test/graph_test.h"
+#include "storage/storage_manager.h"
+
+using namespace kuzu::common;
+using namespace kuzu::storage;
+using namespace kuzu::testing;
+
+// The ID column of person is an INT64 column, so it is compressed. Its 10K values (ID = node
+// offset) take the first 3 segments, and are bit-packed with 12 bits per value.
+class CompressedColumnUpdateTest : public DBTest {
+
+public:
+    void SetUp() override {
+        DBTest::SetUp();
+        initDBAndConnection();
+    }
+
+    std::string getInputDir() override {
+        return TestHelper::appendKuzuRootPath("dataset/node-insertion-deletion-tests/int64-pk/");
+    }
+
+    void initDBAndConnection() {
+        createDBAndConn();
+        readConn = std::make_unique<Connection>(database.get());
+        auto personTableID = getCatalog(*database)->getReadOnlyVersion()->getTableID("person");
+        personNodeTable = getStorageManager(*database)->getNodesStore().getNodeTable(personTableID);
+        auto idPropertyID = getCatalog(*database)
+                                ->getReadOnlyVersion()
+                                ->getNodeProperty(personTableID, "ID")
+                                .propertyID;
+        idColumn = getStorageManager(*database)->getNodesStore().getNodePropertyColumn(
+            personTableID, idPropertyID);
+        conn->beginWriteTransaction();
+    }
+
+    void commitOrRollbackConnectionAndInitDBIfNecessary(
+        bool isCommit, TransactionTestType transactionTestType) {
+        commitOrRollbackConnection(isCommit, transactionTestType);
+        if (transactionTestType == TransactionTestType::RECOVERY) {
+            // This creates a new database/conn/readConn and should run the recovery algorithm.
+            initDBAndConnection();
+        }
+    }
+
+    void writeID(offset_t nodeOffset, int64_t id) {
+        auto dataChunk = std::make_shared<DataChunk>(2);
+        dataChunk->state->currIdx = 0;
+        auto nodeIDVector =
+            std::make_shared<ValueVector>(LogicalTypeID::INTERNAL_ID, getMemoryManager(*database));
+        dataChunk->insert(0, nodeIDVector);
+        auto idVector =
+            std::make_shared<ValueVector>(LogicalTypeID::INT64, getMemoryManager(*database));
+        dataChunk->insert(1, idVector);
+        nodeIDVector->setValue<nodeID_t>(0, nodeID_t{nodeOffset, personNodeTable->getTableID()});
+        idVector->setValue<int64_t>(0, id);
+        idColumn->write(nodeIDVector.get(), idVector.get());
+    }
+
+    offset_t addNodeWithID(int64_t id) {
+        auto nodeOffset = personNodeTable->getNodeStatisticsAndDeletedIDs()->addNode(
+            personNodeTable->getTableID());
+        writeID(nodeOffset, id);
+        return nodeOffset;
+    }
+
+    static int64_t sumOfIDs(Connection& connection) {
+        auto result = connection.query("MATCH (a:person) RETURN sum(a.ID)");
+        return result->getNext()->getValue(0)->getValue<int64_t>();
+    }
+
+    static int64_t countID(Connection& connection, int64_t id) {
+        auto result = connection.query(
+            "MATCH (a:person) WHERE a.ID = " + std::to_string(id) + " RETURN count(*)");
+        return result->getNext()->getValue(0)->getValue<int64_t>();
+    }
+
+    // Writes values within and beyond the bit width of the second segment, and checks that the
+    // write transaction reads them through the WAL while the read transaction does not.
+    void updateSegment(bool isCommit, TransactionTestType transactionTestType) {
+        auto originalSum = sumOfIDs(*conn);
+        writeID(5000, 5001 /* within the bit width */);
+        writeID(6000, -(1ll << 40) /* beyond the bit width */);
+        writeID(6001, 1ll << 40);
+        auto updatedSum = originalSum - 5000 + 5001 - 6000 - 6001;
+        ASSERT_EQ(sumOfIDs(*conn), updatedSum);
+        ASSERT_EQ(sumOfIDs(*readConn), originalSum);
+        // Recompressing the segment keeps the other values of the segment.
+        ASSERT_EQ(countID(*conn, 5001), 2);
+        ASSERT_EQ(countID(*conn, 1ll << 40), 1);
+        ASSERT_EQ(countID(*conn, 4094), 1);
+        ASSERT_EQ(countID(*conn, 8187), 1);
+        commitOrRollbackConnectionAndInitDBIfNecessary(isCommit, transactionTestType);
+        auto expectedSum = isCommit ? updatedSum : originalSum;
+        ASSERT_EQ(sumOfIDs(*conn), expectedSum);
+        ASSERT_EQ(sumOfIDs(*readConn), expectedSum);
+        ASSERT_EQ(countID(*readConn, -(1ll << 40)), isCommit ? 1 : 0);
+        ASSERT_EQ(countID(*readConn, 6000), isCommit ? 0 : 1);
+    }
+
+    // Adds nodes past the last segment, so new segments are appended to the column.
+    void addSegments(bool isCommit, TransactionTestType transactionTestType) {
+        auto originalSum = sumOfIDs(*conn);
+        auto numNodesToAdd = 5000u;
+        auto updatedSum = originalSum;
+        for (auto i = 0u; i < numNodesToAdd; i++) {
+            auto nodeOffset = addNodeWithID(-(int64_t)i);
+            ASSERT_EQ(nodeOffset, 10000 + i);
+            updatedSum -= i;
+        }
+        ASSERT_EQ(sumOfIDs(*conn), updatedSum);
+        ASSERT_EQ(sumOfIDs(*readConn), originalSum);
+        commitOrRollbackConnectionAndInitDBIfNecessary(isCommit, transactionTestType);
+        auto expectedSum = isCommit ? updatedSum : originalSum;
+        ASSERT_EQ(sumOfIDs(*conn), expectedSum);
+        ASSERT_EQ(sumOfIDs(*readConn), expectedSum);
+        ASSERT_EQ(countID(*readConn, -4999), isCommit ? 1 : 0);
+    }
+
+public:
+    std::unique_ptr<Connection> readConn;
+    NodeTable* personNodeTable;
+    Column* idColumn;
+};
+
+TEST_F(CompressedColumnUpdateTest, UpdateSegmentCommitNormalExecution) {
+    updateSegment(true /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CompressedColumnUpdateTest, UpdateSegmentCommitRecovery) {
+    updateSegment(true /* isCommit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CompressedColumnUpdateTest, UpdateSegmentRollbackNormalExecution) {
+    updateSegment(false /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CompressedColumnUpdateTest, UpdateSegmentRollbackRecovery) {
+    updateSegment(false /* isCommit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CompressedColumnUpdateTest, AddSegmentsCommitNormalExecution) {
+    addSegments(true /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CompressedColumnUpdateTest, AddSegmentsCommitRecovery) {
+    addSegments(true /* isCommit */, TransactionTestType::RECOVERY);
+}
+
+TEST_F(CompressedColumnUpdateTest, AddSegmentsRollbackNormalExecution) {
+    addSegments(false /* isCommit */, TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(CompressedColumnUpdateTest, AddSegmentsRollbackRecovery) {
+    addSegments(false /* isCommit */, TransactionTestType::RECOVERY);
+}
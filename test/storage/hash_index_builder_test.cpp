@@ -0,0 +1,278 @@
+#include <thread>
+
+#include "graph_test/graph_test.h"
+#include "storage/buffer_manager/memory_manager.h"
+#include "storage/index/hash_index.h"
+#include "storage/index/hash_index_builder.h"
+
+using namespace kuzu::common;
+using namespace kuzu::testing;
+using namespace kuzu::storage;
+
+class HashIndexBuilderTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        FileUtils::createDir(databasePath);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::WAL);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::STORAGE);
+        bufferManager = std::make_unique<BufferManager>(
+            BufferPoolConstants::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+        memoryManager = std::make_unique<MemoryManager>(bufferManager.get());
+        wal = std::make_unique<WAL>(databasePath, *bufferManager);
+    }
+
+    void TearDown() override {
+        wal.reset();
+        memoryManager.reset();
+        bufferManager.reset();
+        EmptyDBTest::TearDown();
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::WAL);
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::STORAGE);
+    }
+
+    static std::string getStringKey(uint64_t i) {
+        // Every other key is longer than a short string, so it is stored in the overflow file.
+        return i % 2 == 0 ? std::to_string(i) : "a long string key " + std::to_string(i);
+    }
+
+    // Each thread appends its range of keys in batches.
+    void buildIndex(LogicalTypeID keyTypeID, const std::vector<std::string>& stringKeys,
+        const std::vector<int64_t>& int64Keys, uint64_t numKeys) {
+        PrimaryKeyIndexBuilder indexBuilder{getIndexFName(), LogicalType{keyTypeID}};
+        indexBuilder.bulkReserve(numKeys);
+        std::vector<std::thread> threads;
+        auto numKeysPerThread = numKeys / NUM_THREADS;
+        for (auto threadIdx = 0u; threadIdx < NUM_THREADS; threadIdx++) {
+            threads.emplace_back([&, threadIdx] {
+                auto endPos = std::min((threadIdx + 1) * numKeysPerThread, numKeys);
+                if (threadIdx == NUM_THREADS - 1) {
+                    endPos = numKeys;
+                }
+                for (auto startPos = threadIdx * numKeysPerThread; startPos < endPos;
+                     startPos += BATCH_SIZE) {
+                    auto numKeysInBatch = std::min(BATCH_SIZE, endPos - startPos);
+                    std::vector<const uint8_t*> keys(numKeysInBatch);
+                    for (auto i = 0u; i < numKeysInBatch; i++) {
+                        keys[i] = keyTypeID == LogicalTypeID::INT64 ?
+                                      (const uint8_t*)&int64Keys[startPos + i] :
+                                      (const uint8_t*)stringKeys[startPos + i].c_str();
+                    }
+                    ASSERT_EQ(indexBuilder.append(keys, startPos), numKeysInBatch);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        indexBuilder.flush();
+    }
+
+    std::unique_ptr<PrimaryKeyIndex> openIndex(LogicalTypeID keyTypeID) {
+        return std::make_unique<PrimaryKeyIndex>(
+            StorageUtils::getNodeIndexIDAndFName(databasePath, TABLE_ID), LogicalType{keyTypeID},
+            *bufferManager, wal.get());
+    }
+
+    // Keys [0, NUM_KEYS) are built into the index and keys [NUM_KEYS, 2 * NUM_KEYS) are only
+    // inserted by write transactions.
+    void initKeys(LogicalTypeID keyTypeID) {
+        for (auto i = 0u; i < 2 * NUM_KEYS; i++) {
+            if (keyTypeID == LogicalTypeID::INT64) {
+                int64Keys.push_back((int64_t)i * 7 - 1000);
+            } else {
+                stringKeys.push_back(getStringKey(i));
+            }
+        }
+    }
+
+    void setKey(ValueVector& keyVector, uint32_t pos, uint64_t keyIdx) {
+        if (keyVector.dataType.getLogicalTypeID() == LogicalTypeID::INT64) {
+            keyVector.setValue<int64_t>(pos, int64Keys[keyIdx]);
+        } else {
+            StringVector::addString(
+                &keyVector, pos, stringKeys[keyIdx].c_str(), stringKeys[keyIdx].length());
+        }
+    }
+
+    // Each group of 4 keys of the index has a deleted key, a deleted and reinserted key, a key
+    // with a new local key and a key with a new local key that is deleted again. Batches of both
+    // built and new keys are then looked up by the write transaction, so their results merge the
+    // local storage and the persistent index.
+    void checkBatchedLookupsInWriteTransaction(LogicalTypeID keyTypeID) {
+        initKeys(keyTypeID);
+        buildIndex(keyTypeID, stringKeys, int64Keys, NUM_KEYS);
+        auto index = openIndex(keyTypeID);
+        auto keyVector =
+            std::make_shared<ValueVector>(LogicalType{keyTypeID}, memoryManager.get());
+        keyVector->state = DataChunkState::getSingleValueDataChunkState();
+        for (auto i = 0u; i < NUM_KEYS; i++) {
+            setKey(*keyVector, 0 /* pos */, i % 4 < 2 ? i : NUM_KEYS + i);
+            switch (i % 4) {
+            case 0: {
+                index->deleteKey(keyVector.get(), 0 /* pos */);
+            } break;
+            case 1: {
+                index->deleteKey(keyVector.get(), 0 /* pos */);
+                ASSERT_TRUE(index->insert(keyVector.get(), 0 /* pos */, 3 * NUM_KEYS + i));
+            } break;
+            case 2: {
+                ASSERT_TRUE(index->insert(keyVector.get(), 0 /* pos */, 3 * NUM_KEYS + i));
+            } break;
+            default: {
+                ASSERT_TRUE(index->insert(keyVector.get(), 0 /* pos */, 3 * NUM_KEYS + i));
+                index->deleteKey(keyVector.get(), 0 /* pos */);
+            }
+            }
+            keyVector->resetAuxiliaryBuffer();
+        }
+        keyVector->state = std::make_shared<DataChunkState>();
+        kuzu::transaction::Transaction writeTransaction{
+            kuzu::transaction::TransactionType::WRITE, 1 /* transactionID */};
+        std::vector<offset_t> results(DEFAULT_VECTOR_CAPACITY);
+        for (auto startKeyIdx = 0u; startKeyIdx < 2 * NUM_KEYS;
+             startKeyIdx += DEFAULT_VECTOR_CAPACITY) {
+            auto numKeysInBatch = std::min(DEFAULT_VECTOR_CAPACITY, 2 * NUM_KEYS - startKeyIdx);
+            for (auto pos = 0u; pos < numKeysInBatch; pos++) {
+                setKey(*keyVector, pos, startKeyIdx + pos);
+            }
+            keyVector->state->selVector->selectedSize = numKeysInBatch;
+            auto numKeysFound = index->lookup(&writeTransaction, keyVector.get(), results.data());
+            auto expectedNumKeysFound = 0u;
+            for (auto pos = 0u; pos < numKeysInBatch; pos++) {
+                auto expectedResult = getExpectedResult(startKeyIdx + pos);
+                ASSERT_EQ(results[pos], expectedResult);
+                expectedNumKeysFound += expectedResult != INVALID_OFFSET;
+            }
+            ASSERT_EQ(numKeysFound, expectedNumKeysFound);
+            keyVector->resetAuxiliaryBuffer();
+        }
+        // Read transactions don't see the local changes.
+        offset_t result;
+        setKey(*keyVector, 0 /* pos */, 0 /* keyIdx */);
+        ASSERT_TRUE(index->lookup(
+            &kuzu::transaction::DUMMY_READ_TRANSACTION, keyVector.get(), 0 /* pos */, result));
+        ASSERT_EQ(result, 0);
+    }
+
+    static offset_t getExpectedResult(uint64_t keyIdx) {
+        auto i = keyIdx % NUM_KEYS;
+        if (keyIdx < NUM_KEYS) {
+            return i % 4 == 0 ? INVALID_OFFSET : (i % 4 == 1 ? 3 * NUM_KEYS + i : i);
+        }
+        return i % 4 == 2 ? 3 * NUM_KEYS + i : INVALID_OFFSET;
+    }
+
+    inline std::string getIndexFName() const {
+        return StorageUtils::getNodeIndexFName(databasePath, TABLE_ID, DBFileType::ORIGINAL);
+    }
+
+public:
+    static constexpr table_id_t TABLE_ID = 0;
+    static constexpr uint64_t NUM_THREADS = 4;
+    static constexpr uint64_t BATCH_SIZE = 2048;
+    // Large enough for multiple partitions and overflow slots.
+    static constexpr uint64_t NUM_KEYS = 100000;
+    std::unique_ptr<BufferManager> bufferManager;
+    std::unique_ptr<MemoryManager> memoryManager;
+    std::unique_ptr<WAL> wal;
+    std::vector<std::string> stringKeys;
+    std::vector<int64_t> int64Keys;
+};
+
+TEST_F(HashIndexBuilderTest, ParallelAppendsOfInt64Keys) {
+    std::vector<int64_t> keys(NUM_KEYS);
+    for (auto i = 0u; i < NUM_KEYS; i++) {
+        keys[i] = (int64_t)i * 7 - 1000;
+    }
+    buildIndex(LogicalTypeID::INT64, {}, keys, NUM_KEYS);
+    auto index = openIndex(LogicalTypeID::INT64);
+    offset_t result;
+    for (auto i = 0u; i < NUM_KEYS; i++) {
+        ASSERT_TRUE(index->lookup(&kuzu::transaction::DUMMY_READ_TRANSACTION, keys[i], result));
+        ASSERT_EQ(result, i);
+    }
+    ASSERT_FALSE(index->lookup(&kuzu::transaction::DUMMY_READ_TRANSACTION, (int64_t)1, result));
+}
+
+TEST_F(HashIndexBuilderTest, ParallelAppendsOfStringKeys) {
+    std::vector<std::string> keys(NUM_KEYS);
+    for (auto i = 0u; i < NUM_KEYS; i++) {
+        keys[i] = getStringKey(i);
+    }
+    buildIndex(LogicalTypeID::STRING, keys, {}, NUM_KEYS);
+    auto index = openIndex(LogicalTypeID::STRING);
+    offset_t result;
+    for (auto i = 0u; i < NUM_KEYS; i++) {
+        ASSERT_TRUE(
+            index->lookup(&kuzu::transaction::DUMMY_READ_TRANSACTION, keys[i].c_str(), result));
+        ASSERT_EQ(result, i);
+    }
+    ASSERT_FALSE(index->lookup(&kuzu::transaction::DUMMY_READ_TRANSACTION,
+        getStringKey(NUM_KEYS + 1).c_str(), result));
+}
+
+TEST_F(HashIndexBuilderTest, AppendReturnsTheFirstDuplicatedKey) {
+    HashIndexBuilder<int64_t> indexBuilder{getIndexFName(), LogicalType{LogicalTypeID::INT64}};
+    indexBuilder.bulkReserve(NUM_KEYS);
+    std::vector<int64_t> keys{1, 2, 3, 4, 5};
+    std::vector<const uint8_t*> keyPtrs;
+    for (auto& key : keys) {
+        keyPtrs.push_back((const uint8_t*)&key);
+    }
+    ASSERT_EQ(indexBuilder.append(keyPtrs, 0 /* startValue */), 5);
+    std::vector<int64_t> nextKeys{6, 7, 3, 8, 7};
+    keyPtrs.clear();
+    for (auto& key : nextKeys) {
+        keyPtrs.push_back((const uint8_t*)&key);
+    }
+    ASSERT_EQ(indexBuilder.append(keyPtrs, 5 /* startValue */), 2);
+    offset_t result;
+    ASSERT_TRUE(indexBuilder.lookup(6, result));
+    ASSERT_EQ(result, 5);
+    ASSERT_TRUE(indexBuilder.lookup(3, result));
+    ASSERT_EQ(result, 2);
+}
+
+TEST_F(HashIndexBuilderTest, BatchedLookupsOfStringKeys) {
+    std::vector<std::string> keys(NUM_KEYS);
+    for (auto i = 0u; i < NUM_KEYS; i++) {
+        keys[i] = getStringKey(i);
+    }
+    buildIndex(LogicalTypeID::STRING, keys, {}, NUM_KEYS);
+    auto index = openIndex(LogicalTypeID::STRING);
+    // Every third key of the batch doesn't exist in the index.
+    std::vector<std::string> keysToLookup;
+    for (auto i = 0u; i < NUM_KEYS; i += 7) {
+        keysToLookup.push_back(i % 3 == 0 ? getStringKey(NUM_KEYS + i) : keys[i]);
+    }
+    std::vector<const uint8_t*> keyPtrs;
+    for (auto& key : keysToLookup) {
+        keyPtrs.push_back((const uint8_t*)key.c_str());
+    }
+    std::vector<offset_t> results(keyPtrs.size());
+    auto numKeysFound = index->lookup(
+        &kuzu::transaction::DUMMY_READ_TRANSACTION, keyPtrs, results.data());
+    auto expectedNumKeysFound = 0u;
+    for (auto i = 0u; i < keysToLookup.size(); i++) {
+        auto keyIdx = i * 7;
+        if (keyIdx % 3 == 0) {
+            ASSERT_EQ(results[i], INVALID_OFFSET);
+        } else {
+            ASSERT_EQ(results[i], keyIdx);
+            expectedNumKeysFound++;
+        }
+    }
+    ASSERT_EQ(numKeysFound, expectedNumKeysFound);
+}
+
+TEST_F(HashIndexBuilderTest, BatchedLookupsOfInt64KeysInWriteTransaction) {
+    checkBatchedLookupsInWriteTransaction(LogicalTypeID::INT64);
+}
+
+TEST_F(HashIndexBuilderTest, BatchedLookupsOfStringKeysInWriteTransaction) {
+    checkBatchedLookupsInWriteTransaction(LogicalTypeID::STRING);
+}
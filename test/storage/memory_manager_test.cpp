@@ -0,0 +1,106 @@
+#include "graph_test/graph_test.h"
+#include "storage/buffer_manager/buffer_manager.h"
+#include "storage/buffer_manager/memory_manager.h"
+#include "storage/storage_utils.h"
+
+using namespace kuzu::common;
+using namespace kuzu::testing;
+using namespace kuzu::storage;
+
+class MemoryManagerTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        FileUtils::createDir(databasePath);
+        LoggerUtils::createLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+        bufferManager =
+            std::make_unique<BufferManager>(NUM_FRAMES * BufferPoolConstants::PAGE_256KB_SIZE);
+    }
+
+    void TearDown() override {
+        memoryManager.reset();
+        bufferManager.reset();
+        EmptyDBTest::TearDown();
+        LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+    }
+
+    std::vector<std::unique_ptr<MemoryBuffer>> allocateAndUnpinBuffers() {
+        std::vector<std::unique_ptr<MemoryBuffer>> buffers;
+        for (auto i = 0u; i < NUM_FRAMES; i++) {
+            auto buffer = memoryManager->allocateBuffer();
+            memset(buffer->buffer, i + 1, BufferPoolConstants::PAGE_256KB_SIZE);
+            buffer->unpin();
+            buffers.push_back(std::move(buffer));
+        }
+        // Pinning as many new buffers as the buffer pool can hold forces all unpinned buffers out
+        // of memory.
+        std::vector<std::unique_ptr<MemoryBuffer>> pinnedBuffers;
+        for (auto i = 0u; i < NUM_FRAMES; i++) {
+            pinnedBuffers.push_back(memoryManager->allocateBuffer());
+        }
+        return buffers;
+    }
+
+public:
+    static constexpr uint64_t NUM_FRAMES = 8;
+    std::unique_ptr<BufferManager> bufferManager;
+    std::unique_ptr<MemoryManager> memoryManager;
+};
+
+TEST_F(MemoryManagerTest, UnpinnedBuffersAreSpilledAndRestored) {
+    memoryManager = std::make_unique<MemoryManager>(bufferManager.get(), databasePath);
+    ASSERT_TRUE(memoryManager->canSpill());
+    auto spillFilePath = memoryManager->getSpillFilePath();
+    ASSERT_TRUE(FileUtils::fileOrPathExists(spillFilePath));
+    auto buffers = allocateAndUnpinBuffers();
+    auto numBytesRead = 0u;
+    std::vector<uint8_t> expectedContent(BufferPoolConstants::PAGE_256KB_SIZE);
+    for (auto i = 0u; i < NUM_FRAMES; i++) {
+        ASSERT_FALSE(buffers[i]->isPinned());
+        numBytesRead += buffers[i]->pin();
+        ASSERT_TRUE(buffers[i]->isPinned());
+        memset(expectedContent.data(), i + 1, BufferPoolConstants::PAGE_256KB_SIZE);
+        ASSERT_EQ(memcmp(buffers[i]->buffer, expectedContent.data(),
+                      BufferPoolConstants::PAGE_256KB_SIZE),
+            0);
+    }
+    ASSERT_EQ(numBytesRead, NUM_FRAMES * BufferPoolConstants::PAGE_256KB_SIZE);
+    // Freeing an unpinned buffer must make its page reusable.
+    buffers[0]->unpin();
+    buffers.clear();
+    ASSERT_NE(memoryManager->allocateBuffer(), nullptr);
+    memoryManager.reset();
+    ASSERT_FALSE(FileUtils::fileOrPathExists(spillFilePath));
+}
+
+TEST_F(MemoryManagerTest, BuffersOfInMemMemoryManagerAreNotUnpinned) {
+    memoryManager = std::make_unique<MemoryManager>(bufferManager.get());
+    ASSERT_FALSE(memoryManager->canSpill());
+    auto buffer = memoryManager->allocateBuffer();
+    buffer->unpin();
+    ASSERT_TRUE(buffer->isPinned());
+    ASSERT_EQ(buffer->pin(), 0);
+}
+
+TEST_F(MemoryManagerTest, MemoryManagersSharingADirectoryUseDifferentSpillFiles) {
+    // A file left in the directory by another database must not be reused or removed.
+    auto otherFilePath = StorageUtils::getSpillFilePath(databasePath, 0 /* spillFileID */);
+    FileUtils::createFileWithSize(otherFilePath, BufferPoolConstants::PAGE_256KB_SIZE);
+    memoryManager = std::make_unique<MemoryManager>(bufferManager.get(), databasePath);
+    auto otherMemoryManager = std::make_unique<MemoryManager>(bufferManager.get(), databasePath);
+    auto spillFilePath = memoryManager->getSpillFilePath();
+    ASSERT_NE(spillFilePath, otherMemoryManager->getSpillFilePath());
+    ASSERT_NE(spillFilePath, otherFilePath);
+    auto buffers = allocateAndUnpinBuffers();
+    otherMemoryManager.reset();
+    for (auto& buffer : buffers) {
+        buffer->pin();
+    }
+    buffers.clear();
+    memoryManager.reset();
+    ASSERT_FALSE(FileUtils::fileOrPathExists(spillFilePath));
+    ASSERT_TRUE(FileUtils::fileOrPathExists(otherFilePath));
+    ASSERT_EQ(FileUtils::openFile(otherFilePath, O_RDONLY)->getFileSize(),
+        BufferPoolConstants::PAGE_256KB_SIZE);
+}
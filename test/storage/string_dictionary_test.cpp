@@ -0,0 +1,65 @@
+#include "function/hash/hash_functions.h"
+#include "graph_test/graph_test.h"
+#include "storage/storage_structure/string_dictionary.h"
+
+using namespace kuzu::common;
+using namespace kuzu::testing;
+using namespace kuzu::storage;
+
+class StringDictionaryTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        FileUtils::createDir(databasePath);
+    }
+
+public:
+    static void checkEntries(
+        const StringDictionary& dictionary, const std::vector<std::string>& values) {
+        ASSERT_EQ(dictionary.getNumEntries(), values.size());
+        for (auto code = 0u; code < values.size(); code++) {
+            auto& entry = dictionary.getEntry(code);
+            ASSERT_EQ(entry.getAsString(), values[code]);
+            ASSERT_EQ(dictionary.getCode(entry), code);
+            kuzu::common::hash_t hash;
+            kuzu::function::Hash::operation(entry, hash);
+            ASSERT_EQ(dictionary.getHash(code), hash);
+        }
+    }
+};
+
+TEST_F(StringDictionaryTest, CodesAreAssignedInOrderOfFirstAppearance) {
+    StringDictionaryBuilder builder;
+    std::vector<uint32_t> codes;
+    ASSERT_TRUE(builder.encode({"Germany", "a country with a long name"}, codes));
+    ASSERT_EQ(codes, (std::vector<uint32_t>{0, 1}));
+    ASSERT_TRUE(builder.encode({"Canada", "Germany"}, codes));
+    ASSERT_EQ(codes, (std::vector<uint32_t>{2, 0}));
+    auto dictionary = builder.finalize();
+    checkEntries(*dictionary, {"Germany", "a country with a long name", "Canada"});
+    ASSERT_EQ(dictionary->getCode("France"), StringDictionary::INVALID_CODE);
+}
+
+TEST_F(StringDictionaryTest, DictionaryIsAbandonedAboveMaxNumEntries) {
+    StringDictionaryBuilder builder;
+    std::vector<std::string> values;
+    for (auto i = 0u; i <= StorageConstants::MAX_NUM_STRING_DICTIONARY_ENTRIES; i++) {
+        values.push_back(std::to_string(i));
+    }
+    std::vector<std::string_view> distinctValues{values.begin(), values.end()};
+    std::vector<uint32_t> codes;
+    ASSERT_FALSE(builder.encode(distinctValues, codes));
+    ASSERT_TRUE(builder.isAbandoned());
+    ASSERT_FALSE(builder.encode({"0"}, codes));
+    ASSERT_EQ(builder.finalize(), nullptr);
+}
+
+TEST_F(StringDictionaryTest, DictionaryIsSavedAndLoaded) {
+    std::vector<std::string> values{"", "short", "exactly 13 ch", "a value longer than the SSO"};
+    StringDictionary dictionary{values};
+    auto fName = databasePath + "/test_file.dict";
+    dictionary.saveToFile(fName);
+    auto loadedDictionary = StringDictionary::loadFromFile(fName);
+    checkEntries(*loadedDictionary, values);
+}
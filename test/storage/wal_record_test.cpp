@@ -98,3 +98,18 @@ TEST_F(WALRecordTest, MultipleRecordWritingTest) {
     readBackWALRecordAndAssert(expectedWALRecord2, offset);
     readBackWALRecordAndAssert(expectedWALRecord3, offset);
 }
+
+TEST_F(WALRecordTest, DictionaryCodesPageUpdateRecordTest) {
+    auto columnID =
+        StorageStructureID::newNodePropertyColumnID(4 /* tableID */, 2 /* propertyID */);
+    auto codesColumnID = columnID;
+    codesColumnID.isDictionaryCodes = true;
+    // Pages of the codes column are not pages of the string column they encode.
+    ASSERT_FALSE(codesColumnID == columnID);
+    WALRecord expectedWALRecord = WALRecord::newPageUpdateRecord(
+        codesColumnID, 12 /* pageIdxInOriginalFile */, 3 /* pageIdxInWAL */);
+    writeExpectedWALRecordReadBackAndAssert(expectedWALRecord);
+    ASSERT_FALSE(expectedWALRecord ==
+                 WALRecord::newPageUpdateRecord(columnID, 12 /* pageIdxInOriginalFile */,
+                     3 /* pageIdxInWAL */));
+}
@@ -1,4 +1,5 @@
 #include "graph_test/graph_test.h"
+#include "processor/processor.h"
 #include "storage/wal_replayer.h"
 
 using namespace kuzu::common;
@@ -14,10 +15,37 @@ class WALReplayerTests : public DBTest {
 TEST_F(WALReplayerTests, ReplayingUncommittedWALForChekpointErrors) {
     WALReplayer walReplayer(getWAL(*database), getStorageManager(*database),
         getMemoryManager(*database), getBufferManager(*database), getCatalog(*database),
-        WALReplayMode::COMMIT_CHECKPOINT);
+        WALReplayMode::COMMIT_CHECKPOINT, *getQueryProcessor(*database)->getTaskScheduler());
     try {
         walReplayer.replay();
         FAIL();
     } catch (StorageException& e) {
     } catch (Exception& e) { FAIL(); }
 }
+
+TEST_F(WALReplayerTests, RecoveryReplaysTheLastUpdateOfThePagesOfEachFile) {
+    conn->beginWriteTransaction();
+    for (auto age : {10, 20, 30}) {
+        ASSERT_TRUE(
+            conn->query("MATCH (a:person) SET a.age = " + std::to_string(age))->isSuccess());
+    }
+    ASSERT_TRUE(
+        conn->query("MATCH (a:person) SET a.fName = 'A name that is stored in the overflow file'")
+            ->isSuccess());
+    ASSERT_TRUE(conn->query("MATCH (a:organisation) SET a.score = 7")->isSuccess());
+    commitButSkipCheckpointingForTestingRecovery(*conn);
+    createDBAndConn();
+    auto result = conn->query("MATCH (a:person) RETURN a.age, a.fName");
+    ASSERT_EQ(result->getNumTuples(), 8);
+    while (result->hasNext()) {
+        auto tuple = result->getNext();
+        ASSERT_EQ(tuple->getValue(0)->getValue<int64_t>(), 30);
+        ASSERT_EQ(tuple->getValue(1)->getValue<std::string>(),
+            "A name that is stored in the overflow file");
+    }
+    result = conn->query("MATCH (a:organisation) RETURN a.score");
+    ASSERT_EQ(result->getNumTuples(), 3);
+    while (result->hasNext()) {
+        ASSERT_EQ(result->getNext()->getValue(0)->getValue<int64_t>(), 7);
+    }
+}
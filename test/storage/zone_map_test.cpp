@@ -0,0 +1,130 @@
+#include <cmath>
+
+#include "graph_test/graph_test.h"
+#include "storage/storage_structure/zone_map.h"
+
+using namespace kuzu::common;
+using namespace kuzu::testing;
+using namespace kuzu::storage;
+
+class ZoneMapTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        FileUtils::createDir(databasePath);
+    }
+
+public:
+    static ZoneMapPredicate intPredicate(ExpressionType comparisonType, int64_t value) {
+        ZoneMapValue zoneMapValue;
+        zoneMapValue.int64Val = value;
+        return ZoneMapPredicate{comparisonType, zoneMapValue};
+    }
+
+    static ZoneMapPredicate doublePredicate(ExpressionType comparisonType, double value) {
+        ZoneMapValue zoneMapValue;
+        zoneMapValue.doubleVal = value;
+        return ZoneMapPredicate{comparisonType, zoneMapValue};
+    }
+
+    // The first zone has the values [100, 100 + NUM_VALUES_PER_ZONE) and the second zone has the
+    // values [1000, 1010), followed by nulls.
+    static void addValues(ZoneMap& zoneMap) {
+        std::vector<int64_t> values(ZoneMap::NUM_VALUES_PER_ZONE + 20);
+        std::unique_ptr<bool[]> isNull{new bool[values.size()]()};
+        for (auto i = 0u; i < ZoneMap::NUM_VALUES_PER_ZONE; i++) {
+            values[i] = 100 + i;
+        }
+        for (auto i = 0u; i < 20; i++) {
+            values[ZoneMap::NUM_VALUES_PER_ZONE + i] = 1000 + i;
+            isNull[ZoneMap::NUM_VALUES_PER_ZONE + i] = i >= 10;
+        }
+        // Chunks are not aligned with zones.
+        zoneMap.addValues(0, (uint8_t*)values.data(), isNull.get(), 1000);
+        zoneMap.addValues(1000, (uint8_t*)(values.data() + 1000), isNull.get() + 1000,
+            values.size() - 1000);
+    }
+};
+
+TEST_F(ZoneMapTest, ComparisonsSkipZonesOutsideTheirRange) {
+    ZoneMap zoneMap{LogicalType{LogicalTypeID::INT64}};
+    addValues(zoneMap);
+    ASSERT_EQ(zoneMap.getNumZones(), 2);
+    auto maxInFirstZone = 100 + (int64_t)ZoneMap::NUM_VALUES_PER_ZONE - 1;
+    ASSERT_TRUE(zoneMap.mayMatch(0, intPredicate(EQUALS, 100)));
+    ASSERT_FALSE(zoneMap.mayMatch(0, intPredicate(EQUALS, 99)));
+    ASSERT_TRUE(zoneMap.mayMatch(0, intPredicate(GREATER_THAN_EQUALS, maxInFirstZone)));
+    ASSERT_FALSE(zoneMap.mayMatch(0, intPredicate(GREATER_THAN, maxInFirstZone)));
+    ASSERT_TRUE(zoneMap.mayMatch(0, intPredicate(LESS_THAN_EQUALS, 100)));
+    ASSERT_FALSE(zoneMap.mayMatch(0, intPredicate(LESS_THAN, 100)));
+    ASSERT_FALSE(zoneMap.mayMatch(1, intPredicate(LESS_THAN, 1000)));
+    ASSERT_TRUE(zoneMap.mayMatch(1, intPredicate(EQUALS, 1009)));
+    ASSERT_FALSE(zoneMap.mayMatch(1, intPredicate(EQUALS, 1010)));
+    // Other comparisons and zones beyond the zone map are never skipped.
+    ASSERT_TRUE(zoneMap.mayMatch(0, intPredicate(NOT_EQUALS, 100)));
+    ASSERT_TRUE(zoneMap.mayMatch(2, intPredicate(EQUALS, 0)));
+}
+
+TEST_F(ZoneMapTest, NullChecksSkipZonesWithoutNullsOrValues) {
+    ZoneMap zoneMap{LogicalType{LogicalTypeID::INT64}};
+    addValues(zoneMap);
+    ASSERT_FALSE(zoneMap.mayMatch(0, intPredicate(IS_NULL, 0)));
+    ASSERT_TRUE(zoneMap.mayMatch(1, intPredicate(IS_NULL, 0)));
+    auto emptyZoneOffset = 3 * ZoneMap::NUM_VALUES_PER_ZONE;
+    zoneMap.addNull(emptyZoneOffset);
+    ASSERT_EQ(zoneMap.getNumZones(), 4);
+    ASSERT_FALSE(zoneMap.mayMatch(3, intPredicate(IS_NOT_NULL, 0)));
+    ASSERT_FALSE(zoneMap.mayMatch(3, intPredicate(GREATER_THAN, 0)));
+    // Zones before the updated zone are added without values.
+    ASSERT_FALSE(zoneMap.mayMatch(2, intPredicate(IS_NULL, 0)));
+    ASSERT_FALSE(zoneMap.mayMatch(2, intPredicate(IS_NOT_NULL, 0)));
+}
+
+TEST_F(ZoneMapTest, UpdatesWidenZones) {
+    ZoneMap zoneMap{LogicalType{LogicalTypeID::INT32}};
+    int32_t value = 5;
+    zoneMap.addValue(10, (uint8_t*)&value);
+    ASSERT_TRUE(zoneMap.isDirty());
+    ASSERT_FALSE(zoneMap.mayMatch(0, intPredicate(LESS_THAN, 5)));
+    value = -7;
+    zoneMap.addValue(11, (uint8_t*)&value);
+    ASSERT_TRUE(zoneMap.mayMatch(0, intPredicate(EQUALS, -7)));
+    ASSERT_TRUE(zoneMap.mayMatch(0, intPredicate(EQUALS, 5)));
+    ASSERT_FALSE(zoneMap.mayMatch(0, intPredicate(GREATER_THAN, 5)));
+}
+
+TEST_F(ZoneMapTest, NaNIsNotSkippedByComparisons) {
+    ZoneMap zoneMap{LogicalType{LogicalTypeID::DOUBLE}};
+    std::vector<double> values{1.5, 2.5};
+    zoneMap.addValues(0, (uint8_t*)values.data(), nullptr /* isNull */, values.size());
+    ASSERT_FALSE(zoneMap.mayMatch(0, doublePredicate(GREATER_THAN, 2.5)));
+    ASSERT_TRUE(zoneMap.mayMatch(0, doublePredicate(GREATER_THAN_EQUALS, 2.5)));
+    auto nan = std::nan("");
+    zoneMap.addValue(2, (uint8_t*)&nan);
+    ASSERT_TRUE(zoneMap.mayMatch(0, doublePredicate(GREATER_THAN, 2.5)));
+    ASSERT_TRUE(zoneMap.mayMatch(0, doublePredicate(LESS_THAN, 1.5)));
+}
+
+TEST_F(ZoneMapTest, ZoneMapIsSavedAndLoaded) {
+    ZoneMap zoneMap{LogicalType{LogicalTypeID::INT64}};
+    addValues(zoneMap);
+    auto fName = databasePath + "/test_file.zonemap";
+    zoneMap.saveToFile(fName);
+    ASSERT_FALSE(zoneMap.isDirty());
+    auto loadedZoneMap = ZoneMap::loadFromFile(LogicalType{LogicalTypeID::INT64}, fName);
+    ASSERT_EQ(loadedZoneMap->getNumZones(), 2);
+    ASSERT_FALSE(loadedZoneMap->isDirty());
+    ASSERT_FALSE(loadedZoneMap->mayMatch(0, intPredicate(LESS_THAN, 100)));
+    ASSERT_TRUE(loadedZoneMap->mayMatch(1, intPredicate(EQUALS, 1005)));
+    ASSERT_TRUE(loadedZoneMap->mayMatch(1, intPredicate(IS_NULL, 0)));
+    ASSERT_FALSE(loadedZoneMap->mayMatch(0, intPredicate(IS_NULL, 0)));
+    // Saving again replaces the file through a temporary file that does not outlive the save.
+    int64_t value = 5000;
+    loadedZoneMap->addValues(0, (uint8_t*)&value, nullptr /* isNull */, 1);
+    loadedZoneMap->saveToFile(fName);
+    ASSERT_FALSE(FileUtils::fileOrPathExists(fName + ".tmp"));
+    auto reloadedZoneMap = ZoneMap::loadFromFile(LogicalType{LogicalTypeID::INT64}, fName);
+    ASSERT_EQ(reloadedZoneMap->getNumZones(), 2);
+    ASSERT_TRUE(reloadedZoneMap->mayMatch(0, intPredicate(EQUALS, 5000)));
+}
@@ -94,6 +94,11 @@ void TestParser::extractExpectedResult(TestStatement* statement) {
         statement->expectedError = true;
         statement->errorMessage = extractTextBeforeNextStatement();
         replaceVariables(statement->errorMessage);
+    } else if (result == "contains") {
+        // Checks that a tuple of the result contains the text, e.g., the plan printed by EXPLAIN.
+        statement->expectedContains = true;
+        statement->expectedSubstring = extractTextBeforeNextStatement();
+        replaceVariables(statement->expectedSubstring);
     } else {
         checkMinimumParams(1);
         statement->expectedNumTuples = stoi(result);
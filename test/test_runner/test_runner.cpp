@@ -70,6 +70,13 @@ bool TestRunner::checkLogicalPlan(std::unique_ptr<PreparedStatement>& preparedSt
         spdlog::info("EXPECTED ERROR: {}", expectedError);
     } else if (statement->expectedOk && result->isSuccess()) {
         return true;
+    } else if (statement->expectedContains) {
+        for (auto& tuple : convertResultToString(*result, true /* checkOutputOrder */)) {
+            if (tuple.find(statement->expectedSubstring) != std::string::npos) {
+                return true;
+            }
+        }
+        spdlog::info("EXPECTED SUBSTRING: {}", statement->expectedSubstring);
     } else {
         auto planStr = preparedStatement->logicalPlans[planIdx]->toString();
         if (checkPlanResult(result, statement, planStr, planIdx)) {
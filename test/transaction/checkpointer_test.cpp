@@ -0,0 +1,74 @@
+#include "common/metric.h"
+#include "graph_test/graph_test.h"
+#include "transaction/transaction_manager.h"
+
+using namespace kuzu::common;
+using namespace kuzu::main;
+using namespace kuzu::testing;
+
+class CheckpointerTest : public EmptyDBTest {
+
+protected:
+    void SetUp() override {
+        EmptyDBTest::SetUp();
+        systemConfig->enableBackgroundCheckpointing = true;
+        // The checkpointer doesn't stop new transactions before read transactions leave.
+        systemConfig->maxBackgroundCheckpointDelayInMs = 60000;
+        createDBAndConn();
+        readConn = std::make_unique<Connection>(database.get());
+        ASSERT_TRUE(
+            conn->query("CREATE NODE TABLE person(ID INT64, PRIMARY KEY(ID))")->isSuccess());
+        ASSERT_TRUE(conn->query("CREATE (:person {ID: 0})")->isSuccess());
+    }
+
+    void TearDown() override {
+        // Checkpoints the last committed transaction before the database files are removed.
+        readConn.reset();
+        conn.reset();
+        database.reset();
+        EmptyDBTest::TearDown();
+    }
+
+    static uint64_t countPersons(Connection* connection) {
+        auto result = connection->query("MATCH (p:person) RETURN COUNT(*)");
+        return result->getNext()->getValue(0)->getValue<int64_t>();
+    }
+
+protected:
+    std::unique_ptr<Connection> readConn;
+};
+
+TEST_F(CheckpointerTest, CommitDoesNotWaitForReadTransactions) {
+    ASSERT_EQ(countPersons(conn.get()), 1);
+    readConn->beginReadOnlyTransaction();
+    ASSERT_EQ(countPersons(readConn.get()), 1);
+    // Without background checkpointing, the commit would time out waiting for readConn.
+    getTransactionManager(*database)->setCheckPointWaitTimeoutForTransactionsToLeaveInMicros(
+        10000 /* 10ms */);
+    ASSERT_TRUE(conn->query("CREATE (:person {ID: 1})")->isSuccess());
+    // readConn keeps reading the last checkpointed version.
+    ASSERT_EQ(countPersons(readConn.get()), 1);
+    readConn->commit();
+    // conn reads its own write once the checkpoint completes.
+    ASSERT_EQ(countPersons(conn.get()), 2);
+    ASSERT_EQ(countPersons(readConn.get()), 2);
+}
+
+TEST_F(CheckpointerTest, WriteTransactionsWaitForTheScheduledCheckpoint) {
+    auto writeConn = std::make_unique<Connection>(database.get());
+    for (auto i = 1u; i <= 10; i++) {
+        auto& connection = i % 2 == 0 ? conn : writeConn;
+        ASSERT_TRUE(
+            connection->query("CREATE (:person {ID: " + std::to_string(i) + "})")->isSuccess());
+    }
+    writeConn.reset();
+    ASSERT_EQ(countPersons(conn.get()), 11);
+    ASSERT_EQ(getCommitLatencyHistogram(*database)->getNumRecorded(), 12);
+}
+
+TEST_F(CheckpointerTest, CommittedTransactionsAreCheckpointedOnClose) {
+    ASSERT_TRUE(conn->query("CREATE (:person {ID: 1})")->isSuccess());
+    readConn.reset();
+    createDBAndConn();
+    ASSERT_EQ(countPersons(conn.get()), 2);
+}
@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "common/exception.h"
 #include "graph_test/graph_test.h"
 #include "transaction/transaction_manager.h"
@@ -136,3 +138,16 @@ TEST_F(TransactionManagerTest, BasicOneWriteMultipleReadOnlyTransactions) {
     ASSERT_EQ(
         expectedReadOnlyTransactionSet, transactionManager->getActiveReadOnlyTransactionIDs());
 }
+
+TEST_F(TransactionManagerTest, ReadOnlyTransactionsLeaveWhileCheckpointWaits) {
+    std::unique_ptr<Transaction> trx1 = transactionManager->beginReadOnlyTransaction();
+    std::thread readThread([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        transactionManager->commit(trx1.get());
+    });
+    // Returns once trx1 leaves instead of timing out.
+    transactionManager->stopNewTransactionsAndWaitUntilAllReadTransactionsLeave();
+    transactionManager->allowReceivingNewTransactions();
+    readThread.join();
+    ASSERT_FALSE(transactionManager->hasActiveReadOnlyTransactions());
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <random>
+
+#include "benchmark_utils.h"
+#include "common/file_utils.h"
+#include "common/utils.h"
+#include "spdlog/spdlog.h"
+#include "storage/buffer_manager/buffer_manager.h"
+
+using namespace kuzu::benchmark;
+using namespace kuzu::common;
+using namespace kuzu::storage;
+
+// Micro-benchmark of the eviction policies of the BufferManager. A file holds a small set of hot
+// pages, e.g., the pages of a hash index, followed by a large range of pages that are read by full
+// scans. Each round issues point lookups on random hot pages, followed by a full scan with the scan
+// hint. For each policy it reports the hit ratio of the point lookups and the elapsed time.
+
+static void runBenchmark(const std::string& filePath, EvictionPolicy evictionPolicy,
+    uint64_t numFrames, uint64_t numHotPages, uint64_t numRounds, uint64_t numLookupsPerRound) {
+    BufferManager bufferManager{numFrames * BufferPoolConstants::PAGE_4KB_SIZE, evictionPolicy};
+    auto fileHandle =
+        bufferManager.getBMFileHandle(filePath, FileHandle::O_PERSISTENT_FILE_NO_CREATE,
+            BMFileHandle::FileVersionedType::NON_VERSIONED_FILE);
+    std::mt19937_64 randomEngine{0};
+    std::uniform_int_distribution<page_idx_t> hotPageDistribution{0, (page_idx_t)numHotPages - 1};
+    uint64_t numLookupHits = 0;
+    uint64_t checksum = 0;
+    auto readPage = [&](uint8_t* frame) { checksum += frame[0]; };
+    auto start = std::chrono::steady_clock::now();
+    for (auto round = 0u; round < numRounds; ++round) {
+        for (auto i = 0u; i < numLookupsPerRound; ++i) {
+            auto pageIdx = hotPageDistribution(randomEngine);
+            numLookupHits += !fileHandle->isPageEvicted(pageIdx);
+            bufferManager.optimisticRead(*fileHandle, pageIdx, readPage);
+        }
+        for (auto pageIdx = numHotPages; pageIdx < fileHandle->getNumPages(); ++pageIdx) {
+            bufferManager.optimisticRead(
+                *fileHandle, pageIdx, readPage, BufferManager::AccessHint::SCAN);
+        }
+    }
+    auto elapsedTimeInMs = getElapsedTimeInMs(start);
+    spdlog::info("policy: {}, lookup hit ratio: {:.3f}, time: {}ms, checksum: {}",
+        evictionPolicy == EvictionPolicy::SCAN_RESISTANT ? "SCAN_RESISTANT" : "SECOND_CHANCE",
+        (double)numLookupHits / (double)(numRounds * numLookupsPerRound), elapsedTimeInMs,
+        checksum);
+}
+
+int main(int argc, char** argv) {
+    std::string filePath = "buffer_manager_benchmark.data";
+    uint64_t numFrames = 16384;
+    uint64_t numHotPages = 4096;
+    uint64_t numScanPages = 65536;
+    uint64_t numRounds = 10;
+    uint64_t numLookupsPerRound = 100000;
+    parseArguments(argc, argv,
+        {{"--file", [&](const std::string& value) { filePath = value; }},
+            {"--frames", [&](const std::string& value) { numFrames = stoull(value); }},
+            {"--hot", [&](const std::string& value) { numHotPages = stoull(value); }},
+            {"--scan", [&](const std::string& value) { numScanPages = stoull(value); }},
+            {"--rounds", [&](const std::string& value) { numRounds = stoull(value); }},
+            {"--lookups", [&](const std::string& value) { numLookupsPerRound = stoull(value); }}});
+    LoggerUtils::createLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+    auto fileInfo = FileUtils::openFile(filePath, O_CREAT | O_RDWR);
+    std::vector<uint8_t> page(BufferPoolConstants::PAGE_4KB_SIZE);
+    for (auto pageIdx = 0u; pageIdx < numHotPages + numScanPages; ++pageIdx) {
+        memset(page.data(), (uint8_t)pageIdx, BufferPoolConstants::PAGE_4KB_SIZE);
+        FileUtils::writeToFile(fileInfo.get(), page.data(), BufferPoolConstants::PAGE_4KB_SIZE,
+            pageIdx * BufferPoolConstants::PAGE_4KB_SIZE);
+    }
+    fileInfo.reset();
+    for (auto evictionPolicy : {EvictionPolicy::SECOND_CHANCE, EvictionPolicy::SCAN_RESISTANT}) {
+        runBenchmark(
+            filePath, evictionPolicy, numFrames, numHotPages, numRounds, numLookupsPerRound);
+    }
+    FileUtils::removeFileIfExists(filePath);
+    LoggerUtils::dropLogger(LoggerConstants::LoggerEnum::BUFFER_MANAGER);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "benchmark_utils.h"
+#include "common/file_utils.h"
+#include "main/kuzu.h"
+#include "spdlog/spdlog.h"
+#include "storage/copier/csv_reader.h"
+
+using namespace kuzu::benchmark;
+using namespace kuzu::catalog;
+using namespace kuzu::common;
+using namespace kuzu::main;
+using namespace kuzu::storage;
+
+// Benchmark of reading CSV files for COPY. It generates a CSV file of persons with an int64 id, a
+// quoted string name, a double score and a date. For each number of threads it reports the
+// throughput of splitting the file into blocks and parsing the blocks in parallel with CSVReader,
+// and of copying the whole file into a node table with COPY.
+
+static uint64_t generateFile(const std::string& filePath, uint64_t numRows) {
+    std::ofstream file{filePath, std::ios::binary};
+    for (auto i = 0u; i < numRows; ++i) {
+        // Every 16th name has a delimiter and a newline inside quotes.
+        file << i << ",\"" << (i % 16 == 0 ? "person,\n" : "person ") << i % 1000 << "\","
+             << (double)i / 8 << ",19" << 70 + i % 30 << "-0" << 1 + i % 9 << "-1" << i % 10
+             << "\n";
+    }
+    return file.tellp();
+}
+
+static void logThroughput(const std::string& name, uint64_t numThreads, uint64_t numBytes,
+    std::chrono::steady_clock::time_point start) {
+    auto elapsedTimeInMs = getElapsedTimeInMs(start);
+    spdlog::info("{}, threads: {}, time: {}ms, throughput: {:.2f}MB/s", name, numThreads,
+        elapsedTimeInMs,
+        (double)numBytes / (double)std::max<int64_t>(elapsedTimeInMs, 1) / 1000);
+}
+
+static void runReaderBenchmark(
+    const std::string& filePath, uint64_t numBytes, TableSchema* tableSchema, uint64_t numThreads) {
+    CSVReaderConfig csvReaderConfig;
+    csvReaderConfig.hasHeader = false;
+    TaskScheduler taskScheduler{numThreads};
+    auto start = std::chrono::steady_clock::now();
+    CSVReader reader{filePath, csvReaderConfig, tableSchema};
+    reader.splitIntoBlocks(taskScheduler, numThreads);
+    logThroughput("split", numThreads, numBytes, start);
+    start = std::chrono::steady_clock::now();
+    std::atomic<uint64_t> nextBlockIdx = 0;
+    std::atomic<uint64_t> numRows = 0;
+    std::vector<std::thread> threads;
+    for (auto threadIdx = 0u; threadIdx < numThreads; ++threadIdx) {
+        threads.emplace_back([&] {
+            for (auto blockIdx = nextBlockIdx++; blockIdx < reader.getNumBlocks();
+                 blockIdx = nextBlockIdx++) {
+                numRows += reader.readBlock(blockIdx)->num_rows();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (numRows != reader.getNumRows()) {
+        throw std::runtime_error("Wrong number of rows parsed in the benchmark.");
+    }
+    logThroughput("parse", numThreads, numBytes, start);
+}
+
+static void runCopyBenchmark(const std::string& filePath, uint64_t numBytes,
+    const std::string& databasePath, uint64_t numThreads) {
+    FileUtils::removeDir(databasePath);
+    Database database{databasePath};
+    Connection conn{&database};
+    conn.setMaxNumThreadForExec(numThreads);
+    conn.query("CREATE NODE TABLE person(id INT64, name STRING, score DOUBLE, birthday DATE, "
+               "PRIMARY KEY(id))");
+    auto start = std::chrono::steady_clock::now();
+    auto result = conn.query("COPY person FROM \"" + filePath + "\" (HEADER=false)");
+    if (!result->isSuccess()) {
+        throw std::runtime_error(result->getErrorMessage());
+    }
+    logThroughput("copy", numThreads, numBytes, start);
+}
+
+int main(int argc, char** argv) {
+    std::string filePath = "csv_reader_benchmark.csv";
+    std::string databasePath = "csv_reader_benchmark_db";
+    uint64_t numRows = 10000000;
+    uint64_t maxNumThreads = std::thread::hardware_concurrency();
+    parseArguments(argc, argv,
+        {{"--file", [&](const std::string& value) { filePath = value; }},
+            {"--database", [&](const std::string& value) { databasePath = value; }},
+            {"--rows", [&](const std::string& value) { numRows = stoull(value); }},
+            {"--threads", [&](const std::string& value) { maxNumThreads = stoull(value); }}});
+    auto numBytes = generateFile(filePath, numRows);
+    NodeTableSchema tableSchema{"person", 0 /* tableID */, 0 /* primaryPropertyId */,
+        std::vector<Property>{Property{"id", LogicalType{LogicalTypeID::INT64}},
+            Property{"name", LogicalType{LogicalTypeID::STRING}},
+            Property{"score", LogicalType{LogicalTypeID::DOUBLE}},
+            Property{"birthday", LogicalType{LogicalTypeID::DATE}}}};
+    for (auto numThreads = 1u; numThreads <= maxNumThreads; numThreads *= 2) {
+        runReaderBenchmark(filePath, numBytes, &tableSchema, numThreads);
+        runCopyBenchmark(filePath, numBytes, databasePath, numThreads);
+    }
+    FileUtils::removeDir(databasePath);
+    FileUtils::removeFileIfExists(filePath);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "benchmark_utils.h"
+#include "common/file_utils.h"
+#include "common/utils.h"
+#include "spdlog/spdlog.h"
+#include "storage/index/hash_index_builder.h"
+
+using namespace kuzu::benchmark;
+using namespace kuzu::common;
+using namespace kuzu::storage;
+
+// Micro-benchmark of building the primary key index of COPY NODE. Each thread appends a range of
+// shuffled int64 or string keys in batches, as the copy threads do for their chunks. For each key
+// type and number of threads it reports the build throughput of the partitioned index, and of the
+// index with all appends serialized by a single lock, which is how COPY NODE used to append keys.
+
+static void runBenchmark(const std::string& filePath, LogicalTypeID keyTypeID,
+    const std::vector<const uint8_t*>& keys, uint64_t numThreads, uint64_t batchSize,
+    bool serializeAppends) {
+    PrimaryKeyIndexBuilder indexBuilder{filePath, LogicalType{keyTypeID}};
+    indexBuilder.bulkReserve(keys.size());
+    std::mutex mtx;
+    std::vector<std::thread> threads;
+    auto numKeysPerThread = (keys.size() + numThreads - 1) / numThreads;
+    auto start = std::chrono::steady_clock::now();
+    for (auto threadIdx = 0u; threadIdx < numThreads; ++threadIdx) {
+        threads.emplace_back([&, threadIdx] {
+            auto endPos = std::min((threadIdx + 1) * numKeysPerThread, (uint64_t)keys.size());
+            for (auto startPos = threadIdx * numKeysPerThread; startPos < endPos;
+                 startPos += batchSize) {
+                std::vector<const uint8_t*> batch{keys.begin() + startPos,
+                    keys.begin() + std::min(startPos + batchSize, endPos)};
+                std::unique_lock lck{mtx, std::defer_lock};
+                if (serializeAppends) {
+                    lck.lock();
+                }
+                if (indexBuilder.append(batch, startPos) < batch.size()) {
+                    throw std::runtime_error("Duplicated key in the benchmark.");
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsedTimeInMs = getElapsedTimeInMs(start);
+    indexBuilder.flush();
+    spdlog::info("keys: {}, threads: {}, appends: {}, time: {}ms, throughput: {:.2f}M keys/s",
+        keyTypeID == LogicalTypeID::INT64 ? "INT64" : "STRING", numThreads,
+        serializeAppends ? "serialized" : "partitioned", elapsedTimeInMs,
+        (double)keys.size() / (double)std::max<int64_t>(elapsedTimeInMs, 1) / 1000);
+}
+
+int main(int argc, char** argv) {
+    std::string filePath = "hash_index_builder_benchmark.hindex";
+    uint64_t numKeys = 10000000;
+    uint64_t maxNumThreads = std::thread::hardware_concurrency();
+    uint64_t batchSize = 2048;
+    parseArguments(argc, argv,
+        {{"--file", [&](const std::string& value) { filePath = value; }},
+            {"--keys", [&](const std::string& value) { numKeys = stoull(value); }},
+            {"--threads", [&](const std::string& value) { maxNumThreads = stoull(value); }},
+            {"--batch", [&](const std::string& value) { batchSize = stoull(value); }}});
+    std::vector<int64_t> int64Keys(numKeys);
+    for (auto i = 0u; i < numKeys; ++i) {
+        int64Keys[i] = (int64_t)i;
+    }
+    std::shuffle(int64Keys.begin(), int64Keys.end(), std::mt19937_64{0});
+    std::vector<std::string> stringKeys(numKeys);
+    for (auto i = 0u; i < numKeys; ++i) {
+        // Long enough to be stored in the overflow file of the index.
+        stringKeys[i] = "person-" + std::to_string(int64Keys[i]) + "@example.com";
+    }
+    for (auto keyTypeID : {LogicalTypeID::INT64, LogicalTypeID::STRING}) {
+        std::vector<const uint8_t*> keys(numKeys);
+        for (auto i = 0u; i < numKeys; ++i) {
+            keys[i] = keyTypeID == LogicalTypeID::INT64 ?
+                          reinterpret_cast<const uint8_t*>(&int64Keys[i]) :
+                          reinterpret_cast<const uint8_t*>(stringKeys[i].c_str());
+        }
+        for (auto numThreads = 1u; numThreads <= maxNumThreads; numThreads *= 2) {
+            for (auto serializeAppends : {true, false}) {
+                runBenchmark(filePath, keyTypeID, keys, numThreads, batchSize, serializeAppends);
+                FileUtils::removeFileIfExists(filePath);
+                FileUtils::removeFileIfExists(StorageUtils::getOverflowFileName(filePath));
+            }
+        }
+    }
+    return 0;
+}
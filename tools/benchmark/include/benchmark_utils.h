@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common/string_utils.h"
+
+namespace kuzu {
+namespace benchmark {
+
+// An option of a benchmark tool, given as "--name=value", or as "--name" if it is a flag. Options
+// are matched by the prefix of the argument, e.g., "--thread" also matches "--threads=4".
+struct BenchmarkOption {
+    std::string name;
+    std::function<void(const std::string& value)> setValue;
+    bool isFlag = false;
+};
+
+inline std::string getArgumentValue(const std::string& arg) {
+    auto splits = common::StringUtils::split(arg, "=");
+    if (splits.size() != 2) {
+        throw std::invalid_argument("Expect value associate with " + splits[0]);
+    }
+    return splits[1];
+}
+
+// Sets the options given in the arguments, and exits on an argument that matches no option.
+inline void parseArguments(int argc, char** argv, const std::vector<BenchmarkOption>& options) {
+    for (auto i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto option = std::find_if(options.begin(), options.end(),
+            [&](const BenchmarkOption& option) { return arg.starts_with(option.name); });
+        if (option == options.end()) {
+            printf("Unrecognized option %s", arg.c_str());
+            exit(1);
+        }
+        option->setValue(option->isFlag ? "" : getArgumentValue(arg));
+    }
+}
+
+inline int64_t getElapsedTimeInMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+} // namespace benchmark
+} // namespace kuzu
@@ -1,46 +1,27 @@
 #include "benchmark_runner.h"
-#include "common/string_utils.h"
+#include "benchmark_utils.h"
 #include "spdlog/spdlog.h"
 
 using namespace kuzu::benchmark;
-using namespace kuzu::common;
-
-static std::string getArgumentValue(const std::string& arg) {
-    auto splits = StringUtils::split(arg, "=");
-    if (splits.size() != 2) {
-        throw std::invalid_argument("Expect value associate with " + splits[0]);
-    }
-    return splits[1];
-}
 
 int main(int argc, char** argv) {
     std::string datasetPath;
     std::string benchmarkPath;
     auto config = std::make_unique<BenchmarkConfig>();
-    // parse arguments
-    for (auto i = 1; i < argc; ++i) {
-        std::string arg = argv[i];
-        if (arg.starts_with("--dataset")) {
-            datasetPath = getArgumentValue(arg);
-        } else if (arg.starts_with("--benchmark")) {
-            benchmarkPath = getArgumentValue(arg);
-        } else if (arg.starts_with("--warmup")) {
-            config->numWarmups = stoul(getArgumentValue(arg));
-        } else if (arg.starts_with("--run")) {
-            config->numRuns = stoul(getArgumentValue(arg));
-        } else if (arg.starts_with("--thread")) {
-            config->numThreads = stoul(getArgumentValue(arg));
-        } else if (arg.starts_with("--out")) { // save benchmark result to file
-            config->outputPath = getArgumentValue(arg);
-        } else if (arg.starts_with("--profile")) {
-            config->enableProfile = true;
-        } else if (arg.starts_with("--bm-size")) {
-            config->bufferPoolSize = (uint64_t)stoull(getArgumentValue(arg)) << 20;
-        } else {
-            printf("Unrecognized option %s", arg.c_str());
-            exit(1);
-        }
-    }
+    parseArguments(argc, argv,
+        {{"--dataset", [&](const std::string& value) { datasetPath = value; }},
+            {"--benchmark", [&](const std::string& value) { benchmarkPath = value; }},
+            {"--warmup", [&](const std::string& value) { config->numWarmups = stoul(value); }},
+            {"--run", [&](const std::string& value) { config->numRuns = stoul(value); }},
+            {"--thread", [&](const std::string& value) { config->numThreads = stoul(value); }},
+            // save benchmark result to file
+            {"--out", [&](const std::string& value) { config->outputPath = value; }},
+            {"--profile", [&](const std::string&) { config->enableProfile = true; },
+                true /* isFlag */},
+            {"--bm-size",
+                [&](const std::string& value) {
+                    config->bufferPoolSize = (uint64_t)stoull(value) << 20;
+                }}});
     if (datasetPath.empty()) {
         printf("Missing --dataset input.");
         exit(1);
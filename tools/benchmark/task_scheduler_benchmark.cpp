@@ -0,0 +1,80 @@
+#include <atomic>
+#include <chrono>
+
+#include "benchmark_utils.h"
+#include "common/task_system/task_scheduler.h"
+#include "spdlog/spdlog.h"
+
+using namespace kuzu::benchmark;
+using namespace kuzu::common;
+
+// Micro-benchmark of the TaskScheduler. For 1..maxThreads worker threads it measures:
+//  - dispatch latency: the average round trip of scheduling an empty single-threaded task and
+//    waiting for it to finish.
+//  - throughput: the number of morsels per second processed by tasks that accept all threads.
+
+class MorselTask : public Task {
+public:
+    MorselTask(uint64_t maxNumThreads, uint64_t numMorsels, uint64_t workPerMorsel)
+        : Task{maxNumThreads}, numMorsels{numMorsels}, workPerMorsel{workPerMorsel} {}
+
+    void run() override {
+        while (nextMorsel.fetch_add(1) < numMorsels) {
+            uint64_t sum = 0;
+            for (auto i = 0u; i < workPerMorsel; ++i) {
+                sum += i * i;
+            }
+            checksum.fetch_add(sum, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    uint64_t numMorsels;
+    uint64_t workPerMorsel;
+    std::atomic<uint64_t> nextMorsel{0};
+    std::atomic<uint64_t> checksum{0};
+};
+
+static double getElapsedTimeInMicros(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           1000;
+}
+
+int main(int argc, char** argv) {
+    uint64_t maxNumThreads = std::thread::hardware_concurrency();
+    uint64_t numTasks = 10000;
+    uint64_t numMorsels = 100000;
+    uint64_t workPerMorsel = 1000;
+    bool pinThreadsToNUMANodes = false;
+    parseArguments(argc, argv,
+        {{"--thread", [&](const std::string& value) { maxNumThreads = stoull(value); }},
+            {"--tasks", [&](const std::string& value) { numTasks = stoull(value); }},
+            {"--morsels", [&](const std::string& value) { numMorsels = stoull(value); }},
+            {"--work", [&](const std::string& value) { workPerMorsel = stoull(value); }},
+            {"--numa", [&](const std::string&) { pinThreadsToNUMANodes = true; },
+                true /* isFlag */}});
+    // Measure at powers of two and at maxNumThreads.
+    std::vector<uint64_t> numThreadsToMeasure;
+    for (auto numThreads = 1u; numThreads < maxNumThreads; numThreads *= 2) {
+        numThreadsToMeasure.push_back(numThreads);
+    }
+    numThreadsToMeasure.push_back(maxNumThreads);
+    for (auto numThreads : numThreadsToMeasure) {
+        TaskScheduler taskScheduler{numThreads, pinThreadsToNUMANodes};
+        auto start = std::chrono::steady_clock::now();
+        for (auto i = 0u; i < numTasks; ++i) {
+            taskScheduler.scheduleTaskAndWaitOrError(
+                std::make_shared<MorselTask>(1 /* maxNumThreads */, 0, 0), nullptr);
+        }
+        auto dispatchLatency = getElapsedTimeInMicros(start) / (double)numTasks;
+        start = std::chrono::steady_clock::now();
+        taskScheduler.scheduleTaskAndWaitOrError(
+            std::make_shared<MorselTask>(numThreads, numMorsels, workPerMorsel), nullptr);
+        auto morselsPerSecond = (double)numMorsels / getElapsedTimeInMicros(start) * 1000000;
+        spdlog::info("threads: {}, dispatch latency: {:.2f}us, throughput: {:.0f} morsels/s",
+            numThreads, dispatchLatency, morselsPerSecond);
+    }
+    return 0;
+}